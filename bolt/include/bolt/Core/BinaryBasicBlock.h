@@ -980,6 +980,7 @@ private:
     clearList(LandingPads);
     clearList(BranchInfo);
     clearList(Instructions);
+    NumPseudos = 0;
   }
 };
 
@@ -604,6 +604,10 @@ public:
   /// Indicates if the binary contains split functions.
   bool HasSplitFunctions{false};
 
+  /// Indicates if the warm fragments of split functions are emitted to their
+  /// own section.
+  bool HasWarmSection{false};
+
   /// Is the binary always loaded at a fixed address. Shared objects and
   /// position-independent executables (PIEs) are examples of binaries that
   /// will have HasFixedLoadAddress set to false.
@@ -901,6 +905,8 @@ public:
 
   const char *getColdCodeSectionName() const { return ".text.cold"; }
 
+  const char *getWarmCodeSectionName() const { return ".text.warm"; }
+
   const char *getHotTextMoverSectionName() const { return ".text.mover"; }
 
   const char *getInjectedCodeSectionName() const { return ".text.injected"; }
@@ -1331,6 +1331,8 @@ public:
       return SmallString<32>(CodeSectionName);
     if (Fragment == FragmentNum::cold())
       return SmallString<32>(ColdCodeSectionName);
+    if (BC.HasWarmSection && Fragment == FragmentNum::warm())
+      return SmallString<32>(BC.getWarmCodeSectionName());
     return formatv("{0}.{1}", ColdCodeSectionName, Fragment.get() - 1);
   }
 
@@ -2253,6 +2255,11 @@ public:
         return std::string();
       }) const;
 
+  /// Compute a hash of the opcodes in \p BB ignoring operands, pseudo
+  /// instructions and unconditional branches. Unlike computeHash, the result
+  /// is stable across hosts and is used to match blocks of a stale profile.
+  uint64_t computeBlockHash(const BinaryBasicBlock &BB) const;
+
   void setDWARFUnit(DWARFUnit *Unit) { DwarfUnit = Unit; }
 
   /// Return DWARF compile unit for this function.
@@ -17,6 +17,7 @@
 #include <system_error>
 
 namespace llvm {
+class DataExtractor;
 class raw_ostream;
 
 namespace object {
@@ -79,7 +80,8 @@ public:
   BoltAddressTranslation() {}
 
   /// Write the serialized address translation tables for each reordered
-  /// function
+  /// function. The tables are delta and LEB128 encoded and must be stored in a
+  /// note of type NT_BOLT_BAT_COMPACT.
   void write(const BinaryContext &BC, raw_ostream &OS);
 
   /// Read the serialized address translation tables and load them internally
@@ -118,6 +120,11 @@ private:
   void writeEntriesForBB(MapTy &Map, const BinaryBasicBlock &BB,
                          uint64_t FuncAddress);
 
+  /// Read the LEB128-encoded tables written by write() starting at \p Offset
+  /// in \p DE (note type NT_BOLT_BAT_COMPACT). Legacy fixed-width tables
+  /// (NT_BOLT_BAT) are read by parse() directly.
+  std::error_code parseCompact(const DataExtractor &DE, uint64_t Offset);
+
   std::map<uint64_t, MapTy> Maps;
 
   /// Links outlined cold bocks to their original function
@@ -70,6 +70,13 @@ private:
   bool parseFunctionProfile(BinaryFunction &Function,
                             const yaml::bolt::BinaryFunctionProfile &YamlBF);
 
+  /// Infer block and edge counts of \p BF from a profile \p YamlBF collected
+  /// on a different version of the function. Blocks are matched by their
+  /// opcode hash and the remaining counts are completed by the minimum-cost
+  /// flow algorithm. Return true if the inferred profile was applied.
+  bool inferStaleProfile(BinaryFunction &Function,
+                         const yaml::bolt::BinaryFunctionProfile &YamlBF);
+
   /// Initialize maps for profile matching.
   void buildNameMaps(std::map<uint64_t, BinaryFunction> &Functions);
 
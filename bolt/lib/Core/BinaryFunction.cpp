@@ -39,6 +39,7 @@
 #include "llvm/Support/LEB128.h"
 #include "llvm/Support/Regex.h"
 #include "llvm/Support/Timer.h"
+#include "llvm/Support/xxhash.h"
 #include "llvm/Support/raw_ostream.h"
 #include <functional>
 #include <limits>
@@ -3633,6 +3634,25 @@ size_t BinaryFunction::computeHash(bool UseDFS,
   return Hash = std::hash<std::string>{}(HashString);
 }
 
+uint64_t BinaryFunction::computeBlockHash(const BinaryBasicBlock &BB) const {
+  std::string HashString;
+  for (const MCInst &Inst : BB) {
+    if (BC.MIB->isPseudo(Inst) || BC.MIB->isUnconditionalBranch(Inst))
+      continue;
+
+    unsigned Opcode = Inst.getOpcode();
+    if (Opcode == 0)
+      HashString.push_back(0);
+
+    while (Opcode) {
+      HashString.push_back(Opcode & 0xff);
+      Opcode = Opcode >> 8;
+    }
+  }
+
+  return xxHash64(HashString);
+}
+
 void BinaryFunction::insertBasicBlocks(
     BinaryBasicBlock *Start,
     std::vector<std::unique_ptr<BinaryBasicBlock>> &&NewBBs,
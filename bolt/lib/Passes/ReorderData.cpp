@@ -43,7 +43,8 @@ ReorderData("reorder-data",
 
 enum ReorderAlgo : char {
   REORDER_COUNT         = 0,
-  REORDER_FUNCS         = 1
+  REORDER_FUNCS         = 1,
+  REORDER_AFFINITY      = 2
 };
 
 static cl::opt<ReorderAlgo>
@@ -56,7 +57,10 @@ ReorderAlgorithm("reorder-data-algo",
       "sort hot data by read counts"),
     clEnumValN(REORDER_FUNCS,
       "funcs",
-      "sort hot data by hot function usage and count")),
+      "sort hot data by hot function usage and count"),
+    clEnumValN(REORDER_AFFINITY,
+      "affinity",
+      "cluster hot data accessed by the same hot functions")),
   cl::ZeroOrMore,
   cl::cat(BoltOptCategory));
 
@@ -70,6 +74,12 @@ static cl::opt<unsigned> ReorderDataMaxBytes(
     "reorder-data-max-bytes", cl::desc("maximum number of bytes to reorder"),
     cl::init(std::numeric_limits<unsigned>::max()), cl::cat(BoltOptCategory));
 
+static cl::opt<unsigned> ReorderDataAffinityMaxUses(
+    "reorder-data-affinity-max-uses",
+    cl::desc("ignore functions accessing more hot symbols than this when "
+             "computing data affinity (default 64)"),
+    cl::init(64), cl::Hidden, cl::cat(BoltOptCategory));
+
 static cl::list<std::string>
 ReorderSymbols("reorder-symbols",
   cl::CommaSeparated,
@@ -325,6 +335,89 @@ ReorderData::sortedByCount(BinaryContext &BC,
   return std::make_pair(Order, SplitPoint);
 }
 
+/// Start from the count order and regroup the hot symbols so that symbols
+/// accessed by the same hot functions are adjacent and tend to share cache
+/// lines and pages. The affinity of two symbols is the sum, over the hot
+/// functions accessing both, of the smaller of their access counts there.
+std::pair<DataOrder, unsigned>
+ReorderData::sortedByAffinity(BinaryContext &BC, const BinarySection &Section,
+                              std::map<uint64_t, BinaryFunction> &BFs) const {
+  DataOrder Order;
+  unsigned SplitPoint;
+  std::tie(Order, SplitPoint) = sortedByCount(BC, Section);
+
+  DenseMap<const BinaryData *, unsigned> HotIndex;
+  for (unsigned Idx = 0; Idx < SplitPoint; ++Idx)
+    HotIndex[Order[Idx].first] = Idx;
+
+  std::vector<DenseMap<unsigned, uint64_t>> Affinity(SplitPoint);
+  for (auto &Entry : BFs) {
+    const BinaryFunction &BF = Entry.second;
+    if (!BF.hasValidProfile() || !BF.hasMemoryProfile())
+      continue;
+
+    DenseMap<unsigned, uint64_t> Uses;
+    for (const BinaryBasicBlock &BB : BF) {
+      if (BB.isCold())
+        continue;
+
+      for (const MCInst &Inst : BB) {
+        auto ErrorOrMemAccessProfile =
+            BC.MIB->tryGetAnnotationAs<MemoryAccessProfile>(
+                Inst, "MemoryAccessProfile");
+        if (!ErrorOrMemAccessProfile)
+          continue;
+
+        for (const AddressAccess &AccessInfo :
+             ErrorOrMemAccessProfile.get().AddressAccessInfo) {
+          if (!AccessInfo.MemoryObject)
+            continue;
+          auto HI = HotIndex.find(AccessInfo.MemoryObject->getAtomicRoot());
+          if (HI != HotIndex.end())
+            Uses[HI->second] += AccessInfo.Count;
+        }
+      }
+    }
+
+    if (Uses.size() < 2 || Uses.size() > opts::ReorderDataAffinityMaxUses)
+      continue;
+    for (const auto &A : Uses)
+      for (const auto &B : Uses)
+        if (A.first != B.first)
+          Affinity[A.first][B.first] += std::min(A.second, B.second);
+  }
+
+  // Grow chains greedily: seed each chain with the densest symbol not placed
+  // yet and keep appending the unplaced symbol with the strongest affinity to
+  // the last one. Ties are broken by density to keep the order deterministic.
+  DataOrder NewOrder;
+  NewOrder.reserve(Order.size());
+  std::vector<bool> Placed(SplitPoint);
+  for (unsigned Seed = 0; Seed < SplitPoint; ++Seed) {
+    unsigned Cur = Seed;
+    while (!Placed[Cur]) {
+      Placed[Cur] = true;
+      NewOrder.push_back(Order[Cur]);
+
+      uint64_t BestWeight = 0;
+      unsigned Best = Cur;
+      for (const auto &Succ : Affinity[Cur]) {
+        if (Placed[Succ.first] || !Succ.second)
+          continue;
+        if (Succ.second > BestWeight ||
+            (Succ.second == BestWeight && Succ.first < Best)) {
+          BestWeight = Succ.second;
+          Best = Succ.first;
+        }
+      }
+      Cur = Best;
+    }
+  }
+  NewOrder.insert(NewOrder.end(), Order.begin() + SplitPoint, Order.end());
+
+  return std::make_pair(NewOrder, SplitPoint);
+}
+
 // TODO
 // add option for cache-line alignment (or just use cache-line when section
 // is writeable)?
@@ -484,6 +577,10 @@ void ReorderData::runOnFunctions(BinaryContext &BC) {
     if (opts::ReorderAlgorithm == opts::ReorderAlgo::REORDER_COUNT) {
       outs() << "BOLT-INFO: reorder-sections: ordering data by count\n";
       std::tie(Order, SplitPointIdx) = sortedByCount(BC, *Section);
+    } else if (opts::ReorderAlgorithm == opts::ReorderAlgo::REORDER_AFFINITY) {
+      outs() << "BOLT-INFO: reorder-sections: ordering data by affinity\n";
+      std::tie(Order, SplitPointIdx) =
+          sortedByAffinity(BC, *Section, BC.getBinaryFunctions());
     } else {
       outs() << "BOLT-INFO: reorder-sections: ordering data by funcs\n";
       std::tie(Order, SplitPointIdx) =
@@ -91,6 +91,9 @@ static cl::opt<SplitFunctionsStrategy> SplitStrategy(
     cl::values(clEnumValN(SplitFunctionsStrategy::Profile2, "profile2",
                           "split each function into a hot and cold fragment "
                           "using profiling information")),
+    cl::values(clEnumValN(SplitFunctionsStrategy::Profile3, "profile3",
+                          "split each function into a hot, warm and cold "
+                          "fragment using profiling information")),
     cl::values(clEnumValN(
         SplitFunctionsStrategy::Random2, "random2",
         "split each function into a hot and cold fragment at a randomly chosen "
@@ -105,6 +108,13 @@ static cl::opt<SplitFunctionsStrategy> SplitStrategy(
         "fragment contains exactly a single basic block")),
     cl::desc("strategy used to partition blocks into fragments"),
     cl::cat(BoltOptCategory));
+
+static cl::opt<unsigned> SplitWarmRatio(
+    "split-warm-ratio",
+    cl::desc("with -split-strategy=profile3, move executed blocks whose count "
+             "is below this percentage of the function execution count to "
+             "the warm fragment. Default value: 5."),
+    cl::init(5), cl::Hidden, cl::cat(BoltOptCategory));
 } // namespace opts
 
 namespace {
@@ -135,6 +145,37 @@ struct SplitProfile2 final : public SplitStrategy {
   }
 };
 
+struct SplitProfile3 final : public SplitStrategy {
+  bool canSplit(const BinaryFunction &BF) override {
+    return BF.hasValidProfile() && hasFullProfile(BF) && !allBlocksCold(BF);
+  }
+
+  // Keep the warm fragment number even if there are no cold blocks, so that
+  // the warm blocks are emitted to the warm section.
+  bool keepEmpty() override { return true; }
+
+  void fragment(const BlockIt Start, const BlockIt End) override {
+    const BinaryFunction &BF = *(*Start)->getFunction();
+    const uint64_t WarmThreshold =
+        BF.getKnownExecutionCount() * opts::SplitWarmRatio;
+    for (BinaryBasicBlock *const BB : llvm::make_range(Start, End)) {
+      if (!BB->canOutline())
+        continue;
+      const uint64_t Count = BB->getExecutionCount();
+      if (Count == 0)
+        BB->setFragmentNum(FragmentNum::cold());
+      else if (Count * 100 < WarmThreshold)
+        BB->setFragmentNum(FragmentNum::warm());
+    }
+    // Fragments have to be increasing in the layout. The warm fragment comes
+    // last in the function, but its section is placed before the cold one.
+    std::stable_sort(Start, End,
+                     [](BinaryBasicBlock *const A, BinaryBasicBlock *const B) {
+                       return A->getFragmentNum() < B->getFragmentNum();
+                     });
+  }
+};
+
 struct SplitRandom2 final : public SplitStrategy {
   std::minstd_rand0 Gen;
 
@@ -252,6 +293,19 @@ void SplitFunctions::runOnFunctions(BinaryContext &BC) {
   case SplitFunctionsStrategy::Profile2:
     Strategy = std::make_unique<SplitProfile2>();
     break;
+  case SplitFunctionsStrategy::Profile3:
+    // Without relocations only a single cold fragment can be allocated.
+    if (!BC.HasRelocations) {
+      errs() << "BOLT-WARNING: -split-strategy=profile3 requires relocation "
+                "mode, using profile2 instead\n";
+      Strategy = std::make_unique<SplitProfile2>();
+      break;
+    }
+    // Warm fragments go to their own section, which is placed between the
+    // hot and the cold code.
+    BC.HasWarmSection = true;
+    Strategy = std::make_unique<SplitProfile3>();
+    break;
   case SplitFunctionsStrategy::Random2:
     Strategy = std::make_unique<SplitRandom2>();
     // If we split functions randomly, we need to ensure that across runs with
@@ -10,6 +10,7 @@
 #include "bolt/Core/BinaryFunction.h"
 #include "llvm/Support/DataExtractor.h"
 #include "llvm/Support/Errc.h"
+#include "llvm/Support/LEB128.h"
 
 #define DEBUG_TYPE "bolt-bat"
 
@@ -96,29 +97,41 @@ void BoltAddressTranslation::write(const BinaryContext &BC, raw_ostream &OS) {
     }
   }
 
-  const uint32_t NumFuncs = Maps.size();
-  OS.write(reinterpret_cast<const char *>(&NumFuncs), 4);
-  LLVM_DEBUG(dbgs() << "Writing " << NumFuncs << " functions for BAT.\n");
+  // All fields are deltas from the previous value encoded as LEB128: function
+  // and output addresses are sorted, so they use ULEB128, while input offsets
+  // and hot addresses may go backwards and use SLEB128. The branch bit of an
+  // input offset is moved to the least significant bit.
+  LLVM_DEBUG(dbgs() << "Writing " << Maps.size() << " functions for BAT.\n");
+  encodeULEB128(Maps.size(), OS);
+  uint64_t PrevAddress = 0;
   for (auto &MapEntry : Maps) {
     const uint64_t Address = MapEntry.first;
     MapTy &Map = MapEntry.second;
-    const uint32_t NumEntries = Map.size();
-    LLVM_DEBUG(dbgs() << "Writing " << NumEntries << " entries for 0x"
+    LLVM_DEBUG(dbgs() << "Writing " << Map.size() << " entries for 0x"
                       << Twine::utohexstr(Address) << ".\n");
-    OS.write(reinterpret_cast<const char *>(&Address), 8);
-    OS.write(reinterpret_cast<const char *>(&NumEntries), 4);
+    encodeULEB128(Address - PrevAddress, OS);
+    encodeULEB128(Map.size(), OS);
+    PrevAddress = Address;
+    uint32_t PrevOutputOffset = 0;
+    int64_t PrevInputValue = 0;
     for (std::pair<const uint32_t, uint32_t> &KeyVal : Map) {
-      OS.write(reinterpret_cast<const char *>(&KeyVal.first), 4);
-      OS.write(reinterpret_cast<const char *>(&KeyVal.second), 4);
+      const int64_t InputValue = (int64_t)(KeyVal.second & ~BRANCHENTRY) << 1 |
+                                 !!(KeyVal.second & BRANCHENTRY);
+      encodeULEB128(KeyVal.first - PrevOutputOffset, OS);
+      encodeSLEB128(InputValue - PrevInputValue, OS);
+      PrevOutputOffset = KeyVal.first;
+      PrevInputValue = InputValue;
     }
   }
   const uint32_t NumColdEntries = ColdPartSource.size();
   LLVM_DEBUG(dbgs() << "Writing " << NumColdEntries
                     << " cold part mappings.\n");
-  OS.write(reinterpret_cast<const char *>(&NumColdEntries), 4);
+  encodeULEB128(NumColdEntries, OS);
+  uint64_t PrevColdAddress = 0;
   for (std::pair<const uint64_t, uint64_t> &ColdEntry : ColdPartSource) {
-    OS.write(reinterpret_cast<const char *>(&ColdEntry.first), 8);
-    OS.write(reinterpret_cast<const char *>(&ColdEntry.second), 8);
+    encodeULEB128(ColdEntry.first - PrevColdAddress, OS);
+    encodeSLEB128(ColdEntry.second - ColdEntry.first, OS);
+    PrevColdAddress = ColdEntry.first;
     LLVM_DEBUG(dbgs() << " " << Twine::utohexstr(ColdEntry.first) << " -> "
                       << Twine::utohexstr(ColdEntry.second) << "\n");
   }
@@ -138,7 +151,8 @@ std::error_code BoltAddressTranslation::parse(StringRef Buf) {
   const uint32_t DescSz = DE.getU32(&Offset);
   const uint32_t Type = DE.getU32(&Offset);
 
-  if (Type != BinarySection::NT_BOLT_BAT ||
+  if ((Type != BinarySection::NT_BOLT_BAT &&
+       Type != BinarySection::NT_BOLT_BAT_COMPACT) ||
       Buf.size() + Offset < alignTo(NameSz, 4) + DescSz)
     return make_error_code(llvm::errc::io_error);
 
@@ -147,6 +161,9 @@ std::error_code BoltAddressTranslation::parse(StringRef Buf) {
   if (Name.substr(0, 4) != "BOLT")
     return make_error_code(llvm::errc::io_error);
 
+  if (Type == BinarySection::NT_BOLT_BAT_COMPACT)
+    return parseCompact(DE, Offset);
+
   if (Buf.size() - Offset < 4)
     return make_error_code(llvm::errc::io_error);
 
@@ -182,13 +199,65 @@ std::error_code BoltAddressTranslation::parse(StringRef Buf) {
   for (uint32_t I = 0; I < NumColdEntries; ++I) {
     if (Buf.size() - Offset < 16)
       return make_error_code(llvm::errc::io_error);
-    const uint32_t ColdAddress = DE.getU64(&Offset);
-    const uint32_t HotAddress = DE.getU64(&Offset);
+    const uint64_t ColdAddress = DE.getU64(&Offset);
+    const uint64_t HotAddress = DE.getU64(&Offset);
+    ColdPartSource.insert(
+        std::pair<uint64_t, uint64_t>(ColdAddress, HotAddress));
+    LLVM_DEBUG(dbgs() << Twine::utohexstr(ColdAddress) << " -> "
+                      << Twine::utohexstr(HotAddress) << "\n");
+  }
+  outs() << "BOLT-INFO: Parsed " << Maps.size() << " BAT entries\n";
+  outs() << "BOLT-INFO: Parsed " << NumColdEntries
+         << " BAT cold-to-hot entries\n";
+
+  return std::error_code();
+}
+
+std::error_code BoltAddressTranslation::parseCompact(const DataExtractor &DE,
+                                                     uint64_t Offset) {
+  DataExtractor::Cursor C(Offset);
+  const uint64_t NumFunctions = DE.getULEB128(C);
+  LLVM_DEBUG(dbgs() << "Parsing " << NumFunctions << " functions\n");
+  uint64_t PrevAddress = 0;
+  for (uint64_t I = 0; C && I < NumFunctions; ++I) {
+    const uint64_t Address = PrevAddress + DE.getULEB128(C);
+    const uint64_t NumEntries = DE.getULEB128(C);
+    PrevAddress = Address;
+    MapTy Map;
+
+    LLVM_DEBUG(dbgs() << "Parsing " << NumEntries << " entries for 0x"
+                      << Twine::utohexstr(Address) << "\n");
+    uint32_t OutputOffset = 0;
+    int64_t InputValue = 0;
+    for (uint64_t J = 0; C && J < NumEntries; ++J) {
+      OutputOffset += DE.getULEB128(C);
+      InputValue += DE.getSLEB128(C);
+      const uint32_t InputOffset =
+          (InputValue >> 1) | (InputValue & 1 ? BRANCHENTRY : 0);
+      Map.insert(std::pair<uint32_t, uint32_t>(OutputOffset, InputOffset));
+      LLVM_DEBUG(dbgs() << Twine::utohexstr(OutputOffset) << " -> "
+                        << Twine::utohexstr(InputOffset) << "\n");
+    }
+    Maps.insert(std::pair<uint64_t, MapTy>(Address, std::move(Map)));
+  }
+
+  const uint64_t NumColdEntries = DE.getULEB128(C);
+  LLVM_DEBUG(dbgs() << "Parsing " << NumColdEntries << " cold part mappings\n");
+  uint64_t ColdAddress = 0;
+  for (uint64_t I = 0; C && I < NumColdEntries; ++I) {
+    ColdAddress += DE.getULEB128(C);
+    const uint64_t HotAddress = ColdAddress + DE.getSLEB128(C);
     ColdPartSource.insert(
         std::pair<uint64_t, uint64_t>(ColdAddress, HotAddress));
     LLVM_DEBUG(dbgs() << Twine::utohexstr(ColdAddress) << " -> "
                       << Twine::utohexstr(HotAddress) << "\n");
   }
+
+  if (Error E = C.takeError()) {
+    consumeError(std::move(E));
+    return make_error_code(llvm::errc::io_error);
+  }
+
   outs() << "BOLT-INFO: Parsed " << Maps.size() << " BAT entries\n";
   outs() << "BOLT-INFO: Parsed " << NumColdEntries
          << " BAT cold-to-hot entries\n";
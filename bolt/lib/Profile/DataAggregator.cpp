@@ -1390,6 +1390,15 @@ std::error_code DataAggregator::printLBRHeatMap() {
   return std::error_code();
 }
 
+// FIXME: Parsing is single-threaded because the parse*() helpers advance the
+// shared ParsingBuf/Line/Col cursor. Chunked parallel parsing would need a
+// per-chunk cursor object (split at '\n' boundaries), per-thread
+// FallthroughLBRs/BranchLBRs/BasicSamples maps and per-thread trace counters
+// merged after the loop, and MaxSamples applied as a global budget. The perf
+// script child process is usually the larger cost for big captures; reading
+// perf.data natively would avoid it but requires a decoder for the perf file
+// format (attrs, PERF_RECORD_SAMPLE with PERF_SAMPLE_BRANCH_STACK, MMAP2 and
+// COMM/FORK records) that BOLT does not have yet.
 std::error_code DataAggregator::parseBranchEvents() {
   outs() << "PERF2BOLT: parse branch events...\n";
   NamedRegionTimer T("parseBranch", "Parsing branch events", TimerGroupName,
@@ -1429,8 +1438,11 @@ std::error_code DataAggregator::parseBranchEvents() {
     }
 
     // LBRs are stored in reverse execution order. NextPC refers to the next
-    // recorded executed PC.
+    // recorded executed PC. Every address is looked up once: the function
+    // containing LBR.From is also the one containing the next trace end.
     uint64_t NextPC = opts::UseEventPC ? Sample.PC : 0;
+    BinaryFunction *NextBF =
+        NextPC ? getBinaryFunctionContainingAddress(NextPC) : nullptr;
     uint32_t NumEntry = 0;
     for (const LBREntry &LBR : Sample.LBR) {
       ++NumEntry;
@@ -1442,12 +1454,13 @@ std::error_code DataAggregator::parseBranchEvents() {
       // chronological order)
       if (NeedsSkylakeFix && NumEntry <= 2)
         continue;
+      BinaryFunction *FromBF = getBinaryFunctionContainingAddress(LBR.From);
+      BinaryFunction *ToBF = getBinaryFunctionContainingAddress(LBR.To);
       if (NextPC) {
         // Record fall-through trace.
         const uint64_t TraceFrom = LBR.To;
         const uint64_t TraceTo = NextPC;
-        const BinaryFunction *TraceBF =
-            getBinaryFunctionContainingAddress(TraceFrom);
+        const BinaryFunction *TraceBF = ToBF;
         if (TraceBF && TraceBF->containsAddress(TraceTo)) {
           FTInfo &Info = FallthroughLBRs[Trace(TraceFrom, TraceTo)];
           if (TraceBF->containsAddress(LBR.From))
@@ -1455,7 +1468,7 @@ std::error_code DataAggregator::parseBranchEvents() {
           else
             ++Info.ExternCount;
         } else {
-          if (TraceBF && getBinaryFunctionContainingAddress(TraceTo)) {
+          if (TraceBF && NextBF) {
             LLVM_DEBUG(dbgs()
                        << "Invalid trace starting in "
                        << TraceBF->getPrintName() << " @ "
@@ -1488,12 +1501,13 @@ std::error_code DataAggregator::parseBranchEvents() {
         ++NumTraces;
       }
       NextPC = LBR.From;
+      NextBF = FromBF;
 
       uint64_t From = LBR.From;
-      if (!getBinaryFunctionContainingAddress(From))
+      if (!FromBF)
         From = 0;
       uint64_t To = LBR.To;
-      if (!getBinaryFunctionContainingAddress(To))
+      if (!ToBF)
         To = 0;
       if (!From && !To)
         continue;
@@ -0,0 +1,202 @@
+//===- bolt/Profile/StaleProfileMatching.cpp - Profile data matching ----===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// BOLT often has to deal with profiles collected on binaries built from several
+// revisions behind release. As a result, a certain percentage of functions is
+// considered stale and not optimized. This file implements an ability to match
+// profile to functions that are not 100% binary identical, and thus, increasing
+// the optimization coverage and boost the performance of applications.
+//
+// The algorithm consists of two phases: matching and inference:
+// - At the matching phase, we try to "guess" as many block and jump counts from
+//   the stale profile as possible. To this end, the content of each basic block
+//   is hashed (opcodes only) and blocks whose hash is unique in both the
+//   profile and the binary are used as anchors.
+// - At the inference phase, we complete the counts of the remaining blocks and
+//   jumps using the minimum-cost flow algorithm (profi) shared with
+//   SampleProfileLoader, so that the result satisfies flow conservation.
+//
+//===----------------------------------------------------------------------===//
+
+#include "bolt/Core/BinaryBasicBlock.h"
+#include "bolt/Core/BinaryFunction.h"
+#include "bolt/Profile/YAMLProfileReader.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Transforms/Utils/SampleProfileInference.h"
+
+#undef DEBUG_TYPE
+#define DEBUG_TYPE "bolt-prof"
+
+using namespace llvm;
+
+namespace opts {
+
+extern cl::opt<unsigned> Verbosity;
+extern cl::OptionCategory BoltOptCategory;
+
+cl::opt<bool>
+    InferStaleProfile("infer-stale-profile",
+                      cl::desc("infer counts from stale profile data"),
+                      cl::init(false), cl::Hidden, cl::cat(BoltOptCategory));
+
+static cl::opt<unsigned> StaleMatchingMinMatchedBlock(
+    "stale-matching-min-matched-block",
+    cl::desc("minimum percentage of profiled blocks that have to be matched "
+             "for the profile to be used (default 50)"),
+    cl::init(50), cl::Hidden, cl::cat(BoltOptCategory));
+
+} // namespace opts
+
+namespace llvm {
+namespace bolt {
+
+/// Create a wrapper flow function to use with the profile inference algorithm.
+/// The flow function contains an artificial source block (with index 0) that
+/// has a jump to every entry point and landing pad of \p BF, so that it is the
+/// only entry of the graph. Flow block I + 1 corresponds to \p BlockOrder[I].
+static FlowFunction createFlowFunction(
+    ArrayRef<BinaryBasicBlock *> BlockOrder,
+    const DenseMap<const BinaryBasicBlock *, uint64_t> &FlowIndex) {
+  FlowFunction Func;
+  Func.Blocks.resize(BlockOrder.size() + 1);
+  for (uint64_t I = 0; I < Func.Blocks.size(); ++I)
+    Func.Blocks[I].Index = I;
+
+  for (const BinaryBasicBlock *BB : BlockOrder) {
+    if (BB->isEntryPoint() || BB->isLandingPad() || BB->pred_empty()) {
+      Func.Jumps.emplace_back();
+      Func.Jumps.back().Source = 0;
+      Func.Jumps.back().Target = FlowIndex.lookup(BB);
+    }
+
+    // Self-loops are not represented in the flow graph; their counts are
+    // left at zero.
+    SmallPtrSet<const BinaryBasicBlock *, 4> UniqueSuccs;
+    for (const BinaryBasicBlock *Succ : BB->successors()) {
+      if (Succ == BB || !UniqueSuccs.insert(Succ).second)
+        continue;
+      Func.Jumps.emplace_back();
+      Func.Jumps.back().Source = FlowIndex.lookup(BB);
+      Func.Jumps.back().Target = FlowIndex.lookup(Succ);
+    }
+  }
+
+  for (FlowJump &Jump : Func.Jumps) {
+    Func.Blocks[Jump.Source].SuccJumps.push_back(&Jump);
+    Func.Blocks[Jump.Target].PredJumps.push_back(&Jump);
+  }
+  Func.Entry = 0;
+  return Func;
+}
+
+bool YAMLProfileReader::inferStaleProfile(
+    BinaryFunction &BF, const yaml::bolt::BinaryFunctionProfile &YamlBF) {
+  // Basic samples profiles carry no edge counts and are handled by
+  // estimateEdgeCounts() anyway.
+  if (YamlBP.Header.Flags & BinaryFunction::PF_SAMPLE)
+    return false;
+
+  // Anchors are blocks whose hash is unique in both the binary and the profile.
+  std::vector<BinaryBasicBlock *> BlockOrder;
+  DenseMap<const BinaryBasicBlock *, uint64_t> FlowIndex;
+  DenseMap<uint64_t, BinaryBasicBlock *> HashToBB;
+  DenseMap<uint64_t, unsigned> NumBlocksWithHash;
+  for (BinaryBasicBlock &BB : BF) {
+    BlockOrder.push_back(&BB);
+    FlowIndex[&BB] = BlockOrder.size();
+    const uint64_t Hash = BF.computeBlockHash(BB);
+    HashToBB[Hash] = &BB;
+    ++NumBlocksWithHash[Hash];
+  }
+  DenseMap<uint64_t, unsigned> NumYamlBlocksWithHash;
+  for (const yaml::bolt::BinaryBasicBlockProfile &YamlBB : YamlBF.Blocks)
+    ++NumYamlBlocksWithHash[YamlBB.Hash];
+
+  DenseMap<uint32_t, const BinaryBasicBlock *> MatchedBlocks;
+  uint64_t NumProfiledBlocks = 0;
+  for (const yaml::bolt::BinaryBasicBlockProfile &YamlBB : YamlBF.Blocks) {
+    if (!YamlBB.ExecCount)
+      continue;
+    ++NumProfiledBlocks;
+    // A zero hash means the profile was written without block hashes.
+    if (!YamlBB.Hash || NumYamlBlocksWithHash[YamlBB.Hash] != 1 ||
+        NumBlocksWithHash.lookup(YamlBB.Hash) != 1)
+      continue;
+    MatchedBlocks[YamlBB.Index] = HashToBB[YamlBB.Hash];
+  }
+
+  uint64_t NumMatchedProfiledBlocks = 0;
+  for (const yaml::bolt::BinaryBasicBlockProfile &YamlBB : YamlBF.Blocks)
+    if (YamlBB.ExecCount && MatchedBlocks.count(YamlBB.Index))
+      ++NumMatchedProfiledBlocks;
+  if (!NumProfiledBlocks ||
+      NumMatchedProfiledBlocks * 100 <
+          NumProfiledBlocks * opts::StaleMatchingMinMatchedBlock) {
+    LLVM_DEBUG(dbgs() << "BOLT-DEBUG: matched " << NumMatchedProfiledBlocks
+                      << " of " << NumProfiledBlocks
+                      << " profiled blocks of stale function " << BF << '\n');
+    return false;
+  }
+
+  FlowFunction Func = createFlowFunction(BlockOrder, FlowIndex);
+
+  // Transfer the counts of the matched blocks and of the jumps between them.
+  for (const yaml::bolt::BinaryBasicBlockProfile &YamlBB : YamlBF.Blocks) {
+    auto BBI = MatchedBlocks.find(YamlBB.Index);
+    if (BBI == MatchedBlocks.end())
+      continue;
+    const BinaryBasicBlock *BB = BBI->second;
+    FlowBlock &Block = Func.Blocks[FlowIndex.lookup(BB)];
+    Block.Weight = YamlBB.ExecCount;
+    Block.HasUnknownWeight = false;
+
+    for (const yaml::bolt::SuccessorInfo &YamlSI : YamlBB.Successors) {
+      auto SuccI = MatchedBlocks.find(YamlSI.Index);
+      if (SuccI == MatchedBlocks.end())
+        continue;
+      for (FlowJump *Jump : Block.SuccJumps) {
+        if (Jump->Target != FlowIndex.lookup(SuccI->second))
+          continue;
+        Jump->Weight += YamlSI.Count;
+        Jump->HasUnknownWeight = false;
+      }
+    }
+  }
+
+  applyFlowInference(Func);
+
+  // Assign the inferred counts back to the function.
+  uint64_t FunctionExecutionCount = 0;
+  for (BinaryBasicBlock *BB : BlockOrder) {
+    BB->setExecutionCount(Func.Blocks[FlowIndex.lookup(BB)].Flow);
+    for (BinaryBasicBlock::BinaryBranchInfo &BI : BB->branch_info())
+      BI = {0, 0};
+  }
+  for (const FlowJump &Jump : Func.Jumps) {
+    BinaryBasicBlock *Target = BlockOrder[Jump.Target - 1];
+    if (Jump.Source == 0) {
+      if (Target->isEntryPoint())
+        FunctionExecutionCount += Jump.Flow;
+      continue;
+    }
+    BinaryBasicBlock *Source = BlockOrder[Jump.Source - 1];
+    Source->getBranchInfo(*Target).Count = Jump.Flow;
+  }
+  BF.setExecutionCount(FunctionExecutionCount);
+
+  if (opts::Verbosity >= 1)
+    errs() << "BOLT-INFO: inferred profile for stale function " << BF
+           << " from " << NumMatchedProfiledBlocks << " of "
+           << NumProfiledBlocks << " profiled blocks\n";
+  return true;
+}
+
+} // end namespace bolt
+} // end namespace llvm
@@ -20,6 +20,7 @@ namespace opts {
 
 extern cl::opt<unsigned> Verbosity;
 extern cl::OptionCategory BoltOptCategory;
+extern cl::opt<bool> InferStaleProfile;
 
 static llvm::cl::opt<bool>
     IgnoreHash("profile-ignore-hash",
@@ -95,6 +96,12 @@ bool YAMLProfileReader::parseFunctionProfile(
     ProfileMatched = false;
   }
 
+  if (!ProfileMatched && opts::InferStaleProfile &&
+      inferStaleProfile(BF, YamlBF)) {
+    BF.markProfiled(YamlBP.Header.Flags);
+    return true;
+  }
+
   BinaryFunction::BasicBlockOrderType DFSOrder = BF.dfs();
 
   for (const yaml::bolt::BinaryBasicBlockProfile &YamlBB : YamlBF.Blocks) {
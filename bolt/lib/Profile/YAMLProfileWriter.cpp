@@ -38,6 +38,7 @@ void convert(const BinaryFunction &BF,
     yaml::bolt::BinaryBasicBlockProfile YamlBB;
     YamlBB.Index = BB->getLayoutIndex();
     YamlBB.NumInstructions = BB->getNumNonPseudos();
+    YamlBB.Hash = BF.computeBlockHash(*BB);
 
     if (!LBRProfile) {
       YamlBB.EventCount = BB->getKnownExecutionCount();
@@ -3815,18 +3815,22 @@ std::vector<BinarySection *> RewriteInstance::getCodeSections() {
     if (Section.hasValidSectionID())
       CodeSections.emplace_back(&Section);
 
-  auto compareSections = [&](const BinarySection *A, const BinarySection *B) {
+  auto getSectionRank = [&](const BinarySection *Section) {
     // Place movers before anything else.
-    if (A->getName() == BC->getHotTextMoverSectionName())
-      return true;
-    if (B->getName() == BC->getHotTextMoverSectionName())
-      return false;
-
-    // Depending on the option, put main text at the beginning or at the end.
-    if (opts::HotFunctionsAtEnd)
-      return B->getName() == BC->getMainCodeSectionName();
-    else
-      return A->getName() == BC->getMainCodeSectionName();
+    if (Section->getName() == BC->getHotTextMoverSectionName())
+      return 0;
+
+    // Depending on the option, put main text at the beginning or at the end,
+    // and keep warm text next to it.
+    if (Section->getName() == BC->getMainCodeSectionName())
+      return opts::HotFunctionsAtEnd ? 3 : 1;
+    if (BC->HasWarmSection &&
+        Section->getName() == BC->getWarmCodeSectionName())
+      return 2;
+    return opts::HotFunctionsAtEnd ? 1 : 3;
+  };
+  auto compareSections = [&](const BinarySection *A, const BinarySection *B) {
+    return getSectionRank(A) < getSectionRank(B);
   };
 
   // Determine the order of sections.
@@ -4377,8 +4381,8 @@ void RewriteInstance::encodeBATSection() {
   BAT->write(*BC, DescOS);
   DescOS.flush();
 
-  const std::string BoltInfo =
-      BinarySection::encodeELFNote("BOLT", DescStr, BinarySection::NT_BOLT_BAT);
+  const std::string BoltInfo = BinarySection::encodeELFNote(
+      "BOLT", DescStr, BinarySection::NT_BOLT_BAT_COMPACT);
   BC->registerOrUpdateNoteSection(BoltAddressTranslation::SECTION_NAME,
                                   copyByteArray(BoltInfo), BoltInfo.size(),
                                   /*Alignment=*/1,
@@ -0,0 +1,75 @@
+## Check that a YAML profile collected on an older version of a function is
+## matched to the new version with -infer-stale-profile: blocks whose opcodes
+## did not change keep their counts, and the counts of the other blocks are
+## inferred from the flow.
+
+# REQUIRES: system-linux
+
+# RUN: llvm-mc -filetype=obj -triple x86_64-unknown-unknown %s -o %t.o
+# RUN: link_fdata %s %t.o %t.fdata
+# RUN: %clang %cflags %t.o -o %t.exe -Wl,-q
+# RUN: llvm-bolt %t.exe -o %t.null --data %t.fdata -w %t.yaml
+# RUN: FileCheck %s --input-file %t.yaml --check-prefix=CHECK-YAML
+
+# RUN: llvm-mc -filetype=obj -triple x86_64-unknown-unknown --defsym CHANGED=1 \
+# RUN:   %s -o %t.new.o
+# RUN: %clang %cflags %t.new.o -o %t.new.exe -Wl,-q
+
+## Without -infer-stale-profile the profile of main is stale.
+# RUN: llvm-bolt %t.new.exe -o %t.null --data %t.yaml --print-cfg \
+# RUN:   --print-only=main 2>&1 | FileCheck %s --check-prefix=CHECK-STALE \
+# RUN:   --implicit-check-not="Exec Count : 90"
+
+# RUN: llvm-bolt %t.new.exe -o %t.null --data %t.yaml --print-cfg \
+# RUN:   --print-only=main --infer-stale-profile -v=1 2>&1 | FileCheck %s \
+# RUN:   --implicit-check-not="possibly stale"
+
+# CHECK-YAML:      name: main
+# CHECK-YAML:      blocks:
+# CHECK-YAML-NEXT:   - bid: 0
+# CHECK-YAML-NEXT:     insns: 2
+# CHECK-YAML-NEXT:     hash: 0x{{[0-9A-F]+}}
+# CHECK-YAML-NEXT:     exec: 100
+
+# CHECK-STALE: BOLT-WARNING: 1 (100.0% of all profiled) function have invalid (possibly stale) profile
+
+# CHECK: BOLT-INFO: inferred profile for stale function main from 3 of 4 profiled blocks
+# CHECK: Binary Function "main" after building cfg
+# CHECK: Exec Count  : 100
+# CHECK: Exec Count : 100
+# CHECK: cmpl $0x2, %edi
+# CHECK: Exec Count : 90{{$}}
+# CHECK: testl %esi, %esi
+# CHECK: shll $0x2, %eax
+# CHECK: Exec Count : 10{{$}}
+# CHECK-NEXT: Predecessors:
+# CHECK-NEXT: imull $0x3, %edi, %eax
+# CHECK: Exec Count : 100
+# CHECK: retq
+
+    .text
+    .globl main
+    .type main, %function
+main:
+# FDATA: 0 [unknown] 0 1 main 0 0 100
+    cmpl $0x2, %edi
+.Ljl:
+    jl .Lcold
+# FDATA: 1 main #.Ljl# 1 main #.Lcold# 0 10
+.Lhot:
+    movl $0x1, %eax
+    addl %edi, %eax
+.ifdef CHANGED
+    testl %esi, %esi
+    je .Lexit
+    shll $0x2, %eax
+.endif
+.Ljmp:
+    jmp .Lexit
+# FDATA: 1 main #.Ljmp# 1 main #.Lexit# 0 90
+.Lcold:
+    imull $0x3, %edi, %eax
+.Lexit:
+    retq
+.Lend:
+    .size main, .Lend-main
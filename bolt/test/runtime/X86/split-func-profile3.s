@@ -0,0 +1,63 @@
+# Check that -split-strategy=profile3 moves the blocks that rarely execute to a
+# warm fragment, and that the warm fragment is placed between the hot and the
+# cold code.
+
+# REQUIRES: system-linux
+
+# RUN: llvm-mc -filetype=obj -triple x86_64-unknown-unknown %s -o %t.o
+# RUN: link_fdata %s %t.o %t.fdata
+# RUN: llvm-strip --strip-unneeded %t.o
+# RUN: %clang %cflags -no-pie %t.o -o %t.exe -Wl,-q
+
+# RUN: llvm-bolt %t.exe --relocs=1 --data %t.fdata --reorder-blocks=none \
+# RUN:   --split-functions --split-strategy=profile3 -o %t.out \
+# RUN:   | FileCheck %s --check-prefix=CHECK-BOLT
+# RUN: llvm-nm -n %t.out | FileCheck %s
+# RUN: %t.out
+
+# The warm fragment is chain.cold.1, and the cold one chain.cold.0.
+# CHECK-BOLT: BOLT-INFO: splitting separates
+# CHECK:      chain{{$}}
+# CHECK:      chain.cold.1
+# CHECK:      chain.cold.0
+
+  .text
+  .globl  chain
+  .type chain, %function
+  .p2align  4
+chain:
+# FDATA: 0 [unknown] 0 1 chain 0 0 100
+  cmpl  $0x1, %edi
+.J1:
+  je    .BBcold
+# FDATA: 1 chain #.J1# 1 chain #.BB1# 0 100
+.BB1:
+  testl $0x2, %edi
+.J2:
+  jne   .BBwarm
+# FDATA: 1 chain #.J2# 1 chain #.BBhot# 0 97
+# FDATA: 1 chain #.J2# 1 chain #.BBwarm# 0 3
+.BBhot:
+  movl  $0x1, %eax
+  retq
+.BBwarm:
+  movl  $0x2, %eax
+  retq
+.BBcold:
+  movl  $0x3, %eax
+  retq
+  .size chain, .-chain
+
+  .globl  main
+  .type main, %function
+  .p2align  4
+main:
+# FDATA: 0 [unknown] 0 1 main 0 0 1
+  pushq %rbp
+  movq  %rsp, %rbp
+  xorl  %edi, %edi
+  callq chain
+  xorl  %eax, %eax
+  popq  %rbp
+  retq
+  .size main, .-main
@@ -155,3 +155,22 @@ TEST_P(MCPlusBuilderTester, Annotation) {
   ASSERT_DEATH(BC->MIB->addEHInfo(Inst, MCPlus::MCLandingPad(LPSymbol, Value)),
                "annotation value out of range");
 }
+
+TEST_P(MCPlusBuilderTester, ReleaseCFGResetsPseudos) {
+  BinaryFunction *BF = BC->createInjectedBinaryFunction("BF", true);
+  BinaryBasicBlock *BB = BF->addBasicBlock();
+  MCInst Inst;
+  ASSERT_TRUE(BC->MIB->createTailCall(Inst, BC->Ctx->createNamedTempSymbol(),
+                                      BC->Ctx.get()));
+  BB->addInstruction(Inst);
+  BF->addCFIInstruction(BB, BB->begin(),
+                        MCCFIInstruction::createRestore(nullptr, 0));
+  ASSERT_EQ(BB->getNumPseudos(), 1u);
+  ASSERT_EQ(BB->getNumNonPseudos(), 1u);
+
+  // Emitting the function releases the instructions of its blocks.
+  BF->setEmitted();
+  ASSERT_EQ(BB->size(), 0u);
+  ASSERT_EQ(BB->getNumPseudos(), 0u);
+  ASSERT_EQ(BB->getNumNonPseudos(), 0u);
+}
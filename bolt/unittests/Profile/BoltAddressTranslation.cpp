@@ -0,0 +1,69 @@
+//===- bolt/unittests/Profile/BoltAddressTranslation.cpp ------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "bolt/Profile/BoltAddressTranslation.h"
+#include "bolt/Core/BinarySection.h"
+#include "llvm/Support/LEB128.h"
+#include "llvm/Support/raw_ostream.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace llvm::bolt;
+
+namespace {
+
+// Tables for a hot function at 0x1000 with a cold fragment above 4 GiB:
+//   0x1000: 0x0 -> 0x0, 0x10 -> 0x24 (branch), 0x20 -> 0x8
+//   0x100002000: 0x0 -> 0x40
+std::string encodeCompactBAT() {
+  std::string DescStr;
+  raw_string_ostream OS(DescStr);
+  encodeULEB128(2, OS);
+
+  encodeULEB128(0x1000, OS);
+  encodeULEB128(3, OS);
+  encodeULEB128(0x0, OS);
+  encodeSLEB128(0x0, OS);
+  encodeULEB128(0x10, OS);
+  encodeSLEB128(0x24 << 1 | 1, OS);
+  encodeULEB128(0x10, OS);
+  encodeSLEB128((0x8 << 1) - (0x24 << 1 | 1), OS);
+
+  encodeULEB128(0x100002000 - 0x1000, OS);
+  encodeULEB128(1, OS);
+  encodeULEB128(0x0, OS);
+  encodeSLEB128(0x40 << 1, OS);
+
+  encodeULEB128(1, OS);
+  encodeULEB128(0x100002000, OS);
+  encodeSLEB128(0x1000 - 0x100002000LL, OS);
+  OS.flush();
+  return BinarySection::encodeELFNote("BOLT", DescStr,
+                                      BinarySection::NT_BOLT_BAT_COMPACT);
+}
+
+} // namespace
+
+TEST(BoltAddressTranslationTest, ParseCompact) {
+  const std::string Note = encodeCompactBAT();
+  BoltAddressTranslation BAT;
+  ASSERT_FALSE(BAT.parse(Note));
+
+  EXPECT_EQ(BAT.translate(0x1000, 0x4, /*IsBranchSrc=*/false), 0x4u);
+  EXPECT_EQ(BAT.translate(0x1000, 0x12, /*IsBranchSrc=*/false), 0x26u);
+  EXPECT_EQ(BAT.translate(0x1000, 0x12, /*IsBranchSrc=*/true), 0x24u);
+  EXPECT_EQ(BAT.translate(0x1000, 0x28, /*IsBranchSrc=*/false), 0x10u);
+  EXPECT_EQ(BAT.translate(0x100002000, 0x4, /*IsBranchSrc=*/false), 0x44u);
+  EXPECT_EQ(BAT.fetchParentAddress(0x100002000), 0x1000u);
+}
+
+TEST(BoltAddressTranslationTest, ParseTruncatedCompact) {
+  const std::string Note = encodeCompactBAT();
+  BoltAddressTranslation BAT;
+  EXPECT_TRUE(BAT.parse(StringRef(Note).drop_back(4)));
+}
@@ -410,6 +410,7 @@ ClangTidyASTConsumerFactory::createASTConsumer(
     Profiling = std::make_unique<ClangTidyProfiling>(
         Context.getProfileStorageParams());
     FinderOptions.CheckProfiling.emplace(Profiling->Records);
+    FinderOptions.CheckProfiling->PerMatcher = Context.getProfilePerMatcher();
   }
 
   std::unique_ptr<ast_matchers::MatchFinder> Finder(
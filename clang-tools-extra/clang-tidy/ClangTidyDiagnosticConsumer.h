@@ -168,6 +168,10 @@ public:
   void setEnableProfiling(bool Profile);
   bool getEnableProfiling() const { return Profile; }
 
+  /// Control whether profiles break the time of each check down by matcher.
+  void setProfilePerMatcher(bool PerMatcher) { ProfilePerMatcher = PerMatcher; }
+  bool getProfilePerMatcher() const { return ProfilePerMatcher; }
+
   /// Control storage of profile date.
   void setProfileStoragePrefix(StringRef ProfilePrefix);
   std::optional<ClangTidyProfiling::StorageParams>
@@ -230,6 +234,7 @@ private:
   llvm::DenseMap<unsigned, std::string> CheckNamesByDiagnosticID;
 
   bool Profile;
+  bool ProfilePerMatcher = false;
   std::string ProfilePrefix;
 
   bool AllowEnablingAnalyzerAlphaCheckers;
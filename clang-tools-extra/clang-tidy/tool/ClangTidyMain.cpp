@@ -235,6 +235,15 @@ report to stderr.
                                         cl::init(false),
                                         cl::cat(ClangTidyCategory));
 
+static cl::opt<bool> CheckProfilePerMatcher("check-profile-per-matcher",
+                                            desc(R"(
+When used with -enable-check-profile, report the
+time spent in each matcher a check registers
+separately, as <check>.matcher<N>.<node kind>.
+)"),
+                                            cl::init(false),
+                                            cl::cat(ClangTidyCategory));
+
 static cl::opt<std::string> StoreCheckProfile("store-check-profile", desc(R"(
 By default reports are printed in tabulated
 format to stderr. When this option is passed,
@@ -623,6 +632,7 @@ int clangTidyMain(int argc, const char **argv) {
 
   ClangTidyContext Context(std::move(OwningOptionsProvider),
                            AllowEnablingAnalyzerAlphaCheckers);
+  Context.setProfilePerMatcher(CheckProfilePerMatcher);
   std::vector<ClangTidyError> Errors =
       runClangTidy(Context, OptionsParser->getCompilations(), PathList, BaseFS,
                    FixNotes, EnableCheckProfile, ProfilePrefix);
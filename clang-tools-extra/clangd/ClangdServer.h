@@ -114,6 +114,9 @@ public:
     /// on background threads. The index is stored in the project root.
     bool BackgroundIndex = false;
     llvm::ThreadPriority BackgroundIndexPriority = llvm::ThreadPriority::Low;
+    /// If true, the background index runs fewer indexing tasks while the
+    /// system is overloaded.
+    bool BackgroundIndexThrottle = false;
 
     /// If set, use this index to augment code completion results.
     SymbolIndex *StaticIndex = nullptr;
@@ -32,10 +32,10 @@
 #include "clang/Basic/SourceManager.h"
 #include "clang/Frontend/FrontendAction.h"
 #include "llvm/ADT/ArrayRef.h"
-#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/StringSet.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Threading.h"
@@ -44,6 +44,7 @@
 #include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <cmath>
 #include <condition_variable>
 #include <cstddef>
 #include <memory>
@@ -105,6 +106,17 @@ BackgroundIndex::BackgroundIndex(
           })) {
   assert(Opts.ThreadPoolSize > 0 && "Thread pool size can't be zero.");
   assert(this->IndexStorageFactory && "Storage factory can not be null!");
+  if (Opts.ThrottleOnSystemLoad)
+    Queue.setThrottle([Workers = unsigned(Opts.ThreadPoolSize)]() -> unsigned {
+      // Give up one indexing slot for each unit of load beyond the number of
+      // cores, so that foreground work such as a build is not starved.
+      std::optional<double> Load = getSystemLoadAverage();
+      unsigned Cores = std::max(std::thread::hardware_concurrency(), 1u);
+      if (!Load || *Load <= Cores)
+        return Workers;
+      unsigned Excess = std::ceil(*Load - Cores);
+      return Workers > Excess ? Workers - Excess : 1;
+    });
   for (unsigned I = 0; I < Opts.ThreadPoolSize; ++I) {
     ThreadPool.runAsync("background-worker-" + llvm::Twine(I + 1),
                         [this, Ctx(Context::current().clone())]() mutable {
@@ -168,6 +180,7 @@ BackgroundQueue::Task BackgroundIndex::indexFileTask(std::string Path) {
   });
   T.QueuePri = IndexFile;
   T.ThreadPri = IndexingPriority;
+  T.Throttled = true;
   T.Tag = std::move(Tag);
   T.Key = Key;
   return T;
@@ -363,59 +376,67 @@ BackgroundIndex::loadProject(std::vector<std::string> MainFiles) {
              Config::BackgroundPolicy::Skip;
     });
   Rebuilder.startLoading();
-  // Load shards for all of the mainfiles.
-  const std::vector<LoadedShard> Result =
-      loadIndexShards(MainFiles, IndexStorageFactory, CDB);
-  size_t LoadedShards = 0;
-  {
-    // Update in-memory state.
-    std::lock_guard<std::mutex> Lock(ShardVersionsMu);
-    for (auto &LS : Result) {
-      if (!LS.Shard)
-        continue;
-      auto SS =
-          LS.Shard->Symbols
-              ? std::make_unique<SymbolSlab>(std::move(*LS.Shard->Symbols))
-              : nullptr;
-      auto RS = LS.Shard->Refs
-                    ? std::make_unique<RefSlab>(std::move(*LS.Shard->Refs))
-                    : nullptr;
-      auto RelS =
-          LS.Shard->Relations
-              ? std::make_unique<RelationSlab>(std::move(*LS.Shard->Relations))
-              : nullptr;
-      ShardVersion &SV = ShardVersions[LS.AbsolutePath];
-      SV.Digest = LS.Digest;
-      SV.HadErrors = LS.HadErrors;
-      ++LoadedShards;
-
-      IndexedSymbols.update(URI::create(LS.AbsolutePath).toString(),
-                            std::move(SS), std::move(RS), std::move(RelS),
-                            LS.CountReferences);
-    }
-  }
-  Rebuilder.loadedShard(LoadedShards);
-  Rebuilder.doneLoading();
-
   auto FS = TFS.view(/*CWD=*/std::nullopt);
-  llvm::DenseSet<PathRef> TUsToIndex;
-  // We'll accept data from stale shards, but ensure the files get reindexed
-  // soon.
-  for (auto &LS : Result) {
-    if (!shardIsStale(LS, FS.get()))
-      continue;
-    PathRef TUForFile = LS.DependentTU;
-    assert(!TUForFile.empty() && "File without a TU!");
-
-    // FIXME: Currently, we simply schedule indexing on a TU whenever any of
-    // its dependencies needs re-indexing. We might do it smarter by figuring
-    // out a minimal set of TUs that will cover all the stale dependencies.
-    // FIXME: Try looking at other TUs if no compile commands are available
-    // for this TU, i.e TU was deleted after we performed indexing.
-    TUsToIndex.insert(TUForFile);
-  }
+  llvm::StringSet<> TUsToIndex;
+  // Load shards for all of the mainfiles. Each batch is published as soon as
+  // it has been read, so that the rebuilder can serve a partial index while a
+  // large project is still loading.
+  loadIndexShards(
+      MainFiles, IndexStorageFactory, CDB, [&](std::vector<LoadedShard> Batch) {
+        size_t LoadedShards = 0;
+        {
+          // Update in-memory state.
+          std::lock_guard<std::mutex> Lock(ShardVersionsMu);
+          for (auto &LS : Batch) {
+            if (!LS.Shard)
+              continue;
+            auto SS = LS.Shard->Symbols ? std::make_unique<SymbolSlab>(
+                                              std::move(*LS.Shard->Symbols))
+                                        : nullptr;
+            auto RS = LS.Shard->Refs
+                          ? std::make_unique<RefSlab>(std::move(*LS.Shard->Refs))
+                          : nullptr;
+            auto RelS = LS.Shard->Relations
+                            ? std::make_unique<RelationSlab>(
+                                  std::move(*LS.Shard->Relations))
+                            : nullptr;
+            ShardVersion &SV = ShardVersions[LS.AbsolutePath];
+            SV.Digest = LS.Digest;
+            SV.HadErrors = LS.HadErrors;
+            ++LoadedShards;
+
+            IndexedSymbols.update(URI::create(LS.AbsolutePath).toString(),
+                                  std::move(SS), std::move(RS), std::move(RelS),
+                                  LS.CountReferences);
+          }
+        }
+        Rebuilder.loadedShard(LoadedShards);
+
+        // We'll accept data from stale shards, but ensure the files get
+        // reindexed soon.
+        for (auto &LS : Batch) {
+          if (!shardIsStale(LS, FS.get()))
+            continue;
+          PathRef TUForFile = LS.DependentTU;
+          assert(!TUForFile.empty() && "File without a TU!");
+
+          // FIXME: Currently, we simply schedule indexing on a TU whenever any
+          // of its dependencies needs re-indexing. We might do it smarter by
+          // figuring out a minimal set of TUs that will cover all the stale
+          // dependencies.
+          // FIXME: Try looking at other TUs if no compile commands are
+          // available for this TU, i.e TU was deleted after we performed
+          // indexing.
+          TUsToIndex.insert(TUForFile);
+        }
+      });
+  Rebuilder.doneLoading();
 
-  return {TUsToIndex.begin(), TUsToIndex.end()};
+  std::vector<std::string> Result;
+  Result.reserve(TUsToIndex.size());
+  for (const auto &TU : TUsToIndex)
+    Result.push_back(TU.getKey().str());
+  return Result;
 }
 
 void BackgroundIndex::profile(MemoryTree &MT) const {
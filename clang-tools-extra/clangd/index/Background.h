@@ -78,6 +78,8 @@ public:
     std::string Tag;       // Allows priority to be boosted later.
     uint64_t Key = 0;      // If the key matches a previous task, drop this one.
                            // (in practice this means we never reindex a file).
+    bool Throttled = false; // Whether the queue's throttle applies to this task
+                            // (used for CPU-bound work such as parsing).
 
     bool operator<(const Task &O) const { return QueuePri < O.QueuePri; }
   };
@@ -108,6 +110,12 @@ public:
   // Stop processing new tasks, allowing all work() calls to return soon.
   void stop();
 
+  // Limits how many throttled tasks may run concurrently. The limit is
+  // re-evaluated before starting a throttled task, and at least once a second
+  // while such a task is waiting; it is always treated as at least one.
+  // Tasks that are not throttled still run on any idle worker.
+  void setThrottle(std::function<unsigned()> MaxThrottledTasks);
+
   // Disables thread priority lowering to ensure progress on loaded systems.
   // Only affects tasks that run after the call.
   static void preventThreadStarvationInTests();
@@ -117,6 +125,7 @@ public:
 private:
   void notifyProgress() const; // Requires lock Mu
   bool adjust(Task &T);
+  bool isThrottled(const Task &T) const; // Requires lock Mu
 
   std::mutex Mu;
   Stats Stat;
@@ -126,6 +135,8 @@ private:
   llvm::StringMap<unsigned> Boosts;
   std::function<void(Stats)> OnProgress;
   llvm::DenseSet<uint64_t> SeenKeys;
+  std::function<unsigned()> Throttle;
+  unsigned ActiveThrottled = 0;
 };
 
 // Builds an in-memory index by by running the static indexer action over
@@ -145,6 +156,10 @@ public:
     // file. Called with the empty string for other tasks.
     // (When called, the context from BackgroundIndex construction is active).
     std::function<Context(PathRef)> ContextProvider = nullptr;
+    // Whether to run fewer concurrent indexing tasks while the system load
+    // exceeds the number of available cores, e.g. during a foreground build.
+    // Loading shards from disk is not affected.
+    bool ThrottleOnSystemLoad = false;
   };
 
   /// Creates a new background index and starts its threads.
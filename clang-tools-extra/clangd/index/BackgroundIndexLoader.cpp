@@ -11,7 +11,7 @@
 #include "index/Background.h"
 #include "support/Logger.h"
 #include "support/Path.h"
-#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringSet.h"
 #include "llvm/Support/Path.h"
 #include <string>
 #include <utility>
@@ -30,38 +30,38 @@ public:
   /// Load the shards for \p MainFile and all of its dependencies.
   void load(PathRef MainFile);
 
-  /// Consumes the loader and returns all shards.
-  std::vector<LoadedShard> takeResult() &&;
+  /// Returns the shards loaded since the last call.
+  std::vector<LoadedShard> takeLoadedShards();
 
 private:
-  /// Returns the Shard for \p StartSourceFile from cache or loads it from \p
-  /// Storage. Also returns paths for dependencies of \p StartSourceFile if it
-  /// wasn't cached yet.
-  std::pair<const LoadedShard &, std::vector<Path>>
-  loadShard(PathRef StartSourceFile, PathRef DependentTU);
+  /// Loads the Shard for \p StartSourceFile from \p Storage, unless it was
+  /// already visited. Returns paths for dependencies of \p StartSourceFile if
+  /// it wasn't visited yet.
+  std::vector<Path> loadShard(PathRef StartSourceFile, PathRef DependentTU);
 
-  /// Cache for Storage lookups.
-  llvm::StringMap<LoadedShard> LoadedShards;
+  /// Files whose shards were already looked up in storage.
+  llvm::StringSet<> VisitedFiles;
+  /// Shards loaded since the last call to takeLoadedShards().
+  std::vector<LoadedShard> Pending;
 
   BackgroundIndexStorage::Factory &IndexStorageFactory;
 };
 
-std::pair<const LoadedShard &, std::vector<Path>>
-BackgroundIndexLoader::loadShard(PathRef StartSourceFile, PathRef DependentTU) {
-  auto It = LoadedShards.try_emplace(StartSourceFile);
-  LoadedShard &LS = It.first->getValue();
+std::vector<Path> BackgroundIndexLoader::loadShard(PathRef StartSourceFile,
+                                                   PathRef DependentTU) {
   std::vector<Path> Edges = {};
-  // Return the cached shard.
-  if (!It.second)
-    return {LS, Edges};
+  // Return if the shard was already loaded.
+  if (!VisitedFiles.insert(StartSourceFile).second)
+    return Edges;
 
+  LoadedShard &LS = Pending.emplace_back();
   LS.AbsolutePath = StartSourceFile.str();
   LS.DependentTU = std::string(DependentTU);
   BackgroundIndexStorage *Storage = IndexStorageFactory(LS.AbsolutePath);
   auto Shard = Storage->loadShard(StartSourceFile);
   if (!Shard || !Shard->Sources) {
     vlog("Failed to load shard: {0}", StartSourceFile);
-    return {LS, Edges};
+    return Edges;
   }
 
   LS.Shard = std::move(Shard);
@@ -84,7 +84,7 @@ BackgroundIndexLoader::loadShard(PathRef StartSourceFile, PathRef DependentTU) {
     LS.HadErrors = IGN.Flags & IncludeGraphNode::SourceFlag::HadErrors;
   }
   assert(LS.Digest != FileDigest{{0}} && "Digest is empty?");
-  return {LS, Edges};
+  return Edges;
 }
 
 void BackgroundIndexLoader::load(PathRef MainFile) {
@@ -98,8 +98,7 @@ void BackgroundIndexLoader::load(PathRef MainFile) {
     PathRef SourceFile = ToVisit.front();
     ToVisit.pop();
 
-    auto ShardAndEdges = loadShard(SourceFile, MainFile);
-    for (PathRef Edge : ShardAndEdges.second) {
+    for (PathRef Edge : loadShard(SourceFile, MainFile)) {
       auto It = InQueue.insert(Edge);
       if (It.second)
         ToVisit.push(It.first->getKey());
@@ -107,25 +106,26 @@ void BackgroundIndexLoader::load(PathRef MainFile) {
   }
 }
 
-std::vector<LoadedShard> BackgroundIndexLoader::takeResult() && {
+std::vector<LoadedShard> BackgroundIndexLoader::takeLoadedShards() {
   std::vector<LoadedShard> Result;
-  Result.reserve(LoadedShards.size());
-  for (auto &It : LoadedShards)
-    Result.push_back(std::move(It.getValue()));
+  Result.swap(Pending);
   return Result;
 }
 } // namespace
 
-std::vector<LoadedShard>
-loadIndexShards(llvm::ArrayRef<Path> MainFiles,
-                BackgroundIndexStorage::Factory &IndexStorageFactory,
-                const GlobalCompilationDatabase &CDB) {
+void loadIndexShards(
+    llvm::ArrayRef<Path> MainFiles,
+    BackgroundIndexStorage::Factory &IndexStorageFactory,
+    const GlobalCompilationDatabase &CDB,
+    llvm::function_ref<void(std::vector<LoadedShard>)> OnLoaded) {
   BackgroundIndexLoader Loader(IndexStorageFactory);
   for (llvm::StringRef MainFile : MainFiles) {
     assert(llvm::sys::path::is_absolute(MainFile));
     Loader.load(MainFile);
+    std::vector<LoadedShard> Shards = Loader.takeLoadedShards();
+    if (!Shards.empty())
+      OnLoaded(std::move(Shards));
   }
-  return std::move(Loader).takeResult();
 }
 
 } // namespace clangd
@@ -12,6 +12,7 @@
 #include "index/Background.h"
 #include "support/Path.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/STLFunctionalExtras.h"
 #include <memory>
 #include <vector>
 
@@ -37,11 +38,16 @@ struct LoadedShard {
   std::unique_ptr<IndexFileIn> Shard;
 };
 
-/// Loads all shards for the TU \p MainFile from \p Storage.
-std::vector<LoadedShard>
-loadIndexShards(llvm::ArrayRef<Path> MainFiles,
-                BackgroundIndexStorage::Factory &IndexStorageFactory,
-                const GlobalCompilationDatabase &CDB);
+/// Loads all shards for the TUs \p MainFiles and their dependencies from
+/// storage. Shards are handed to \p OnLoaded in batches as soon as each TU
+/// has been processed, so callers can make them available incrementally
+/// rather than holding the whole project in memory first. Every file is
+/// reported at most once, even if several TUs depend on it.
+void loadIndexShards(
+    llvm::ArrayRef<Path> MainFiles,
+    BackgroundIndexStorage::Factory &IndexStorageFactory,
+    const GlobalCompilationDatabase &CDB,
+    llvm::function_ref<void(std::vector<LoadedShard>)> OnLoaded);
 
 } // namespace clangd
 } // namespace clang
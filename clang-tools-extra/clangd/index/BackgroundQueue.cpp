@@ -24,7 +24,14 @@ void BackgroundQueue::work(std::function<void()> OnIdle) {
     std::optional<Task> Task;
     {
       std::unique_lock<std::mutex> Lock(Mu);
-      CV.wait(Lock, [&] { return ShouldStop || !Queue.empty(); });
+      while (true) {
+        CV.wait(Lock, [&] { return ShouldStop || !Queue.empty(); });
+        if (ShouldStop || !isThrottled(Queue.front()))
+          break;
+        // The throttle may depend on external state such as the system load,
+        // so poll it even if no other task finishes.
+        CV.wait_for(Lock, std::chrono::seconds(1));
+      }
       if (ShouldStop) {
         Queue.clear();
         CV.notify_all();
@@ -34,6 +41,8 @@ void BackgroundQueue::work(std::function<void()> OnIdle) {
       std::pop_heap(Queue.begin(), Queue.end());
       Task = std::move(Queue.back());
       Queue.pop_back();
+      if (Task->Throttled)
+        ++ActiveThrottled;
       notifyProgress();
     }
 
@@ -47,6 +56,8 @@ void BackgroundQueue::work(std::function<void()> OnIdle) {
     {
       std::unique_lock<std::mutex> Lock(Mu);
       ++Stat.Completed;
+      if (Task->Throttled)
+        --ActiveThrottled;
       if (Stat.Active == 1 && Queue.empty()) {
         // We just finished the last item, the queue is going idle.
         assert(ShouldStop || Stat.Completed == Stat.Enqueued);
@@ -74,6 +85,20 @@ void BackgroundQueue::stop() {
 }
 
 // Tweaks the priority of a newly-enqueued task, or returns false to cancel it.
+void BackgroundQueue::setThrottle(std::function<unsigned()> MaxThrottledTasks) {
+  {
+    std::lock_guard<std::mutex> Lock(Mu);
+    Throttle = std::move(MaxThrottledTasks);
+  }
+  CV.notify_all();
+}
+
+bool BackgroundQueue::isThrottled(const Task &T) const {
+  if (!T.Throttled || !Throttle)
+    return false;
+  return ActiveThrottled >= std::max(Throttle(), 1u);
+}
+
 bool BackgroundQueue::adjust(Task &T) {
   // It is tempting to drop duplicates of queued tasks, and merely deprioritize
   // duplicates of completed tasks (i.e. reindexing on CDB changes). But:
@@ -53,14 +53,25 @@ void BackgroundIndexRebuilder::idle() {
 
 void BackgroundIndexRebuilder::startLoading() {
   std::lock_guard<std::mutex> Lock(Mu);
-  if (!Loading)
+  if (!Loading) {
     LoadedShards = 0;
+    LoadedShardsAtNextRebuild = ShardsBeforeLoadingRebuild;
+  }
   ++Loading;
 }
 void BackgroundIndexRebuilder::loadedShard(size_t ShardCount) {
-  std::lock_guard<std::mutex> Lock(Mu);
-  assert(Loading);
-  LoadedShards += ShardCount;
+  maybeRebuild("while loading index from disk", [this, ShardCount] {
+    assert(Loading);
+    LoadedShards += ShardCount;
+    if (LoadedShards < LoadedShardsAtNextRebuild)
+      return false;
+    if (ActiveVersion != StartedVersion) // currently building
+      return false;
+    // Serve what has been loaded so far. Doubling the threshold keeps the
+    // total cost of these rebuilds proportional to the final index size.
+    LoadedShardsAtNextRebuild = 2 * LoadedShards;
+    return true;
+  });
 }
 void BackgroundIndexRebuilder::doneLoading() {
   maybeRebuild("after loading index from disk", [this] {
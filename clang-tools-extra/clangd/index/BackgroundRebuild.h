@@ -61,6 +61,8 @@ public:
   // sessions may happen concurrently.
   void startLoading();
   // Called to indicate some shards were actually loaded from disk.
+  // May rebuild, if enough shards were loaded since the last rebuild, so that
+  // large indexes become partially available before loading finishes.
   void loadedShard(size_t ShardCount);
   // Called to indicate we're finished loading shards from disk.
   // May rebuild (if any were loaded).
@@ -72,6 +74,10 @@ public:
   // Thresholds for rebuilding as TUs get indexed. Exposed for testing.
   const unsigned TUsBeforeFirstBuild; // Typically one per worker thread.
   const unsigned TUsBeforeRebuild = 100;
+  // Threshold for the first rebuild while loading shards. Later rebuilds in
+  // the same loading session happen each time the number of loaded shards
+  // doubles. Exposed for testing.
+  const unsigned ShardsBeforeLoadingRebuild = 5000;
 
 private:
   // Run Check under the lock, and rebuild if it returns true.
@@ -90,6 +96,7 @@ private:
   // Are we loading shards? May be multiple concurrent sessions.
   unsigned Loading = 0;
   unsigned LoadedShards; // In the current loading session.
+  unsigned LoadedShardsAtNextRebuild;
 
   SwapIndex *Target;
   FileSymbols *Source;
@@ -12,6 +12,7 @@
 #include "llvm/Support/Threading.h"
 #include "llvm/Support/thread.h"
 #include <atomic>
+#include <cstdlib>
 #include <optional>
 #include <thread>
 #ifdef __USE_POSIX
@@ -127,6 +128,15 @@ void wait(std::unique_lock<std::mutex> &Lock, std::condition_variable &CV,
   CV.wait_until(Lock, D.time());
 }
 
+std::optional<double> getSystemLoadAverage() {
+#if defined(__USE_POSIX) || defined(__APPLE__)
+  double Load;
+  if (getloadavg(&Load, 1) == 1)
+    return Load;
+#endif
+  return std::nullopt;
+}
+
 bool PeriodicThrottler::operator()() {
   Rep Now = Stopwatch::now().time_since_epoch().count();
   Rep OldNext = Next.load(std::memory_order_acquire);
@@ -172,6 +172,10 @@ public:
   }
 };
 
+/// Returns the system's one-minute load average, or std::nullopt if it is not
+/// available on this platform.
+std::optional<double> getSystemLoadAverage();
+
 /// Used to guard an operation that should run at most every N seconds.
 ///
 /// Usage:
@@ -183,6 +183,14 @@ opt<llvm::ThreadPriority> BackgroundIndexPriority{
     init(llvm::ThreadPriority::Low),
 };
 
+opt<bool> BackgroundIndexThrottle{
+    "background-index-throttle",
+    cat(Features),
+    desc("Run fewer background indexing tasks while the system load exceeds "
+         "the number of cores, e.g. during a build"),
+    init(false),
+};
+
 opt<bool> EnableClangTidy{
     "clang-tidy",
     cat(Features),
@@ -901,6 +909,7 @@ clangd accepts flags on the commandline, and in the CLANGD_FLAGS environment var
 #endif
   Opts.BackgroundIndex = EnableBackgroundIndex;
   Opts.BackgroundIndexPriority = BackgroundIndexPriority;
+  Opts.BackgroundIndexThrottle = BackgroundIndexThrottle;
   Opts.ReferencesLimit = ReferencesLimit;
   Opts.Rename.LimitFiles = RenameFileLimit;
   auto PAI = createProjectAwareIndex(loadExternalIndex, Sync);
@@ -757,6 +757,20 @@ TEST_F(BackgroundIndexRebuilderTest, LoadingShards) {
   EXPECT_TRUE(checkRebuild([&] { Rebuilder.doneLoading(); }));
 }
 
+TEST_F(BackgroundIndexRebuilderTest, LoadingShardsIncrementally) {
+  Rebuilder.startLoading();
+  EXPECT_FALSE(checkRebuild(
+      [&] { Rebuilder.loadedShard(Rebuilder.ShardsBeforeLoadingRebuild - 1); }));
+  EXPECT_TRUE(checkRebuild([&] { Rebuilder.loadedShard(1); }));
+  // The next rebuild waits until the number of loaded shards has doubled.
+  EXPECT_FALSE(checkRebuild(
+      [&] { Rebuilder.loadedShard(Rebuilder.ShardsBeforeLoadingRebuild - 1); }));
+  EXPECT_TRUE(checkRebuild([&] { Rebuilder.loadedShard(1); }));
+  EXPECT_FALSE(checkRebuild([&] { Rebuilder.loadedShard(1); }));
+  // Loading still finishes with a rebuild.
+  EXPECT_TRUE(checkRebuild([&] { Rebuilder.doneLoading(); }));
+}
+
 TEST(BackgroundQueueTest, Priority) {
   // Create high and low priority tasks.
   // Once a bunch of high priority tasks have run, the queue is stopped.
@@ -789,6 +803,36 @@ TEST(BackgroundQueueTest, Priority) {
   EXPECT_EQ(LoRan, 0u);
 }
 
+TEST(BackgroundQueueTest, Throttle) {
+  // With a throttle of one, throttled tasks never overlap, while other tasks
+  // still run on the remaining workers.
+  BackgroundQueue Q;
+  Q.setThrottle([] { return 1u; });
+  std::atomic<unsigned> Running(0), MaxRunning(0), OtherRan(0);
+  BackgroundQueue::Task Throttled([&] {
+    unsigned Now = ++Running;
+    unsigned Max = MaxRunning.load();
+    while (Now > Max && !MaxRunning.compare_exchange_weak(Max, Now))
+      ;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    --Running;
+  });
+  Throttled.Throttled = true;
+  BackgroundQueue::Task Other([&] { ++OtherRan; });
+
+  Q.append(std::vector<BackgroundQueue::Task>(20, Throttled));
+  Q.append(std::vector<BackgroundQueue::Task>(5, Other));
+
+  AsyncTaskRunner ThreadPool;
+  for (unsigned I = 0; I < 4; ++I)
+    ThreadPool.runAsync("worker", [&] { Q.work(); });
+  EXPECT_TRUE(Q.blockUntilIdleForTest(60));
+  Q.stop();
+  ThreadPool.wait();
+  EXPECT_EQ(MaxRunning, 1u);
+  EXPECT_EQ(OtherRan, 5u);
+}
+
 TEST(BackgroundQueueTest, Boost) {
   std::string Sequence;
 
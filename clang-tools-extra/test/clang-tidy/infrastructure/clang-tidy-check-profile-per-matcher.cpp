@@ -0,0 +1,16 @@
+// RUN: clang-tidy -enable-check-profile -check-profile-per-matcher -checks='-*,readability-function-size' %s -- 2>&1 | FileCheck --match-full-lines -implicit-check-not='{{warning:|error:}}' %s
+
+// CHECK: ===-------------------------------------------------------------------------===
+// CHECK-NEXT:                          clang-tidy checks profiling
+// CHECK-NEXT: ===-------------------------------------------------------------------------===
+// CHECK-NEXT: Total Execution Time: {{.*}} seconds ({{.*}} wall clock)
+
+// CHECK: {{.*}}  --- Name ---
+// CHECK-DAG: {{.*}}  readability-function-size
+// CHECK-DAG: {{.*}}  readability-function-size.matcher0.FunctionDecl
+// CHECK: {{.*}}  Total
+
+class A {
+  A() {}
+  ~A() {}
+};
@@ -34,7 +34,7 @@
  * compatible, thus CINDEX_VERSION_MAJOR is expected to remain stable.
  */
 #define CINDEX_VERSION_MAJOR 0
-#define CINDEX_VERSION_MINOR 63
+#define CINDEX_VERSION_MINOR 64
 
 #define CINDEX_VERSION_ENCODE(major, minor) (((major)*10000) + ((minor)*1))
 
@@ -263,6 +263,10 @@ enum CXCursor_ExceptionSpecificationKind {
  * This process of creating the 'pch', loading it separately, and using it (via
  * -include-pch) allows 'excludeDeclsFromPCH' to remove redundant callbacks
  * (which gives the indexer the same performance benefit as the compiler).
+ *
+ * Translation units may be parsed concurrently from several threads with the
+ * same index, as long as the index's options are not changed at the same
+ * time. A translation unit itself must only be used by one thread at a time.
  */
 CINDEX_LINKAGE CXIndex clang_createIndex(int excludeDeclarationsFromPCH,
                                          int displayDiagnostics);
@@ -305,7 +309,21 @@ typedef enum {
    */
   CXGlobalOpt_ThreadBackgroundPriorityForAll =
       CXGlobalOpt_ThreadBackgroundPriorityForIndexing |
-      CXGlobalOpt_ThreadBackgroundPriorityForEditing
+      CXGlobalOpt_ThreadBackgroundPriorityForEditing,
+
+  /**
+   * Used to indicate that the results of file system lookups (whether a file
+   * exists, its size and modification time) should be cached in the index and
+   * shared between all translation units parsed with it.
+   *
+   * This avoids repeating the same lookups of headers and include directories
+   * for every translation unit, but it assumes that files on disk do not
+   * change while the index is alive, including when translation units are
+   * reparsed. Unsaved files are not affected.
+   *
+   * Affects #clang_parseTranslationUnit.
+   */
+  CXGlobalOpt_CacheFileSystemStatus = 0x4
 
 } CXGlobalOptFlags;
 
@@ -624,6 +624,11 @@ private:
   std::unique_ptr<interp::Context> InterpContext;
   std::unique_ptr<ParentMapContext> ParentMapCtx;
 
+  /// Results of successful constant evaluations of calls to functions taking
+  /// and returning scalars, keyed by the callee and the argument values, with
+  /// the number of evaluation steps that they took.
+  mutable llvm::StringMap<std::pair<APValue, unsigned>> ConstexprCallResults;
+
   /// Keeps track of the deallocated DeclListNodes for future reuse.
   DeclListNode *ListNodeFreeList = nullptr;
 
@@ -639,6 +644,13 @@ public:
   /// Returns the clang bytecode interpreter context.
   interp::Context &getInterpContext();
 
+  /// Returns the cache of constexpr call results used by the constant
+  /// evaluator.
+  llvm::StringMap<std::pair<APValue, unsigned>> &
+  getConstexprCallResults() const {
+    return ConstexprCallResults;
+  }
+
   struct CUDAConstantEvalContext {
     /// Do not allow wrong-sided variables in constant expressions.
     bool NoWrongSidedVars = false;
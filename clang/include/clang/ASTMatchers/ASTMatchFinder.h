@@ -133,6 +133,16 @@ public:
 
       /// Per bucket timing information.
       llvm::StringMap<llvm::TimeRecord> &Records;
+
+      /// Record the time spent in each registered matcher separately, instead
+      /// of accumulating it in a single bucket per callback.
+      ///
+      /// Matcher buckets are named "<ID>.matcher<N>.<Kind>", where \c ID is
+      /// the callback's \c getID(), \c N is the index of the matcher among
+      /// those registered for that callback and \c Kind is the node kind the
+      /// matcher runs on. Time spent in \c onStartOfTranslationUnit() and
+      /// \c onEndOfTranslationUnit() is still recorded under \c ID.
+      bool PerMatcher = false;
     };
 
     /// Enables per-check timers.
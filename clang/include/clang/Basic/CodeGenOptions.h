@@ -55,13 +55,14 @@ public:
   };
 
   enum VectorLibrary {
-    NoLibrary,         // Don't use any vector library.
-    Accelerate,        // Use the Accelerate framework.
-    LIBMVEC,           // GLIBC vector math library.
-    MASSV,             // IBM MASS vector library.
-    SVML,              // Intel short vector math library.
-    SLEEF,             // SLEEF SIMD Library for Evaluating Elementary Functions.
-    Darwin_libsystem_m // Use Darwin's libsytem_m vector functions.
+    NoLibrary,          // Don't use any vector library.
+    Accelerate,         // Use the Accelerate framework.
+    LIBMVEC,            // GLIBC vector math library.
+    MASSV,              // IBM MASS vector library.
+    SVML,               // Intel short vector math library.
+    SLEEF,              // SLEEF SIMD Library for Evaluating Elementary Functions.
+    Darwin_libsystem_m, // Use Darwin's libsytem_m vector functions.
+    LLVMLIBC            // LLVM libc vector math functions.
   };
 
   enum ObjCDispatchMethodKind {
@@ -507,6 +507,10 @@ public:
   /// Path which stores the output files for -ftime-trace
   std::string TimeTracePath;
 
+  /// Directory of the compilation cache, or empty if compilations are not
+  /// cached.
+  std::string CompilationCachePath;
+
 public:
   FrontendOptions()
       : DisableFree(false), RelocatablePCH(false), ShowHelp(false),
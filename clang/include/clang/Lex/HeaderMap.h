@@ -91,6 +91,10 @@ public:
   static std::unique_ptr<HeaderMap> Create(const FileEntry *FE,
                                            FileManager &FM);
 
+  /// Creates a header map over \p Buffer without taking ownership of it.
+  /// Returns null if it doesn't look like a header map.
+  static std::unique_ptr<HeaderMap> Create(llvm::MemoryBufferRef Buffer);
+
   using HeaderMapImpl::dump;
   using HeaderMapImpl::forEachKey;
   using HeaderMapImpl::getFileName;
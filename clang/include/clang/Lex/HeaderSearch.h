@@ -28,6 +28,8 @@
 #include <cassert>
 #include <cstddef>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -218,6 +220,37 @@ using SearchDirIterator = detail::SearchDirIteratorImpl<false>;
 using ConstSearchDirRange = llvm::iterator_range<ConstSearchDirIterator>;
 using SearchDirRange = llvm::iterator_range<SearchDirIterator>;
 
+/// Header search state that can be shared between the HeaderSearch instances
+/// of several compilations in one process, such as a batch compiler or a
+/// long-lived tool driving many CompilerInstances. It is thread-safe.
+///
+/// Currently it caches the contents of header maps, which are often large
+/// and otherwise read again by every compilation. Entries are keyed by the
+/// unique ID of the file, as the same path can name different files in
+/// compilations with different working directories, and revalidated against
+/// the size and modification time of the file.
+class SharedHeaderSearchCache {
+public:
+  /// Returns the contents of the header map \p FE, reading it through \p FM
+  /// if it is not cached yet or the file changed. The buffer stays valid for
+  /// the lifetime of the cache.
+  std::optional<llvm::MemoryBufferRef> getHeaderMapBuffer(const FileEntry *FE,
+                                                          FileManager &FM);
+
+private:
+  struct HeaderMapEntry {
+    off_t Size = 0;
+    time_t ModTime = 0;
+    const llvm::MemoryBuffer *Buffer = nullptr;
+  };
+
+  std::mutex Lock;
+  llvm::DenseMap<llvm::sys::fs::UniqueID, HeaderMapEntry> HeaderMaps;
+  /// Owns every buffer ever returned, including those of changed files that
+  /// compilations may still be using.
+  std::vector<std::unique_ptr<llvm::MemoryBuffer>> Buffers;
+};
+
 /// Encapsulates the information needed to find the file referenced
 /// by a \#include or \#include_next, (sub-)framework lookup, etc.
 class HeaderSearch {
@@ -313,6 +346,9 @@ class HeaderSearch {
   /// This is a mapping from FileEntry -> HeaderMap, uniquing headermaps.
   std::vector<std::pair<const FileEntry *, std::unique_ptr<HeaderMap>>> HeaderMaps;
 
+  /// Cache shared with other HeaderSearch instances, if any.
+  std::shared_ptr<SharedHeaderSearchCache> SharedCache;
+
   /// The mapping between modules and headers.
   mutable ModuleMap ModMap;
 
@@ -570,6 +606,11 @@ public:
   /// FileEntry, uniquing them through the 'HeaderMaps' datastructure.
   const HeaderMap *CreateHeaderMap(const FileEntry *FE);
 
+  /// Share cached state with the other users of \p Cache.
+  void setSharedCache(std::shared_ptr<SharedHeaderSearchCache> Cache) {
+    SharedCache = std::move(Cache);
+  }
+
   /// Get filenames for all registered header maps.
   void getHeaderMapFileNames(SmallVectorImpl<std::string> &Names) const;
 
@@ -207,6 +207,10 @@ public:
   /// Whether to validate system input files when a module is loaded.
   unsigned ModulesValidateSystemHeaders : 1;
 
+  /// Whether module files may be memory-mapped rather than read into memory.
+  /// Only safe if module files are never modified in place.
+  unsigned ModulesMmapPCMs : 1;
+
   // Whether the content of input files should be hashed and used to
   // validate consistency.
   unsigned ValidateASTInputFilesContent : 1;
@@ -232,7 +236,7 @@ public:
         UseBuiltinIncludes(true), UseStandardSystemIncludes(true),
         UseStandardCXXIncludes(true), UseLibcxx(false), Verbose(false),
         ModulesValidateOncePerBuildSession(false),
-        ModulesValidateSystemHeaders(false),
+        ModulesValidateSystemHeaders(false), ModulesMmapPCMs(false),
         ValidateASTInputFilesContent(false), UseDebugInfo(false),
         ModulesValidateDiagnosticOptions(true), ModulesHashContent(false),
         ModulesStrictContextHash(false) {}
@@ -32,6 +32,8 @@ class MemoryBuffer;
 
 namespace clang {
 
+class SharedHeaderSearchCache;
+
 /// Enumerate the kinds of standard library that
 enum ObjCXXARCStandardLibraryKind {
   ARCXX_nolib,
@@ -215,6 +217,11 @@ public:
       FileEntryRef)>
       DependencyDirectivesForFile;
 
+  /// Header search state shared with the other compilations of the process,
+  /// such as the header maps already read. The HeaderSearch of the
+  /// preprocessor uses it if it is set.
+  std::shared_ptr<SharedHeaderSearchCache> SharedHeaderSearch;
+
   /// Set up preprocessor for RunAnalysis action.
   bool SetUpStaticAnalyzer = false;
 
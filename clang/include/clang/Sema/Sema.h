@@ -9455,6 +9455,47 @@ public:
     SuppressedDiagnosticsMap;
   SuppressedDiagnosticsMap SuppressedDiagnostics;
 
+  /// Statistics gathered for a single primary template while
+  /// \c CollectStats is set. Times and allocation sizes exclude any nested
+  /// instantiation or deduction, which is attributed to its own template.
+  struct TemplateInstantiationStats {
+    unsigned NumInstantiations = 0;
+    unsigned NumDeductions = 0;
+    uint64_t SelfNanoseconds = 0;
+    size_t SelfBytes = 0;
+  };
+
+  /// Per-template statistics, keyed by the canonical declaration of the
+  /// primary template (or the member of a class template) being used.
+  llvm::DenseMap<const NamedDecl *, TemplateInstantiationStats>
+      TemplateInstantiationProfile;
+
+  /// RAII object attributing the time and AST memory spent within its
+  /// lifetime to a template in \c TemplateInstantiationProfile. Does nothing
+  /// unless \c CollectStats is set.
+  class TemplateProfileScope {
+  public:
+    enum ProfileKind { Instantiation, Deduction };
+
+    TemplateProfileScope(Sema &SemaRef, const Decl *D, ProfileKind Kind);
+    ~TemplateProfileScope();
+
+    TemplateProfileScope(const TemplateProfileScope &) = delete;
+    TemplateProfileScope &operator=(const TemplateProfileScope &) = delete;
+
+  private:
+    Sema &SemaRef;
+    const NamedDecl *Template = nullptr;
+    TemplateProfileScope *Parent = nullptr;
+    uint64_t StartNanoseconds = 0;
+    size_t StartBytes = 0;
+    uint64_t NestedNanoseconds = 0;
+    size_t NestedBytes = 0;
+  };
+
+  /// The innermost active \c TemplateProfileScope, if any.
+  TemplateProfileScope *CurrentTemplateProfileScope = nullptr;
+
   /// A stack object to be created when performing template
   /// instantiation.
   ///
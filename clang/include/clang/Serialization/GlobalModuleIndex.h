@@ -159,8 +159,16 @@ public:
   /// information about this name.
   ///
   /// \returns true if the identifier is known to the index, false otherwise.
+  /// If the index has an identifier table, an identifier unknown to it is in
+  /// none of the module files that it has information about, so the module
+  /// files reported by \c loadedModuleFile() can be skipped in either case.
   bool lookupIdentifier(llvm::StringRef Name, HitSet &Hits);
 
+  /// Determine whether the index has an identifier table, and so whether
+  /// \c lookupIdentifier() knows about every identifier of the module files
+  /// it has information about.
+  bool hasIdentifierIndex() const { return IdentifierIndex != nullptr; }
+
   /// Note that the given module file has been loaded.
   ///
   /// \returns false if the global module index has information about this
@@ -0,0 +1,81 @@
+//===- CompilationCache.h - Cache of -cc1 compilation outputs ---*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_TOOLING_DEPENDENCYSCANNING_COMPILATIONCACHE_H
+#define LLVM_CLANG_TOOLING_DEPENDENCYSCANNING_COMPILATIONCACHE_H
+
+#include "clang/Basic/LLVM.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Error.h"
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace clang {
+
+class CompilerInvocation;
+
+namespace tooling {
+namespace dependencies {
+
+/// A cache of the outputs of -cc1 compilations, stored in a directory.
+///
+/// An entry is keyed by a hash of the compiler version, the working directory,
+/// the -cc1 command line, the contents of every file that the compilation
+/// reads and the result of every file lookup it makes, including the failed
+/// ones. The files are found by the dependency directives scanner, and their
+/// contents are read through the scanning file system, so a lookup costs a
+/// fraction of a preprocessing run. An entry holds the output files and the
+/// diagnostics of a successful compilation, which are replayed on a hit.
+class CompilationCache {
+public:
+  explicit CompilationCache(StringRef Path);
+
+  /// Returns whether the compilation described by \p Invocation can be
+  /// cached, and if so, adds the paths of the files it writes to \p Outputs.
+  ///
+  /// Only compilations of a single input, without modules or PCH, that write
+  /// nothing but their main output and dependency file are cached.
+  static bool getCacheableOutputs(const CompilerInvocation &Invocation,
+                                  SmallVectorImpl<std::string> &Outputs);
+
+  /// Computes the key of the compilation described by \p CommandLine, which
+  /// starts with the executable followed by "-cc1". The paths of the outputs,
+  /// which follow options such as "-o" and "-dependency-file", are left out of
+  /// the key.
+  ///
+  /// \returns A \c StringError with the diagnostic output if the dependencies
+  /// of the compilation could not be scanned, or if the compilation may use
+  /// __DATE__, __TIME__ or __TIMESTAMP__, the key otherwise.
+  llvm::Expected<std::string>
+  computeKey(const std::vector<std::string> &CommandLine,
+             StringRef WorkingDirectory);
+
+  /// If the cache has an entry for \p Key, writes its outputs to
+  /// \p OutputPaths and returns the diagnostics of the compilation.
+  std::optional<std::string> replay(StringRef Key,
+                                    ArrayRef<std::string> OutputPaths);
+
+  /// Stores the contents of \p OutputPaths and \p Diagnostics as the entry of
+  /// \p Key.
+  llvm::Error store(StringRef Key, ArrayRef<std::string> OutputPaths,
+                    StringRef Diagnostics);
+
+private:
+  std::string getEntryPath(StringRef Key) const;
+
+  std::string Path;
+};
+
+} // end namespace dependencies
+} // end namespace tooling
+} // end namespace clang
+
+#endif // LLVM_CLANG_TOOLING_DEPENDENCYSCANNING_COMPILATIONCACHE_H
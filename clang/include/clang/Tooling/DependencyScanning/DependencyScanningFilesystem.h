@@ -202,9 +202,34 @@ public:
   CacheShard &getShardForFilename(StringRef Filename) const;
   CacheShard &getShardForUID(llvm::sys::fs::UniqueID UID) const;
 
+  /// Sets the directory of the persistent directives cache. Scanned
+  /// directives are stored there keyed by a hash of the file contents, so
+  /// they can be reused by later scanning services and shared between
+  /// machines. An empty path disables the persistent cache.
+  void setDirectivesCachePath(StringRef Path);
+  StringRef getDirectivesCachePath() const { return DirectivesCachePath; }
+
+  /// Forgets the cached entry for the given filename, e.g. after the file was
+  /// modified, so that the next lookup goes to the underlying filesystem.
+  /// Other names of the same file (e.g. symlinks) must be invalidated
+  /// separately. Entries stay allocated, so references obtained earlier remain
+  /// valid. Safe to call while workers are scanning.
+  ///
+  /// \returns True if there was an entry for the filename, i.e. if a worker
+  /// looked it up, even if the lookup failed.
+  bool invalidateEntryForFilename(StringRef Filename);
+
+  /// Returns a counter that is incremented by every invalidation. Workers
+  /// compare it against the value they last saw to drop their local caches.
+  uint64_t getGeneration() const {
+    return Generation.load(std::memory_order_acquire);
+  }
+
 private:
   std::unique_ptr<CacheShard[]> CacheShards;
   unsigned NumShards;
+  std::string DirectivesCachePath;
+  std::atomic<uint64_t> Generation{0};
 };
 
 /// This class is a local cache, that caches the 'stat' and 'open' calls to the
@@ -228,6 +253,9 @@ public:
     assert(InsertedEntry == &Entry && "entry already present");
     return *InsertedEntry;
   }
+
+  /// Removes all entries.
+  void clear() { Cache.clear(); }
 };
 
 /// Reference to a CachedFileSystemEntry.
@@ -388,6 +416,8 @@ private:
   /// The local cache is used by the worker thread to cache file system queries
   /// locally instead of querying the global cache every time.
   DependencyScanningFilesystemLocalCache LocalCache;
+  /// The generation of the shared cache the local cache is consistent with.
+  uint64_t LocalCacheGeneration = 0;
 };
 
 } // end namespace dependencies
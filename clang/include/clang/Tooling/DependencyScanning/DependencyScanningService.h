@@ -10,8 +10,11 @@
 #define LLVM_CLANG_TOOLING_DEPENDENCYSCANNING_DEPENDENCYSCANNINGSERVICE_H
 
 #include "clang/Tooling/DependencyScanning/DependencyScanningFilesystem.h"
+#include <memory>
 
 namespace clang {
+class SharedHeaderSearchCache;
+
 namespace tooling {
 namespace dependencies {
 
@@ -64,6 +67,11 @@ public:
     return SharedCache;
   }
 
+  /// The header search state shared by the workers.
+  const std::shared_ptr<SharedHeaderSearchCache> &getHeaderSearchCache() const {
+    return HeaderSearchCache;
+  }
+
 private:
   const ScanningMode Mode;
   const ScanningOutputFormat Format;
@@ -73,6 +81,8 @@ private:
   const bool EagerLoadModules;
   /// The global file system cache.
   DependencyScanningFilesystemSharedCache SharedCache;
+  /// The header search cache, e.g. of the header maps.
+  std::shared_ptr<SharedHeaderSearchCache> HeaderSearchCache;
 };
 
 } // end namespace dependencies
@@ -92,6 +92,12 @@ public:
   llvm::Expected<std::string>
   getDependencyFile(const std::vector<std::string> &CommandLine, StringRef CWD);
 
+  /// Like the above, but also returns the files that the dependency file
+  /// lists, as spelled in it.
+  llvm::Expected<std::string>
+  getDependencyFile(const std::vector<std::string> &CommandLine, StringRef CWD,
+                    std::vector<std::string> &FileDeps);
+
   /// Collect the module dependency in P1689 format for C++20 named modules.
   ///
   /// \param MakeformatOutput The output parameter for dependency information
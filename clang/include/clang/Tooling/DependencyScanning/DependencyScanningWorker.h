@@ -74,9 +74,9 @@ public:
                            llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> FS);
 
   /// Run the dependency scanning tool for a given clang driver command-line,
-  /// and report the discovered dependencies to the provided consumer. If \p
-  /// ModuleName isn't empty, this function reports the dependencies of module
-  /// \p ModuleName.
+  /// or -cc1 command-line, and report the discovered dependencies to the
+  /// provided consumer. If \p ModuleName isn't empty, this function reports
+  /// the dependencies of module \p ModuleName.
   ///
   /// \returns false if clang errors occurred (with diagnostics reported to
   /// \c DiagConsumer), true otherwise.
@@ -110,6 +110,8 @@ private:
   bool OptimizeArgs;
   /// Whether to set up command-lines to load PCM files eagerly.
   bool EagerLoadModules;
+  /// The header search state shared with the other workers of the service.
+  std::shared_ptr<SharedHeaderSearchCache> HeaderSearchCache;
 };
 
 } // end namespace dependencies
@@ -847,6 +847,12 @@ namespace {
     /// declaration whose initializer is being evaluated, if any.
     APValue *EvaluatingDeclValue;
 
+    /// The number of times the in-flight value of EvaluatingDecl, or of a
+    /// temporary whose lifetime it extends, has been accessed. A call that
+    /// accesses such an object may see a value that differs from the final
+    /// one, so its result must not be cached.
+    unsigned NumEvaluatingDeclAccesses = 0;
+
     /// Set of objects that are currently being constructed.
     llvm::DenseMap<ObjectUnderConstruction, ConstructionPhase>
         ObjectsUnderConstruction;
@@ -3271,6 +3277,7 @@ static bool evaluateVarDeclInit(EvalInfo &Info, const Expr *E,
   // If we're currently evaluating the initializer of this declaration, use that
   // in-flight value.
   if (Info.EvaluatingDecl == Base) {
+    ++Info.NumEvaluatingDeclAccesses;
     Result = Info.EvaluatingDeclValue;
     return true;
   }
@@ -3972,6 +3979,11 @@ static CompleteObject findCompleteObject(EvalInfo &Info, const Expr *E,
     return CompleteObject();
   }
 
+  if (Info.IsEvaluatingDecl != EvalInfo::EvaluatingDeclKind::None &&
+      !LVal.Base.getCallIndex() && !LVal.Base.is<DynamicAllocLValue>() &&
+      lifetimeStartedInEvaluation(Info, LVal.Base))
+    ++Info.NumEvaluatingDeclAccesses;
+
   CallStackFrame *Frame = nullptr;
   unsigned Depth = 0;
   if (LVal.getLValueCallIndex()) {
@@ -6159,6 +6171,64 @@ static bool handleTrivialCopy(EvalInfo &Info, const ParmVarDecl *Param,
       CopyObjectRepresentation);
 }
 
+/// Determine whether the result of evaluating a call to \p Callee can be
+/// stored in, or taken from, the ASTContext's cache of constexpr call results.
+/// This is restricted to functions whose parameters and result are integers
+/// or floating-point values, so that the result depends only on the callee
+/// and the argument values.
+static bool isCacheableConstexprCall(EvalInfo &Info, const FunctionDecl *Callee,
+                                     const LValue *This, CallRef Call) {
+  if (Info.EvalMode != EvalInfo::EM_ConstantExpression ||
+      Info.checkingPotentialConstantExpression() || This || !Call ||
+      Callee->isVariadic() || !Callee->isConstexpr())
+    return false;
+  auto IsScalar = [](QualType T) {
+    return T->isIntegralOrEnumerationType() || T->isRealFloatingType();
+  };
+  if (!IsScalar(Callee->getReturnType()))
+    return false;
+  return llvm::all_of(Callee->parameters(), [&](const ParmVarDecl *PVD) {
+    return IsScalar(PVD->getType());
+  });
+}
+
+/// Compute the cache key for a call to \p Callee with the arguments of
+/// \p Call. Returns false if some argument does not have a scalar value.
+static bool getConstexprCallKey(EvalInfo &Info, const FunctionDecl *Callee,
+                                CallRef Call, SmallVectorImpl<char> &Key) {
+  auto AppendBytes = [&](const void *Data, size_t Size) {
+    Key.append(static_cast<const char *>(Data),
+               static_cast<const char *>(Data) + Size);
+  };
+  auto AppendAPInt = [&](const llvm::APInt &I) {
+    unsigned BitWidth = I.getBitWidth();
+    AppendBytes(&BitWidth, sizeof(BitWidth));
+    AppendBytes(I.getRawData(), I.getNumWords() * sizeof(uint64_t));
+  };
+
+  AppendBytes(&Callee, sizeof(Callee));
+  Key.push_back(Info.InConstantContext);
+  Key.push_back(Info.Ctx.CUDAConstantEvalCtx.NoWrongSidedVars);
+  for (const ParmVarDecl *PVD : Callee->parameters()) {
+    const APValue *Arg = Info.getParamSlot(Call, PVD);
+    if (!Arg)
+      return false;
+    if (Arg->isInt()) {
+      Key.push_back('i');
+      Key.push_back(Arg->getInt().isUnsigned());
+      AppendAPInt(Arg->getInt());
+    } else if (Arg->isFloat()) {
+      const llvm::fltSemantics *Sem = &Arg->getFloat().getSemantics();
+      Key.push_back('f');
+      AppendBytes(&Sem, sizeof(Sem));
+      AppendAPInt(Arg->getFloat().bitcastToAPInt());
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
 /// Evaluate a function call.
 static bool HandleFunctionCall(SourceLocation CallLoc,
                                const FunctionDecl *Callee, const LValue *This,
@@ -6204,6 +6274,36 @@ static bool HandleFunctionCall(SourceLocation CallLoc,
                                         Frame.LambdaThisCaptureField);
   }
 
+  // Calls with scalar arguments and results are memoized across the
+  // translation unit. A result is only cached if its evaluation was a clean
+  // constant expression: no notes, side effects, undefined behavior, or
+  // accesses to the in-flight value of the variable being initialized.
+  //
+  // A cached call still uses up the evaluation steps that evaluating it took,
+  // so that whether an evaluation hits the step limit does not depend on
+  // which calls were evaluated before.
+  SmallString<64> CacheKey;
+  bool CanCache = isCacheableConstexprCall(Info, Callee, This, Call) &&
+                  getConstexprCallKey(Info, Callee, Call, CacheKey);
+  if (CanCache) {
+    auto It = Info.Ctx.getConstexprCallResults().find(CacheKey);
+    if (It != Info.Ctx.getConstexprCallResults().end()) {
+      if (Info.StepsLeft < It->second.second) {
+        Info.StepsLeft = 0;
+        Info.FFDiag(CallLoc, diag::note_constexpr_step_limit_exceeded);
+        return false;
+      }
+      Info.StepsLeft -= It->second.second;
+      Result = It->second.first;
+      return true;
+    }
+  }
+  Expr::EvalStatus &Status = Info.EvalStatus;
+  CanCache = CanCache && Status.Diag && Status.Diag->empty() &&
+             !Status.HasSideEffects && !Status.HasUndefinedBehavior;
+  unsigned OldEvaluatingDeclAccesses = Info.NumEvaluatingDeclAccesses;
+  unsigned OldStepsLeft = Info.StepsLeft;
+
   StmtResult Ret = {Result, ResultSlot};
   EvalStmtResult ESR = EvaluateStmt(Ret, Info, Body);
   if (ESR == ESR_Succeeded) {
@@ -6211,7 +6311,16 @@ static bool HandleFunctionCall(SourceLocation CallLoc,
       return true;
     Info.FFDiag(Callee->getEndLoc(), diag::note_constexpr_no_return);
   }
-  return ESR == ESR_Returned;
+  if (ESR != ESR_Returned)
+    return false;
+
+  if (CanCache && Status.Diag->empty() && !Status.HasSideEffects &&
+      !Status.HasUndefinedBehavior &&
+      Info.NumEvaluatingDeclAccesses == OldEvaluatingDeclAccesses &&
+      (Result.isInt() || Result.isFloat()))
+    Info.Ctx.getConstexprCallResults().try_emplace(
+        CacheKey, Result, OldStepsLeft - Info.StepsLeft);
+  return true;
 }
 
 /// Evaluate a constructor call.
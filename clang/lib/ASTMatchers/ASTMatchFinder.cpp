@@ -420,7 +420,10 @@ class MatchASTVisitor : public RecursiveASTVisitor<MatchASTVisitor>,
 public:
   MatchASTVisitor(const MatchFinder::MatchersByType *Matchers,
                   const MatchFinder::MatchFinderOptions &Options)
-      : Matchers(Matchers), Options(Options), ActiveASTContext(nullptr) {}
+      : Matchers(Matchers), Options(Options), ActiveASTContext(nullptr) {
+    if (Options.CheckProfiling && Options.CheckProfiling->PerMatcher)
+      createMatcherBuckets();
+  }
 
   ~MatchASTVisitor() override {
     if (Options.CheckProfiling) {
@@ -1005,6 +1008,39 @@ private:
     llvm::TimeRecord *Bucket;
   };
 
+  /// Creates one profiling bucket per registered matcher.
+  void createMatcherBuckets() {
+    llvm::DenseMap<MatchCallback *, unsigned> NumMatchers;
+    auto AddBuckets = [&](const auto &Entries) {
+      for (const auto &MP : Entries) {
+        unsigned Index = NumMatchers[MP.second]++;
+        // The restricted kind, e.g. CallExpr rather than Stmt.
+        ASTNodeKind Kind = DynTypedMatcher(MP.first).getID().first;
+        std::string Name = (MP.second->getID() + ".matcher" + Twine(Index) +
+                            "." + Kind.asStringRef())
+                               .str();
+        MatcherBuckets[&MP] = &TimeByBucket[Name];
+      }
+    };
+    AddBuckets(Matchers->DeclOrStmt);
+    AddBuckets(Matchers->Type);
+    AddBuckets(Matchers->NestedNameSpecifier);
+    AddBuckets(Matchers->NestedNameSpecifierLoc);
+    AddBuckets(Matchers->TypeLoc);
+    AddBuckets(Matchers->CtorInit);
+    AddBuckets(Matchers->TemplateArgumentLoc);
+    AddBuckets(Matchers->Attr);
+  }
+
+  /// Returns the bucket that the time spent running the matcher in \p MP is
+  /// recorded in.
+  template <typename MatcherAndCallback>
+  llvm::TimeRecord *getBucket(const MatcherAndCallback &MP) {
+    if (Options.CheckProfiling->PerMatcher)
+      return MatcherBuckets.lookup(&MP);
+    return &TimeByBucket[MP.second->getID()];
+  }
+
   /// Runs all the \p Matchers on \p Node.
   ///
   /// Used by \c matchDispatch() below.
@@ -1014,7 +1050,7 @@ private:
     TimeBucketRegion Timer;
     for (const auto &MP : Matchers) {
       if (EnableCheckProfiling)
-        Timer.setBucket(&TimeByBucket[MP.second->getID()]);
+        Timer.setBucket(getBucket(MP));
       BoundNodesTreeBuilder Builder;
       CurMatchRAII RAII(*this, MP.second, Node);
       if (MP.first.matches(Node, this, &Builder)) {
@@ -1039,7 +1075,7 @@ private:
     for (unsigned short I : Filter) {
       auto &MP = Matchers[I];
       if (EnableCheckProfiling)
-        Timer.setBucket(&TimeByBucket[MP.second->getID()]);
+        Timer.setBucket(getBucket(MP));
       BoundNodesTreeBuilder Builder;
 
       {
@@ -1307,6 +1343,11 @@ private:
   /// Used to get the appropriate bucket for each matcher.
   llvm::StringMap<llvm::TimeRecord> TimeByBucket;
 
+  /// Bucket of each registered matcher, keyed by its entry in \c Matchers.
+  ///
+  /// Only populated if per-matcher profiling is enabled.
+  llvm::DenseMap<const void *, llvm::TimeRecord *> MatcherBuckets;
+
   const MatchFinder::MatchersByType *Matchers;
 
   /// Filtered list of matcher indices for each matcher kind.
@@ -284,6 +284,10 @@ static TargetLibraryInfoImpl *createTLII(llvm::Triple &TargetTriple,
     TLII->addVectorizableFunctionsFromVecLib(
         TargetLibraryInfoImpl::DarwinLibSystemM, TargetTriple);
     break;
+  case CodeGenOptions::LLVMLIBC:
+    TLII->addVectorizableFunctionsFromVecLib(TargetLibraryInfoImpl::LLVMLIBC,
+                                             TargetTriple);
+    break;
   default:
     break;
   }
@@ -3843,6 +3843,7 @@ static bool RenderModulesOptions(Compilation &C, const Driver &D,
 
     Args.AddLastArg(CmdArgs,
                     options::OPT_fmodules_disable_diagnostic_validation);
+    Args.AddLastArg(CmdArgs, options::OPT_fmodules_mmap_pcms);
   } else {
     Args.ClaimAllArgs(options::OPT_fbuild_session_timestamp);
     Args.ClaimAllArgs(options::OPT_fbuild_session_file);
@@ -3850,6 +3851,7 @@ static bool RenderModulesOptions(Compilation &C, const Driver &D,
     Args.ClaimAllArgs(options::OPT_fmodules_validate_system_headers);
     Args.ClaimAllArgs(options::OPT_fno_modules_validate_system_headers);
     Args.ClaimAllArgs(options::OPT_fmodules_disable_diagnostic_validation);
+    Args.ClaimAllArgs(options::OPT_fmodules_mmap_pcms);
   }
 
   // Claim `-fmodule-output` and `-fmodule-output=` to avoid unused warnings.
@@ -5204,6 +5206,12 @@ void Clang::ConstructJob(Compilation &C, const JobAction &JA,
           Triple.getArch() != llvm::Triple::aarch64_be)
         D.Diag(diag::err_drv_unsupported_opt_for_target)
             << Name << Triple.getArchName();
+    } else if (Name == "LLVMlibc") {
+      if (Triple.getArch() != llvm::Triple::x86_64 &&
+          Triple.getArch() != llvm::Triple::aarch64 &&
+          Triple.getArch() != llvm::Triple::aarch64_be)
+        D.Diag(diag::err_drv_unsupported_opt_for_target)
+            << Name << Triple.getArchName();
     }
     A->render(Args, CmdArgs);
   }
@@ -6359,6 +6367,7 @@ void Clang::ConstructJob(Compilation &C, const JobAction &JA,
   Args.AddLastArg(CmdArgs, options::OPT_ftime_trace);
   Args.AddLastArg(CmdArgs, options::OPT_ftime_trace_granularity_EQ);
   Args.AddLastArg(CmdArgs, options::OPT_ftime_trace_EQ);
+  Args.AddLastArg(CmdArgs, options::OPT_fcompilation_cache_path_EQ);
   Args.AddLastArg(CmdArgs, options::OPT_ftrapv);
   Args.AddLastArg(CmdArgs, options::OPT_malign_double);
   Args.AddLastArg(CmdArgs, options::OPT_fno_temp_file);
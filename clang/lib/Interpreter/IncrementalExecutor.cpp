@@ -30,14 +30,25 @@ namespace clang {
 
 IncrementalExecutor::IncrementalExecutor(llvm::orc::ThreadSafeContext &TSC,
                                          llvm::Error &Err,
-                                         const clang::TargetInfo &TI)
+                                         const clang::TargetInfo &TI,
+                                         bool LazyCompilation)
     : TSCtx(TSC) {
   using namespace llvm::orc;
   llvm::ErrorAsOutParameter EAO(&Err);
 
   auto JTMB = JITTargetMachineBuilder(TI.getTriple());
   JTMB.addFeatures(TI.getTargetOpts().Features);
-  if (auto JitOrErr = LLJITBuilder().setJITTargetMachineBuilder(JTMB).create())
+  if (LazyCompilation) {
+    if (auto JitOrErr =
+            LLLazyJITBuilder().setJITTargetMachineBuilder(JTMB).create()) {
+      LazyJit = JitOrErr->get();
+      Jit = std::move(*JitOrErr);
+    } else {
+      Err = JitOrErr.takeError();
+      return;
+    }
+  } else if (auto JitOrErr =
+                 LLJITBuilder().setJITTargetMachineBuilder(JTMB).create())
     Jit = std::move(*JitOrErr);
   else {
     Err = JitOrErr.takeError();
@@ -61,6 +72,10 @@ llvm::Error IncrementalExecutor::addModule(PartialTranslationUnit &PTU) {
       Jit->getMainJITDylib().createResourceTracker();
   ResourceTrackers[&PTU] = RT;
 
+  // In lazy mode, the functions of the PTU are compiled when they are first
+  // called rather than when the PTU is executed.
+  if (LazyJit)
+    return LazyJit->addLazyIRModule(RT, {std::move(PTU.TheModule), TSCtx});
   return Jit->addIRModule(RT, {std::move(PTU.TheModule), TSCtx});
 }
 
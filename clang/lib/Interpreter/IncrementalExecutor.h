@@ -23,6 +23,7 @@ namespace llvm {
 class Error;
 namespace orc {
 class LLJIT;
+class LLLazyJIT;
 class ThreadSafeContext;
 } // namespace orc
 } // namespace llvm
@@ -35,6 +36,8 @@ class TargetInfo;
 class IncrementalExecutor {
   using CtorDtorIterator = llvm::orc::CtorDtorIterator;
   std::unique_ptr<llvm::orc::LLJIT> Jit;
+  /// Jit as an LLLazyJIT if the PTUs are compiled lazily, null otherwise.
+  llvm::orc::LLLazyJIT *LazyJit = nullptr;
   llvm::orc::ThreadSafeContext &TSCtx;
 
   llvm::DenseMap<const PartialTranslationUnit *, llvm::orc::ResourceTrackerSP>
@@ -44,7 +47,8 @@ public:
   enum SymbolNameKind { IRName, LinkerName };
 
   IncrementalExecutor(llvm::orc::ThreadSafeContext &TSC, llvm::Error &Err,
-                      const clang::TargetInfo &TI);
+                      const clang::TargetInfo &TI,
+                      bool LazyCompilation = false);
   ~IncrementalExecutor();
 
   llvm::Error addModule(PartialTranslationUnit &PTU);
@@ -172,7 +172,8 @@ IncrementalCompilerBuilder::create(std::vector<const char *> &ClangArgv) {
 }
 
 Interpreter::Interpreter(std::unique_ptr<CompilerInstance> CI,
-                         llvm::Error &Err) {
+                         bool LazyCompilation, llvm::Error &Err)
+    : LazyCompilation(LazyCompilation) {
   llvm::ErrorAsOutParameter EAO(&Err);
   auto LLVMCtx = std::make_unique<llvm::LLVMContext>();
   TSCtx = std::make_unique<llvm::orc::ThreadSafeContext>(std::move(LLVMCtx));
@@ -190,10 +191,11 @@ Interpreter::~Interpreter() {
 }
 
 llvm::Expected<std::unique_ptr<Interpreter>>
-Interpreter::create(std::unique_ptr<CompilerInstance> CI) {
+Interpreter::create(std::unique_ptr<CompilerInstance> CI,
+                    bool LazyCompilation) {
   llvm::Error Err = llvm::Error::success();
-  auto Interp =
-      std::unique_ptr<Interpreter>(new Interpreter(std::move(CI), Err));
+  auto Interp = std::unique_ptr<Interpreter>(
+      new Interpreter(std::move(CI), LazyCompilation, Err));
   if (Err)
     return std::move(Err);
   return std::move(Interp);
@@ -220,7 +222,8 @@ llvm::Error Interpreter::Execute(PartialTranslationUnit &T) {
     const clang::TargetInfo &TI =
         getCompilerInstance()->getASTContext().getTargetInfo();
     llvm::Error Err = llvm::Error::success();
-    IncrExecutor = std::make_unique<IncrementalExecutor>(*TSCtx, Err, TI);
+    IncrExecutor = std::make_unique<IncrementalExecutor>(*TSCtx, Err, TI,
+                                                         LazyCompilation);
 
     if (Err)
       return Err;
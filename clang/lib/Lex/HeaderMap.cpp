@@ -63,6 +63,16 @@ std::unique_ptr<HeaderMap> HeaderMap::Create(const FileEntry *FE,
   return std::unique_ptr<HeaderMap>(new HeaderMap(std::move(*FileBuffer), NeedsByteSwap));
 }
 
+std::unique_ptr<HeaderMap> HeaderMap::Create(llvm::MemoryBufferRef Buffer) {
+  auto FileBuffer = llvm::MemoryBuffer::getMemBuffer(
+      Buffer, /*RequiresNullTerminator=*/false);
+  bool NeedsByteSwap;
+  if (!checkHeader(*FileBuffer, NeedsByteSwap))
+    return nullptr;
+  return std::unique_ptr<HeaderMap>(
+      new HeaderMap(std::move(FileBuffer), NeedsByteSwap));
+}
+
 bool HeaderMapImpl::checkHeader(const llvm::MemoryBuffer &File,
                                 bool &NeedsByteSwap) {
   if (File.getBufferSize() <= sizeof(HMapHeader))
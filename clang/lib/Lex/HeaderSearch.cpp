@@ -155,7 +155,14 @@ const HeaderMap *HeaderSearch::CreateHeaderMap(const FileEntry *FE) {
         return HeaderMaps[i].second.get();
   }
 
-  if (std::unique_ptr<HeaderMap> HM = HeaderMap::Create(FE, FileMgr)) {
+  std::unique_ptr<HeaderMap> HM;
+  if (SharedCache) {
+    if (auto Buffer = SharedCache->getHeaderMapBuffer(FE, FileMgr))
+      HM = HeaderMap::Create(*Buffer);
+  } else {
+    HM = HeaderMap::Create(FE, FileMgr);
+  }
+  if (HM) {
     HeaderMaps.emplace_back(FE, std::move(HM));
     return HeaderMaps.back().second.get();
   }
@@ -163,6 +170,26 @@ const HeaderMap *HeaderSearch::CreateHeaderMap(const FileEntry *FE) {
   return nullptr;
 }
 
+std::optional<llvm::MemoryBufferRef>
+SharedHeaderSearchCache::getHeaderMapBuffer(const FileEntry *FE,
+                                            FileManager &FM) {
+  std::lock_guard<std::mutex> Guard(Lock);
+  HeaderMapEntry &Entry = HeaderMaps[FE->getUniqueID()];
+  if (!Entry.Buffer || Entry.Size != FE->getSize() ||
+      Entry.ModTime != FE->getModificationTime()) {
+    // Same size check as HeaderMap::Create.
+    if (FE->getSize() <= sizeof(HMapHeader))
+      return std::nullopt;
+    auto FileBuffer = FM.getBufferForFile(FE);
+    if (!FileBuffer || !*FileBuffer)
+      return std::nullopt;
+    Entry.Size = FE->getSize();
+    Entry.ModTime = FE->getModificationTime();
+    Entry.Buffer = Buffers.emplace_back(std::move(*FileBuffer)).get();
+  }
+  return Entry.Buffer->getMemBufferRef();
+}
+
 /// Get filenames for all registered header maps.
 void HeaderSearch::getHeaderMapFileNames(
     SmallVectorImpl<std::string> &Names) const {
@@ -47,6 +47,13 @@
 #include <tuple>
 #include <utility>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#elif __ALTIVEC__
+#include <altivec.h>
+#undef bool
+#endif
+
 using namespace clang;
 
 //===----------------------------------------------------------------------===//
@@ -1820,19 +1827,47 @@ bool Lexer::LexUnicodeIdentifierStart(Token &Result, uint32_t C,
   return true;
 }
 
+/// Returns a pointer past the run of [_A-Za-z0-9] characters starting at
+/// \p CurPtr. \p BufferEnd must point to a null character.
+static const char *skipAsciiIdentifierContinue(const char *CurPtr,
+                                               const char *BufferEnd) {
+#ifdef __SSE2__
+  // Bytes >= 0x80 compare as negative and so are never matched.
+  const __m128i LowerA = _mm_set1_epi8('a' - 1);
+  const __m128i LowerZ = _mm_set1_epi8('z' + 1);
+  const __m128i Digit0 = _mm_set1_epi8('0' - 1);
+  const __m128i Digit9 = _mm_set1_epi8('9' + 1);
+  const __m128i Underscore = _mm_set1_epi8('_');
+  const __m128i CaseBit = _mm_set1_epi8(0x20);
+  while (BufferEnd - CurPtr >= 16) {
+    __m128i V = _mm_loadu_si128((const __m128i *)CurPtr);
+    __m128i Lower = _mm_or_si128(V, CaseBit);
+    __m128i Alpha = _mm_and_si128(_mm_cmpgt_epi8(Lower, LowerA),
+                                  _mm_cmplt_epi8(Lower, LowerZ));
+    __m128i Digit =
+        _mm_and_si128(_mm_cmpgt_epi8(V, Digit0), _mm_cmplt_epi8(V, Digit9));
+    __m128i Match = _mm_or_si128(_mm_or_si128(Alpha, Digit),
+                                 _mm_cmpeq_epi8(V, Underscore));
+    unsigned Mismatch = ~_mm_movemask_epi8(Match) & 0xffff;
+    if (Mismatch)
+      return CurPtr + llvm::countr_zero(Mismatch);
+    CurPtr += 16;
+  }
+#endif
+  while (isAsciiIdentifierContinue(*CurPtr))
+    ++CurPtr;
+  return CurPtr;
+}
+
 bool Lexer::LexIdentifierContinue(Token &Result, const char *CurPtr) {
   // Match [_A-Za-z0-9]*, we have already matched an identifier start.
   while (true) {
-    unsigned char C = *CurPtr;
     // Fast path.
-    if (isAsciiIdentifierContinue(C)) {
-      ++CurPtr;
-      continue;
-    }
+    CurPtr = skipAsciiIdentifierContinue(CurPtr, BufferEnd);
 
     unsigned Size;
     // Slow path: handle trigraph, unicode codepoints, UCNs.
-    C = getCharAndSize(CurPtr, Size);
+    unsigned char C = getCharAndSize(CurPtr, Size);
     if (isAsciiIdentifierContinue(C)) {
       CurPtr = ConsumeChar(CurPtr, Size, Result);
       continue;
@@ -2354,6 +2389,66 @@ bool Lexer::LexCharConstant(Token &Result, const char *CurPtr,
   return true;
 }
 
+/// Returns a pointer past the run of horizontal whitespace starting at
+/// \p CurPtr. \p BufferEnd must point to a null character.
+static const char *skipHorizontalWhitespace(const char *CurPtr,
+                                            const char *BufferEnd) {
+  // Most runs are a single space between tokens; only longer runs such as
+  // indentation are worth the vector code.
+  if (!isHorizontalWhitespace(CurPtr[0]))
+    return CurPtr;
+  if (!isHorizontalWhitespace(CurPtr[1]))
+    return CurPtr + 1;
+  CurPtr += 2;
+#ifdef __SSE2__
+  const __m128i Space = _mm_set1_epi8(' '), Tab = _mm_set1_epi8('\t');
+  const __m128i FormFeed = _mm_set1_epi8('\f'), VTab = _mm_set1_epi8('\v');
+  while (BufferEnd - CurPtr >= 16) {
+    __m128i V = _mm_loadu_si128((const __m128i *)CurPtr);
+    __m128i Match =
+        _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(V, Space),
+                                  _mm_cmpeq_epi8(V, Tab)),
+                     _mm_or_si128(_mm_cmpeq_epi8(V, FormFeed),
+                                  _mm_cmpeq_epi8(V, VTab)));
+    unsigned Mismatch = ~_mm_movemask_epi8(Match) & 0xffff;
+    if (Mismatch)
+      return CurPtr + llvm::countr_zero(Mismatch);
+    CurPtr += 16;
+  }
+#endif
+  while (isHorizontalWhitespace(*CurPtr))
+    ++CurPtr;
+  return CurPtr;
+}
+
+/// Returns a pointer to the first character at or after \p CurPtr that may
+/// end a line comment or needs special handling in one: a newline, a null
+/// character or a non-ASCII character. \p BufferEnd must point to a null
+/// character.
+static const char *skipPlainLineCommentChars(const char *CurPtr,
+                                             const char *BufferEnd) {
+#ifdef __SSE2__
+  const __m128i Zero = _mm_setzero_si128();
+  const __m128i NewLine = _mm_set1_epi8('\n'), Return = _mm_set1_epi8('\r');
+  while (BufferEnd - CurPtr >= 16) {
+    __m128i V = _mm_loadu_si128((const __m128i *)CurPtr);
+    __m128i Special =
+        _mm_or_si128(_mm_cmpeq_epi8(V, Zero),
+                     _mm_or_si128(_mm_cmpeq_epi8(V, NewLine),
+                                  _mm_cmpeq_epi8(V, Return)));
+    // The sign bits of V flag the non-ASCII bytes.
+    unsigned Stop = _mm_movemask_epi8(_mm_or_si128(Special, V));
+    if (Stop)
+      return CurPtr + llvm::countr_zero(Stop);
+    CurPtr += 16;
+  }
+#endif
+  char C = *CurPtr;
+  while (isASCII(C) && C != 0 && C != '\n' && C != '\r')
+    C = *++CurPtr;
+  return CurPtr;
+}
+
 /// SkipWhitespace - Efficiently skip over a series of whitespace characters.
 /// Update BufferPtr to point to the next non-whitespace character and return.
 ///
@@ -2377,8 +2472,8 @@ bool Lexer::SkipWhitespace(Token &Result, const char *CurPtr,
   // Skip consecutive spaces efficiently.
   while (true) {
     // Skip horizontal whitespace very aggressively.
-    while (isHorizontalWhitespace(Char))
-      Char = *++CurPtr;
+    CurPtr = skipHorizontalWhitespace(CurPtr, BufferEnd);
+    Char = *CurPtr;
 
     // Otherwise if we have something other than whitespace, we're done.
     if (!isVerticalWhitespace(Char))
@@ -2462,13 +2557,14 @@ bool Lexer::SkipLineComment(Token &Result, const char *CurPtr,
 
   char C;
   while (true) {
-    C = *CurPtr;
-    // Skip over characters in the fast loop.
-    while (isASCII(C) && C != 0 &&   // Potentially EOF.
-           C != '\n' && C != '\r') { // Newline or DOS-style newline.
-      C = *++CurPtr;
+    // Skip over characters in the fast loop. It stops at a potential EOF, a
+    // newline or DOS-style newline, or a non-ASCII character.
+    if (const char *End = skipPlainLineCommentChars(CurPtr, BufferEnd);
+        End != CurPtr) {
+      CurPtr = End;
       UnicodeDecodingAlreadyDiagnosed = false;
     }
+    C = *CurPtr;
 
     if (!isASCII(C)) {
       unsigned Length = llvm::getUTF8SequenceSize(
@@ -2700,13 +2796,6 @@ static bool isEndOfBlockCommentWithEscapedNewLine(const char *CurPtr, Lexer *L,
   return true;
 }
 
-#ifdef __SSE2__
-#include <emmintrin.h>
-#elif __ALTIVEC__
-#include <altivec.h>
-#undef bool
-#endif
-
 /// We have just read from input the / and * characters that started a comment.
 /// Read until we find the * and / characters that terminate the comment.
 /// Note that we don't bother decoding trigraphs or escaped newlines in block
@@ -48,6 +48,7 @@
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/Support/Format.h"
 #include "llvm/Support/TimeProfiler.h"
 #include <optional>
 
@@ -560,6 +561,35 @@ void Sema::PrintStats() const {
 
   BumpAlloc.PrintStats();
   AnalysisWarnings.PrintStats();
+
+  if (TemplateInstantiationProfile.empty())
+    return;
+
+  // Report the templates with the most self time first; only the most
+  // expensive ones are listed to keep the output readable.
+  const unsigned MaxTemplatesToPrint = 50;
+  SmallVector<std::pair<const NamedDecl *, TemplateInstantiationStats>, 0>
+      Entries(TemplateInstantiationProfile.begin(),
+              TemplateInstantiationProfile.end());
+  llvm::sort(Entries, [](const auto &LHS, const auto &RHS) {
+    if (LHS.second.SelfNanoseconds != RHS.second.SelfNanoseconds)
+      return LHS.second.SelfNanoseconds > RHS.second.SelfNanoseconds;
+    return LHS.first->getBeginLoc() < RHS.first->getBeginLoc();
+  });
+
+  llvm::errs() << "\n*** Template Instantiation Profile:\n";
+  llvm::errs() << Entries.size() << " templates used; showing at most "
+               << MaxTemplatesToPrint << " by self time.\n";
+  llvm::errs() << "  Self (ms)  Self bytes  Instantiations  Deductions  "
+                  "Template\n";
+  for (const auto &Entry : ArrayRef(Entries).take_front(MaxTemplatesToPrint)) {
+    const TemplateInstantiationStats &Stats = Entry.second;
+    llvm::errs() << llvm::format("%11.3f %11zu %15u %11u  ",
+                                 Stats.SelfNanoseconds / 1e6, Stats.SelfBytes,
+                                 Stats.NumInstantiations, Stats.NumDeductions);
+    Entry.first->printQualifiedName(llvm::errs(), getPrintingPolicy());
+    llvm::errs() << "\n";
+  }
 }
 
 void Sema::diagnoseNullableToNonnullConversion(QualType DstType,
@@ -4070,6 +4070,9 @@ Sema::TemplateDeductionResult Sema::DeduceTemplateArguments(
   if (FunctionTemplate->isInvalidDecl())
     return TDK_Invalid;
 
+  TemplateProfileScope ProfileScope(*this, FunctionTemplate,
+                                    TemplateProfileScope::Deduction);
+
   FunctionDecl *Function = FunctionTemplate->getTemplatedDecl();
   unsigned NumParams = Function->getNumParams();
 
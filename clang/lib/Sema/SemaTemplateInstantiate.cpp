@@ -36,6 +36,7 @@
 #include "clang/Sema/TemplateInstCallback.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/TimeProfiler.h"
+#include <chrono>
 #include <optional>
 
 using namespace clang;
@@ -3031,6 +3032,73 @@ namespace clang {
   }
 }
 
+/// Map a specialization or instantiated member to the template that the
+/// instantiation profile aggregates it under.
+static const NamedDecl *getProfiledTemplate(const Decl *D) {
+  if (const auto *Spec = dyn_cast<ClassTemplateSpecializationDecl>(D))
+    D = Spec->getSpecializedTemplate();
+  else if (const auto *RD = dyn_cast<CXXRecordDecl>(D)) {
+    if (CXXRecordDecl *Member = RD->getInstantiatedFromMemberClass())
+      D = Member;
+  } else if (const auto *FD = dyn_cast<FunctionDecl>(D)) {
+    if (FunctionTemplateDecl *Primary = FD->getPrimaryTemplate())
+      D = Primary;
+    else if (FunctionDecl *Member = FD->getInstantiatedFromMemberFunction())
+      D = Member;
+  }
+  return dyn_cast<NamedDecl>(D->getCanonicalDecl());
+}
+
+static uint64_t getProfileTimeInNanoseconds() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+Sema::TemplateProfileScope::TemplateProfileScope(Sema &SemaRef, const Decl *D,
+                                                 ProfileKind Kind)
+    : SemaRef(SemaRef) {
+  if (!SemaRef.CollectStats || !D)
+    return;
+  Template = getProfiledTemplate(D);
+  if (!Template)
+    return;
+
+  TemplateInstantiationStats &Stats =
+      SemaRef.TemplateInstantiationProfile[Template];
+  if (Kind == Instantiation)
+    ++Stats.NumInstantiations;
+  else
+    ++Stats.NumDeductions;
+
+  Parent = SemaRef.CurrentTemplateProfileScope;
+  SemaRef.CurrentTemplateProfileScope = this;
+  StartBytes = SemaRef.Context.getAllocator().getBytesAllocated();
+  StartNanoseconds = getProfileTimeInNanoseconds();
+}
+
+Sema::TemplateProfileScope::~TemplateProfileScope() {
+  if (!Template)
+    return;
+
+  uint64_t Elapsed = getProfileTimeInNanoseconds() - StartNanoseconds;
+  size_t Allocated =
+      SemaRef.Context.getAllocator().getBytesAllocated() - StartBytes;
+
+  TemplateInstantiationStats &Stats =
+      SemaRef.TemplateInstantiationProfile[Template];
+  Stats.SelfNanoseconds += Elapsed - std::min(Elapsed, NestedNanoseconds);
+  Stats.SelfBytes += Allocated - std::min(Allocated, NestedBytes);
+
+  assert(SemaRef.CurrentTemplateProfileScope == this &&
+         "template profile scopes not properly nested");
+  SemaRef.CurrentTemplateProfileScope = Parent;
+  if (Parent) {
+    Parent->NestedNanoseconds += Elapsed;
+    Parent->NestedBytes += Allocated;
+  }
+}
+
 /// Instantiate the definition of a class from a given pattern.
 ///
 /// \param PointOfInstantiation The point of instantiation within the
@@ -3074,6 +3142,9 @@ Sema::InstantiateClass(SourceLocation PointOfInstantiation,
     return Name;
   });
 
+  TemplateProfileScope ProfileScope(*this, Instantiation,
+                                    TemplateProfileScope::Instantiation);
+
   Pattern = PatternDef;
 
   // Record the point of instantiation.
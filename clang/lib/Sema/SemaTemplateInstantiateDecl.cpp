@@ -4893,6 +4893,8 @@ void Sema::InstantiateFunctionDefinition(SourceLocation PointOfInstantiation,
                                    /*Qualified=*/true);
     return Name;
   });
+  TemplateProfileScope ProfileScope(*this, Function,
+                                    TemplateProfileScope::Instantiation);
 
   // If we're performing recursive template instantiation, create our own
   // queue of pending implicit instantiations that we will instantiate later,
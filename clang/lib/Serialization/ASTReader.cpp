@@ -2101,13 +2101,16 @@ void ASTReader::updateOutOfDateIdentifier(IdentifierInfo &II) {
     PriorGeneration = IdentifierGeneration[&II];
 
   // If there is a global index, look there first to determine which modules
-  // provably do not have any results for this identifier.
+  // provably do not have any results for this identifier. If the index has an
+  // identifier table, an identifier that it doesn't know about is in none of
+  // the indexed modules, so only the modules missing from the index are
+  // searched.
   GlobalModuleIndex::HitSet Hits;
   GlobalModuleIndex::HitSet *HitsPtr = nullptr;
   if (!loadGlobalIndex()) {
-    if (GlobalIndex->lookupIdentifier(II.getName(), Hits)) {
+    if (GlobalIndex->lookupIdentifier(II.getName(), Hits) ||
+        GlobalIndex->hasIdentifierIndex())
       HitsPtr = &Hits;
-    }
   }
 
   IdentifierLookupVisitor Visitor(II.getName(), PriorGeneration,
@@ -8119,13 +8122,14 @@ IdentifierInfo *ASTReader::get(StringRef Name) {
         break;
   } else {
     // If there is a global index, look there first to determine which modules
-    // provably do not have any results for this identifier.
+    // provably do not have any results for this identifier. As above, an
+    // identifier unknown to the index has no results in the indexed modules.
     GlobalModuleIndex::HitSet Hits;
     GlobalModuleIndex::HitSet *HitsPtr = nullptr;
     if (!loadGlobalIndex()) {
-      if (GlobalIndex->lookupIdentifier(Name, Hits)) {
+      if (GlobalIndex->lookupIdentifier(Name, Hits) ||
+          GlobalIndex->hasIdentifierIndex())
         HitsPtr = &Hits;
-      }
     }
 
     ModuleMgr.visit(Visitor, HitsPtr);
@@ -256,8 +256,13 @@ GlobalModuleIndex::readIndex(StringRef Path) {
   IndexPath += Path;
   llvm::sys::path::append(IndexPath, IndexFileName);
 
+  // The index is replaced atomically when it is rewritten, so it can be
+  // mapped for as long as it is live. The bitstream doesn't need a null
+  // terminator, which would prevent mapping files of a multiple of the page
+  // size.
   llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> BufferOrErr =
-      llvm::MemoryBuffer::getFile(IndexPath.c_str());
+      llvm::MemoryBuffer::getFile(IndexPath.c_str(), /*IsText=*/false,
+                                  /*RequiresNullTerminator=*/false);
   if (!BufferOrErr)
     return std::make_pair(nullptr,
                           llvm::errorCodeToError(BufferOrErr.getError()));
@@ -210,11 +210,14 @@ ModuleManager::addModule(StringRef FileName, ModuleKind Type,
       // Get a buffer of the file and close the file descriptor when done.
       // The file is volatile because in a parallel build we expect multiple
       // compiler processes to use the same module file rebuilding it if needed.
+      // With -fmodules-mmap-pcms the user promises that module files are only
+      // ever replaced (never rewritten in place), so the file can be mapped
+      // instead of being copied into memory.
       //
       // RequiresNullTerminator is false because module files don't need it, and
       // this allows the file to still be mmapped.
-      Buf = FileMgr.getBufferForFile(NewModule->File,
-                                     /*IsVolatile=*/true,
+      bool IsVolatile = !HeaderSearchInfo.getHeaderSearchOpts().ModulesMmapPCMs;
+      Buf = FileMgr.getBufferForFile(NewModule->File, IsVolatile,
                                      /*RequiresNullTerminator=*/false);
     }
 
@@ -0,0 +1,313 @@
+//===- CompilationCache.cpp - Cache of -cc1 compilation outputs -----------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Tooling/DependencyScanning/CompilationCache.h"
+#include "clang/Basic/Version.h"
+#include "clang/Frontend/CompilerInvocation.h"
+#include "clang/Tooling/DependencyScanning/DependencyScanningService.h"
+#include "clang/Tooling/DependencyScanning/DependencyScanningWorker.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/BLAKE3.h"
+#include "llvm/Support/EndianStream.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/VirtualFileSystem.h"
+#include "llvm/Support/raw_ostream.h"
+#include <map>
+
+using namespace clang;
+using namespace tooling;
+using namespace dependencies;
+
+/// Identifies the format of the cache entries.
+static constexpr llvm::StringLiteral EntryMagic = "CLANGCC1";
+
+namespace {
+
+/// Collects the files read by a compilation.
+class FileDependencyCollector : public DependencyConsumer {
+public:
+  void handleDependencyOutputOpts(const DependencyOutputOptions &) override {}
+
+  void handleFileDependency(StringRef File) override {
+    Files.push_back(std::string(File));
+  }
+
+  void handlePrebuiltModuleDependency(PrebuiltModuleDep) override {}
+
+  void handleModuleDependency(ModuleDeps) override {}
+
+  void handleContextHash(std::string) override {}
+
+  std::string lookupModuleOutput(const ModuleID &, ModuleOutputKind) override {
+    llvm::report_fatal_error("unexpected module output lookup");
+  }
+
+  std::vector<std::string> Files;
+};
+
+/// Records the result of every status query and open made by the scanner.
+/// Adding them to the key makes it change when a header search would find
+/// another file, including the lookups that failed and the ones made by
+/// __has_include.
+class StatRecordingFileSystem : public llvm::vfs::ProxyFileSystem {
+public:
+  using ProxyFileSystem::ProxyFileSystem;
+
+  llvm::ErrorOr<llvm::vfs::Status> status(const Twine &Path) override {
+    llvm::ErrorOr<llvm::vfs::Status> Result = ProxyFileSystem::status(Path);
+    Lookups.insert({Path.str(), !Result              ? Missing
+                                : Result->isDirectory() ? Directory
+                                                        : File});
+    return Result;
+  }
+
+  llvm::ErrorOr<std::unique_ptr<llvm::vfs::File>>
+  openFileForRead(const Twine &Path) override {
+    llvm::ErrorOr<std::unique_ptr<llvm::vfs::File>> Result =
+        ProxyFileSystem::openFileForRead(Path);
+    Lookups.insert({Path.str(), Result ? File : Missing});
+    return Result;
+  }
+
+  enum LookupResult : char { Missing = '-', Directory = 'd', File = 'f' };
+
+  /// The result of the first lookup of each path, ordered by path.
+  std::map<std::string, LookupResult> Lookups;
+};
+
+} // end anonymous namespace
+
+/// Returns whether \p Text may expand one of the macros whose value depends on
+/// the time of the compilation.
+static bool mayUseTimeMacros(StringRef Text) {
+  return Text.contains("__DATE__") || Text.contains("__TIME__") ||
+         Text.contains("__TIMESTAMP__");
+}
+
+/// Returns whether \p Arg is a -cc1 option whose value, the next argument, is
+/// the path of an output of the compilation.
+static bool isOutputOption(StringRef Arg) {
+  return Arg == "-o" || Arg == "-dependency-file" ||
+         Arg == "-serialize-diagnostic-file" || Arg == "-diagnostic-log-file" ||
+         Arg == "-split-dwarf-output" || Arg == "-stack-usage-file";
+}
+
+CompilationCache::CompilationCache(StringRef Path) : Path(Path) {}
+
+bool CompilationCache::getCacheableOutputs(
+    const CompilerInvocation &Invocation,
+    SmallVectorImpl<std::string> &Outputs) {
+  const FrontendOptions &FrontendOpts = Invocation.getFrontendOpts();
+  switch (FrontendOpts.ProgramAction) {
+  case frontend::EmitAssembly:
+  case frontend::EmitBC:
+  case frontend::EmitLLVM:
+  case frontend::EmitObj:
+    break;
+  default:
+    return false;
+  }
+  if (FrontendOpts.Inputs.size() != 1 || FrontendOpts.OutputFile.empty() ||
+      FrontendOpts.OutputFile == "-")
+    return false;
+
+  // Modules and PCHs are read without being reported as file dependencies by
+  // the scanner.
+  const LangOptions &LangOpts = *Invocation.getLangOpts();
+  if (LangOpts.Modules || LangOpts.CPlusPlusModules ||
+      !FrontendOpts.ModuleFiles.empty() ||
+      !Invocation.getPreprocessorOpts().ImplicitPCHInclude.empty())
+    return false;
+
+  // Neither are these other inputs of the compilation.
+  const CodeGenOptions &CodeGenOpts = Invocation.getCodeGenOpts();
+  if (!CodeGenOpts.ProfileInstrumentUsePath.empty() ||
+      !CodeGenOpts.SampleProfileFile.empty() ||
+      !LangOpts.NoSanitizeFiles.empty())
+    return false;
+
+  // Reject the compilations that write anything else than their main output,
+  // dependency file and diagnostics.
+  const DependencyOutputOptions &DepOpts = Invocation.getDependencyOutputOpts();
+  const DiagnosticOptions &DiagOpts = Invocation.getDiagnosticOpts();
+  if (FrontendOpts.ShowStats || FrontendOpts.TimeTrace ||
+      !FrontendOpts.TimeTracePath.empty() || !FrontendOpts.StatsFile.empty() ||
+      CodeGenOpts.TimePasses || !CodeGenOpts.SplitDwarfOutput.empty() ||
+      !CodeGenOpts.CoverageNotesFile.empty() ||
+      !CodeGenOpts.OptRecordFile.empty() ||
+      !CodeGenOpts.StackUsageOutput.empty() || DepOpts.ShowHeaderIncludes ||
+      !DepOpts.HeaderIncludeOutputFile.empty() ||
+      !DepOpts.DOTOutputFile.empty() ||
+      !DepOpts.ModuleDependencyOutputDir.empty() ||
+      !DiagOpts.DiagnosticSerializationFile.empty() ||
+      !DiagOpts.DiagnosticLogFile.empty() || DiagOpts.VerifyDiagnostics)
+    return false;
+
+  Outputs.push_back(FrontendOpts.OutputFile);
+  if (!DepOpts.OutputFile.empty()) {
+    if (DepOpts.OutputFile == "-")
+      return false;
+    Outputs.push_back(DepOpts.OutputFile);
+  }
+  return true;
+}
+
+llvm::Expected<std::string>
+CompilationCache::computeKey(const std::vector<std::string> &CommandLine,
+                             StringRef WorkingDirectory) {
+  // Find the files read by the compilation. The worker reads them through the
+  // scanning file system, which keeps their contents in the shared cache of
+  // the service. A new service is used for each key, so that every lookup of
+  // the compilation reaches the recording file system once.
+  DependencyScanningService Service(ScanningMode::DependencyDirectivesScan,
+                                    ScanningOutputFormat::Make);
+  auto RecordingFS = llvm::makeIntrusiveRefCnt<StatRecordingFileSystem>(
+      llvm::vfs::createPhysicalFileSystem());
+  DependencyScanningWorker Worker(Service, RecordingFS);
+  FileDependencyCollector Collector;
+  if (llvm::Error Err =
+          Worker.computeDependencies(WorkingDirectory, CommandLine, Collector))
+    return std::move(Err);
+
+  llvm::BLAKE3 Hasher;
+  auto AddString = [&Hasher](StringRef Str) {
+    uint64_t Size = Str.size();
+    Hasher.update(ArrayRef(reinterpret_cast<const uint8_t *>(&Size),
+                           sizeof(Size)));
+    Hasher.update(Str);
+  };
+
+  AddString(getClangFullVersion());
+  AddString(WorkingDirectory);
+  for (size_t I = 0, E = CommandLine.size(); I != E; ++I) {
+    StringRef Arg = CommandLine[I];
+    if (mayUseTimeMacros(Arg))
+      return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                     "the command line uses the time");
+    AddString(Arg);
+    // Leave out the paths of the outputs, but not other arguments that happen
+    // to have the same text, such as the target of the dependency file.
+    if (isOutputOption(Arg))
+      ++I;
+  }
+
+  for (const auto &[LookupPath, Result] : RecordingFS->Lookups) {
+    AddString(LookupPath);
+    AddString(StringRef(reinterpret_cast<const char *>(&Result), 1));
+  }
+
+  DependencyScanningWorkerFilesystem FS(Service.getSharedCache(),
+                                        llvm::vfs::createPhysicalFileSystem());
+  for (const std::string &File : Collector.Files) {
+    llvm::ErrorOr<EntryRef> Entry =
+        FS.getOrCreateFileSystemEntry(File, /*DisableDirectivesScanning=*/true);
+    if (!Entry)
+      return llvm::createStringError(Entry.getError(),
+                                     "cannot read '" + File + "'");
+    StringRef Contents =
+        Entry->isDirectory() ? StringRef() : Entry->getContents();
+    // The outputs of the compilations that use the time would be stale.
+    if (mayUseTimeMacros(Contents))
+      return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                     "'" + File + "' uses the time");
+    AddString(File);
+    AddString(Contents);
+  }
+
+  return llvm::toHex(Hasher.final(), /*LowerCase=*/true);
+}
+
+std::string CompilationCache::getEntryPath(StringRef Key) const {
+  SmallString<256> EntryPath(Path);
+  llvm::sys::path::append(EntryPath, Key.take_front(2), Key);
+  return std::string(EntryPath);
+}
+
+std::optional<std::string>
+CompilationCache::replay(StringRef Key, ArrayRef<std::string> OutputPaths) {
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> Entry =
+      llvm::MemoryBuffer::getFile(getEntryPath(Key), /*IsText=*/false,
+                                  /*RequiresNullTerminator=*/false);
+  if (!Entry)
+    return std::nullopt;
+
+  // An entry is the magic, followed by the number of blobs and each blob as
+  // its size and contents. The first blob holds the diagnostics, the others
+  // the outputs.
+  StringRef Data = (*Entry)->getBuffer();
+  if (!Data.consume_front(EntryMagic))
+    return std::nullopt;
+  SmallVector<StringRef, 4> Blobs;
+  if (Data.size() < sizeof(uint32_t))
+    return std::nullopt;
+  uint32_t NumBlobs = llvm::support::endian::read32le(Data.data());
+  Data = Data.drop_front(sizeof(uint32_t));
+  if (NumBlobs != OutputPaths.size() + 1)
+    return std::nullopt;
+  for (uint32_t I = 0; I < NumBlobs; ++I) {
+    if (Data.size() < sizeof(uint64_t))
+      return std::nullopt;
+    uint64_t Size = llvm::support::endian::read64le(Data.data());
+    Data = Data.drop_front(sizeof(uint64_t));
+    if (Data.size() < Size)
+      return std::nullopt;
+    Blobs.push_back(Data.take_front(Size));
+    Data = Data.drop_front(Size);
+  }
+
+  for (const auto &[OutputPath, Contents] :
+       llvm::zip_equal(OutputPaths, ArrayRef(Blobs).drop_front())) {
+    if (llvm::Error Err = llvm::writeToOutput(
+            OutputPath, [Contents = Contents](raw_ostream &OS) {
+              OS << Contents;
+              return llvm::Error::success();
+            })) {
+      llvm::consumeError(std::move(Err));
+      return std::nullopt;
+    }
+  }
+  return Blobs.front().str();
+}
+
+llvm::Error CompilationCache::store(StringRef Key,
+                                    ArrayRef<std::string> OutputPaths,
+                                    StringRef Diagnostics) {
+  SmallVector<std::unique_ptr<llvm::MemoryBuffer>, 2> Outputs;
+  for (const std::string &OutputPath : OutputPaths) {
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> Output =
+        llvm::MemoryBuffer::getFile(OutputPath, /*IsText=*/false,
+                                    /*RequiresNullTerminator=*/false);
+    if (!Output)
+      return llvm::createStringError(Output.getError(),
+                                     "cannot read '" + OutputPath + "'");
+    Outputs.push_back(std::move(*Output));
+  }
+
+  std::string EntryPath = getEntryPath(Key);
+  if (std::error_code EC = llvm::sys::fs::create_directories(
+          llvm::sys::path::parent_path(EntryPath)))
+    return llvm::createStringError(EC, "cannot create directory for '" +
+                                           EntryPath + "'");
+
+  // The entry is written to a temporary file and renamed, so that concurrent
+  // compilations never see a partial entry.
+  return llvm::writeToOutput(EntryPath, [&](raw_ostream &OS) {
+    llvm::support::endian::Writer Writer(OS, llvm::support::little);
+    OS << EntryMagic;
+    Writer.write<uint32_t>(Outputs.size() + 1);
+    Writer.write<uint64_t>(Diagnostics.size());
+    OS << Diagnostics;
+    for (const std::unique_ptr<llvm::MemoryBuffer> &Output : Outputs) {
+      Writer.write<uint64_t>(Output->getBufferSize());
+      OS << Output->getBuffer();
+    }
+    return llvm::Error::success();
+  });
+}
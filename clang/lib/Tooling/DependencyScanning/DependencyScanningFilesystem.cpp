@@ -7,7 +7,14 @@
 //===----------------------------------------------------------------------===//
 
 #include "clang/Tooling/DependencyScanning/DependencyScanningFilesystem.h"
+#include "clang/Basic/TokenKinds.h"
+#include "clang/Basic/Version.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/BLAKE3.h"
+#include "llvm/Support/EndianStream.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
 #include "llvm/Support/SmallVectorMemoryBuffer.h"
 #include "llvm/Support/Threading.h"
 #include <optional>
@@ -41,6 +48,115 @@ DependencyScanningWorkerFilesystem::readFile(StringRef Filename) {
   return TentativeEntry(Stat, std::move(Buffer));
 }
 
+// The persistent directives cache stores one file per scanned source, named
+// after a hash of the scanner version and the source contents. A file holds
+// the directive tokens followed by the kind and token count of each directive;
+// the directives are consecutive slices of the token array.
+static constexpr llvm::StringLiteral DirectivesCacheMagic = "CSDD";
+static constexpr uint32_t DirectivesCacheVersion = 1;
+
+static std::string getDirectivesCacheFile(StringRef CachePath,
+                                          StringRef Source) {
+  llvm::BLAKE3 Hasher;
+  Hasher.update(getClangFullRepositoryVersion());
+  Hasher.update(llvm::arrayRefFromStringRef(Source));
+  SmallString<128> Path(CachePath);
+  llvm::sys::path::append(Path,
+                          llvm::toHex(Hasher.final(), /*LowerCase=*/true));
+  return std::string(Path);
+}
+
+static bool readCachedDirectives(
+    StringRef CacheFile, StringRef Source,
+    SmallVectorImpl<dependency_directives_scan::Token> &Tokens,
+    SmallVectorImpl<dependency_directives_scan::Directive> &Directives) {
+  using namespace llvm::support;
+  auto Buffer = llvm::MemoryBuffer::getFile(CacheFile, /*IsText=*/false,
+                                            /*RequiresNullTerminator=*/false);
+  if (!Buffer)
+    return false;
+  StringRef Data = (*Buffer)->getBuffer();
+  auto Read32 = [&](uint32_t &V) {
+    if (Data.size() < 4)
+      return false;
+    V = endian::read32le(Data.data());
+    Data = Data.drop_front(4);
+    return true;
+  };
+
+  uint32_t Version, NumTokens, NumDirectives;
+  if (!Data.consume_front(DirectivesCacheMagic) || !Read32(Version) ||
+      Version != DirectivesCacheVersion || !Read32(NumTokens) ||
+      Data.size() / 12 < NumTokens)
+    return false;
+  SmallVector<dependency_directives_scan::Token, 10> NewTokens;
+  NewTokens.reserve(NumTokens);
+  for (uint32_t I = 0; I != NumTokens; ++I) {
+    uint32_t Offset, Length, KindAndFlags;
+    Read32(Offset);
+    Read32(Length);
+    Read32(KindAndFlags);
+    unsigned Kind = KindAndFlags & 0xffff;
+    if (Kind >= tok::NUM_TOKENS || Offset > Source.size() ||
+        Length > Source.size() - Offset)
+      return false;
+    NewTokens.emplace_back(Offset, Length, static_cast<tok::TokenKind>(Kind),
+                           KindAndFlags >> 16);
+  }
+
+  if (!Read32(NumDirectives) || Data.size() / 8 != NumDirectives ||
+      Data.size() % 8 != 0)
+    return false;
+  SmallVector<std::pair<dependency_directives_scan::DirectiveKind, uint32_t>,
+              64>
+      Layout;
+  uint64_t TotalTokens = 0;
+  for (uint32_t I = 0; I != NumDirectives; ++I) {
+    uint32_t Kind, Count;
+    Read32(Kind);
+    Read32(Count);
+    if (Kind > dependency_directives_scan::pp_eof)
+      return false;
+    Layout.emplace_back(
+        static_cast<dependency_directives_scan::DirectiveKind>(Kind), Count);
+    TotalTokens += Count;
+  }
+  if (TotalTokens != NumTokens)
+    return false;
+
+  Tokens = std::move(NewTokens);
+  ArrayRef<dependency_directives_scan::Token> Remaining = Tokens;
+  for (auto [Kind, Count] : Layout) {
+    Directives.emplace_back(Kind, Remaining.take_front(Count));
+    Remaining = Remaining.drop_front(Count);
+  }
+  return true;
+}
+
+static void writeCachedDirectives(
+    StringRef CacheFile, ArrayRef<dependency_directives_scan::Token> Tokens,
+    ArrayRef<dependency_directives_scan::Directive> Directives) {
+  // The file is written to a temporary and renamed, so concurrent scanners
+  // never observe partial entries. Failures only cost a rescan later.
+  llvm::consumeError(llvm::writeToOutput(CacheFile, [&](raw_ostream &OS) {
+    llvm::support::endian::Writer W(OS, llvm::support::little);
+    OS << DirectivesCacheMagic;
+    W.write<uint32_t>(DirectivesCacheVersion);
+    W.write<uint32_t>(Tokens.size());
+    for (const dependency_directives_scan::Token &T : Tokens) {
+      W.write<uint32_t>(T.Offset);
+      W.write<uint32_t>(T.Length);
+      W.write<uint32_t>(uint32_t(T.Kind) | uint32_t(T.Flags) << 16);
+    }
+    W.write<uint32_t>(Directives.size());
+    for (const dependency_directives_scan::Directive &D : Directives) {
+      W.write<uint32_t>(D.Kind);
+      W.write<uint32_t>(D.Tokens.size());
+    }
+    return llvm::Error::success();
+  }));
+}
+
 EntryRef DependencyScanningWorkerFilesystem::scanForDirectivesIfNecessary(
     const CachedFileSystemEntry &Entry, StringRef Filename, bool Disable) {
   if (Entry.isError() || Entry.isDirectory() || Disable ||
@@ -61,15 +177,28 @@ EntryRef DependencyScanningWorkerFilesystem::scanForDirectivesIfNecessary(
     return EntryRef(Filename, Entry);
 
   SmallVector<dependency_directives_scan::Directive, 64> Directives;
-  // Scan the file for preprocessor directives that might affect the
-  // dependencies.
-  if (scanSourceForDependencyDirectives(Contents->Original->getBuffer(),
-                                        Contents->DepDirectiveTokens,
-                                        Directives)) {
-    Contents->DepDirectiveTokens.clear();
-    // FIXME: Propagate the diagnostic if desired by the client.
-    Contents->DepDirectives.store(new std::optional<DependencyDirectivesTy>());
-    return EntryRef(Filename, Entry);
+  StringRef Source = Contents->Original->getBuffer();
+  std::string CacheFile;
+  if (!SharedCache.getDirectivesCachePath().empty())
+    CacheFile =
+        getDirectivesCacheFile(SharedCache.getDirectivesCachePath(), Source);
+
+  if (CacheFile.empty() || !readCachedDirectives(CacheFile, Source,
+                                                 Contents->DepDirectiveTokens,
+                                                 Directives)) {
+    // Scan the file for preprocessor directives that might affect the
+    // dependencies.
+    if (scanSourceForDependencyDirectives(Source, Contents->DepDirectiveTokens,
+                                          Directives)) {
+      Contents->DepDirectiveTokens.clear();
+      // FIXME: Propagate the diagnostic if desired by the client.
+      Contents->DepDirectives.store(
+          new std::optional<DependencyDirectivesTy>());
+      return EntryRef(Filename, Entry);
+    }
+    if (!CacheFile.empty())
+      writeCachedDirectives(CacheFile, Contents->DepDirectiveTokens,
+                            Directives);
   }
 
   // This function performed double-checked locking using `DepDirectives`.
@@ -93,6 +222,41 @@ DependencyScanningFilesystemSharedCache::
   CacheShards = std::make_unique<CacheShard[]>(NumShards);
 }
 
+void DependencyScanningFilesystemSharedCache::setDirectivesCachePath(
+    StringRef Path) {
+  DirectivesCachePath = std::string(Path);
+  if (!DirectivesCachePath.empty() &&
+      llvm::sys::fs::create_directories(DirectivesCachePath))
+    DirectivesCachePath.clear();
+}
+
+bool DependencyScanningFilesystemSharedCache::invalidateEntryForFilename(
+    StringRef Filename) {
+  CacheShard &Shard = getShardForFilename(Filename);
+  const CachedFileSystemEntry *Entry;
+  {
+    std::lock_guard<std::mutex> LockGuard(Shard.CacheLock);
+    auto It = Shard.EntriesByFilename.find(Filename);
+    if (It == Shard.EntriesByFilename.end())
+      return false;
+    Entry = It->getValue();
+    Shard.EntriesByFilename.erase(It);
+  }
+
+  // The file may be modified in place, keeping its unique ID.
+  if (!Entry->isError()) {
+    llvm::sys::fs::UniqueID UID = Entry->getUniqueID();
+    CacheShard &UIDShard = getShardForUID(UID);
+    std::lock_guard<std::mutex> LockGuard(UIDShard.CacheLock);
+    auto It = UIDShard.EntriesByUID.find(UID);
+    if (It != UIDShard.EntriesByUID.end() && It->getSecond() == Entry)
+      UIDShard.EntriesByUID.erase(It);
+  }
+
+  Generation.fetch_add(1, std::memory_order_acq_rel);
+  return true;
+}
+
 DependencyScanningFilesystemSharedCache::CacheShard &
 DependencyScanningFilesystemSharedCache::getShardForFilename(
     StringRef Filename) const {
@@ -202,6 +366,11 @@ DependencyScanningWorkerFilesystem::getOrEmplaceSharedEntryForUID(
 const CachedFileSystemEntry *
 DependencyScanningWorkerFilesystem::findEntryByFilenameWithWriteThrough(
     StringRef Filename) {
+  uint64_t Generation = SharedCache.getGeneration();
+  if (Generation != LocalCacheGeneration) {
+    LocalCache.clear();
+    LocalCacheGeneration = Generation;
+  }
   if (const auto *Entry = LocalCache.findEntryByFilename(Filename))
     return Entry;
   auto &Shard = SharedCache.getShardForFilename(Filename);
@@ -73,6 +73,10 @@ public:
     Generator.printDependencies(S);
   }
 
+  std::vector<std::string> takeDependencies() {
+    return std::move(Dependencies);
+  }
+
 protected:
   std::unique_ptr<DependencyOutputOptions> Opts;
   std::vector<std::string> Dependencies;
@@ -81,12 +85,20 @@ protected:
 
 llvm::Expected<std::string> DependencyScanningTool::getDependencyFile(
     const std::vector<std::string> &CommandLine, StringRef CWD) {
+  std::vector<std::string> FileDeps;
+  return getDependencyFile(CommandLine, CWD, FileDeps);
+}
+
+llvm::Expected<std::string> DependencyScanningTool::getDependencyFile(
+    const std::vector<std::string> &CommandLine, StringRef CWD,
+    std::vector<std::string> &FileDeps) {
   MakeDependencyPrinterConsumer Consumer;
   auto Result = Worker.computeDependencies(CWD, CommandLine, Consumer);
   if (Result)
     return std::move(Result);
   std::string Output;
   Consumer.printDependencies(Output);
+  FileDeps = Consumer.takeDependencies();
   return Output;
 }
 
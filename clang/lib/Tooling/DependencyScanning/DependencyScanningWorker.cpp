@@ -147,12 +147,14 @@ public:
   DependencyScanningAction(
       StringRef WorkingDirectory, DependencyConsumer &Consumer,
       llvm::IntrusiveRefCntPtr<DependencyScanningWorkerFilesystem> DepFS,
+      std::shared_ptr<SharedHeaderSearchCache> HeaderSearchCache,
       ScanningOutputFormat Format, bool OptimizeArgs, bool EagerLoadModules,
       bool DisableFree, std::optional<StringRef> ModuleName = std::nullopt)
       : WorkingDirectory(WorkingDirectory), Consumer(Consumer),
-        DepFS(std::move(DepFS)), Format(Format), OptimizeArgs(OptimizeArgs),
-        EagerLoadModules(EagerLoadModules), DisableFree(DisableFree),
-        ModuleName(ModuleName) {}
+        DepFS(std::move(DepFS)),
+        HeaderSearchCache(std::move(HeaderSearchCache)), Format(Format),
+        OptimizeArgs(OptimizeArgs), EagerLoadModules(EagerLoadModules),
+        DisableFree(DisableFree), ModuleName(ModuleName) {}
 
   bool runInvocation(std::shared_ptr<CompilerInvocation> Invocation,
                      FileManager *FileMgr,
@@ -224,6 +226,9 @@ public:
       };
     }
 
+    // Read the header maps once for all the workers of the service.
+    ScanInstance.getPreprocessorOpts().SharedHeaderSearch = HeaderSearchCache;
+
     // Create the dependency collector that will collect the produced
     // dependencies.
     //
@@ -301,6 +306,7 @@ private:
   StringRef WorkingDirectory;
   DependencyConsumer &Consumer;
   llvm::IntrusiveRefCntPtr<DependencyScanningWorkerFilesystem> DepFS;
+  std::shared_ptr<SharedHeaderSearchCache> HeaderSearchCache;
   ScanningOutputFormat Format;
   bool OptimizeArgs;
   bool EagerLoadModules;
@@ -318,7 +324,8 @@ DependencyScanningWorker::DependencyScanningWorker(
     DependencyScanningService &Service,
     llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> FS)
     : Format(Service.getFormat()), OptimizeArgs(Service.canOptimizeArgs()),
-      EagerLoadModules(Service.shouldEagerLoadModules()) {
+      EagerLoadModules(Service.shouldEagerLoadModules()),
+      HeaderSearchCache(Service.getHeaderSearchCache()) {
   PCHContainerOps = std::make_shared<PCHContainerOperations>();
   PCHContainerOps->registerReader(
       std::make_unique<ObjectFilePCHContainerReader>());
@@ -445,9 +452,22 @@ bool DependencyScanningWorker::computeDependencies(
   // in-process; preserve the original value, which is
   // always true for a driver invocation.
   bool DisableFree = true;
-  DependencyScanningAction Action(WorkingDirectory, Consumer, DepFS, Format,
-                                  OptimizeArgs, EagerLoadModules, DisableFree,
-                                  ModuleName);
+  DependencyScanningAction Action(WorkingDirectory, Consumer, DepFS,
+                                  HeaderSearchCache, Format, OptimizeArgs,
+                                  EagerLoadModules, DisableFree, ModuleName);
+  // A -cc1 command line is scanned as is, without going through the driver.
+  if (FinalCommandLine.size() >= 2 && FinalCommandLine[1] == "-cc1") {
+    ToolInvocation Invocation(FinalCommandLine, &Action, &*FileMgr,
+                              PCHContainerOps);
+    Invocation.setDiagnosticConsumer(Diags->getClient());
+    Invocation.setDiagnosticOptions(&Diags->getDiagnosticOptions());
+    if (!Invocation.run())
+      return false;
+    Consumer.handleBuildCommand(
+        {FinalCommandLine[0], Action.takeLastCC1Arguments()});
+    return true;
+  }
+
   bool Success = forEachDriverJob(
       FinalCommandLine, *Diags, *FileMgr, [&](const driver::Command &Cmd) {
         if (StringRef(Cmd.getCreator().getName()) != "clang") {
@@ -0,0 +1,38 @@
+// Check that scanned directives are stored in and reused from the persistent
+// directives cache.
+
+// RUN: rm -rf %t
+// RUN: split-file %s %t
+// RUN: sed -e "s|DIR|%/t|g" %t/cdb.json.template > %t/cdb.json
+
+// RUN: clang-scan-deps -compilation-database %t/cdb.json \
+// RUN:   -directives-cache-path=%t/cache | FileCheck %s
+// RUN: ls %t/cache | FileCheck %s -check-prefix=CACHE
+// RUN: clang-scan-deps -compilation-database %t/cdb.json \
+// RUN:   -directives-cache-path=%t/cache | FileCheck %s
+
+// CHECK: t.c
+// CHECK: a.h
+// CHECK: b.h
+
+// CACHE: {{^[0-9a-f]{64}$}}
+
+//--- cdb.json.template
+[
+  {
+    "directory": "DIR",
+    "command": "clang -fsyntax-only DIR/t.c -I DIR",
+    "file": "DIR/t.c"
+  }
+]
+
+//--- t.c
+#include "a.h"
+#ifdef A_H
+#include "b.h"
+#endif
+
+//--- a.h
+#define A_H
+
+//--- b.h
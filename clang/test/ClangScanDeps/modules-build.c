@@ -0,0 +1,68 @@
+// Check that -build builds the modules in dependency order, each of them once
+// even when several translation units import it, and then the translation
+// units.
+
+// RUN: rm -rf %t
+// RUN: split-file %s %t
+// RUN: sed "s|DIR|%/t|g" %t/cdb.json.template > %t/cdb.json
+// RUN: clang-scan-deps -compilation-database %t/cdb.json -j 4 \
+// RUN:   -format experimental-full -module-files-dir %t/build -build
+// RUN: find %t/build -name '*.pcm' | sort | FileCheck %s --check-prefix=MODULES
+// RUN: FileCheck %s --check-prefix=IR < %t/tu1.ll
+// RUN: FileCheck %s --check-prefix=IR < %t/tu2.ll
+
+// MODULES:      first-{{.*}}.pcm
+// MODULES-NEXT: second-{{.*}}.pcm
+// MODULES-NEXT: third-{{.*}}.pcm
+// MODULES-NOT:  .pcm
+// IR: define {{.*}} @f
+
+// A module that fails to build stops the translation units importing it.
+// RUN: echo 'int broken thing;' > %t/third/third.h
+// RUN: rm -rf %t/build
+// RUN: not clang-scan-deps -compilation-database %t/cdb.json \
+// RUN:   -format experimental-full -module-files-dir %t/build -build 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=ERROR
+
+// ERROR: Error while building module third
+// ERROR-DAG: Skipped building module second
+// ERROR-DAG: Skipped building module first
+
+// The build requires the full output format.
+// RUN: not clang-scan-deps -compilation-database %t/cdb.json -format make \
+// RUN:   -build 2>&1 | FileCheck %s --check-prefix=FORMAT
+// FORMAT: -build requires -format experimental-full
+
+//--- tu1.c
+#include "first.h"
+int f(void) { return 1; }
+
+//--- tu2.c
+#include "second.h"
+int f(void) { return 2; }
+
+//--- first/module.modulemap
+module first { header "first.h" }
+//--- first/first.h
+#include "second.h"
+
+//--- second/module.modulemap
+module second { header "second.h" }
+//--- second/second.h
+#include "third.h"
+
+//--- third/module.modulemap
+module third { header "third.h" }
+//--- third/third.h
+// empty
+
+//--- cdb.json.template
+[{
+  "file": "DIR/tu1.c",
+  "directory": "DIR",
+  "command": "clang -I DIR/first -I DIR/second -I DIR/third -fmodules -fmodules-cache-path=DIR/cache -S -emit-llvm DIR/tu1.c -o DIR/tu1.ll"
+},{
+  "file": "DIR/tu2.c",
+  "directory": "DIR",
+  "command": "clang -I DIR/first -I DIR/second -I DIR/third -fmodules -fmodules-cache-path=DIR/cache -S -emit-llvm DIR/tu2.c -o DIR/tu2.ll"
+}]
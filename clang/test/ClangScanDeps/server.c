@@ -0,0 +1,103 @@
+// Test that the -server mode answers from its cache, and scans an input again
+// once one of its dependencies changes.
+
+// REQUIRES: system-linux
+
+// RUN: rm -rf %t
+// RUN: split-file %s %t
+// RUN: sed -e "s|DIR|%/t|g" %t/cdb.json.template > %t/cdb.json
+// RUN: %python %t/client.py clang-scan-deps %t/cdb.json %t | FileCheck %s
+
+// CHECK:      scanned: {{.*}}t.o: {{.*}}t.c {{.*}}a.h{{$}}
+// CHECK-NEXT: cached: {{.*}}t.o: {{.*}}t.c {{.*}}a.h{{$}}
+// CHECK-NEXT: scanned: {{.*}}t.o: {{.*}}t.c {{.*}}a.h {{.*}}b.h{{$}}
+// CHECK-NEXT: cached: {{.*}}t.o: {{.*}}t.c {{.*}}a.h {{.*}}b.h{{$}}
+// CHECK-NEXT: error: no compile command
+// CHECK-NEXT: shutdown: 0
+
+//--- cdb.json.template
+[
+  {
+    "directory": "DIR",
+    "command": "clang -fsyntax-only DIR/t.c -o DIR/t.o",
+    "file": "DIR/t.c"
+  }
+]
+
+//--- t.c
+#include "a.h"
+
+//--- a.h
+
+//--- b.h
+
+//--- client.py
+import json
+import os
+import socket
+import subprocess
+import sys
+import tempfile
+import time
+
+scan_deps, cdb, root = sys.argv[1:]
+# The path of a socket is limited to about a hundred characters, which the
+# test directory may exceed.
+sock_path = os.path.join(tempfile.mkdtemp(), "sock")
+server = subprocess.Popen([scan_deps, "-compilation-database", cdb,
+                           "-server", sock_path])
+
+sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+for _ in range(300):
+    try:
+        sock.connect(sock_path)
+        break
+    except OSError:
+        time.sleep(0.1)
+stream = sock.makefile("rw")
+
+
+def request(obj):
+    stream.write(json.dumps(obj) + "\n")
+    stream.flush()
+    return json.loads(stream.readline())
+
+
+def scan(path):
+    return request({"method": "scan", "files": [path]})["results"][0]
+
+
+def show(result):
+    if "error" in result:
+        print("error: " + result["error"])
+        return
+    deps = " ".join(result["dependencies"].replace("\\\n", " ").split())
+    print(("cached: " if result["cached"] else "scanned: ") + deps)
+
+
+t_c = os.path.join(root, "t.c")
+show(scan(t_c))
+# The first scan starts watching the directory, so its result is cached only
+# if nothing changed in the meantime. Scan until it is.
+result = scan(t_c)
+while not result["cached"]:
+    result = scan(t_c)
+show(result)
+
+with open(os.path.join(root, "a.h"), "w") as f:
+    f.write('#include "b.h"\n')
+# The change is seen once the watcher has delivered its event.
+deadline = time.time() + 60
+result = scan(t_c)
+while result["cached"] and time.time() < deadline:
+    time.sleep(0.1)
+    result = scan(t_c)
+show(result)
+result = scan(t_c)
+while not result["cached"]:
+    result = scan(t_c)
+show(result)
+
+show(scan(os.path.join(root, "missing.c")))
+request({"method": "shutdown"})
+print("shutdown: %d" % server.wait())
@@ -0,0 +1,20 @@
+// RUN: %clang_cc1 -fveclib=LLVMlibc -triple x86_64-unknown-linux-gnu %s -vectorize-loops -emit-llvm -O3 -o - | FileCheck %s --check-prefix=X86
+// RUN: %clang_cc1 -fveclib=LLVMlibc -triple aarch64-unknown-linux-gnu -target-feature +neon %s -vectorize-loops -emit-llvm -O3 -o - | FileCheck %s --check-prefix=AARCH64
+
+// REQUIRES: x86-registered-target, aarch64-registered-target
+
+// Make sure -fveclib=LLVMlibc gets passed through to LLVM as expected: a call
+// to the vector variant of expf following the vector function ABI of the
+// target should be generated.
+
+extern float expf(float);
+
+// X86-LABEL: define{{.*}}@apply_exp
+// X86: call <4 x float> @_ZGVbN4v_expf(
+// AARCH64-LABEL: define{{.*}}@apply_exp
+// AARCH64: call <4 x float> @_ZGVnN4v_expf(
+//
+void apply_exp(float *A, float *C, unsigned N) {
+  for (unsigned i = 0; i < N; i++)
+    C[i] = expf(A[i]);
+}
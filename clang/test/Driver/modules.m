@@ -45,6 +45,12 @@
 // RUN: %clang -fmodules -fmodules-disable-diagnostic-validation -### %s 2>&1 | FileCheck -check-prefix=MODULES_DISABLE_DIAGNOSTIC_VALIDATION %s
 // MODULES_DISABLE_DIAGNOSTIC_VALIDATION: -fmodules-disable-diagnostic-validation
 
+// RUN: %clang -fmodules -### %s 2>&1 | FileCheck -check-prefix=MODULES_MMAP_PCMS_DEFAULT %s
+// MODULES_MMAP_PCMS_DEFAULT-NOT: -fmodules-mmap-pcms
+
+// RUN: %clang -fmodules -fmodules-mmap-pcms -### %s 2>&1 | FileCheck -check-prefix=MODULES_MMAP_PCMS %s
+// MODULES_MMAP_PCMS: "-fmodules-mmap-pcms"
+
 // RUN: %clang -fmodules -### %s 2>&1 | FileCheck -check-prefix=MODULES_PREBUILT_PATH_DEFAULT %s
 // MODULES_PREBUILT_PATH_DEFAULT-NOT: -fprebuilt-module-path
 
@@ -0,0 +1,78 @@
+// Test that the styles found for the files of one run stay per directory.
+
+// RUN: rm -rf %t && split-file %s %t/j1 && split-file %s %t/j2
+
+// Files in directories with different .clang-format files get their own
+// style.
+// RUN: clang-format -i %t/j1/a/f.cpp %t/j1/b/f.cpp %t/j1/a/g.cpp %t/j1/b/g.cpp
+// RUN: FileCheck %s --strict-whitespace --check-prefix=TWO < %t/j1/a/f.cpp
+// RUN: FileCheck %s --strict-whitespace --check-prefix=TWO < %t/j1/a/g.cpp
+// RUN: FileCheck %s --strict-whitespace --check-prefix=EIGHT < %t/j1/b/f.cpp
+// RUN: FileCheck %s --strict-whitespace --check-prefix=EIGHT < %t/j1/b/g.cpp
+
+// Formatting the files in parallel gives the same output.
+// RUN: clang-format -i -j2 %t/j2/a/f.cpp %t/j2/b/f.cpp %t/j2/a/g.cpp %t/j2/b/g.cpp
+// RUN: diff %t/j1/a/f.cpp %t/j2/a/f.cpp
+// RUN: diff %t/j1/a/g.cpp %t/j2/a/g.cpp
+// RUN: diff %t/j1/b/f.cpp %t/j2/b/f.cpp
+// RUN: diff %t/j1/b/g.cpp %t/j2/b/g.cpp
+
+// The style of the input read from stdin comes from --assume-filename.
+// RUN: clang-format --assume-filename=%t/j2/b/h.cpp < %t/j2/in.cpp \
+// RUN:   | FileCheck %s --strict-whitespace --check-prefix=EIGHT
+// RUN: clang-format --assume-filename=%t/j2/a/h.cpp < %t/j2/in.cpp \
+// RUN:   | FileCheck %s --strict-whitespace --check-prefix=TWO
+
+// A -style given on the command line is used for every file.
+// RUN: clang-format -style="{IndentWidth: 4}" %t/j2/in.cpp %t/j2/b/f.cpp \
+// RUN:   | FileCheck %s --strict-whitespace --check-prefix=FOUR
+
+// TWO:        {{^}}void f() {
+// TWO-NEXT:   {{^}}  int i;{{$}}
+// TWO-NEXT:   {{^}}  int j;{{$}}
+// EIGHT:      {{^}}void f() {
+// EIGHT-NEXT: {{^}}        int i;{{$}}
+// EIGHT-NEXT: {{^}}        int j;{{$}}
+// FOUR:       {{^}}void f() {
+// FOUR-NEXT:  {{^}}    int i;{{$}}
+// FOUR-NEXT:  {{^}}    int j;{{$}}
+// FOUR:       {{^}}void f() {
+// FOUR-NEXT:  {{^}}    int i;{{$}}
+
+//--- a/.clang-format
+BasedOnStyle: LLVM
+IndentWidth: 2
+
+//--- b/.clang-format
+BasedOnStyle: LLVM
+IndentWidth: 8
+
+//--- in.cpp
+void f() {
+int i;
+int j;
+}
+
+//--- a/f.cpp
+void f() {
+int i;
+int j;
+}
+
+//--- a/g.cpp
+void f() {
+int i;
+int j;
+}
+
+//--- b/f.cpp
+void f() {
+int i;
+int j;
+}
+
+//--- b/g.cpp
+void f() {
+int i;
+int j;
+}
@@ -0,0 +1,130 @@
+// RUN: rm -rf %t && split-file %s %t
+
+// The first compilation is cached, and the second one replays its outputs and
+// diagnostics.
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -emit-llvm -I %t \
+// RUN:   -fcompilation-cache-path=%t/cache -Rcompilation-cache \
+// RUN:   -dependency-file %t/first.d -MT main.o %t/main.c -o %t/first.ll 2>&1 \
+// RUN:   | FileCheck %s --check-prefixes=MISS,WARN
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -emit-llvm -I %t \
+// RUN:   -fcompilation-cache-path=%t/cache -Rcompilation-cache \
+// RUN:   -dependency-file %t/second.d -MT main.o %t/main.c -o %t/second.ll 2>&1 \
+// RUN:   | FileCheck %s --check-prefixes=HIT,WARN
+// RUN: cmp %t/first.ll %t/second.ll
+// RUN: cmp %t/first.d %t/second.d
+
+// MISS: remark: compilation cache miss for '{{.*}}first.ll'
+// HIT: remark: compilation cache hit for '{{.*}}second.ll'
+// WARN: main.c:2:2: warning: cached warning
+// MISS-NOT: cached warning
+// HIT-NOT: cached warning
+
+// The default target of the dependency file is the output, which stays in the
+// key even though the output path does not.
+// RUN: %clang --target=x86_64-unknown-linux-gnu -S -emit-llvm -I %t \
+// RUN:   -fcompilation-cache-path=%t/cache -Rcompilation-cache -MD \
+// RUN:   -MF %t/one.d %t/main.c -o %t/one.ll 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=TARGET-ONE
+// RUN: %clang --target=x86_64-unknown-linux-gnu -S -emit-llvm -I %t \
+// RUN:   -fcompilation-cache-path=%t/cache -Rcompilation-cache -MD \
+// RUN:   -MF %t/two.d %t/main.c -o %t/two.ll 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=TARGET-TWO
+// RUN: FileCheck %s --check-prefix=DEP-ONE < %t/one.d
+// RUN: FileCheck %s --check-prefix=DEP-TWO < %t/two.d
+
+// TARGET-ONE: remark: compilation cache miss for '{{.*}}one.ll'
+// TARGET-TWO: remark: compilation cache miss for '{{.*}}two.ll'
+// DEP-ONE: one.ll: {{.*}}main.c
+// DEP-TWO: two.ll: {{.*}}main.c
+
+// Changing an included header changes the key.
+// RUN: echo '#define VALUE 2' > %t/value.h
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -emit-llvm -I %t \
+// RUN:   -fcompilation-cache-path=%t/cache -Rcompilation-cache \
+// RUN:   -dependency-file %t/third.d -MT main.o %t/main.c -o %t/third.ll 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=CHANGED
+// RUN: FileCheck %s --check-prefix=IR < %t/third.ll
+
+// CHANGED: remark: compilation cache miss for '{{.*}}third.ll'
+// IR: ret i32 2
+
+// Failed compilations are not cached.
+// RUN: not %clang_cc1 -triple x86_64-unknown-linux-gnu -emit-llvm -I %t \
+// RUN:   -fcompilation-cache-path=%t/cache -Rcompilation-cache -DFAIL \
+// RUN:   %t/main.c -o %t/fail.ll 2>&1 | FileCheck %s --check-prefix=FAIL
+// RUN: not %clang_cc1 -triple x86_64-unknown-linux-gnu -emit-llvm -I %t \
+// RUN:   -fcompilation-cache-path=%t/cache -Rcompilation-cache -DFAIL \
+// RUN:   %t/main.c -o %t/fail.ll 2>&1 | FileCheck %s --check-prefix=FAIL
+
+// FAIL: remark: compilation cache miss for '{{.*}}fail.ll'
+// FAIL: error: failed
+
+// A header that an earlier search directory would now provide changes the key,
+// even though the lookup in that directory failed before.
+// RUN: mkdir %t/first
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -emit-llvm -I %t/first \
+// RUN:   -I %t -fcompilation-cache-path=%t/cache -Rcompilation-cache \
+// RUN:   %t/main.c -o %t/search.ll 2>&1 | FileCheck %s --check-prefix=SEARCH
+// RUN: echo '#define VALUE 3' > %t/first/value.h
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -emit-llvm -I %t/first \
+// RUN:   -I %t -fcompilation-cache-path=%t/cache -Rcompilation-cache \
+// RUN:   %t/main.c -o %t/search.ll 2>&1 | FileCheck %s --check-prefix=SEARCH
+// RUN: FileCheck %s --check-prefix=SEARCH-IR < %t/search.ll
+
+// SEARCH: remark: compilation cache miss for '{{.*}}search.ll'
+// SEARCH-IR: ret i32 3
+
+// So does a file that appears for __has_include.
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -emit-llvm -I %t \
+// RUN:   -fcompilation-cache-path=%t/cache -Rcompilation-cache \
+// RUN:   %t/has_include.c -o %t/has_include.ll 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=HAS-INCLUDE
+// RUN: touch %t/optional.h
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -emit-llvm -I %t \
+// RUN:   -fcompilation-cache-path=%t/cache -Rcompilation-cache \
+// RUN:   %t/has_include.c -o %t/has_include.ll 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=HAS-INCLUDE
+// RUN: FileCheck %s --check-prefix=HAS-INCLUDE-IR < %t/has_include.ll
+
+// HAS-INCLUDE: remark: compilation cache miss for '{{.*}}has_include.ll'
+// HAS-INCLUDE-IR: ret i32 1
+
+// The compilations that use the time are not cached.
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -emit-llvm \
+// RUN:   -fcompilation-cache-path=%t/cache -Rcompilation-cache \
+// RUN:   %t/time.c -o %t/time.ll 2>&1 | count 0
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -emit-llvm \
+// RUN:   -fcompilation-cache-path=%t/cache -Rcompilation-cache \
+// RUN:   %t/time.c -o %t/time.ll 2>&1 | count 0
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -emit-llvm \
+// RUN:   -fcompilation-cache-path=%t/cache -Rcompilation-cache \
+// RUN:   '-DVALUE=__DATE__[0]' %t/no_value.c -o %t/time.ll 2>&1 | count 0
+
+// The driver forwards the cache directory.
+// RUN: %clang -### -c -fcompilation-cache-path=%t/cache %t/main.c 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=DRIVER
+// DRIVER: "-cc1" {{.*}}"-fcompilation-cache-path={{.*}}cache"
+
+//--- main.c
+#include "value.h"
+#warning cached warning
+#ifdef FAIL
+#error failed
+#endif
+int f(void) { return VALUE; }
+
+//--- value.h
+#define VALUE 1
+
+//--- has_include.c
+#if __has_include("optional.h")
+int f(void) { return 1; }
+#else
+int f(void) { return 0; }
+#endif
+
+//--- time.c
+const char *f(void) { return __TIME__; }
+
+//--- no_value.c
+int f(void) { return VALUE; }
@@ -0,0 +1,25 @@
+// RUN: %clang_cc1 -fsyntax-only -print-stats %s 2>&1 | FileCheck %s
+
+// CHECK: *** Semantic Analysis Stats:
+// CHECK: *** Template Instantiation Profile:
+// CHECK-NEXT: 3 templates used; showing at most 50 by self time.
+// CHECK-NEXT: Self (ms)  Self bytes  Instantiations  Deductions  Template
+// CHECK-DAG: {{[0-9.]+ +[0-9]+ +3 +0}}  ns::Box
+// CHECK-DAG: {{[0-9.]+ +[0-9]+ +2 +2}}  ns::get
+// CHECK-DAG: {{[0-9.]+ +[0-9]+ +1 +0}}  ns::Box::size
+
+namespace ns {
+template <typename T> struct Box {
+  T Value;
+  int size() const { return sizeof(T); }
+};
+
+template <typename T> T get(const Box<T> &B) { return B.Value; }
+} // namespace ns
+
+int use() {
+  ns::Box<int> I{1};
+  ns::Box<char> C{'c'};
+  ns::Box<long> L{2};
+  return ns::get(I) + ns::get(C) + I.size();
+}
@@ -0,0 +1,64 @@
+// Identifiers that the global module index doesn't know about are in none of
+// the indexed modules, so only the modules missing from the index are searched
+// for them. Make sure that they are still found in those modules.
+
+// RUN: rm -rf %t
+// RUN: split-file %s %t
+//
+// Build A and B, and the global index.
+// RUN: %clang_cc1 -fmodules -fimplicit-module-maps -fdisable-module-hash \
+// RUN:   -fmodules-cache-path=%t/cache -I %t/include %t/ab.c -verify
+// RUN: ls %t/cache | grep modules.idx
+//
+// Look up identifiers through the index, including some that are in none of
+// the modules.
+// RUN: %clang_cc1 -fmodules -fimplicit-module-maps -fdisable-module-hash \
+// RUN:   -fmodules-cache-path=%t/cache -I %t/include %t/ab.c -verify \
+// RUN:   -print-stats 2>&1 | FileCheck %s
+//
+// C isn't in the index, so it is searched for the identifiers that the index
+// doesn't know about.
+// RUN: %clang_cc1 -fmodules -fimplicit-module-maps -fdisable-module-hash \
+// RUN:   -fmodules-cache-path=%t/cache -I %t/include %t/abc.c -verify
+
+// CHECK: *** Global Module Index Statistics:
+// CHECK-NEXT: identifier lookups succeeded
+
+//--- include/module.modulemap
+module A { header "a.h" }
+module B { header "b.h" }
+module C { header "c.h" }
+
+//--- include/a.h
+int a_func(void);
+#define A_MACRO 1
+
+//--- include/b.h
+int b_func(void);
+
+//--- include/c.h
+int c_func(void);
+#define C_MACRO 1
+
+//--- ab.c
+#include "a.h"
+#include "b.h"
+
+#if !A_MACRO || defined(C_MACRO) || defined(IN_NO_MODULE)
+#error wrong macros
+#endif
+
+int ab(void) { return a_func() + b_func(); }
+int none(void) { return in_no_module; } // expected-error {{use of undeclared identifier 'in_no_module'}}
+
+//--- abc.c
+// expected-no-diagnostics
+#include "a.h"
+#include "b.h"
+#include "c.h"
+
+#if !C_MACRO
+#error C_MACRO not found
+#endif
+
+int abc(void) { return a_func() + b_func() + c_func(); }
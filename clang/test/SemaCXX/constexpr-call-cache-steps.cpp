@@ -0,0 +1,24 @@
+// RUN: %clang_cc1 -std=c++14 -fsyntax-only -verify %s -fconstexpr-steps 1000
+
+// A memoized call still uses up the evaluation steps that evaluating it took,
+// so whether an evaluation fits in the step limit does not depend on which
+// calls were evaluated before.
+
+// This takes n + 4 steps, as in constexpr-steps.cpp.
+constexpr int steps(int n) {
+  for (int k = 0; k != n; ++k) {}
+  return n;
+}
+
+static_assert(steps(600) == 600, "");
+static_assert(steps(600) == 600, "");
+
+constexpr int twice(int n) {
+  return steps(n) + // ok, cached
+         steps(n); // expected-note {{step limit}} expected-note {{in call to 'steps(600)'}}
+}
+static_assert(twice(600) == 1200, ""); // expected-error {{constant}} expected-note {{in call to 'twice(600)'}}
+
+// The same calls fit once the steps they take are within the limit.
+static_assert(twice(400) == 800, "");
+static_assert(twice(400) == 800, "");
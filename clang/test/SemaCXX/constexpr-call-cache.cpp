@@ -0,0 +1,43 @@
+// RUN: %clang_cc1 -std=c++20 -fsyntax-only -verify %s
+// expected-no-diagnostics
+
+// Calls to constexpr functions with scalar arguments and results are
+// memoized across the translation unit.
+
+namespace Memoized {
+  constexpr long fib(int N) { return N < 2 ? N : fib(N - 1) + fib(N - 2); }
+  static_assert(fib(20) == 6765);
+  static_assert(fib(19) == 4181);
+
+  constexpr double half(double D) { return D / 2; }
+  static_assert(half(3.0) == 1.5);
+  static_assert(half(-3.0) == -1.5);
+
+  constexpr unsigned char wrap(unsigned char C) { return C + 1; }
+  static_assert(wrap(255) == 0);
+  static_assert(wrap(1) == 2);
+}
+
+namespace ConstantContext {
+  constexpr int sign(int X) {
+    return __builtin_is_constant_evaluated() ? X : -X;
+  }
+  static_assert(sign(1) == 1);
+  constexpr int A = sign(1);
+  static_assert(A == 1);
+}
+
+namespace InFlightValue {
+  // The call made while Obj is being constructed sees the in-flight value of
+  // Obj.N; that result must not be reused once Obj is complete.
+  struct S {
+    int N;
+    constexpr S();
+  };
+  extern const S Obj;
+  constexpr int readN(int) { return Obj.N; }
+  constexpr S::S() : N(1) { N = readN(0) + 1; }
+  constexpr S Obj;
+  static_assert(Obj.N == 2);
+  static_assert(readN(0) == 2);
+}
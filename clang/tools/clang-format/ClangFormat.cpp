@@ -23,8 +23,12 @@
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/InitLLVM.h"
+#include "llvm/Support/Path.h"
 #include "llvm/Support/Process.h"
+#include "llvm/Support/ThreadPool.h"
+#include <atomic>
 #include <fstream>
+#include <mutex>
 
 using namespace llvm;
 using clang::tooling::Replacements;
@@ -200,6 +204,12 @@ static cl::opt<bool>
                           "whether or not to print diagnostics in color"),
                  cl::init(false), cl::cat(ClangFormatCategory), cl::Hidden);
 
+static cl::opt<unsigned>
+    NumThreads("j",
+               cl::desc("Number of files to format in parallel when used with\n"
+                        "-i (0 = number of available cores)."),
+               cl::init(1), cl::cat(ClangFormatCategory));
+
 static cl::list<std::string> FileNames(cl::Positional, cl::desc("[<file> ...]"),
                                        cl::cat(ClangFormatCategory));
 
@@ -215,6 +225,43 @@ static FileID createInMemoryFile(StringRef FileName, MemoryBufferRef Source,
   return Sources.createFileID(*File, SourceLocation(), SrcMgr::C_User);
 }
 
+// Styles already looked up, keyed by the directory and language of the files
+// they apply to, and by the -style and -fallback-style values they were looked
+// up with. Without this, getStyle() walks and parses the configuration files
+// of all parent directories again for every file.
+static StringMap<FormatStyle> StyleCache;
+static std::mutex StyleCacheMutex;
+
+static llvm::Expected<FormatStyle> getStyleForFile(StringRef FileName,
+                                                   StringRef Code) {
+  SmallString<128> Key(FileName);
+  if (std::error_code EC = sys::fs::make_absolute(Key))
+    return make_error<StringError>(EC.message(), EC);
+  sys::path::remove_filename(Key);
+  Key.push_back('\0');
+  Key.append(getLanguageName(guessLanguage(FileName, Code)));
+  Key.push_back('\0');
+  Key.append(Style);
+  Key.push_back('\0');
+  Key.append(FallbackStyle);
+
+  {
+    std::lock_guard<std::mutex> Lock(StyleCacheMutex);
+    auto It = StyleCache.find(Key);
+    if (It != StyleCache.end())
+      return It->second;
+  }
+
+  llvm::Expected<FormatStyle> FormatStyle =
+      getStyle(Style, FileName, FallbackStyle, Code, nullptr,
+               WNoErrorList.isSet(WNoError::Unknown));
+  if (FormatStyle) {
+    std::lock_guard<std::mutex> Lock(StyleCacheMutex);
+    StyleCache.try_emplace(Key, *FormatStyle);
+  }
+  return FormatStyle;
+}
+
 // Parses <start line>:<end line> input to a pair of line numbers.
 // Returns true on error.
 static bool parseLineRange(StringRef Input, unsigned &FromLine,
@@ -439,8 +486,7 @@ static bool format(StringRef FileName) {
   }
 
   llvm::Expected<FormatStyle> FormatStyle =
-      getStyle(Style, AssumedFileName, FallbackStyle, Code->getBuffer(),
-               nullptr, WNoErrorList.isSet(WNoError::Unknown));
+      getStyleForFile(AssumedFileName, Code->getBuffer());
   if (!FormatStyle) {
     llvm::errs() << llvm::toString(FormatStyle.takeError()) << "\n";
     return true;
@@ -622,6 +668,29 @@ int main(int argc, const char **argv) {
     return 1;
   }
 
+  // Files formatted in-place don't share any output, so they can be
+  // processed concurrently. Diagnostics of different files may interleave.
+  if (Inplace && !OutputXML && NumThreads != 1) {
+    std::atomic<bool> AnyError(false);
+    std::atomic<unsigned> FileNo(1);
+    ThreadPool Pool(hardware_concurrency(NumThreads));
+    for (const auto &FileName : FileNames) {
+      Pool.async([&, FileName = StringRef(FileName)] {
+        if (Verbose) {
+          std::string Message = ("Formatting [" + Twine(FileNo++) + "/" +
+                                 Twine(FileNames.size()) + "] " + FileName +
+                                 "\n")
+                                    .str();
+          errs() << Message;
+        }
+        if (clang::format::format(FileName))
+          AnyError = true;
+      });
+    }
+    Pool.wait();
+    return AnyError ? 1 : 0;
+  }
+
   unsigned FileNo = 1;
   for (const auto &FileName : FileNames) {
     if (Verbose) {
@@ -6,6 +6,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "clang/DirectoryWatcher/DirectoryWatcher.h"
 #include "clang/Driver/Compilation.h"
 #include "clang/Driver/Driver.h"
 #include "clang/Frontend/CompilerInstance.h"
@@ -15,9 +16,14 @@
 #include "clang/Tooling/DependencyScanning/DependencyScanningTool.h"
 #include "clang/Tooling/DependencyScanning/DependencyScanningWorker.h"
 #include "clang/Tooling/JSONCompilationDatabase.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringSet.h"
 #include "llvm/ADT/Twine.h"
+#include "llvm/Config/llvm-config.h"
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Errno.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/FileUtilities.h"
 #include "llvm/Support/InitLLVM.h"
 #include "llvm/Support/JSON.h"
@@ -26,10 +32,19 @@
 #include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/Threading.h"
 #include "llvm/TargetParser/Host.h"
+#include <array>
+#include <deque>
+#include <functional>
 #include <mutex>
 #include <optional>
 #include <thread>
 
+#ifdef LLVM_ON_UNIX
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
 using namespace clang;
 using namespace tooling::dependencies;
 
@@ -153,6 +168,13 @@ static llvm::cl::opt<std::string> ModuleFilesDir(
         "'-fmodules-cache-path=' from command lines for implicit modules."),
     llvm::cl::cat(DependencyScannerCategory));
 
+static llvm::cl::opt<std::string> DirectivesCachePath(
+    "directives-cache-path",
+    llvm::cl::desc("Directory of a persistent cache of scanned preprocessor "
+                   "directives, keyed by file contents. It can be shared "
+                   "between invocations and machines."),
+    llvm::cl::cat(DependencyScannerCategory));
+
 static llvm::cl::opt<bool> OptimizeArgs(
     "optimize-args",
     llvm::cl::desc("Whether to optimize command-line arguments of modules."),
@@ -214,6 +236,14 @@ static constexpr bool DoRoundTripDefault = true;
 static constexpr bool DoRoundTripDefault = false;
 #endif
 
+static llvm::cl::opt<bool> Build(
+    "build", llvm::cl::Optional,
+    llvm::cl::desc("with -format experimental-full, build the modules and the "
+                   "translation units instead of printing their commands. Each "
+                   "module is built once, and the commands that do not depend "
+                   "on each other run in parallel."),
+    llvm::cl::init(false), llvm::cl::cat(DependencyScannerCategory));
+
 llvm::cl::opt<bool>
     RoundTripArgs("round-trip-args", llvm::cl::Optional,
                   llvm::cl::desc("verify that command-line arguments are "
@@ -221,6 +251,14 @@ llvm::cl::opt<bool>
                   llvm::cl::init(DoRoundTripDefault),
                   llvm::cl::cat(DependencyScannerCategory));
 
+llvm::cl::opt<std::string> ServerSocket(
+    "server", llvm::cl::Optional,
+    llvm::cl::desc("Instead of scanning the compilation database once, listen "
+                   "on this Unix domain socket and answer dependency queries "
+                   "for its translation units, rescanning only the ones whose "
+                   "files changed. Requires -format make."),
+    llvm::cl::cat(DependencyScannerCategory));
+
 llvm::cl::opt<bool> Verbose("v", llvm::cl::Optional,
                             llvm::cl::desc("Use verbose output."),
                             llvm::cl::init(false),
@@ -273,13 +311,29 @@ static llvm::json::Array toJSONSorted(std::vector<ModuleID> V) {
 
 // Thread safe.
 class FullDeps {
+  /// The compiler and working directory that build a module.
+  struct BuildContext {
+    std::string Executable;
+    std::string WorkingDirectory;
+  };
+
 public:
-  void mergeDeps(StringRef Input, TranslationUnitDeps TUDeps,
+  void mergeDeps(StringRef Input, StringRef CWD, TranslationUnitDeps TUDeps,
                  size_t InputIndex) {
-    mergeDeps(std::move(TUDeps.ModuleGraph), InputIndex);
+    // The modules are built by the compiler that builds the translation unit
+    // discovering them, in its working directory.
+    BuildContext Context;
+    Context.WorkingDirectory = std::string(CWD);
+    for (const Command &Cmd : TUDeps.Commands)
+      if (!Cmd.Arguments.empty() && Cmd.Arguments.front() == "-cc1") {
+        Context.Executable = Cmd.Executable;
+        break;
+      }
+    mergeDeps(std::move(TUDeps.ModuleGraph), InputIndex, Context);
 
     InputDeps ID;
     ID.FileName = std::string(Input);
+    ID.WorkingDirectory = std::string(CWD);
     ID.ContextHash = std::move(TUDeps.ID.ContextHash);
     ID.FileDeps = std::move(TUDeps.FileDeps);
     ID.ModuleDeps = std::move(TUDeps.ClangModuleDeps);
@@ -290,7 +344,8 @@ public:
     Inputs.push_back(std::move(ID));
   }
 
-  void mergeDeps(ModuleDepsGraph Graph, size_t InputIndex) {
+  void mergeDeps(ModuleDepsGraph Graph, size_t InputIndex,
+                 const BuildContext &Context = {}) {
     std::unique_lock<std::mutex> ul(Lock);
     for (const ModuleDeps &MD : Graph) {
       auto I = Modules.find({MD.ID, 0});
@@ -298,10 +353,94 @@ public:
         I->first.InputIndex = std::min(I->first.InputIndex, InputIndex);
         continue;
       }
+      ModuleContexts.insert({{MD.ID, InputIndex}, Context});
       Modules.insert(I, {{MD.ID, InputIndex}, std::move(MD)});
     }
   }
 
+  /// Builds the modules and then the translation units, running the commands
+  /// of each module once even if several translation units import it. A
+  /// command is started as soon as the modules it depends on are built, so
+  /// the independent ones run in parallel on \p Pool.
+  ///
+  /// \returns True if any command failed.
+  bool build(llvm::ThreadPool &Pool, SharedStream &Errs) {
+    struct Job {
+      std::string Description;
+      std::vector<Command> Commands;
+      std::string WorkingDirectory;
+      /// The number of the modules of this job that are left to build.
+      unsigned NumPendingDeps = 0;
+      std::vector<Job *> Dependents;
+    };
+
+    // The jobs refer to each other, so they are kept in a container that
+    // doesn't move them.
+    std::deque<Job> Jobs;
+    std::unordered_map<IndexedModuleID, Job *, IndexedModuleIDHasher>
+        ModuleJobs;
+    for (auto &&M : Modules) {
+      const BuildContext &Context = ModuleContexts[M.first];
+      Job &J = Jobs.emplace_back();
+      J.Description = "module " + M.first.ID.ModuleName;
+      J.Commands.push_back(
+          {Context.Executable.empty() ? "clang" : Context.Executable,
+           M.second.BuildArguments});
+      J.WorkingDirectory = Context.WorkingDirectory;
+      ModuleJobs[M.first] = &J;
+    }
+
+    auto AddDeps = [&](Job &J, const std::vector<ModuleID> &Deps) {
+      for (const ModuleID &Dep : Deps) {
+        auto It = ModuleJobs.find({Dep, 0});
+        if (It == ModuleJobs.end())
+          continue;
+        ++J.NumPendingDeps;
+        It->second->Dependents.push_back(&J);
+      }
+    };
+    for (auto &&M : Modules)
+      AddDeps(*ModuleJobs[M.first], M.second.ClangModuleDeps);
+    for (const InputDeps &I : Inputs) {
+      Job &J = Jobs.emplace_back();
+      J.Description = I.FileName;
+      J.Commands = I.Commands;
+      J.WorkingDirectory = I.WorkingDirectory;
+      AddDeps(J, I.ModuleDeps);
+    }
+
+    std::mutex JobsLock;
+    std::atomic<bool> HadErrors(false);
+    std::function<void(Job &)> Run = [&](Job &J) {
+      for (const Command &Cmd : J.Commands) {
+        if (!runCommand(Cmd, J.WorkingDirectory, Errs)) {
+          Errs.applyLocked([&](raw_ostream &OS) {
+            OS << "Error while building " << J.Description << "\n";
+          });
+          HadErrors = true;
+          return;
+        }
+      }
+      std::unique_lock<std::mutex> LockGuard(JobsLock);
+      for (Job *Dependent : J.Dependents)
+        if (--Dependent->NumPendingDeps == 0)
+          Pool.async([&Run, Dependent]() { Run(*Dependent); });
+    };
+    for (Job &J : Jobs)
+      if (J.NumPendingDeps == 0)
+        Pool.async([&Run, &J]() { Run(J); });
+    Pool.wait();
+
+    // The jobs that still wait for modules have a dependency that failed.
+    for (const Job &J : Jobs)
+      if (J.NumPendingDeps != 0)
+        Errs.applyLocked([&](raw_ostream &OS) {
+          OS << "Skipped building " << J.Description
+             << " because a module it depends on failed to build\n";
+        });
+    return HadErrors;
+  }
+
   bool roundTripCommand(ArrayRef<std::string> ArgStrs,
                         DiagnosticsEngine &Diags) {
     if (ArgStrs.empty() || ArgStrs[0] != "-cc1")
@@ -404,6 +543,55 @@ public:
   }
 
 private:
+  /// Runs \p Cmd, interpreting its relative paths from \p WorkingDirectory.
+  ///
+  /// \returns True on success.
+  static bool runCommand(const Command &Cmd, StringRef WorkingDirectory,
+                         SharedStream &Errs) {
+    std::string Executable = Cmd.Executable;
+    if (!llvm::sys::path::is_absolute(Executable)) {
+      if (llvm::sys::path::has_parent_path(Executable)) {
+        SmallString<256> Path(WorkingDirectory);
+        llvm::sys::path::append(Path, Executable);
+        Executable = std::string(Path);
+      } else if (llvm::ErrorOr<std::string> Program =
+                     llvm::sys::findProgramByName(Executable)) {
+        Executable = *Program;
+      }
+    }
+
+    SmallVector<StringRef, 64> Args{Cmd.Executable};
+    auto ArgsBegin = Cmd.Arguments.begin();
+    // The frontend resolves the relative paths of its inputs and outputs
+    // against -working-directory.
+    if (!Cmd.Arguments.empty() && Cmd.Arguments.front() == "-cc1" &&
+        !WorkingDirectory.empty() &&
+        !llvm::is_contained(Cmd.Arguments, "-working-directory")) {
+      Args.append({"-cc1", "-working-directory", WorkingDirectory});
+      ++ArgsBegin;
+    }
+    Args.append(ArgsBegin, Cmd.Arguments.end());
+
+    if (Verbose)
+      Errs.applyLocked([&](raw_ostream &OS) {
+        llvm::interleave(Args, OS, " ");
+        OS << "\n";
+      });
+
+    std::string ErrMsg;
+    int Result = llvm::sys::ExecuteAndWait(Executable, Args, std::nullopt, {},
+                                           0, 0, &ErrMsg);
+    if (Result == 0)
+      return true;
+    Errs.applyLocked([&](raw_ostream &OS) {
+      OS << "Error while running '" << Executable << "'";
+      if (!ErrMsg.empty())
+        OS << ": " << ErrMsg;
+      OS << "\n";
+    });
+    return false;
+  }
+
   struct IndexedModuleID {
     ModuleID ID;
     mutable size_t InputIndex;
@@ -424,6 +612,7 @@ private:
 
   struct InputDeps {
     std::string FileName;
+    std::string WorkingDirectory;
     std::string ContextHash;
     std::vector<std::string> FileDeps;
     std::vector<ModuleID> ModuleDeps;
@@ -434,12 +623,15 @@ private:
   std::mutex Lock;
   std::unordered_map<IndexedModuleID, ModuleDeps, IndexedModuleIDHasher>
       Modules;
+  std::unordered_map<IndexedModuleID, BuildContext, IndexedModuleIDHasher>
+      ModuleContexts;
   std::vector<InputDeps> Inputs;
 };
 
 static bool handleTranslationUnitResult(
-    StringRef Input, llvm::Expected<TranslationUnitDeps> &MaybeTUDeps,
-    FullDeps &FD, size_t InputIndex, SharedStream &OS, SharedStream &Errs) {
+    StringRef Input, StringRef CWD,
+    llvm::Expected<TranslationUnitDeps> &MaybeTUDeps, FullDeps &FD,
+    size_t InputIndex, SharedStream &OS, SharedStream &Errs) {
   if (!MaybeTUDeps) {
     llvm::handleAllErrors(
         MaybeTUDeps.takeError(), [&Input, &Errs](llvm::StringError &Err) {
@@ -450,7 +642,7 @@ static bool handleTranslationUnitResult(
         });
     return true;
   }
-  FD.mergeDeps(Input, std::move(*MaybeTUDeps), InputIndex);
+  FD.mergeDeps(Input, CWD, std::move(*MaybeTUDeps), InputIndex);
   return false;
 }
 
@@ -691,6 +883,420 @@ getCompilationDataBase(int argc, const char **argv, std::string &ErrorMessage) {
       FEOpts.Inputs[0].getFile(), OutputFile, CommandLine);
 }
 
+#ifdef LLVM_ON_UNIX
+namespace {
+/// Answers dependency queries for the translation units of the compilation
+/// database over a Unix domain socket, for -server.
+///
+/// Each request and each response is a JSON object on a single line:
+///
+///   {"method": "scan", "files": ["/src/a.cpp", ...]}
+///   -> {"results": [{"file": "/src/a.cpp", "dependencies": "...",
+///                    "cached": false}, ...]}
+///   {"method": "shutdown"}
+///   -> {"shutdown": true}
+///
+/// The dependencies are printed in the make format. A failed scan gives an
+/// "error" member instead of "dependencies".
+///
+/// The results are kept until one of the files that they depend on changes.
+/// The directories of these files are watched with DirectoryWatcher. A change
+/// invalidates the entry of the file in the shared filesystem cache and the
+/// results that depend on it, so that only these translation units are
+/// scanned again, and only the changed files are read again. Files created in
+/// directories that are not watched, e.g. a header that would now be found in
+/// an include directory searched before the one of the header it shadows, are
+/// not noticed.
+class ScanDepsServer {
+public:
+  ScanDepsServer(
+      DependencyScanningService &Service, llvm::ThreadPool &Pool,
+      std::vector<std::unique_ptr<DependencyScanningTool>> &WorkerTools,
+      std::vector<tooling::CompileCommand> Inputs);
+
+  /// Serves the connections to the socket until a client requests a shutdown.
+  ///
+  /// \returns True on error.
+  bool serve(StringRef SocketPath);
+
+private:
+  struct ScanResult {
+    std::string Dependencies;
+    /// The absolute paths of the files that the dependencies list, and their
+    /// spellings in the dependency file.
+    std::vector<std::pair<std::string, std::string>> Files;
+  };
+
+  /// \returns True if a client requested a shutdown.
+  bool handleConnection(int FD);
+  llvm::json::Value handleRequest(StringRef Line, bool &Shutdown);
+  llvm::json::Array scan(ArrayRef<std::string> Files);
+
+  /// Watches the directories of the files of the result at \p Index if they
+  /// are not watched yet, and caches the result if they were.
+  void cacheResult(size_t Index, ScanResult Result, uint64_t Generation);
+
+  void handleEvents(StringRef Dir, ArrayRef<DirectoryWatcher::Event> Events,
+                    bool IsInitial);
+  void invalidateFileLocked(StringRef Path);
+  void invalidateAllLocked();
+
+  DependencyScanningService &Service;
+  llvm::ThreadPool &Pool;
+  std::vector<std::unique_ptr<DependencyScanningTool>> &WorkerTools;
+  std::vector<tooling::CompileCommand> Inputs;
+  /// The indexes of the inputs of each absolute filename.
+  llvm::StringMap<SmallVector<size_t, 1>> InputsByFile;
+
+  /// Protects the members below, which the watcher threads update.
+  std::mutex Lock;
+  std::vector<std::optional<std::string>> CachedDependencies;
+  /// The inputs whose cached dependencies list each absolute path.
+  llvm::StringMap<llvm::DenseSet<size_t>> Dependents;
+  /// The spellings of each absolute path in the dependencies.
+  llvm::StringMap<llvm::StringSet<>> Spellings;
+  llvm::StringMap<std::unique_ptr<DirectoryWatcher>> Watchers;
+  /// The directories that cannot be watched, or whose watcher got invalidated
+  /// and has to be recreated.
+  llvm::StringSet<> UnwatchableDirs;
+  llvm::StringSet<> InvalidatedDirs;
+};
+} // end anonymous namespace
+
+static std::string makeAbsolute(StringRef Dir, StringRef Path) {
+  SmallString<256> Result(Path);
+  llvm::sys::fs::make_absolute(Dir, Result);
+  llvm::sys::path::remove_dots(Result, /*remove_dot_dot=*/true);
+  return std::string(Result);
+}
+
+ScanDepsServer::ScanDepsServer(
+    DependencyScanningService &Service, llvm::ThreadPool &Pool,
+    std::vector<std::unique_ptr<DependencyScanningTool>> &WorkerTools,
+    std::vector<tooling::CompileCommand> Inputs)
+    : Service(Service), Pool(Pool), WorkerTools(WorkerTools),
+      Inputs(std::move(Inputs)), CachedDependencies(this->Inputs.size()) {
+  for (auto [I, Input] : llvm::enumerate(this->Inputs))
+    InputsByFile[makeAbsolute(Input.Directory, Input.Filename)].push_back(I);
+}
+
+bool ScanDepsServer::serve(StringRef SocketPath) {
+  sockaddr_un Addr = {};
+  Addr.sun_family = AF_UNIX;
+  if (SocketPath.size() >= sizeof(Addr.sun_path)) {
+    llvm::errs() << "-server: socket path is too long: " << SocketPath << "\n";
+    return true;
+  }
+  memcpy(Addr.sun_path, SocketPath.data(), SocketPath.size());
+
+  // Remove the socket of a server that did not shut down cleanly.
+  llvm::sys::fs::file_status Status;
+  if (!llvm::sys::fs::status(SocketPath, Status) &&
+      Status.type() == llvm::sys::fs::file_type::socket_file)
+    llvm::sys::fs::remove(SocketPath);
+
+  int ListenFD = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (ListenFD < 0 ||
+      ::bind(ListenFD, reinterpret_cast<sockaddr *>(&Addr), sizeof(Addr)) ||
+      ::listen(ListenFD, SOMAXCONN)) {
+    llvm::errs() << "-server: cannot listen on " << SocketPath << ": "
+                 << llvm::sys::StrError() << "\n";
+    if (ListenFD >= 0)
+      ::close(ListenFD);
+    return true;
+  }
+
+  bool HadErrors = false;
+  for (bool Shutdown = false; !Shutdown;) {
+    int FD =
+        llvm::sys::RetryAfterSignal(-1, ::accept, ListenFD, nullptr, nullptr);
+    if (FD < 0) {
+      llvm::errs() << "-server: accept failed: " << llvm::sys::StrError()
+                   << "\n";
+      HadErrors = true;
+      break;
+    }
+    Shutdown = handleConnection(FD);
+    ::close(FD);
+  }
+  ::close(ListenFD);
+  llvm::sys::fs::remove(SocketPath);
+
+  // Stop the watchers, without holding the lock that their callbacks take.
+  llvm::StringMap<std::unique_ptr<DirectoryWatcher>> StoppedWatchers;
+  {
+    std::lock_guard<std::mutex> LockGuard(Lock);
+    StoppedWatchers = std::move(Watchers);
+  }
+  StoppedWatchers.clear();
+  return HadErrors;
+}
+
+bool ScanDepsServer::handleConnection(int FD) {
+  llvm::raw_fd_ostream OS(FD, /*shouldClose=*/false, /*unbuffered=*/false);
+  std::string Buffer;
+  std::array<char, 4096> Chunk;
+  while (true) {
+    ssize_t N = llvm::sys::RetryAfterSignal(-1, ::read, FD, Chunk.data(),
+                                            Chunk.size());
+    if (N <= 0)
+      return false;
+    Buffer.append(Chunk.data(), N);
+
+    size_t Start = 0;
+    for (size_t End; (End = Buffer.find('\n', Start)) != std::string::npos;
+         Start = End + 1) {
+      bool Shutdown = false;
+      OS << handleRequest(StringRef(Buffer).slice(Start, End), Shutdown)
+         << '\n';
+      OS.flush();
+      if (Shutdown)
+        return true;
+    }
+    Buffer.erase(0, Start);
+  }
+}
+
+llvm::json::Value ScanDepsServer::handleRequest(StringRef Line,
+                                                bool &Shutdown) {
+  llvm::Expected<llvm::json::Value> Request = llvm::json::parse(Line);
+  if (!Request)
+    return llvm::json::Object{{"error", llvm::toString(Request.takeError())}};
+  const llvm::json::Object *Object = Request->getAsObject();
+  std::optional<StringRef> Method =
+      Object ? Object->getString("method") : std::nullopt;
+
+  if (Method == "shutdown") {
+    Shutdown = true;
+    return llvm::json::Object{{"shutdown", true}};
+  }
+  if (Method == "scan") {
+    std::vector<std::string> Files;
+    if (const llvm::json::Array *Array = Object->getArray("files"))
+      for (const llvm::json::Value &File : *Array)
+        if (std::optional<StringRef> S = File.getAsString())
+          Files.push_back(makeAbsolute(".", *S));
+    return llvm::json::Object{{"results", scan(Files)}};
+  }
+  return llvm::json::Object{{"error", "unknown method"}};
+}
+
+llvm::json::Array ScanDepsServer::scan(ArrayRef<std::string> Files) {
+  // Destroy the watchers that got invalidated. Their directories are watched
+  // again when a result that depends on one of them is cached. A watcher is
+  // destroyed without holding the lock, as its callback may be waiting for it.
+  std::vector<std::unique_ptr<DirectoryWatcher>> InvalidatedWatchers;
+  {
+    std::lock_guard<std::mutex> LockGuard(Lock);
+    for (const auto &Dir : InvalidatedDirs) {
+      auto It = Watchers.find(Dir.getKey());
+      if (It == Watchers.end())
+        continue;
+      InvalidatedWatchers.push_back(std::move(It->second));
+      Watchers.erase(It);
+    }
+    InvalidatedDirs.clear();
+  }
+  InvalidatedWatchers.clear();
+
+  // Find the inputs to scan, and answer from the cached results.
+  std::vector<llvm::json::Object> Results;
+  std::vector<std::pair<size_t, size_t>> ToScan;
+  {
+    std::lock_guard<std::mutex> LockGuard(Lock);
+    for (const std::string &File : Files) {
+      auto It = InputsByFile.find(File);
+      if (It == InputsByFile.end()) {
+        Results.push_back(llvm::json::Object{{"file", File},
+                                             {"error", "no compile command"}});
+        continue;
+      }
+      for (size_t Index : It->second) {
+        llvm::json::Object Result{{"file", File}};
+        const std::optional<std::string> &Deps = CachedDependencies[Index];
+        Result["cached"] = Deps.has_value();
+        if (Deps)
+          Result["dependencies"] = *Deps;
+        else
+          ToScan.emplace_back(Results.size(), Index);
+        Results.push_back(std::move(Result));
+      }
+    }
+  }
+
+  // Scan the other inputs in parallel. If a file changes during the scan, the
+  // shared cache generation changes and the result is not cached.
+  uint64_t Generation = Service.getSharedCache().getGeneration();
+  std::vector<std::optional<ScanResult>> Scanned(ToScan.size());
+  std::atomic<size_t> Next(0);
+  for (unsigned I = 0, E = std::min<size_t>(Pool.getThreadCount(),
+                                            ToScan.size());
+       I < E; ++I) {
+    Pool.async([&, I] {
+      for (size_t J; (J = Next++) < ToScan.size();) {
+        const tooling::CompileCommand &Input = Inputs[ToScan[J].second];
+        std::vector<std::string> FileDeps;
+        llvm::Expected<std::string> MaybeFile =
+            WorkerTools[I]->getDependencyFile(Input.CommandLine,
+                                              Input.Directory, FileDeps);
+        llvm::json::Object &Result = Results[ToScan[J].first];
+        if (!MaybeFile) {
+          Result.try_emplace("error", llvm::toString(MaybeFile.takeError()));
+          continue;
+        }
+        Result.try_emplace("dependencies", *MaybeFile);
+        Scanned[J].emplace();
+        Scanned[J]->Dependencies = std::move(*MaybeFile);
+        for (std::string &Dep : FileDeps)
+          Scanned[J]->Files.emplace_back(makeAbsolute(Input.Directory, Dep),
+                                         std::move(Dep));
+      }
+    });
+  }
+  Pool.wait();
+
+  for (auto [J, Result] : llvm::enumerate(Scanned))
+    if (Result)
+      cacheResult(ToScan[J].second, std::move(*Result), Generation);
+
+  llvm::json::Array Array;
+  for (llvm::json::Object &Result : Results)
+    Array.push_back(std::move(Result));
+  return Array;
+}
+
+void ScanDepsServer::cacheResult(size_t Index, ScanResult Result,
+                                 uint64_t Generation) {
+  llvm::StringSet<> NewDirs;
+  {
+    std::lock_guard<std::mutex> LockGuard(Lock);
+    bool Watched = true;
+    for (const auto &[Path, Spelling] : Result.Files) {
+      StringRef Dir = llvm::sys::path::parent_path(Path);
+      if (UnwatchableDirs.contains(Dir))
+        return;
+      if (!Watchers.count(Dir)) {
+        NewDirs.insert(Dir);
+        Watched = false;
+      }
+    }
+    if (Watched) {
+      if (Service.getSharedCache().getGeneration() != Generation)
+        return;
+      for (const auto &[Path, Spelling] : Result.Files) {
+        Dependents[Path].insert(Index);
+        Spellings[Path].insert(Spelling);
+      }
+      CachedDependencies[Index] = std::move(Result.Dependencies);
+      return;
+    }
+  }
+
+  // Start watching the new directories, without holding the lock, which the
+  // initial events need. The result is not cached: its files in these
+  // directories may have changed before their watcher started, so their
+  // entries in the shared cache are invalidated and the next query scans the
+  // input again.
+  for (const auto &Dir : NewDirs) {
+    std::string DirPath = Dir.getKey().str();
+    std::unique_ptr<DirectoryWatcher> Watcher;
+    if (llvm::sys::fs::is_directory(DirPath)) {
+      llvm::Expected<std::unique_ptr<DirectoryWatcher>> MaybeWatcher =
+          DirectoryWatcher::create(
+              DirPath,
+              [this, DirPath](ArrayRef<DirectoryWatcher::Event> Events,
+                              bool IsInitial) {
+                handleEvents(DirPath, Events, IsInitial);
+              },
+              /*WaitForInitialSync=*/true);
+      if (MaybeWatcher)
+        Watcher = std::move(*MaybeWatcher);
+      else
+        llvm::errs() << "-server: cannot watch " << DirPath << ": "
+                     << llvm::toString(MaybeWatcher.takeError()) << "\n";
+    }
+
+    std::lock_guard<std::mutex> LockGuard(Lock);
+    if (Watcher)
+      Watchers.try_emplace(DirPath, std::move(Watcher));
+    else
+      UnwatchableDirs.insert(DirPath);
+  }
+
+  for (const auto &[Path, Spelling] : Result.Files) {
+    if (!NewDirs.contains(llvm::sys::path::parent_path(Path)))
+      continue;
+    Service.getSharedCache().invalidateEntryForFilename(Path);
+    Service.getSharedCache().invalidateEntryForFilename(Spelling);
+  }
+}
+
+void ScanDepsServer::handleEvents(StringRef Dir,
+                                  ArrayRef<DirectoryWatcher::Event> Events,
+                                  bool IsInitial) {
+  // The initial events list the files that exist when the watcher starts.
+  if (IsInitial)
+    return;
+
+  std::lock_guard<std::mutex> LockGuard(Lock);
+  for (const DirectoryWatcher::Event &Event : Events) {
+    switch (Event.Kind) {
+    case DirectoryWatcher::Event::EventKind::Removed:
+    case DirectoryWatcher::Event::EventKind::Modified: {
+      SmallString<256> Path(Dir);
+      llvm::sys::path::append(Path, Event.Filename);
+      invalidateFileLocked(Path);
+      break;
+    }
+    case DirectoryWatcher::Event::EventKind::WatchedDirRemoved:
+    case DirectoryWatcher::Event::EventKind::WatcherGotInvalidated:
+      // Events may have been lost. The watcher cannot be destroyed from its
+      // own callback, so it is recreated by the next scan.
+      InvalidatedDirs.insert(Dir);
+      invalidateAllLocked();
+      break;
+    }
+  }
+}
+
+void ScanDepsServer::invalidateFileLocked(StringRef Path) {
+  DependencyScanningFilesystemSharedCache &SharedCache =
+      Service.getSharedCache();
+  bool LookedUp = SharedCache.invalidateEntryForFilename(Path);
+  auto SpellingsIt = Spellings.find(Path);
+  if (SpellingsIt != Spellings.end())
+    for (const auto &Spelling : SpellingsIt->second)
+      LookedUp |= SharedCache.invalidateEntryForFilename(Spelling.getKey());
+
+  auto It = Dependents.find(Path);
+  if (It != Dependents.end()) {
+    for (size_t Index : It->second)
+      CachedDependencies[Index].reset();
+    Dependents.erase(It);
+  } else if (LookedUp) {
+    // A scan looked this file up without depending on it, e.g. a header that
+    // was not found in one of the include directories before the right one.
+    // The results that this affects are not known.
+    for (std::optional<std::string> &Deps : CachedDependencies)
+      Deps.reset();
+  }
+}
+
+void ScanDepsServer::invalidateAllLocked() {
+  DependencyScanningFilesystemSharedCache &SharedCache =
+      Service.getSharedCache();
+  for (const auto &Entry : Spellings) {
+    SharedCache.invalidateEntryForFilename(Entry.getKey());
+    for (const auto &Spelling : Entry.getValue())
+      SharedCache.invalidateEntryForFilename(Spelling.getKey());
+  }
+  Spellings.clear();
+  Dependents.clear();
+  for (std::optional<std::string> &Deps : CachedDependencies)
+    Deps.reset();
+}
+#endif // LLVM_ON_UNIX
+
 int main(int argc, const char **argv) {
   std::string ErrorMessage;
   std::unique_ptr<tooling::CompilationDatabase> Compilations =
@@ -702,6 +1308,25 @@ int main(int argc, const char **argv) {
 
   llvm::cl::PrintOptionValues();
 
+  if (Build && (Format != ScanningOutputFormat::Full || !ModuleName.empty())) {
+    llvm::errs() << "-build requires -format experimental-full, without "
+                    "-module-name\n";
+    return 1;
+  }
+
+  if (!ServerSocket.empty() &&
+      (Format != ScanningOutputFormat::Make || Build || !ModuleName.empty())) {
+    llvm::errs() << "-server requires -format make, without -build or "
+                    "-module-name\n";
+    return 1;
+  }
+#ifndef LLVM_ON_UNIX
+  if (!ServerSocket.empty()) {
+    llvm::errs() << "-server is not supported on this platform\n";
+    return 1;
+  }
+#endif
+
   // The command options are rewritten to run Clang in preprocessor only mode.
   auto AdjustingCompilations =
       std::make_unique<tooling::ArgumentsAdjustingCompilations>(
@@ -773,6 +1398,7 @@ int main(int argc, const char **argv) {
 
   DependencyScanningService Service(ScanMode, Format, OptimizeArgs,
                                     EagerLoadModules);
+  Service.getSharedCache().setDirectivesCachePath(DirectivesCachePath);
   llvm::ThreadPool Pool(llvm::hardware_concurrency(NumThreads));
   std::vector<std::unique_ptr<DependencyScanningTool>> WorkerTools;
   for (unsigned I = 0; I < Pool.getThreadCount(); ++I)
@@ -781,6 +1407,13 @@ int main(int argc, const char **argv) {
   std::vector<tooling::CompileCommand> Inputs =
       AdjustingCompilations->getAllCompileCommands();
 
+#ifdef LLVM_ON_UNIX
+  if (!ServerSocket.empty()) {
+    ScanDepsServer Server(Service, Pool, WorkerTools, std::move(Inputs));
+    return Server.serve(ServerSocket);
+  }
+#endif
+
   std::atomic<bool> HadErrors(false);
   FullDeps FD;
   P1689Deps PD;
@@ -881,8 +1514,8 @@ int main(int argc, const char **argv) {
         } else {
           auto MaybeTUDeps = WorkerTools[I]->getTranslationUnitDependencies(
               Input->CommandLine, CWD, AlreadySeenModules, LookupOutput);
-          if (handleTranslationUnitResult(Filename, MaybeTUDeps, FD, LocalIndex,
-                                          DependencyOS, Errs))
+          if (handleTranslationUnitResult(Filename, CWD, MaybeTUDeps, FD,
+                                          LocalIndex, DependencyOS, Errs))
             HadErrors = true;
         }
       }
@@ -894,7 +1527,11 @@ int main(int argc, const char **argv) {
     if (FD.roundTripCommands(llvm::errs()))
       HadErrors = true;
 
-  if (Format == ScanningOutputFormat::Full)
+  if (Build) {
+    // Don't build anything from a partial scan.
+    if (!HadErrors && FD.build(Pool, Errs))
+      HadErrors = true;
+  } else if (Format == ScanningOutputFormat::Full)
     FD.printFullOutput(llvm::outs());
   else if (Format == ScanningOutputFormat::P1689)
     PD.printDependencies(llvm::outs());
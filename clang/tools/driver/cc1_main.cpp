@@ -25,6 +25,7 @@
 #include "clang/Frontend/TextDiagnosticPrinter.h"
 #include "clang/Frontend/Utils.h"
 #include "clang/FrontendTool/Utils.h"
+#include "clang/Tooling/DependencyScanning/CompilationCache.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/Config/llvm-config.h"
 #include "llvm/LinkAllPasses.h"
@@ -164,6 +165,62 @@ static void ensureSufficientStack() {
 static void ensureSufficientStack() {}
 #endif
 
+namespace {
+/// A stream that writes to another stream and keeps a copy of the output, so
+/// that the diagnostics of a compilation can be stored in the compilation
+/// cache.
+class TeeOStream : public raw_ostream {
+  raw_ostream &OS;
+  std::string &Copy;
+  uint64_t Pos = 0;
+
+  void write_impl(const char *Ptr, size_t Size) override {
+    OS.write(Ptr, Size);
+    Copy.append(Ptr, Size);
+    Pos += Size;
+  }
+
+  uint64_t current_pos() const override { return Pos; }
+
+public:
+  TeeOStream(raw_ostream &OS, std::string &Copy) : OS(OS), Copy(Copy) {
+    SetUnbuffered();
+    enable_colors(OS.colors_enabled());
+  }
+
+  bool is_displayed() const override { return OS.is_displayed(); }
+
+  bool has_colors() const override { return OS.has_colors(); }
+};
+} // end anonymous namespace
+
+/// Computes the compilation cache key of the compilation of \p Clang, if it
+/// can be cached, and adds the paths of its outputs to \p Outputs.
+static std::optional<std::string>
+getCompilationCacheKey(CompilerInstance &Clang, const char *Argv0,
+                       tooling::dependencies::CompilationCache &Cache,
+                       SmallVectorImpl<std::string> &Outputs) {
+  using tooling::dependencies::CompilationCache;
+  if (!CompilationCache::getCacheableOutputs(Clang.getInvocation(), Outputs))
+    return std::nullopt;
+
+  std::vector<std::string> CommandLine =
+      Clang.getInvocation().getCC1CommandLine();
+  CommandLine.insert(CommandLine.begin(), Argv0);
+  SmallString<256> WorkingDir(Clang.getFileSystemOpts().WorkingDir);
+  if (WorkingDir.empty() && llvm::sys::fs::current_path(WorkingDir))
+    return std::nullopt;
+
+  llvm::Expected<std::string> Key =
+      Cache.computeKey(CommandLine, WorkingDir);
+  if (!Key) {
+    // The compilation reports the errors that made the scan fail.
+    llvm::consumeError(Key.takeError());
+    return std::nullopt;
+  }
+  return std::move(*Key);
+}
+
 /// Print supported cpus of the given target.
 static int PrintSupportedCPUs(std::string TargetStr) {
   std::string Error;
@@ -185,6 +242,11 @@ static int PrintSupportedCPUs(std::string TargetStr) {
 int cc1_main(ArrayRef<const char *> Argv, const char *Argv0, void *MainAddr) {
   ensureSufficientStack();
 
+  // The diagnostics of a compilation whose outputs are cached. They outlive
+  // the diagnostics engine, which may not be destroyed with -disable-free.
+  std::string CacheDiagnostics;
+  std::optional<TeeOStream> CacheDiagnosticsOS;
+
   std::unique_ptr<CompilerInstance> Clang(new CompilerInstance());
   IntrusiveRefCntPtr<DiagnosticIDs> DiagID(new DiagnosticIDs());
 
@@ -229,8 +291,17 @@ int cc1_main(ArrayRef<const char *> Argv, const char *Argv0, void *MainAddr) {
     Clang->getHeaderSearchOpts().ResourceDir =
       CompilerInvocation::GetResourcesPath(Argv0, MainAddr);
 
-  // Create the actual diagnostics engine.
-  Clang->createDiagnostics();
+  // Create the actual diagnostics engine. With a compilation cache, the
+  // diagnostics are also kept to be stored with the outputs.
+  FrontendOptions &FrontendOpts = Clang->getFrontendOpts();
+  if (!FrontendOpts.CompilationCachePath.empty()) {
+    CacheDiagnosticsOS.emplace(llvm::errs(), CacheDiagnostics);
+    Clang->createDiagnostics(
+        new TextDiagnosticPrinter(*CacheDiagnosticsOS,
+                                  &Clang->getDiagnosticOpts()));
+  } else {
+    Clang->createDiagnostics();
+  }
   if (!Clang->hasDiagnostics())
     return 1;
 
@@ -245,12 +316,45 @@ int cc1_main(ArrayRef<const char *> Argv, const char *Argv0, void *MainAddr) {
     return 1;
   }
 
+  // Replay the outputs and diagnostics of an identical compilation from the
+  // compilation cache, if there is one.
+  std::optional<tooling::dependencies::CompilationCache> Cache;
+  std::optional<std::string> CacheKey;
+  SmallVector<std::string, 2> CacheOutputs;
+  if (!FrontendOpts.CompilationCachePath.empty()) {
+    Cache.emplace(FrontendOpts.CompilationCachePath);
+    CacheKey = getCompilationCacheKey(*Clang, Argv0, *Cache, CacheOutputs);
+  }
+  if (CacheKey) {
+    if (std::optional<std::string> Diagnostics =
+            Cache->replay(*CacheKey, CacheOutputs)) {
+      Clang->getDiagnostics().Report(diag::remark_compilation_cache_hit)
+          << FrontendOpts.OutputFile;
+      llvm::errs() << *Diagnostics;
+      Clang->getDiagnosticClient().finish();
+      llvm::remove_fatal_error_handler();
+      return 0;
+    }
+    Clang->getDiagnostics().Report(diag::remark_compilation_cache_miss)
+        << FrontendOpts.OutputFile;
+  }
+  // Only store the diagnostics of the compilation itself.
+  CacheDiagnostics.clear();
+
   // Execute the frontend actions.
   {
     llvm::TimeTraceScope TimeScope("ExecuteCompiler");
     Success = ExecuteCompilerInvocation(Clang.get());
   }
 
+  if (Success && CacheKey) {
+    if (llvm::Error Err =
+            Cache->store(*CacheKey, CacheOutputs, CacheDiagnostics))
+      Clang->getDiagnostics().Report(
+          diag::remark_compilation_cache_store_failed)
+          << FrontendOpts.OutputFile << toString(std::move(Err));
+  }
+
   // If any timers were active but haven't been destroyed yet, print their
   // results now.  This happens in -disable-free mode.
   llvm::TimerGroup::printAll(llvm::errs());
@@ -17,6 +17,7 @@
 #include "clang/Driver/Driver.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MD5.h"
 #include "llvm/Support/Path.h"
@@ -97,6 +98,8 @@ void getClangResourcesPathImplAIX(LibClangPathType &LibClangPath) {
 #endif
 
 const std::string &CIndexer::getClangResourcesPath() {
+  std::lock_guard<std::mutex> Lock(Mutex);
+
   // Did we already compute the path?
   if (!ResourcesPath.empty())
     return ResourcesPath;
@@ -150,15 +153,67 @@ const std::string &CIndexer::getClangResourcesPath() {
 }
 
 StringRef CIndexer::getClangToolchainPath() {
+  StringRef ResourcePath = getClangResourcesPath();
+  std::lock_guard<std::mutex> Lock(Mutex);
   if (!ToolchainPath.empty())
     return ToolchainPath;
-  StringRef ResourcePath = getClangResourcesPath();
   ToolchainPath =
       std::string(llvm::sys::path::parent_path(llvm::sys::path::parent_path(
           llvm::sys::path::parent_path(ResourcePath))));
   return ToolchainPath;
 }
 
+namespace {
+/// A file system that remembers the status of every absolute path it was asked
+/// about, including the ones that don't exist, which is what most lookups on
+/// include paths end up being. It is safe to use from several threads.
+class StatusCachingFileSystem : public llvm::vfs::ProxyFileSystem {
+public:
+  StatusCachingFileSystem(IntrusiveRefCntPtr<llvm::vfs::FileSystem> FS)
+      : ProxyFileSystem(std::move(FS)) {}
+
+  llvm::ErrorOr<llvm::vfs::Status> status(const Twine &Path) override {
+    SmallString<256> Storage;
+    StringRef Key = Path.toStringRef(Storage);
+    // Relative paths depend on the working directory of the caller, and the
+    // files of the module cache are written by the parses themselves.
+    if (!llvm::sys::path::is_absolute(Key) || isModuleCacheFile(Key))
+      return ProxyFileSystem::status(Path);
+
+    {
+      std::lock_guard<std::mutex> Lock(Mutex);
+      auto It = Cache.find(Key);
+      if (It != Cache.end())
+        return It->second;
+    }
+    llvm::ErrorOr<llvm::vfs::Status> Result = ProxyFileSystem::status(Key);
+    std::lock_guard<std::mutex> Lock(Mutex);
+    Cache.try_emplace(Key, Result);
+    return Result;
+  }
+
+private:
+  static bool isModuleCacheFile(StringRef Path) {
+    StringRef Name = llvm::sys::path::filename(Path);
+    return Name.endswith(".pcm") || Name.endswith(".timestamp") ||
+           Name == "modules.idx";
+  }
+
+  std::mutex Mutex;
+  llvm::StringMap<llvm::ErrorOr<llvm::vfs::Status>> Cache;
+};
+} // namespace
+
+IntrusiveRefCntPtr<llvm::vfs::FileSystem> CIndexer::getFileSystem() {
+  if (!isOptEnabled(CXGlobalOpt_CacheFileSystemStatus))
+    return nullptr;
+  std::lock_guard<std::mutex> Lock(Mutex);
+  if (!StatusCachingFS)
+    StatusCachingFS = llvm::makeIntrusiveRefCnt<StatusCachingFileSystem>(
+        llvm::vfs::getRealFileSystem());
+  return StatusCachingFS;
+}
+
 LibclangInvocationReporter::LibclangInvocationReporter(
     CIndexer &Idx, OperationKind Op, unsigned ParseOptions,
     llvm::ArrayRef<const char *> Args,
@@ -16,7 +16,10 @@
 
 #include "clang-c/Index.h"
 #include "clang/Frontend/PCHContainerOperations.h"
+#include "llvm/ADT/IntrusiveRefCntPtr.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/Support/VirtualFileSystem.h"
+#include <mutex>
 #include <utility>
 
 namespace llvm {
@@ -43,6 +46,14 @@ class CIndexer {
 
   std::string InvocationEmissionPath;
 
+  /// Shared by all the translation units of the index if
+  /// CXGlobalOpt_CacheFileSystemStatus is set.
+  IntrusiveRefCntPtr<llvm::vfs::FileSystem> StatusCachingFS;
+
+  /// Guards the lazily computed members above, so that translation units can
+  /// be parsed concurrently.
+  std::mutex Mutex;
+
 public:
   CIndexer(std::shared_ptr<PCHContainerOperations> PCHContainerOps =
                std::make_shared<PCHContainerOperations>())
@@ -77,6 +88,10 @@ public:
 
   StringRef getClangToolchainPath();
 
+  /// Get the file system to parse translation units with, or null to use the
+  /// real file system.
+  IntrusiveRefCntPtr<llvm::vfs::FileSystem> getFileSystem();
+
   void setInvocationEmissionPath(StringRef Str) {
     InvocationEmissionPath = std::string(Str);
   }
@@ -216,6 +216,31 @@ TEST(MatchFinder, CheckProfiling) {
   EXPECT_EQ("MyID", Records.begin()->getKey());
 }
 
+TEST(MatchFinder, CheckProfilingPerMatcher) {
+  MatchFinder::MatchFinderOptions Options;
+  llvm::StringMap<llvm::TimeRecord> Records;
+  Options.CheckProfiling.emplace(Records);
+  Options.CheckProfiling->PerMatcher = true;
+  MatchFinder Finder(std::move(Options));
+
+  struct NamedCallback : public MatchFinder::MatchCallback {
+    void run(const MatchFinder::MatchResult &Result) override {}
+    StringRef getID() const override { return "MyID"; }
+  } Callback;
+  Finder.addMatcher(varDecl(), &Callback);
+  Finder.addMatcher(callExpr(), &Callback);
+  Finder.addMatcher(typeLoc(), &Callback);
+  std::unique_ptr<FrontendActionFactory> Factory(
+      newFrontendActionFactory(&Finder));
+  ASSERT_TRUE(tooling::runToolOnCode(Factory->create(), "int x;"));
+
+  EXPECT_EQ(4u, Records.size());
+  EXPECT_TRUE(Records.count("MyID"));
+  EXPECT_TRUE(Records.count("MyID.matcher0.VarDecl"));
+  EXPECT_TRUE(Records.count("MyID.matcher1.CallExpr"));
+  EXPECT_TRUE(Records.count("MyID.matcher2.TypeLoc"));
+}
+
 class VerifyStartOfTranslationUnit : public MatchFinder::MatchCallback {
 public:
   VerifyStartOfTranslationUnit() : Called(false) {}
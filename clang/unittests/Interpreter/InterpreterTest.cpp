@@ -314,4 +314,39 @@ TEST(IncrementalProcessing, InstantiateTemplate) {
   free(NewA);
 }
 
+#ifdef CLANG_INTERPRETER_NO_SUPPORT_EXEC
+TEST(IncrementalProcessing, DISABLED_LazyCompilation) {
+#else
+TEST(IncrementalProcessing, LazyCompilation) {
+#endif
+  Args ClangArgs = {"-Xclang", "-emit-llvm-only"};
+  auto CI = cantFail(clang::IncrementalCompilerBuilder::create(ClangArgs));
+  std::unique_ptr<Interpreter> Interp = cantFail(
+      clang::Interpreter::create(std::move(CI), /*LazyCompilation=*/true));
+
+  // We cannot execute on the platform.
+  if (!HostSupportsJit()) {
+    return;
+  }
+
+  // The initializer of x calls f and g through their lazy stubs.
+  if (llvm::Error Err =
+          Interp->ParseAndExecute("extern \"C\" int g() { return 1; }"
+                                  "extern \"C\" int f() { return g() + 41; }"
+                                  "int x = f();")) {
+    // We cannot execute on the platform.
+    consumeError(std::move(Err));
+    return;
+  }
+  EXPECT_EQ(42, *(int *)cantFail(Interp->getSymbolAddress("x")));
+
+  // Undo removes the lazily compiled functions, which can then be defined
+  // again.
+  cantFail(Interp->Undo());
+  cantFail(Interp->ParseAndExecute("extern \"C\" int f() { return 24; }"));
+  typedef int (*FnTy)();
+  auto F = (FnTy)cantFail(Interp->getSymbolAddress("f"));
+  EXPECT_EQ(24, F());
+}
+
 } // end anonymous namespace
@@ -248,6 +248,79 @@ TEST_F(HeaderSearchTest, HeaderMapReverseLookup) {
             "d.h");
 }
 
+TEST_F(HeaderSearchTest, SharedHeaderMapCache) {
+  typedef NullTerminatedFile<test::HMapFileMock<2, 32>, char> FileTy;
+  auto MakeHeaderMap = [](FileTy &File, StringRef Prefix) {
+    File.init();
+    test::HMapFileMockMaker<FileTy> Maker(File);
+    auto a = Maker.addString("d.h");
+    auto b = Maker.addString(Prefix);
+    auto c = Maker.addString("c.h");
+    Maker.addBucket("d.h", a, b, c);
+  };
+  FileTy File;
+  MakeHeaderMap(File, "b/");
+  // Another header map of the same size, that says something else.
+  FileTy Other;
+  MakeHeaderMap(Other, "p/");
+
+  VFS->addFile("/x/y/z.hmap", 0, File.getBuffer(), /*User=*/std::nullopt,
+               /*Group=*/std::nullopt, llvm::sys::fs::file_type::regular_file);
+  VFS->addFile("/p/z.hmap", 0, Other.getBuffer(), /*User=*/std::nullopt,
+               /*Group=*/std::nullopt, llvm::sys::fs::file_type::regular_file);
+  auto FE = FileMgr.getFile("/x/y/z.hmap", true);
+  ASSERT_TRUE(FE);
+
+  auto Cache = std::make_shared<SharedHeaderSearchCache>();
+  Search.setSharedCache(Cache);
+  const HeaderMap *HM1 = Search.CreateHeaderMap(*FE);
+  ASSERT_TRUE(HM1);
+
+  // A second compilation, with its own FileManager, reads the cached buffer.
+  FileManager FileMgr2(FileMgrOpts, VFS);
+  SourceManager SourceMgr2(Diags, FileMgr2);
+  HeaderSearch Search2(std::make_shared<HeaderSearchOptions>(), SourceMgr2,
+                       Diags, LangOpts, Target.get());
+  Search2.setSharedCache(Cache);
+  auto FE2 = FileMgr2.getFile("/x/y/z.hmap", true);
+  ASSERT_TRUE(FE2);
+  const HeaderMap *HM2 = Search2.CreateHeaderMap(*FE2);
+  ASSERT_TRUE(HM2);
+  EXPECT_NE(HM1, HM2);
+  EXPECT_EQ(Cache->getHeaderMapBuffer(*FE, FileMgr)->getBufferStart(),
+            Cache->getHeaderMapBuffer(*FE2, FileMgr2)->getBufferStart());
+
+  SmallString<64> DestPath;
+  EXPECT_EQ(HM1->lookupFilename("d.h", DestPath), "b/c.h");
+  DestPath.clear();
+  EXPECT_EQ(HM2->lookupFilename("d.h", DestPath), "b/c.h");
+
+  // Compilations in different working directories can name different header
+  // maps with the same relative path. Each of them sees its own.
+  auto LookupInWorkingDir = [&](StringRef WorkingDir) {
+    FileSystemOptions Opts;
+    Opts.WorkingDir = std::string(WorkingDir);
+    FileManager FM(Opts, VFS);
+    SourceManager SM(Diags, FM);
+    HeaderSearch HS(std::make_shared<HeaderSearchOptions>(), SM, Diags,
+                    LangOpts, Target.get());
+    HS.setSharedCache(Cache);
+    auto RelFE = FM.getFile("z.hmap", true);
+    EXPECT_TRUE(RelFE);
+    if (!RelFE)
+      return std::string();
+    const HeaderMap *HM = HS.CreateHeaderMap(*RelFE);
+    EXPECT_TRUE(HM);
+    if (!HM)
+      return std::string();
+    SmallString<64> Path;
+    return HM->lookupFilename("d.h", Path).str();
+  };
+  EXPECT_EQ(LookupInWorkingDir("/x/y"), "b/c.h");
+  EXPECT_EQ(LookupInWorkingDir("/p"), "p/c.h");
+  EXPECT_EQ(LookupInWorkingDir("/x/y"), "b/c.h");
+}
+
 TEST_F(HeaderSearchTest, HeaderMapFrameworkLookup) {
   typedef NullTerminatedFile<test::HMapFileMock<4, 128>, char> FileTy;
   FileTy File;
@@ -28,6 +28,7 @@
 #include "llvm/ADT/StringRef.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include <cstring>
 #include <memory>
 #include <vector>
 
@@ -660,4 +661,74 @@ TEST_F(LexerTest, RawAndNormalLexSameForLineComments) {
   }
   EXPECT_TRUE(ToksView.empty());
 }
+
+// The lexer skips identifiers, whitespace and line comments 16 bytes at a time
+// where it can. Check runs of every length up to a few vectors, followed by
+// each kind of character that stops them, also right before the end of the
+// buffer.
+TEST_F(LexerTest, LongRunsAroundVectorBoundaries) {
+  struct RawToken {
+    tok::TokenKind Kind;
+    unsigned Offset;
+    unsigned Length;
+  };
+  auto LexRaw = [&](const std::string &Source) {
+    FileID FID = SourceMgr.createFileID(llvm::MemoryBuffer::getMemBuffer(
+        Source, "<input>", /*RequiresNullTerminator=*/true));
+    llvm::MemoryBufferRef Buffer = SourceMgr.getBufferOrFake(FID);
+    Lexer L(FID, Buffer, SourceMgr, LangOpts);
+    std::vector<RawToken> Toks;
+    Token T;
+    while (true) {
+      L.LexFromRawLexer(T);
+      if (T.is(tok::eof))
+        return Toks;
+      Toks.push_back({T.getKind(), SourceMgr.getFileOffset(T.getLocation()),
+                      T.getLength()});
+    }
+  };
+  // Accept the non-ASCII characters in identifiers, and line comments.
+  LangOpts.CPlusPlus = LangOpts.CPlusPlus11 = true;
+  LangOpts.LineComment = true;
+
+  for (unsigned N = 1; N <= 40; ++N) {
+    std::string Run(N, 'a');
+    for (unsigned I = 0; I < N; ++I)
+      Run[I] = "aZ_9"[I % 4];
+
+    // An identifier, ended by punctuation, a non-ASCII character, an escaped
+    // newline or the end of the buffer.
+    for (const char *Tail : {";", "\xc3\xa9;", "\\\nb;", ""}) {
+      auto Toks = LexRaw("a" + Run + Tail);
+      ASSERT_FALSE(Toks.empty());
+      EXPECT_EQ(Toks[0].Kind, tok::raw_identifier);
+      EXPECT_EQ(Toks[0].Offset, 0u);
+      EXPECT_GE(Toks[0].Length, N + 1);
+      EXPECT_EQ(Toks.size(), *Tail ? 2u : 1u) << N << " " << Tail;
+    }
+
+    // Horizontal whitespace of every kind, then a token.
+    std::string Blanks(N, ' ');
+    for (unsigned I = 0; I < N; ++I)
+      Blanks[I] = " \t\f\v"[I % 4];
+    for (const char *Tail : {"x", "\nx", ""}) {
+      auto Toks = LexRaw(";" + Blanks + Tail);
+      ASSERT_EQ(Toks.size(), *Tail ? 2u : 1u) << N << " " << Tail;
+      if (*Tail)
+        EXPECT_EQ(Toks[1].Offset, N + 1 + (Tail[0] == '\n'));
+    }
+
+    // A line comment, with or without a non-ASCII character in it, ended by
+    // a newline, a DOS-style newline or the end of the buffer.
+    for (const char *Body : {"", "\xc3\xa9"}) {
+      std::string Comment = "//" + Run + Body + Run;
+      for (const char *Tail : {"\nx", "\r\nx", ""}) {
+        auto Toks = LexRaw(Comment + Tail);
+        ASSERT_EQ(Toks.size(), *Tail ? 1u : 0u) << N << " " << Tail;
+        if (*Tail)
+          EXPECT_EQ(Toks[0].Offset, Comment.size() + strlen(Tail) - 1);
+      }
+    }
+  }
+}
 } // anonymous namespace
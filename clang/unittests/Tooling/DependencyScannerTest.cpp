@@ -18,6 +18,8 @@
 #include "clang/Tooling/Tooling.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/MC/TargetRegistry.h"
+#include "llvm/Support/EndianStream.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/FormatVariadic.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/TargetSelect.h"
@@ -239,3 +241,87 @@ TEST(DependencyScanner, ScanDepsWithFS) {
   EXPECT_EQ(convert_to_slash(DepFile),
             "test.cpp.o: /root/test.cpp /root/header.h\n");
 }
+
+TEST(DependencyScanningFilesystem, InvalidateEntry) {
+  auto InMemoryFS = llvm::makeIntrusiveRefCnt<llvm::vfs::InMemoryFileSystem>();
+  InMemoryFS->setCurrentWorkingDirectory("/");
+
+  DependencyScanningFilesystemSharedCache SharedCache;
+  DependencyScanningWorkerFilesystem DepFS(SharedCache, InMemoryFS);
+
+  // The stat failure of a source file is cached.
+  EXPECT_FALSE(DepFS.status("/header.h"));
+  InMemoryFS->addFile("/header.h", 0, llvm::MemoryBuffer::getMemBuffer("\n"));
+  EXPECT_FALSE(DepFS.status("/header.h"));
+
+  uint64_t Generation = SharedCache.getGeneration();
+  EXPECT_TRUE(SharedCache.invalidateEntryForFilename("/header.h"));
+  EXPECT_NE(Generation, SharedCache.getGeneration());
+  EXPECT_TRUE(DepFS.status("/header.h"));
+
+  // Invalidating an unknown filename does nothing.
+  Generation = SharedCache.getGeneration();
+  EXPECT_FALSE(SharedCache.invalidateEntryForFilename("/unknown.h"));
+  EXPECT_EQ(Generation, SharedCache.getGeneration());
+}
+
+TEST(DependencyScanningFilesystem, PersistentDirectivesCache) {
+  using namespace dependency_directives_scan;
+  SmallString<128> CacheDir;
+  ASSERT_FALSE(
+      llvm::sys::fs::createUniqueDirectory("directives-cache", CacheDir));
+
+  auto InMemoryFS = llvm::makeIntrusiveRefCnt<llvm::vfs::InMemoryFileSystem>();
+  InMemoryFS->setCurrentWorkingDirectory("/");
+  InMemoryFS->addFile(
+      "/t.c", 0, llvm::MemoryBuffer::getMemBuffer("#include \"a.h\"\n"
+                                                  "#define X\n"));
+
+  // Each service starts with an empty in-memory cache, as a new process does.
+  auto GetDirectiveKinds = [&] {
+    DependencyScanningFilesystemSharedCache SharedCache;
+    SharedCache.setDirectivesCachePath(CacheDir);
+    DependencyScanningWorkerFilesystem DepFS(SharedCache, InMemoryFS);
+    std::vector<DirectiveKind> Kinds;
+    auto Entry = DepFS.getOrCreateFileSystemEntry("/t.c");
+    EXPECT_TRUE(Entry);
+    if (!Entry)
+      return Kinds;
+    if (auto Directives = Entry->getDirectiveTokens())
+      for (const Directive &D : *Directives)
+        Kinds.push_back(D.Kind);
+    return Kinds;
+  };
+  auto WriteEntry = [&](StringRef Path, ArrayRef<uint32_t> Words) {
+    std::error_code EC;
+    llvm::raw_fd_ostream OS(Path, EC);
+    ASSERT_FALSE(EC);
+    OS << "CSDD";
+    llvm::support::endian::Writer W(OS, llvm::support::little);
+    for (uint32_t Word : Words)
+      W.write<uint32_t>(Word);
+  };
+
+  std::vector<DirectiveKind> Scanned = {pp_include, pp_define, pp_eof};
+  EXPECT_EQ(GetDirectiveKinds(), Scanned);
+
+  // The scan stored exactly one entry.
+  std::vector<std::string> Entries;
+  std::error_code EC;
+  for (llvm::sys::fs::directory_iterator I(CacheDir, EC), E; I != E && !EC;
+       I.increment(EC))
+    Entries.push_back(I->path());
+  ASSERT_EQ(Entries.size(), 1u);
+
+  // Replace the entry with a valid one that only holds the end of file. A
+  // scan that reads the cache sees it instead of the directives of the file.
+  WriteEntry(Entries[0], {/*Version=*/1, /*NumTokens=*/0, /*NumDirectives=*/1,
+                          pp_eof, /*Count=*/0});
+  EXPECT_EQ(GetDirectiveKinds(), std::vector<DirectiveKind>{pp_eof});
+
+  // An inconsistent entry is ignored and the file is scanned again.
+  WriteEntry(Entries[0], {/*Version=*/1, /*NumTokens=*/1, 0, 1000, 0});
+  EXPECT_EQ(GetDirectiveKinds(), Scanned);
+
+  llvm::sys::fs::remove_directories(CacheDir);
+}
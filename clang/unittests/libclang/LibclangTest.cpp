@@ -434,6 +434,43 @@ TEST_F(LibclangParseTest, EvaluateChildExpression) {
       nullptr);
 }
 
+TEST_F(LibclangParseTest, CacheFileSystemStatus) {
+  clang_CXIndex_setGlobalOptions(Index, CXGlobalOpt_CacheFileSystemStatus);
+  EXPECT_EQ(clang_CXIndex_getGlobalOptions(Index),
+            (unsigned)CXGlobalOpt_CacheFileSystemStatus);
+
+  std::string Contents = "#if __has_include(\"header.h\")\n"
+                         "#error header found\n"
+                         "#endif\n";
+  std::string First = "first.c", Second = "second.c";
+  WriteFile(First, Contents);
+  WriteFile(Second, Contents);
+  ClangTU = clang_parseTranslationUnit(Index, First.c_str(), nullptr, 0,
+                                       nullptr, 0, TUFlags);
+  ASSERT_TRUE(ClangTU);
+  EXPECT_EQ(0u, clang_getNumDiagnostics(ClangTU));
+  clang_disposeTranslationUnit(ClangTU);
+
+  // The index remembers that the header doesn't exist.
+  std::string Header = "header.h";
+  WriteFile(Header, "");
+  ClangTU = clang_parseTranslationUnit(Index, Second.c_str(), nullptr, 0,
+                                       nullptr, 0, TUFlags);
+  ASSERT_TRUE(ClangTU);
+  EXPECT_EQ(0u, clang_getNumDiagnostics(ClangTU));
+  clang_disposeTranslationUnit(ClangTU);
+
+  // A new index sees it.
+  CXIndex OtherIndex = clang_createIndex(0, 0);
+  ClangTU = clang_parseTranslationUnit(OtherIndex, Second.c_str(), nullptr, 0,
+                                       nullptr, 0, TUFlags);
+  ASSERT_TRUE(ClangTU);
+  EXPECT_EQ(1u, clang_getNumDiagnostics(ClangTU));
+  clang_disposeTranslationUnit(ClangTU);
+  ClangTU = nullptr;
+  clang_disposeIndex(OtherIndex);
+}
+
 class LibclangReparseTest : public LibclangParseTest {
 public:
   void DisplayDiagnostics() {
@@ -100,12 +100,21 @@ static void ChunkCallback(uptr chunk, void *arg) {
       FindHeapChunkByAllocBeg(chunk));
 }
 
+static void PrintStackDepotStats() {
+  StackDepotStats stats = StackDepotGetStats();
+  Printf("Stack depot: %zd unique stacks, %zd KiB allocated, %zd KiB released "
+         "by compression\n",
+         stats.n_uniq_ids, stats.allocated >> 10,
+         StackDepotGetPackedBytes() >> 10);
+}
+
 static void MemoryProfileCB(const SuspendedThreadsList &suspended_threads_list,
                             void *argument) {
   HeapProfile hp;
   __lsan::ForEachChunk(ChunkCallback, &hp);
   uptr *Arg = reinterpret_cast<uptr*>(argument);
   hp.Print(Arg[0], Arg[1]);
+  PrintStackDepotStats();
 
   if (Verbosity())
     __asan_print_accumulated_stats();
@@ -26,6 +26,23 @@ u32 GetMallocContextSize() {
   return atomic_load(&malloc_context_size, memory_order_acquire);
 }
 
+u32 GetSampledMallocContextSize() {
+  u32 rate = flags()->malloc_context_sample_rate;
+  if (LIKELY(rate <= 1))
+    return GetMallocContextSize();
+  // A per-thread countdown is enough here, the stacks don't need to be
+  // sampled uniformly across threads.
+  static THREADLOCAL u32 countdown;
+  if (countdown) {
+    --countdown;
+    // Keep the top frame, reports expect a non-empty stack and it doesn't
+    // need an unwind.
+    return 1;
+  }
+  countdown = rate - 1;
+  return GetMallocContextSize();
+}
+
 namespace {
 
 // ScopedUnwinding is a scope for stacktracing member of a context
@@ -25,6 +25,9 @@ static const u32 kDefaultMallocContextSize = 30;
 
 void SetMallocContextSize(u32 size);
 u32 GetMallocContextSize();
+// Returns the malloc context size to use for the current allocation or
+// deallocation, which is 1 for calls not sampled by malloc_context_sample_rate.
+u32 GetSampledMallocContextSize();
 
 } // namespace __asan
 
@@ -58,7 +61,8 @@ u32 GetMallocContextSize();
   GET_STACK_TRACE(kStackTraceMax, true)
 
 #define GET_STACK_TRACE_MALLOC                                                 \
-  GET_STACK_TRACE(GetMallocContextSize(), common_flags()->fast_unwind_on_malloc)
+  const u32 malloc_stack_size = GetSampledMallocContextSize();                 \
+  GET_STACK_TRACE(malloc_stack_size, common_flags()->fast_unwind_on_malloc)
 
 #define GET_STACK_TRACE_FREE GET_STACK_TRACE_MALLOC
 
@@ -101,6 +101,7 @@ struct GlobalEnv {
   int Verbosity = 0;
   int Group = 0;
   int NumCorpuses = 8;
+  bool MergeByFeatures = false;
 
   size_t NumTimeouts = 0;
   size_t NumOOMs = 0;
@@ -201,6 +202,7 @@ struct GlobalEnv {
     NumRuns += Stats.number_of_executed_units;
 
     std::vector<SizedFile> TempFiles, MergeCandidates;
+    std::vector<std::vector<uint32_t>> CandidateFeatures;
     // Read all newly created inputs and their feature sets.
     // Choose only those inputs that have new features.
     GetSizedFilesFromDir(Job->CorpusDir, &TempFiles);
@@ -215,6 +217,7 @@ struct GlobalEnv {
       for (auto Ft : NewFeatures) {
         if (!Features.count(Ft)) {
           MergeCandidates.push_back(F);
+          CandidateFeatures.push_back(std::move(NewFeatures));
           break;
         }
       }
@@ -230,11 +233,26 @@ struct GlobalEnv {
 
     std::vector<std::string> FilesToAdd;
     std::set<uint32_t> NewFeatures, NewCov;
-    bool IsSetCoverMerge =
-        !Job->Cmd.getFlagValue("set_cover_merge").compare("1");
-    CrashResistantMerge(Args, {}, MergeCandidates, &FilesToAdd, Features,
-                        &NewFeatures, Cov, &NewCov, Job->CFPath, false,
-                        IsSetCoverMerge);
+    if (MergeByFeatures) {
+      // The feature sets were recorded by the job when it added the inputs,
+      // so there is no need to execute them again. Like the merge, prefer the
+      // smaller inputs, which come first, and only keep an input if it still
+      // adds features once the previous ones were added.
+      for (size_t i = 0; i < MergeCandidates.size(); i++) {
+        bool HasNewFeatures = false;
+        for (auto Ft : CandidateFeatures[i])
+          if (!Features.count(Ft) && NewFeatures.insert(Ft).second)
+            HasNewFeatures = true;
+        if (HasNewFeatures)
+          FilesToAdd.push_back(MergeCandidates[i].File);
+      }
+    } else {
+      bool IsSetCoverMerge =
+          !Job->Cmd.getFlagValue("set_cover_merge").compare("1");
+      CrashResistantMerge(Args, {}, MergeCandidates, &FilesToAdd, Features,
+                          &NewFeatures, Cov, &NewCov, Job->CFPath, false,
+                          IsSetCoverMerge);
+    }
     for (auto &Path : FilesToAdd) {
       auto U = FileToVector(Path);
       auto NewPath = DirPlusFile(MainCorpusDir, Hash(U));
@@ -322,6 +340,7 @@ void FuzzWithFork(Random &Rand, const FuzzingOptions &Options,
   Env.ProcessStartTime = std::chrono::system_clock::now();
   Env.DataFlowBinary = Options.CollectDataFlow;
   Env.Group = Options.ForkCorpusGroups;
+  Env.MergeByFeatures = Options.ForkMergeByFeatures;
 
   std::vector<SizedFile> SeedFiles;
   for (auto &Dir : CorpusDirs)
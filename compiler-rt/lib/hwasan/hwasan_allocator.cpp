@@ -139,6 +139,7 @@ void HwasanAllocatorInit() {
   atomic_store_relaxed(&hwasan_allocator_tagging_enabled,
                        !flags()->disable_allocator_tagging);
   SetAllocatorMayReturnNull(common_flags()->allocator_may_return_null);
+  SetAllocatorMaxCachedChunks(common_flags()->allocator_max_cached_chunks);
   allocator.Init(common_flags()->allocator_release_to_os_interval_ms,
                  GetAliasRegionStart());
   for (uptr i = 0; i < sizeof(tail_magic); i++)
@@ -40,6 +40,7 @@ static uptr max_malloc_size;
 
 void InitializeAllocator() {
   SetAllocatorMayReturnNull(common_flags()->allocator_may_return_null);
+  SetAllocatorMaxCachedChunks(common_flags()->allocator_max_cached_chunks);
   allocator.InitLinkerInitialized(
       common_flags()->allocator_release_to_os_interval_ms);
   if (common_flags()->max_allocation_size_mb)
@@ -244,6 +244,23 @@ void ClearShadow(uptr addr, uptr size) {
   }
 }
 
+// Returns whether the context of an allocation of the given size should be
+// recorded. With sample_bytes set, the allocations are sampled by a per-thread
+// countdown of the allocated bytes, so that larger allocations are more likely
+// to be recorded.
+static bool ShouldRecordAllocation(uptr size) {
+  static THREADLOCAL uptr bytes_until_sample;
+  const int sample_bytes = flags()->sample_bytes;
+  if (sample_bytes <= 1)
+    return true;
+  if (size < bytes_until_sample) {
+    bytes_until_sample -= size;
+    return false;
+  }
+  bytes_until_sample = sample_bytes;
+  return true;
+}
+
 struct Allocator {
   static const uptr kMaxAllowedMallocSize = 1ULL << kMaxAllowedMallocBits;
 
@@ -312,7 +329,7 @@ struct Allocator {
           Allocator *A = (Allocator *)alloc;
           MemprofChunk *m =
               A->GetMemprofChunk((void *)chunk, user_requested_size);
-          if (!m)
+          if (!m || !m->alloc_context_id)
             return;
           uptr user_beg = ((uptr)m) + kChunkHeaderSize;
           u64 c = GetShadowCount(user_beg, user_requested_size);
@@ -406,12 +423,16 @@ struct Allocator {
 
     m->cpu_id = GetCpuId();
     m->timestamp_ms = GetTimestamp();
-    m->alloc_context_id = StackDepotPut(*stack);
-
-    uptr size_rounded_down_to_granularity =
-        RoundDownTo(size, SHADOW_GRANULARITY);
-    if (size_rounded_down_to_granularity)
-      ClearShadow(user_beg, size_rounded_down_to_granularity);
+    // A zero context id marks the allocations that are not part of the
+    // profile; their shadow counters are left alone as they are never read.
+    m->alloc_context_id = 0;
+    if (ShouldRecordAllocation(size)) {
+      m->alloc_context_id = StackDepotPut(*stack);
+      uptr size_rounded_down_to_granularity =
+          RoundDownTo(size, SHADOW_GRANULARITY);
+      if (size_rounded_down_to_granularity)
+        ClearShadow(user_beg, size_rounded_down_to_granularity);
+    }
 
     MemprofStats &thread_stats = GetCurrentThreadStats();
     thread_stats.mallocs++;
@@ -445,7 +466,7 @@ struct Allocator {
 
     u64 user_requested_size =
         atomic_exchange(&m->user_requested_size, 0, memory_order_acquire);
-    if (memprof_inited && memprof_init_done &&
+    if (m->alloc_context_id && memprof_inited && memprof_init_done &&
         atomic_load_relaxed(&constructed) &&
         !atomic_load_relaxed(&destructing)) {
       u64 c = GetShadowCount(p, user_requested_size);
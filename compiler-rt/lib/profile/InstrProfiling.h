@@ -170,6 +170,31 @@ int __llvm_orderfile_write_file(void);
  */
 int __llvm_profile_dump(void);
 
+/*!
+ * \brief Request a profile dump whenever the signal \c Signum is delivered.
+ *
+ * The signal handler only records the request, since writing the profile is
+ * not async-signal-safe: the dump happens at the next call to
+ * \a __llvm_profile_dump_if_requested(), which long running programs are
+ * expected to call periodically, e.g. from their main loop. Returns 0 on
+ * success and -1 on failure.
+ */
+int __llvm_profile_set_dump_signal(int Signum);
+
+/*!
+ * \brief Write the profile if a dump was requested through the signal set
+ * with \a __llvm_profile_set_dump_signal(). Return 0 if there was nothing to
+ * do or the profile was written, and the error of
+ * \a __llvm_profile_write_file() otherwise.
+ *
+ * Unlike \a __llvm_profile_dump(), this allows the profile to be dumped any
+ * number of times: with online profile merging (\c %m), the counters are
+ * reset after every dump so that each execution is only merged once, and
+ * without merging every dump overwrites the profile with the counts so far.
+ * This is a no-op in continuous mode, where the profile is always up to date.
+ */
+int __llvm_profile_dump_if_requested(void);
+
 int __llvm_orderfile_dump(void);
 
 /*!
@@ -10,6 +10,7 @@
 
 #include <assert.h>
 #include <errno.h>
+#include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -1071,6 +1072,50 @@ int __llvm_profile_dump(void) {
   return rc;
 }
 
+/* Set by the handler of the signal given to __llvm_profile_set_dump_signal. */
+static volatile sig_atomic_t DumpRequested = 0;
+
+static void requestDump(int Signum) {
+  (void)Signum;
+  DumpRequested = 1;
+}
+
+COMPILER_RT_VISIBILITY
+int __llvm_profile_set_dump_signal(int Signum) {
+#if defined(_WIN32)
+  if (signal(Signum, requestDump) == SIG_ERR) {
+#else
+  struct sigaction SA;
+  memset(&SA, 0, sizeof(SA));
+  SA.sa_handler = requestDump;
+  SA.sa_flags = SA_RESTART;
+  sigemptyset(&SA.sa_mask);
+  if (sigaction(Signum, &SA, NULL) != 0) {
+#endif
+    PROF_ERR("Unable to install the profile dump handler for signal %d: %s\n",
+             Signum, strerror(errno));
+    return -1;
+  }
+  return 0;
+}
+
+COMPILER_RT_VISIBILITY
+int __llvm_profile_dump_if_requested(void) {
+  int rc;
+  if (!DumpRequested)
+    return 0;
+  DumpRequested = 0;
+  if (__llvm_profile_is_continuous_mode_enabled())
+    return 0;
+
+  rc = __llvm_profile_write_file();
+  /* The written counts were merged into the in-memory counters, clear them so
+   * that the next dump, or the one at exit, doesn't merge them again. */
+  if (!rc && doMerging())
+    __llvm_profile_reset_counters();
+  return rc;
+}
+
 /* Order file data will be saved in a file with suffx .order. */
 static const char *OrderFileSuffix = ".order";
 
@@ -173,6 +173,7 @@ void SetLowLevelAllocateCallback(LowLevelAllocateCallback callback) {
 
 static atomic_uint8_t allocator_out_of_memory = {0};
 static atomic_uint8_t allocator_may_return_null = {0};
+static atomic_uint32_t allocator_max_cached_chunks = {0};
 
 bool IsAllocatorOutOfMemory() {
   return atomic_load_relaxed(&allocator_out_of_memory);
@@ -191,6 +192,15 @@ void SetAllocatorMayReturnNull(bool may_return_null) {
                memory_order_relaxed);
 }
 
+u32 AllocatorMaxCachedChunks() {
+  return atomic_load(&allocator_max_cached_chunks, memory_order_relaxed);
+}
+
+void SetAllocatorMaxCachedChunks(u32 max_cached_chunks) {
+  atomic_store(&allocator_max_cached_chunks, max_cached_chunks,
+               memory_order_relaxed);
+}
+
 void PrintHintAllocatorCannotReturnNull() {
   Report("HINT: if you don't care about these errors you may set "
          "allocator_may_return_null=1\n");
@@ -36,6 +36,12 @@ extern const char *SecondaryAllocatorName;
 bool AllocatorMayReturnNull();
 void SetAllocatorMayReturnNull(bool may_return_null);
 
+// Limit on the number of chunks of one size class kept by a thread's
+// SizeClassAllocator64LocalCache, 0 meaning no limit beyond the size class
+// map's hint. It is read once per thread, when its cache is first used.
+u32 AllocatorMaxCachedChunks();
+void SetAllocatorMaxCachedChunks(u32 max_cached_chunks);
+
 // Returns true if allocator detected OOM condition. Can be used to avoid memory
 // hungry operations.
 bool IsAllocatorOutOfMemory();
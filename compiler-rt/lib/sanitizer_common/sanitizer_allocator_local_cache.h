@@ -87,10 +87,15 @@ struct SizeClassAllocator64LocalCache {
   void InitCache(PerClass *c) {
     if (LIKELY(c->max_count))
       return;
+    const u32 max_cached = AllocatorMaxCachedChunks();
     for (uptr i = 1; i < kNumClasses; i++) {
       PerClass *c = &per_class_[i];
       const uptr size = Allocator::ClassIdToSize(i);
       c->max_count = 2 * SizeClassMap::MaxCachedHint(size);
+      // Refill and DrainHalfMax move max_count / 2 chunks at a time, so keep
+      // at least 2.
+      if (max_cached)
+        c->max_count = Max<u32>(2, Min(c->max_count, max_cached));
       c->class_size = size;
     }
     DCHECK_NE(c->max_count, 0UL);
@@ -70,6 +70,9 @@ void StackDepotHandle::inc_use_count_unsafe() {
   atomic_fetch_add(&useCounts[id_], 1, memory_order_relaxed);
 }
 
+// Total number of bytes released by packing the blocks of stackStore.
+static atomic_uintptr_t packedBytes;
+
 uptr StackDepotNode::allocated() {
   return stackStore.Allocated() + useCounts.MemoryUsage();
 }
@@ -80,6 +83,7 @@ static void CompressStackStore() {
       Abs(common_flags()->compress_stack_depot)));
   if (!diff)
     return;
+  atomic_fetch_add(&packedBytes, diff, memory_order_relaxed);
   if (Verbosity() >= 1) {
     u64 finish = MonotonicNanoTime();
     uptr total_before = theDepot.GetStats().allocated + diff;
@@ -205,6 +209,10 @@ StackDepotNode::args_type StackDepotNode::load(u32 id) const {
 
 StackDepotStats StackDepotGetStats() { return theDepot.GetStats(); }
 
+uptr StackDepotGetPackedBytes() {
+  return atomic_load_relaxed(&packedBytes);
+}
+
 u32 StackDepotPut(StackTrace stack) { return theDepot.Put(stack); }
 
 StackDepotHandle StackDepotPut_WithHandle(StackTrace stack) {
@@ -34,6 +34,8 @@ struct StackDepotHandle {
 const int kStackDepotMaxUseCount = 1U << (SANITIZER_ANDROID ? 16 : 20);
 
 StackDepotStats StackDepotGetStats();
+// Returns the number of bytes released so far by compress_stack_depot.
+uptr StackDepotGetPackedBytes();
 u32 StackDepotPut(StackTrace stack);
 StackDepotHandle StackDepotPut_WithHandle(StackTrace stack);
 // Retrieves a stored stack trace by the id.
@@ -833,6 +833,88 @@ TEST(SanitizerCommon, SizeClassAllocator64CompactLocalCache) {
 TEST(SanitizerCommon, SizeClassAllocator64VeryCompactLocalCache) {
   TestSizeClassAllocatorLocalCache<Allocator64VeryCompact>();
 }
+
+TEST(SanitizerCommon, SizeClassAllocator64LimitedLocalCache) {
+  SetAllocatorMaxCachedChunks(4);
+  TestSizeClassAllocatorLocalCache<Allocator64>();
+  SetAllocatorMaxCachedChunks(0);
+}
+
+// Counts the chunks that a local cache moves from and to the allocator.
+struct CountingAllocator64 : Allocator64 {
+  typedef MemoryMapper<CountingAllocator64> MemoryMapperT;
+
+  void ReturnToAllocator(MemoryMapperT *memory_mapper, AllocatorStats *stat,
+                         uptr class_id, const CompactPtrT *chunks,
+                         uptr n_chunks) {
+    MemoryMapper<Allocator64> base_memory_mapper(*this);
+    Allocator64::ReturnToAllocator(&base_memory_mapper, stat, class_id, chunks,
+                                   n_chunks);
+    returned += n_chunks;
+  }
+
+  bool GetFromAllocator(AllocatorStats *stat, uptr class_id,
+                        CompactPtrT *chunks, uptr n_chunks) {
+    if (!Allocator64::GetFromAllocator(stat, class_id, chunks, n_chunks))
+      return false;
+    fetched += n_chunks;
+    return true;
+  }
+
+  uptr fetched = 0;
+  uptr returned = 0;
+};
+
+static void TestLocalCacheLimit(u32 max_cached_chunks) {
+  typedef SizeClassAllocator64LocalCache<CountingAllocator64> AllocatorCache;
+  const uptr class_id = 1;
+  const uptr hint = 2 * Allocator64::SizeClassMapT::MaxCachedHint(
+                            Allocator64::ClassIdToSize(class_id));
+  const uptr max_count =
+      max_cached_chunks ? Max<uptr>(2, Min<uptr>(hint, max_cached_chunks))
+                        : hint;
+
+  CountingAllocator64 *a = new CountingAllocator64();
+  a->Init(kReleaseToOSIntervalNever);
+  AllocatorCache *cache = new AllocatorCache();
+  memset(cache, 0, sizeof(*cache));
+  SetAllocatorMaxCachedChunks(max_cached_chunks);
+  cache->Init(0);
+
+  std::vector<void *> allocated;
+  allocated.push_back(cache->Allocate(a, class_id));
+  // A refill brings half of the limit.
+  EXPECT_EQ(max_count / 2, a->fetched);
+  for (uptr i = 1; i < max_count + 1; i++)
+    allocated.push_back(cache->Allocate(a, class_id));
+  cache->Drain(a);
+  a->fetched = a->returned = 0;
+
+  // The cache keeps up to the limit...
+  for (uptr i = 0; i < max_count; i++)
+    cache->Deallocate(a, class_id, allocated[i]);
+  EXPECT_EQ(0U, a->returned);
+  // ...and returns half of it to the allocator when it goes beyond.
+  cache->Deallocate(a, class_id, allocated[max_count]);
+  EXPECT_EQ(max_count / 2, a->returned);
+  EXPECT_EQ(0U, a->fetched);
+
+  cache->Drain(a);
+  EXPECT_EQ(max_count + 1, a->returned);
+  SetAllocatorMaxCachedChunks(0);
+  delete cache;
+  a->TestOnlyUnmap();
+  delete a;
+}
+
+TEST(SanitizerCommon, SizeClassAllocator64LocalCacheLimit) {
+  // No limit, a limit below the size class map's hint, one so low that it is
+  // raised to the minimum of 2 chunks, and one above the hint.
+  TestLocalCacheLimit(0);
+  TestLocalCacheLimit(4);
+  TestLocalCacheLimit(1);
+  TestLocalCacheLimit(1 << 20);
+}
 #endif
 #endif
 
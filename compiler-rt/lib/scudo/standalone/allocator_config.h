@@ -54,6 +54,10 @@ namespace scudo {
 //   // Call map for user memory with at least this size. Only used with
 //   // primary64.
 //   static const uptr PrimaryMapSizeIncrement = 1UL << 18;
+//   // Indicates that the regions should be backed by transparent huge pages.
+//   // Periodic releases then only return whole huge pages to the OS, smaller
+//   // free ranges are left to forced releases. Only used with primary64.
+//   static const bool PrimaryEnableHugePages = false;
 //   // Defines the minimal & maximal release interval that can be set.
 //   static const s32 PrimaryMinReleaseToOsIntervalMs = INT32_MIN;
 //   static const s32 PrimaryMaxReleaseToOsIntervalMs = INT32_MAX;
@@ -78,6 +82,7 @@ struct DefaultConfig {
   static const uptr PrimaryCompactPtrScale = 0;
   static const bool PrimaryEnableRandomOffset = true;
   static const uptr PrimaryMapSizeIncrement = 1UL << 18;
+  static const bool PrimaryEnableHugePages = false;
 #else
   typedef SizeClassAllocator32<DefaultConfig> Primary;
   static const uptr PrimaryRegionSizeLog = 19U;
@@ -109,6 +114,7 @@ struct AndroidConfig {
   static const uptr PrimaryGroupSizeLog = 20U;
   static const bool PrimaryEnableRandomOffset = true;
   static const uptr PrimaryMapSizeIncrement = 1UL << 18;
+  static const bool PrimaryEnableHugePages = false;
 #else
   typedef SizeClassAllocator32<AndroidConfig> Primary;
   static const uptr PrimaryRegionSizeLog = 18U;
@@ -142,6 +148,7 @@ struct AndroidSvelteConfig {
   static const uptr PrimaryGroupSizeLog = 18U;
   static const bool PrimaryEnableRandomOffset = true;
   static const uptr PrimaryMapSizeIncrement = 1UL << 18;
+  static const bool PrimaryEnableHugePages = false;
 #else
   typedef SizeClassAllocator32<AndroidSvelteConfig> Primary;
   static const uptr PrimaryRegionSizeLog = 16U;
@@ -174,6 +181,7 @@ struct FuchsiaConfig {
   typedef u32 PrimaryCompactPtrT;
   static const bool PrimaryEnableRandomOffset = true;
   static const uptr PrimaryMapSizeIncrement = 1UL << 18;
+  static const bool PrimaryEnableHugePages = false;
   static const uptr PrimaryCompactPtrScale = SCUDO_MIN_ALIGNMENT_LOG;
   static const s32 PrimaryMinReleaseToOsIntervalMs = INT32_MIN;
   static const s32 PrimaryMaxReleaseToOsIntervalMs = INT32_MAX;
@@ -195,6 +203,7 @@ struct TrustyConfig {
   static const bool PrimaryEnableRandomOffset = false;
   // Trusty is extremely memory-constrained so minimally round up map calls.
   static const uptr PrimaryMapSizeIncrement = 1UL << 4;
+  static const bool PrimaryEnableHugePages = false;
   static const uptr PrimaryCompactPtrScale = SCUDO_MIN_ALIGNMENT_LOG;
   static const s32 PrimaryMinReleaseToOsIntervalMs = INT32_MIN;
   static const s32 PrimaryMaxReleaseToOsIntervalMs = INT32_MAX;
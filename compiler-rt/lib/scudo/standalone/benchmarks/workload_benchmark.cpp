@@ -0,0 +1,301 @@
+//===-- workload_benchmark.cpp ----------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Benchmarks modeling common allocation patterns, to compare the allocator
+// configs against each other. Besides the throughput, every benchmark reports
+// the latency percentiles of a sample of the operations (p50_ns, p99_ns,
+// p999_ns) and the RSS of the process at the end of the run (rss_kb).
+//
+//===----------------------------------------------------------------------===//
+
+#include "allocator_config.h"
+#include "combined.h"
+#include "common.h"
+
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <stdio.h>
+
+void *CurrentAllocator;
+template <typename Config> void PostInitCallback() {
+  reinterpret_cast<scudo::Allocator<Config> *>(CurrentAllocator)->initGwpAsan();
+}
+
+template <typename Config> struct AllocatorDeleter {
+  void operator()(scudo::Allocator<Config, PostInitCallback<Config>> *A) {
+    A->unmapTestOnly();
+    delete A;
+  }
+};
+
+template <typename Config>
+using AllocatorPtr =
+    std::unique_ptr<scudo::Allocator<Config, PostInitCallback<Config>>,
+                    AllocatorDeleter<Config>>;
+
+template <typename Config> static AllocatorPtr<Config> createAllocator() {
+  AllocatorPtr<Config> Allocator(
+      new scudo::Allocator<Config, PostInitCallback<Config>>);
+  CurrentAllocator = Allocator.get();
+  return Allocator;
+}
+
+// Returns the resident set size of the process in KiB, or 0 if unknown.
+static double getRssKb() {
+#if SCUDO_LINUX
+  FILE *F = fopen("/proc/self/statm", "r");
+  if (!F)
+    return 0;
+  unsigned long Size = 0, Resident = 0;
+  const int N = fscanf(F, "%lu %lu", &Size, &Resident);
+  fclose(F);
+  if (N != 2)
+    return 0;
+  return static_cast<double>(Resident * scudo::getPageSizeCached() / 1024);
+#else
+  return 0;
+#endif
+}
+
+// Records the duration of one in SampleRate operations, and reports the
+// percentiles of the sampled durations as counters.
+class LatencySampler {
+public:
+  explicit LatencySampler(size_t SampleRate = 16) : SampleRate(SampleRate) {}
+
+  template <typename Fn> void run(Fn F) {
+    if (++Count % SampleRate) {
+      F();
+      return;
+    }
+    const auto Start = std::chrono::steady_clock::now();
+    F();
+    const auto End = std::chrono::steady_clock::now();
+    Samples.push_back(static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(End - Start)
+            .count()));
+  }
+
+  void report(benchmark::State &State) {
+    State.counters["p50_ns"] = percentile(0.5);
+    State.counters["p99_ns"] = percentile(0.99);
+    State.counters["p999_ns"] = percentile(0.999);
+  }
+
+private:
+  double percentile(double P) {
+    if (Samples.empty())
+      return 0;
+    const size_t I = std::min(Samples.size() - 1,
+                              static_cast<size_t>(P * Samples.size()));
+    std::nth_element(Samples.begin(), Samples.begin() + I, Samples.end());
+    return Samples[I];
+  }
+
+  const size_t SampleRate;
+  size_t Count = 0;
+  std::vector<double> Samples;
+};
+
+// Chunks are allocated by the benchmark thread and freed by a consumer thread,
+// in batches, as in a producer/consumer pipeline. This exercises the paths
+// returning blocks allocated through another thread's cache.
+template <typename Config>
+static void BM_producer_consumer(benchmark::State &State) {
+  auto Allocator = createAllocator<Config>();
+  const size_t NBytes = State.range(0);
+  constexpr size_t BatchSize = 256;
+  constexpr size_t MaxPendingBatches = 64;
+
+  std::mutex Mutex;
+  std::condition_variable CV;
+  std::deque<std::vector<void *>> Pending;
+  bool Done = false;
+  std::thread Consumer([&] {
+    for (;;) {
+      std::vector<void *> Batch;
+      {
+        std::unique_lock<std::mutex> Lock(Mutex);
+        CV.wait(Lock, [&] { return Done || !Pending.empty(); });
+        if (Pending.empty())
+          return;
+        Batch = std::move(Pending.front());
+        Pending.pop_front();
+      }
+      CV.notify_all();
+      for (void *Ptr : Batch)
+        Allocator->deallocate(Ptr, scudo::Chunk::Origin::Malloc);
+    }
+  });
+
+  LatencySampler Sampler;
+  for (auto _ : State) {
+    std::vector<void *> Batch(BatchSize);
+    for (void *&Ptr : Batch) {
+      Sampler.run([&] {
+        Ptr = Allocator->allocate(NBytes, scudo::Chunk::Origin::Malloc);
+      });
+      benchmark::DoNotOptimize(Ptr);
+    }
+    {
+      std::unique_lock<std::mutex> Lock(Mutex);
+      CV.wait(Lock, [&] { return Pending.size() < MaxPendingBatches; });
+      Pending.push_back(std::move(Batch));
+    }
+    CV.notify_all();
+  }
+  {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    Done = true;
+  }
+  CV.notify_all();
+  Consumer.join();
+
+  State.SetItemsProcessed(State.iterations() * BatchSize);
+  State.counters["rss_kb"] = getRssKb();
+  Sampler.report(State);
+}
+
+// A working set of chunks of random sizes spread over all the size classes of
+// the primary, in which a random chunk is replaced at every iteration.
+template <typename Config>
+static void BM_size_class_churn(benchmark::State &State) {
+  auto Allocator = createAllocator<Config>();
+  const size_t WorkingSetSize = State.range(0);
+  const size_t MaxSize = Config::Primary::SizeClassMap::MaxSize;
+  std::mt19937 Rng(0);
+  std::uniform_int_distribution<size_t> SizeLogDist(
+      3, scudo::getMostSignificantSetBitIndex(MaxSize) - 1);
+  std::uniform_int_distribution<size_t> SlotDist(0, WorkingSetSize - 1);
+  auto RandomSize = [&] {
+    // Log-uniform sizes, so that the small size classes get more traffic.
+    const size_t SizeLog = SizeLogDist(Rng);
+    return (size_t(1) << SizeLog) +
+           std::uniform_int_distribution<size_t>(0, (1U << SizeLog) - 1)(Rng);
+  };
+
+  std::vector<void *> WorkingSet(WorkingSetSize);
+  for (void *&Ptr : WorkingSet)
+    Ptr = Allocator->allocate(RandomSize(), scudo::Chunk::Origin::Malloc);
+
+  LatencySampler Sampler;
+  for (auto _ : State) {
+    void *&Ptr = WorkingSet[SlotDist(Rng)];
+    const size_t Size = RandomSize();
+    Sampler.run([&] {
+      Allocator->deallocate(Ptr, scudo::Chunk::Origin::Malloc);
+      Ptr = Allocator->allocate(Size, scudo::Chunk::Origin::Malloc);
+    });
+    benchmark::DoNotOptimize(Ptr);
+  }
+
+  State.SetItemsProcessed(State.iterations());
+  State.counters["rss_kb"] = getRssKb();
+  Sampler.report(State);
+  for (void *Ptr : WorkingSet)
+    Allocator->deallocate(Ptr, scudo::Chunk::Origin::Malloc);
+}
+
+// Allocations served by the secondary allocator, with their pages touched
+// since the cost of the secondary is dominated by the mappings.
+template <typename Config>
+static void BM_secondary(benchmark::State &State) {
+  auto Allocator = createAllocator<Config>();
+  const size_t NBytes = State.range(0);
+  const size_t PageSize = scudo::getPageSizeCached();
+
+  // These are slow enough to time all of them.
+  LatencySampler Sampler(/*SampleRate=*/1);
+  for (auto _ : State) {
+    Sampler.run([&] {
+      void *Ptr = Allocator->allocate(NBytes, scudo::Chunk::Origin::Malloc);
+      auto *Data = reinterpret_cast<uint8_t *>(Ptr);
+      for (size_t I = 0; I < NBytes; I += PageSize)
+        Data[I] = 1;
+      benchmark::DoNotOptimize(Ptr);
+      Allocator->deallocate(Ptr, scudo::Chunk::Origin::Malloc);
+    });
+  }
+
+  State.SetBytesProcessed(uint64_t(State.iterations()) * uint64_t(NBytes));
+  State.counters["rss_kb"] = getRssKb();
+  Sampler.report(State);
+}
+
+// Models a long running program whose live heap shifts over time: in every
+// phase, a random half of the small chunks is freed and replaced by chunks
+// twice as large. The RSS after the last phase (rss_kb) shows how well the
+// freed memory is reused, and the RSS once everything was freed and released
+// to the OS (released_rss_kb) how much of it can be returned.
+template <typename Config>
+static void BM_fragmentation(benchmark::State &State) {
+  auto Allocator = createAllocator<Config>();
+  const size_t NumChunks = State.range(0);
+  constexpr size_t NumPhases = 8;
+  std::mt19937 Rng(0);
+
+  std::vector<std::pair<void *, size_t>> Chunks;
+  LatencySampler Sampler;
+  for (auto _ : State) {
+    Chunks.clear();
+    size_t Size = 16;
+    for (size_t I = 0; I < NumChunks; I++)
+      Chunks.emplace_back(
+          Allocator->allocate(Size, scudo::Chunk::Origin::Malloc), Size);
+    for (size_t Phase = 0; Phase < NumPhases; Phase++) {
+      std::shuffle(Chunks.begin(), Chunks.end(), Rng);
+      Size = std::min<size_t>(Size * 2, Config::Primary::SizeClassMap::MaxSize);
+      for (size_t I = 0; I < NumChunks / 2; I++) {
+        Sampler.run([&] {
+          Allocator->deallocate(Chunks[I].first, scudo::Chunk::Origin::Malloc);
+          Chunks[I] = {Allocator->allocate(Size, scudo::Chunk::Origin::Malloc),
+                       Size};
+        });
+      }
+    }
+    State.PauseTiming();
+    State.counters["rss_kb"] = getRssKb();
+    for (auto &Chunk : Chunks)
+      Allocator->deallocate(Chunk.first, scudo::Chunk::Origin::Malloc);
+    Allocator->releaseToOS();
+    State.counters["released_rss_kb"] = getRssKb();
+    State.ResumeTiming();
+  }
+
+  State.SetItemsProcessed(State.iterations() * NumChunks * NumPhases / 2);
+  Sampler.report(State);
+}
+
+// FIXME: Add DefaultConfig here once we can tear down the exclusive TSD
+// cleanly.
+#define SCUDO_WORKLOAD_BENCHMARKS(Config)                                      \
+  BENCHMARK_TEMPLATE(BM_producer_consumer, Config)                             \
+      ->Range(16, 4096)                                                        \
+      ->UseRealTime();                                                         \
+  BENCHMARK_TEMPLATE(BM_size_class_churn, Config)->Range(1 << 10, 1 << 16);    \
+  BENCHMARK_TEMPLATE(BM_secondary, Config)->Range(1 << 18, 1 << 24);           \
+  BENCHMARK_TEMPLATE(BM_fragmentation, Config)->Range(1 << 12, 1 << 15);
+
+SCUDO_WORKLOAD_BENCHMARKS(scudo::AndroidConfig)
+SCUDO_WORKLOAD_BENCHMARKS(scudo::AndroidSvelteConfig)
+#if SCUDO_CAN_USE_PRIMARY64
+SCUDO_WORKLOAD_BENCHMARKS(scudo::FuchsiaConfig)
+#endif
+
+BENCHMARK_MAIN();
@@ -150,11 +150,14 @@ bool getRandom(void *Buffer, uptr Length, bool Blocking = false);
 #define MAP_RESIZABLE (1U << 2)
 #define MAP_MEMTAG (1U << 3)
 #define MAP_PRECOMMIT (1U << 4)
+#define MAP_HUGEPAGE (1U << 5)
 
 // Our platform memory mapping use is restricted to 3 scenarios:
 // - reserve memory at a random address (MAP_NOACCESS);
 // - commit memory in a previously reserved space;
 // - commit memory at a random address.
+// MAP_HUGEPAGE asks for the committed memory to be backed by transparent huge
+// pages where the platform supports it, and is ignored otherwise.
 // As such, only a subset of parameters combinations is valid, which is checked
 // by the function implementation. The Data parameter allows to pass opaque
 // platform specific data to the function.
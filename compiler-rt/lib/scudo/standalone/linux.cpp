@@ -67,6 +67,11 @@ void *map(void *Addr, uptr Size, UNUSED const char *Name, uptr Flags,
       dieOnMapUnmapError(errno == ENOMEM ? Size : 0);
     return nullptr;
   }
+#if defined(MADV_HUGEPAGE)
+  // This is only a hint, the memory is usable either way.
+  if (Flags & MAP_HUGEPAGE)
+    madvise(P, Size, MADV_HUGEPAGE);
+#endif
 #if SCUDO_ANDROID
   if (Name)
     prctl(ANDROID_PR_SET_VMA, ANDROID_PR_SET_VMA_ANON_NAME, P, Size, Name);
@@ -197,17 +197,23 @@ public:
     uptr TotalMapped = 0;
     uptr PoppedBlocks = 0;
     uptr PushedBlocks = 0;
+    uptr DeferredBytes = 0;
     for (uptr I = 0; I < NumClasses; I++) {
       RegionInfo *Region = getRegionInfo(I);
       if (Region->MappedUser)
         TotalMapped += Region->MappedUser;
       PoppedBlocks += Region->Stats.PoppedBlocks;
       PushedBlocks += Region->Stats.PushedBlocks;
+      DeferredBytes += Region->ReleaseInfo.LastDeferredBytes;
     }
     Str->append("Stats: SizeClassAllocator64: %zuM mapped (%uM rss) in %zu "
                 "allocations; remains %zu\n",
                 TotalMapped >> 20, 0U, PoppedBlocks,
                 PoppedBlocks - PushedBlocks);
+    if (Config::PrimaryEnableHugePages)
+      Str->append("Stats: SizeClassAllocator64: huge pages enabled, %zuK "
+                  "deferred to the next forced release\n",
+                  DeferredBytes >> 10);
 
     for (uptr I = 0; I < NumClasses; I++)
       getStats(Str, I, 0);
@@ -313,6 +319,9 @@ private:
   static const uptr PrimarySize = RegionSize * NumClasses;
 
   static const uptr MapSizeIncrement = Config::PrimaryMapSizeIncrement;
+  // Granularity of the periodic releases when the regions are backed by huge
+  // pages.
+  static const uptr HugePageSize = 1UL << 21;
   // Fill at most this number of batches from the newly map'd memory.
   static const u32 MaxNumBatches = SCUDO_ANDROID ? 4U : 8U;
 
@@ -325,6 +334,7 @@ private:
     uptr PushedBlocksAtLastRelease;
     uptr RangesReleased;
     uptr LastReleasedBytes;
+    uptr LastDeferredBytes;
     u64 LastReleaseAtNs;
   };
 
@@ -591,7 +601,8 @@ private:
               reinterpret_cast<void *>(RegionBeg + MappedUser), MapSize,
               "scudo:primary",
               MAP_ALLOWNOMEM | MAP_RESIZABLE |
-                  (useMemoryTagging<Config>(Options.load()) ? MAP_MEMTAG : 0),
+                  (useMemoryTagging<Config>(Options.load()) ? MAP_MEMTAG : 0) |
+                  (Config::PrimaryEnableHugePages ? MAP_HUGEPAGE : 0),
               &Region->Data))) {
         return false;
       }
@@ -642,25 +653,34 @@ private:
     const uptr TotalChunks = Region->AllocatedUser / getSizeByClassId(ClassId);
     Str->append("%s %02zu (%6zu): mapped: %6zuK popped: %7zu pushed: %7zu "
                 "inuse: %6zu total: %6zu rss: %6zuK releases: %6zu last "
-                "released: %6zuK region: 0x%zx (0x%zx)\n",
+                "released: %6zuK region: 0x%zx (0x%zx)",
                 Region->Exhausted ? "F" : " ", ClassId,
                 getSizeByClassId(ClassId), Region->MappedUser >> 10,
                 Region->Stats.PoppedBlocks, Region->Stats.PushedBlocks, InUse,
                 TotalChunks, Rss >> 10, Region->ReleaseInfo.RangesReleased,
                 Region->ReleaseInfo.LastReleasedBytes >> 10, Region->RegionBeg,
                 getRegionBaseByClassId(ClassId));
+    if (Config::PrimaryEnableHugePages)
+      Str->append(" deferred: %6zuK",
+                  Region->ReleaseInfo.LastDeferredBytes >> 10);
+    Str->append("\n");
   }
 
   NOINLINE uptr releaseToOSMaybe(RegionInfo *Region, uptr ClassId,
                                  bool Force = false) {
     const uptr BlockSize = getSizeByClassId(ClassId);
     const uptr PageSize = getPageSizeCached();
+    // With huge pages, periodic releases only return whole huge pages to the
+    // OS, so as not to split the others. Smaller free ranges are deferred to
+    // the forced releases.
+    const uptr ReleaseGranularity =
+        (Config::PrimaryEnableHugePages && !Force) ? HugePageSize : 0;
 
     DCHECK_GE(Region->Stats.PoppedBlocks, Region->Stats.PushedBlocks);
     const uptr BytesInFreeList =
         Region->AllocatedUser -
         (Region->Stats.PoppedBlocks - Region->Stats.PushedBlocks) * BlockSize;
-    if (BytesInFreeList < PageSize)
+    if (BytesInFreeList < Max(PageSize, ReleaseGranularity))
       return 0; // No chance to release anything.
     const uptr BytesPushed = (Region->Stats.PushedBlocks -
                               Region->ReleaseInfo.PushedBlocksAtLastRelease) *
@@ -690,7 +710,8 @@ private:
 
     const uptr GroupSize = (1U << GroupSizeLog);
     const uptr AllocatedUserEnd = Region->AllocatedUser + Region->RegionBeg;
-    ReleaseRecorder Recorder(Region->RegionBeg, &Region->Data);
+    ReleaseRecorder Recorder(Region->RegionBeg, &Region->Data,
+                             ReleaseGranularity);
     PageReleaseContext Context(BlockSize, Region->AllocatedUser,
                                /*NumberOfRegions=*/1U);
 
@@ -774,6 +795,7 @@ private:
       Region->ReleaseInfo.RangesReleased += Recorder.getReleasedRangesCount();
       Region->ReleaseInfo.LastReleasedBytes = Recorder.getReleasedBytes();
     }
+    Region->ReleaseInfo.LastDeferredBytes = Recorder.getDeferredBytes();
     Region->ReleaseInfo.LastReleaseAtNs = getMonotonicTime();
     return Recorder.getReleasedBytes();
   }
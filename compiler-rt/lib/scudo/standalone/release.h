@@ -17,17 +17,34 @@ namespace scudo {
 
 class ReleaseRecorder {
 public:
-  ReleaseRecorder(uptr Base, MapPlatformData *Data = nullptr)
-      : Base(Base), Data(Data) {}
+  // If Granularity is non-zero, only the parts of the free ranges made of whole
+  // Granularity aligned blocks are released, e.g. to avoid splitting huge
+  // pages. The remainder is accounted for as deferred.
+  ReleaseRecorder(uptr Base, MapPlatformData *Data = nullptr,
+                  uptr Granularity = 0)
+      : Base(Base), Data(Data), Granularity(Granularity) {}
 
   uptr getReleasedRangesCount() const { return ReleasedRangesCount; }
 
   uptr getReleasedBytes() const { return ReleasedBytes; }
 
+  uptr getDeferredBytes() const { return DeferredBytes; }
+
   uptr getBase() const { return Base; }
 
   // Releases [From, To) range of pages back to OS.
   void releasePageRangeToOS(uptr From, uptr To) {
+    if (Granularity) {
+      const uptr AlignedFrom = roundUpTo(Base + From, Granularity) - Base;
+      const uptr AlignedTo = roundDownTo(Base + To, Granularity) - Base;
+      if (AlignedFrom >= AlignedTo) {
+        DeferredBytes += To - From;
+        return;
+      }
+      DeferredBytes += (AlignedFrom - From) + (To - AlignedTo);
+      From = AlignedFrom;
+      To = AlignedTo;
+    }
     const uptr Size = To - From;
     releasePagesToOS(Base, From, Size, Data);
     ReleasedRangesCount++;
@@ -37,8 +54,10 @@ public:
 private:
   uptr ReleasedRangesCount = 0;
   uptr ReleasedBytes = 0;
+  uptr DeferredBytes = 0;
   uptr Base = 0;
   MapPlatformData *Data = nullptr;
+  uptr Granularity = 0;
 };
 
 // A Region page map is used to record the usage of pages in the regions. It
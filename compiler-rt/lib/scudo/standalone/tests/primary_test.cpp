@@ -35,6 +35,7 @@ struct TestConfig1 {
   static const scudo::uptr PrimaryCompactPtrScale = 0;
   static const bool PrimaryEnableRandomOffset = true;
   static const scudo::uptr PrimaryMapSizeIncrement = 1UL << 18;
+  static const bool PrimaryEnableHugePages = false;
 };
 
 struct TestConfig2 {
@@ -52,6 +53,7 @@ struct TestConfig2 {
   static const scudo::uptr PrimaryCompactPtrScale = 0;
   static const bool PrimaryEnableRandomOffset = true;
   static const scudo::uptr PrimaryMapSizeIncrement = 1UL << 18;
+  static const bool PrimaryEnableHugePages = false;
 };
 
 struct TestConfig3 {
@@ -69,6 +71,7 @@ struct TestConfig3 {
   static const scudo::uptr PrimaryCompactPtrScale = 0;
   static const bool PrimaryEnableRandomOffset = true;
   static const scudo::uptr PrimaryMapSizeIncrement = 1UL << 18;
+  static const bool PrimaryEnableHugePages = false;
 };
 
 struct TestConfig4 {
@@ -86,6 +89,12 @@ struct TestConfig4 {
   typedef scudo::u32 PrimaryCompactPtrT;
   static const bool PrimaryEnableRandomOffset = true;
   static const scudo::uptr PrimaryMapSizeIncrement = 1UL << 18;
+  static const bool PrimaryEnableHugePages = false;
+};
+
+// Same as TestConfig2, with huge page backed regions.
+struct TestConfig5 : public TestConfig2 {
+  static const bool PrimaryEnableHugePages = true;
 };
 
 template <typename BaseConfig, typename SizeClassMapT>
@@ -124,7 +133,8 @@ template <class BaseConfig> struct ScudoPrimaryTest : public Test {};
   SCUDO_TYPED_TEST_TYPE(FIXTURE, NAME, TestConfig1)                            \
   SCUDO_TYPED_TEST_TYPE(FIXTURE, NAME, TestConfig2)                            \
   SCUDO_TYPED_TEST_TYPE(FIXTURE, NAME, TestConfig3)                            \
-  SCUDO_TYPED_TEST_TYPE(FIXTURE, NAME, TestConfig4)
+  SCUDO_TYPED_TEST_TYPE(FIXTURE, NAME, TestConfig4)                            \
+  SCUDO_TYPED_TEST_TYPE(FIXTURE, NAME, TestConfig5)
 #endif
 
 #define SCUDO_TYPED_TEST_TYPE(FIXTURE, NAME, TYPE)                             \
@@ -177,6 +187,7 @@ struct SmallRegionsConfig {
   static const scudo::uptr PrimaryCompactPtrScale = 0;
   static const bool PrimaryEnableRandomOffset = true;
   static const scudo::uptr PrimaryMapSizeIncrement = 1UL << 18;
+  static const bool PrimaryEnableHugePages = false;
   static const scudo::uptr PrimaryGroupSizeLog = 20U;
 };
 
@@ -115,6 +115,34 @@ TEST(ScudoReleaseTest, FreePagesRangeTracker) {
   }
 }
 
+TEST(ScudoReleaseTest, ReleaseRecorderGranularity) {
+  const scudo::uptr Granularity = 1UL << 21;
+  const scudo::uptr Size = 4 * Granularity;
+  scudo::MapPlatformData Data = {};
+  char *P = reinterpret_cast<char *>(
+      scudo::map(nullptr, Size, "test:release", 0, &Data));
+  ASSERT_NE(P, nullptr);
+  const scudo::uptr Base = reinterpret_cast<scudo::uptr>(P);
+  const scudo::uptr PageSize = scudo::getPageSizeCached();
+  // The first granule boundary within the mapping, as an offset.
+  const scudo::uptr First = scudo::roundUpTo(Base, Granularity) - Base;
+
+  scudo::ReleaseRecorder Recorder(Base, &Data, Granularity);
+  // A range that doesn't contain a whole granule is only deferred.
+  Recorder.releasePageRangeToOS(First, First + Granularity - PageSize);
+  EXPECT_EQ(Recorder.getReleasedRangesCount(), 0U);
+  EXPECT_EQ(Recorder.getReleasedBytes(), 0U);
+  EXPECT_EQ(Recorder.getDeferredBytes(), Granularity - PageSize);
+  // Only the whole granule of this one is released.
+  Recorder.releasePageRangeToOS(First + Granularity - PageSize,
+                                First + 2 * Granularity + PageSize);
+  EXPECT_EQ(Recorder.getReleasedRangesCount(), 1U);
+  EXPECT_EQ(Recorder.getReleasedBytes(), Granularity);
+  EXPECT_EQ(Recorder.getDeferredBytes(), Granularity + PageSize);
+
+  scudo::unmap(P, Size, 0, &Data);
+}
+
 class ReleasedPagesRecorder {
 public:
   std::set<scudo::uptr> ReportedPages;
@@ -402,6 +402,32 @@ Context::Context()
 
 TidSlot::TidSlot() : mtx(MutexTypeSlot) {}
 
+#if !SANITIZER_GO
+static uptr *ShadowStackAlloc() {
+  {
+    Lock lock(&ctx->slot_mtx);
+    if (ctx->shadow_stack_cache_size)
+      return ctx->shadow_stack_cache[--ctx->shadow_stack_cache_size];
+  }
+  uptr *shadow_stack = static_cast<uptr *>(
+      MmapNoReserveOrDie(kShadowStackSize * sizeof(uptr), "shadow stack"));
+  SetShadowRegionHugePageMode(reinterpret_cast<uptr>(shadow_stack),
+                              kShadowStackSize * sizeof(uptr));
+  return shadow_stack;
+}
+
+void ShadowStackFree(uptr *shadow_stack) {
+  {
+    Lock lock(&ctx->slot_mtx);
+    if (ctx->shadow_stack_cache_size < Context::kShadowStackCacheSize) {
+      ctx->shadow_stack_cache[ctx->shadow_stack_cache_size++] = shadow_stack;
+      return;
+    }
+  }
+  UnmapOrDie(shadow_stack, kShadowStackSize * sizeof(uptr));
+}
+#endif
+
 // The objects are allocated in TLS, so one may rely on zero-initialization.
 ThreadState::ThreadState(Tid tid)
     // Do not touch these, rely on zero initialization,
@@ -413,10 +439,7 @@ ThreadState::ThreadState(Tid tid)
 #if !SANITIZER_GO
   // C/C++ uses fixed size shadow stack.
   const int kInitStackSize = kShadowStackSize;
-  shadow_stack = static_cast<uptr*>(
-      MmapNoReserveOrDie(kInitStackSize * sizeof(uptr), "shadow stack"));
-  SetShadowRegionHugePageMode(reinterpret_cast<uptr>(shadow_stack),
-                              kInitStackSize * sizeof(uptr));
+  shadow_stack = ShadowStackAlloc();
 #else
   // Go uses malloc-allocated shadow stack with dynamic size.
   const int kInitStackSize = 8;
@@ -374,6 +374,15 @@ struct Context {
   uptr trace_part_total_allocated SANITIZER_GUARDED_BY(slot_mtx);
   uptr trace_part_recycle_finished SANITIZER_GUARDED_BY(slot_mtx);
   uptr trace_part_finished_excess SANITIZER_GUARDED_BY(slot_mtx);
+#if !SANITIZER_GO
+  // Shadow stacks of finished threads, reused by new threads so that
+  // programs creating many short-lived threads don't pay for an mmap/munmap
+  // pair per thread.
+  static const uptr kShadowStackCacheSize = 64;
+  uptr *shadow_stack_cache[kShadowStackCacheSize] SANITIZER_GUARDED_BY(
+      slot_mtx);
+  uptr shadow_stack_cache_size SANITIZER_GUARDED_BY(slot_mtx);
+#endif
 #if SANITIZER_GO
   uptr mapped_shadow_begin;
   uptr mapped_shadow_end;
@@ -559,6 +568,9 @@ Tid ThreadCreate(ThreadState *thr, uptr pc, uptr uid, bool detached);
 void ThreadStart(ThreadState *thr, Tid tid, tid_t os_id,
                  ThreadType thread_type);
 void ThreadFinish(ThreadState *thr);
+#if !SANITIZER_GO
+void ShadowStackFree(uptr *shadow_stack);
+#endif
 Tid ThreadConsumeTid(ThreadState *thr, uptr pc, uptr uid);
 void ThreadJoin(ThreadState *thr, uptr pc, Tid tid);
 void ThreadDetach(ThreadState *thr, uptr pc, Tid tid);
@@ -236,7 +236,7 @@ void ThreadFinish(ThreadState *thr) {
     }
   }
 #if !SANITIZER_GO
-  UnmapOrDie(thr->shadow_stack, kShadowStackSize * sizeof(uptr));
+  ShadowStackFree(thr->shadow_stack);
 #else
   Free(thr->shadow_stack);
 #endif
@@ -66,6 +66,11 @@ struct XRAY_TLS_ALIGNAS(64) ThreadLocalData {
                                     alignof(FDRController<>)>::type;
   ControllerStorage CStorage;
   FDRController<> *Controller = nullptr;
+
+  // State of the call sampling, see shouldRecordCall(...).
+  uint32_t CallDepth = 0;
+  uint32_t CallsUntilSample = 0;
+  bool CallSampled = true;
 };
 
 } // namespace
@@ -86,6 +91,9 @@ static atomic_uint64_t ThresholdTicks{0};
 // Global for ticks per second.
 static atomic_uint64_t TicksPerSec{0};
 
+// Global for the rate at which the outermost calls are sampled.
+static atomic_uint32_t SampleRate{1};
+
 static atomic_sint32_t LogFlushStatus = {
     XRayLogFlushStatus::XRAY_LOG_NOT_FLUSHING};
 
@@ -491,6 +499,40 @@ static bool setupTLD(ThreadLocalData &TLD) XRAY_NEVER_INSTRUMENT {
   return true;
 }
 
+// Returns whether the function entry or exit should be recorded. When sampling,
+// the decision is made for whole call trees: the outermost entry of a thread
+// starts a new tree which is recorded once in every SampleRate, and the entries
+// and exits nested in it follow the same decision. This keeps the recorded
+// stream balanced, with every recorded entry having its matching exit.
+static bool shouldRecordCall(ThreadLocalData &TLD,
+                             XRayEntryType Entry) XRAY_NEVER_INSTRUMENT {
+  auto Rate = atomic_load_relaxed(&SampleRate);
+  if (Rate <= 1)
+    return true;
+
+  switch (Entry) {
+  case XRayEntryType::ENTRY:
+  case XRayEntryType::LOG_ARGS_ENTRY:
+    if (TLD.CallDepth++ == 0) {
+      TLD.CallSampled = TLD.CallsUntilSample == 0;
+      TLD.CallsUntilSample =
+          TLD.CallSampled ? Rate - 1 : TLD.CallsUntilSample - 1;
+    }
+    return TLD.CallSampled;
+  case XRayEntryType::EXIT:
+  case XRayEntryType::TAIL:
+    // Exits of calls entered before the logging got initialized don't have a
+    // matching entry; only the outermost tree could be partially recorded.
+    if (TLD.CallDepth > 0)
+      --TLD.CallDepth;
+    return TLD.CallSampled;
+  case XRayEntryType::CUSTOM_EVENT:
+  case XRayEntryType::TYPED_EVENT:
+    break;
+  }
+  return true;
+}
+
 void fdrLoggingHandleArg0(int32_t FuncId,
                           XRayEntryType Entry) XRAY_NEVER_INSTRUMENT {
   auto TC = getTimestamp();
@@ -501,6 +543,8 @@ void fdrLoggingHandleArg0(int32_t FuncId,
     return;
 
   auto &TLD = getThreadLocalData();
+  if (!shouldRecordCall(TLD, Entry))
+    return;
   if (!setupTLD(TLD))
     return;
 
@@ -531,6 +575,8 @@ void fdrLoggingHandleArg1(int32_t FuncId, XRayEntryType Entry,
     return;
 
   auto &TLD = getThreadLocalData();
+  if (!shouldRecordCall(TLD, Entry))
+    return;
   if (!setupTLD(TLD))
     return;
 
@@ -704,6 +750,9 @@ XRayLogInitStatus fdrLoggingInit(size_t, size_t, void *Options,
                atomic_load_relaxed(&TicksPerSec) *
                    fdrFlags()->func_duration_threshold_us / 1000000,
                memory_order_release);
+  atomic_store(&SampleRate,
+               fdrFlags()->sample_rate > 1 ? fdrFlags()->sample_rate : 1,
+               memory_order_release);
   // Arg1 handler should go in first to avoid concurrent code accidentally
   // falling back to arg0 when it should have ran arg1.
   __xray_set_handler_arg1(fdrLoggingHandleArg1);
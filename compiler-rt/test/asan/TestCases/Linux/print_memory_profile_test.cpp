@@ -29,6 +29,7 @@ int main(int argc, char **argv) {
 // CHECK-100-10: Live Heap Allocations: {{.*}}; showing top 100% (at most 10 unique contexts)
 // CHECK-100-10: 2227000 byte(s) ({{.*}}%) in 17 allocation(s)
 // CHECK-100-10: 672000 byte(s) ({{.*}}%) in 28 allocation(s)
+// CHECK-100-10: Stack depot: {{[0-9]+}} unique stacks, {{[0-9]+}} KiB allocated, {{[0-9]+}} KiB released by compression
 
 // CHECK-100-1: Live Heap Allocations: {{.*}}; showing top 100% (at most 1 unique contexts)
 // CHECK-100-1: 2227000 byte(s) ({{.*}}%) in 17 allocation(s)
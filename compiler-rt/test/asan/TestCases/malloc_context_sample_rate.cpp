@@ -0,0 +1,28 @@
+// RUN: %clangxx_asan -O0 %s -o %t
+// RUN: %env_asan_opts=malloc_context_sample_rate=1000000 not %run %t 2>&1 | FileCheck %s
+// RUN: %env_asan_opts=malloc_context_sample_rate=1 not %run %t 2>&1 | FileCheck %s --check-prefix=ALL
+
+#include <stdlib.h>
+
+int main() {
+  // Make sure the sampled call of this thread is behind us.
+  free(malloc(1));
+  char *x = new char[20];
+  delete[] x;
+  return x[0];
+
+  // CHECK: freed by thread T{{.*}} here:
+  // CHECK-NEXT: #0 0x{{.*}} in {{operator delete( )?\[\]|wrap__ZdaPv}}
+  // CHECK-NOT: #1 0x{{.*}}
+
+  // CHECK: previously allocated by thread T{{.*}} here:
+  // CHECK-NEXT: #0 0x{{.*}} in {{operator new( )?\[\]|wrap__Znam}}
+  // CHECK-NOT: #1 0x{{.*}}
+
+  // CHECK: SUMMARY: AddressSanitizer: heap-use-after-free
+
+  // ALL: previously allocated by thread T{{.*}} here:
+  // ALL-NEXT: #0 0x{{.*}}
+  // ALL-NEXT: #1 0x{{.*}} in main {{.*}}malloc_context_sample_rate.cpp
+  // ALL: SUMMARY: AddressSanitizer: heap-use-after-free
+}
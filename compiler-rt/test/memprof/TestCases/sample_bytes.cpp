@@ -0,0 +1,21 @@
+// Check that with sample_bytes, only about one in sample_bytes allocated bytes
+// have their allocation recorded.
+
+// RUN: %clangxx_memprof -O0 %s -o %t
+// RUN: %env_memprof_opts=print_text=true:log_path=stdout %run %t | FileCheck %s --check-prefix=ALL
+// RUN: %env_memprof_opts=print_text=true:log_path=stdout:sample_bytes=10000 %run %t | FileCheck %s --check-prefix=SAMPLED
+
+#include <stdlib.h>
+#include <string.h>
+
+int main(int argc, char **argv) {
+  for (int i = 0; i < 100; i++) {
+    char *x = (char *)malloc(1000);
+    memset(x, 0, 1000);
+    free(x);
+  }
+  return 0;
+}
+
+// ALL: alloc_count 100, size (ave/min/max) 1000.00 / 1000 / 1000
+// SAMPLED: alloc_count {{9|10|11}}, size (ave/min/max) 1000.00 / 1000 / 1000
@@ -0,0 +1,44 @@
+/*
+RUN: rm -fr %t.profdir
+RUN: %clang_profgen=%t.profdir/default_%m.profraw -o %t -O2 %s
+RUN: %run %t
+RUN: llvm-profdata merge -o %t.profdata %t.profdir
+RUN: %clang_profuse=%t.profdata -o - -S -emit-llvm %s | FileCheck %s
+*/
+
+#include <signal.h>
+
+int __llvm_profile_set_dump_signal(int Signum);
+int __llvm_profile_dump_if_requested(void);
+int foo(int);
+
+int main(int argc, const char *argv[]) {
+  if (__llvm_profile_set_dump_signal(SIGUSR1))
+    return 1;
+
+  /* Nothing was requested yet. */
+  if (__llvm_profile_dump_if_requested())
+    return 1;
+
+  int Ret = foo(0);
+  raise(SIGUSR1);
+  if (__llvm_profile_dump_if_requested())
+    return 1;
+
+  /* The counters were reset by the dump, so the counts written at exit are
+     merged with the dumped ones without counting foo(0) twice. */
+  Ret += foo(1);
+  return Ret;
+}
+
+__attribute__((noinline)) int foo(int X) {
+  /* CHECK: define {{.*}} @foo({{.*}}!prof ![[ENT:[0-9]+]]
+     CHECK: br i1 %{{.*}}, label %{{.*}}, label %{{.*}}, !prof ![[PD:[0-9]+]]
+  */
+  return X <= 0 ? -X : X;
+}
+
+/*
+CHECK: ![[ENT]] = !{!"function_entry_count", i64 2}
+CHECK: ![[PD]] = !{!"branch_weights", i32 2, i32 2}
+*/
@@ -0,0 +1,69 @@
+// RUN: %clangxx_tsan -O1 %s -o %t && %deflake %run %t 2>&1 | FileCheck %s
+
+// The shadow stacks of finished threads are handed to new threads. Check that
+// the stacks reported for threads created after many others have finished
+// don't contain frames of the finished threads.
+
+#include "test.h"
+
+int Global;
+
+int __attribute__((noinline)) Recurse(int depth) {
+  volatile int tmp = depth;
+  if (depth == 0)
+    return tmp;
+  return Recurse(depth - 1) + tmp;
+}
+
+void *Finished(void *x) {
+  Recurse(100);
+  return NULL;
+}
+
+void __attribute__((noinline)) foo1() { Global = 42; }
+
+void __attribute__((noinline)) foo2() {
+  volatile int v = Global;
+  (void)v;
+}
+
+void *Thread1(void *x) {
+  barrier_wait(&barrier);
+  foo1();
+  return NULL;
+}
+
+void *Thread2(void *x) {
+  foo2();
+  barrier_wait(&barrier);
+  return NULL;
+}
+
+int main() {
+  for (int i = 0; i < 100; i++) {
+    pthread_t t;
+    pthread_create(&t, NULL, Finished, NULL);
+    pthread_join(t, NULL);
+  }
+
+  barrier_init(&barrier, 2);
+  pthread_t t[2];
+  pthread_create(&t[0], NULL, Thread1, NULL);
+  pthread_create(&t[1], NULL, Thread2, NULL);
+  pthread_join(t[0], NULL);
+  pthread_join(t[1], NULL);
+  fprintf(stderr, "DONE\n");
+  return 0;
+}
+
+// CHECK:      WARNING: ThreadSanitizer: data race
+// CHECK-NEXT:   Write of size 4 at {{.*}} by thread T{{[0-9]+}}:
+// CHECK-NEXT:     #0 foo1{{.*}} {{.*}}reuse_shadow_stack.cpp
+// CHECK-NEXT:     #1 Thread1{{.*}} {{.*}}reuse_shadow_stack.cpp
+// CHECK-EMPTY:
+// CHECK-NEXT:   Previous read of size 4 at {{.*}} by thread T{{[0-9]+}}:
+// CHECK-NEXT:     #0 foo2{{.*}} {{.*}}reuse_shadow_stack.cpp
+// CHECK-NEXT:     #1 Thread2{{.*}} {{.*}}reuse_shadow_stack.cpp
+// CHECK-EMPTY:
+// CHECK-NOT:  Recurse
+// CHECK:      DONE
@@ -0,0 +1,46 @@
+// RUN: %clangxx_xray -g -std=c++11 %s -o %t
+// RUN: rm -f fdr-sampling-*
+// RUN: XRAY_OPTIONS="verbosity=1 patch_premain=false \
+// RUN:   xray_logfile_base=fdr-sampling-" \
+// RUN: XRAY_FDR_OPTIONS="func_duration_threshold_us=0 sample_rate=2" \
+// RUN:   %run %t 2>&1
+// RUN: %llvm_xray convert --output-format=yaml --symbolize --instr_map=%t \
+// RUN:   "`ls fdr-sampling-* | head -n1`" | FileCheck %s
+// RUN: rm fdr-sampling-*
+//
+// REQUIRES: x86_64-target-arch
+
+#include "xray/xray_log_interface.h"
+#include <cassert>
+
+[[clang::xray_always_instrument]] void __attribute__((noinline)) inner() {}
+
+[[clang::xray_always_instrument]] void __attribute__((noinline))
+outer() {
+  inner();
+}
+
+int main(int argc, char *argv[]) {
+  auto status = __xray_log_init_mode("xray-fdr", "");
+  assert(status == XRayLogInitStatus::XRAY_LOG_INITIALIZED);
+
+  __xray_patch();
+  for (int i = 0; i < 4; ++i)
+    outer();
+  __xray_unpatch();
+  assert(__xray_log_finalize() == XRAY_LOG_FINALIZED);
+  assert(__xray_log_flushLog() == XRAY_LOG_FLUSHED);
+  return 0;
+}
+
+// Only one in two calls to outer() is recorded, along with its nested call.
+// CHECK: records:
+// CHECK-NEXT: - { type: 0, func-id: {{[0-9]+}}, function: {{.*outer.*}}, {{.*}} kind: function-enter,
+// CHECK-NEXT: - { type: 0, func-id: {{[0-9]+}}, function: {{.*inner.*}}, {{.*}} kind: function-enter,
+// CHECK-NEXT: - { type: 0, func-id: {{[0-9]+}}, function: {{.*inner.*}}, {{.*}} kind: function-exit,
+// CHECK-NEXT: - { type: 0, func-id: {{[0-9]+}}, function: {{.*outer.*}}, {{.*}} kind: function-exit,
+// CHECK-NEXT: - { type: 0, func-id: {{[0-9]+}}, function: {{.*outer.*}}, {{.*}} kind: function-enter,
+// CHECK-NEXT: - { type: 0, func-id: {{[0-9]+}}, function: {{.*inner.*}}, {{.*}} kind: function-enter,
+// CHECK-NEXT: - { type: 0, func-id: {{[0-9]+}}, function: {{.*inner.*}}, {{.*}} kind: function-exit,
+// CHECK-NEXT: - { type: 0, func-id: {{[0-9]+}}, function: {{.*outer.*}}, {{.*}} kind: function-exit,
+// CHECK-NOT: function-enter
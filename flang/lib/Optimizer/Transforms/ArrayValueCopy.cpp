@@ -6,6 +6,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "flang/Optimizer/Analysis/AliasAnalysis.h"
 #include "flang/Optimizer/Builder/Array.h"
 #include "flang/Optimizer/Builder/BoxValue.h"
 #include "flang/Optimizer/Builder/FIRBuilder.h"
@@ -561,6 +562,19 @@ static bool mutuallyExclusiveSliceRange(ArrayLoadOp ld, ArrayMergeStoreOp st) {
   return true;
 }
 
+/// Use the FIR alias analysis to prove that the array loaded by `ld` and the
+/// array stored to by `st` are distinct memory objects, e.g., a POINTER
+/// dummy argument and a local array without the TARGET attribute.
+static bool disjointMemory(ArrayLoadOp ld, ArrayMergeStoreOp st) {
+  fir::AliasAnalysis aliasAnalysis;
+  if (aliasAnalysis.alias(ld.getMemref(), st.getMemref()).isNo()) {
+    LLVM_DEBUG(llvm::dbgs() << "alias analysis proved that " << ld << " and "
+                            << st << " do not overlap\n");
+    return true;
+  }
+  return false;
+}
+
 /// Is there a conflict between the array value that was updated and to be
 /// stored to `st` and the set of arrays loaded (`reach`) and used to compute
 /// the updated value?
@@ -591,6 +605,8 @@ static bool conflictOnLoad(llvm::ArrayRef<mlir::Operation *> reach,
                 ld.getMemref(),
                 {getTargetAttrName(), GlobalOp::getTargetAttrNameStr()}))
           continue;
+        if (optimize && disjointMemory(ld, st))
+          continue;
 
         return true;
       } else if (hasPointerType(ldTy)) {
@@ -598,6 +614,8 @@ static bool conflictOnLoad(llvm::ArrayRef<mlir::Operation *> reach,
             !valueMayHaveFirAttributes(
                 addr, {getTargetAttrName(), GlobalOp::getTargetAttrNameStr()}))
           continue;
+        if (optimize && disjointMemory(ld, st))
+          continue;
 
         return true;
       }
@@ -1388,6 +1406,13 @@ public:
 
     const auto &useMap = analysis->getUseMap();
 
+    if (reportTemporaries)
+      func.walk([&](ArrayMergeStoreOp st) {
+        if (analysis->hasPotentialConflict(st))
+          mlir::emitRemark(st.getLoc(),
+                           "array assignment requires a temporary copy");
+      });
+
     mlir::RewritePatternSet patterns1(context);
     patterns1.insert<ArrayFetchConversion>(context, useMap);
     patterns1.insert<ArrayUpdateConversion>(context, *analysis, useMap);
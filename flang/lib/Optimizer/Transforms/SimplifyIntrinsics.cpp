@@ -343,6 +343,41 @@ static void genRuntimeMaxvalBody(fir::FirOpBuilder &builder,
                                            loc);
 }
 
+static void genRuntimeMinvalBody(fir::FirOpBuilder &builder,
+                                 mlir::func::FuncOp &funcOp, unsigned rank,
+                                 mlir::Type elementType) {
+  auto init = [](fir::FirOpBuilder builder, mlir::Location loc,
+                 mlir::Type elementType) {
+    if (auto ty = elementType.dyn_cast<mlir::FloatType>()) {
+      const llvm::fltSemantics &sem = ty.getFloatSemantics();
+      return builder.createRealConstant(
+          loc, elementType, llvm::APFloat::getLargest(sem, /*Negative=*/false));
+    }
+    unsigned bits = elementType.getIntOrFloatBitWidth();
+    int64_t maxInt = llvm::APInt::getSignedMaxValue(bits).getSExtValue();
+    return builder.createIntegerConstant(loc, elementType, maxInt);
+  };
+
+  auto genBodyOp = [](fir::FirOpBuilder builder, mlir::Location loc,
+                      mlir::Type elementType, mlir::Value elem1,
+                      mlir::Value elem2) -> mlir::Value {
+    if (elementType.isa<mlir::FloatType>())
+      return builder.create<mlir::arith::MinFOp>(loc, elem1, elem2);
+    if (elementType.isa<mlir::IntegerType>())
+      return builder.create<mlir::arith::MinSIOp>(loc, elem1, elem2);
+
+    llvm_unreachable("unsupported type");
+    return {};
+  };
+
+  mlir::Location loc = mlir::UnknownLoc::get(builder.getContext());
+  builder.setInsertionPointToEnd(funcOp.addEntryBlock());
+
+  genReductionLoop<fir::DoLoopOp, bool, 0>(builder, funcOp, init, nopLoopCond,
+                                           false, genBodyOp, rank, elementType,
+                                           loc);
+}
+
 static void genRuntimeCountBody(fir::FirOpBuilder &builder,
                                 mlir::func::FuncOp &funcOp, unsigned rank,
                                 mlir::Type elementType) {
@@ -917,6 +952,10 @@ void SimplifyIntrinsicsPass::runOnOperation() {
           simplifyIntOrFloatReduction(call, kindMap, genRuntimeMaxvalBody);
           return;
         }
+        if (funcName.startswith(RTNAME_STRING(Minval))) {
+          simplifyIntOrFloatReduction(call, kindMap, genRuntimeMinvalBody);
+          return;
+        }
         if (funcName.startswith(RTNAME_STRING(Count))) {
           LLVM_DEBUG(llvm::dbgs() << "Count" << '\n');
           simplifyLogicalDim0Reduction(call, kindMap, genRuntimeCountBody);
@@ -44,7 +44,9 @@ void LeftShiftBufferCircularly(char *, std::size_t bytes, std::size_t shift);
 // The 3-byte frame of file offsets 103:105 is contiguous in the buffer
 // at buffer offset (start_ + frame_) == 22 ("DEF").
 
-template <typename STORE, std::size_t minBuffer = 65536> class FileFrame {
+template <typename STORE, std::size_t minBuffer = 65536,
+    std::size_t maxBuffer = 64 * minBuffer>
+class FileFrame {
 public:
   using FileOffset = std::int64_t;
 
@@ -76,6 +78,12 @@ public:
     RUNTIME_CHECK(handler, at == fileOffset_ + frame_);
     if (static_cast<std::int64_t>(start_ + frame_ + bytes) > size_) {
       DiscardLeadingBytes(frame_, handler);
+      // A larger buffer is only useful for the rest of the file.
+      auto limit{static_cast<std::int64_t>(maxBuffer)};
+      if (auto size{Store().knownSize()}) {
+        limit = std::min<std::int64_t>(limit, *size - fileOffset_);
+      }
+      GrowForStreaming(limit, handler);
       MakeDataContiguous(handler, bytes);
       RUNTIME_CHECK(handler, at == fileOffset_ + frame_);
     }
@@ -101,6 +109,7 @@ public:
     } else if (start_ + newFrame + static_cast<std::int64_t>(bytes) > size_) {
       // Flush leading data before "at", retain from "at" onward
       Flush(handler, length_ - newFrame);
+      GrowForStreaming(maxBuffer, handler);
       MakeDataContiguous(handler, bytes);
     } else {
       frame_ = newFrame;
@@ -155,6 +164,17 @@ private:
     }
   }
 
+  // A buffer that fills up during sequential transfers is doubled, up to
+  // "limit" bytes, so that long files are read and written in fewer and
+  // larger blocks; units used only for short records keep the minimum
+  // buffer size.  This is called once the transferred data was discarded,
+  // so that only the retained data is copied.
+  void GrowForStreaming(std::int64_t limit, const Terminator &terminator) {
+    if (size_ > 0 && size_ < limit) {
+      Reallocate(std::min<std::int64_t>(2 * size_, limit), terminator);
+    }
+  }
+
   void Reset(FileOffset at) {
     start_ = length_ = frame_ = 0;
     fileOffset_ = at;
@@ -86,9 +86,23 @@ static inline CppTypeFor<RCAT, RKIND> DoDotProduct(
               static_cast<AccumType>(*yp++);
         }
       } else {
-        for (SubscriptValue j{0}; j < n; ++j) {
+        // Independent partial sums of interleaved products, so that the
+        // floating-point loop vectorizes without reassociation
+        constexpr SubscriptValue lanes{8};
+        AccumType partial[lanes]{};
+        SubscriptValue j{0};
+        for (; j + lanes <= n; j += lanes) {
+          for (SubscriptValue k{0}; k < lanes; ++k) {
+            partial[k] += static_cast<AccumType>(xp[j + k]) *
+                static_cast<AccumType>(yp[j + k]);
+          }
+        }
+        for (; j < n; ++j) {
           accum +=
-              static_cast<AccumType>(*xp++) * static_cast<AccumType>(*yp++);
+              static_cast<AccumType>(xp[j]) * static_cast<AccumType>(yp[j]);
+        }
+        for (SubscriptValue k{0}; k < lanes; ++k) {
+          accum += partial[k];
         }
       }
       return static_cast<Result>(accum);
@@ -26,6 +26,7 @@ namespace Fortran::runtime {
 
 template <typename T, bool IS_MAX, bool BACK> struct NumericCompare {
   using Type = T;
+  static constexpr bool back{BACK};
   explicit NumericCompare(std::size_t /*elemLen; ignored*/) {}
   bool operator()(const T &value, const T &previous) const {
     if (value == previous) {
@@ -41,6 +42,7 @@ template <typename T, bool IS_MAX, bool BACK> struct NumericCompare {
 template <typename T, bool IS_MAX, bool BACK> class CharacterCompare {
 public:
   using Type = T;
+  static constexpr bool back{BACK};
   explicit CharacterCompare(std::size_t elemLen)
       : chars_{elemLen / sizeof(T)} {}
   bool operator()(const T &value, const T &previous) const {
@@ -93,6 +95,55 @@ public:
     }
     return true;
   }
+  // The extremum is found first with independent lanes, which vectorize,
+  // and then the position of its first (or last, with BACK=) occurrence.
+  // A NaN in the first element is never replaced, as in AccumulateAt().
+  template <typename A> void AccumulateContiguous(const A *x, std::size_t n) {
+    if (n == 0) {
+      return;
+    }
+    constexpr std::size_t lanes{8};
+    Type lane[lanes];
+    for (std::size_t k{0}; k < lanes; ++k) {
+      lane[k] = x[0];
+    }
+    std::size_t j{0};
+    for (; j + lanes <= n; j += lanes) {
+      for (std::size_t k{0}; k < lanes; ++k) {
+        lane[k] = compare_(x[j + k], lane[k]) ? x[j + k] : lane[k];
+      }
+    }
+    Type extremum{lane[0]};
+    for (std::size_t k{1}; k < lanes; ++k) {
+      if (compare_(lane[k], extremum)) {
+        extremum = lane[k];
+      }
+    }
+    for (; j < n; ++j) {
+      if (compare_(x[j], extremum)) {
+        extremum = x[j];
+      }
+    }
+    std::size_t at{0};
+    if (extremum == extremum) {
+      if constexpr (COMPARE::back) {
+        for (at = n - 1; !(x[at] == extremum); --at) {
+        }
+      } else {
+        for (; !(x[at] == extremum); ++at) {
+        }
+      }
+    }
+    if (!previous_ || compare_(x[at], *previous_)) {
+      previous_ = &x[at];
+      array_.GetLowerBounds(extremumLoc_);
+      for (int k{0}; k < argRank_; ++k) {
+        auto extent{array_.GetDimension(k).Extent()};
+        extremumLoc_[k] += at % extent;
+        at /= extent;
+      }
+    }
+  }
 
 private:
   const Descriptor &array_;
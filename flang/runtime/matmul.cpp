@@ -25,6 +25,7 @@
 #include "flang/Runtime/c-or-cpp.h"
 #include "flang/Runtime/cpp-type.h"
 #include "flang/Runtime/descriptor.h"
+#include <algorithm>
 #include <cstring>
 
 namespace Fortran::runtime {
@@ -69,23 +70,53 @@ private:
 //    DO 2 J = 1, NCOLS
 //     DO 2 I = 1, NROWS
 //   2  RES(I,J) = RES(I,J) + X(I,K)*Y(K,J) ! loop-invariant last term
+// The loops are then blocked over I and K so that a panel of X stays in the
+// cache while it is applied to all of the columns, and each element of X
+// that is loaded updates four columns of the result.  Every RES(I,J) still
+// sums its terms in the order of K.
 template <TypeCategory RCAT, int RKIND, typename XT, typename YT>
 inline void MatrixTimesMatrix(CppTypeFor<RCAT, RKIND> *RESTRICT product,
     SubscriptValue rows, SubscriptValue cols, const XT *RESTRICT x,
     const YT *RESTRICT y, SubscriptValue n) {
   using ResultType = CppTypeFor<RCAT, RKIND>;
+  constexpr SubscriptValue rowBlock{256}, kBlock{64}, colBlock{4};
   std::memset(product, 0, rows * cols * sizeof *product);
-  const XT *RESTRICT xp0{x};
-  for (SubscriptValue k{0}; k < n; ++k) {
-    ResultType *RESTRICT p{product};
-    for (SubscriptValue j{0}; j < cols; ++j) {
-      const XT *RESTRICT xp{xp0};
-      auto yv{static_cast<ResultType>(y[k + j * n])};
-      for (SubscriptValue i{0}; i < rows; ++i) {
-        *p++ += static_cast<ResultType>(*xp++) * yv;
+  for (SubscriptValue i0{0}; i0 < rows; i0 += rowBlock) {
+    SubscriptValue iEnd{std::min(rows, i0 + rowBlock)};
+    for (SubscriptValue k0{0}; k0 < n; k0 += kBlock) {
+      SubscriptValue kEnd{std::min(n, k0 + kBlock)};
+      SubscriptValue j{0};
+      for (; j + colBlock <= cols; j += colBlock) {
+        ResultType *RESTRICT p0{product + j * rows};
+        ResultType *RESTRICT p1{p0 + rows};
+        ResultType *RESTRICT p2{p1 + rows};
+        ResultType *RESTRICT p3{p2 + rows};
+        for (SubscriptValue k{k0}; k < kEnd; ++k) {
+          const XT *RESTRICT xp{x + k * rows};
+          auto y0{static_cast<ResultType>(y[k + j * n])};
+          auto y1{static_cast<ResultType>(y[k + (j + 1) * n])};
+          auto y2{static_cast<ResultType>(y[k + (j + 2) * n])};
+          auto y3{static_cast<ResultType>(y[k + (j + 3) * n])};
+          for (SubscriptValue i{i0}; i < iEnd; ++i) {
+            auto xv{static_cast<ResultType>(xp[i])};
+            p0[i] += xv * y0;
+            p1[i] += xv * y1;
+            p2[i] += xv * y2;
+            p3[i] += xv * y3;
+          }
+        }
+      }
+      for (; j < cols; ++j) {
+        ResultType *RESTRICT p{product + j * rows};
+        for (SubscriptValue k{k0}; k < kEnd; ++k) {
+          const XT *RESTRICT xp{x + k * rows};
+          auto yv{static_cast<ResultType>(y[k + j * n])};
+          for (SubscriptValue i{i0}; i < iEnd; ++i) {
+            p[i] += static_cast<ResultType>(xp[i]) * yv;
+          }
+        }
       }
     }
-    xp0 += rows;
   }
 }
 
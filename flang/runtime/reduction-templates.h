@@ -25,6 +25,8 @@
 #include "tools.h"
 #include "flang/Runtime/cpp-type.h"
 #include "flang/Runtime/descriptor.h"
+#include <type_traits>
+#include <utility>
 
 namespace Fortran::runtime {
 
@@ -35,6 +37,19 @@ namespace Fortran::runtime {
 // AccumulateAt() member function that applies supplied subscripts to the
 // array and does something with a scalar element, and a GetResult()
 // member function that copies a final result into its destination.
+// An accumulator may also support an AccumulateContiguous() member function
+// that processes all of the elements of a contiguous array in storage order
+// with a simple loop that can be vectorized; total reductions without a
+// MASK= use it in place of AccumulateAt() when it is present.
+
+template <typename ACCUMULATOR, typename TYPE, typename = void>
+struct HasAccumulateContiguous : std::false_type {};
+template <typename ACCUMULATOR, typename TYPE>
+struct HasAccumulateContiguous<ACCUMULATOR, TYPE,
+    std::void_t<decltype(std::declval<ACCUMULATOR &>()
+                             .template AccumulateContiguous<TYPE>(
+                                 std::declval<const TYPE *>(), std::size_t{}))>>
+    : std::true_type {};
 
 // Total reduction of the array argument to a scalar (or to a vector in the
 // cases of FINDLOC, MAXLOC, & MINLOC).  These are the cases without DIM= or
@@ -68,6 +83,14 @@ inline void DoTotalReduction(const Descriptor &x, int dim,
     }
   }
   // No MASK=, or scalar MASK=.TRUE.
+  if constexpr (!std::is_void_v<TYPE> &&
+      HasAccumulateContiguous<ACCUMULATOR, TYPE>::value) {
+    if (x.IsContiguous() && x.ElementBytes() == sizeof(TYPE)) {
+      accumulator.template AccumulateContiguous<TYPE>(
+          x.Element<TYPE>(xAt), x.Elements());
+      return;
+    }
+  }
   for (auto elements{x.Elements()}; elements--; x.IncrementSubscripts(xAt)) {
     if (!accumulator.template AccumulateAt<TYPE>(xAt)) {
       break; // cut short, result is known
@@ -32,6 +32,13 @@ public:
     sum_ += *array_.Element<A>(at);
     return true;
   }
+  template <typename A> void AccumulateContiguous(const A *x, std::size_t n) {
+    INTERMEDIATE sum{0};
+    for (std::size_t j{0}; j < n; ++j) {
+      sum += x[j];
+    }
+    sum_ += sum;
+  }
 
 private:
   const Descriptor &array_;
@@ -48,7 +55,7 @@ public:
   }
   template <typename A> bool Accumulate(A x) {
     // Kahan summation
-    auto next{x + correction_};
+    auto next{x - correction_};
     auto oldSum{sum_};
     sum_ += next;
     correction_ = (sum_ - oldSum) - next; // algebraically zero
@@ -57,6 +64,30 @@ public:
   template <typename A> bool AccumulateAt(const SubscriptValue at[]) {
     return Accumulate(*array_.Element<A>(at));
   }
+  // Interleaved elements are summed in independent lanes, each with its
+  // own Kahan correction, so that the loop vectorizes; the lanes are
+  // combined at the end.
+  template <typename A> void AccumulateContiguous(const A *x, std::size_t n) {
+    constexpr std::size_t lanes{8};
+    INTERMEDIATE sum[lanes]{}, correction[lanes]{};
+    std::size_t j{0};
+    for (; j + lanes <= n; j += lanes) {
+      for (std::size_t k{0}; k < lanes; ++k) {
+        INTERMEDIATE next{
+            static_cast<INTERMEDIATE>(x[j + k]) - correction[k]};
+        INTERMEDIATE newSum{sum[k] + next};
+        correction[k] = (newSum - sum[k]) - next;
+        sum[k] = newSum;
+      }
+    }
+    for (std::size_t k{0}; k < lanes; ++k) {
+      Accumulate(sum[k]);
+      Accumulate(-correction[k]);
+    }
+    for (; j < n; ++j) {
+      Accumulate(x[j]);
+    }
+  }
 
 private:
   const Descriptor &array_;
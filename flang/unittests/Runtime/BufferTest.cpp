@@ -13,19 +13,27 @@
 #include <cstdint>
 #include <cstring>
 #include <memory>
+#include <optional>
 
 static constexpr std::size_t tinyBufferSize{32};
 using FileOffset = std::int64_t;
 using namespace Fortran::runtime;
 using namespace Fortran::runtime::io;
 
-class Store : public FileFrame<Store, tinyBufferSize> {
+// The buffer of a BasicStore grows from tinyBufferSize to at most MAX_BUFFER
+// bytes.
+template <std::size_t MAX_BUFFER>
+class BasicStore
+    : public FileFrame<BasicStore<MAX_BUFFER>, tinyBufferSize, MAX_BUFFER> {
 public:
-  explicit Store(std::size_t bytes = 65536) : bytes_{bytes} {
+  explicit BasicStore(std::size_t bytes = 65536) : bytes_{bytes} {
     data_.reset(new char[bytes]);
     std::memset(&data_[0], 0, bytes);
   }
   std::size_t bytes() const { return bytes_; }
+  std::optional<FileOffset> knownSize() const { return bytes_; }
+  std::size_t largestTransfer() const { return largestTransfer_; }
+  std::size_t largestReadRequest() const { return largestReadRequest_; }
   void set_enforceSequence(bool yes = true) { enforceSequence_ = yes; }
   void set_expect(FileOffset to) { expect_ = to; }
 
@@ -43,6 +51,8 @@ public:
     auto result{std::min<std::size_t>(maxBytes, bytes_ - at)};
     std::memcpy(to, &data_[at], result);
     expect_ = at + result;
+    largestTransfer_ = std::max(largestTransfer_, result);
+    largestReadRequest_ = std::max(largestReadRequest_, maxBytes);
     return result;
   }
   std::size_t Write(FileOffset at, const char *from, std::size_t bytes,
@@ -57,6 +67,7 @@ public:
     }
     std::memcpy(&data_[at], from, bytes);
     expect_ = at + bytes;
+    largestTransfer_ = std::max(largestTransfer_, bytes);
     return bytes;
   }
 
@@ -65,8 +76,12 @@ private:
   std::unique_ptr<char[]> data_;
   bool enforceSequence_{false};
   FileOffset expect_{0};
+  std::size_t largestTransfer_{0};
+  std::size_t largestReadRequest_{0};
 };
 
+using Store = BasicStore<tinyBufferSize>;
+
 inline int ChunkSize(int j, int most) {
   // 31, 1, 29, 3, 27, ...
   j %= tinyBufferSize;
@@ -79,10 +94,9 @@ inline int ValueFor(int at) { return (at ^ (at >> 8)) & 0xff; }
 
 struct BufferTests : CrashHandlerFixture {};
 
-TEST(BufferTests, TestFrameBufferReadAndWrite) {
+template <typename STORE> static void TestReadAndWrite(STORE &store) {
   Terminator terminator{__FILE__, __LINE__};
   IoErrorHandler handler{terminator};
-  Store store;
   store.set_enforceSequence(true);
   const auto bytes{static_cast<FileOffset>(store.bytes())};
   // Fill with an assortment of chunks
@@ -120,3 +134,34 @@ TEST(BufferTests, TestFrameBufferReadAndWrite) {
     ++j;
   }
 }
+
+TEST(BufferTests, TestFrameBufferReadAndWrite) {
+  Store store;
+  TestReadAndWrite(store);
+  EXPECT_LE(store.largestTransfer(), tinyBufferSize);
+}
+
+TEST(BufferTests, TestGrowingFrameBufferReadAndWrite) {
+  BasicStore<8 * tinyBufferSize> store;
+  TestReadAndWrite(store);
+  EXPECT_GT(store.largestTransfer(), 4 * tinyBufferSize);
+  EXPECT_LE(store.largestTransfer(), 8 * tinyBufferSize);
+}
+
+TEST(BufferTests, TestFrameBufferGrowsUpToFileSize) {
+  Terminator terminator{__FILE__, __LINE__};
+  IoErrorHandler handler{terminator};
+  constexpr FileOffset bytes{4 * tinyBufferSize + tinyBufferSize / 2};
+  BasicStore<64 * tinyBufferSize> store{bytes};
+  store.set_enforceSequence(true);
+  for (FileOffset at{0}; at < bytes;) {
+    auto chunk{std::min<FileOffset>(tinyBufferSize / 2 + 1, bytes - at)};
+    ASSERT_GE(store.ReadFrame(at, chunk, handler),
+        static_cast<std::size_t>(chunk));
+    at += chunk;
+  }
+  // Once the first buffer was read, the buffer does not grow beyond what is
+  // left of the file.
+  EXPECT_LE(store.largestReadRequest(),
+      static_cast<std::size_t>(bytes - tinyBufferSize));
+}
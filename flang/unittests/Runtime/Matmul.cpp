@@ -96,3 +96,34 @@ TEST(Matmul, Basic) {
   EXPECT_TRUE(
       static_cast<bool>(*result.ZeroBasedIndexedElement<std::uint16_t>(3)));
 }
+
+TEST(Matmul, Blocked) {
+  // Larger than the blocks of the contiguous algorithm, with remainders
+  const int rows{300}, n{70}, cols{9};
+  std::vector<std::int32_t> xData(rows * n), yData(n * cols);
+  for (int j{0}; j < rows * n; ++j) {
+    xData[j] = j % 13 - 6;
+  }
+  for (int j{0}; j < n * cols; ++j) {
+    yData[j] = j % 7 - 3;
+  }
+  auto x{MakeArray<TypeCategory::Integer, 4>(std::vector<int>{rows, n}, xData)};
+  auto y{MakeArray<TypeCategory::Integer, 4>(std::vector<int>{n, cols}, yData)};
+  StaticDescriptor<2, true> statDesc;
+  Descriptor &result{statDesc.descriptor()};
+  RTNAME(Matmul)(result, *x, *y, __FILE__, __LINE__);
+  ASSERT_EQ(result.rank(), 2);
+  ASSERT_EQ(result.GetDimension(0).Extent(), rows);
+  ASSERT_EQ(result.GetDimension(1).Extent(), cols);
+  for (int i{0}; i < rows; ++i) {
+    for (int j{0}; j < cols; ++j) {
+      std::int32_t expect{0};
+      for (int k{0}; k < n; ++k) {
+        expect += xData[i + k * rows] * yData[k + j * n];
+      }
+      EXPECT_EQ(*result.ZeroBasedIndexedElement<std::int32_t>(i + j * rows),
+          expect);
+    }
+  }
+  result.Destroy();
+}
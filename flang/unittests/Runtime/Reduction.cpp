@@ -15,6 +15,7 @@
 #include "flang/Runtime/type-code.h"
 #include <cstdint>
 #include <cstring>
+#include <limits>
 #include <string>
 #include <vector>
 
@@ -617,6 +618,73 @@ TEST(Reductions, DotProduct) {
       *logicalVector2, *logicalVector1, __FILE__, __LINE__));
 }
 
+TEST(Reductions, Contiguous) {
+  // Long enough for the vectorized loops and their remainders
+  const int n{1005};
+  std::vector<std::int32_t> ints(n);
+  std::vector<double> reals(n);
+  std::int32_t intSum{0};
+  double dot{0};
+  for (int j{0}; j < n; ++j) {
+    ints[j] = (j * 7) % 11 - 5;
+    reals[j] = ints[j];
+    intSum += ints[j];
+    dot += reals[j] * reals[j];
+  }
+  auto intVector{
+      MakeArray<TypeCategory::Integer, 4>(std::vector<int>{n}, ints)};
+  auto realVector{MakeArray<TypeCategory::Real, 8>(std::vector<int>{n}, reals)};
+  EXPECT_EQ(RTNAME(SumInteger4)(*intVector, __FILE__, __LINE__), intSum);
+  EXPECT_EQ(RTNAME(SumReal8)(*realVector, __FILE__, __LINE__), intSum);
+  EXPECT_EQ(
+      RTNAME(DotProductReal8)(*realVector, *realVector, __FILE__, __LINE__),
+      dot);
+
+  // The compensated sum does not lose the small values
+  std::vector<float> small(1 << 16, 1.0e-8f);
+  small[0] = 1.0f;
+  auto smallVector{MakeArray<TypeCategory::Real, 4>(
+      std::vector<int>{static_cast<int>(small.size())}, small)};
+  EXPECT_NEAR(RTNAME(SumReal4)(*smallVector, __FILE__, __LINE__),
+      1.0f + (small.size() - 1) * 1.0e-8f, 1.0e-6f);
+
+  // The maxima 5 are at (1,2), ..., (3,335), and the minima -5 at (1,1),
+  // ..., (3,334)
+  auto intMatrix{
+      MakeArray<TypeCategory::Integer, 4>(std::vector<int>{3, 335}, ints)};
+  auto realMatrix{
+      MakeArray<TypeCategory::Real, 8>(std::vector<int>{3, 335}, reals)};
+  StaticDescriptor<2, true> statDesc;
+  Descriptor &loc{statDesc.descriptor()};
+  RTNAME(MaxlocInteger4)
+  (loc, *intMatrix, /*KIND=*/4, __FILE__, __LINE__, /*MASK=*/nullptr,
+      /*BACK=*/false);
+  EXPECT_EQ(*loc.ZeroBasedIndexedElement<std::int32_t>(0), 1);
+  EXPECT_EQ(*loc.ZeroBasedIndexedElement<std::int32_t>(1), 2);
+  loc.Destroy();
+  RTNAME(MaxlocReal8)
+  (loc, *realMatrix, /*KIND=*/4, __FILE__, __LINE__, /*MASK=*/nullptr,
+      /*BACK=*/true);
+  EXPECT_EQ(*loc.ZeroBasedIndexedElement<std::int32_t>(0), 3);
+  EXPECT_EQ(*loc.ZeroBasedIndexedElement<std::int32_t>(1), 335);
+  loc.Destroy();
+  RTNAME(MinlocInteger4)
+  (loc, *intMatrix, /*KIND=*/4, __FILE__, __LINE__, /*MASK=*/nullptr,
+      /*BACK=*/true);
+  EXPECT_EQ(*loc.ZeroBasedIndexedElement<std::int32_t>(0), 3);
+  EXPECT_EQ(*loc.ZeroBasedIndexedElement<std::int32_t>(1), 334);
+  loc.Destroy();
+
+  // A leading NaN is never replaced
+  reals[0] = std::numeric_limits<double>::quiet_NaN();
+  auto nanVector{MakeArray<TypeCategory::Real, 8>(std::vector<int>{n}, reals)};
+  RTNAME(MaxlocReal8)
+  (loc, *nanVector, /*KIND=*/4, __FILE__, __LINE__, /*MASK=*/nullptr,
+      /*BACK=*/true);
+  EXPECT_EQ(*loc.ZeroBasedIndexedElement<std::int32_t>(0), 1);
+  loc.Destroy();
+}
+
 #if LDBL_MANT_DIG == 113 || HAS_FLOAT128
 TEST(Reductions, ExtremaReal16) {
   // The identity value for Min/Maxval for REAL(16) was mistakenly
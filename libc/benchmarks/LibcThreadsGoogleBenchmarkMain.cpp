@@ -0,0 +1,141 @@
+//===-- Benchmarks for the libc synchronization primitives ----------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Measures the throughput of the internal mutex, condition variable and
+// reader/writer lock under contention, for an increasing number of threads.
+// The time is measured as wall time, so that time spent blocked in the kernel
+// is accounted for.
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/__support/threads/linux/CndVar.h"
+#include "src/__support/threads/linux/rwlock.h"
+#include "src/__support/threads/mutex.h"
+
+#include "benchmark/benchmark.h"
+
+#include <cstdint>
+
+using __llvm_libc::CndVar;
+using __llvm_libc::Mutex;
+using __llvm_libc::RwLock;
+
+static Mutex &getMutex() {
+  static Mutex M(/*istimed=*/false, /*isrecursive=*/false,
+                 /*isrobust=*/false);
+  return M;
+}
+
+// CndVar has no constructor, it is initialized in place like a cnd_t.
+static CndVar &getCndVar() {
+  alignas(CndVar) static char Storage[sizeof(CndVar)];
+  static bool Initialized = [] {
+    return CndVar::init(reinterpret_cast<CndVar *>(Storage)) == thrd_success;
+  }();
+  (void)Initialized;
+  return *reinterpret_cast<CndVar *>(Storage);
+}
+
+// Simulates some work done with or without holding a lock.
+static void work(int64_t Iterations) {
+  for (int64_t I = 0; I < Iterations; ++I)
+    benchmark::DoNotOptimize(I);
+}
+
+// All the threads increment a counter under the same mutex. The argument is
+// the length of the critical section.
+static void BM_MutexContended(benchmark::State &State) {
+  static int64_t Counter = 0;
+  Mutex &M = getMutex();
+  for (auto _ : State) {
+    M.lock();
+    ++Counter;
+    work(State.range(0));
+    M.unlock();
+    work(State.range(0));
+  }
+  State.SetItemsProcessed(State.iterations());
+}
+BENCHMARK(BM_MutexContended)
+    ->Arg(0)
+    ->Arg(64)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+// Two threads hand a token over to each other through a condition variable,
+// which measures the latency of a wake up.
+static void BM_CndVarPingPong(benchmark::State &State) {
+  static int Turn = 0;
+  Mutex &M = getMutex();
+  CndVar &CV = getCndVar();
+  const int Self = State.thread_index();
+  for (auto _ : State) {
+    M.lock();
+    while (Turn != Self)
+      CV.wait(&M);
+    Turn = 1 - Self;
+    CV.notify_one();
+    M.unlock();
+  }
+  State.SetItemsProcessed(State.iterations());
+}
+BENCHMARK(BM_CndVarPingPong)->Threads(2)->UseRealTime();
+
+// The threads synchronize at a barrier built from a condition variable at
+// every iteration, which is released by a broadcast from the last thread.
+static void BM_CndVarBroadcast(benchmark::State &State) {
+  static int Generation = 0;
+  static int Arrived = 0;
+  Mutex &M = getMutex();
+  CndVar &CV = getCndVar();
+  const int NumThreads = State.threads();
+  for (auto _ : State) {
+    M.lock();
+    const int CurrentGeneration = Generation;
+    if (++Arrived == NumThreads) {
+      Arrived = 0;
+      ++Generation;
+      CV.broadcast();
+    } else {
+      while (CurrentGeneration == Generation)
+        CV.wait(&M);
+    }
+    M.unlock();
+  }
+  State.SetItemsProcessed(State.iterations());
+}
+BENCHMARK(BM_CndVarBroadcast)->ThreadRange(2, 16)->UseRealTime();
+
+// The threads mostly read the data protected by a reader/writer lock. The
+// argument is the percentage of the accesses which are writes.
+static void BM_RwLockReadMostly(benchmark::State &State) {
+  static RwLock Lock;
+  static int64_t Data = 0;
+  const int64_t WritePercentage = State.range(0);
+  int64_t Iteration = State.thread_index();
+  for (auto _ : State) {
+    if (++Iteration % 100 < WritePercentage) {
+      Lock.write_lock();
+      ++Data;
+      work(16);
+      Lock.unlock();
+    } else {
+      Lock.read_lock();
+      benchmark::DoNotOptimize(Data);
+      work(16);
+      Lock.unlock();
+    }
+  }
+  State.SetItemsProcessed(State.iterations());
+}
+BENCHMARK(BM_RwLockReadMostly)
+    ->Arg(0)
+    ->Arg(1)
+    ->Arg(10)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
@@ -0,0 +1,20 @@
+//===-- Definition of pthread_cond_t type ---------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef __LLVM_LIBC_TYPES_PTHREAD_COND_T_H
+#define __LLVM_LIBC_TYPES_PTHREAD_COND_T_H
+
+#include <llvm-libc-types/pthread_mutex_t.h>
+
+typedef struct {
+  void *__qfront;
+  void *__qback;
+  pthread_mutex_t __qmtx;
+} pthread_cond_t;
+
+#endif // __LLVM_LIBC_TYPES_PTHREAD_COND_T_H
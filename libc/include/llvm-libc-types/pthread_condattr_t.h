@@ -0,0 +1,19 @@
+//===-- Definition of pthread_condattr_t type -----------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef __LLVM_LIBC_TYPES_PTHREAD_CONDATTR_T_H
+#define __LLVM_LIBC_TYPES_PTHREAD_CONDATTR_T_H
+
+#include <llvm-libc-types/clockid_t.h>
+
+typedef struct {
+  clockid_t __clock;
+  int __pshared;
+} pthread_condattr_t;
+
+#endif // __LLVM_LIBC_TYPES_PTHREAD_CONDATTR_T_H
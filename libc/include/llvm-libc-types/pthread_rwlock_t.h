@@ -0,0 +1,19 @@
+//===-- Definition of pthread_rwlock_t type -------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef __LLVM_LIBC_TYPES_PTHREAD_RWLOCK_T_H
+#define __LLVM_LIBC_TYPES_PTHREAD_RWLOCK_T_H
+
+#include <llvm-libc-types/__futex_word.h>
+
+typedef struct {
+  __futex_word __state;
+  __futex_word __writer_notify;
+} pthread_rwlock_t;
+
+#endif // __LLVM_LIBC_TYPES_PTHREAD_RWLOCK_T_H
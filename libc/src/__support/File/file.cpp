@@ -10,6 +10,7 @@
 
 #include "src/__support/CPP/new.h"
 #include "src/__support/CPP/span.h"
+#include "src/string/memory_utils/memcpy_implementations.h"
 
 #include <errno.h> // For error macros
 #include <stdio.h>
@@ -38,6 +39,21 @@ FileIOResult File::write_unlocked(const void *data, size_t len) {
 }
 
 FileIOResult File::write_unlocked_nbf(const uint8_t *data, size_t len) {
+  if (pos > 0 && platform_writev != nullptr) {
+    // Flush the buffer and write the data with a single operation.
+    const size_t buffered = pos;
+    auto write_result = platform_writev(this, buf, buffered, data, len);
+    pos = 0;
+    if (write_result < buffered + len) {
+      err = true;
+      // Only report the bytes written from data.
+      return {write_result.value <= buffered ? 0
+                                             : write_result.value - buffered,
+              write_result.error};
+    }
+    return len;
+  }
+
   if (pos > 0) { // If the buffer is not empty
     // Flush the buffer
     const size_t write_size = pos;
@@ -62,7 +78,10 @@ FileIOResult File::write_unlocked_fbf(const uint8_t *data, size_t len) {
   const size_t bufspace = bufsize - pos;
 
   // If data is too large to be buffered at all, then just write it unbuffered.
-  if (len > bufspace + bufsize)
+  // If the buffer and the data can be written together, do so as soon as the
+  // data would need a flush of its own, rather than copying it first.
+  if (len > bufspace + bufsize ||
+      (platform_writev != nullptr && len >= bufsize))
     return write_unlocked_nbf(data, len);
 
   // we split |data| (conceptually) using the split point. Then we handle the
@@ -84,9 +103,7 @@ FileIOResult File::write_unlocked_fbf(const uint8_t *data, size_t len) {
   cpp::span<uint8_t> bufref(static_cast<uint8_t *>(buf), bufsize);
 
   // Copy the first piece into the buffer.
-  // TODO: Replace the for loop below with a call to internal memcpy.
-  for (size_t i = 0; i < primary.size(); ++i)
-    bufref[pos + i] = primary[i];
+  inline_memcpy(bufref.data() + pos, primary.data(), primary.size());
   pos += primary.size();
 
   // If there is no remainder, we can return early, since the first piece has
@@ -114,14 +131,12 @@ FileIOResult File::write_unlocked_fbf(const uint8_t *data, size_t len) {
   // know that if the second piece has data in it then the buffer has been
   // flushed, meaning that pos is always 0.
   if (remainder.size() < bufsize) {
-    // TODO: Replace the for loop below with a call to internal memcpy.
-    for (size_t i = 0; i < remainder.size(); ++i)
-      bufref[i] = remainder[i];
+    inline_memcpy(bufref.data(), remainder.data(), remainder.size());
     pos = remainder.size();
   } else {
 
     auto result = platform_write(this, remainder.data(), remainder.size());
-    size_t bytes_written = buf_result.value;
+    size_t bytes_written = result.value;
 
     // If less bytes were written than expected, then an error occurred. Return
     // the number of bytes that have been written from |data|.
@@ -196,17 +211,13 @@ FileIOResult File::read_unlocked(void *data, size_t len) {
   // available_data is never a wrapped around value.
   size_t available_data = read_limit - pos;
   if (len <= available_data) {
-    // TODO: Replace the for loop below with a call to internal memcpy.
-    for (size_t i = 0; i < len; ++i)
-      dataref[i] = bufref[i + pos];
+    inline_memcpy(dataref.data(), bufref.data() + pos, len);
     pos += len;
     return len;
   }
 
   // Copy all of the available data.
-  // TODO: Replace the for loop with a call to internal memcpy.
-  for (size_t i = 0; i < available_data; ++i)
-    dataref[i] = bufref[i + pos];
+  inline_memcpy(dataref.data(), bufref.data() + pos, available_data);
   read_limit = pos = 0; // Reset the pointers.
   // Update the dataref to reflect that fact that we have already
   // copied |available_data| into |data|.
@@ -232,8 +243,7 @@ FileIOResult File::read_unlocked(void *data, size_t len) {
   size_t fetched_size = result.value;
   read_limit += fetched_size;
   size_t transfer_size = fetched_size >= to_fetch ? to_fetch : fetched_size;
-  for (size_t i = 0; i < transfer_size; ++i)
-    dataref[i] = bufref[i];
+  inline_memcpy(dataref.data(), bufref.data(), transfer_size);
   pos += transfer_size;
   if (result.has_error() || fetched_size < to_fetch) {
     if (!result.has_error())
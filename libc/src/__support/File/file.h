@@ -12,6 +12,7 @@
 #include "src/__support/CPP/new.h"
 #include "src/__support/error_or.h"
 #include "src/__support/threads/mutex.h"
+#include "src/__support/threads/single_threaded.h"
 
 #include <stddef.h>
 #include <stdint.h>
@@ -41,6 +42,11 @@ public:
   using UnlockFunc = void(File *);
 
   using WriteFunc = FileIOResult(File *, const void *, size_t);
+  // The WriteVFunc writes the two pieces of data one after the other, with a
+  // single platform operation. The returned value is the total number of bytes
+  // written.
+  using WriteVFunc = FileIOResult(File *, const void *, size_t, const void *,
+                                  size_t);
   using ReadFunc = FileIOResult(File *, void *, size_t);
   // The SeekFunc is expected to return the current offset of the external
   // file position indicator.
@@ -95,6 +101,8 @@ private:
   CloseFunc *platform_close;
   FlushFunc *platform_flush;
   CleanupFunc *platform_cleanup;
+  // Optional, the buffer and the data are written separately if it's nullptr.
+  WriteVFunc *platform_writev;
 
   Mutex mutex;
 
@@ -129,14 +137,22 @@ private:
   bool eof;
   bool err;
 
-  // This is a convenience RAII class to lock and unlock file objects.
+  // This is a convenience RAII class to lock and unlock file objects. The
+  // lock is skipped while the process has a single thread.
   class FileLock {
     File *file;
+    bool locked;
 
   public:
-    explicit FileLock(File *f) : file(f) { file->lock(); }
+    explicit FileLock(File *f) : file(f), locked(!is_single_threaded()) {
+      if (locked)
+        file->lock();
+    }
 
-    ~FileLock() { file->unlock(); }
+    ~FileLock() {
+      if (locked)
+        file->unlock();
+    }
 
     FileLock(const FileLock &) = delete;
     FileLock(FileLock &&) = delete;
@@ -190,13 +206,13 @@ public:
   constexpr File(WriteFunc *wf, ReadFunc *rf, SeekFunc *sf, CloseFunc *cf,
                  FlushFunc *ff, CleanupFunc *clf, uint8_t *buffer,
                  size_t buffer_size, int buffer_mode, bool owned,
-                 ModeFlags modeflags)
+                 ModeFlags modeflags, WriteVFunc *wvf = nullptr)
       : platform_write(wf), platform_read(rf), platform_seek(sf),
         platform_close(cf), platform_flush(ff), platform_cleanup(clf),
-        mutex(false, false, false), ungetc_buf(0), buf(buffer),
-        bufsize(buffer_size), bufmode(buffer_mode), own_buf(owned),
-        mode(modeflags), pos(0), prev_op(FileOp::NONE), read_limit(0),
-        eof(false), err(false) {
+        platform_writev(wvf), mutex(false, false, false), ungetc_buf(0),
+        buf(buffer), bufsize(buffer_size), bufmode(buffer_mode),
+        own_buf(owned), mode(modeflags), pos(0), prev_op(FileOp::NONE),
+        read_limit(0), eof(false), err(false) {
     adjust_buf();
   }
 
@@ -21,6 +21,7 @@ namespace __llvm_libc {
 namespace {
 
 FileIOResult write_func(File *, const void *, size_t);
+FileIOResult writev_func(File *, const void *, size_t, const void *, size_t);
 FileIOResult read_func(File *, void *, size_t);
 ErrorOr<long> seek_func(File *, long, int);
 int close_func(File *);
@@ -36,7 +37,7 @@ public:
                       int buffer_mode, bool owned, File::ModeFlags modeflags)
       : File(&write_func, &read_func, &seek_func, &close_func, flush_func,
              &cleanup_file<LinuxFile>, buffer, buffer_size, buffer_mode, owned,
-             modeflags),
+             modeflags, &writev_func),
         fd(file_descriptor) {}
 
   int get_fd() const { return fd; }
@@ -53,6 +54,22 @@ FileIOResult write_func(File *f, const void *data, size_t size) {
   return ret;
 }
 
+FileIOResult writev_func(File *f, const void *data1, size_t size1,
+                         const void *data2, size_t size2) {
+  // The layout of the kernel's struct iovec.
+  struct IOVec {
+    const void *base;
+    size_t len;
+  };
+  auto *lf = reinterpret_cast<LinuxFile *>(f);
+  IOVec iov[2] = {{data1, size1}, {data2, size2}};
+  long ret = __llvm_libc::syscall_impl(SYS_writev, lf->get_fd(), iov, 2);
+  if (ret < 0) {
+    return {0, static_cast<int>(-ret)};
+  }
+  return static_cast<size_t>(ret);
+}
+
 FileIOResult read_func(File *f, void *buf, size_t size) {
   auto *lf = reinterpret_cast<LinuxFile *>(f);
   int ret = __llvm_libc::syscall_impl(SYS_read, lf->get_fd(), buf, size);
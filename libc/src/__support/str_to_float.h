@@ -783,7 +783,20 @@ decimal_string_to_float(const char *__restrict src, const char DECIMAL_POINT,
   // The loop fills the mantissa with as many digits as it can hold
   const BitsType bitstype_max_div_by_base =
       cpp::numeric_limits<BitsType>::max() / BASE;
+  // Below this, eight more digits fit in the mantissa as well.
+  const BitsType bitstype_max_div_by_eight_digits =
+      bitstype_max_div_by_base / 100000000;
   while (true) {
+    uint32_t eight_digits;
+    if (mantissa < bitstype_max_div_by_eight_digits &&
+        read_eight_digits(src, &eight_digits)) {
+      seen_digit = true;
+      mantissa = (mantissa * 100000000) + eight_digits;
+      if (after_decimal)
+        exponent -= 8;
+      src += 8;
+      continue;
+    }
     if (isdigit(*src)) {
       uint32_t digit = *src - '0';
       seen_digit = true;
@@ -12,9 +12,11 @@
 #include "src/__support/CPP/limits.h"
 #include "src/__support/common.h"
 #include "src/__support/ctype_utils.h"
+#include "src/__support/endian.h"
 #include "src/__support/str_to_num_result.h"
 #include <errno.h>
 #include <limits.h>
+#include <stdint.h>
 
 namespace __llvm_libc {
 namespace internal {
@@ -65,6 +67,55 @@ LIBC_INLINE int infer_base(const char *__restrict *__restrict src) {
   }
 }
 
+// Returns true if each of the eight characters packed in little endian order
+// in |chars| is a decimal digit. A byte is a digit if its high nibble is 3 and
+// its low nibble is at most 9, which is checked for all bytes at once: adding 6
+// to a low nibble above 9 carries into the high nibble.
+LIBC_INLINE bool is_eight_digits(uint64_t chars) {
+  constexpr uint64_t HIGH_NIBBLES = 0xF0F0F0F0F0F0F0F0;
+  return ((chars & HIGH_NIBBLES) |
+          (((chars + 0x0606060606060606) & HIGH_NIBBLES) >> 4)) ==
+         0x3333333333333333;
+}
+
+// Returns the value of the eight decimal digits packed in little endian order
+// in |chars|, the first character being the most significant digit. The digits
+// are combined pairwise with three multiplications instead of eight.
+LIBC_INLINE uint32_t eight_digits_to_int(uint64_t chars) {
+  constexpr uint64_t MASK = 0x000000FF000000FF;
+  constexpr uint64_t MUL1 = 100 + (1000000ULL << 32);
+  constexpr uint64_t MUL2 = 1 + (10000ULL << 32);
+  chars -= 0x3030303030303030;
+  chars = (chars * 10) + (chars >> 8);
+  chars = (((chars & MASK) * MUL1) + (((chars >> 16) & MASK) * MUL2)) >> 32;
+  return static_cast<uint32_t>(chars);
+}
+
+// If the next eight characters of |src| are all decimal digits, stores their
+// value in |value| and returns true. Since the characters are read with a
+// single load that may go past the end of the string, this is only done if the
+// load stays within the page of |src|, and only when wide reads are allowed.
+LIBC_INLINE bool read_eight_digits(const char *__restrict src,
+                                   uint32_t *value) {
+#ifdef LIBC_UNSAFE_STRING_WIDE_READ
+  constexpr uintptr_t PAGE_SIZE = 4096;
+  if (reinterpret_cast<uintptr_t>(src) % PAGE_SIZE >
+      PAGE_SIZE - sizeof(uint64_t))
+    return false;
+  uint64_t chars;
+  __builtin_memcpy(&chars, src, sizeof(chars));
+  chars = __llvm_libc::Endian::to_little_endian(chars);
+  if (!is_eight_digits(chars))
+    return false;
+  *value = eight_digits_to_int(chars);
+  return true;
+#else
+  (void)src;
+  (void)value;
+  return false;
+#endif
+}
+
 // Takes a pointer to a string and the base to convert to. This function is used
 // as the backend for all of the string to int functions.
 template <class T>
@@ -103,6 +154,19 @@ LIBC_INLINE StrToNumResult<T> strtointeger(const char *__restrict src,
   unsigned long long const abs_max =
       (is_positive ? cpp::numeric_limits<T>::max() : NEGATIVE_MAX);
   unsigned long long const abs_max_div_by_base = abs_max / base;
+  if (base == 10) {
+    // Consume the digits eight at a time while the result cannot overflow,
+    // which gives the same result as the loop below.
+    unsigned long long const max_before_eight_digits =
+        (abs_max - 99999999) / 100000000;
+    uint32_t eight_digits;
+    while (result <= max_before_eight_digits &&
+           read_eight_digits(src, &eight_digits)) {
+      result = result * 100000000 + eight_digits;
+      is_number = true;
+      src += 8;
+    }
+  }
   while (isalnum(*src)) {
     int cur_digit = b36_char_to_int(*src);
     if (cur_digit >= base)
@@ -43,10 +43,12 @@ public:
     return true;
   }
 
+  // As specified by POSIX, the prepare callbacks are invoked in the reverse
+  // order of their registration.
   void invoke_prepare() {
     MutexLock lock(&mtx);
-    for (size_t i = 0; i < next_index; ++i) {
-      auto prepare = list[i].prepare;
+    for (size_t i = next_index; i > 0; --i) {
+      auto prepare = list[i - 1].prepare;
       if (prepare)
         prepare();
     }
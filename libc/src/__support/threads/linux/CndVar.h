@@ -6,8 +6,8 @@
 //
 //===----------------------------------------------------------------------===//
 
-#ifndef LLVM_LIBC_SRC_THREADS_LINUX_CNDVAR_H
-#define LLVM_LIBC_SRC_THREADS_LINUX_CNDVAR_H
+#ifndef LLVM_LIBC_SRC_SUPPORT_THREADS_LINUX_CNDVAR_H
+#define LLVM_LIBC_SRC_SUPPORT_THREADS_LINUX_CNDVAR_H
 
 #include "include/sys/syscall.h" // For syscall numbers.
 #include "include/threads.h"     // For values like thrd_success etc.
@@ -25,6 +25,9 @@ struct CndVar {
   enum CndWaiterStatus : uint32_t {
     WS_Waiting = 0xE,
     WS_Signalled = 0x5,
+    // Signalled by broadcast(), which hands the waiters queued after this one
+    // over to it.
+    WS_Broadcast = 0x6,
   };
 
   struct CndWaiter {
@@ -84,12 +87,23 @@ struct CndVar {
       }
     }
 
-    __llvm_libc::syscall_impl(SYS_futex, &waiter.futex_word.val, FUTEX_WAIT,
-                              WS_Waiting, 0, 0, 0);
+    // The waiter is still referenced by the queue or by the previous waiter
+    // until it is signalled, so it must not return before then, even if the
+    // futex wait is interrupted.
+    uint32_t status;
+    while ((status = waiter.futex_word.load()) == WS_Waiting)
+      __llvm_libc::syscall_impl(SYS_futex, &waiter.futex_word.val,
+                                FUTEX_WAIT_PRIVATE, WS_Waiting, 0, 0, 0);
 
     // At this point, if locking |m| fails, we can simply return as the
     // queued up waiter would have been removed from the queue.
     auto err = m->lock();
+
+    // The waiters detached from the queue by broadcast() are woken up one at
+    // a time, each one by the previous one once it owns |m|. These waiters
+    // are still waiting, so |next| remains valid.
+    if (status == WS_Broadcast && waiter.next != nullptr)
+      wake(waiter.next, WS_Broadcast);
     return err == MutexError::NONE ? thrd_success : thrd_error;
   }
 
@@ -110,30 +124,43 @@ struct CndVar {
     qmtx.futex_word = FutexWordType(Mutex::LockState::Free);
 
     __llvm_libc::syscall_impl(
-        SYS_futex, &qmtx.futex_word.val, FUTEX_WAKE_OP, 1, 1,
+        SYS_futex, &qmtx.futex_word.val, FUTEX_WAKE_OP_PRIVATE, 1, 1,
         &first->futex_word.val,
         FUTEX_OP(FUTEX_OP_SET, WS_Signalled, FUTEX_OP_CMP_EQ, WS_Waiting));
     return thrd_success;
   }
 
   int broadcast() {
-    MutexLock ml(&qmtx);
-    uint32_t dummy_futex_word;
-    CndWaiter *waiter = waitq_front;
-    waitq_front = waitq_back = nullptr;
-    while (waiter != nullptr) {
-      // FUTEX_WAKE_OP is used instead of just FUTEX_WAKE as it allows us to
-      // atomically update the waiter status to WS_Signalled before waking
-      // up the waiter. A dummy location is used for the other futex of
-      // FUTEX_WAKE_OP.
-      __llvm_libc::syscall_impl(
-          SYS_futex, &dummy_futex_word, FUTEX_WAKE_OP, 1, 1,
-          &waiter->futex_word.val,
-          FUTEX_OP(FUTEX_OP_SET, WS_Signalled, FUTEX_OP_CMP_EQ, WS_Waiting));
-      waiter = waiter->next;
+    CndWaiter *first;
+    {
+      MutexLock ml(&qmtx);
+      first = waitq_front;
+      waitq_front = waitq_back = nullptr;
     }
+    if (first == nullptr)
+      return thrd_success;
+
+    // Only the first waiter is woken up. All of the waiters have to lock their
+    // mutex before returning, so waking them all up at once would only make
+    // them contend on it. Hence each woken up waiter wakes up the next one
+    // once it owns the mutex. The detached waiters are not accessed here past
+    // the first one, as they can return as soon as they are signalled.
+    wake(first, WS_Broadcast);
     return thrd_success;
   }
+
+private:
+  // Signals |waiter| with |status| and wakes it up if it is already waiting.
+  static void wake(CndWaiter *waiter, CndWaiterStatus status) {
+    // FUTEX_WAKE_OP is used instead of just FUTEX_WAKE as it allows us to
+    // atomically update the waiter status before waking up the waiter. A
+    // dummy location is used for the other futex of FUTEX_WAKE_OP.
+    uint32_t dummy_futex_word;
+    __llvm_libc::syscall_impl(
+        SYS_futex, &dummy_futex_word, FUTEX_WAKE_OP_PRIVATE, 1, 1,
+        &waiter->futex_word.val,
+        FUTEX_OP(FUTEX_OP_SET, status, FUTEX_OP_CMP_EQ, WS_Waiting));
+  }
 };
 
 static_assert(sizeof(CndVar) == sizeof(cnd_t),
@@ -143,4 +170,4 @@ static_assert(sizeof(CndVar) == sizeof(cnd_t),
 
 } // namespace __llvm_libc
 
-#endif // LLVM_LIBC_SRC_THREADS_LINUX_CNDVAR_H
+#endif // LLVM_LIBC_SRC_SUPPORT_THREADS_LINUX_CNDVAR_H
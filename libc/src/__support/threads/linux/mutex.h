@@ -13,6 +13,7 @@
 #include "src/__support/OSUtil/syscall.h" // For syscall functions.
 #include "src/__support/threads/linux/futex_word.h"
 #include "src/__support/threads/mutex_common.h"
+#include "src/__support/threads/sleep.h"
 
 #include <linux/futex.h>
 #include <stdint.h>
@@ -57,8 +58,27 @@ public:
 
   MutexError reset();
 
-  MutexError lock() {
-    bool was_waiting = false;
+  // The number of times a locked mutex is polled before waiting on the futex.
+  // Critical sections are usually short, so spinning for a little while saves
+  // the futex wait and wake syscalls when the owner is running on another CPU.
+  static constexpr unsigned SPIN_COUNT = 100;
+
+  MutexError lock() { return lock_impl(/*was_waiting=*/false); }
+
+  MutexError lock_impl(bool was_waiting) {
+    // Spin while the mutex is held but nobody waits for it. If there are
+    // waiters already, spinning would only let this thread jump the queue.
+    for (unsigned i = 0; !was_waiting && i < SPIN_COUNT; ++i) {
+      FutexWordType mutex_status = futex_word.load(cpp::MemoryOrder::RELAXED);
+      if (mutex_status == FutexWordType(LockState::Waiting))
+        break;
+      if (mutex_status == FutexWordType(LockState::Free) &&
+          futex_word.compare_exchange_strong(mutex_status,
+                                             FutexWordType(LockState::Locked)))
+        return MutexError::NONE;
+      sleep_briefly();
+    }
+
     while (true) {
       FutexWordType mutex_status = FutexWordType(LockState::Free);
       FutexWordType locked_status = FutexWordType(LockState::Locked);
@@ -91,7 +111,8 @@ public:
           // we will wait for the futex to be woken up. Note again that the
           // following syscall will block only if the futex data is still
           // `LockState::Waiting`.
-          __llvm_libc::syscall_impl(SYS_futex, &futex_word, FUTEX_WAIT_PRIVATE,
+          __llvm_libc::syscall_impl(SYS_futex, &futex_word.val,
+                                    FUTEX_WAIT_PRIVATE,
                                     FutexWordType(LockState::Waiting), 0, 0, 0);
           was_waiting = true;
         }
@@ -109,8 +130,8 @@ public:
       if (futex_word.compare_exchange_strong(mutex_status,
                                              FutexWordType(LockState::Free))) {
         // If any thread is waiting to be woken up, then do it.
-        __llvm_libc::syscall_impl(SYS_futex, &futex_word, FUTEX_WAKE_PRIVATE, 1,
-                                  0, 0, 0);
+        __llvm_libc::syscall_impl(SYS_futex, &futex_word.val,
+                                  FUTEX_WAKE_PRIVATE, 1, 0, 0, 0);
         return MutexError::NONE;
       }
 
@@ -127,7 +148,13 @@ public:
     }
   }
 
-  MutexError trylock();
+  MutexError trylock() {
+    FutexWordType mutex_status = FutexWordType(LockState::Free);
+    if (futex_word.compare_exchange_strong(mutex_status,
+                                           FutexWordType(LockState::Locked)))
+      return MutexError::NONE;
+    return MutexError::BUSY;
+  }
 };
 
 } // namespace __llvm_libc
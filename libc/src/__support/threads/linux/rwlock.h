@@ -0,0 +1,233 @@
+//===--- Implementation of a Linux reader/writer lock class -----*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIBC_SRC_SUPPORT_THREADS_LINUX_RWLOCK_H
+#define LLVM_LIBC_SRC_SUPPORT_THREADS_LINUX_RWLOCK_H
+
+#include "src/__support/CPP/atomic.h"
+#include "src/__support/OSUtil/syscall.h" // For syscall functions.
+#include "src/__support/threads/linux/futex_word.h"
+#include "src/__support/threads/mutex_common.h"
+#include "src/__support/threads/sleep.h"
+
+#include <limits.h>
+#include <linux/futex.h>
+#include <stdint.h>
+#include <sys/syscall.h> // For syscall numbers.
+
+namespace __llvm_libc {
+
+// A reader/writer lock built on two futexes. The state futex holds the number
+// of readers owning the lock, or WRITE_LOCKED when a writer owns it, along
+// with a bit for each kind of waiters. Readers wait on the state futex while
+// writers wait on the writer_notify futex, so that an unlock can either wake
+// up a single writer or all of the readers. Writers are preferred: readers do
+// not acquire the lock while writers are waiting, so that a continuous stream
+// of readers cannot starve the writers.
+class RwLock {
+  static constexpr FutexWordType READ_LOCKED = 1;
+  static constexpr FutexWordType MASK = (FutexWordType(1) << 30) - 1;
+  static constexpr FutexWordType WRITE_LOCKED = MASK;
+  static constexpr FutexWordType MAX_READERS = MASK - 1;
+  static constexpr FutexWordType READERS_WAITING = FutexWordType(1) << 30;
+  static constexpr FutexWordType WRITERS_WAITING = FutexWordType(1) << 31;
+
+  // The number of times the state is polled before waiting on a futex.
+  static constexpr unsigned SPIN_COUNT = 100;
+
+  cpp::Atomic<FutexWordType> state;
+  // Incremented every time a writer is woken up, so that a writer about to
+  // wait can detect that it was woken up in the meantime.
+  cpp::Atomic<FutexWordType> writer_notify;
+
+  static bool is_unlocked(FutexWordType s) { return (s & MASK) == 0; }
+  static bool is_write_locked(FutexWordType s) {
+    return (s & MASK) == WRITE_LOCKED;
+  }
+  static bool has_readers_waiting(FutexWordType s) {
+    return s & READERS_WAITING;
+  }
+  static bool has_writers_waiting(FutexWordType s) {
+    return s & WRITERS_WAITING;
+  }
+  static bool is_read_lockable(FutexWordType s) {
+    return (s & MASK) < MAX_READERS && !has_readers_waiting(s) &&
+           !has_writers_waiting(s);
+  }
+
+  // Spinning stops once the lock may be acquired, or once a thread waits: the
+  // waiting threads are to be woken up in order rather than overtaken.
+  static bool read_spin_done(FutexWordType s) {
+    return !is_write_locked(s) || has_readers_waiting(s) ||
+           has_writers_waiting(s);
+  }
+  static bool write_spin_done(FutexWordType s) {
+    return is_unlocked(s) || has_writers_waiting(s);
+  }
+
+  FutexWordType spin_until(bool (*pred)(FutexWordType)) {
+    for (unsigned i = 0;; ++i) {
+      FutexWordType s = state.load(cpp::MemoryOrder::RELAXED);
+      if (pred(s) || i == SPIN_COUNT)
+        return s;
+      sleep_briefly();
+    }
+  }
+
+  void futex_wait(cpp::Atomic<FutexWordType> &futex_word,
+                  FutexWordType expected) {
+    __llvm_libc::syscall_impl(SYS_futex, &futex_word.val, FUTEX_WAIT_PRIVATE,
+                              expected, 0, 0, 0);
+  }
+
+  // Returns true if a writer was woken up.
+  bool wake_writer() {
+    writer_notify.fetch_add(1);
+    return __llvm_libc::syscall_impl(SYS_futex, &writer_notify.val,
+                                     FUTEX_WAKE_PRIVATE, 1, 0, 0, 0) > 0;
+  }
+
+  MutexError read_lock_contended() {
+    FutexWordType s = spin_until(read_spin_done);
+    while (true) {
+      if (is_read_lockable(s)) {
+        if (state.compare_exchange_strong(s, s + READ_LOCKED))
+          return MutexError::NONE;
+        continue;
+      }
+      if ((s & MASK) == MAX_READERS)
+        return MutexError::BUSY;
+      if (!has_readers_waiting(s) &&
+          !state.compare_exchange_strong(s, s | READERS_WAITING))
+        continue;
+      futex_wait(state, s | READERS_WAITING);
+      s = spin_until(read_spin_done);
+    }
+  }
+
+  void write_lock_contended() {
+    FutexWordType s = spin_until(write_spin_done);
+    // Once this writer has waited, it cannot know whether other writers are
+    // waiting as well, so it keeps the WRITERS_WAITING bit set when it gets
+    // the lock. The unlock then wakes up the next writer, if any.
+    FutexWordType other_writers_waiting = 0;
+    while (true) {
+      if (is_unlocked(s)) {
+        if (state.compare_exchange_strong(s, s | WRITE_LOCKED |
+                                                 other_writers_waiting))
+          return;
+        continue;
+      }
+      if (!has_writers_waiting(s) &&
+          !state.compare_exchange_strong(s, s | WRITERS_WAITING))
+        continue;
+      other_writers_waiting = WRITERS_WAITING;
+
+      // Do not wait if the lock was released before the sequence number was
+      // read, as the corresponding wake up might have been missed.
+      FutexWordType seq = writer_notify.load();
+      s = state.load(cpp::MemoryOrder::RELAXED);
+      if (is_unlocked(s) || !has_writers_waiting(s))
+        continue;
+      futex_wait(writer_notify, seq);
+      s = spin_until(write_spin_done);
+    }
+  }
+
+  // Called when the lock was released with waiters. Writers are woken up
+  // first, and readers only when there are no more writers waiting.
+  void wake_writer_or_readers(FutexWordType s) {
+    if (s == WRITERS_WAITING) {
+      if (state.compare_exchange_strong(s, 0)) {
+        wake_writer();
+        return;
+      }
+    }
+    if (s == (READERS_WAITING | WRITERS_WAITING)) {
+      if (!state.compare_exchange_strong(s, READERS_WAITING))
+        return;
+      if (wake_writer())
+        return;
+      // No writer was actually waiting any more, so wake up the readers.
+      s = READERS_WAITING;
+    }
+    if (s == READERS_WAITING && state.compare_exchange_strong(s, 0))
+      __llvm_libc::syscall_impl(SYS_futex, &state.val, FUTEX_WAKE_PRIVATE,
+                                INT_MAX, 0, 0, 0);
+  }
+
+public:
+  constexpr RwLock() : state(0), writer_notify(0) {}
+
+  static MutexError init(RwLock *rwlock) {
+    rwlock->state.set(0);
+    rwlock->writer_notify.set(0);
+    return MutexError::NONE;
+  }
+
+  static MutexError destroy(RwLock *) { return MutexError::NONE; }
+
+  // Returns MutexError::BUSY if the maximum number of readers was reached.
+  MutexError read_lock() {
+    FutexWordType s = state.load(cpp::MemoryOrder::RELAXED);
+    if (is_read_lockable(s) &&
+        state.compare_exchange_strong(s, s + READ_LOCKED))
+      return MutexError::NONE;
+    return read_lock_contended();
+  }
+
+  MutexError try_read_lock() {
+    FutexWordType s = state.load(cpp::MemoryOrder::RELAXED);
+    while (is_read_lockable(s)) {
+      if (state.compare_exchange_strong(s, s + READ_LOCKED))
+        return MutexError::NONE;
+    }
+    return MutexError::BUSY;
+  }
+
+  MutexError write_lock() {
+    FutexWordType s = 0;
+    if (!state.compare_exchange_strong(s, WRITE_LOCKED))
+      write_lock_contended();
+    return MutexError::NONE;
+  }
+
+  MutexError try_write_lock() {
+    FutexWordType s = state.load(cpp::MemoryOrder::RELAXED);
+    while (is_unlocked(s)) {
+      if (state.compare_exchange_strong(s, s | WRITE_LOCKED))
+        return MutexError::NONE;
+    }
+    return MutexError::BUSY;
+  }
+
+  // Releases the lock, whether it is owned by a writer or by readers.
+  MutexError unlock() {
+    FutexWordType s = state.load(cpp::MemoryOrder::RELAXED);
+    if (is_unlocked(s))
+      return MutexError::UNLOCK_WITHOUT_LOCK;
+
+    if (is_write_locked(s)) {
+      s = state.fetch_sub(WRITE_LOCKED) - WRITE_LOCKED;
+      if (has_readers_waiting(s) || has_writers_waiting(s))
+        wake_writer_or_readers(s);
+      return MutexError::NONE;
+    }
+
+    s = state.fetch_sub(READ_LOCKED) - READ_LOCKED;
+    // Readers only wait on a read locked lock if a writer is waiting too, so
+    // the last reader has to wake up a writer.
+    if (is_unlocked(s) && has_writers_waiting(s))
+      wake_writer_or_readers(s);
+    return MutexError::NONE;
+  }
+};
+
+} // namespace __llvm_libc
+
+#endif // LLVM_LIBC_SRC_SUPPORT_THREADS_LINUX_RWLOCK_H
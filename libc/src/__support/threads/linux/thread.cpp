@@ -15,6 +15,7 @@
 #include "src/__support/common.h"
 #include "src/__support/error_or.h"
 #include "src/__support/threads/linux/futex_word.h" // For FutexWordType
+#include "src/__support/threads/single_threaded.h"
 
 #ifdef LIBC_TARGET_ARCH_IS_AARCH64
 #include <arm_acle.h>
@@ -150,6 +151,10 @@ int Thread::run(ThreadStyle style, ThreadRunner runner, void *arg, void *stack,
   TLSDescriptor tls;
   init_tls(tls);
 
+  // The locks which were skipped while there was a single thread are needed
+  // from now on.
+  mark_multi_threaded();
+
   // When the new thread is spawned by the kernel, the new thread gets the
   // stack we pass to the clone syscall. However, this stack is empty and does
   // not have any local vars present in this function. Hence, one cannot
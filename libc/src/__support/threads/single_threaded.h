@@ -0,0 +1,42 @@
+//===--- Tracking of whether the process has a single thread ----*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIBC_SRC_SUPPORT_THREADS_SINGLE_THREADED_H
+#define LLVM_LIBC_SRC_SUPPORT_THREADS_SINGLE_THREADED_H
+
+#include "src/__support/CPP/atomic.h"
+#include "src/__support/macros/attributes.h"
+
+namespace __llvm_libc {
+
+// Whether the process is known to have a single thread, in which case locks
+// which only guard against the other threads of the process can be skipped.
+//
+// This starts out false since, when LLVM libc is used as an overlay, threads
+// can be created without it knowing. The startup code of the full build sets it
+// before calling main, and it is cleared for good when a thread is created.
+inline cpp::Atomic<int> single_threaded = 0;
+
+LIBC_INLINE bool is_single_threaded() {
+  return single_threaded.load(cpp::MemoryOrder::RELAXED);
+}
+
+// Called by the startup code, before anything can create a thread.
+LIBC_INLINE void mark_single_threaded() {
+  single_threaded.store(1, cpp::MemoryOrder::RELAXED);
+}
+
+// Called before creating a thread. The store is ordered before the new thread
+// starts by the thread creation itself.
+LIBC_INLINE void mark_multi_threaded() {
+  single_threaded.store(0, cpp::MemoryOrder::RELAXED);
+}
+
+} // namespace __llvm_libc
+
+#endif // LLVM_LIBC_SRC_SUPPORT_THREADS_SINGLE_THREADED_H
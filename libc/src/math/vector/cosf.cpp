@@ -0,0 +1,12 @@
+//===-- Vector variant of cosf --------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/math/cosf.h"
+#include "src/math/vector/vector_math.h"
+
+LLVM_LIBC_VECTOR_FUNCTION(cosf)
@@ -0,0 +1,74 @@
+//===-- Vector variants of the float math functions -------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// The vector variants follow the vector function ABI of the target, under
+// which compilers call them when vectorizing loops, e.g. _ZGVbN4v_expf takes
+// and returns four floats in an SSE register on x86-64. Every lane is computed
+// by the scalar function, so the results are the same, correctly rounded
+// ones.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIBC_SRC_MATH_VECTOR_VECTOR_MATH_H
+#define LLVM_LIBC_SRC_MATH_VECTOR_VECTOR_MATH_H
+
+#include "src/__support/common.h"
+#include "src/__support/macros/properties/architectures.h"
+
+#include <stddef.h>
+
+#if defined(LIBC_TARGET_ARCH_IS_X86_64)
+// 128-bit vectors, no mask, one vector argument.
+#define LLVM_LIBC_VECTOR_NAME(name) _ZGVbN4v_##name
+#elif defined(LIBC_TARGET_ARCH_IS_AARCH64)
+// Advanced SIMD, no mask, one vector argument.
+#define LLVM_LIBC_VECTOR_NAME(name) _ZGVnN4v_##name
+#endif
+
+namespace __llvm_libc::vector {
+
+constexpr size_t NUM_LANES = 4;
+typedef float Float4 __attribute__((vector_size(NUM_LANES * sizeof(float))));
+
+template <float (*Func)(float)>
+LIBC_INLINE Float4 apply_lanewise(Float4 x) {
+  Float4 result;
+  for (size_t i = 0; i < NUM_LANES; ++i)
+    result[i] = Func(x[i]);
+  return result;
+}
+
+} // namespace __llvm_libc::vector
+
+#ifdef LLVM_LIBC_VECTOR_NAME
+namespace __llvm_libc {
+
+vector::Float4 LLVM_LIBC_VECTOR_NAME(cosf)(vector::Float4 x);
+vector::Float4 LLVM_LIBC_VECTOR_NAME(exp2f)(vector::Float4 x);
+vector::Float4 LLVM_LIBC_VECTOR_NAME(expf)(vector::Float4 x);
+vector::Float4 LLVM_LIBC_VECTOR_NAME(log10f)(vector::Float4 x);
+vector::Float4 LLVM_LIBC_VECTOR_NAME(log2f)(vector::Float4 x);
+vector::Float4 LLVM_LIBC_VECTOR_NAME(logf)(vector::Float4 x);
+vector::Float4 LLVM_LIBC_VECTOR_NAME(sinf)(vector::Float4 x);
+
+} // namespace __llvm_libc
+#endif // LLVM_LIBC_VECTOR_NAME
+
+#define LLVM_LIBC_VECTOR_FUNCTION_IMPL(vector_name, name)                      \
+  namespace __llvm_libc {                                                      \
+  LLVM_LIBC_FUNCTION(vector::Float4, vector_name, (vector::Float4 x)) {        \
+    return vector::apply_lanewise<name>(x);                                    \
+  }                                                                            \
+  }
+
+// Defines the vector variant of the float function `name`, which must be
+// declared in namespace __llvm_libc, as well as its vector variant above.
+#define LLVM_LIBC_VECTOR_FUNCTION(name)                                        \
+  LLVM_LIBC_VECTOR_FUNCTION_IMPL(LLVM_LIBC_VECTOR_NAME(name), name)
+
+#endif // LLVM_LIBC_SRC_MATH_VECTOR_VECTOR_MATH_H
@@ -0,0 +1,23 @@
+//===-- Linux implementation of the pthread_cond_broadcast function -------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "pthread_cond_broadcast.h"
+
+#include "src/__support/common.h"
+#include "src/__support/threads/linux/CndVar.h"
+
+#include <pthread.h>
+
+namespace __llvm_libc {
+
+LLVM_LIBC_FUNCTION(int, pthread_cond_broadcast, (pthread_cond_t * cond)) {
+  reinterpret_cast<CndVar *>(cond)->broadcast();
+  return 0;
+}
+
+} // namespace __llvm_libc
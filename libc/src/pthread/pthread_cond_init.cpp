@@ -0,0 +1,32 @@
+//===-- Linux implementation of the pthread_cond_init function ------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "pthread_cond_init.h"
+
+#include "src/__support/common.h"
+#include "src/__support/threads/linux/CndVar.h"
+
+#include <errno.h>
+#include <pthread.h>
+
+namespace __llvm_libc {
+
+static_assert(sizeof(CndVar) <= sizeof(pthread_cond_t),
+              "The public pthread_cond_t type cannot accommodate the internal "
+              "condition variable type.");
+
+// Condition variable attributes are not supported yet, so |attr| is ignored.
+LLVM_LIBC_FUNCTION(int, pthread_cond_init,
+                   (pthread_cond_t *__restrict cond,
+                    const pthread_condattr_t *__restrict)) {
+  return CndVar::init(reinterpret_cast<CndVar *>(cond)) == thrd_success
+             ? 0
+             : EAGAIN;
+}
+
+} // namespace __llvm_libc
@@ -0,0 +1,30 @@
+//===-- Linux implementation of the pthread_cond_wait function ------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "pthread_cond_wait.h"
+
+#include "src/__support/common.h"
+#include "src/__support/threads/linux/CndVar.h"
+#include "src/__support/threads/mutex.h"
+
+#include <errno.h>
+#include <pthread.h>
+
+namespace __llvm_libc {
+
+LLVM_LIBC_FUNCTION(int, pthread_cond_wait,
+                   (pthread_cond_t *__restrict cond,
+                    pthread_mutex_t *__restrict mutex)) {
+  CndVar *cndvar = reinterpret_cast<CndVar *>(cond);
+  // Waiting fails only if |mutex| could not be unlocked, that is if it was not
+  // locked by the caller.
+  return cndvar->wait(reinterpret_cast<Mutex *>(mutex)) == thrd_success ? 0
+                                                                        : EPERM;
+}
+
+} // namespace __llvm_libc
@@ -0,0 +1,30 @@
+//===-- Linux implementation of the pthread_rwlock_init function ----------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "pthread_rwlock_init.h"
+
+#include "src/__support/common.h"
+#include "src/__support/threads/linux/rwlock.h"
+
+#include <pthread.h>
+
+namespace __llvm_libc {
+
+static_assert(sizeof(RwLock) <= sizeof(pthread_rwlock_t),
+              "The public pthread_rwlock_t type cannot accommodate the "
+              "internal reader/writer lock type.");
+
+// Reader/writer lock attributes are not supported yet, so |attr| is ignored.
+LLVM_LIBC_FUNCTION(int, pthread_rwlock_init,
+                   (pthread_rwlock_t *__restrict rwlock,
+                    const pthread_rwlockattr_t *__restrict)) {
+  RwLock::init(reinterpret_cast<RwLock *>(rwlock));
+  return 0;
+}
+
+} // namespace __llvm_libc
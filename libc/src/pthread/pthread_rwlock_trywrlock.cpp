@@ -0,0 +1,26 @@
+//===-- Linux implementation of the pthread_rwlock_trywrlock function -----===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "pthread_rwlock_trywrlock.h"
+
+#include "src/__support/common.h"
+#include "src/__support/threads/linux/rwlock.h"
+
+#include <errno.h>
+#include <pthread.h>
+
+namespace __llvm_libc {
+
+LLVM_LIBC_FUNCTION(int, pthread_rwlock_trywrlock, (pthread_rwlock_t * rwlock)) {
+  return reinterpret_cast<RwLock *>(rwlock)->try_write_lock() ==
+                 MutexError::NONE
+             ? 0
+             : EBUSY;
+}
+
+} // namespace __llvm_libc
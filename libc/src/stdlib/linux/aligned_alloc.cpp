@@ -0,0 +1,29 @@
+//===-- Linux implementation of aligned_alloc -----------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/stdlib/aligned_alloc.h"
+#include "src/__support/common.h"
+#include "src/stdlib/linux/native_allocator.h"
+
+#include <errno.h>
+
+namespace __llvm_libc {
+
+LLVM_LIBC_FUNCTION(void *, aligned_alloc, (size_t alignment, size_t size)) {
+  // The alignment must be a power of two.
+  if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+    errno = EINVAL;
+    return nullptr;
+  }
+  void *ptr = native_allocator.allocate(size, alignment, get_thread_cache());
+  if (ptr == nullptr)
+    errno = ENOMEM;
+  return ptr;
+}
+
+} // namespace __llvm_libc
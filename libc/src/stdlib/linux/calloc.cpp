@@ -0,0 +1,34 @@
+//===-- Linux implementation of calloc ------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/stdlib/calloc.h"
+#include "src/__support/common.h"
+#include "src/stdlib/linux/native_allocator.h"
+#include "src/string/memory_utils/memset_implementations.h"
+
+#include <errno.h>
+
+namespace __llvm_libc {
+
+LLVM_LIBC_FUNCTION(void *, calloc, (size_t num, size_t size)) {
+  size_t total;
+  if (__builtin_mul_overflow(num, size, &total)) {
+    errno = ENOMEM;
+    return nullptr;
+  }
+  void *ptr = native_allocator.allocate(total, SizeClassAllocator::ALIGNMENT,
+                                        get_thread_cache());
+  if (ptr == nullptr) {
+    errno = ENOMEM;
+    return nullptr;
+  }
+  inline_memset(ptr, 0, total);
+  return ptr;
+}
+
+} // namespace __llvm_libc
@@ -0,0 +1,19 @@
+//===-- Linux implementation of free --------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/stdlib/free.h"
+#include "src/__support/common.h"
+#include "src/stdlib/linux/native_allocator.h"
+
+namespace __llvm_libc {
+
+LLVM_LIBC_FUNCTION(void, free, (void *ptr)) {
+  native_allocator.deallocate(ptr, get_thread_cache());
+}
+
+} // namespace __llvm_libc
@@ -0,0 +1,25 @@
+//===-- Linux implementation of malloc ------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/stdlib/malloc.h"
+#include "src/__support/common.h"
+#include "src/stdlib/linux/native_allocator.h"
+
+#include <errno.h>
+
+namespace __llvm_libc {
+
+LLVM_LIBC_FUNCTION(void *, malloc, (size_t size)) {
+  void *ptr = native_allocator.allocate(size, SizeClassAllocator::ALIGNMENT,
+                                        get_thread_cache());
+  if (ptr == nullptr)
+    errno = ENOMEM;
+  return ptr;
+}
+
+} // namespace __llvm_libc
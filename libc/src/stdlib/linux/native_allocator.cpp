@@ -0,0 +1,62 @@
+//===-- The allocator behind malloc and friends ---------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/stdlib/linux/native_allocator.h"
+#include "src/__support/CPP/atomic.h"
+#include "src/__support/macros/optimization.h"
+#include "src/__support/threads/fork_callbacks.h"
+
+// Provided by the thread library, see src/__support/threads/thread.cpp.
+extern "C" int __cxa_thread_atexit_impl(void (*callback)(void *), void *obj,
+                                        void *);
+
+namespace __llvm_libc {
+
+SizeClassAllocator native_allocator;
+
+namespace {
+
+struct ThreadState {
+  SizeClassAllocator::ThreadCache cache;
+  bool registered = false;
+  bool drained = false;
+};
+
+} // anonymous namespace
+
+static thread_local ThreadState thread_state;
+
+// Gives the chunks of an exiting thread back to the other threads. The thread
+// keeps allocating from the central free lists afterwards, e.g. in the
+// destructors of other thread locals.
+static void drain_thread_cache(void *) {
+  thread_state.drained = true;
+  native_allocator.drain(thread_state.cache);
+}
+
+static void lock_before_fork() { native_allocator.lock_all(); }
+static void unlock_after_fork() { native_allocator.unlock_all(); }
+
+static cpp::Atomic<bool> fork_callbacks_registered(false);
+
+SizeClassAllocator::ThreadCache *get_thread_cache() {
+  if (LIBC_UNLIKELY(!thread_state.registered)) {
+    thread_state.registered = true;
+    // The callbacks are registered by the first allocation of the process, so
+    // the prepare callbacks registered later run before the allocator is
+    // locked, and may allocate.
+    if (!fork_callbacks_registered.exchange(true))
+      register_atfork_callbacks(lock_before_fork, unlock_after_fork,
+                                unlock_after_fork);
+    if (__cxa_thread_atexit_impl(drain_thread_cache, nullptr, nullptr) != 0)
+      thread_state.drained = true;
+  }
+  return thread_state.drained ? nullptr : &thread_state.cache;
+}
+
+} // namespace __llvm_libc
@@ -0,0 +1,24 @@
+//===-- The allocator behind malloc and friends -----------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIBC_SRC_STDLIB_LINUX_NATIVE_ALLOCATOR_H
+#define LLVM_LIBC_SRC_STDLIB_LINUX_NATIVE_ALLOCATOR_H
+
+#include "src/stdlib/linux/size_class_allocator.h"
+
+namespace __llvm_libc {
+
+extern SizeClassAllocator native_allocator;
+
+// Returns the cache of the calling thread, or nullptr once the thread's
+// atexit callbacks drained it.
+SizeClassAllocator::ThreadCache *get_thread_cache();
+
+} // namespace __llvm_libc
+
+#endif // LLVM_LIBC_SRC_STDLIB_LINUX_NATIVE_ALLOCATOR_H
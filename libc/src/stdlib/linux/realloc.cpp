@@ -0,0 +1,24 @@
+//===-- Linux implementation of realloc -----------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/stdlib/realloc.h"
+#include "src/__support/common.h"
+#include "src/stdlib/linux/native_allocator.h"
+
+#include <errno.h>
+
+namespace __llvm_libc {
+
+LLVM_LIBC_FUNCTION(void *, realloc, (void *ptr, size_t size)) {
+  void *new_ptr = native_allocator.reallocate(ptr, size, get_thread_cache());
+  if (new_ptr == nullptr)
+    errno = ENOMEM;
+  return new_ptr;
+}
+
+} // namespace __llvm_libc
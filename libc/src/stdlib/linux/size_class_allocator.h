@@ -0,0 +1,369 @@
+//===-- A general purpose allocator with thread caches ----------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIBC_SRC_STDLIB_LINUX_SIZE_CLASS_ALLOCATOR_H
+#define LLVM_LIBC_SRC_STDLIB_LINUX_SIZE_CLASS_ALLOCATOR_H
+
+#include "src/__support/OSUtil/syscall.h" // For internal syscall function.
+#include "src/__support/common.h"
+#include "src/__support/macros/optimization.h"
+#include "src/__support/threads/mutex.h"
+#include "src/string/memory_utils/memcpy_implementations.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/mman.h>    // For PROT_* and MAP_* definitions.
+#include <sys/syscall.h> // For syscall numbers.
+
+namespace __llvm_libc {
+
+// The small allocations are rounded up to one of NUM_CLASSES size classes,
+// and carved out of runs of RUN_SIZE bytes holding chunks of a single size
+// class. Every thread keeps a few free chunks of each size class in a
+// ThreadCache, so that most allocations and deallocations don't need any
+// synchronization. The central free lists of the size classes, which the
+// thread caches are refilled from and drained to, are guarded by a mutex per
+// size class. The large allocations get a mapping of their own.
+//
+// Both the runs and the mappings of the large allocations start with a
+// RunHeader, at an address aligned to RUN_SIZE. The header of any pointer
+// returned by the allocator is found by rounding it down to RUN_SIZE, so the
+// chunks themselves have no header.
+class SizeClassAllocator {
+public:
+  // The alignment of all the allocations.
+  static constexpr size_t ALIGNMENT = 16;
+  static constexpr size_t RUN_SIZE = size_t(1) << 18;
+  // The largest allocation served from a size class.
+  static constexpr size_t MAX_SMALL_SIZE = size_t(1) << 15;
+  // 8 size classes of 16 to 128 bytes, then 4 per power of two.
+  static constexpr unsigned NUM_CLASSES = 40;
+
+  struct FreeChunk {
+    FreeChunk *next;
+  };
+
+  // The free chunks owned by a thread.
+  struct ThreadCache {
+    FreeChunk *chunks[NUM_CLASSES] = {};
+    unsigned counts[NUM_CLASSES] = {};
+  };
+
+  constexpr SizeClassAllocator() = default;
+
+  LIBC_INLINE static constexpr unsigned size_to_class(size_t size) {
+    if (size <= 128)
+      return size <= 16 ? 0 : unsigned((size - 1) / 16);
+    const unsigned log = 63 - __builtin_clzll(size - 1);
+    return 8 + (log - 7) * 4 + unsigned(((size - 1) >> (log - 2)) & 3);
+  }
+
+  LIBC_INLINE static constexpr size_t class_to_size(unsigned class_id) {
+    if (class_id < 8)
+      return (class_id + 1) * 16;
+    const unsigned log = 7 + (class_id - 8) / 4;
+    return (size_t(1) << log) +
+           ((class_id - 8) % 4 + 1) * (size_t(1) << (log - 2));
+  }
+
+  // Returns a block of at least `size` bytes aligned to `alignment`, which
+  // must be a power of two, or nullptr if there is not enough memory. The
+  // `cache` of the calling thread may be null, e.g. once it was drained.
+  LIBC_INLINE void *allocate(size_t size, size_t alignment,
+                             ThreadCache *cache) {
+    if (size == 0)
+      size = 1;
+    if (alignment < ALIGNMENT)
+      alignment = ALIGNMENT;
+    // The chunks are only aligned to ALIGNMENT, so make room for aligning the
+    // block within the chunk.
+    size_t needed = size + (alignment - ALIGNMENT);
+    if (needed < size)
+      return nullptr;
+    if (needed > MAX_SMALL_SIZE)
+      return allocate_large(size, alignment);
+
+    void *chunk = allocate_chunk(size_to_class(needed), cache);
+    if (LIBC_UNLIKELY(chunk == nullptr))
+      return nullptr;
+    return reinterpret_cast<void *>(align_up(uintptr_t(chunk), alignment));
+  }
+
+  LIBC_INLINE void deallocate(void *ptr, ThreadCache *cache) {
+    if (ptr == nullptr)
+      return;
+    RunHeader *run = get_run(ptr);
+    if (run->large) {
+      unmap(reinterpret_cast<void *>(run->map_base), run->map_size);
+      return;
+    }
+    deallocate_chunk(run->class_id, get_chunk(run, ptr), cache);
+  }
+
+  // Returns the number of bytes usable from `ptr`, which must have been
+  // returned by the allocator.
+  LIBC_INLINE size_t usable_size(void *ptr) {
+    RunHeader *run = get_run(ptr);
+    if (run->large)
+      return run->map_base + run->map_size - uintptr_t(ptr);
+    return uintptr_t(get_chunk(run, ptr)) + class_to_size(run->class_id) -
+           uintptr_t(ptr);
+  }
+
+  LIBC_INLINE void *reallocate(void *ptr, size_t size, ThreadCache *cache) {
+    if (ptr == nullptr)
+      return allocate(size, ALIGNMENT, cache);
+    // Keep the block if it's large enough, unless it's a large allocation
+    // which would be mostly unused.
+    const size_t usable = usable_size(ptr);
+    if (size <= usable && (usable <= MAX_SMALL_SIZE || size > usable / 2))
+      return ptr;
+    void *new_ptr = allocate(size, ALIGNMENT, cache);
+    if (new_ptr == nullptr)
+      return nullptr;
+    inline_memcpy(new_ptr, ptr, size < usable ? size : usable);
+    deallocate(ptr, cache);
+    return new_ptr;
+  }
+
+  // Returns all the chunks of `cache` to the central free lists.
+  LIBC_INLINE void drain(ThreadCache &cache) {
+    for (unsigned class_id = 0; class_id < NUM_CLASSES; ++class_id)
+      drain(cache, class_id, cache.counts[class_id]);
+  }
+
+  // Takes all the locks of the allocator, before a fork, so that the child
+  // doesn't inherit a lock held by another thread of the parent.
+  LIBC_INLINE void lock_all() {
+    // The region lock is taken with a size class lock held, see refill.
+    for (SizeClass &sc : classes)
+      sc.lock.lock();
+    region_lock.lock();
+  }
+
+  // Releases the locks taken by lock_all, in the parent and in the child.
+  LIBC_INLINE void unlock_all() {
+    region_lock.unlock();
+    for (SizeClass &sc : classes)
+      sc.lock.unlock();
+  }
+
+private:
+  struct RunHeader {
+    // Whether this is the mapping of a large allocation instead of a run.
+    bool large;
+    unsigned class_id;
+    // The mapping of a large allocation.
+    uintptr_t map_base;
+    size_t map_size;
+  };
+  // The offset of the first chunk of a run.
+  static constexpr size_t RUN_HEADER_SIZE =
+      (sizeof(RunHeader) + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+  // The granularity of the mappings, which is a multiple of the page size.
+  static constexpr size_t MAP_GRANULE = size_t(1) << 16;
+  // The size of the mappings the runs are carved from.
+  static constexpr size_t REGION_SIZE = RUN_SIZE * 32;
+
+  struct SizeClass {
+    Mutex lock{/*istimed=*/false, /*isrecursive=*/false, /*isrobust=*/false};
+    FreeChunk *free_list = nullptr;
+    // The part of the current run which was never allocated.
+    uintptr_t run_next = 0;
+    uintptr_t run_end = 0;
+  };
+
+  SizeClass classes[NUM_CLASSES];
+  Mutex region_lock{/*istimed=*/false, /*isrecursive=*/false,
+                    /*isrobust=*/false};
+  uintptr_t region_next = 0;
+  uintptr_t region_end = 0;
+
+  LIBC_INLINE static constexpr uintptr_t align_up(uintptr_t value,
+                                                  size_t alignment) {
+    return (value + alignment - 1) & ~uintptr_t(alignment - 1);
+  }
+
+  // The number of chunks of a size class a thread cache holds at most, and
+  // moves from or to the central free list at once.
+  LIBC_INLINE static constexpr unsigned max_cached(unsigned class_id) {
+    const size_t count = (RUN_SIZE / 8) / class_to_size(class_id);
+    return count < 4 ? 4 : count > 64 ? 64 : unsigned(count);
+  }
+
+  LIBC_INLINE static RunHeader *get_run(void *ptr) {
+    // Blocks never start at the beginning of a run, which holds its header.
+    return reinterpret_cast<RunHeader *>((uintptr_t(ptr) - 1) &
+                                         ~uintptr_t(RUN_SIZE - 1));
+  }
+
+  LIBC_INLINE static FreeChunk *get_chunk(RunHeader *run, void *ptr) {
+    const uintptr_t first = uintptr_t(run) + RUN_HEADER_SIZE;
+    const size_t size = class_to_size(run->class_id);
+    return reinterpret_cast<FreeChunk *>(
+        first + (uintptr_t(ptr) - first) / size * size);
+  }
+
+  LIBC_INLINE static void *map(size_t size) {
+#ifdef SYS_mmap2
+    constexpr long MMAP_SYSCALL_NUMBER = SYS_mmap2;
+#else
+    constexpr long MMAP_SYSCALL_NUMBER = SYS_mmap;
+#endif
+    long result = __llvm_libc::syscall_impl(
+        MMAP_SYSCALL_NUMBER, 0, size, PROT_READ | PROT_WRITE,
+        MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+    if (result < 0 && uintptr_t(result) >= UINTPTR_MAX - size)
+      return nullptr;
+    return reinterpret_cast<void *>(result);
+  }
+
+  LIBC_INLINE static void unmap(void *ptr, size_t size) {
+    __llvm_libc::syscall_impl(SYS_munmap, ptr, size);
+  }
+
+  // Maps `size` bytes at an address aligned to `alignment`, both multiples of
+  // MAP_GRANULE.
+  LIBC_INLINE static uintptr_t map_aligned(size_t size, size_t alignment) {
+    if (size + alignment < size)
+      return 0;
+    void *mapping = map(size + alignment);
+    if (mapping == nullptr)
+      return 0;
+    const uintptr_t begin = uintptr_t(mapping);
+    const uintptr_t base = align_up(begin, alignment);
+    if (base != begin)
+      unmap(mapping, base - begin);
+    if (base + size != begin + size + alignment)
+      unmap(reinterpret_cast<void *>(base + size), begin + alignment - base);
+    return base;
+  }
+
+  LIBC_INLINE void *allocate_large(size_t size, size_t alignment) {
+    const size_t offset = align_up(RUN_HEADER_SIZE, alignment);
+    const size_t map_size = align_up(offset + size, MAP_GRANULE);
+    if (offset + size < size || map_size < offset + size)
+      return nullptr;
+    const uintptr_t base =
+        map_aligned(map_size, alignment > RUN_SIZE ? alignment : RUN_SIZE);
+    if (base == 0)
+      return nullptr;
+    // With an alignment larger than RUN_SIZE, the header isn't at the start
+    // of the mapping but right below the block.
+    void *ptr = reinterpret_cast<void *>(base + offset);
+    RunHeader *run = get_run(ptr);
+    run->large = true;
+    run->class_id = 0;
+    run->map_base = base;
+    run->map_size = map_size;
+    return ptr;
+  }
+
+  // Returns a new run, with its header set for the size class.
+  LIBC_INLINE RunHeader *allocate_run(unsigned class_id) {
+    MutexLock lock(&region_lock);
+    if (region_next == region_end) {
+      const uintptr_t region = map_aligned(REGION_SIZE, RUN_SIZE);
+      if (region == 0)
+        return nullptr;
+      region_next = region;
+      region_end = region + REGION_SIZE;
+    }
+    RunHeader *run = reinterpret_cast<RunHeader *>(region_next);
+    region_next += RUN_SIZE;
+    run->large = false;
+    run->class_id = class_id;
+    return run;
+  }
+
+  // Moves up to `count` chunks from the central free list, or from a run, to
+  // `list`, and returns how many were moved.
+  LIBC_INLINE unsigned refill(unsigned class_id, FreeChunk *&list,
+                              unsigned count) {
+    SizeClass &sc = classes[class_id];
+    const size_t size = class_to_size(class_id);
+    MutexLock lock(&sc.lock);
+    unsigned moved = 0;
+    for (; moved < count && sc.free_list; ++moved) {
+      FreeChunk *chunk = sc.free_list;
+      sc.free_list = chunk->next;
+      chunk->next = list;
+      list = chunk;
+    }
+    for (; moved < count; ++moved) {
+      if (sc.run_next + size > sc.run_end) {
+        RunHeader *run = allocate_run(class_id);
+        if (run == nullptr)
+          break;
+        sc.run_next = uintptr_t(run) + RUN_HEADER_SIZE;
+        sc.run_end = uintptr_t(run) + RUN_SIZE;
+      }
+      FreeChunk *chunk = reinterpret_cast<FreeChunk *>(sc.run_next);
+      sc.run_next += size;
+      chunk->next = list;
+      list = chunk;
+    }
+    return moved;
+  }
+
+  // Moves `count` chunks of `cache` to the central free list.
+  LIBC_INLINE void drain(ThreadCache &cache, unsigned class_id,
+                         unsigned count) {
+    if (count == 0)
+      return;
+    FreeChunk *first = cache.chunks[class_id];
+    FreeChunk *last = first;
+    for (unsigned i = 1; i < count; ++i)
+      last = last->next;
+    cache.chunks[class_id] = last->next;
+    cache.counts[class_id] -= count;
+
+    SizeClass &sc = classes[class_id];
+    MutexLock lock(&sc.lock);
+    last->next = sc.free_list;
+    sc.free_list = first;
+  }
+
+  LIBC_INLINE void *allocate_chunk(unsigned class_id, ThreadCache *cache) {
+    if (LIBC_UNLIKELY(cache == nullptr)) {
+      FreeChunk *list = nullptr;
+      refill(class_id, list, 1);
+      return list;
+    }
+    FreeChunk *chunk = cache->chunks[class_id];
+    if (LIBC_UNLIKELY(chunk == nullptr)) {
+      cache->counts[class_id] =
+          refill(class_id, cache->chunks[class_id], max_cached(class_id) / 2);
+      chunk = cache->chunks[class_id];
+      if (chunk == nullptr)
+        return nullptr;
+    }
+    cache->chunks[class_id] = chunk->next;
+    --cache->counts[class_id];
+    return chunk;
+  }
+
+  LIBC_INLINE void deallocate_chunk(unsigned class_id, FreeChunk *chunk,
+                                    ThreadCache *cache) {
+    if (LIBC_UNLIKELY(cache == nullptr)) {
+      SizeClass &sc = classes[class_id];
+      MutexLock lock(&sc.lock);
+      chunk->next = sc.free_list;
+      sc.free_list = chunk;
+      return;
+    }
+    chunk->next = cache->chunks[class_id];
+    cache->chunks[class_id] = chunk;
+    if (LIBC_UNLIKELY(++cache->counts[class_id] > max_cached(class_id)))
+      drain(*cache, class_id, max_cached(class_id) / 2);
+  }
+};
+
+} // namespace __llvm_libc
+
+#endif // LLVM_LIBC_SRC_STDLIB_LINUX_SIZE_CLASS_ALLOCATOR_H
@@ -55,9 +55,16 @@ inline_memcpy_x86(Ptr __restrict dst, CPtr __restrict src, size_t count) {
     return builtin::Memcpy<64>::head_tail(dst, src, count);
   if (x86::kAvx && count < 256)
     return builtin::Memcpy<128>::head_tail(dst, src, count);
-  builtin::Memcpy<32>::block(dst, src);
-  align_to_next_boundary<32, Arg::Dst>(dst, src, count);
-  static constexpr size_t kBlockSize = x86::kAvx ? 64 : 32;
+  if (x86::kAvx512F && count < 512)
+    return builtin::Memcpy<256>::head_tail(dst, src, count);
+  // With 64-byte registers every unaligned store splits a cache line, so align
+  // the destination to the register size.
+  static constexpr size_t kAlignment = x86::kAvx512F ? 64 : 32;
+  builtin::Memcpy<kAlignment>::block(dst, src);
+  align_to_next_boundary<kAlignment, Arg::Dst>(dst, src, count);
+  static constexpr size_t kBlockSize = x86::kAvx512F ? 128
+                                       : x86::kAvx   ? 64
+                                                     : 32;
   return builtin::Memcpy<kBlockSize>::loop_and_tail(dst, src, count);
 }
 
@@ -92,6 +99,9 @@ inline_memcpy_x86_maybe_interpose_repmovsb(Ptr __restrict dst,
 #if defined(LIBC_TARGET_ARCH_IS_AARCH64)
 [[maybe_unused]] LIBC_INLINE void
 inline_memcpy_aarch64(Ptr __restrict dst, CPtr __restrict src, size_t count) {
+  if constexpr (aarch64::kSve)
+    if (count <= 2 * aarch64::sve::vector_length())
+      return aarch64::sve::Memcpy::upto_two_vectors(dst, src, count);
   if (count == 0)
     return;
   if (count == 1)
@@ -77,6 +77,11 @@ LIBC_INLINE void inline_memmove(Ptr dst, CPtr src, size_t count) {
   static constexpr size_t kMaxSize = aarch64::kNeon ? 16 : 8;
 #endif
   // return inline_memmove_generic<kMaxSize>(dst, src, count);
+#if defined(LIBC_TARGET_ARCH_IS_AARCH64)
+  if constexpr (aarch64::kSve)
+    if (count <= 2 * aarch64::sve::vector_length())
+      return aarch64::sve::Memcpy::upto_two_vectors(dst, src, count);
+#endif
   if (count == 0)
     return;
   if (count == 1)
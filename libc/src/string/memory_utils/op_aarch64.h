@@ -23,10 +23,50 @@
 #ifdef __ARM_NEON
 #include <arm_neon.h>
 #endif //__ARM_NEON
+#ifdef __ARM_FEATURE_SVE
+#include <arm_sve.h>
+#endif //__ARM_FEATURE_SVE
 
 namespace __llvm_libc::aarch64 {
 
 static inline constexpr bool kNeon = LLVM_LIBC_IS_DEFINED(__ARM_NEON);
+static inline constexpr bool kSve = LLVM_LIBC_IS_DEFINED(__ARM_FEATURE_SVE);
+
+namespace sve {
+
+// The size in bytes of an SVE vector, only known at runtime.
+LIBC_INLINE static size_t vector_length() {
+#ifdef __ARM_FEATURE_SVE
+  return svcntb();
+#else
+  return 0;
+#endif
+}
+
+struct Memcpy {
+  // Copies up to two vector lengths with predicated loads and stores, which
+  // handles all the small sizes without branching on `count`. Both vectors are
+  // loaded before anything is stored, so the buffers may overlap.
+  LIBC_INLINE static void upto_two_vectors(Ptr dst, CPtr src, size_t count) {
+#ifdef __ARM_FEATURE_SVE
+    const auto *src8 = reinterpret_cast<const uint8_t *>(src);
+    auto *dst8 = reinterpret_cast<uint8_t *>(dst);
+    const svbool_t lo = svwhilelt_b8_u64(0, count);
+    const svbool_t hi = svwhilelt_b8_u64(svcntb(), count);
+    const svuint8_t v0 = svld1_u8(lo, src8);
+    const svuint8_t v1 = svld1_vnum_u8(hi, src8, 1);
+    svst1_u8(lo, dst8, v0);
+    svst1_vnum_u8(hi, dst8, 1, v1);
+#else
+    // Only called when `kSve` is true.
+    (void)dst;
+    (void)src;
+    (void)count;
+#endif
+  }
+};
+
+} // namespace sve
 
 namespace neon {
 
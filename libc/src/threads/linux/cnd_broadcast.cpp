@@ -6,7 +6,7 @@
 //
 //===----------------------------------------------------------------------===//
 
-#include "CndVar.h"
+#include "src/__support/threads/linux/CndVar.h"
 
 #include "src/threads/cnd_broadcast.h"
 #include "src/__support/common.h"
@@ -8,6 +8,7 @@
 
 #include "config/linux/app.h"
 #include "src/__support/OSUtil/syscall.h"
+#include "src/__support/threads/single_threaded.h"
 #include "src/__support/threads/thread.h"
 #include "src/stdlib/atexit.h"
 #include "src/stdlib/exit.h"
@@ -190,6 +191,7 @@ __attribute__((noinline)) static void do_start() {
     __llvm_libc::set_thread_ptr(tls.tp);
 
   __llvm_libc::self.attrib = &__llvm_libc::main_thread_attrib;
+  __llvm_libc::mark_single_threaded();
   __llvm_libc::main_thread_attrib.atexit_callback_mgr =
       __llvm_libc::internal::get_thread_atexit_callback_mgr();
 
@@ -8,6 +8,7 @@
 
 #include "config/linux/app.h"
 #include "src/__support/OSUtil/syscall.h"
+#include "src/__support/threads/single_threaded.h"
 #include "src/__support/threads/thread.h"
 #include "src/stdlib/atexit.h"
 #include "src/stdlib/exit.h"
@@ -210,6 +211,7 @@ extern "C" void _start() {
     __llvm_libc::syscall_impl(SYS_exit, 1);
 
   __llvm_libc::self.attrib = &__llvm_libc::main_thread_attrib;
+  __llvm_libc::mark_single_threaded();
   __llvm_libc::main_thread_attrib.atexit_callback_mgr =
       __llvm_libc::internal::get_thread_atexit_callback_mgr();
 
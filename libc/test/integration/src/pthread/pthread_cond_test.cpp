@@ -0,0 +1,145 @@
+//===-- Tests for pthread_cond_t ------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/pthread/pthread_cond_broadcast.h"
+#include "src/pthread/pthread_cond_destroy.h"
+#include "src/pthread/pthread_cond_init.h"
+#include "src/pthread/pthread_cond_signal.h"
+#include "src/pthread/pthread_cond_wait.h"
+#include "src/pthread/pthread_mutex_destroy.h"
+#include "src/pthread/pthread_mutex_init.h"
+#include "src/pthread/pthread_mutex_lock.h"
+#include "src/pthread/pthread_mutex_unlock.h"
+
+#include "src/pthread/pthread_create.h"
+#include "src/pthread/pthread_join.h"
+
+#include "test/IntegrationTest/test.h"
+
+#include <pthread.h>
+#include <stdint.h> // uintptr_t
+
+constexpr int THREAD_COUNT = 16;
+constexpr int ROUNDS = 200;
+
+pthread_mutex_t mutex;
+pthread_cond_t round_cond;
+pthread_cond_t ready_cond;
+// The current round, and the number of threads waiting for the next one. Both
+// are protected by |mutex|.
+static int current_round = 0;
+static int waiting = 0;
+
+void *broadcast_waiter(void *) {
+  __llvm_libc::pthread_mutex_lock(&mutex);
+  for (int r = 0; r < ROUNDS; ++r) {
+    if (++waiting == THREAD_COUNT)
+      __llvm_libc::pthread_cond_signal(&ready_cond);
+    // The waiters of a round wait again in the next one, reusing the same
+    // stack space, while the broadcast of the round may still be handing
+    // them over to each other.
+    while (current_round == r)
+      __llvm_libc::pthread_cond_wait(&round_cond, &mutex);
+  }
+  __llvm_libc::pthread_mutex_unlock(&mutex);
+  return nullptr;
+}
+
+void broadcast_test() {
+  ASSERT_EQ(__llvm_libc::pthread_mutex_init(&mutex, nullptr), 0);
+  ASSERT_EQ(__llvm_libc::pthread_cond_init(&round_cond, nullptr), 0);
+  ASSERT_EQ(__llvm_libc::pthread_cond_init(&ready_cond, nullptr), 0);
+
+  pthread_t threads[THREAD_COUNT];
+  for (pthread_t &thread : threads)
+    __llvm_libc::pthread_create(&thread, nullptr, broadcast_waiter, nullptr);
+
+  // Each round only starts once all of the threads wait for it, so all of
+  // them are woken up by the same broadcast.
+  __llvm_libc::pthread_mutex_lock(&mutex);
+  for (int r = 0; r < ROUNDS; ++r) {
+    while (waiting != THREAD_COUNT)
+      __llvm_libc::pthread_cond_wait(&ready_cond, &mutex);
+    waiting = 0;
+    ++current_round;
+    ASSERT_EQ(__llvm_libc::pthread_cond_broadcast(&round_cond), 0);
+  }
+  __llvm_libc::pthread_mutex_unlock(&mutex);
+
+  for (pthread_t &thread : threads) {
+    void *retval = reinterpret_cast<void *>(123);
+    __llvm_libc::pthread_join(thread, &retval);
+    ASSERT_EQ(uintptr_t(retval), uintptr_t(nullptr));
+  }
+  ASSERT_EQ(current_round, ROUNDS);
+
+  // Broadcasting or signalling without waiters does nothing.
+  ASSERT_EQ(__llvm_libc::pthread_cond_broadcast(&round_cond), 0);
+  ASSERT_EQ(__llvm_libc::pthread_cond_signal(&round_cond), 0);
+
+  ASSERT_EQ(__llvm_libc::pthread_cond_destroy(&round_cond), 0);
+  ASSERT_EQ(__llvm_libc::pthread_cond_destroy(&ready_cond), 0);
+  ASSERT_EQ(__llvm_libc::pthread_mutex_destroy(&mutex), 0);
+}
+
+constexpr int ITEMS = 10000;
+
+pthread_cond_t item_cond;
+pthread_cond_t space_cond;
+// A single slot buffer, protected by |mutex|.
+static bool full = false;
+static int item = 0;
+
+void *consumer(void *) {
+  int sum = 0;
+  __llvm_libc::pthread_mutex_lock(&mutex);
+  for (int i = 0; i < ITEMS; ++i) {
+    while (!full)
+      __llvm_libc::pthread_cond_wait(&item_cond, &mutex);
+    sum += item;
+    full = false;
+    __llvm_libc::pthread_cond_signal(&space_cond);
+  }
+  __llvm_libc::pthread_mutex_unlock(&mutex);
+  return reinterpret_cast<void *>(uintptr_t(sum));
+}
+
+void signal_test() {
+  ASSERT_EQ(__llvm_libc::pthread_mutex_init(&mutex, nullptr), 0);
+  ASSERT_EQ(__llvm_libc::pthread_cond_init(&item_cond, nullptr), 0);
+  ASSERT_EQ(__llvm_libc::pthread_cond_init(&space_cond, nullptr), 0);
+
+  pthread_t thread;
+  __llvm_libc::pthread_create(&thread, nullptr, consumer, nullptr);
+
+  int sum = 0;
+  __llvm_libc::pthread_mutex_lock(&mutex);
+  for (int i = 0; i < ITEMS; ++i) {
+    while (full)
+      __llvm_libc::pthread_cond_wait(&space_cond, &mutex);
+    item = i % 7;
+    sum += item;
+    full = true;
+    __llvm_libc::pthread_cond_signal(&item_cond);
+  }
+  __llvm_libc::pthread_mutex_unlock(&mutex);
+
+  void *retval = nullptr;
+  __llvm_libc::pthread_join(thread, &retval);
+  ASSERT_EQ(uintptr_t(retval), uintptr_t(sum));
+
+  ASSERT_EQ(__llvm_libc::pthread_cond_destroy(&item_cond), 0);
+  ASSERT_EQ(__llvm_libc::pthread_cond_destroy(&space_cond), 0);
+  ASSERT_EQ(__llvm_libc::pthread_mutex_destroy(&mutex), 0);
+}
+
+TEST_MAIN() {
+  broadcast_test();
+  signal_test();
+  return 0;
+}
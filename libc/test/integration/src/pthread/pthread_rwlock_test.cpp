@@ -0,0 +1,99 @@
+//===-- Tests for pthread_rwlock_t ----------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/pthread/pthread_rwlock_destroy.h"
+#include "src/pthread/pthread_rwlock_init.h"
+#include "src/pthread/pthread_rwlock_rdlock.h"
+#include "src/pthread/pthread_rwlock_tryrdlock.h"
+#include "src/pthread/pthread_rwlock_trywrlock.h"
+#include "src/pthread/pthread_rwlock_unlock.h"
+#include "src/pthread/pthread_rwlock_wrlock.h"
+
+#include "src/pthread/pthread_create.h"
+#include "src/pthread/pthread_join.h"
+
+#include "src/__support/CPP/atomic.h"
+
+#include "test/IntegrationTest/test.h"
+
+#include <errno.h>
+#include <pthread.h>
+
+void try_lock_test() {
+  pthread_rwlock_t rwlock;
+  ASSERT_EQ(__llvm_libc::pthread_rwlock_init(&rwlock, nullptr), 0);
+
+  // Any number of readers can own the lock, but no writer.
+  ASSERT_EQ(__llvm_libc::pthread_rwlock_rdlock(&rwlock), 0);
+  ASSERT_EQ(__llvm_libc::pthread_rwlock_tryrdlock(&rwlock), 0);
+  ASSERT_EQ(__llvm_libc::pthread_rwlock_trywrlock(&rwlock), EBUSY);
+  ASSERT_EQ(__llvm_libc::pthread_rwlock_unlock(&rwlock), 0);
+  ASSERT_EQ(__llvm_libc::pthread_rwlock_trywrlock(&rwlock), EBUSY);
+  ASSERT_EQ(__llvm_libc::pthread_rwlock_unlock(&rwlock), 0);
+
+  // A writer owns the lock exclusively.
+  ASSERT_EQ(__llvm_libc::pthread_rwlock_wrlock(&rwlock), 0);
+  ASSERT_EQ(__llvm_libc::pthread_rwlock_tryrdlock(&rwlock), EBUSY);
+  ASSERT_EQ(__llvm_libc::pthread_rwlock_trywrlock(&rwlock), EBUSY);
+  ASSERT_EQ(__llvm_libc::pthread_rwlock_unlock(&rwlock), 0);
+
+  ASSERT_EQ(__llvm_libc::pthread_rwlock_unlock(&rwlock), EPERM);
+  ASSERT_EQ(__llvm_libc::pthread_rwlock_destroy(&rwlock), 0);
+}
+
+constexpr int THREAD_COUNT = 8;
+constexpr int ITERATIONS = 10000;
+
+pthread_rwlock_t rwlock;
+// Both counters are only updated together by the writers, so the readers
+// should always see them equal.
+static int counter_a = 0;
+static int counter_b = 0;
+static __llvm_libc::cpp::Atomic<int> mismatches(0);
+
+void *reader_writer(void *arg) {
+  // Every thread is mostly a reader, and a writer one time out of eight.
+  for (int i = 0; i < ITERATIONS; ++i) {
+    if (i % 8 == 0) {
+      __llvm_libc::pthread_rwlock_wrlock(&rwlock);
+      ++counter_a;
+      ++counter_b;
+      __llvm_libc::pthread_rwlock_unlock(&rwlock);
+    } else {
+      __llvm_libc::pthread_rwlock_rdlock(&rwlock);
+      if (counter_a != counter_b)
+        mismatches.fetch_add(1);
+      __llvm_libc::pthread_rwlock_unlock(&rwlock);
+    }
+  }
+  return nullptr;
+}
+
+void contention_test() {
+  ASSERT_EQ(__llvm_libc::pthread_rwlock_init(&rwlock, nullptr), 0);
+
+  pthread_t threads[THREAD_COUNT];
+  for (pthread_t &thread : threads)
+    __llvm_libc::pthread_create(&thread, nullptr, reader_writer, nullptr);
+  for (pthread_t &thread : threads) {
+    void *retval = reinterpret_cast<void *>(123);
+    __llvm_libc::pthread_join(thread, &retval);
+    ASSERT_EQ(uintptr_t(retval), uintptr_t(nullptr));
+  }
+
+  ASSERT_EQ(mismatches.load(), 0);
+  ASSERT_EQ(counter_a, THREAD_COUNT * ITERATIONS / 8);
+  ASSERT_EQ(counter_b, THREAD_COUNT * ITERATIONS / 8);
+  __llvm_libc::pthread_rwlock_destroy(&rwlock);
+}
+
+TEST_MAIN() {
+  try_lock_test();
+  contention_test();
+  return 0;
+}
@@ -27,22 +27,25 @@ class StringFile : public File {
   char str[SIZE] = {0};
   size_t eof_marker;
   bool write_append;
+  size_t num_writes;
 
   static FileIOResult str_read(__llvm_libc::File *f, void *data, size_t len);
   static FileIOResult str_write(__llvm_libc::File *f, const void *data,
                                 size_t len);
+  static FileIOResult str_writev(__llvm_libc::File *f, const void *data1,
+                                 size_t len1, const void *data2, size_t len2);
   static ErrorOr<long> str_seek(__llvm_libc::File *f, long offset, int whence);
   static int str_close(__llvm_libc::File *f) { return 0; }
   static int str_flush(__llvm_libc::File *f) { return 0; }
 
 public:
   explicit StringFile(char *buffer, size_t buflen, int bufmode, bool owned,
-                      ModeFlags modeflags)
+                      ModeFlags modeflags, bool vectored = false)
       : __llvm_libc::File(&str_write, &str_read, &str_seek, &str_close,
                           &str_flush, &__llvm_libc::cleanup_file<StringFile>,
                           reinterpret_cast<uint8_t *>(buffer), buflen, bufmode,
-                          owned, modeflags),
-        pos(0), eof_marker(0), write_append(false) {
+                          owned, modeflags, vectored ? &str_writev : nullptr),
+        pos(0), eof_marker(0), write_append(false), num_writes(0) {
     if (modeflags & static_cast<ModeFlags>(__llvm_libc::File::OpenMode::APPEND))
       write_append = true;
   }
@@ -50,6 +53,10 @@ public:
   void reset() { pos = 0; }
   size_t get_pos() const { return pos; }
   char *get_str() { return str; }
+  // The number of platform write operations performed so far.
+  size_t get_num_writes() const { return num_writes; }
+
+  size_t append(const void *data, size_t len);
 
   // Use this method to prefill the file.
   void reset_and_fill(const char *data, size_t len) {
@@ -74,22 +81,38 @@ FileIOResult StringFile::str_read(__llvm_libc::File *f, void *data,
   return i;
 }
 
-FileIOResult StringFile::str_write(__llvm_libc::File *f, const void *data,
-                                   size_t len) {
-  StringFile *sf = static_cast<StringFile *>(f);
-  if (sf->write_append)
-    sf->pos = sf->eof_marker;
-  if (sf->pos >= SIZE)
+size_t StringFile::append(const void *data, size_t len) {
+  if (write_append)
+    pos = eof_marker;
+  if (pos >= SIZE)
     return 0;
   size_t i = 0;
-  for (i = 0; i < len && sf->pos < SIZE; ++i, ++sf->pos)
-    sf->str[sf->pos] = reinterpret_cast<const char *>(data)[i];
+  for (i = 0; i < len && pos < SIZE; ++i, ++pos)
+    str[pos] = reinterpret_cast<const char *>(data)[i];
   // Move the eof marker if the data was written beyond the current eof marker.
-  if (sf->pos > sf->eof_marker)
-    sf->eof_marker = sf->pos;
+  if (pos > eof_marker)
+    eof_marker = pos;
   return i;
 }
 
+FileIOResult StringFile::str_write(__llvm_libc::File *f, const void *data,
+                                   size_t len) {
+  StringFile *sf = static_cast<StringFile *>(f);
+  ++sf->num_writes;
+  return sf->append(data, len);
+}
+
+FileIOResult StringFile::str_writev(__llvm_libc::File *f, const void *data1,
+                                    size_t len1, const void *data2,
+                                    size_t len2) {
+  StringFile *sf = static_cast<StringFile *>(f);
+  ++sf->num_writes;
+  size_t written = sf->append(data1, len1);
+  if (written == len1)
+    written += sf->append(data2, len2);
+  return written;
+}
+
 ErrorOr<long> StringFile::str_seek(__llvm_libc::File *f, long offset,
                                    int whence) {
   StringFile *sf = static_cast<StringFile *>(f);
@@ -103,12 +126,13 @@ ErrorOr<long> StringFile::str_seek(__llvm_libc::File *f, long offset,
 }
 
 StringFile *new_string_file(char *buffer, size_t buflen, int bufmode,
-                            bool owned, const char *mode) {
+                            bool owned, const char *mode,
+                            bool vectored = false) {
   __llvm_libc::AllocChecker ac;
   // We will just assume the allocation succeeds. We cannot test anything
   // otherwise.
   return new (ac) StringFile(buffer, buflen, bufmode, owned,
-                             __llvm_libc::File::mode_flags(mode));
+                             __llvm_libc::File::mode_flags(mode), vectored);
 }
 
 TEST(LlvmLibcFileTest, WriteOnly) {
@@ -224,6 +248,35 @@ TEST(LlvmLibcFileTest, WriteUnbuffered) {
   ASSERT_EQ(File::cleanup(f), 0);
 }
 
+TEST(LlvmLibcFileTest, WriteVectored) {
+  const char data1[] = "hello";
+  const char data2[] = "a vectored write";
+  constexpr size_t FILE_BUFFER_SIZE = 8;
+  char file_buffer[FILE_BUFFER_SIZE];
+  StringFile *f = new_string_file(file_buffer, FILE_BUFFER_SIZE, _IOFBF, false,
+                                  "w", /*vectored=*/true);
+
+  ASSERT_EQ(sizeof(data1), f->write(data1, sizeof(data1)).value);
+  EXPECT_EQ(f->get_pos(), size_t(0)); // Data is buffered in the file stream
+  // The buffered data and data2, which does not fit in the buffer, are written
+  // with a single operation.
+  ASSERT_EQ(sizeof(data2), f->write(data2, sizeof(data2)).value);
+  EXPECT_EQ(f->get_pos(), sizeof(data1) + sizeof(data2));
+  EXPECT_EQ(f->get_num_writes(), size_t(1));
+  MemoryView src1("hello\0a vectored write", sizeof(data1) + sizeof(data2)),
+      dst1(f->get_str(), sizeof(data1) + sizeof(data2));
+  EXPECT_MEM_EQ(src1, dst1);
+
+  // Data which fits in the buffer is still buffered.
+  ASSERT_EQ(sizeof(data1), f->write(data1, sizeof(data1)).value);
+  EXPECT_EQ(f->get_num_writes(), size_t(1));
+  ASSERT_EQ(f->flush(), 0);
+  EXPECT_EQ(f->get_num_writes(), size_t(2));
+  EXPECT_EQ(f->get_pos(), 2 * sizeof(data1) + sizeof(data2));
+
+  ASSERT_EQ(File::cleanup(f), 0);
+}
+
 TEST(LlvmLibcFileTest, ReadOnly) {
   const char initial_content[] = "1234567890987654321";
   constexpr size_t FILE_BUFFER_SIZE = sizeof(initial_content);
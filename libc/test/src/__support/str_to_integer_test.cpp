@@ -0,0 +1,72 @@
+//===-- Unittests for str_to_integer --------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/__support/str_to_integer.h"
+
+#include "test/UnitTest/Test.h"
+
+#include <errno.h>
+#include <stdint.h>
+
+// Packs the first eight characters of |str| in little endian order.
+static uint64_t pack(const char *str) {
+  uint64_t chars = 0;
+  for (size_t i = 0; i < 8; ++i)
+    chars |= uint64_t(static_cast<unsigned char>(str[i])) << (8 * i);
+  return chars;
+}
+
+TEST(LlvmLibcStrToIntegerTest, IsEightDigits) {
+  EXPECT_TRUE(__llvm_libc::internal::is_eight_digits(pack("00000000")));
+  EXPECT_TRUE(__llvm_libc::internal::is_eight_digits(pack("12345678")));
+  EXPECT_TRUE(__llvm_libc::internal::is_eight_digits(pack("99999999")));
+  EXPECT_FALSE(__llvm_libc::internal::is_eight_digits(pack("1234567a")));
+  EXPECT_FALSE(__llvm_libc::internal::is_eight_digits(pack("/2345678")));
+  EXPECT_FALSE(__llvm_libc::internal::is_eight_digits(pack("1234:678")));
+  EXPECT_FALSE(__llvm_libc::internal::is_eight_digits(pack("1234.678")));
+  EXPECT_FALSE(__llvm_libc::internal::is_eight_digits(pack("123\0abcd")));
+}
+
+TEST(LlvmLibcStrToIntegerTest, EightDigitsToInt) {
+  EXPECT_EQ(__llvm_libc::internal::eight_digits_to_int(pack("00000000")),
+            uint32_t(0));
+  EXPECT_EQ(__llvm_libc::internal::eight_digits_to_int(pack("12345678")),
+            uint32_t(12345678));
+  EXPECT_EQ(__llvm_libc::internal::eight_digits_to_int(pack("00000001")),
+            uint32_t(1));
+  EXPECT_EQ(__llvm_libc::internal::eight_digits_to_int(pack("99999999")),
+            uint32_t(99999999));
+  EXPECT_EQ(__llvm_libc::internal::eight_digits_to_int(pack("90807060")),
+            uint32_t(90807060));
+}
+
+TEST(LlvmLibcStrToIntegerTest, LongDecimalNumbers) {
+  auto result = __llvm_libc::internal::strtointeger<uint64_t>(
+      "18446744073709551615", 10);
+  EXPECT_EQ(result.value, uint64_t(18446744073709551615ULL));
+  EXPECT_EQ(result.parsed_len, ptrdiff_t(20));
+  EXPECT_EQ(result.error, 0);
+
+  result = __llvm_libc::internal::strtointeger<uint64_t>(
+      "18446744073709551616", 10);
+  EXPECT_EQ(result.value, uint64_t(18446744073709551615ULL));
+  EXPECT_EQ(result.parsed_len, ptrdiff_t(20));
+  EXPECT_EQ(result.error, ERANGE);
+
+  auto signed_result =
+      __llvm_libc::internal::strtointeger<int64_t>("-1234567812345678x", 10);
+  EXPECT_EQ(signed_result.value, int64_t(-1234567812345678));
+  EXPECT_EQ(signed_result.parsed_len, ptrdiff_t(17));
+  EXPECT_EQ(signed_result.error, 0);
+
+  auto int_result =
+      __llvm_libc::internal::strtointeger<int32_t>("123456789012", 10);
+  EXPECT_EQ(int_result.value, int32_t(2147483647));
+  EXPECT_EQ(int_result.parsed_len, ptrdiff_t(12));
+  EXPECT_EQ(int_result.error, ERANGE);
+}
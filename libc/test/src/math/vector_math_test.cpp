@@ -0,0 +1,56 @@
+//===-- Unittests for the vector variants of the float math functions -----===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/__support/FPUtil/FPBits.h"
+#include "src/math/cosf.h"
+#include "src/math/exp2f.h"
+#include "src/math/expf.h"
+#include "src/math/log10f.h"
+#include "src/math/log2f.h"
+#include "src/math/logf.h"
+#include "src/math/sinf.h"
+#include "src/math/vector/vector_math.h"
+#include "test/UnitTest/Test.h"
+
+#include <stdint.h>
+
+using __llvm_libc::vector::Float4;
+using __llvm_libc::vector::NUM_LANES;
+using FPBits = __llvm_libc::fputil::FPBits<float>;
+
+// Checks that every lane of the vector variant matches the scalar function
+// bit for bit, over a sample of all the float values.
+template <float (*Scalar)(float), Float4 (*Vector)(Float4)>
+static void check_lanes() {
+  constexpr uint32_t COUNT = 1'000'003;
+  constexpr uint32_t STEP = UINT32_MAX / COUNT;
+  uint32_t bits = 0;
+  for (uint32_t i = 0; i < COUNT / NUM_LANES; ++i) {
+    Float4 x;
+    for (size_t lane = 0; lane < NUM_LANES; ++lane, bits += STEP)
+      x[lane] = float(FPBits(bits));
+    Float4 result = Vector(x);
+    for (size_t lane = 0; lane < NUM_LANES; ++lane)
+      ASSERT_EQ(FPBits(Scalar(x[lane])).uintval(),
+                FPBits(result[lane]).uintval());
+  }
+}
+
+#define VECTOR_MATH_TEST(name)                                                 \
+  TEST(LlvmLibcVectorMathTest, name) {                                         \
+    check_lanes<__llvm_libc::name,                                             \
+                __llvm_libc::LLVM_LIBC_VECTOR_NAME(name)>();                   \
+  }
+
+VECTOR_MATH_TEST(cosf)
+VECTOR_MATH_TEST(exp2f)
+VECTOR_MATH_TEST(expf)
+VECTOR_MATH_TEST(log10f)
+VECTOR_MATH_TEST(log2f)
+VECTOR_MATH_TEST(logf)
+VECTOR_MATH_TEST(sinf)
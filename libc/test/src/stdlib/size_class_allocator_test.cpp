@@ -0,0 +1,112 @@
+//===-- Unittests for SizeClassAllocator ----------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/stdlib/linux/size_class_allocator.h"
+#include "test/UnitTest/Test.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+using __llvm_libc::SizeClassAllocator;
+
+static SizeClassAllocator allocator;
+
+TEST(LlvmLibcSizeClassAllocatorTest, SizeClasses) {
+  for (unsigned c = 0; c < SizeClassAllocator::NUM_CLASSES; ++c) {
+    const size_t size = SizeClassAllocator::class_to_size(c);
+    EXPECT_EQ(size % SizeClassAllocator::ALIGNMENT, size_t(0));
+    EXPECT_EQ(SizeClassAllocator::size_to_class(size), c);
+    if (c > 0)
+      EXPECT_EQ(SizeClassAllocator::size_to_class(
+                    SizeClassAllocator::class_to_size(c - 1) + 1),
+                c);
+  }
+  EXPECT_EQ(SizeClassAllocator::class_to_size(
+                SizeClassAllocator::NUM_CLASSES - 1),
+            SizeClassAllocator::MAX_SMALL_SIZE);
+}
+
+TEST(LlvmLibcSizeClassAllocatorTest, AllocateAndFree) {
+  SizeClassAllocator::ThreadCache cache;
+  constexpr size_t SIZES[] = {0, 1, 16, 17, 100, 128, 129, 1000, 4096, 32768,
+                              32769, 100000, 1 << 20};
+  for (size_t size : SIZES) {
+    void *ptrs[100];
+    for (void *&ptr : ptrs) {
+      ptr = allocator.allocate(size, SizeClassAllocator::ALIGNMENT, &cache);
+      ASSERT_TRUE(ptr != nullptr);
+      EXPECT_EQ(uintptr_t(ptr) % SizeClassAllocator::ALIGNMENT, uintptr_t(0));
+      EXPECT_GE(allocator.usable_size(ptr), size);
+      __builtin_memset(ptr, 0xab, size);
+    }
+    for (void *ptr : ptrs)
+      allocator.deallocate(ptr, &cache);
+  }
+  allocator.drain(cache);
+}
+
+TEST(LlvmLibcSizeClassAllocatorTest, Alignment) {
+  SizeClassAllocator::ThreadCache cache;
+  for (size_t alignment = 1; alignment <= (size_t(1) << 20); alignment <<= 1) {
+    constexpr size_t SIZES[] = {1, 100, 50000};
+    for (size_t size : SIZES) {
+      void *ptr = allocator.allocate(size, alignment, &cache);
+      ASSERT_TRUE(ptr != nullptr);
+      EXPECT_EQ(uintptr_t(ptr) % alignment, uintptr_t(0));
+      EXPECT_GE(allocator.usable_size(ptr), size);
+      __builtin_memset(ptr, 0xcd, size);
+      allocator.deallocate(ptr, &cache);
+    }
+  }
+  allocator.drain(cache);
+}
+
+TEST(LlvmLibcSizeClassAllocatorTest, Reallocate) {
+  SizeClassAllocator::ThreadCache cache;
+  unsigned char *ptr = reinterpret_cast<unsigned char *>(
+      allocator.reallocate(nullptr, 10, &cache));
+  ASSERT_TRUE(ptr != nullptr);
+  for (size_t i = 0; i < 10; ++i)
+    ptr[i] = static_cast<unsigned char>(i);
+  constexpr size_t SIZES[] = {12, 1000, 100000, 20};
+  for (size_t size : SIZES) {
+    ptr = reinterpret_cast<unsigned char *>(
+        allocator.reallocate(ptr, size, &cache));
+    ASSERT_TRUE(ptr != nullptr);
+    EXPECT_GE(allocator.usable_size(ptr), size);
+    for (size_t i = 0; i < 10; ++i)
+      EXPECT_EQ(ptr[i], static_cast<unsigned char>(i));
+  }
+  allocator.deallocate(ptr, &cache);
+  allocator.drain(cache);
+}
+
+TEST(LlvmLibcSizeClassAllocatorTest, NoThreadCache) {
+  void *ptr = allocator.allocate(64, SizeClassAllocator::ALIGNMENT, nullptr);
+  ASSERT_TRUE(ptr != nullptr);
+  __builtin_memset(ptr, 0xef, 64);
+  allocator.deallocate(ptr, nullptr);
+  ptr = allocator.allocate(64, SizeClassAllocator::ALIGNMENT, nullptr);
+  ASSERT_TRUE(ptr != nullptr);
+  allocator.deallocate(ptr, nullptr);
+}
+
+TEST(LlvmLibcSizeClassAllocatorTest, LockAll) {
+  // The locks of all the size classes and of the regions are released again,
+  // as after a fork.
+  allocator.lock_all();
+  allocator.unlock_all();
+  SizeClassAllocator::ThreadCache cache;
+  for (unsigned c = 0; c < SizeClassAllocator::NUM_CLASSES; ++c) {
+    void *ptr = allocator.allocate(SizeClassAllocator::class_to_size(c),
+                                   SizeClassAllocator::ALIGNMENT, nullptr);
+    ASSERT_TRUE(ptr != nullptr);
+    allocator.deallocate(ptr, &cache);
+  }
+  allocator.drain(cache);
+}
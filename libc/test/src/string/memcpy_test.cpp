@@ -31,4 +31,18 @@ TEST(LlvmLibcMemcpyTest, SizeSweep) {
   }
 }
 
+// Some implementations switch to 'rep movsb' above a few kilobytes.
+TEST(LlvmLibcMemcpyTest, LargeSizes) {
+  static constexpr size_t kMaxSize = 8192;
+  static constexpr auto Impl = CopyAdaptor<__llvm_libc::memcpy>;
+  Buffer SrcBuffer(kMaxSize);
+  Buffer DstBuffer(kMaxSize, Aligned::NO);
+  Randomize(SrcBuffer.span());
+  for (size_t size = 1024; size < kMaxSize; size += 31) {
+    auto src = SrcBuffer.span().subspan(0, size);
+    auto dst = DstBuffer.span().subspan(0, size);
+    ASSERT_TRUE(CheckMemcpy<Impl>(dst, src, size));
+  }
+}
+
 } // namespace __llvm_libc
@@ -40,14 +40,16 @@ struct Buffers {
 
 using MemcpyImplementations = testing::TypeList<
 #ifdef LLVM_LIBC_HAS_BUILTIN_MEMCPY_INLINE
-    builtin::Memcpy<1>,  //
-    builtin::Memcpy<2>,  //
-    builtin::Memcpy<3>,  //
-    builtin::Memcpy<4>,  //
-    builtin::Memcpy<8>,  //
-    builtin::Memcpy<16>, //
-    builtin::Memcpy<32>, //
-    builtin::Memcpy<64>
+    builtin::Memcpy<1>,   //
+    builtin::Memcpy<2>,   //
+    builtin::Memcpy<3>,   //
+    builtin::Memcpy<4>,   //
+    builtin::Memcpy<8>,   //
+    builtin::Memcpy<16>,  //
+    builtin::Memcpy<32>,  //
+    builtin::Memcpy<64>,  //
+    builtin::Memcpy<128>, //
+    builtin::Memcpy<256>
 #endif // LLVM_LIBC_HAS_BUILTIN_MEMCPY_INLINE
     >;
 
@@ -107,6 +109,41 @@ TYPED_TEST(LlvmLibcOpTest, Memcpy, MemcpyImplementations) {
   }
 }
 
+#ifdef __ARM_FEATURE_SVE
+TEST(LlvmLibcOpTest, SveMemcpy) {
+  static constexpr auto Impl =
+      CopyAdaptor<aarch64::sve::Memcpy::upto_two_vectors>;
+  const size_t kMaxSize = 2 * aarch64::sve::vector_length();
+  { // Test all sizes from 0 to two vector lengths.
+    Buffer SrcBuffer(kMaxSize);
+    Buffer DstBuffer(kMaxSize);
+    Randomize(SrcBuffer.span());
+    for (size_t size = 0; size <= kMaxSize; ++size) {
+      auto src = SrcBuffer.span().subspan(0, size);
+      auto dst = DstBuffer.span().subspan(0, size);
+      ASSERT_TRUE(CheckMemcpy<Impl>(dst, src, size));
+    }
+  }
+  { // Test overlapping buffers, memmove uses this operation too.
+    Buffer Mem(kMaxSize + 1);
+    Buffer Expected(kMaxSize + 1);
+    for (size_t size = 0; size <= kMaxSize; ++size) {
+      for (size_t dst_offset : cpp::array<size_t, 2>{0, 1}) {
+        const size_t src_offset = 1 - dst_offset;
+        Randomize(Mem.span());
+        ReferenceCopy(Expected.span(), Mem.span());
+        for (size_t i = 0; i < size; ++i)
+          Expected.span()[dst_offset + i] = Mem.span()[src_offset + i];
+        Impl(Mem.span().subspan(dst_offset, size),
+             Mem.span().subspan(src_offset, size), size);
+        for (size_t i = 0; i <= kMaxSize; ++i)
+          ASSERT_EQ(Mem.span()[i], Expected.span()[i]);
+      }
+    }
+  }
+}
+#endif // __ARM_FEATURE_SVE
+
 using MemsetImplementations = testing::TypeList<
 #ifdef LLVM_LIBC_HAS_BUILTIN_MEMSET_INLINE
     builtin::Memset<1>,  //
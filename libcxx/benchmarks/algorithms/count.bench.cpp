@@ -0,0 +1,51 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+// Half of the elements are counted.
+template <class T>
+static void BM_std_count(benchmark::State& state) {
+  std::vector<T> vec(state.range(0), T(1));
+  for (size_t i = 0; i < vec.size(); i += 2)
+    vec[i] = T(2);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(vec);
+    benchmark::DoNotOptimize(std::count(vec.begin(), vec.end(), T(2)));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_std_count<char>)->RangeMultiplier(8)->Range(1, 1 << 20);
+BENCHMARK(BM_std_count<short>)->RangeMultiplier(8)->Range(1, 1 << 20);
+BENCHMARK(BM_std_count<int>)->RangeMultiplier(8)->Range(1, 1 << 20);
+BENCHMARK(BM_std_count<long long>)->RangeMultiplier(8)->Range(1, 1 << 20);
+BENCHMARK(BM_std_count<float>)->RangeMultiplier(8)->Range(1, 1 << 20);
+BENCHMARK(BM_std_count<double>)->RangeMultiplier(8)->Range(1, 1 << 20);
+
+template <class T>
+static void BM_ranges_count(benchmark::State& state) {
+  std::vector<T> vec(state.range(0), T(1));
+  for (size_t i = 0; i < vec.size(); i += 2)
+    vec[i] = T(2);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(vec);
+    benchmark::DoNotOptimize(std::ranges::count(vec, T(2)));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ranges_count<char>)->RangeMultiplier(8)->Range(1, 1 << 20);
+BENCHMARK(BM_ranges_count<short>)->RangeMultiplier(8)->Range(1, 1 << 20);
+BENCHMARK(BM_ranges_count<int>)->RangeMultiplier(8)->Range(1, 1 << 20);
+BENCHMARK(BM_ranges_count<long long>)->RangeMultiplier(8)->Range(1, 1 << 20);
+BENCHMARK(BM_ranges_count<float>)->RangeMultiplier(8)->Range(1, 1 << 20);
+BENCHMARK(BM_ranges_count<double>)->RangeMultiplier(8)->Range(1, 1 << 20);
+
+BENCHMARK_MAIN();
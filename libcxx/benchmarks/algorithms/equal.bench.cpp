@@ -0,0 +1,50 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+template <class T>
+static void BM_std_equal(benchmark::State& state) {
+  std::vector<T> vec1(state.range(0), T(1));
+  std::vector<T> vec2 = vec1;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(vec1);
+    benchmark::DoNotOptimize(vec2);
+    benchmark::DoNotOptimize(std::equal(vec1.begin(), vec1.end(), vec2.begin()));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_std_equal<char>)->RangeMultiplier(8)->Range(1, 1 << 20);
+BENCHMARK(BM_std_equal<short>)->RangeMultiplier(8)->Range(1, 1 << 20);
+BENCHMARK(BM_std_equal<int>)->RangeMultiplier(8)->Range(1, 1 << 20);
+BENCHMARK(BM_std_equal<long long>)->RangeMultiplier(8)->Range(1, 1 << 20);
+BENCHMARK(BM_std_equal<float>)->RangeMultiplier(8)->Range(1, 1 << 20);
+BENCHMARK(BM_std_equal<double>)->RangeMultiplier(8)->Range(1, 1 << 20);
+
+template <class T>
+static void BM_ranges_equal(benchmark::State& state) {
+  std::vector<T> vec1(state.range(0), T(1));
+  std::vector<T> vec2 = vec1;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(vec1);
+    benchmark::DoNotOptimize(vec2);
+    benchmark::DoNotOptimize(std::ranges::equal(vec1, vec2));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ranges_equal<char>)->RangeMultiplier(8)->Range(1, 1 << 20);
+BENCHMARK(BM_ranges_equal<short>)->RangeMultiplier(8)->Range(1, 1 << 20);
+BENCHMARK(BM_ranges_equal<int>)->RangeMultiplier(8)->Range(1, 1 << 20);
+BENCHMARK(BM_ranges_equal<long long>)->RangeMultiplier(8)->Range(1, 1 << 20);
+BENCHMARK(BM_ranges_equal<float>)->RangeMultiplier(8)->Range(1, 1 << 20);
+BENCHMARK(BM_ranges_equal<double>)->RangeMultiplier(8)->Range(1, 1 << 20);
+
+BENCHMARK_MAIN();
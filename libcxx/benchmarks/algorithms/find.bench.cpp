@@ -0,0 +1,49 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+// The element looked for is the last one, so the whole range is searched.
+template <class T>
+static void BM_std_find(benchmark::State& state) {
+  std::vector<T> vec(state.range(0), T(1));
+  vec.back() = T(2);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(vec);
+    benchmark::DoNotOptimize(std::find(vec.begin(), vec.end(), T(2)));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_std_find<char>)->RangeMultiplier(8)->Range(1, 1 << 20);
+BENCHMARK(BM_std_find<short>)->RangeMultiplier(8)->Range(1, 1 << 20);
+BENCHMARK(BM_std_find<int>)->RangeMultiplier(8)->Range(1, 1 << 20);
+BENCHMARK(BM_std_find<long long>)->RangeMultiplier(8)->Range(1, 1 << 20);
+BENCHMARK(BM_std_find<float>)->RangeMultiplier(8)->Range(1, 1 << 20);
+BENCHMARK(BM_std_find<double>)->RangeMultiplier(8)->Range(1, 1 << 20);
+
+template <class T>
+static void BM_ranges_find(benchmark::State& state) {
+  std::vector<T> vec(state.range(0), T(1));
+  vec.back() = T(2);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(vec);
+    benchmark::DoNotOptimize(std::ranges::find(vec, T(2)));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ranges_find<char>)->RangeMultiplier(8)->Range(1, 1 << 20);
+BENCHMARK(BM_ranges_find<short>)->RangeMultiplier(8)->Range(1, 1 << 20);
+BENCHMARK(BM_ranges_find<int>)->RangeMultiplier(8)->Range(1, 1 << 20);
+BENCHMARK(BM_ranges_find<long long>)->RangeMultiplier(8)->Range(1, 1 << 20);
+BENCHMARK(BM_ranges_find<float>)->RangeMultiplier(8)->Range(1, 1 << 20);
+BENCHMARK(BM_ranges_find<double>)->RangeMultiplier(8)->Range(1, 1 << 20);
+
+BENCHMARK_MAIN();
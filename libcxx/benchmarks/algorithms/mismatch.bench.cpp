@@ -0,0 +1,53 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+// The ranges only differ in their last element, so they are compared entirely.
+template <class T>
+static void BM_std_mismatch(benchmark::State& state) {
+  std::vector<T> vec1(state.range(0), T(1));
+  std::vector<T> vec2 = vec1;
+  vec2.back() = T(2);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(vec1);
+    benchmark::DoNotOptimize(vec2);
+    benchmark::DoNotOptimize(std::mismatch(vec1.begin(), vec1.end(), vec2.begin()));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_std_mismatch<char>)->RangeMultiplier(8)->Range(1, 1 << 20);
+BENCHMARK(BM_std_mismatch<short>)->RangeMultiplier(8)->Range(1, 1 << 20);
+BENCHMARK(BM_std_mismatch<int>)->RangeMultiplier(8)->Range(1, 1 << 20);
+BENCHMARK(BM_std_mismatch<long long>)->RangeMultiplier(8)->Range(1, 1 << 20);
+BENCHMARK(BM_std_mismatch<float>)->RangeMultiplier(8)->Range(1, 1 << 20);
+BENCHMARK(BM_std_mismatch<double>)->RangeMultiplier(8)->Range(1, 1 << 20);
+
+template <class T>
+static void BM_ranges_mismatch(benchmark::State& state) {
+  std::vector<T> vec1(state.range(0), T(1));
+  std::vector<T> vec2 = vec1;
+  vec2.back() = T(2);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(vec1);
+    benchmark::DoNotOptimize(vec2);
+    benchmark::DoNotOptimize(std::ranges::mismatch(vec1, vec2));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ranges_mismatch<char>)->RangeMultiplier(8)->Range(1, 1 << 20);
+BENCHMARK(BM_ranges_mismatch<short>)->RangeMultiplier(8)->Range(1, 1 << 20);
+BENCHMARK(BM_ranges_mismatch<int>)->RangeMultiplier(8)->Range(1, 1 << 20);
+BENCHMARK(BM_ranges_mismatch<long long>)->RangeMultiplier(8)->Range(1, 1 << 20);
+BENCHMARK(BM_ranges_mismatch<float>)->RangeMultiplier(8)->Range(1, 1 << 20);
+BENCHMARK(BM_ranges_mismatch<double>)->RangeMultiplier(8)->Range(1, 1 << 20);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,295 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <cstdint>
+#include <flat_map>
+#include <map>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "CartesianBenchmarks.h"
+#include "benchmark/benchmark.h"
+#include "test_macros.h"
+
+// Compares std::flat_map against std::map, see map.bench.cpp for the
+// benchmarks of the other operations of std::map.
+
+namespace {
+
+enum class Container { Map, FlatMap };
+struct AllContainers : EnumValuesAsTuple<AllContainers, Container, 2> {
+  static constexpr const char* Names[] = {"map", "flat_map"};
+};
+
+template <class Cont>
+using MapType = std::conditional_t<Cont::value == Container::Map,
+                                   std::map<uint64_t, int64_t>,
+                                   std::flat_map<uint64_t, int64_t> >;
+
+enum class Mode { Hit, Miss };
+struct AllModes : EnumValuesAsTuple<AllModes, Mode, 2> {
+  static constexpr const char* Names[] = {"ExistingElement", "NewElement"};
+};
+
+enum class Order { Sorted, Random };
+struct AllOrders : EnumValuesAsTuple<AllOrders, Order, 2> {
+  static constexpr const char* Names[] = {"Sorted", "Random"};
+};
+
+// The map holds the even keys 2 to 2 * MapSize, the keys to look up are the
+// same keys on a hit and the odd keys on a miss.
+std::vector<uint64_t> makeKeys(size_t MapSize, Mode mode, Order order) {
+  std::vector<uint64_t> Keys;
+  for (uint64_t I = 0; I < MapSize; ++I)
+    Keys.push_back(mode == Mode::Hit ? 2 * I + 2 : 2 * I + 1);
+  if (order == Order::Random)
+    std::shuffle(Keys.begin(), Keys.end(), std::mt19937());
+  return Keys;
+}
+
+std::vector<std::pair<uint64_t, int64_t> > makeElements(size_t MapSize,
+                                                        Order order) {
+  std::vector<std::pair<uint64_t, int64_t> > Elements;
+  for (auto K : makeKeys(MapSize, Mode::Hit, order))
+    Elements.emplace_back(K, 0);
+  return Elements;
+}
+
+struct Base {
+  size_t MapSize;
+  Base(size_t T) : MapSize(T) {}
+
+  std::string baseName() const { return "_MapSize=" + std::to_string(MapSize); }
+};
+
+//*******************************************************************|
+//                          Construction                             |
+//*******************************************************************|
+
+template <class Cont, class Order>
+struct ConstructorIterator : Base {
+  using Base::Base;
+
+  void run(benchmark::State& State) const {
+    auto Elements = makeElements(MapSize, Order());
+    while (State.KeepRunningBatch(MapSize)) {
+      MapType<Cont> M(Elements.begin(), Elements.end());
+      benchmark::DoNotOptimize(M);
+    }
+  }
+
+  std::string name() const {
+    return "BM_ConstructorIterator" + Cont::name() + baseName() +
+           Order::name();
+  }
+};
+
+// The insertion of sorted unique elements, one at a time for std::map and in
+// bulk for std::flat_map.
+template <class Cont>
+struct ConstructorSortedUnique : Base {
+  using Base::Base;
+
+  void run(benchmark::State& State) const {
+    auto Elements = makeElements(MapSize, Order::Sorted);
+    while (State.KeepRunningBatch(MapSize)) {
+      if constexpr (Cont::value == Container::Map) {
+        MapType<Cont> M;
+        for (auto& E : Elements)
+          M.emplace_hint(M.end(), E);
+        benchmark::DoNotOptimize(M);
+      } else {
+        MapType<Cont> M(std::sorted_unique, Elements.begin(), Elements.end());
+        benchmark::DoNotOptimize(M);
+      }
+    }
+  }
+
+  std::string name() const {
+    return "BM_ConstructorSortedUnique" + Cont::name() + baseName();
+  }
+};
+
+//*******************************************************************|
+//                           Modifiers                               |
+//*******************************************************************|
+
+// Inserts the elements one at a time.
+template <class Cont, class Order>
+struct Insert : Base {
+  using Base::Base;
+
+  void run(benchmark::State& State) const {
+    auto Elements = makeElements(MapSize, Order());
+    while (State.KeepRunningBatch(MapSize)) {
+      MapType<Cont> M;
+      for (auto& E : Elements)
+        benchmark::DoNotOptimize(M.insert(E));
+    }
+  }
+
+  // Inserting in random order in a flat_map is quadratic.
+  bool skip() const {
+    return Cont::value == Container::FlatMap &&
+           Order::value == ::Order::Random && MapSize > 10000;
+  }
+
+  std::string name() const {
+    return "BM_Insert" + Cont::name() + baseName() + Order::name();
+  }
+};
+
+// Inserts the elements in bulk in a map holding as many elements, with keys
+// which interleave with the inserted ones.
+template <class Cont, class Order>
+struct InsertRange : Base {
+  using Base::Base;
+
+  void run(benchmark::State& State) const {
+    auto Elements = makeElements(MapSize, Order());
+    std::vector<std::pair<uint64_t, int64_t> > Initial;
+    for (auto K : makeKeys(MapSize, Mode::Miss, ::Order::Sorted))
+      Initial.emplace_back(K, 0);
+    const MapType<Cont> Map(Initial.begin(), Initial.end());
+    while (State.KeepRunningBatch(MapSize)) {
+      State.PauseTiming();
+      MapType<Cont> M(Map);
+      State.ResumeTiming();
+      M.insert(Elements.begin(), Elements.end());
+      benchmark::DoNotOptimize(M);
+    }
+  }
+
+  std::string name() const {
+    return "BM_InsertRange" + Cont::name() + baseName() + Order::name();
+  }
+};
+
+// Appends sorted unique elements which are all greater than the existing ones.
+template <class Cont>
+struct InsertSortedUniqueAppend : Base {
+  using Base::Base;
+
+  void run(benchmark::State& State) const {
+    auto Elements = makeElements(2 * MapSize, Order::Sorted);
+    const MapType<Cont> Map(Elements.begin(), Elements.begin() + MapSize);
+    while (State.KeepRunningBatch(MapSize)) {
+      State.PauseTiming();
+      MapType<Cont> M(Map);
+      State.ResumeTiming();
+      if constexpr (Cont::value == Container::Map)
+        M.insert(Elements.begin() + MapSize, Elements.end());
+      else
+        M.insert(std::sorted_unique, Elements.begin() + MapSize,
+                 Elements.end());
+      benchmark::DoNotOptimize(M);
+    }
+  }
+
+  std::string name() const {
+    return "BM_InsertSortedUniqueAppend" + Cont::name() + baseName();
+  }
+};
+
+//*******************************************************************|
+//                            Lookup                                 |
+//*******************************************************************|
+
+template <class Cont, class Mode, class Order>
+struct Find : Base {
+  using Base::Base;
+
+  void run(benchmark::State& State) const {
+    auto Elements = makeElements(MapSize, ::Order::Sorted);
+    const MapType<Cont> Map(Elements.begin(), Elements.end());
+    auto Keys = makeKeys(MapSize, Mode(), Order());
+    while (State.KeepRunningBatch(MapSize)) {
+      for (auto K : Keys)
+        benchmark::DoNotOptimize(Map.find(K));
+    }
+  }
+
+  std::string name() const {
+    return "BM_Find" + Cont::name() + baseName() + Mode::name() +
+           Order::name();
+  }
+};
+
+template <class Cont, class Mode, class Order>
+struct LowerBound : Base {
+  using Base::Base;
+
+  void run(benchmark::State& State) const {
+    auto Elements = makeElements(MapSize, ::Order::Sorted);
+    const MapType<Cont> Map(Elements.begin(), Elements.end());
+    auto Keys = makeKeys(MapSize, Mode(), Order());
+    while (State.KeepRunningBatch(MapSize)) {
+      for (auto K : Keys)
+        benchmark::DoNotOptimize(Map.lower_bound(K));
+    }
+  }
+
+  std::string name() const {
+    return "BM_LowerBound" + Cont::name() + baseName() + Mode::name() +
+           Order::name();
+  }
+};
+
+template <class Cont>
+struct IterateRangeFor : Base {
+  using Base::Base;
+
+  void run(benchmark::State& State) const {
+    auto Elements = makeElements(MapSize, Order::Sorted);
+    const MapType<Cont> Map(Elements.begin(), Elements.end());
+    while (State.KeepRunningBatch(MapSize)) {
+      for (auto&& [K, V] : Map) {
+        benchmark::DoNotOptimize(K);
+        benchmark::DoNotOptimize(V);
+      }
+    }
+  }
+
+  std::string name() const {
+    return "BM_IterateRangeFor" + Cont::name() + baseName();
+  }
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    return 1;
+
+  const std::vector<size_t> MapSize{10, 100, 1000, 10000, 100000, 1000000};
+
+  // Construction
+  makeCartesianProductBenchmark<ConstructorIterator, AllContainers, AllOrders>(
+      MapSize);
+  makeCartesianProductBenchmark<ConstructorSortedUnique, AllContainers>(
+      MapSize);
+
+  // Modifiers
+  makeCartesianProductBenchmark<Insert, AllContainers, AllOrders>(MapSize);
+  makeCartesianProductBenchmark<InsertRange, AllContainers, AllOrders>(MapSize);
+  makeCartesianProductBenchmark<InsertSortedUniqueAppend, AllContainers>(
+      MapSize);
+
+  // Lookup
+  makeCartesianProductBenchmark<Find, AllContainers, AllModes, AllOrders>(
+      MapSize);
+  makeCartesianProductBenchmark<LowerBound, AllContainers, AllModes, AllOrders>(
+      MapSize);
+  makeCartesianProductBenchmark<IterateRangeFor, AllContainers>(MapSize);
+
+  benchmark::RunSpecifiedBenchmarks();
+}
@@ -0,0 +1,211 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <cstdint>
+#include <flat_set>
+#include <numeric>
+#include <random>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "CartesianBenchmarks.h"
+#include "benchmark/benchmark.h"
+#include "test_macros.h"
+
+// Compares std::flat_set against std::set, see ordered_set.bench.cpp for the
+// benchmarks of the other operations of std::set.
+
+namespace {
+
+enum class Container { Set, FlatSet };
+struct AllContainers : EnumValuesAsTuple<AllContainers, Container, 2> {
+  static constexpr const char* Names[] = {"set", "flat_set"};
+};
+
+template <class Cont>
+using SetType = std::conditional_t<Cont::value == Container::Set,
+                                   std::set<uint64_t>,
+                                   std::flat_set<uint64_t> >;
+
+enum class HitType { Hit, Miss };
+
+struct AllHitTypes : EnumValuesAsTuple<AllHitTypes, HitType, 2> {
+  static constexpr const char* Names[] = {"Hit", "Miss"};
+};
+
+enum class AccessPattern { Ordered, Random };
+
+struct AllAccessPattern
+    : EnumValuesAsTuple<AllAccessPattern, AccessPattern, 2> {
+  static constexpr const char* Names[] = {"Ordered", "Random"};
+};
+
+void sortKeysBy(std::vector<uint64_t>& Keys, AccessPattern AP) {
+  if (AP == AccessPattern::Random) {
+    std::random_device R;
+    std::mt19937 M(R());
+    std::shuffle(std::begin(Keys), std::end(Keys), M);
+  }
+}
+
+// The set holds the even keys below 2 * TableSize, the keys to look up are the
+// same keys on a hit and the odd keys on a miss.
+std::vector<uint64_t> makeKeys(size_t TableSize, HitType Hit,
+                               AccessPattern Access) {
+  std::vector<uint64_t> Keys;
+  for (uint64_t I = 0; I < TableSize; ++I)
+    Keys.push_back(Hit == HitType::Hit ? 2 * I : 2 * I + 1);
+  sortKeysBy(Keys, Access);
+  return Keys;
+}
+
+struct Base {
+  size_t TableSize;
+  Base(size_t T) : TableSize(T) {}
+
+  std::string baseName() const {
+    return "_TableSize" + std::to_string(TableSize);
+  }
+};
+
+// Inserts the keys one at a time.
+template <class Cont, class Access>
+struct Create : Base {
+  using Base::Base;
+
+  // Inserting in random order in a flat_set is quadratic.
+  bool skip() const {
+    return Cont::value == Container::FlatSet &&
+           Access::value == AccessPattern::Random && TableSize > 10000;
+  }
+
+  void run(benchmark::State& State) const {
+    std::vector<uint64_t> Keys(TableSize);
+    std::iota(Keys.begin(), Keys.end(), uint64_t{0});
+    sortKeysBy(Keys, Access());
+
+    while (State.KeepRunningBatch(TableSize)) {
+      SetType<Cont> Set;
+      for (auto K : Keys)
+        benchmark::DoNotOptimize(Set.insert(K));
+    }
+  }
+
+  std::string name() const {
+    return "BM_Create" + Cont::name() + Access::name() + baseName();
+  }
+};
+
+// Inserts the keys in bulk, which sorts them for a flat_set.
+template <class Cont, class Access>
+struct CreateRange : Base {
+  using Base::Base;
+
+  void run(benchmark::State& State) const {
+    std::vector<uint64_t> Keys(TableSize);
+    std::iota(Keys.begin(), Keys.end(), uint64_t{0});
+    sortKeysBy(Keys, Access());
+
+    while (State.KeepRunningBatch(TableSize)) {
+      SetType<Cont> Set(Keys.begin(), Keys.end());
+      benchmark::DoNotOptimize(Set);
+    }
+  }
+
+  std::string name() const {
+    return "BM_CreateRange" + Cont::name() + Access::name() + baseName();
+  }
+};
+
+// Inserts the odd keys in bulk in a set holding the even ones.
+template <class Cont, class Access>
+struct InsertRange : Base {
+  using Base::Base;
+
+  void run(benchmark::State& State) const {
+    auto Existing = makeKeys(TableSize, HitType::Hit, AccessPattern::Ordered);
+    auto Keys = makeKeys(TableSize, HitType::Miss, Access());
+    const SetType<Cont> Set(Existing.begin(), Existing.end());
+
+    while (State.KeepRunningBatch(TableSize)) {
+      State.PauseTiming();
+      SetType<Cont> S(Set);
+      State.ResumeTiming();
+      S.insert(Keys.begin(), Keys.end());
+      benchmark::DoNotOptimize(S);
+    }
+  }
+
+  std::string name() const {
+    return "BM_InsertRange" + Cont::name() + Access::name() + baseName();
+  }
+};
+
+template <class Cont, class Hit, class Access>
+struct Find : Base {
+  using Base::Base;
+
+  void run(benchmark::State& State) const {
+    auto Existing = makeKeys(TableSize, HitType::Hit, AccessPattern::Ordered);
+    const SetType<Cont> Set(Existing.begin(), Existing.end());
+    auto Keys = makeKeys(TableSize, Hit(), Access());
+
+    while (State.KeepRunningBatch(TableSize)) {
+      for (auto K : Keys)
+        benchmark::DoNotOptimize(Set.find(K));
+    }
+  }
+
+  std::string name() const {
+    return "BM_Find" + Cont::name() + Hit::name() + Access::name() +
+           baseName();
+  }
+};
+
+template <class Cont>
+struct IterateRangeFor : Base {
+  using Base::Base;
+
+  void run(benchmark::State& State) const {
+    auto Existing = makeKeys(TableSize, HitType::Hit, AccessPattern::Ordered);
+    const SetType<Cont> Set(Existing.begin(), Existing.end());
+
+    while (State.KeepRunningBatch(TableSize)) {
+      for (auto& V : Set)
+        benchmark::DoNotOptimize(V);
+    }
+  }
+
+  std::string name() const {
+    return "BM_IterateRangeFor" + Cont::name() + baseName();
+  }
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    return 1;
+
+  const std::vector<size_t> TableSize{10, 100, 1000, 10000, 100000, 1000000};
+
+  makeCartesianProductBenchmark<Create, AllContainers, AllAccessPattern>(
+      TableSize);
+  makeCartesianProductBenchmark<CreateRange, AllContainers, AllAccessPattern>(
+      TableSize);
+  makeCartesianProductBenchmark<InsertRange, AllContainers, AllAccessPattern>(
+      TableSize);
+  makeCartesianProductBenchmark<Find, AllContainers, AllHitTypes,
+                                AllAccessPattern>(TableSize);
+  makeCartesianProductBenchmark<IterateRangeFor, AllContainers>(TableSize);
+  benchmark::RunSpecifiedBenchmarks();
+}
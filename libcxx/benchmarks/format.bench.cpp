@@ -27,6 +27,50 @@ static void BM_format_string(benchmark::State& state) {
 BENCHMARK_TEMPLATE(BM_format_string, char)->RangeMultiplier(2)->Range(1, 1 << 20);
 BENCHMARK_TEMPLATE(BM_format_string, wchar_t)->RangeMultiplier(2)->Range(1, 1 << 20);
 
+// A typical log line, with literal text around a few replacement fields.
+template <class CharT>
+static void BM_format_log_line(benchmark::State& state) {
+  std::basic_string<CharT> client(CSTR("client"));
+  unsigned request = 0;
+
+  for (auto _ : state) {
+    ++request;
+    benchmark::DoNotOptimize(std::format(CSTR("[info] request {} took {} ms for {}"), request, request % 1000, client));
+  }
+}
+BENCHMARK_TEMPLATE(BM_format_log_line, char);
+BENCHMARK_TEMPLATE(BM_format_log_line, wchar_t);
+
+// The same log line, with format-specs in the replacement fields.
+template <class CharT>
+static void BM_format_log_line_with_specs(benchmark::State& state) {
+  std::basic_string<CharT> client(CSTR("client"));
+  unsigned request = 0;
+
+  for (auto _ : state) {
+    ++request;
+    benchmark::DoNotOptimize(
+        std::format(CSTR("[info] request {:#010x} took {:>5} ms for {:.4}"), request, request % 1000, client));
+  }
+}
+BENCHMARK_TEMPLATE(BM_format_log_line_with_specs, char);
+BENCHMARK_TEMPLATE(BM_format_log_line_with_specs, wchar_t);
+
+// With manual indexing the format string is interpreted on every call.
+template <class CharT>
+static void BM_format_log_line_manual_indexing(benchmark::State& state) {
+  std::basic_string<CharT> client(CSTR("client"));
+  unsigned request = 0;
+
+  for (auto _ : state) {
+    ++request;
+    benchmark::DoNotOptimize(
+        std::format(CSTR("[info] request {0} took {1} ms for {2}"), request, request % 1000, client));
+  }
+}
+BENCHMARK_TEMPLATE(BM_format_log_line_manual_indexing, char);
+BENCHMARK_TEMPLATE(BM_format_log_line_manual_indexing, wchar_t);
+
 int main(int argc, char** argv) {
   benchmark::Initialize(&argc, argv);
   if (benchmark::ReportUnrecognizedArguments(argc, argv))
@@ -6,6 +6,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <atomic>
 #include <list>
 #include <memory_resource>
 
@@ -25,4 +26,33 @@ static void bm_list(benchmark::State& state) {
 }
 BENCHMARK(bm_list)->Range(1, 2048);
 
+template <class PoolResource>
+static void bm_pool_list(benchmark::State& state) {
+  static PoolResource resource;
+  for (auto _ : state) {
+    std::pmr::list<int> l(&resource);
+    for (size_t i = 0; i != state.range(); ++i) {
+      l.push_back(1);
+      benchmark::DoNotOptimize(l);
+    }
+  }
+}
+BENCHMARK_TEMPLATE(bm_pool_list, std::pmr::unsynchronized_pool_resource)->Range(1, 2048);
+BENCHMARK_TEMPLATE(bm_pool_list, std::pmr::synchronized_pool_resource)->Range(1, 2048)->ThreadRange(1, 8)->UseRealTime();
+
+// Every thread frees the nodes allocated by another one, so the blocks keep moving between the threads.
+static void bm_synchronized_pool_handoff(benchmark::State& state) {
+  static std::pmr::synchronized_pool_resource resource;
+  static std::atomic<std::pmr::list<int>*> slot{nullptr};
+  for (auto _ : state) {
+    auto* l = new std::pmr::list<int>(&resource);
+    for (size_t i = 0; i != state.range(); ++i)
+      l->push_back(1);
+    benchmark::DoNotOptimize(l);
+    delete slot.exchange(l);
+  }
+  delete slot.exchange(nullptr);
+}
+BENCHMARK(bm_synchronized_pool_handoff)->Arg(64)->ThreadRange(1, 8)->UseRealTime();
+
 BENCHMARK_MAIN();
@@ -0,0 +1,50 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include <regex>
+#include <string>
+
+#include "benchmark/benchmark.h"
+#include "test_macros.h"
+
+// Build with -D_LIBCPP_ABI_REGEX_LINEAR_TIME_SEARCH to compare the linear time
+// search against the backtracking one.
+
+static const char* const LogLine =
+    "2023-05-01 12:34:56 INFO [worker-7] request id=4711 path=/api/v1/items took 35ms";
+
+static void BM_RegexSearch(benchmark::State& state, const char* pattern) {
+  std::string line = LogLine;
+  std::regex re(pattern);
+  std::smatch m;
+  for (auto _ : state)
+    benchmark::DoNotOptimize(std::regex_search(line, m, re));
+}
+BENCHMARK_CAPTURE(BM_RegexSearch, literal, "took");
+BENCHMARK_CAPTURE(BM_RegexSearch, missing_literal, "error");
+BENCHMARK_CAPTURE(BM_RegexSearch, alternation, "WARN|INFO|ERROR");
+BENCHMARK_CAPTURE(BM_RegexSearch, groups, "id=(\\d+) path=(\\S+)");
+BENCHMARK_CAPTURE(BM_RegexSearch, dotstar, "path=(.*) took (\\d+)ms");
+
+// Nested quantifiers take an exponential time to backtrack over the input.
+static void BM_RegexSearch_nested_quantifiers(benchmark::State& state) {
+  std::string input(state.range(0), 'a');
+  std::regex re("(a|aa)*b");
+  std::smatch m;
+  for (auto _ : state) {
+    try {
+      benchmark::DoNotOptimize(std::regex_search(input, m, re));
+    } catch (const std::regex_error&) {
+      state.SkipWithError("regex_error");
+      break;
+    }
+  }
+}
+BENCHMARK(BM_RegexSearch_nested_quantifiers)->RangeMultiplier(4)->Range(16, 4096);
+
+BENCHMARK_MAIN();
@@ -37,4 +37,28 @@ static void BM_Istream_numbers(benchmark::State &state) {
 }
 
 BENCHMARK(BM_Istream_numbers)->RangeMultiplier(2)->Range(1024, 4096);
+
+static void BM_Ostream_integers(benchmark::State &state) {
+  std::ostringstream s;
+  int i = 0;
+  while (state.KeepRunning()) {
+    s.seekp(0);
+    s << i++ << ' ' << -i << ' ' << std::hex << i << std::dec << ' ';
+    benchmark::DoNotOptimize(s);
+  }
+}
+BENCHMARK(BM_Ostream_integers);
+
+static void BM_Ostream_doubles(benchmark::State &state) {
+  std::ostringstream s;
+  double d = 0.0;
+  while (state.KeepRunning()) {
+    s.seekp(0);
+    d += 0.37;
+    s << d << ' ' << std::fixed << d << ' ' << std::scientific << d << ' ' << std::defaultfloat;
+    benchmark::DoNotOptimize(s);
+  }
+}
+BENCHMARK(BM_Ostream_doubles);
+
 BENCHMARK_MAIN();
@@ -10,8 +10,16 @@
 #ifndef _LIBCPP___ALGORITHM_COUNT_H
 #define _LIBCPP___ALGORITHM_COUNT_H
 
+#include <__algorithm/simd_utils.h>
+#include <__algorithm/unwrap_iter.h>
 #include <__config>
+#include <__functional/identity.h>
+#include <__functional/invoke.h>
 #include <__iterator/iterator_traits.h>
+#include <__type_traits/enable_if.h>
+#include <__type_traits/is_constant_evaluated.h>
+#include <__type_traits/remove_cv.h>
+#include <cstddef>
 
 #if !defined(_LIBCPP_HAS_NO_PRAGMA_SYSTEM_HEADER)
 #  pragma GCC system_header
@@ -19,15 +27,45 @@
 
 _LIBCPP_BEGIN_NAMESPACE_STD
 
+template <class _Diff, class _Iter, class _Sent, class _Tp, class _Proj>
+_LIBCPP_HIDE_FROM_ABI _LIBCPP_CONSTEXPR_SINCE_CXX20 _Diff
+__count_impl(_Iter __first, _Sent __last, const _Tp& __value, _Proj& __proj) {
+  _Diff __r(0);
+  for (; __first != __last; ++__first)
+    if (std::__invoke(__proj, *__first) == __value)
+      ++__r;
+  return __r;
+}
+
+template <class _Diff,
+          class _Tp,
+          class _Up,
+          class _Proj,
+          __enable_if_t<__is_identity<_Proj>::value && __can_vectorize_find<_Tp, _Up>::value, int> = 0>
+_LIBCPP_HIDE_FROM_ABI _LIBCPP_CONSTEXPR_SINCE_CXX20 _Diff
+__count_impl(_Tp* __first, _Tp* __last, const _Up& __value, _Proj&) {
+  if (__libcpp_is_constant_evaluated()) {
+    _Diff __r(0);
+    for (; __first != __last; ++__first)
+      if (*__first == __value)
+        ++__r;
+    return __r;
+  }
+
+  typedef __remove_cv_t<_Tp> _Elem;
+  if (!(static_cast<_Elem>(__value) == __value))
+    return 0;
+  return static_cast<_Diff>(std::__simd_count(
+      __first, static_cast<size_t>(__last - __first), __simd_vector<_Tp>::__to_lane(_Elem(__value))));
+}
+
 template <class _InputIterator, class _Tp>
 _LIBCPP_NODISCARD_EXT inline _LIBCPP_INLINE_VISIBILITY _LIBCPP_CONSTEXPR_SINCE_CXX20
     typename iterator_traits<_InputIterator>::difference_type
     count(_InputIterator __first, _InputIterator __last, const _Tp& __value) {
-  typename iterator_traits<_InputIterator>::difference_type __r(0);
-  for (; __first != __last; ++__first)
-    if (*__first == __value)
-      ++__r;
-  return __r;
+  __identity __proj;
+  return std::__count_impl<typename iterator_traits<_InputIterator>::difference_type>(
+      std::__unwrap_iter(__first), std::__unwrap_iter(__last), __value, __proj);
 }
 
 _LIBCPP_END_NAMESPACE_STD
@@ -9,6 +9,8 @@
 #ifndef _LIBCPP___ALGORITHM_RANGES_EQUAL_H
 #define _LIBCPP___ALGORITHM_RANGES_EQUAL_H
 
+#include <__algorithm/mismatch.h>
+#include <__algorithm/unwrap_iter.h>
 #include <__config>
 #include <__functional/identity.h>
 #include <__functional/invoke.h>
@@ -43,13 +45,24 @@ private:
                     _Pred& __pred,
                     _Proj1& __proj1,
                     _Proj2& __proj2) {
-    while (__first1 != __last1 && __first2 != __last2) {
-      if (!std::invoke(__pred, std::invoke(__proj1, *__first1), std::invoke(__proj2, *__first2)))
+    if constexpr (random_access_iterator<_Iter1> && sized_sentinel_for<_Sent1, _Iter1> &&
+                  random_access_iterator<_Iter2> && sized_sentinel_for<_Sent2, _Iter2>) {
+      // The lengths are known upfront, so the contiguous ranges can go to the vectorized std::__mismatch.
+      if (__last1 - __first1 != __last2 - __first2)
         return false;
-      ++__first1;
-      ++__first2;
+      auto __last1_iter = __first1 + (__last1 - __first1);
+      auto __last1_un   = std::__unwrap_iter(__last1_iter);
+      return std::__mismatch(std::__unwrap_iter(std::move(__first1)), __last1_un,
+                             std::__unwrap_iter(std::move(__first2)), __pred, __proj1, __proj2).first == __last1_un;
+    } else {
+      while (__first1 != __last1 && __first2 != __last2) {
+        if (!std::invoke(__pred, std::invoke(__proj1, *__first1), std::invoke(__proj2, *__first2)))
+          return false;
+        ++__first1;
+        ++__first2;
+      }
+      return __first1 == __last1 && __first2 == __last2;
     }
-    return __first1 == __last1 && __first2 == __last2;
   }
 
 public:
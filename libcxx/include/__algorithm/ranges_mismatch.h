@@ -10,6 +10,8 @@
 #define _LIBCPP___ALGORITHM_RANGES_MISMATCH_H
 
 #include <__algorithm/in_in_result.h>
+#include <__algorithm/mismatch.h>
+#include <__algorithm/unwrap_iter.h>
 #include <__config>
 #include <__functional/identity.h>
 #include <__functional/invoke.h>
@@ -42,13 +44,25 @@ struct __fn {
   mismatch_result<_I1, _I2>
   __go(_I1 __first1, _S1 __last1, _I2 __first2, _S2 __last2,
        _Pred& __pred, _Proj1& __proj1, _Proj2& __proj2) {
-    while (__first1 != __last1 && __first2 != __last2) {
-      if (!std::invoke(__pred, std::invoke(__proj1, *__first1), std::invoke(__proj2, *__first2)))
-        break;
-      ++__first1;
-      ++__first2;
+    if constexpr (random_access_iterator<_I1> && sized_sentinel_for<_S1, _I1> &&
+                  random_access_iterator<_I2> && sized_sentinel_for<_S2, _I2>) {
+      // The shortest range is known upfront, so the contiguous ranges can go to the vectorized std::__mismatch.
+      auto __n1 = __last1 - __first1;
+      auto __n2 = __last2 - __first2;
+      auto __last1_common = __n2 < __n1 ? __first1 + static_cast<iter_difference_t<_I1>>(__n2) : __first1 + __n1;
+      auto __result = std::__mismatch(std::__unwrap_iter(__first1), std::__unwrap_iter(std::move(__last1_common)),
+                                      std::__unwrap_iter(__first2), __pred, __proj1, __proj2);
+      return {std::__rewrap_iter(std::move(__first1), std::move(__result.first)),
+              std::__rewrap_iter(std::move(__first2), std::move(__result.second))};
+    } else {
+      while (__first1 != __last1 && __first2 != __last2) {
+        if (!std::invoke(__pred, std::invoke(__proj1, *__first1), std::invoke(__proj2, *__first2)))
+          break;
+        ++__first1;
+        ++__first2;
+      }
+      return {std::move(__first1), std::move(__first2)};
     }
-    return {std::move(__first1), std::move(__first2)};
   }
 
   template <input_iterator _I1, sentinel_for<_I1> _S1,
@@ -0,0 +1,288 @@
+// -*- C++ -*-
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _LIBCPP___ALGORITHM_SIMD_UTILS_H
+#define _LIBCPP___ALGORITHM_SIMD_UTILS_H
+
+#include <__algorithm/comp.h>
+#include <__config>
+#include <__functional/operations.h>
+#include <__functional/ranges_operations.h>
+#include <__type_traits/integral_constant.h>
+#include <__type_traits/is_integral.h>
+#include <__type_traits/is_same.h>
+#include <__type_traits/is_volatile.h>
+#include <__type_traits/remove_cv.h>
+#include <__type_traits/remove_cvref.h>
+#include <cstddef>
+
+#if !defined(_LIBCPP_HAS_NO_PRAGMA_SYSTEM_HEADER)
+#  pragma GCC system_header
+#endif
+
+_LIBCPP_PUSH_MACROS
+#include <__undef_macros>
+
+// The vectorized algorithms are written with the generic vector extensions of Clang and GCC, and use the widest
+// vector registers the target is compiled for. Everything else uses the scalar loops. 64 bit integers are only
+// vectorized where there is a native comparison for them, since emulating it is slower than the scalar loop.
+#if defined(_LIBCPP_COMPILER_CLANG_BASED) || defined(_LIBCPP_COMPILER_GCC)
+#  if defined(__AVX2__)
+#    define _LIBCPP_NATIVE_VECTOR_BYTES 32
+#  elif defined(__SSE2__) || defined(__ARM_NEON)
+#    define _LIBCPP_NATIVE_VECTOR_BYTES 16
+#  endif
+#endif
+
+#ifdef _LIBCPP_NATIVE_VECTOR_BYTES
+#  define _LIBCPP_HAS_ALGORITHM_VECTOR_UTILS 1
+#else
+#  define _LIBCPP_HAS_ALGORITHM_VECTOR_UTILS 0
+#endif
+
+#if _LIBCPP_HAS_ALGORITHM_VECTOR_UTILS && (defined(__SSE4_1__) || defined(__aarch64__))
+#  define _LIBCPP_NATIVE_VECTOR_HAS_INT64_EQUALITY 1
+#else
+#  define _LIBCPP_NATIVE_VECTOR_HAS_INT64_EQUALITY 0
+#endif
+
+_LIBCPP_BEGIN_NAMESPACE_STD
+
+template <size_t _Size>
+struct __simd_integer_lane {
+  static const bool __vectorizable = false;
+};
+
+template <>
+struct __simd_integer_lane<1> {
+  static const bool __vectorizable = true;
+  typedef unsigned char __lane;
+  typedef unsigned char __mask_lane;
+};
+
+template <>
+struct __simd_integer_lane<2> {
+  static const bool __vectorizable = true;
+  typedef unsigned short __lane;
+  typedef unsigned short __mask_lane;
+};
+
+template <>
+struct __simd_integer_lane<4> {
+  static const bool __vectorizable = true;
+  typedef unsigned int __lane;
+  typedef unsigned int __mask_lane;
+};
+
+template <>
+struct __simd_integer_lane<8> {
+  static const bool __vectorizable = _LIBCPP_NATIVE_VECTOR_HAS_INT64_EQUALITY;
+  typedef unsigned long long __lane;
+  typedef unsigned long long __mask_lane;
+};
+
+// Integers are compared as the unsigned integers of the same size, which compare equal exactly when they have the
+// same value. Floating point numbers are compared as themselves to get the IEEE semantics of ==.
+template <class _Tp, bool = is_integral<_Tp>::value>
+struct __simd_lane_traits {
+  static const bool __vectorizable = false;
+};
+
+template <class _Tp>
+struct __simd_lane_traits<_Tp, true> : __simd_integer_lane<sizeof(_Tp)> {};
+
+template <>
+struct __simd_lane_traits<bool, true> {
+  static const bool __vectorizable = false;
+};
+
+template <>
+struct __simd_lane_traits<float, false> {
+  static const bool __vectorizable = sizeof(float) == sizeof(unsigned int);
+  typedef float __lane;
+  typedef unsigned int __mask_lane;
+};
+
+template <>
+struct __simd_lane_traits<double, false> {
+  static const bool __vectorizable = sizeof(double) == sizeof(unsigned long long);
+  typedef double __lane;
+  typedef unsigned long long __mask_lane;
+};
+
+// Whether the algorithms comparing elements of type _Tp for equality have a vectorized implementation. The accesses
+// to volatile elements have to be kept as they are.
+template <class _Tp>
+struct __can_vectorize_equality
+    : integral_constant<bool,
+                        _LIBCPP_HAS_ALGORITHM_VECTOR_UTILS && !is_volatile<_Tp>::value &&
+                            __simd_lane_traits<__remove_cv_t<_Tp> >::__vectorizable> {};
+
+// Whether looking for a _Up among elements of type _Tp is vectorized. Looking for an integer of another type is
+// vectorized too, since it compares equal to an element exactly when it is equal to its conversion to the element
+// type, and to none when it doesn't convert back to itself.
+template <class _Tp, class _Up>
+struct __can_vectorize_find
+    : integral_constant<bool,
+                        __can_vectorize_equality<_Tp>::value &&
+                            (is_same<__remove_cv_t<_Tp>, _Up>::value ||
+                             (is_integral<__remove_cv_t<_Tp> >::value && is_integral<_Up>::value))> {};
+
+// Whether _Pred compares two elements of type _Tp with their operator==.
+template <class _Pred, class _Tp>
+struct __is_equality_predicate : false_type {};
+
+template <class _Tp>
+struct __is_equality_predicate<__equal_to, _Tp> : true_type {};
+
+template <class _Tp>
+struct __is_equality_predicate<equal_to<_Tp>, _Tp> : true_type {};
+
+#if _LIBCPP_STD_VER >= 14
+template <class _Tp>
+struct __is_equality_predicate<equal_to<void>, _Tp> : true_type {};
+#endif
+
+#if _LIBCPP_STD_VER >= 20
+template <class _Tp>
+struct __is_equality_predicate<ranges::equal_to, _Tp> : true_type {};
+#endif
+
+template <class _Tp>
+struct __simd_vector {
+  typedef typename __simd_lane_traits<__remove_cv_t<_Tp> >::__lane __lane;
+  typedef typename __simd_lane_traits<__remove_cv_t<_Tp> >::__mask_lane __mask_lane;
+
+#if _LIBCPP_HAS_ALGORITHM_VECTOR_UTILS
+  typedef __lane __type __attribute__((__vector_size__(_LIBCPP_NATIVE_VECTOR_BYTES)));
+  typedef __mask_lane __mask __attribute__((__vector_size__(_LIBCPP_NATIVE_VECTOR_BYTES)));
+
+  static const size_t __size = _LIBCPP_NATIVE_VECTOR_BYTES / sizeof(__lane);
+
+  _LIBCPP_HIDE_FROM_ABI static __type __load(const _Tp* __ptr) _NOEXCEPT {
+    __type __vec;
+    __builtin_memcpy(&__vec, __ptr, sizeof(__vec));
+    return __vec;
+  }
+
+  _LIBCPP_HIDE_FROM_ABI static __type __broadcast(__lane __value) _NOEXCEPT {
+    __type __vec;
+    for (size_t __i = 0; __i != __size; ++__i)
+      __vec[__i] = __value;
+    return __vec;
+  }
+
+  // The lanes of the result are all ones where __x and __y are equal and all zeros elsewhere.
+  _LIBCPP_HIDE_FROM_ABI static __mask __equal(__type __x, __type __y) _NOEXCEPT { return (__mask)(__x == __y); }
+
+  _LIBCPP_HIDE_FROM_ABI static bool __any_of(__mask __m) _NOEXCEPT {
+    unsigned long long __words[sizeof(__mask) / sizeof(unsigned long long)];
+    __builtin_memcpy(__words, &__m, sizeof(__m));
+    unsigned long long __any = 0;
+    for (size_t __i = 0; __i != sizeof(__mask) / sizeof(unsigned long long); ++__i)
+      __any |= __words[__i];
+    return __any != 0;
+  }
+#endif // _LIBCPP_HAS_ALGORITHM_VECTOR_UTILS
+
+  _LIBCPP_HIDE_FROM_ABI static __lane __to_lane(__remove_cv_t<_Tp> __x) _NOEXCEPT { return static_cast<__lane>(__x); }
+};
+
+// Returns the offset of the first element of [__first, __first + __n) which is equal to __value, or __n if there is
+// none.
+template <class _Tp>
+_LIBCPP_HIDE_FROM_ABI size_t
+__simd_find(const _Tp* __first, size_t __n, typename __simd_vector<_Tp>::__lane __value) _NOEXCEPT {
+  typedef __simd_vector<_Tp> _Vec;
+  size_t __i = 0;
+#if _LIBCPP_HAS_ALGORITHM_VECTOR_UTILS
+  const size_t __w = _Vec::__size;
+  typename _Vec::__type __values = _Vec::__broadcast(__value);
+  for (; __n - __i >= 4 * __w; __i += 4 * __w) {
+    if (_Vec::__any_of(_Vec::__equal(_Vec::__load(__first + __i), __values) |
+                       _Vec::__equal(_Vec::__load(__first + __i + __w), __values) |
+                       _Vec::__equal(_Vec::__load(__first + __i + 2 * __w), __values) |
+                       _Vec::__equal(_Vec::__load(__first + __i + 3 * __w), __values)))
+      break;
+  }
+  for (; __n - __i >= __w; __i += __w) {
+    if (_Vec::__any_of(_Vec::__equal(_Vec::__load(__first + __i), __values)))
+      break;
+  }
+#endif
+  // Finds the match in the vector containing it, or goes through the elements which don't fill a vector.
+  for (; __i != __n; ++__i) {
+    if (_Vec::__to_lane(__first[__i]) == __value)
+      break;
+  }
+  return __i;
+}
+
+// Returns the number of elements of [__first, __first + __n) which are equal to __value.
+template <class _Tp>
+_LIBCPP_HIDE_FROM_ABI size_t
+__simd_count(const _Tp* __first, size_t __n, typename __simd_vector<_Tp>::__lane __value) _NOEXCEPT {
+  typedef __simd_vector<_Tp> _Vec;
+  size_t __count = 0;
+  size_t __i     = 0;
+#if _LIBCPP_HAS_ALGORITHM_VECTOR_UTILS
+  const size_t __w = _Vec::__size;
+  typename _Vec::__type __values = _Vec::__broadcast(__value);
+  // Each lane of the accumulator counts the matches at its position, and is added to the total before it can wrap.
+  const size_t __max_steps = static_cast<size_t>(static_cast<typename _Vec::__mask_lane>(-1));
+  while (__n - __i >= __w) {
+    size_t __steps = (__n - __i) / __w;
+    if (__steps > __max_steps)
+      __steps = __max_steps;
+    typename _Vec::__mask __counts = typename _Vec::__mask();
+    for (size_t __s = 0; __s != __steps; ++__s, __i += __w)
+      __counts -= _Vec::__equal(_Vec::__load(__first + __i), __values);
+    for (size_t __l = 0; __l != __w; ++__l)
+      __count += static_cast<size_t>(__counts[__l]);
+  }
+#endif
+  for (; __i != __n; ++__i) {
+    if (_Vec::__to_lane(__first[__i]) == __value)
+      ++__count;
+  }
+  return __count;
+}
+
+// Returns the offset of the first position at which [__first1, __first1 + __n) and [__first2, __first2 + __n) hold
+// elements which aren't equal, or __n if there is none.
+template <class _Tp>
+_LIBCPP_HIDE_FROM_ABI size_t __simd_mismatch(const _Tp* __first1, const _Tp* __first2, size_t __n) _NOEXCEPT {
+  typedef __simd_vector<_Tp> _Vec;
+  size_t __i = 0;
+#if _LIBCPP_HAS_ALGORITHM_VECTOR_UTILS
+  const size_t __w = _Vec::__size;
+  for (; __n - __i >= 4 * __w; __i += 4 * __w) {
+    if (_Vec::__any_of(~(_Vec::__equal(_Vec::__load(__first1 + __i), _Vec::__load(__first2 + __i)) &
+                         _Vec::__equal(_Vec::__load(__first1 + __i + __w), _Vec::__load(__first2 + __i + __w)) &
+                         _Vec::__equal(_Vec::__load(__first1 + __i + 2 * __w), _Vec::__load(__first2 + __i + 2 * __w)) &
+                         _Vec::__equal(_Vec::__load(__first1 + __i + 3 * __w), _Vec::__load(__first2 + __i + 3 * __w)))))
+      break;
+  }
+  for (; __n - __i >= __w; __i += __w) {
+    if (_Vec::__any_of(~_Vec::__equal(_Vec::__load(__first1 + __i), _Vec::__load(__first2 + __i))))
+      break;
+  }
+#endif
+  for (; __i != __n; ++__i) {
+    if (!(_Vec::__to_lane(__first1[__i]) == _Vec::__to_lane(__first2[__i])))
+      break;
+  }
+  return __i;
+}
+
+_LIBCPP_END_NAMESPACE_STD
+
+_LIBCPP_POP_MACROS
+
+#endif // _LIBCPP___ALGORITHM_SIMD_UTILS_H
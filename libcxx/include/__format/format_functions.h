@@ -34,6 +34,7 @@
 #include <__format/formatter_char.h>
 #include <__format/formatter_floating_point.h>
 #include <__format/formatter_integer.h>
+#include <__format/formatter_output.h>
 #include <__format/formatter_pointer.h>
 #include <__format/formatter_string.h>
 #include <__format/parser_std_format_spec.h>
@@ -325,14 +326,206 @@ __vformat_to(_ParseCtx&& __parse_ctx, _Ctx&& __ctx) {
         std::__throw_format_error("The format string contains an invalid escape sequence");
 
       break;
+
+    default: {
+      // Copy the text up to the next brace in one go, writing it one
+      // character at a time through the output iterator is a lot slower.
+      auto __first = __begin;
+      do
+        ++__begin;
+      while (__begin != __end && *__begin != _CharT('{') && *__begin != _CharT('}'));
+
+      if constexpr (!same_as<_Ctx, __compile_time_basic_format_context<_CharT>>)
+        __out_it = __formatter::__copy(basic_string_view<_CharT>{__first, __begin}, _VSTD::move(__out_it));
+
+      continue;
+    }
     }
 
-    // Copy the character to the output verbatim.
+    // Copy the escaped brace to the output verbatim.
     *__out_it++ = *__begin++;
   }
   return __out_it;
 }
 
+// _LIBCPP_ABI_COMPILED_FORMAT_STRING makes basic_format_string keep the format string it parses at compile time in a
+// __compiled_format_string, which the format functions use instead of interpreting the format string again. It can
+// be turned on with LIBCXX_ABI_DEFINES. This is an ABI break, since it changes the layout of basic_format_string.
+#  if defined(_LIBCPP_ABI_COMPILED_FORMAT_STRING)
+
+template <class _CharT, class _Tp>
+consteval auto __format_arg_value_type() {
+  if constexpr (!__formattable<_Tp, _CharT>)
+    return type_identity<void>{};
+  else {
+    constexpr __arg_t __arg = __format::__determine_arg_t<__compile_time_basic_format_context<_CharT>, _Tp>();
+    if constexpr (__arg == __arg_t::__boolean)
+      return type_identity<bool>{};
+    else if constexpr (__arg == __arg_t::__char_type)
+      return type_identity<_CharT>{};
+    else if constexpr (__arg == __arg_t::__int)
+      return type_identity<int>{};
+    else if constexpr (__arg == __arg_t::__long_long)
+      return type_identity<long long>{};
+#  ifndef _LIBCPP_HAS_NO_INT128
+    else if constexpr (__arg == __arg_t::__i128)
+      return type_identity<__int128_t>{};
+#  endif
+    else if constexpr (__arg == __arg_t::__unsigned)
+      return type_identity<unsigned>{};
+    else if constexpr (__arg == __arg_t::__unsigned_long_long)
+      return type_identity<unsigned long long>{};
+#  ifndef _LIBCPP_HAS_NO_INT128
+    else if constexpr (__arg == __arg_t::__u128)
+      return type_identity<__uint128_t>{};
+#  endif
+    else if constexpr (__arg == __arg_t::__float)
+      return type_identity<float>{};
+    else if constexpr (__arg == __arg_t::__double)
+      return type_identity<double>{};
+    else if constexpr (__arg == __arg_t::__long_double)
+      return type_identity<long double>{};
+    else if constexpr (__arg == __arg_t::__const_char_type_ptr)
+      return type_identity<const _CharT*>{};
+    else if constexpr (__arg == __arg_t::__string_view)
+      return type_identity<basic_string_view<_CharT>>{};
+    else if constexpr (__arg == __arg_t::__ptr)
+      return type_identity<const void*>{};
+    else
+      return type_identity<void>{};
+  }
+}
+
+/// The type a formatting argument of type \c _Tp is stored as in a \ref
+/// basic_format_arg, or \c void when it's stored as a handle or isn't formattable.
+template <class _CharT, class _Tp>
+using __format_arg_value_t = typename decltype(__format::__format_arg_value_type<_CharT, remove_cvref_t<_Tp>>())::type;
+
+template <class _Tp, class _Context>
+_LIBCPP_HIDE_FROM_ABI _Tp __get_format_arg_value(const basic_format_arg<_Context>& __arg) {
+  if constexpr (same_as<_Tp, bool>)
+    return __arg.__value_.__boolean_;
+  else if constexpr (same_as<_Tp, typename _Context::char_type>)
+    return __arg.__value_.__char_type_;
+  else if constexpr (same_as<_Tp, int>)
+    return __arg.__value_.__int_;
+  else if constexpr (same_as<_Tp, long long>)
+    return __arg.__value_.__long_long_;
+#  ifndef _LIBCPP_HAS_NO_INT128
+  else if constexpr (same_as<_Tp, __int128_t>)
+    return __arg.__value_.__i128_;
+#  endif
+  else if constexpr (same_as<_Tp, unsigned>)
+    return __arg.__value_.__unsigned_;
+  else if constexpr (same_as<_Tp, unsigned long long>)
+    return __arg.__value_.__unsigned_long_long_;
+#  ifndef _LIBCPP_HAS_NO_INT128
+  else if constexpr (same_as<_Tp, __uint128_t>)
+    return __arg.__value_.__u128_;
+#  endif
+  else if constexpr (same_as<_Tp, float>)
+    return __arg.__value_.__float_;
+  else if constexpr (same_as<_Tp, double>)
+    return __arg.__value_.__double_;
+  else if constexpr (same_as<_Tp, long double>)
+    return __arg.__value_.__long_double_;
+  else if constexpr (same_as<_Tp, const typename _Context::char_type*>)
+    return __arg.__value_.__const_char_type_ptr_;
+  else if constexpr (same_as<_Tp, basic_string_view<typename _Context::char_type>>)
+    return __arg.__value_.__string_view_;
+  else
+    return __arg.__value_.__ptr_;
+}
+
+/// The format string of a \ref basic_format_string, parsed at compile time.
+///
+/// When the replacement fields use automatic indexing, the n-th replacement
+/// field formats the n-th argument. If the types of the arguments are known to
+/// have a formatter which can be parsed in a constant expression, the format
+/// string is split at compile time in the literal text between the fields and
+/// the formatters of the arguments, with their format-spec already parsed.
+/// Formatting then no longer parses the format string, nor looks up the type
+/// of the arguments, it writes each piece of literal text and formats each
+/// argument with its formatter in turn.
+///
+/// Format strings with escaped braces, manual indexing or replacement fields
+/// not in the order of the arguments, for example after a nested replacement
+/// field for a width, are interpreted at run time.
+template <class _CharT, class... _Args>
+class _LIBCPP_TEMPLATE_VIS __compiled_format_string {
+public:
+  // Arguments which are formatted by a handle use a formatter which may not
+  // be usable in a constant expression.
+  static constexpr bool __enabled = (!is_void_v<__format_arg_value_t<_CharT, _Args>> && ...);
+
+  __compiled_format_string() = default;
+
+  /// \pre \c __fmt is a valid format string for \c _Args.
+  consteval explicit __compiled_format_string(basic_string_view<_CharT> __fmt) {
+    if constexpr (__enabled) {
+      basic_format_parse_context<_CharT> __parse_ctx{__fmt, sizeof...(_Args)};
+      auto __begin = __fmt.begin();
+      auto __end   = __fmt.end();
+      while (true) {
+        auto __first = __begin;
+        while (__begin != __end && *__begin != _CharT('{') && *__begin != _CharT('}'))
+          ++__begin;
+        __literals_[__fields_] = basic_string_view<_CharT>{__first, __begin};
+        if (__begin == __end)
+          break;
+
+        // The format string has been validated, so a '{' is followed by its
+        // arg-id, format-spec or '}', a '}' is escaped.
+        if (*__begin == _CharT('}'))
+          return;
+        ++__begin;
+        if (*__begin != _CharT('}') && *__begin != _CharT(':'))
+          return;
+        if (__parse_ctx.next_arg_id() != __fields_)
+          return;
+
+        if (*__begin == _CharT(':')) {
+          __parse_ctx.advance_to(__begin + 1);
+          [&]<size_t... _Is>(index_sequence<_Is...>) {
+            ((_Is == __fields_ ? __parse_ctx.advance_to(std::get<_Is>(__formatters_).parse(__parse_ctx)) : void()),
+             ...);
+          }(index_sequence_for<_Args...>{});
+          __begin = __parse_ctx.begin();
+        }
+        ++__begin;
+        ++__fields_;
+      }
+      __valid_ = true;
+    }
+  }
+
+  _LIBCPP_HIDE_FROM_ABI bool __valid() const { return __valid_; }
+
+  /// \pre \ref __valid() is \c true.
+  template <class _Ctx>
+  _LIBCPP_HIDE_FROM_ABI auto __format(_Ctx& __ctx) const -> decltype(__ctx.out()) {
+    [&]<size_t... _Is>(index_sequence<_Is...>) {
+      (void)((_Is < __fields_ &&
+              (__ctx.advance_to(__formatter::__copy(__literals_[_Is], __ctx.out())),
+               __ctx.advance_to(std::get<_Is>(__formatters_)
+                                    .format(__format::__get_format_arg_value<__format_arg_value_t<_CharT, _Args>>(
+                                                __ctx.arg(_Is)),
+                                            __ctx)),
+               true)) &&
+             ...);
+    }(index_sequence_for<_Args...>{});
+    return __formatter::__copy(__literals_[__fields_], __ctx.out());
+  }
+
+private:
+  bool __valid_    = false;
+  size_t __fields_ = 0;
+  array<basic_string_view<_CharT>, sizeof...(_Args) + 1> __literals_{};
+  conditional_t<__enabled, tuple<formatter<__format_arg_value_t<_CharT, _Args>, _CharT>...>, tuple<>> __formatters_{};
+};
+
+#  endif // defined(_LIBCPP_ABI_COMPILED_FORMAT_STRING)
+
 } // namespace __format
 
 template <class _CharT, class... _Args>
@@ -342,14 +535,26 @@ struct _LIBCPP_TEMPLATE_VIS basic_format_string {
   consteval basic_format_string(const _Tp& __str) : __str_{__str} {
     __format::__vformat_to(basic_format_parse_context<_CharT>{__str_, sizeof...(_Args)},
                            _Context{__types_.data(), __handles_.data(), sizeof...(_Args)});
+#  if defined(_LIBCPP_ABI_COMPILED_FORMAT_STRING)
+    __compiled_ = __format::__compiled_format_string<_CharT, _Args...>{__str_};
+#  endif
   }
 
   _LIBCPP_HIDE_FROM_ABI _LIBCPP_AVAILABILITY_FORMAT constexpr basic_string_view<_CharT> get() const noexcept {
     return __str_;
   }
 
+#  if defined(_LIBCPP_ABI_COMPILED_FORMAT_STRING)
+  _LIBCPP_HIDE_FROM_ABI const __format::__compiled_format_string<_CharT, _Args...>& __compiled() const noexcept {
+    return __compiled_;
+  }
+#  endif
+
 private:
   basic_string_view<_CharT> __str_;
+#  if defined(_LIBCPP_ABI_COMPILED_FORMAT_STRING)
+  __format::__compiled_format_string<_CharT, _Args...> __compiled_;
+#  endif
 
   using _Context = __format::__compile_time_basic_format_context<_CharT>;
 
@@ -389,17 +594,41 @@ template <class... _Args>
 using wformat_string = basic_format_string<wchar_t, type_identity_t<_Args>...>;
 #endif
 
-template <class _OutIt, class _CharT, class _FormatOutIt>
+namespace __format {
+
+template <class _CharT, class _Ctx>
+_LIBCPP_HIDE_FROM_ABI auto __vformat_to(basic_string_view<_CharT> __fmt, size_t __size, _Ctx&& __ctx)
+    -> decltype(__ctx.out()) {
+  return __format::__vformat_to(basic_format_parse_context{__fmt, __size}, _VSTD::move(__ctx));
+}
+
+// The format functions taking a basic_format_string use its compiled form when
+// available, see __compiled_format_string.
+template <class _CharT, class... _Args, class _Ctx>
+_LIBCPP_HIDE_FROM_ABI auto
+__vformat_to(const basic_format_string<_CharT, _Args...>& __fmt, size_t __size, _Ctx&& __ctx)
+    -> decltype(__ctx.out()) {
+#  if defined(_LIBCPP_ABI_COMPILED_FORMAT_STRING)
+  if constexpr (__compiled_format_string<_CharT, _Args...>::__enabled)
+    if (__fmt.__compiled().__valid())
+      return __fmt.__compiled().__format(__ctx);
+#  endif
+  return __format::__vformat_to(__fmt.get(), __size, _VSTD::move(__ctx));
+}
+
+} // namespace __format
+
+template <class _OutIt, class _CharT, class _FormatOutIt, class _Fmt>
 requires(output_iterator<_OutIt, const _CharT&>) _LIBCPP_HIDE_FROM_ABI _OutIt
     __vformat_to(
-        _OutIt __out_it, basic_string_view<_CharT> __fmt,
+        _OutIt __out_it, _Fmt __fmt,
         basic_format_args<basic_format_context<_FormatOutIt, _CharT>> __args) {
   if constexpr (same_as<_OutIt, _FormatOutIt>)
-    return _VSTD::__format::__vformat_to(basic_format_parse_context{__fmt, __args.__size()},
+    return _VSTD::__format::__vformat_to(__fmt, __args.__size(),
                                          _VSTD::__format_context_create(_VSTD::move(__out_it), __args));
   else {
     __format::__format_buffer<_OutIt, _CharT> __buffer{_VSTD::move(__out_it)};
-    _VSTD::__format::__vformat_to(basic_format_parse_context{__fmt, __args.__size()},
+    _VSTD::__format::__vformat_to(__fmt, __args.__size(),
                                   _VSTD::__format_context_create(__buffer.__make_output_iterator(), __args));
     return _VSTD::move(__buffer).__out_it();
   }
@@ -425,16 +654,14 @@ vformat_to(_OutIt __out_it, wstring_view __fmt, wformat_args __args) {
 template <output_iterator<const char&> _OutIt, class... _Args>
 _LIBCPP_ALWAYS_INLINE _LIBCPP_HIDE_FROM_ABI _LIBCPP_AVAILABILITY_FORMAT _OutIt
 format_to(_OutIt __out_it, format_string<_Args...> __fmt, _Args&&... __args) {
-  return _VSTD::vformat_to(_VSTD::move(__out_it), __fmt.get(),
-                           _VSTD::make_format_args(__args...));
+  return _VSTD::__vformat_to(_VSTD::move(__out_it), __fmt, format_args{_VSTD::make_format_args(__args...)});
 }
 
 #ifndef _LIBCPP_HAS_NO_WIDE_CHARACTERS
 template <output_iterator<const wchar_t&> _OutIt, class... _Args>
 _LIBCPP_ALWAYS_INLINE _LIBCPP_HIDE_FROM_ABI _LIBCPP_AVAILABILITY_FORMAT _OutIt
 format_to(_OutIt __out_it, wformat_string<_Args...> __fmt, _Args&&... __args) {
-  return _VSTD::vformat_to(_VSTD::move(__out_it), __fmt.get(),
-                           _VSTD::make_wformat_args(__args...));
+  return _VSTD::__vformat_to(_VSTD::move(__out_it), __fmt, wformat_args{_VSTD::make_wformat_args(__args...)});
 }
 #endif
 
@@ -457,23 +684,27 @@ vformat(wstring_view __fmt, wformat_args __args) {
 template <class... _Args>
 _LIBCPP_ALWAYS_INLINE _LIBCPP_HIDE_FROM_ABI _LIBCPP_AVAILABILITY_FORMAT string format(format_string<_Args...> __fmt,
                                                                                       _Args&&... __args) {
-  return _VSTD::vformat(__fmt.get(), _VSTD::make_format_args(__args...));
+  string __res;
+  _VSTD::__vformat_to(_VSTD::back_inserter(__res), __fmt, format_args{_VSTD::make_format_args(__args...)});
+  return __res;
 }
 
 #ifndef _LIBCPP_HAS_NO_WIDE_CHARACTERS
 template <class... _Args>
 _LIBCPP_ALWAYS_INLINE _LIBCPP_HIDE_FROM_ABI _LIBCPP_AVAILABILITY_FORMAT wstring
 format(wformat_string<_Args...> __fmt, _Args&&... __args) {
-  return _VSTD::vformat(__fmt.get(), _VSTD::make_wformat_args(__args...));
+  wstring __res;
+  _VSTD::__vformat_to(_VSTD::back_inserter(__res), __fmt, wformat_args{_VSTD::make_wformat_args(__args...)});
+  return __res;
 }
 #endif
 
-template <class _Context, class _OutIt, class _CharT>
+template <class _Context, class _OutIt, class _Fmt>
 _LIBCPP_HIDE_FROM_ABI format_to_n_result<_OutIt> __vformat_to_n(_OutIt __out_it, iter_difference_t<_OutIt> __n,
-                                                                basic_string_view<_CharT> __fmt,
+                                                                _Fmt __fmt,
                                                                 basic_format_args<_Context> __args) {
-  __format::__format_to_n_buffer<_OutIt, _CharT> __buffer{_VSTD::move(__out_it), __n};
-  _VSTD::__format::__vformat_to(basic_format_parse_context{__fmt, __args.__size()},
+  __format::__format_to_n_buffer<_OutIt, typename _Context::char_type> __buffer{_VSTD::move(__out_it), __n};
+  _VSTD::__format::__vformat_to(__fmt, __args.__size(),
                                 _VSTD::__format_context_create(__buffer.__make_output_iterator(), __args));
   return _VSTD::move(__buffer).__result();
 }
@@ -481,7 +712,7 @@ _LIBCPP_HIDE_FROM_ABI format_to_n_result<_OutIt> __vformat_to_n(_OutIt __out_it,
 template <output_iterator<const char&> _OutIt, class... _Args>
 _LIBCPP_ALWAYS_INLINE _LIBCPP_HIDE_FROM_ABI _LIBCPP_AVAILABILITY_FORMAT format_to_n_result<_OutIt>
 format_to_n(_OutIt __out_it, iter_difference_t<_OutIt> __n, format_string<_Args...> __fmt, _Args&&... __args) {
-  return _VSTD::__vformat_to_n<format_context>(_VSTD::move(__out_it), __n, __fmt.get(), _VSTD::make_format_args(__args...));
+  return _VSTD::__vformat_to_n<format_context>(_VSTD::move(__out_it), __n, __fmt, _VSTD::make_format_args(__args...));
 }
 
 #ifndef _LIBCPP_HAS_NO_WIDE_CHARACTERS
@@ -489,14 +720,14 @@ template <output_iterator<const wchar_t&> _OutIt, class... _Args>
 _LIBCPP_HIDE_FROM_ABI _LIBCPP_AVAILABILITY_FORMAT format_to_n_result<_OutIt>
 format_to_n(_OutIt __out_it, iter_difference_t<_OutIt> __n, wformat_string<_Args...> __fmt,
             _Args&&... __args) {
-  return _VSTD::__vformat_to_n<wformat_context>(_VSTD::move(__out_it), __n, __fmt.get(), _VSTD::make_wformat_args(__args...));
+  return _VSTD::__vformat_to_n<wformat_context>(_VSTD::move(__out_it), __n, __fmt, _VSTD::make_wformat_args(__args...));
 }
 #endif
 
 template <class _CharT>
-_LIBCPP_HIDE_FROM_ABI size_t __vformatted_size(basic_string_view<_CharT> __fmt, auto __args) {
+_LIBCPP_HIDE_FROM_ABI size_t __vformatted_size(auto __fmt, auto __args) {
   __format::__formatted_size_buffer<_CharT> __buffer;
-  _VSTD::__format::__vformat_to(basic_format_parse_context{__fmt, __args.__size()},
+  _VSTD::__format::__vformat_to(__fmt, __args.__size(),
                                 _VSTD::__format_context_create(__buffer.__make_output_iterator(), __args));
   return _VSTD::move(__buffer).__result();
 }
@@ -504,32 +735,32 @@ _LIBCPP_HIDE_FROM_ABI size_t __vformatted_size(basic_string_view<_CharT> __fmt,
 template <class... _Args>
 _LIBCPP_ALWAYS_INLINE _LIBCPP_HIDE_FROM_ABI _LIBCPP_AVAILABILITY_FORMAT size_t
 formatted_size(format_string<_Args...> __fmt, _Args&&... __args) {
-  return _VSTD::__vformatted_size(__fmt.get(), basic_format_args{_VSTD::make_format_args(__args...)});
+  return _VSTD::__vformatted_size<char>(__fmt, basic_format_args{_VSTD::make_format_args(__args...)});
 }
 
 #ifndef _LIBCPP_HAS_NO_WIDE_CHARACTERS
 template <class... _Args>
 _LIBCPP_ALWAYS_INLINE _LIBCPP_HIDE_FROM_ABI _LIBCPP_AVAILABILITY_FORMAT size_t
 formatted_size(wformat_string<_Args...> __fmt, _Args&&... __args) {
-  return _VSTD::__vformatted_size(__fmt.get(), basic_format_args{_VSTD::make_wformat_args(__args...)});
+  return _VSTD::__vformatted_size<wchar_t>(__fmt, basic_format_args{_VSTD::make_wformat_args(__args...)});
 }
 #endif
 
 #ifndef _LIBCPP_HAS_NO_LOCALIZATION
 
-template <class _OutIt, class _CharT, class _FormatOutIt>
+template <class _OutIt, class _CharT, class _FormatOutIt, class _Fmt>
 requires(output_iterator<_OutIt, const _CharT&>) _LIBCPP_HIDE_FROM_ABI _OutIt
     __vformat_to(
-        _OutIt __out_it, locale __loc, basic_string_view<_CharT> __fmt,
+        _OutIt __out_it, locale __loc, _Fmt __fmt,
         basic_format_args<basic_format_context<_FormatOutIt, _CharT>> __args) {
   if constexpr (same_as<_OutIt, _FormatOutIt>)
     return _VSTD::__format::__vformat_to(
-        basic_format_parse_context{__fmt, __args.__size()},
+        __fmt, __args.__size(),
         _VSTD::__format_context_create(_VSTD::move(__out_it), __args, _VSTD::move(__loc)));
   else {
     __format::__format_buffer<_OutIt, _CharT> __buffer{_VSTD::move(__out_it)};
     _VSTD::__format::__vformat_to(
-        basic_format_parse_context{__fmt, __args.__size()},
+        __fmt, __args.__size(),
         _VSTD::__format_context_create(__buffer.__make_output_iterator(), __args, _VSTD::move(__loc)));
     return _VSTD::move(__buffer).__out_it();
   }
@@ -554,16 +785,16 @@ _LIBCPP_ALWAYS_INLINE _LIBCPP_HIDE_FROM_ABI _LIBCPP_AVAILABILITY_FORMAT _OutIt v
 template <output_iterator<const char&> _OutIt, class... _Args>
 _LIBCPP_ALWAYS_INLINE _LIBCPP_HIDE_FROM_ABI _LIBCPP_AVAILABILITY_FORMAT _OutIt
 format_to(_OutIt __out_it, locale __loc, format_string<_Args...> __fmt, _Args&&... __args) {
-  return _VSTD::vformat_to(_VSTD::move(__out_it), _VSTD::move(__loc), __fmt.get(),
-                           _VSTD::make_format_args(__args...));
+  return _VSTD::__vformat_to(_VSTD::move(__out_it), _VSTD::move(__loc), __fmt,
+                             format_args{_VSTD::make_format_args(__args...)});
 }
 
 #ifndef _LIBCPP_HAS_NO_WIDE_CHARACTERS
 template <output_iterator<const wchar_t&> _OutIt, class... _Args>
 _LIBCPP_ALWAYS_INLINE _LIBCPP_HIDE_FROM_ABI _LIBCPP_AVAILABILITY_FORMAT _OutIt
 format_to(_OutIt __out_it, locale __loc, wformat_string<_Args...> __fmt, _Args&&... __args) {
-  return _VSTD::vformat_to(_VSTD::move(__out_it), _VSTD::move(__loc), __fmt.get(),
-                           _VSTD::make_wformat_args(__args...));
+  return _VSTD::__vformat_to(_VSTD::move(__out_it), _VSTD::move(__loc), __fmt,
+                             wformat_args{_VSTD::make_wformat_args(__args...)});
 }
 #endif
 
@@ -589,26 +820,30 @@ template <class... _Args>
 _LIBCPP_ALWAYS_INLINE _LIBCPP_HIDE_FROM_ABI _LIBCPP_AVAILABILITY_FORMAT string format(locale __loc,
                                                                                       format_string<_Args...> __fmt,
                                                                                       _Args&&... __args) {
-  return _VSTD::vformat(_VSTD::move(__loc), __fmt.get(),
-                        _VSTD::make_format_args(__args...));
+  string __res;
+  _VSTD::__vformat_to(_VSTD::back_inserter(__res), _VSTD::move(__loc), __fmt,
+                      format_args{_VSTD::make_format_args(__args...)});
+  return __res;
 }
 
 #ifndef _LIBCPP_HAS_NO_WIDE_CHARACTERS
 template <class... _Args>
 _LIBCPP_ALWAYS_INLINE _LIBCPP_HIDE_FROM_ABI _LIBCPP_AVAILABILITY_FORMAT wstring
 format(locale __loc, wformat_string<_Args...> __fmt, _Args&&... __args) {
-  return _VSTD::vformat(_VSTD::move(__loc), __fmt.get(),
-                        _VSTD::make_wformat_args(__args...));
+  wstring __res;
+  _VSTD::__vformat_to(_VSTD::back_inserter(__res), _VSTD::move(__loc), __fmt,
+                      wformat_args{_VSTD::make_wformat_args(__args...)});
+  return __res;
 }
 #endif
 
-template <class _Context, class _OutIt, class _CharT>
+template <class _Context, class _OutIt, class _Fmt>
 _LIBCPP_HIDE_FROM_ABI format_to_n_result<_OutIt> __vformat_to_n(_OutIt __out_it, iter_difference_t<_OutIt> __n,
-                                                                locale __loc, basic_string_view<_CharT> __fmt,
+                                                                locale __loc, _Fmt __fmt,
                                                                 basic_format_args<_Context> __args) {
-  __format::__format_to_n_buffer<_OutIt, _CharT> __buffer{_VSTD::move(__out_it), __n};
+  __format::__format_to_n_buffer<_OutIt, typename _Context::char_type> __buffer{_VSTD::move(__out_it), __n};
   _VSTD::__format::__vformat_to(
-      basic_format_parse_context{__fmt, __args.__size()},
+      __fmt, __args.__size(),
       _VSTD::__format_context_create(__buffer.__make_output_iterator(), __args, _VSTD::move(__loc)));
   return _VSTD::move(__buffer).__result();
 }
@@ -617,7 +852,7 @@ template <output_iterator<const char&> _OutIt, class... _Args>
 _LIBCPP_ALWAYS_INLINE _LIBCPP_HIDE_FROM_ABI _LIBCPP_AVAILABILITY_FORMAT format_to_n_result<_OutIt>
 format_to_n(_OutIt __out_it, iter_difference_t<_OutIt> __n, locale __loc, format_string<_Args...> __fmt,
             _Args&&... __args) {
-  return _VSTD::__vformat_to_n<format_context>(_VSTD::move(__out_it), __n, _VSTD::move(__loc), __fmt.get(),
+  return _VSTD::__vformat_to_n<format_context>(_VSTD::move(__out_it), __n, _VSTD::move(__loc), __fmt,
                                                _VSTD::make_format_args(__args...));
 }
 
@@ -626,16 +861,16 @@ template <output_iterator<const wchar_t&> _OutIt, class... _Args>
 _LIBCPP_ALWAYS_INLINE _LIBCPP_HIDE_FROM_ABI _LIBCPP_AVAILABILITY_FORMAT format_to_n_result<_OutIt>
 format_to_n(_OutIt __out_it, iter_difference_t<_OutIt> __n, locale __loc, wformat_string<_Args...> __fmt,
             _Args&&... __args) {
-  return _VSTD::__vformat_to_n<wformat_context>(_VSTD::move(__out_it), __n, _VSTD::move(__loc), __fmt.get(),
+  return _VSTD::__vformat_to_n<wformat_context>(_VSTD::move(__out_it), __n, _VSTD::move(__loc), __fmt,
                                                 _VSTD::make_wformat_args(__args...));
 }
 #endif
 
 template <class _CharT>
-_LIBCPP_HIDE_FROM_ABI size_t __vformatted_size(locale __loc, basic_string_view<_CharT> __fmt, auto __args) {
+_LIBCPP_HIDE_FROM_ABI size_t __vformatted_size(locale __loc, auto __fmt, auto __args) {
   __format::__formatted_size_buffer<_CharT> __buffer;
   _VSTD::__format::__vformat_to(
-      basic_format_parse_context{__fmt, __args.__size()},
+      __fmt, __args.__size(),
       _VSTD::__format_context_create(__buffer.__make_output_iterator(), __args, _VSTD::move(__loc)));
   return _VSTD::move(__buffer).__result();
 }
@@ -643,14 +878,14 @@ _LIBCPP_HIDE_FROM_ABI size_t __vformatted_size(locale __loc, basic_string_view<_
 template <class... _Args>
 _LIBCPP_ALWAYS_INLINE _LIBCPP_HIDE_FROM_ABI _LIBCPP_AVAILABILITY_FORMAT size_t
 formatted_size(locale __loc, format_string<_Args...> __fmt, _Args&&... __args) {
-  return _VSTD::__vformatted_size(_VSTD::move(__loc), __fmt.get(), basic_format_args{_VSTD::make_format_args(__args...)});
+  return _VSTD::__vformatted_size<char>(_VSTD::move(__loc), __fmt, basic_format_args{_VSTD::make_format_args(__args...)});
 }
 
 #ifndef _LIBCPP_HAS_NO_WIDE_CHARACTERS
 template <class... _Args>
 _LIBCPP_ALWAYS_INLINE _LIBCPP_HIDE_FROM_ABI _LIBCPP_AVAILABILITY_FORMAT size_t
 formatted_size(locale __loc, wformat_string<_Args...> __fmt, _Args&&... __args) {
-  return _VSTD::__vformatted_size(_VSTD::move(__loc), __fmt.get(), basic_format_args{_VSTD::make_wformat_args(__args...)});
+  return _VSTD::__vformatted_size<wchar_t>(_VSTD::move(__loc), __fmt, basic_format_args{_VSTD::make_wformat_args(__args...)});
 }
 #endif
 
@@ -11,6 +11,7 @@
 #define _LIBCPP___FUNCTIONAL_IDENTITY_H
 
 #include <__config>
+#include <__type_traits/integral_constant.h>
 #include <__utility/forward.h>
 
 #if !defined(_LIBCPP_HAS_NO_PRAGMA_SYSTEM_HEADER)
@@ -28,6 +29,12 @@ struct __identity {
   using is_transparent = void;
 };
 
+template <class _Tp>
+struct __is_identity : false_type {};
+
+template <>
+struct __is_identity<__identity> : true_type {};
+
 #if _LIBCPP_STD_VER > 17
 
 struct identity {
@@ -39,6 +46,9 @@ struct identity {
 
     using is_transparent = void;
 };
+
+template <>
+struct __is_identity<identity> : true_type {};
 #endif // _LIBCPP_STD_VER > 17
 
 _LIBCPP_END_NAMESPACE_STD
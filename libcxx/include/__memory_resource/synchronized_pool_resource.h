@@ -22,6 +22,15 @@
 #  pragma GCC system_header
 #endif
 
+// _LIBCPP_ABI_SYNCHRONIZED_POOL_RESOURCE_THREAD_CACHES gives every thread using a synchronized_pool_resource its own
+// lists of free blocks, so that most allocations and deallocations don't lock the resource. It can be turned on with
+// LIBCXX_ABI_DEFINES. This is an ABI break, since it changes the layout of synchronized_pool_resource and moves its
+// members into the dylib.
+#if defined(_LIBCPP_ABI_SYNCHRONIZED_POOL_RESOURCE_THREAD_CACHES) && !defined(_LIBCPP_HAS_NO_THREADS) &&                \
+    !defined(_LIBCPP_HAS_NO_ATOMIC_HEADER)
+#  define _LIBCPP_HAS_SYNCHRONIZED_POOL_RESOURCE_THREAD_CACHES
+#endif
+
 #if _LIBCPP_STD_VER > 14
 
 _LIBCPP_BEGIN_NAMESPACE_STD
@@ -32,8 +41,12 @@ namespace pmr {
 
 class _LIBCPP_TYPE_VIS synchronized_pool_resource : public memory_resource {
 public:
+#  if defined(_LIBCPP_HAS_SYNCHRONIZED_POOL_RESOURCE_THREAD_CACHES)
+  synchronized_pool_resource(const pool_options& __opts, memory_resource* __upstream);
+#  else
   _LIBCPP_HIDE_FROM_ABI synchronized_pool_resource(const pool_options& __opts, memory_resource* __upstream)
       : __unsync_(__opts, __upstream) {}
+#  endif
 
   _LIBCPP_HIDE_FROM_ABI synchronized_pool_resource()
       : synchronized_pool_resource(pool_options(), get_default_resource()) {}
@@ -46,43 +59,75 @@ public:
 
   synchronized_pool_resource(const synchronized_pool_resource&) = delete;
 
+#  if defined(_LIBCPP_HAS_SYNCHRONIZED_POOL_RESOURCE_THREAD_CACHES)
+  ~synchronized_pool_resource() override;
+#  else
   ~synchronized_pool_resource() override = default;
+#  endif
 
   synchronized_pool_resource& operator=(const synchronized_pool_resource&) = delete;
 
+#  if defined(_LIBCPP_HAS_SYNCHRONIZED_POOL_RESOURCE_THREAD_CACHES)
+  void release();
+#  else
   _LIBCPP_HIDE_FROM_ABI void release() {
-#  if !defined(_LIBCPP_HAS_NO_THREADS)
+#    if !defined(_LIBCPP_HAS_NO_THREADS)
     unique_lock<mutex> __lk(__mut_);
-#  endif
+#    endif
     __unsync_.release();
   }
+#  endif
 
   _LIBCPP_HIDE_FROM_ABI memory_resource* upstream_resource() const { return __unsync_.upstream_resource(); }
 
   _LIBCPP_HIDE_FROM_ABI pool_options options() const { return __unsync_.options(); }
 
 protected:
+#  if defined(_LIBCPP_HAS_SYNCHRONIZED_POOL_RESOURCE_THREAD_CACHES)
+  void* do_allocate(size_t __bytes, size_t __align) override;
+
+  void do_deallocate(void* __p, size_t __bytes, size_t __align) override;
+#  else
   _LIBCPP_HIDE_FROM_ABI_VIRTUAL void* do_allocate(size_t __bytes, size_t __align) override {
-#  if !defined(_LIBCPP_HAS_NO_THREADS)
+#    if !defined(_LIBCPP_HAS_NO_THREADS)
     unique_lock<mutex> __lk(__mut_);
-#  endif
+#    endif
     return __unsync_.allocate(__bytes, __align);
   }
 
   _LIBCPP_HIDE_FROM_ABI_VIRTUAL void do_deallocate(void* __p, size_t __bytes, size_t __align) override {
-#  if !defined(_LIBCPP_HAS_NO_THREADS)
+#    if !defined(_LIBCPP_HAS_NO_THREADS)
     unique_lock<mutex> __lk(__mut_);
-#  endif
+#    endif
     return __unsync_.deallocate(__p, __bytes, __align);
   }
+#  endif
 
   bool do_is_equal(const memory_resource& __other) const noexcept override; // key function
 
 private:
-#  if !defined(_LIBCPP_HAS_NO_THREADS)
+#  if defined(_LIBCPP_HAS_SYNCHRONIZED_POOL_RESOURCE_THREAD_CACHES)
+  struct __free_block;
+  struct __free_list;
+  struct __shared_list;
+  struct __thread_cache;
+  struct __thread_cache_list;
+
+  __thread_cache* __local_cache();
+  void __refill(__free_list& __list, int __i);
+  void __give_back(int __i, __free_block* __first, __free_block* __last);
+  void __detach(__thread_cache* __cache);
+
   mutex __mut_;
-#  endif
   unsynchronized_pool_resource __unsync_;
+  __shared_list* __shared_lists_;
+  __thread_cache* __thread_caches_;
+#  else
+#    if !defined(_LIBCPP_HAS_NO_THREADS)
+  mutex __mut_;
+#    endif
+  unsynchronized_pool_resource __unsync_;
+#  endif
 };
 
 } // namespace pmr
@@ -28,6 +28,9 @@ namespace pmr {
 // [mem.res.pool.overview]
 
 class _LIBCPP_TYPE_VIS unsynchronized_pool_resource : public memory_resource {
+  // synchronized_pool_resource hands out the blocks of the fixed pools to its threads.
+  friend class synchronized_pool_resource;
+
   class __fixed_pool;
 
   class __adhoc_pool {
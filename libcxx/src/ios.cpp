@@ -429,15 +429,6 @@ ios_base::__set_failbit_and_consider_rethrow()
 #endif // _LIBCPP_NO_EXCEPTIONS
 }
 
-bool
-ios_base::sync_with_stdio(bool sync)
-{
-    static bool previous_state = true;
-    bool r = previous_state;
-    previous_state = sync;
-    return r;
-}
-
 _LIBCPP_END_NAMESPACE_STD
 
 _LIBCPP_POP_MACROS
@@ -42,6 +42,7 @@ __asm__("?cout@" _LIBCPP_ABI_NAMESPACE_STR "@std@@3V?$basic_ostream@DU?$char_tra
 ;
 _ALIGNAS_TYPE (__stdoutbuf<char>) static char __cout[sizeof(__stdoutbuf<char>)];
 static mbstate_t mb_cout;
+static __stdoutbuf<char>* cout_buf_ptr;
 
 #ifndef _LIBCPP_HAS_NO_WIDE_CHARACTERS
 _ALIGNAS_TYPE (wostream) _LIBCPP_FUNC_VIS char wcout[sizeof(wostream)]
@@ -51,6 +52,7 @@ __asm__("?wcout@" _LIBCPP_ABI_NAMESPACE_STR "@std@@3V?$basic_ostream@_WU?$char_t
 ;
 _ALIGNAS_TYPE (__stdoutbuf<wchar_t>) static char __wcout[sizeof(__stdoutbuf<wchar_t>)];
 static mbstate_t mb_wcout;
+static __stdoutbuf<wchar_t>* wcout_buf_ptr;
 #endif // _LIBCPP_HAS_NO_WIDE_CHARACTERS
 
 _ALIGNAS_TYPE (ostream) _LIBCPP_FUNC_VIS char cerr[sizeof(ostream)]
@@ -118,7 +120,8 @@ DoIOSInit::DoIOSInit()
     force_locale_initialization();
 
     istream* cin_ptr  = ::new(cin)  istream(::new(__cin)  __stdinbuf <char>(stdin, &mb_cin));
-    ostream* cout_ptr = ::new(cout) ostream(::new(__cout) __stdoutbuf<char>(stdout, &mb_cout));
+    cout_buf_ptr = ::new(__cout) __stdoutbuf<char>(stdout, &mb_cout);
+    ostream* cout_ptr = ::new(cout) ostream(cout_buf_ptr);
     ostream* cerr_ptr = ::new(cerr) ostream(::new(__cerr) __stdoutbuf<char>(stderr, &mb_cerr));
                         ::new(clog) ostream(cerr_ptr->rdbuf());
     cin_ptr->tie(cout_ptr);
@@ -127,7 +130,10 @@ DoIOSInit::DoIOSInit()
 
 #ifndef _LIBCPP_HAS_NO_WIDE_CHARACTERS
     wistream* wcin_ptr  = ::new(wcin)  wistream(::new(__wcin)  __stdinbuf <wchar_t>(stdin, &mb_wcin));
-    wostream* wcout_ptr = ::new(wcout) wostream(::new(__wcout) __stdoutbuf<wchar_t>(stdout, &mb_wcout));
+    wcout_buf_ptr = ::new(__wcout) __stdoutbuf<wchar_t>(stdout, &mb_wcout);
+    // wcout writes to stdout too, so what cout buffered has to be written first.
+    wcout_buf_ptr->__write_after(cout_buf_ptr);
+    wostream* wcout_ptr = ::new(wcout) wostream(wcout_buf_ptr);
     wostream* wcerr_ptr = ::new(wcerr) wostream(::new(__wcerr) __stdoutbuf<wchar_t>(stderr, &mb_wcerr));
                           ::new(wclog) wostream(wcerr_ptr->rdbuf());
 
@@ -161,4 +167,22 @@ ios_base::Init::~Init()
 {
 }
 
+bool
+ios_base::sync_with_stdio(bool sync)
+{
+    static bool previous_state = true;
+    bool r = previous_state;
+    previous_state = sync;
+    // This can be called before the streams are initialized, by the
+    // constructor of a static object in another translation unit.
+    ios_base::Init init_the_streams;
+    // Once unsynchronized, cout buffers its output. cerr and wcerr are
+    // unit-buffered so they wouldn't gain anything from it.
+    cout_buf_ptr->__sync_with_stdio(sync);
+#ifndef _LIBCPP_HAS_NO_WIDE_CHARACTERS
+    wcout_buf_ptr->__sync_with_stdio(sync);
+#endif
+    return r;
+}
+
 _LIBCPP_END_NAMESPACE_STD
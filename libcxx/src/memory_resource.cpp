@@ -408,6 +408,267 @@ void unsynchronized_pool_resource::do_deallocate(void* p, size_t bytes, size_t a
 
 bool synchronized_pool_resource::do_is_equal(const memory_resource& other) const noexcept { return &other == this; }
 
+#if defined(_LIBCPP_HAS_SYNCHRONIZED_POOL_RESOURCE_THREAD_CACHES)
+
+// Each thread using a synchronized_pool_resource has a __thread_cache holding a list of free blocks for every fixed
+// pool, which it allocates from and deallocates to without any synchronization. When its list is empty, a thread
+// takes all the blocks the other threads gave back to the resource's lock-free __shared_list, and only when there are
+// none does it lock the resource to take a batch of blocks out of the unsynchronized pool. When its list grows too
+// long, a thread gives a batch back to the shared list. The shared lists are only ever emptied as a whole, so they
+// don't suffer from ABA.
+//
+// The caches live in a fixed number of thread-local slots, and the caches of a resource are linked together: a thread
+// gives the blocks of its caches back when it exits or evicts one, and a resource frees the slots of all the threads
+// when it is released or destroyed. The lists themselves are allocated from the pool, so that releasing it frees
+// everything. The links are guarded by __thread_caches_mutex, which is never destroyed since threads may exit after
+// the static objects are destroyed.
+
+static constinit __libcpp_mutex_t __thread_caches_mutex = _LIBCPP_MUTEX_INITIALIZER;
+
+namespace {
+
+struct __thread_caches_lock {
+  __thread_caches_lock() { __libcpp_mutex_lock(&__thread_caches_mutex); }
+  ~__thread_caches_lock() { __libcpp_mutex_unlock(&__thread_caches_mutex); }
+
+  __thread_caches_lock(const __thread_caches_lock&)            = delete;
+  __thread_caches_lock& operator=(const __thread_caches_lock&) = delete;
+};
+
+} // namespace
+
+// The number of blocks a thread takes from the pool, or gives back to the shared list, at once.
+static size_t batch_size(size_t block_size) {
+  size_t n = 4096 / block_size;
+  return n < 1 ? 1 : (n > 32 ? 32 : n);
+}
+
+struct synchronized_pool_resource::__free_block {
+  __free_block* __next_;
+};
+
+struct synchronized_pool_resource::__free_list {
+  __free_block* __first_ = nullptr;
+  size_t __size_         = 0;
+
+  void __push(void* p) {
+    __free_block* block = static_cast<__free_block*>(p);
+    block->__next_      = __first_;
+    __first_            = block;
+    ++__size_;
+  }
+
+  void* __pop() {
+    __free_block* block = __first_;
+    __first_            = block->__next_;
+    --__size_;
+    return block;
+  }
+};
+
+struct synchronized_pool_resource::__shared_list {
+  atomic<__free_block*> __first_{nullptr};
+};
+
+struct synchronized_pool_resource::__thread_cache {
+  // The resource this cache belongs to, or null if the slot is free.
+  atomic<synchronized_pool_resource*> __owner_{nullptr};
+  __thread_cache* __prev_in_resource_ = nullptr;
+  __thread_cache* __next_in_resource_ = nullptr;
+  __free_list* __lists_               = nullptr;
+};
+
+struct synchronized_pool_resource::__thread_cache_list {
+  // A thread rarely uses many resources at once, when it does it evicts the cache of another one.
+  static const int __size = 8;
+
+  __thread_cache __caches_[__size];
+  int __last_used_    = 0;
+  int __next_evicted_ = 0;
+
+  ~__thread_cache_list() {
+    __thread_caches_lock guard;
+    for (__thread_cache& cache : __caches_)
+      if (synchronized_pool_resource* owner = cache.__owner_.load(memory_order_relaxed))
+        owner->__detach(&cache);
+  }
+};
+
+synchronized_pool_resource::synchronized_pool_resource(const pool_options& opts, memory_resource* upstream)
+    : __unsync_(opts, upstream), __shared_lists_(nullptr), __thread_caches_(nullptr) {}
+
+synchronized_pool_resource::~synchronized_pool_resource() { release(); }
+
+void synchronized_pool_resource::release() {
+  {
+    // The blocks in the caches go away with the pool, and so do the lists themselves.
+    __thread_caches_lock guard;
+    for (__thread_cache* cache = __thread_caches_; cache != nullptr;) {
+      __thread_cache* next       = cache->__next_in_resource_;
+      cache->__prev_in_resource_ = nullptr;
+      cache->__next_in_resource_ = nullptr;
+      cache->__lists_            = nullptr;
+      cache->__owner_.store(nullptr, memory_order_relaxed);
+      cache = next;
+    }
+    __thread_caches_ = nullptr;
+  }
+  unique_lock<mutex> lk(__mut_);
+  __shared_lists_ = nullptr;
+  __unsync_.release();
+}
+
+synchronized_pool_resource::__thread_cache* synchronized_pool_resource::__local_cache() {
+  static thread_local __thread_cache_list caches;
+
+  __thread_cache* cache = &caches.__caches_[caches.__last_used_];
+  if (cache->__owner_.load(memory_order_relaxed) == this)
+    return cache;
+
+  // Only this thread ever makes one of its caches belong to a resource, the other threads only free them.
+  int free_slot = -1;
+  for (int k = 0; k != __thread_cache_list::__size; ++k) {
+    synchronized_pool_resource* owner = caches.__caches_[k].__owner_.load(memory_order_relaxed);
+    if (owner == this) {
+      caches.__last_used_ = k;
+      return &caches.__caches_[k];
+    }
+    if (owner == nullptr && free_slot == -1)
+      free_slot = k;
+  }
+
+  // This is the first time this thread uses this resource.
+  __thread_caches_lock guard;
+  if (free_slot == -1) {
+    free_slot              = caches.__next_evicted_;
+    caches.__next_evicted_ = (free_slot + 1) % __thread_cache_list::__size;
+    if (synchronized_pool_resource* owner = caches.__caches_[free_slot].__owner_.load(memory_order_relaxed))
+      owner->__detach(&caches.__caches_[free_slot]);
+  }
+  cache = &caches.__caches_[free_slot];
+
+  const int n = __unsync_.__num_fixed_pools_;
+  {
+    unique_lock<mutex> lk(__mut_);
+    if (__shared_lists_ == nullptr) {
+      void* p         = __unsync_.allocate(n * sizeof(__shared_list), alignof(__shared_list));
+      __shared_lists_ = static_cast<__shared_list*>(p);
+      for (int i = 0; i < n; ++i)
+        ::new ((void*)(__shared_lists_ + i)) __shared_list;
+    }
+    void* p         = __unsync_.allocate(n * sizeof(__free_list), alignof(__free_list));
+    cache->__lists_ = static_cast<__free_list*>(p);
+    for (int i = 0; i < n; ++i)
+      ::new ((void*)(cache->__lists_ + i)) __free_list;
+  }
+
+  cache->__next_in_resource_ = __thread_caches_;
+  if (__thread_caches_ != nullptr)
+    __thread_caches_->__prev_in_resource_ = cache;
+  __thread_caches_ = cache;
+  cache->__owner_.store(this, memory_order_relaxed);
+  caches.__last_used_ = free_slot;
+  return cache;
+}
+
+void synchronized_pool_resource::__refill(__free_list& list, int i) {
+  // Take all the blocks the other threads gave back, if any.
+  if (__free_block* first = __shared_lists_[i].__first_.exchange(nullptr, memory_order_acquire)) {
+    list.__first_ = first;
+    for (__free_block* block = first; block != nullptr; block = block->__next_)
+      ++list.__size_;
+    return;
+  }
+
+  // Otherwise take the next batch of blocks from the pool, the first allocation carves a new chunk out of the upstream
+  // resource if needed and the others only take the vacancies that are left.
+  const size_t block_size = __unsync_.__pool_block_size(i);
+  const size_t batch      = batch_size(block_size);
+  const size_t align      = block_size < alignof(max_align_t) ? block_size : alignof(max_align_t);
+  unique_lock<mutex> lk(__mut_);
+  list.__push(__unsync_.allocate(block_size, align));
+  while (list.__size_ < batch) {
+    void* p = __unsync_.__fixed_pools_[i].__try_allocate_from_vacancies();
+    if (p == nullptr)
+      break;
+    list.__push(p);
+  }
+}
+
+void synchronized_pool_resource::__give_back(int i, __free_block* first, __free_block* last) {
+  atomic<__free_block*>& shared = __shared_lists_[i].__first_;
+  __free_block* head            = shared.load(memory_order_relaxed);
+  do
+    last->__next_ = head;
+  while (!shared.compare_exchange_weak(head, first, memory_order_release, memory_order_relaxed));
+}
+
+void synchronized_pool_resource::__detach(__thread_cache* cache) {
+  const int n = __unsync_.__num_fixed_pools_;
+  for (int i = 0; i < n; ++i) {
+    __free_list& list = cache->__lists_[i];
+    if (list.__first_ == nullptr)
+      continue;
+    __free_block* last = list.__first_;
+    while (last->__next_ != nullptr)
+      last = last->__next_;
+    __give_back(i, list.__first_, last);
+  }
+  {
+    unique_lock<mutex> lk(__mut_);
+    __unsync_.deallocate(cache->__lists_, n * sizeof(__free_list), alignof(__free_list));
+  }
+
+  if (cache->__prev_in_resource_ != nullptr)
+    cache->__prev_in_resource_->__next_in_resource_ = cache->__next_in_resource_;
+  else
+    __thread_caches_ = cache->__next_in_resource_;
+  if (cache->__next_in_resource_ != nullptr)
+    cache->__next_in_resource_->__prev_in_resource_ = cache->__prev_in_resource_;
+  cache->__prev_in_resource_ = nullptr;
+  cache->__next_in_resource_ = nullptr;
+  cache->__lists_            = nullptr;
+  cache->__owner_.store(nullptr, memory_order_relaxed);
+}
+
+void* synchronized_pool_resource::do_allocate(size_t bytes, size_t align) {
+  int i = __unsync_.__pool_index(bytes, align);
+  if (i == __unsync_.__num_fixed_pools_) {
+    unique_lock<mutex> lk(__mut_);
+    return __unsync_.allocate(bytes, align);
+  }
+
+  __free_list& list = __local_cache()->__lists_[i];
+  if (list.__first_ == nullptr)
+    __refill(list, i);
+  return list.__pop();
+}
+
+void synchronized_pool_resource::do_deallocate(void* p, size_t bytes, size_t align) {
+  int i = __unsync_.__pool_index(bytes, align);
+  if (i == __unsync_.__num_fixed_pools_) {
+    unique_lock<mutex> lk(__mut_);
+    return __unsync_.deallocate(p, bytes, align);
+  }
+
+  __free_list& list = __local_cache()->__lists_[i];
+  list.__push(p);
+
+  // Give a batch back once the list holds more than two of them, for the threads which allocate what this one deallocates.
+  const size_t batch = batch_size(__unsync_.__pool_block_size(i));
+  if (list.__size_ > 2 * batch) {
+    __free_block* first = list.__first_;
+    __free_block* last  = first;
+    for (size_t n = 1; n != batch; ++n)
+      last = last->__next_;
+    list.__first_ = last->__next_;
+    list.__size_ -= batch;
+    __give_back(i, first, last);
+  }
+}
+
+#endif // _LIBCPP_HAS_SYNCHRONIZED_POOL_RESOURCE_THREAD_CACHES
+
 // 23.12.6, mem.res.monotonic.buffer
 
 static void* align_down(size_t align, size_t size, void*& ptr, size_t& space) {
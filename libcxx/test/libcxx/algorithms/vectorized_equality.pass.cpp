@@ -0,0 +1,139 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03
+
+// <algorithm>
+
+// find, count, mismatch and equal are vectorized over the arithmetic types. Make sure they behave like the scalar
+// loops around the end of the vectors, with values of another type and with the IEEE semantics of floating point
+// comparisons.
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <vector>
+
+#include "test_macros.h"
+
+template <class T, class U>
+void test_find_count(const std::vector<T>& vec, U value) {
+  std::ptrdiff_t expected_count = 0;
+  std::size_t expected_pos      = vec.size();
+  for (std::size_t i = 0; i != vec.size(); ++i) {
+    if (vec[i] == value) {
+      ++expected_count;
+      if (expected_pos == vec.size())
+        expected_pos = i;
+    }
+  }
+  assert(std::count(vec.begin(), vec.end(), value) == expected_count);
+  assert(static_cast<std::size_t>(std::find(vec.begin(), vec.end(), value) - vec.begin()) == expected_pos);
+#if TEST_STD_VER >= 20
+  assert(std::ranges::count(vec, value) == expected_count);
+  assert(static_cast<std::size_t>(std::ranges::find(vec, value) - vec.begin()) == expected_pos);
+#endif
+}
+
+template <class T>
+void test_mismatch(const std::vector<T>& vec1, const std::vector<T>& vec2, std::size_t expected) {
+  assert(static_cast<std::size_t>(std::mismatch(vec1.begin(), vec1.end(), vec2.begin()).first - vec1.begin()) ==
+         expected);
+  assert(std::equal(vec1.begin(), vec1.end(), vec2.begin()) == (expected == vec1.size()));
+  assert(std::equal(vec1.begin(), vec1.end(), vec2.begin(), std::equal_to<T>()) == (expected == vec1.size()));
+#if TEST_STD_VER >= 14
+  assert(static_cast<std::size_t>(
+             std::mismatch(vec1.begin(), vec1.end(), vec2.begin(), vec2.end()).first - vec1.begin()) == expected);
+  assert(std::equal(vec1.begin(), vec1.end(), vec2.begin(), vec2.end()) == (expected == vec1.size()));
+#endif
+#if TEST_STD_VER >= 20
+  auto result = std::ranges::mismatch(vec1, vec2);
+  assert(static_cast<std::size_t>(result.in1 - vec1.begin()) == expected);
+  assert(static_cast<std::size_t>(result.in2 - vec2.begin()) == expected);
+  assert(std::ranges::equal(vec1, vec2) == (expected == vec1.size()));
+#endif
+}
+
+template <class T>
+void test() {
+  const std::size_t sizes[] = {0, 1, 7, 15, 16, 17, 31, 32, 33, 63, 64, 65, 127, 128, 129, 255, 1000};
+  for (std::size_t n : sizes) {
+    std::vector<T> vec(n);
+    for (std::size_t i = 0; i != n; ++i)
+      vec[i] = T(i % 7);
+    test_find_count(vec, T(3));
+    test_find_count(vec, T(9));
+    test_find_count(vec, 6);
+    test_find_count(vec, 1000);
+    test_find_count(vec, -1);
+    if (n != 0) {
+      vec.back() = T(-1);
+      test_find_count(vec, T(-1));
+      test_find_count(vec, -1);
+    }
+
+    test_mismatch(vec, vec, n);
+    for (std::size_t i = 0; i < n; i += 1 + i / 3) {
+      std::vector<T> other = vec;
+      other[i]             = T(42);
+      test_mismatch(vec, other, i);
+    }
+  }
+}
+
+int main(int, char**) {
+  test<char>();
+  test<signed char>();
+  test<unsigned char>();
+  test<short>();
+  test<unsigned short>();
+  test<int>();
+  test<unsigned int>();
+  test<long>();
+  test<long long>();
+  test<unsigned long long>();
+  test<float>();
+  test<double>();
+
+  { // The lanes counting the matches don't wrap around.
+    std::vector<unsigned char> bytes(100000, 1);
+    assert(std::count(bytes.begin(), bytes.end(), 1) == 100000);
+    std::vector<short> shorts(200000, 5);
+    assert(std::count(shorts.begin(), shorts.end(), 5) == 200000);
+  }
+
+  { // The value is converted like in a scalar comparison.
+    std::vector<unsigned int> uints(50, std::numeric_limits<unsigned int>::max());
+    assert(std::count(uints.begin(), uints.end(), -1) == 50);
+    std::vector<unsigned char> uchars(50, 255);
+    assert(std::count(uchars.begin(), uchars.end(), -1) == 0);
+    assert(std::find(uchars.begin(), uchars.end(), 255) == uchars.begin());
+    std::vector<signed char> schars(50, -1);
+    assert(std::count(schars.begin(), schars.end(), 255) == 0);
+    assert(std::count(schars.begin(), schars.end(), -1) == 50);
+  }
+
+  { // NaNs are never equal, and signed zeros are.
+    std::vector<float> floats(100, 0.f);
+    floats[50] = -0.f;
+    floats[70] = std::numeric_limits<float>::quiet_NaN();
+    assert(std::count(floats.begin(), floats.end(), 0.f) == 99);
+    assert(std::find(floats.begin(), floats.end(), -0.f) == floats.begin());
+    assert(std::count(floats.begin(), floats.end(), std::numeric_limits<float>::quiet_NaN()) == 0);
+    std::vector<float> copy = floats;
+    assert(std::mismatch(floats.begin(), floats.end(), copy.begin()).first - floats.begin() == 70);
+    copy[50] = 0.f;
+    copy[70] = floats[70] = 1.f;
+    assert(std::equal(floats.begin(), floats.end(), copy.begin()));
+  }
+
+  return 0;
+}
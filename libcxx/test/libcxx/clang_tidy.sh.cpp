@@ -99,6 +99,8 @@ END-SCRIPT
 #if !defined(_LIBCPP_HAS_NO_FILESYSTEM_LIBRARY)
 #   include <filesystem>
 #endif
+#include <flat_map>
+#include <flat_set>
 #include <float.h>
 #include <format>
 #include <forward_list>
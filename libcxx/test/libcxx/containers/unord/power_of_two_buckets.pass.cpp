@@ -0,0 +1,77 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03
+
+// <unordered_set>
+
+// With _LIBCPP_ABI_UNORDERED_CONTAINER_POWER_OF_TWO_BUCKETS, the bucket counts are powers of two and the hashes
+// are spread over all the buckets, even when their low bits are always the same.
+
+// ADDITIONAL_COMPILE_FLAGS: -Wno-macro-redefined -D_LIBCPP_ABI_UNORDERED_CONTAINER_POWER_OF_TWO_BUCKETS
+
+#include <unordered_map>
+#include <unordered_set>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#include "test_macros.h"
+
+bool is_power_of_two(std::size_t n) { return n != 0 && (n & (n - 1)) == 0; }
+
+int main(int, char**) {
+  {
+    std::unordered_set<int> s;
+    for (int i = 0; i < 1000; ++i) {
+      s.insert(i);
+      assert(is_power_of_two(s.bucket_count()));
+    }
+    s.rehash(3000);
+    assert(s.bucket_count() == 4096);
+    s.reserve(100);
+    assert(s.bucket_count() == 1024);
+    s.rehash(5000);
+    assert(s.bucket_count() == 8192);
+    for (int i = 0; i < 1000; ++i)
+      assert(s.count(i) == 1);
+  }
+  {
+    // The addresses of the elements of an array of doubles are all multiples of 8.
+    std::vector<double> objects(1024);
+    std::unordered_set<double*> s;
+    s.max_load_factor(1);
+    for (auto& o : objects)
+      s.insert(&o);
+    std::size_t used = 0;
+    for (std::size_t b = 0; b != s.bucket_count(); ++b) {
+      used += s.bucket_size(b) != 0;
+      for (auto it = s.begin(b); it != s.end(b); ++it)
+        assert(s.bucket(*it) == b);
+    }
+    assert(used > s.bucket_count() / 2);
+    for (auto& o : objects)
+      assert(s.count(&o) == 1);
+  }
+  {
+    std::unordered_multimap<long, int> m;
+    for (int i = 0; i < 500; ++i) {
+      m.emplace(i * 4096L, i);
+      m.emplace(i * 4096L, -i);
+    }
+    assert(is_power_of_two(m.bucket_count()));
+    for (int i = 0; i < 500; ++i)
+      assert(m.count(i * 4096L) == 2);
+    m.erase(0L);
+    m.rehash(0);
+    assert(is_power_of_two(m.bucket_count()));
+    assert(m.size() == 998);
+  }
+
+  return 0;
+}
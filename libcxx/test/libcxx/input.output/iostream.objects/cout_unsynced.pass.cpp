@@ -0,0 +1,79 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: no-filesystem
+
+// <iostream>
+
+// Once unsynchronized from stdio, cout buffers its output. Make sure that the
+// output stays in order when the buffer fills up, when wcout writes to stdout
+// too, when cout is flushed and when it is synchronized again.
+
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+#include "test_macros.h"
+#include "platform_support.h"
+
+static std::string read_file(const std::string& name) {
+  std::ifstream f(name.c_str());
+  return std::string(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+}
+
+int main(int, char**) {
+  std::string temp = get_temp_file_name();
+  FILE* f = std::freopen(temp.c_str(), "w", stdout);
+  assert(f != nullptr);
+
+  std::string expected = "synced ";
+  std::cout << "synced ";
+
+  std::ios_base::sync_with_stdio(false);
+  // Write a lot more than the buffer holds, so that it overflows.
+  for (int i = 0; i < 2000; ++i) {
+    std::cout << i << ' ';
+    expected += std::to_string(i) + ' ';
+  }
+  std::cout.put('c');
+  std::cout.write("write ", 6);
+  expected += "cwrite ";
+
+#ifndef TEST_HAS_NO_WIDE_CHARACTERS
+  std::cout << "narrow ";
+  std::wcout << L"wide ";
+  std::cout.put('n');
+  std::wcout.put(L'w');
+  std::cout << ' ';
+  std::wcout << std::flush;
+  expected += "narrow wide nw ";
+#endif
+
+  std::cout << "flushed" << std::flush;
+  expected += "flushed";
+  std::string flushed = read_file(temp);
+
+  // Synchronizing again writes what is buffered before the C library writes.
+  std::cout << " unsynced";
+  std::ios_base::sync_with_stdio(true);
+  std::fputs(" stdio", stdout);
+  std::cout << " resynced";
+  std::fflush(stdout);
+  std::string resynced = read_file(temp);
+  // Remove the file before checking its contents, so that a failure does not
+  // leave it behind.
+  std::remove(temp.c_str());
+
+  assert(flushed == expected);
+  expected += " unsynced stdio resynced";
+  assert(resynced == expected);
+  return 0;
+}
@@ -0,0 +1,162 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14
+
+// <locale>
+
+// class num_put<charT, OutputIterator>
+
+// From C++17 on, num_put formats the integers, and some of the doubles, with
+// to_chars instead of snprintf. Make sure that the output is the same as the
+// one of the printf format that the standard specifies, over the combinations
+// of flags that the to_chars path handles and the ones it leaves to snprintf.
+
+#include <cassert>
+#include <cstdio>
+#include <ios>
+#include <limits>
+#include <locale>
+#include <string>
+#include <type_traits>
+
+#include "test_macros.h"
+
+typedef std::num_put<char, char*> F;
+
+class my_facet : public F {
+public:
+  explicit my_facet(std::size_t refs = 0) : F(refs) {}
+};
+
+static const my_facet f(1);
+
+template <class T>
+std::string put(T v, std::ios_base::fmtflags flags, std::streamsize precision = 6) {
+  std::ios ios(0);
+  ios.flags(flags);
+  ios.precision(precision);
+  char str[1000];
+  char* end = f.put(str, ios, '*', v);
+  return std::string(str, end);
+}
+
+template <class T>
+std::string expected_integral(T v, std::ios_base::fmtflags flags) {
+  std::string fmt = "%";
+  if (flags & std::ios_base::showpos)
+    fmt += '+';
+  if (flags & std::ios_base::showbase)
+    fmt += '#';
+  fmt += "ll";
+  std::ios_base::fmtflags basefield = flags & std::ios_base::basefield;
+  char buf[100];
+  if (basefield == std::ios_base::oct || basefield == std::ios_base::hex) {
+    fmt += basefield == std::ios_base::oct ? 'o' : (flags & std::ios_base::uppercase) ? 'X' : 'x';
+    // Like printf, num_put prints the octal and hexadecimal values as unsigned.
+    typedef typename std::make_unsigned<T>::type U;
+    std::snprintf(buf, sizeof(buf), fmt.c_str(), static_cast<unsigned long long>(static_cast<U>(v)));
+  } else if (std::is_signed<T>::value) {
+    fmt += 'd';
+    std::snprintf(buf, sizeof(buf), fmt.c_str(), static_cast<long long>(v));
+  } else {
+    fmt += 'u';
+    std::snprintf(buf, sizeof(buf), fmt.c_str(), static_cast<unsigned long long>(v));
+  }
+  return buf;
+}
+
+std::string expected_double(double v, std::ios_base::fmtflags flags, int precision) {
+  std::string fmt = "%";
+  if (flags & std::ios_base::showpos)
+    fmt += '+';
+  if (flags & std::ios_base::showpoint)
+    fmt += '#';
+  fmt += ".*";
+  bool upper = flags & std::ios_base::uppercase;
+  std::ios_base::fmtflags floatfield = flags & std::ios_base::floatfield;
+  if (floatfield == std::ios_base::fixed)
+    fmt += upper ? 'F' : 'f';
+  else if (floatfield == std::ios_base::scientific)
+    fmt += upper ? 'E' : 'e';
+  else
+    fmt += upper ? 'G' : 'g';
+  char buf[1000];
+  std::snprintf(buf, sizeof(buf), fmt.c_str(), precision, v);
+  return buf;
+}
+
+template <class T>
+void test_integral() {
+  const T values[] = {T(0),
+                      T(1),
+                      T(7),
+                      T(42),
+                      T(255),
+                      static_cast<T>(-1),
+                      static_cast<T>(-42),
+                      std::numeric_limits<T>::min(),
+                      std::numeric_limits<T>::max()};
+  const std::ios_base::fmtflags bases[] = {std::ios_base::dec, std::ios_base::oct, std::ios_base::hex};
+  for (T v : values)
+    for (std::ios_base::fmtflags base : bases)
+      for (int extra = 0; extra < 8; ++extra) {
+        std::ios_base::fmtflags flags = base;
+        if (extra & 1)
+          flags |= std::ios_base::showpos;
+        if (extra & 2)
+          flags |= std::ios_base::showbase;
+        if (extra & 4)
+          flags |= std::ios_base::uppercase;
+        assert(put(v, flags) == expected_integral(v, flags));
+      }
+}
+
+void test_double() {
+  const double values[] = {0.0,
+                           -0.0,
+                           1.0,
+                           -1.0,
+                           0.1,
+                           1.5,
+                           123456.789,
+                           1e-10,
+                           -2.5e-300,
+                           1e21,
+                           // Too long in fixed notation for the buffer of the to_chars path.
+                           1e300,
+                           std::numeric_limits<double>::max(),
+                           std::numeric_limits<double>::denorm_min()};
+  const std::ios_base::fmtflags floatfields[] = {
+      std::ios_base::fmtflags(), std::ios_base::fixed, std::ios_base::scientific};
+  const int precisions[] = {0, 1, 3, 6, 17, 40};
+  for (double v : values)
+    for (std::ios_base::fmtflags floatfield : floatfields)
+      for (int precision : precisions)
+        for (int extra = 0; extra < 8; ++extra) {
+          std::ios_base::fmtflags flags = floatfield;
+          // showpoint and uppercase are left to snprintf.
+          if (extra & 1)
+            flags |= std::ios_base::showpos;
+          if (extra & 2)
+            flags |= std::ios_base::showpoint;
+          if (extra & 4)
+            flags |= std::ios_base::uppercase;
+          assert(put(v, flags, precision) == expected_double(v, flags, precision));
+        }
+}
+
+int main(int, char**) {
+  test_integral<long>();
+  test_integral<long long>();
+  test_integral<unsigned long>();
+  test_integral<unsigned long long>();
+  test_double();
+
+  return 0;
+}
@@ -149,6 +149,10 @@ TEST_MACROS();
 #   include <filesystem>
 TEST_MACROS();
 #endif
+#include <flat_map>
+TEST_MACROS();
+#include <flat_set>
+TEST_MACROS();
 #include <float.h>
 TEST_MACROS();
 #include <format>
@@ -216,6 +216,7 @@ END-SCRIPT
 #include <__algorithm/shift_right.h> // expected-error@*:* {{use of private header from outside its module: '__algorithm/shift_right.h'}}
 #include <__algorithm/shuffle.h> // expected-error@*:* {{use of private header from outside its module: '__algorithm/shuffle.h'}}
 #include <__algorithm/sift_down.h> // expected-error@*:* {{use of private header from outside its module: '__algorithm/sift_down.h'}}
+#include <__algorithm/simd_utils.h> // expected-error@*:* {{use of private header from outside its module: '__algorithm/simd_utils.h'}}
 #include <__algorithm/sort.h> // expected-error@*:* {{use of private header from outside its module: '__algorithm/sort.h'}}
 #include <__algorithm/sort_heap.h> // expected-error@*:* {{use of private header from outside its module: '__algorithm/sort_heap.h'}}
 #include <__algorithm/stable_partition.h> // expected-error@*:* {{use of private header from outside its module: '__algorithm/stable_partition.h'}}
@@ -334,6 +335,13 @@ END-SCRIPT
 #include <__filesystem/recursive_directory_iterator.h> // expected-error@*:* {{use of private header from outside its module: '__filesystem/recursive_directory_iterator.h'}}
 #include <__filesystem/space_info.h> // expected-error@*:* {{use of private header from outside its module: '__filesystem/space_info.h'}}
 #include <__filesystem/u8path.h> // expected-error@*:* {{use of private header from outside its module: '__filesystem/u8path.h'}}
+#include <__flat_map/flat_map.h> // expected-error@*:* {{use of private header from outside its module: '__flat_map/flat_map.h'}}
+#include <__flat_map/flat_multimap.h> // expected-error@*:* {{use of private header from outside its module: '__flat_map/flat_multimap.h'}}
+#include <__flat_map/key_value_iterator.h> // expected-error@*:* {{use of private header from outside its module: '__flat_map/key_value_iterator.h'}}
+#include <__flat_map/sorted_equivalent.h> // expected-error@*:* {{use of private header from outside its module: '__flat_map/sorted_equivalent.h'}}
+#include <__flat_map/sorted_unique.h> // expected-error@*:* {{use of private header from outside its module: '__flat_map/sorted_unique.h'}}
+#include <__flat_set/flat_multiset.h> // expected-error@*:* {{use of private header from outside its module: '__flat_set/flat_multiset.h'}}
+#include <__flat_set/flat_set.h> // expected-error@*:* {{use of private header from outside its module: '__flat_set/flat_set.h'}}
 #include <__format/buffer.h> // expected-error@*:* {{use of private header from outside its module: '__format/buffer.h'}}
 #include <__format/concepts.h> // expected-error@*:* {{use of private header from outside its module: '__format/concepts.h'}}
 #include <__format/container_adaptor.h> // expected-error@*:* {{use of private header from outside its module: '__format/container_adaptor.h'}}
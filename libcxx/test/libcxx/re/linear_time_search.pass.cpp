@@ -0,0 +1,114 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03
+
+// <regex>
+
+// With _LIBCPP_ABI_REGEX_LINEAR_TIME_SEARCH, the ECMAScript searches without back references or lookaheads run in
+// a time linear in the length of the input. Make sure they find the same matches and sub-matches as the
+// backtracking search, and that the patterns which make it backtrack exponentially don't throw error_complexity.
+
+// ADDITIONAL_COMPILE_FLAGS: -Wno-macro-redefined -D_LIBCPP_ABI_REGEX_LINEAR_TIME_SEARCH
+
+#include <regex>
+#include <cassert>
+#include <string>
+#include <vector>
+
+#include "test_macros.h"
+
+void check_search(const char* pattern, const std::string& input, const std::vector<std::string>& expected,
+                  std::regex_constants::match_flag_type flags = std::regex_constants::match_default) {
+  std::smatch m;
+  bool found = std::regex_search(input, m, std::regex(pattern), flags);
+  assert(found == !expected.empty());
+  if (!found)
+    return;
+  assert(m.size() == expected.size());
+  for (std::size_t i = 0; i != expected.size(); ++i)
+    assert(m.str(i) == expected[i]);
+  assert(m.prefix().str() + m.str(0) + m.suffix().str() == input);
+}
+
+int main(int, char**) {
+  { // Exponential and quadratic patterns.
+    std::string s(1000, 'a');
+    assert(!std::regex_search(s, std::regex("(a|aa)*b")));
+    assert(!std::regex_search(s, std::regex("(a*)*b")));
+    assert(!std::regex_search(s, std::regex("a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?b")));
+    assert(std::regex_match(s, std::regex("(a|aa)*")));
+    assert(std::regex_search("aaaaaaaaaaaaaaaaaaaa",
+                             std::regex("a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?aaaaaaaaaaaaaaaaaaaa")));
+  }
+
+  // The alternatives and the quantifiers keep their ECMAScript priorities.
+  check_search("(a|b)*c", "xxababcyy", {"ababc", "b"});
+  check_search("(a|ab)(c|bcd)(d*)", "abcd", {"abcd", "a", "bcd", ""});
+  check_search("(a+)(a*)", "xaaay", {"aaa", "aaa", ""});
+  check_search("(a+?)(a*)", "xaaay", {"aaa", "a", "aa"});
+  check_search("a{2,3}", "aaaa", {"aaa"});
+  check_search("a{2,3}?", "aaaa", {"aa"});
+  check_search("(?:ab){2}(c)?", "abababd", {"abab", ""});
+  check_search("((a)|b)+", "ab", {"ab", "b", ""});
+  check_search("(a*)+", "b", {"", ""});
+  check_search("\\bfoo\\b", "afoo foo", {"foo"});
+  check_search("^b", "ab\nb", {});
+  check_search("[0-9]+$", "a1b22c333", {"333"});
+  check_search("x", "abc", {});
+  check_search("", "abc", {""});
+
+  // Back references and lookaheads fall back to backtracking.
+  check_search("(a+)b\\1", "xaabaay", {"aabaa", "aa"});
+  check_search("a(?=b)", "acab", {"a"});
+
+  { // The flags.
+    std::smatch m;
+    std::string s = "abcabc";
+    assert(std::regex_search(s, m, std::regex("bc"), std::regex_constants::match_default));
+    assert(m.position(0) == 1);
+    assert(!std::regex_search(s, m, std::regex("bc"), std::regex_constants::match_continuous));
+    assert(!std::regex_search(s, m, std::regex("^a"), std::regex_constants::match_not_bol) ||
+           m.position(0) != 0);
+    assert(std::regex_search(s, m, std::regex("a*"), std::regex_constants::match_not_null));
+    assert(m.str(0) == "a");
+    assert(std::regex_match(s, std::regex("a|abc|abcabc")));
+    assert(!std::regex_match(s, std::regex("abc")));
+  }
+
+  { // Iterating over the matches, including the empty ones.
+    std::string s = "a1b22c333";
+    std::regex re("\\d+");
+    std::vector<std::string> found;
+    for (std::sregex_iterator i(s.begin(), s.end(), re), e; i != e; ++i)
+      found.push_back(i->str());
+    assert((found == std::vector<std::string>{"1", "22", "333"}));
+
+    std::string t = "baaa";
+    std::regex empty("a*");
+    std::vector<std::ptrdiff_t> positions;
+    for (std::sregex_iterator i(t.begin(), t.end(), empty), e; i != e; ++i)
+      positions.push_back(i->position(0));
+    assert((positions == std::vector<std::ptrdiff_t>{0, 1, 4}));
+  }
+
+  { // Case insensitive and wide patterns.
+    std::smatch m;
+    std::string s = "xxHeLLo";
+    assert(std::regex_search(s, m, std::regex("hel+o", std::regex::icase)));
+    assert(m.position(0) == 2);
+#ifndef TEST_HAS_NO_WIDE_CHARACTERS
+    std::wsmatch wm;
+    std::wstring ws = L"abcab";
+    assert(std::regex_search(ws, wm, std::wregex(L"(c|b)a")));
+    assert(wm.str(0) == L"ca");
+#endif
+  }
+
+  return 0;
+}
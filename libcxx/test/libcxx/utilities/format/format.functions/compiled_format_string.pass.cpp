@@ -0,0 +1,126 @@
+//===----------------------------------------------------------------------===//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14, c++17
+// UNSUPPORTED: libcpp-has-no-incomplete-format
+// TODO FMT Evaluate gcc-12 status
+// UNSUPPORTED: gcc-12
+
+// <format>
+
+// With _LIBCPP_ABI_COMPILED_FORMAT_STRING, a basic_format_string keeps the format string parsed at compile time, and
+// the format functions use it when it only has replacement fields with automatic indexing in the order of the
+// arguments. The other format strings are interpreted at run time, and both give the same output.
+
+// ADDITIONAL_COMPILE_FLAGS: -Wno-macro-redefined -D_LIBCPP_ABI_COMPILED_FORMAT_STRING
+
+#include <format>
+#include <cassert>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "test_macros.h"
+
+#ifndef TEST_HAS_NO_LOCALIZATION
+#  include <locale>
+#endif
+
+struct Point {
+  int x;
+  int y;
+};
+
+// A type formatted through a handle, whose formatter may not be usable in a constant expression.
+template <>
+struct std::formatter<Point, char> : std::formatter<int, char> {
+  auto format(Point p, std::format_context& ctx) const {
+    ctx.advance_to(std::formatter<int, char>::format(p.x, ctx));
+    *ctx.out()++ = ',';
+    return std::formatter<int, char>::format(p.y, ctx);
+  }
+};
+
+template <class... Args>
+void test(bool compiled, std::string_view expected, std::format_string<Args...> fmt, Args&&... args) {
+  assert(fmt.__compiled().__valid() == compiled);
+
+  // The arguments are forwarded for the format strings to have the same type, none of them is moved from.
+  assert(std::format(fmt, std::forward<Args>(args)...) == expected);
+
+  std::string out;
+  std::format_to(std::back_inserter(out), fmt, std::forward<Args>(args)...);
+  assert(out == expected);
+
+  assert(std::formatted_size(fmt, std::forward<Args>(args)...) == expected.size());
+
+  // The output is truncated in the middle of the literal text and of the fields.
+  for (std::size_t n = 0; n <= expected.size(); ++n) {
+    std::string buffer(n, '*');
+    auto result = std::format_to_n(buffer.begin(), n, fmt, std::forward<Args>(args)...);
+    assert(result.size == static_cast<std::ptrdiff_t>(expected.size()));
+    assert(result.out == buffer.end());
+    assert(buffer == expected.substr(0, n));
+  }
+
+#ifndef TEST_HAS_NO_LOCALIZATION
+  // The overloads taking a locale use the compiled form too.
+  assert(std::format(std::locale::classic(), fmt, std::forward<Args>(args)...) == expected);
+
+  out.clear();
+  std::format_to(std::back_inserter(out), std::locale::classic(), fmt, std::forward<Args>(args)...);
+  assert(out == expected);
+
+  assert(std::formatted_size(std::locale::classic(), fmt, std::forward<Args>(args)...) == expected.size());
+
+  std::string buffer(expected.size(), '*');
+  auto result =
+      std::format_to_n(buffer.begin(), expected.size(), std::locale::classic(), fmt, std::forward<Args>(args)...);
+  assert(result.size == static_cast<std::ptrdiff_t>(expected.size()));
+  assert(buffer == expected);
+#endif
+}
+
+#ifndef TEST_HAS_NO_WIDE_CHARACTERS
+template <class... Args>
+void test(bool compiled, std::wstring_view expected, std::wformat_string<Args...> fmt, Args&&... args) {
+  assert(fmt.__compiled().__valid() == compiled);
+  assert(std::format(fmt, std::forward<Args>(args)...) == expected);
+  assert(std::formatted_size(fmt, std::forward<Args>(args)...) == expected.size());
+}
+#endif
+
+int main(int, char**) {
+  // Compiled.
+  test(true, "", "");
+  test(true, "literal text only", "literal text only");
+  test(true, "42", "{}", 42);
+  test(true, "a: 42, b: true, c: x, d: 1.5", "a: {}, b: {}, c: {}, d: {}", 42, true, 'x', 1.5);
+  test(true, "[   42] [0x2a] [abc  ] [+1.50]", "[{:5}] [{:#x}] [{:<5}] [{:+.2f}]", 42, 42, "abc", 1.5);
+  test(true, "sv and str", "{} and {}", std::string_view{"sv"}, std::string{"str"});
+  test(true, "0x0", "{}", static_cast<const void*>(nullptr));
+  test(true, "42 42", "{} {}", 42LL, 42u);
+  // The width is looked up at run time by the formatter of the field.
+  test(true, "[   42]", "[{:{}}]", 42, 5);
+  // The locale is looked up at run time from the context.
+  test(true, "1234 1.5", "{:L} {:L}", 1234, 1.5);
+
+  // Interpreted at run time.
+  test(false, "{42}", "{{{}}}", 42);
+  test(false, "2 1", "{1} {0}", 1, 2);
+  test(false, "[   42] 7", "[{:{}}] {}", 42, 5, 7);
+  test(false, "1,2", "{}", Point{1, 2});
+  test(false, "1,2 3", "{} {}", Point{1, 2}, 3);
+
+#ifndef TEST_HAS_NO_WIDE_CHARACTERS
+  test(true, L"a: 42, b: abc", L"a: {}, b: {}", 42, L"abc");
+  test(false, L"{42}", L"{{{}}}", 42);
+#endif
+
+  return 0;
+}
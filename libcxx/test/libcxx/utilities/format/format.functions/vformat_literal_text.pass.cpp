@@ -0,0 +1,76 @@
+//===----------------------------------------------------------------------===//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14, c++17
+// UNSUPPORTED: libcpp-has-no-incomplete-format
+// TODO FMT Evaluate gcc-12 status
+// UNSUPPORTED: gcc-12
+
+// <format>
+
+// The interpreter copies the literal text up to the next brace in one go. Check the literal text at the start and the
+// end of the format string, and next to the replacement fields and the escaped braces.
+
+#include <format>
+#include <cassert>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+#include "test_macros.h"
+
+void test(std::string_view expected, std::string_view fmt, const auto&... args) {
+  assert(std::vformat(fmt, std::make_format_args(args...)) == expected);
+
+  std::string out;
+  std::vformat_to(std::back_inserter(out), fmt, std::make_format_args(args...));
+  assert(out == expected);
+
+  // A pointer is written to directly, without a buffer.
+  char buffer[256];
+  char* end = std::vformat_to(buffer, fmt, std::make_format_args(args...));
+  assert(std::string_view(buffer, end) == expected);
+}
+
+#ifndef TEST_HAS_NO_WIDE_CHARACTERS
+void test(std::wstring_view expected, std::wstring_view fmt, const auto&... args) {
+  assert(std::vformat(fmt, std::make_wformat_args(args...)) == expected);
+
+  wchar_t buffer[256];
+  wchar_t* end = std::vformat_to(buffer, fmt, std::make_wformat_args(args...));
+  assert(std::wstring_view(buffer, end) == expected);
+}
+#endif
+
+int main(int, char**) {
+  test("", "");
+  test("a", "a");
+  test("some literal text", "some literal text");
+  test("before 1", "before {}", 1);
+  test("1 after", "{} after", 1);
+  test("1 between 2", "{} between {}", 1, 2);
+  test("12", "{}{}", 1, 2);
+  test("{", "{{");
+  test("}", "}}");
+  test("a{b}c", "a{{b}}c");
+  test("{1}", "{{{}}}", 1);
+  test("text {1} text", "text {{{}}} text", 1);
+  test("x}}y{{z", "x}}}}y{{{{z");
+
+  std::string long_text(200, 'x');
+  test(long_text + "1" + long_text, long_text + "{}" + long_text, 1);
+
+#ifndef TEST_HAS_NO_WIDE_CHARACTERS
+  test(L"", L"");
+  test(L"some literal text", L"some literal text");
+  test(L"1 between 2", L"{} between {}", 1, 2);
+  test(L"a{b}c", L"a{{b}}c");
+  test(L"text {1} text", L"text {{{}}} text", 1);
+#endif
+
+  return 0;
+}
@@ -0,0 +1,311 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14
+// UNSUPPORTED: no-threads
+
+// <memory_resource>
+
+// class synchronized_pool_resource
+
+// With _LIBCPP_ABI_SYNCHRONIZED_POOL_RESOURCE_THREAD_CACHES, every thread allocates from and deallocates to its own
+// lists of free blocks. Stress the hand-offs between these lists: blocks freed by other threads, threads exiting after
+// the resource was released or destroyed, threads using more resources than they have slots, and resources destroyed
+// while other threads still hold slots for them. The flag moves the members of the class into the dylib, so this only
+// tests something when the library was built with it in LIBCXX_ABI_DEFINES.
+
+#include <memory_resource>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "make_test_thread.h"
+#include "test_macros.h"
+
+#if defined(_LIBCPP_HAS_SYNCHRONIZED_POOL_RESOURCE_THREAD_CACHES)
+
+// An upstream resource which counts its outstanding allocations, from any thread.
+class counting_resource : public std::pmr::memory_resource {
+public:
+  long outstanding() const { return outstanding_.load(); }
+
+private:
+  void* do_allocate(std::size_t bytes, std::size_t align) override {
+    ++outstanding_;
+    return std::pmr::new_delete_resource()->allocate(bytes, align);
+  }
+
+  void do_deallocate(void* p, std::size_t bytes, std::size_t align) override {
+    --outstanding_;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return &other == this; }
+
+  std::atomic<long> outstanding_{0};
+};
+
+// Blocks are filled with a tag when they are allocated and checked when they are deallocated, so that a block handed
+// out twice is caught.
+struct block {
+  void* p;
+  std::size_t size;
+  unsigned char tag;
+};
+
+static block allocate_block(std::pmr::memory_resource& r, std::size_t size, unsigned char tag) {
+  void* p = r.allocate(size);
+  assert(p != nullptr);
+  std::memset(p, tag, size);
+  return block{p, size, tag};
+}
+
+static void deallocate_block(std::pmr::memory_resource& r, const block& b) {
+  const unsigned char* bytes = static_cast<const unsigned char*>(b.p);
+  for (std::size_t i = 0; i != b.size; ++i)
+    assert(bytes[i] == b.tag);
+  r.deallocate(b.p, b.size);
+}
+
+static std::size_t size_for(int i) {
+  static const std::size_t sizes[] = {8, 24, 64, 200, 1000};
+  return sizes[i % 5];
+}
+
+// A gate the main thread opens once, for the threads waiting for it.
+class gate {
+public:
+  void open() {
+    std::lock_guard<std::mutex> lk(mut_);
+    open_ = true;
+    cv_.notify_all();
+  }
+
+  void wait() {
+    std::unique_lock<std::mutex> lk(mut_);
+    cv_.wait(lk, [&] { return open_; });
+  }
+
+private:
+  std::mutex mut_;
+  std::condition_variable cv_;
+  bool open_ = false;
+};
+
+// Producers allocate blocks which consumers deallocate, so that most blocks come back to a cache other than the one
+// they came from.
+void test_cross_thread_frees() {
+  counting_resource upstream;
+  {
+    std::pmr::synchronized_pool_resource r(std::pmr::pool_options{0, 1024}, &upstream);
+
+    const int producers = 4;
+    const int consumers = 4;
+    const int per_thread = 5000;
+    std::mutex mut;
+    std::vector<block> queue;
+    std::atomic<int> produced{0};
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t != producers; ++t)
+      threads.push_back(support::make_test_thread([&, t] {
+        for (int i = 0; i != per_thread; ++i) {
+          block b = allocate_block(r, size_for(i), static_cast<unsigned char>(t + 1));
+          std::lock_guard<std::mutex> lk(mut);
+          queue.push_back(b);
+        }
+        ++produced;
+      }));
+    for (int t = 0; t != consumers; ++t)
+      threads.push_back(support::make_test_thread([&] {
+        for (;;) {
+          bool done = produced.load() == producers;
+          std::vector<block> taken;
+          {
+            std::lock_guard<std::mutex> lk(mut);
+            taken.swap(queue);
+          }
+          for (const block& b : taken)
+            deallocate_block(r, b);
+          if (done && taken.empty())
+            return;
+          std::this_thread::yield();
+        }
+      }));
+    for (std::thread& th : threads)
+      th.join();
+    assert(queue.empty());
+
+    // The blocks the consumers gave back are reused by the main thread.
+    std::vector<block> blocks;
+    for (int i = 0; i != 1000; ++i)
+      blocks.push_back(allocate_block(r, size_for(i), 0x5a));
+    for (const block& b : blocks)
+      deallocate_block(r, b);
+
+    r.release();
+    assert(upstream.outstanding() == 0);
+  }
+  assert(upstream.outstanding() == 0);
+}
+
+// A thread which used a resource exits after the resource was released, and then after it was destroyed. Its cache
+// must not give back blocks that no longer exist.
+void test_thread_exit_after_release() {
+  counting_resource upstream;
+  {
+    std::pmr::synchronized_pool_resource r(&upstream);
+    gate used, released;
+
+    std::thread th = support::make_test_thread([&] {
+      std::vector<block> blocks;
+      for (int i = 0; i != 100; ++i)
+        blocks.push_back(allocate_block(r, size_for(i), 0x11));
+      for (int i = 0; i != 50; ++i)
+        deallocate_block(r, blocks[i]);
+      used.open();
+      released.wait();
+    });
+    used.wait();
+    r.release();
+    assert(upstream.outstanding() == 0);
+    released.open();
+    th.join();
+    assert(upstream.outstanding() == 0);
+
+    // The resource is still usable after the release.
+    block b = allocate_block(r, 8, 0x22);
+    deallocate_block(r, b);
+  }
+  assert(upstream.outstanding() == 0);
+
+  {
+    gate used, destroyed;
+    std::unique_ptr<std::pmr::synchronized_pool_resource> r(new std::pmr::synchronized_pool_resource(&upstream));
+
+    std::thread th = support::make_test_thread([&] {
+      std::pmr::synchronized_pool_resource& res = *r;
+      for (int i = 0; i != 100; ++i) {
+        block b = allocate_block(res, size_for(i), 0x33);
+        deallocate_block(res, b);
+      }
+      used.open();
+      destroyed.wait();
+    });
+    used.wait();
+    r.reset();
+    assert(upstream.outstanding() == 0);
+    destroyed.open();
+    th.join();
+  }
+  assert(upstream.outstanding() == 0);
+}
+
+// A thread uses more resources than it has slots, so it keeps evicting the cache of one resource for another.
+void test_eviction() {
+  const int n = 20;
+  counting_resource upstreams[n];
+  {
+    std::unique_ptr<std::pmr::synchronized_pool_resource> resources[n];
+    for (int k = 0; k != n; ++k)
+      resources[k].reset(new std::pmr::synchronized_pool_resource(&upstreams[k]));
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t != 4; ++t)
+      threads.push_back(support::make_test_thread([&, t] {
+        std::vector<block> held[n];
+        for (int round = 0; round != 50; ++round)
+          for (int k = 0; k != n; ++k) {
+            std::pmr::synchronized_pool_resource& r = *resources[k];
+            const unsigned char tag = static_cast<unsigned char>(t * n + k + 1);
+            for (int i = 0; i != 10; ++i)
+              held[k].push_back(allocate_block(r, size_for(round + i), tag));
+            // Deallocate what was allocated in an earlier round, possibly while the cache of the resource was
+            // evicted.
+            while (held[k].size() > 30) {
+              deallocate_block(r, held[k].front());
+              held[k].erase(held[k].begin());
+            }
+          }
+        for (int k = 0; k != n; ++k)
+          for (const block& b : held[k])
+            deallocate_block(*resources[k], b);
+      }));
+    for (std::thread& th : threads)
+      th.join();
+
+    // Destroy half of the resources and check that the others still work in this thread, which holds no slots.
+    for (int k = 0; k < n; k += 2) {
+      resources[k].reset();
+      assert(upstreams[k].outstanding() == 0);
+    }
+    for (int k = 1; k < n; k += 2) {
+      block b = allocate_block(*resources[k], 64, 0x44);
+      deallocate_block(*resources[k], b);
+    }
+  }
+  for (int k = 0; k != n; ++k)
+    assert(upstreams[k].outstanding() == 0);
+}
+
+// A resource is destroyed while other threads still hold slots for it, and these threads then use another resource
+// whose cache may take the freed slots.
+void test_destroy_while_threads_hold_slots() {
+  counting_resource upstream;
+  for (int iteration = 0; iteration != 20; ++iteration) {
+    std::unique_ptr<std::pmr::synchronized_pool_resource> r(new std::pmr::synchronized_pool_resource(&upstream));
+    std::pmr::synchronized_pool_resource other(&upstream);
+    std::atomic<int> ready{0};
+    gate destroyed;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t != 4; ++t)
+      threads.push_back(support::make_test_thread([&, t] {
+        std::pmr::synchronized_pool_resource& res = *r;
+        std::vector<block> blocks;
+        for (int i = 0; i != 200; ++i)
+          blocks.push_back(allocate_block(res, size_for(i), static_cast<unsigned char>(t + 1)));
+        for (const block& b : blocks)
+          deallocate_block(res, b);
+        ++ready;
+        destroyed.wait();
+
+        blocks.clear();
+        for (int i = 0; i != 200; ++i)
+          blocks.push_back(allocate_block(other, size_for(i), static_cast<unsigned char>(t + 0x81)));
+        for (const block& b : blocks)
+          deallocate_block(other, b);
+      }));
+    while (ready.load() != 4)
+      std::this_thread::yield();
+    r.reset();
+    destroyed.open();
+    for (std::thread& th : threads)
+      th.join();
+  }
+  assert(upstream.outstanding() == 0);
+}
+
+#endif // _LIBCPP_HAS_SYNCHRONIZED_POOL_RESOURCE_THREAD_CACHES
+
+int main(int, char**) {
+#if defined(_LIBCPP_HAS_SYNCHRONIZED_POOL_RESOURCE_THREAD_CACHES)
+  test_cross_thread_frees();
+  test_thread_exit_after_release();
+  test_eviction();
+  test_destroy_while_threads_hold_slots();
+#endif
+
+  return 0;
+}
@@ -0,0 +1,40 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14, c++17, c++20
+
+// <flat_map>
+
+// mapped_type& operator[](const key_type& x);
+// mapped_type& at(const key_type& x);
+// const mapped_type& at(const key_type& x) const;
+
+#include <cassert>
+#include <flat_map>
+#include <stdexcept>
+
+#include "test_macros.h"
+
+int main(int, char**) {
+  std::flat_map<int, int> m = {{1, 10}, {2, 20}};
+  m[3] = 30;
+  assert(m.size() == 3);
+  assert(m.at(3) == 30);
+  m.at(1) = 11;
+  const auto& cm = m;
+  assert(cm.at(1) == 11);
+#ifndef TEST_HAS_NO_EXCEPTIONS
+  try {
+    TEST_IGNORE_NODISCARD cm.at(4);
+    assert(false);
+  } catch (const std::out_of_range&) {
+  }
+#endif
+
+  return 0;
+}
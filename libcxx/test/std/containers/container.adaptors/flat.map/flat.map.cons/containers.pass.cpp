@@ -0,0 +1,55 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14, c++17, c++20
+
+// <flat_map>
+
+// flat_map(key_container_type key_cont, mapped_container_type mapped_cont,
+//          const key_compare& comp = key_compare());
+// flat_map(sorted_unique_t, key_container_type key_cont, mapped_container_type mapped_cont,
+//          const key_compare& comp = key_compare());
+
+#include <cassert>
+#include <deque>
+#include <flat_map>
+#include <functional>
+#include <vector>
+
+#include "test_macros.h"
+
+int main(int, char**) {
+  {
+    using M = std::flat_map<int, char>;
+    M m({5, 2, 2, 3, 1, 3}, {'a', 'b', 'c', 'd', 'e', 'f'});
+    assert(m.size() == 4);
+    assert((m.keys() == std::vector<int>{1, 2, 3, 5}));
+    assert(m[1] == 'e');
+    assert(m[5] == 'a');
+  }
+  {
+    using M = std::flat_map<int, char, std::greater<int>, std::deque<int>, std::deque<char>>;
+    M m({1, 2, 3}, {'a', 'b', 'c'}, std::greater<int>());
+    assert((m.keys() == std::deque<int>{3, 2, 1}));
+    assert((m.values() == std::deque<char>{'c', 'b', 'a'}));
+  }
+  {
+    using M = std::flat_map<int, char>;
+    M m(std::sorted_unique, {1, 2, 4}, {'a', 'b', 'c'});
+    assert(m.size() == 3);
+    assert(m.find(4)->second == 'c');
+    assert(m.find(3) == m.end());
+  }
+  {
+    std::flat_map m(std::vector<int>{2, 1}, std::vector<double>{2.5, 1.5});
+    ASSERT_SAME_TYPE(decltype(m), std::flat_map<int, double>);
+    assert(m.begin()->second == 1.5);
+  }
+
+  return 0;
+}
@@ -0,0 +1,33 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14, c++17, c++20
+
+// <flat_map>
+
+// template<class Key, class T, class Compare, class KeyContainer, class MappedContainer,
+//          class Predicate>
+//   typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::size_type
+//     erase_if(flat_map<Key, T, Compare, KeyContainer, MappedContainer>& c, Predicate pred);
+
+#include <cassert>
+#include <flat_map>
+#include <vector>
+
+#include "test_macros.h"
+
+int main(int, char**) {
+  std::flat_map<int, int> m = {{1, 1}, {2, 4}, {3, 9}, {4, 16}};
+  assert(std::erase_if(m, [](auto p) { return p.first % 2 == 0; }) == 2);
+  assert((m.keys() == std::vector<int>{1, 3}));
+  assert((m.values() == std::vector<int>{1, 9}));
+  assert(std::erase_if(m, [](auto p) { return p.second > 100; }) == 0);
+  assert(m.size() == 2);
+
+  return 0;
+}
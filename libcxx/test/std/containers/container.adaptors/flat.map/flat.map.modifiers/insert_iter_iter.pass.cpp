@@ -0,0 +1,68 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14, c++17, c++20
+
+// <flat_map>
+
+// template <class InputIterator>
+//   void insert(InputIterator first, InputIterator last);
+// template <class InputIterator>
+//   void insert(sorted_unique_t, InputIterator first, InputIterator last);
+
+#include <cassert>
+#include <flat_map>
+#include <utility>
+#include <vector>
+
+#include "test_macros.h"
+#include "test_iterators.h"
+
+int main(int, char**) {
+  using M = std::flat_map<int, double>;
+  using P = std::pair<int, double>;
+  {
+    P ar[] = {P(3, 1), P(1, 1), P(2, 1), P(1, 1.5), P(3, 2)};
+    M m;
+    m.insert(cpp17_input_iterator<P*>(ar), cpp17_input_iterator<P*>(ar + 5));
+    assert(m.size() == 3);
+    assert((m.keys() == std::vector<int>{1, 2, 3}));
+  }
+  {
+    // The existing elements are kept over the inserted ones.
+    M m = {{2, 0}, {4, 0}};
+    P ar[] = {P(5, 1), P(1, 1), P(4, 1), P(3, 1)};
+    m.insert(ar, ar + 4);
+    assert((m.keys() == std::vector<int>{1, 2, 3, 4, 5}));
+    assert((m.values() == std::vector<double>{1, 0, 1, 0, 1}));
+  }
+  {
+    // Sorted elements which all go after the existing ones are appended.
+    M m = {{1, 0}, {2, 0}};
+    P ar[] = {P(3, 1), P(4, 1)};
+    m.insert(std::sorted_unique, ar, ar + 2);
+    assert((m.keys() == std::vector<int>{1, 2, 3, 4}));
+    assert((m.values() == std::vector<double>{0, 0, 1, 1}));
+  }
+  {
+    // Sorted elements which overlap the existing ones are merged.
+    M m = {{1, 0}, {3, 0}, {5, 0}};
+    P ar[] = {P(0, 1), P(3, 1), P(4, 1), P(6, 1)};
+    m.insert(std::sorted_unique, cpp17_input_iterator<P*>(ar), cpp17_input_iterator<P*>(ar + 4));
+    assert((m.keys() == std::vector<int>{0, 1, 3, 4, 5, 6}));
+    assert((m.values() == std::vector<double>{1, 0, 0, 1, 0, 1}));
+  }
+  {
+    M m;
+    m.insert_range(std::vector<P>{P(2, 2), P(1, 1), P(2, 3)});
+    assert(m.size() == 2);
+    assert(m.begin()->first == 1);
+  }
+
+  return 0;
+}
@@ -0,0 +1,61 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14, c++17, c++20
+
+// <flat_map>
+
+// template<class... Args>
+//   pair<iterator, bool> try_emplace(const key_type& k, Args&&... args);
+// template<class... Args>
+//   iterator try_emplace(const_iterator hint, const key_type& k, Args&&... args);
+// template<class M>
+//   pair<iterator, bool> insert_or_assign(const key_type& k, M&& obj);
+
+#include <cassert>
+#include <flat_map>
+#include <string>
+
+#include "test_macros.h"
+
+int main(int, char**) {
+  using M = std::flat_map<int, std::string>;
+  {
+    M m;
+    auto r = m.try_emplace(2, 3, 'a');
+    assert(r.second);
+    assert(r.first->second == "aaa");
+    r = m.try_emplace(2, "b");
+    assert(!r.second);
+    assert(r.first->second == "aaa");
+    assert(m.size() == 1);
+  }
+  {
+    M m = {{1, "a"}, {3, "c"}};
+    // correct hint
+    auto it = m.try_emplace(m.begin() + 1, 2, "b");
+    assert(it->first == 2);
+    // wrong hint
+    it = m.try_emplace(m.begin(), 4, "d");
+    assert(it->first == 4);
+    assert(it == m.end() - 1);
+    // hint to an equivalent key
+    it = m.try_emplace(m.begin() + 2, 3, "x");
+    assert(it->second == "c");
+    assert(m.size() == 4);
+  }
+  {
+    M m = {{1, "a"}};
+    assert(!m.insert_or_assign(1, "b").second);
+    assert(m[1] == "b");
+    assert(m.insert_or_assign(m.end(), 2, "c")->second == "c");
+    assert(m.size() == 2);
+  }
+
+  return 0;
+}
@@ -0,0 +1,55 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14, c++17, c++20
+
+// <flat_map>
+
+// template <class InputIterator>
+//   void insert(InputIterator first, InputIterator last);
+// template <class InputIterator>
+//   void insert(sorted_equivalent_t, InputIterator first, InputIterator last);
+
+#include <cassert>
+#include <flat_map>
+#include <utility>
+#include <vector>
+
+#include "test_macros.h"
+#include "test_iterators.h"
+
+int main(int, char**) {
+  using M = std::flat_multimap<int, int>;
+  using P = std::pair<int, int>;
+  {
+    // The equivalent elements keep the order of insertion.
+    M m = {{2, 0}, {1, 0}};
+    P ar[] = {P(2, 1), P(1, 1), P(2, 2), P(0, 1)};
+    m.insert(cpp17_input_iterator<P*>(ar), cpp17_input_iterator<P*>(ar + 4));
+    assert((m.keys() == std::vector<int>{0, 1, 1, 2, 2, 2}));
+    assert((m.values() == std::vector<int>{1, 0, 1, 0, 1, 2}));
+  }
+  {
+    M m = {{1, 0}, {2, 0}};
+    P ar[] = {P(2, 1), P(3, 1), P(3, 2)};
+    m.insert(std::sorted_equivalent, ar, ar + 3);
+    assert((m.keys() == std::vector<int>{1, 2, 2, 3, 3}));
+    assert((m.values() == std::vector<int>{0, 0, 1, 1, 2}));
+    assert(m.count(3) == 2);
+  }
+  {
+    M m = {{1, 0}, {1, 1}};
+    auto it = m.emplace(1, 2);
+    assert(it == m.end() - 1);
+    it = m.emplace_hint(m.begin(), 1, 3);
+    assert(it == m.begin());
+    assert(m.erase(1) == 4);
+  }
+
+  return 0;
+}
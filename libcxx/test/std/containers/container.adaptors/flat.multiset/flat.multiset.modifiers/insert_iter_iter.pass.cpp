@@ -0,0 +1,43 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14, c++17, c++20
+
+// <flat_set>
+
+// template <class InputIterator>
+//   void insert(InputIterator first, InputIterator last);
+// template <class InputIterator>
+//   void insert(sorted_equivalent_t, InputIterator first, InputIterator last);
+
+#include <cassert>
+#include <flat_set>
+#include <vector>
+
+#include "test_macros.h"
+#include "test_iterators.h"
+
+int main(int, char**) {
+  {
+    std::flat_multiset<int> s = {2, 4};
+    int ar[] = {4, 1, 2};
+    s.insert(cpp17_input_iterator<int*>(ar), cpp17_input_iterator<int*>(ar + 3));
+    assert((std::move(s).extract() == std::vector<int>{1, 2, 2, 4, 4}));
+  }
+  {
+    std::flat_multiset<int> s = {1, 2};
+    int ar[] = {2, 3, 3};
+    s.insert(std::sorted_equivalent, ar, ar + 3);
+    assert(s.count(2) == 2);
+    assert(s.count(3) == 2);
+    assert(s.erase(3) == 2);
+    assert(s.size() == 3);
+  }
+
+  return 0;
+}
@@ -0,0 +1,50 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14, c++17, c++20
+
+// <flat_set>
+
+// template <class InputIterator>
+//   void insert(InputIterator first, InputIterator last);
+// template <class InputIterator>
+//   void insert(sorted_unique_t, InputIterator first, InputIterator last);
+
+#include <cassert>
+#include <deque>
+#include <flat_set>
+#include <vector>
+
+#include "test_macros.h"
+#include "test_iterators.h"
+
+int main(int, char**) {
+  {
+    std::flat_set<int> s = {2, 4};
+    int ar[] = {5, 1, 4, 3, 1};
+    s.insert(cpp17_input_iterator<int*>(ar), cpp17_input_iterator<int*>(ar + 5));
+    assert((std::move(s).extract() == std::vector<int>{1, 2, 3, 4, 5}));
+  }
+  {
+    std::flat_set<int, std::less<int>, std::deque<int>> s = {1, 2};
+    int ar[] = {3, 4};
+    s.insert(std::sorted_unique, ar, ar + 2);
+    int ar2[] = {0, 2, 5};
+    s.insert(std::sorted_unique, ar2, ar2 + 3);
+    assert((std::move(s).extract() == std::deque<int>{0, 1, 2, 3, 4, 5}));
+  }
+  {
+    std::flat_set<int> s;
+    assert(s.insert(1).second);
+    assert(!s.insert(1).second);
+    assert(*s.insert(s.end(), 0) == 0);
+    assert(s.size() == 2);
+  }
+
+  return 0;
+}
@@ -33,7 +33,11 @@ int main(int, char**) {
           std::regex(
               "a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?aaaaaaaaaaaaaaaaaaaa",
               op));
+#ifdef _LIBCPP_ABI_REGEX_LINEAR_TIME_SEARCH
+      LIBCPP_ASSERT(op == std::regex::ECMAScript);
+#else
       LIBCPP_ASSERT(false);
+#endif
       assert(b);
     } catch (const std::regex_error &e) {
       assert(e.code() == std::regex_constants::error_complexity);
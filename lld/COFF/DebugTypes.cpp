@@ -732,7 +732,11 @@ void TpiSource::remapTpiWithGHashes(GHashState *g) {
   tpiMap = indexMapStorage;
   ipiMap = indexMapStorage;
   mergeUniqueTypeRecords(file->debugTypes);
-  // TODO: Free all unneeded ghash resources now that we have a full index map.
+
+  // The unique type list and the item bit vector are only read while merging
+  // this source, so free them now rather than after all sources are merged.
+  uniqueTypes = std::vector<uint32_t>();
+  isItemIndex = BitVector();
 
   if (ctx.config.showSummary) {
     nbTypeRecords = ghashes.size();
@@ -1166,6 +1170,10 @@ void TypeMerger::mergeTypesWithGHash() {
         GHashCell(cell.isItem(), cell.getTpiSrcIdx(), pdbTypeIndex);
   }
 
+  // The sorted cell list is not needed anymore. Release it before remapping,
+  // which allocates the merged type records, so the two don't overlap at peak.
+  entries = std::vector<GHashCell>();
+
   // In parallel, remap all types.
   for (TpiSource *source : dependencySources)
     source->remapTpiWithGHashes(&ghashState);
@@ -1028,7 +1028,7 @@ void BitcodeFile::parse() {
     comdat[i] =
         ctx.symtab.addComdat(this, saver.save(obj->getComdatTable()[i].first));
   for (const lto::InputFile::Symbol &objSym : obj->symbols()) {
-    StringRef symName = saver.save(objSym.getName());
+    StringRef symName = interner().intern(objSym.getName()).val();
     int comdatIndex = objSym.getComdatIndex();
     Symbol *sym;
     SectionChunk *fakeSC = nullptr;
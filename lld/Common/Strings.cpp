@@ -18,6 +18,24 @@
 using namespace llvm;
 using namespace lld;
 
+CachedHashStringRef StringInterner::intern(CachedHashStringRef s) {
+  // DenseSet uses the low bits of the hash value to select a bucket, so use
+  // the high bits to select a shard.
+  Shard &shard = shards[s.hash() >> (32 - numShardBits)];
+  std::lock_guard<std::mutex> lock(shard.mu);
+  auto it = shard.set.find(s);
+  if (it != shard.set.end())
+    return *it;
+
+  // Null-terminate the copy like StringSaver does.
+  char *p = shard.alloc.Allocate<char>(s.size() + 1);
+  memcpy(p, s.data(), s.size());
+  p[s.size()] = '\0';
+  CachedHashStringRef copy(StringRef(p, s.size()), s.hash());
+  shard.set.insert(copy);
+  return copy;
+}
+
 SingleStringMatcher::SingleStringMatcher(StringRef Pattern) {
   if (Pattern.size() > 2 && Pattern.startswith("\"") &&
       Pattern.endswith("\"")) {
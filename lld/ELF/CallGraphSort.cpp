@@ -45,6 +45,7 @@
 #include "InputSection.h"
 #include "Symbols.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Transforms/Utils/CodeLayout.h"
 
 #include <numeric>
 
@@ -97,6 +98,9 @@ constexpr uint64_t MAX_CLUSTER_SIZE = 1024 * 1024;
 using SectionPair =
     std::pair<const InputSectionBase *, const InputSectionBase *>;
 
+static DenseMap<const InputSectionBase *, int>
+buildOrderMap(ArrayRef<const InputSectionBase *> ordered);
+
 // Take the edge list in Config->CallGraphProfile, resolve symbol names to
 // Symbols, and generate a graph between InputSections with the provided
 // weights.
@@ -222,16 +226,27 @@ DenseMap<const InputSectionBase *, int> CallGraphSort::run() {
     return clusters[a].getDensity() > clusters[b].getDensity();
   });
 
-  DenseMap<const InputSectionBase *, int> orderMap;
-  int curOrder = 1;
+  std::vector<const InputSectionBase *> ordered;
   for (int leader : sorted) {
     for (int i = leader;;) {
-      orderMap[sections[i]] = curOrder++;
+      ordered.push_back(sections[i]);
       i = clusters[i].next;
       if (i == leader)
         break;
     }
   }
+  return buildOrderMap(ordered);
+}
+
+// Assign increasing priorities to the given sections and, if requested, print
+// the symbols defined in them to --print-symbol-order in the same order.
+static DenseMap<const InputSectionBase *, int>
+buildOrderMap(ArrayRef<const InputSectionBase *> ordered) {
+  DenseMap<const InputSectionBase *, int> orderMap;
+  int curOrder = 1;
+  for (const InputSectionBase *sec : ordered)
+    orderMap[sec] = curOrder++;
+
   if (!config->printSymbolOrder.empty()) {
     std::error_code ec;
     raw_fd_ostream os(config->printSymbolOrder, ec, sys::fs::OF_None);
@@ -240,31 +255,76 @@ DenseMap<const InputSectionBase *, int> CallGraphSort::run() {
       return orderMap;
     }
 
-    // Print the symbols ordered by C3, in the order of increasing curOrder
-    // Instead of sorting all the orderMap, just repeat the loops above.
-    for (int leader : sorted)
-      for (int i = leader;;) {
-        // Search all the symbols in the file of the section
-        // and find out a Defined symbol with name that is within the section.
-        for (Symbol *sym : sections[i]->file->getSymbols())
-          if (!sym->isSection()) // Filter out section-type symbols here.
-            if (auto *d = dyn_cast<Defined>(sym))
-              if (sections[i] == d->section)
-                os << sym->getName() << "\n";
-        i = clusters[i].next;
-        if (i == leader)
-          break;
-      }
+    for (const InputSectionBase *sec : ordered) {
+      // Search all the symbols in the file of the section
+      // and find out a Defined symbol with name that is within the section.
+      for (Symbol *sym : sec->file->getSymbols())
+        if (!sym->isSection()) // Filter out section-type symbols here.
+          if (auto *d = dyn_cast<Defined>(sym))
+            if (sec == d->section)
+              os << sym->getName() << "\n";
+    }
   }
 
   return orderMap;
 }
 
+// Order sections with the Ext-TSP heuristic, which is also used for basic
+// block placement. Every input section is a node weighted by its hottest
+// incident edge total, every call graph edge is a jump from the caller to the
+// callee, and chains of nodes are merged to maximize the number of calls whose
+// caller and callee end up close to each other in the output.
+static DenseMap<const InputSectionBase *, int> computeExtTspOrder() {
+  MapVector<SectionPair, uint64_t> &profile = config->callGraphProfile;
+  DenseMap<const InputSectionBase *, uint64_t> secToNode;
+  std::vector<const InputSectionBase *> sections;
+  std::vector<uint64_t> sizes, inWeights, outWeights;
+  std::vector<EdgeCountT> edges;
+
+  auto getOrCreateNode = [&](const InputSectionBase *isec) -> uint64_t {
+    auto res = secToNode.try_emplace(isec, sections.size());
+    if (res.second) {
+      sections.push_back(isec);
+      sizes.push_back(std::max<uint64_t>(isec->getSize(), 1));
+      inWeights.push_back(0);
+      outWeights.push_back(0);
+    }
+    return res.first->second;
+  };
+
+  for (std::pair<SectionPair, uint64_t> &c : profile) {
+    const auto *fromSB = cast<InputSectionBase>(c.first.first);
+    const auto *toSB = cast<InputSectionBase>(c.first.second);
+    // As with C³, edges across output sections can't be honored.
+    if (fromSB->getOutputSection() != toSB->getOutputSection())
+      continue;
+
+    uint64_t from = getOrCreateNode(fromSB);
+    uint64_t to = getOrCreateNode(toSB);
+    inWeights[to] += c.second;
+    outWeights[from] += c.second;
+    if (from != to)
+      edges.push_back({{from, to}, c.second});
+  }
+
+  std::vector<uint64_t> counts(sections.size());
+  for (size_t i = 0, e = sections.size(); i != e; ++i)
+    counts[i] = std::max(inWeights[i], outWeights[i]);
+
+  std::vector<const InputSectionBase *> ordered;
+  ordered.reserve(sections.size());
+  for (uint64_t node : applyExtTspLayout(sizes, counts, edges))
+    ordered.push_back(sections[node]);
+  return buildOrderMap(ordered);
+}
+
 // Sort sections by the profile data provided by --callgraph-profile-file.
 //
-// This first builds a call graph based on the profile data then merges sections
-// according to the C³ heuristic. All clusters are then sorted by a density
-// metric to further improve locality.
+// With the default hfsort algorithm this first builds a call graph based on
+// the profile data then merges sections according to the C³ heuristic. All
+// clusters are then sorted by a density metric to further improve locality.
 DenseMap<const InputSectionBase *, int> elf::computeCallGraphProfileOrder() {
+  if (config->callGraphProfileSort == CGProfileSortKind::Exttsp)
+    return computeExtTspOrder();
   return CallGraphSort().run();
 }
@@ -57,6 +57,9 @@ enum class BsymbolicKind { None, NonWeakFunctions, Functions, All };
 // For --build-id.
 enum class BuildIdKind { None, Fast, Md5, Sha1, Hexstring, Uuid };
 
+// For --call-graph-profile-sort={none,hfsort,exttsp}.
+enum class CGProfileSortKind { None, Hfsort, Exttsp };
+
 // For --discard-{all,locals,none}.
 enum class DiscardPolicy { Default, All, Locals, None };
 
@@ -134,6 +137,7 @@ public:
 struct Config {
   uint8_t osabi = 0;
   uint32_t andFeatures = 0;
+  llvm::CachePruningPolicy incrementalCachePolicy;
   llvm::CachePruningPolicy thinLTOCachePolicy;
   llvm::SetVector<llvm::CachedHashString> dependencyFiles; // for --dependency-file
   llvm::StringMap<uint64_t> sectionStartMap;
@@ -145,6 +149,7 @@ struct Config {
   llvm::StringRef entry;
   llvm::StringRef emulation;
   llvm::StringRef fini;
+  llvm::StringRef incrementalCacheDir;
   llvm::StringRef init;
   llvm::StringRef ltoAAPipeline;
   llvm::StringRef ltoCSProfileFile;
@@ -193,11 +198,12 @@ struct Config {
   bool armJ1J2BranchEncoding = false;
   bool asNeeded = false;
   BsymbolicKind bsymbolic = BsymbolicKind::None;
-  bool callGraphProfileSort;
+  CGProfileSortKind callGraphProfileSort;
   bool checkSections;
   bool checkDynamicRelocs;
   llvm::DebugCompressionType compressDebugSections;
   bool cref;
+  bool debugNames;
   llvm::SmallVector<std::pair<llvm::GlobPattern, uint64_t>, 0>
       deadRelocInNonAlloc;
   bool demangle = true;
@@ -277,6 +283,7 @@ struct Config {
   bool zForceIbt;
   bool zGlobal;
   bool zHazardplt;
+  bool zHugepageText;
   bool zIfuncNoplt;
   bool zInitfirst;
   bool zInterpose;
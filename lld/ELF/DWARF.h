@@ -32,7 +32,7 @@ public:
   }
 
   InputSection *getInfoSection() const {
-    return cast<InputSection>(infoSection.sec);
+    return cast_or_null<InputSection>(infoSection.sec);
   }
 
   const llvm::DWARFSection &getLoclistsSection() const override {
@@ -55,6 +55,10 @@ public:
     return lineSection;
   }
 
+  const LLDDWARFSection &getNamesSection() const override {
+    return namesSection;
+  }
+
   const llvm::DWARFSection &getAddrSection() const override {
     return addrSection;
   }
@@ -93,6 +97,7 @@ private:
   LLDDWARFSection rnglistsSection;
   LLDDWARFSection strOffsetsSection;
   LLDDWARFSection lineSection;
+  LLDDWARFSection namesSection;
   LLDDWARFSection addrSection;
   StringRef abbrevSection;
   StringRef strSection;
@@ -60,10 +60,12 @@
 #include "llvm/Support/LEB128.h"
 #include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/SHA1.h"
 #include "llvm/Support/TarWriter.h"
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
 #include <cstdlib>
 #include <utility>
 
@@ -372,6 +374,8 @@ static void checkOptions() {
       error("-r and -shared may not be used together");
     if (config->gdbIndex)
       error("-r and --gdb-index may not be used together");
+    if (config->debugNames)
+      error("-r and --debug-names may not be used together");
     if (config->icf != ICFLevel::None)
       error("-r and --icf may not be used together");
     if (config->pie)
@@ -482,6 +486,7 @@ constexpr const char *knownZFlags[] = {
     "force-ibt",
     "global",
     "hazardplt",
+    "hugepage-text",
     "ifunc-noplt",
     "initfirst",
     "interpose",
@@ -539,6 +544,146 @@ constexpr const char *saveTempsValues[] = {
     "resolution", "preopt",     "promote", "internalize",  "import",
     "opt",        "precodegen", "prelink", "combinedindex"};
 
+// --incremental-cache reuses the output of a previous link if the command line
+// and the contents of every input file are unchanged. Options which produce
+// side outputs or print diagnostics about the link are not replayed, so the
+// cache is bypassed when any of them is present.
+static bool canUseIncrementalCache() {
+  return !config->incrementalCacheDir.empty() && config->outputFile != "-" &&
+         !tar && config->mapFile.empty() && config->dependencyFile.empty() &&
+         config->whyExtract.empty() && config->printArchiveStats.empty() &&
+         config->printSymbolOrder.empty() && config->optRemarksFilename.empty() &&
+         config->optStatsFilename.empty() && config->saveTempsArgs.empty() &&
+         !config->cref && !config->emitLLVM && !config->printGcSections &&
+         !config->printIcfSections && !config->thinLTOIndexOnly &&
+         !config->timeTraceEnabled;
+}
+
+// Returns the files named by options that are read after the cache key is
+// computed, or by the LTO backend rather than through readFile.
+static SmallVector<StringRef, 0> getLateInputFiles(opt::InputArgList &args) {
+  SmallVector<StringRef, 0> files;
+  for (unsigned id : {OPT_call_graph_ordering_file, OPT_call_graph_perf_profile,
+                      OPT_lto_sample_profile})
+    if (auto *arg = args.getLastArg(id))
+      files.push_back(arg->getValue());
+  if (!config->ltoCSProfileGenerate && !config->ltoCSProfileFile.empty())
+    files.push_back(config->ltoCSProfileFile);
+  StringRef bbSections = config->ltoBasicBlockSections;
+  if (!bbSections.empty() && bbSections != "all" && bbSections != "labels" &&
+      bbSections != "none")
+    files.push_back(bbSections);
+  return files;
+}
+
+// Computes the cache key of this link from the lld version, the options that
+// affect the output and all input files. createFiles() has read every input
+// (including members of thin archives and files referenced by linker scripts)
+// at this point, and the files that are read later are hashed here. Returns
+// std::nullopt if one of them can't be read, in which case the cache is
+// bypassed and the link reports the error.
+static std::optional<std::string>
+computeIncrementalCacheKey(opt::InputArgList &args) {
+  SmallVector<uint64_t, 0> hashes(ctx.memoryBuffers.size());
+  parallelFor(0, hashes.size(), [&](size_t i) {
+    hashes[i] = xxHash64(ctx.memoryBuffers[i]->getBuffer());
+  });
+
+  SHA1 hasher;
+  auto addString = [&](StringRef str) {
+    hasher.update(str);
+    hasher.update(ArrayRef<uint8_t>{0});
+  };
+  addString(getLLDVersion());
+  for (const opt::Arg *arg : args) {
+    // The output path and the options that only affect diagnostics or the
+    // speed of the link do not change the output.
+    switch (arg->getOption().getID()) {
+    case OPT_o:
+    case OPT_verbose:
+    case OPT_color_diagnostics:
+    case OPT_error_limit:
+    case OPT_threads:
+    case OPT_incremental_cache_policy:
+      continue;
+    }
+    addString(arg->getAsString(args));
+  }
+  for (auto [mb, hash] : llvm::zip(ctx.memoryBuffers, hashes)) {
+    addString(mb->getBufferIdentifier());
+    uint8_t buf[8];
+    support::endian::write64le(buf, hash);
+    hasher.update(buf);
+  }
+  for (StringRef path : getLateInputFiles(args)) {
+    if (!config->chroot.empty() && path.startswith("/"))
+      path = saver().save(config->chroot + path);
+    ErrorOr<std::unique_ptr<MemoryBuffer>> mbOrErr =
+        MemoryBuffer::getFile(path, /*IsText=*/false,
+                              /*RequiresNullTerminator=*/false);
+    if (!mbOrErr)
+      return std::nullopt;
+    addString(path);
+    uint8_t buf[8];
+    support::endian::write64le(buf, xxHash64((*mbOrErr)->getBuffer()));
+    hasher.update(buf);
+  }
+  return toHex(hasher.result(), /*LowerCase=*/true);
+}
+
+// Copies a cached output to the destination path, keeping its permissions.
+static std::error_code copyOutputFile(StringRef from, StringRef to) {
+  ErrorOr<fs::perms> perms = fs::getPermissions(from);
+  if (!perms)
+    return perms.getError();
+  fs::remove(to);
+  if (std::error_code ec = fs::copy_file(from, to))
+    return ec;
+  return fs::setPermissions(to, *perms);
+}
+
+// Returns true if the output was restored from the cache.
+static bool restoreFromIncrementalCache(StringRef cachePath) {
+  if (!fs::exists(cachePath))
+    return false;
+  if (std::error_code ec = copyOutputFile(cachePath, config->outputFile)) {
+    log("--incremental-cache: cannot restore " + cachePath + ": " +
+        ec.message());
+    return false;
+  }
+  log("--incremental-cache: reused " + cachePath);
+  return true;
+}
+
+static void saveToIncrementalCache(StringRef cachePath) {
+  // Write to a temporary file first so that a concurrent link never observes a
+  // partially written cache entry.
+  auto report = [&](const Twine &msg) {
+    warn("--incremental-cache: cannot write " + cachePath + ": " + msg);
+  };
+  StringRef dir = path::parent_path(cachePath);
+  if (std::error_code ec = fs::create_directories(dir))
+    return report(ec.message());
+  // The temporary file must not look like a cache entry, or a concurrent
+  // pruning could remove it.
+  SmallString<128> tempModel(dir);
+  path::append(tempModel, "lld-incremental-%%%%%%.tmp");
+  Expected<fs::TempFile> temp = fs::TempFile::create(tempModel);
+  if (!temp)
+    return report(toString(temp.takeError()));
+  std::error_code ec = fs::copy_file(config->outputFile, temp->FD);
+  if (!ec) {
+    ErrorOr<fs::perms> perms = fs::getPermissions(config->outputFile);
+    ec = perms ? fs::setPermissions(temp->FD, *perms) : perms.getError();
+  }
+  if (ec) {
+    consumeError(temp->discard());
+    return report(ec.message());
+  }
+  if (Error e = temp->keep(cachePath))
+    report(toString(std::move(e)));
+}
+
 void LinkerDriver::linkerMain(ArrayRef<const char *> argsArr) {
   ELFOptTable parser;
   opt::InputArgList args = parser.parse(argsArr.slice(1));
@@ -618,7 +763,21 @@ void LinkerDriver::linkerMain(ArrayRef<const char *> argsArr) {
     if (errorCount())
       return;
 
+    SmallString<128> cachePath;
+    if (canUseIncrementalCache())
+      if (std::optional<std::string> key = computeIncrementalCacheKey(args)) {
+        path::append(cachePath, config->incrementalCacheDir,
+                     "llvmcache-" + *key);
+        if (restoreFromIncrementalCache(cachePath))
+          return;
+      }
+
     link(args);
+
+    if (!cachePath.empty() && !errorCount()) {
+      saveToIncrementalCache(cachePath);
+      pruneCache(config->incrementalCacheDir, config->incrementalCachePolicy);
+    }
   }
 
   if (config->timeTraceEnabled) {
@@ -867,12 +1026,28 @@ static std::pair<bool, bool> getPackDynRelocs(opt::InputArgList &args) {
   return {false, false};
 }
 
-static void readCallGraph(MemoryBufferRef mb) {
-  // Build a map from symbol name to section
+static CGProfileSortKind getCGProfileSortKind(opt::InputArgList &args) {
+  StringRef s = args.getLastArgValue(OPT_call_graph_profile_sort, "hfsort");
+  if (s == "hfsort")
+    return CGProfileSortKind::Hfsort;
+  if (s == "exttsp")
+    return CGProfileSortKind::Exttsp;
+  if (s != "none")
+    error("unknown --call-graph-profile-sort= value: " + s);
+  return CGProfileSortKind::None;
+}
+
+// Build a map from symbol name to symbol for resolving call graph profiles.
+static DenseMap<StringRef, Symbol *> getCallGraphSymbolMap() {
   DenseMap<StringRef, Symbol *> map;
   for (ELFFileBase *file : ctx.objectFiles)
     for (Symbol *sym : file->getSymbols())
       map[sym->getName()] = sym;
+  return map;
+}
+
+static void readCallGraph(MemoryBufferRef mb) {
+  DenseMap<StringRef, Symbol *> map = getCallGraphSymbolMap();
 
   auto findSection = [&](StringRef name) -> InputSectionBase * {
     Symbol *sym = map.lookup(name);
@@ -904,6 +1079,72 @@ static void readCallGraph(MemoryBufferRef mb) {
   }
 }
 
+// Parse a branch location of the form "symbol[+0xoffset]". Returns the
+// section containing the symbol and sets isEntry if the location is the first
+// byte of that symbol.
+static InputSectionBase *
+parseBranchLocation(const DenseMap<StringRef, Symbol *> &map, StringRef loc,
+                    bool &isEntry) {
+  StringRef name = loc;
+  uint64_t offset = 0;
+  size_t pos = loc.rfind('+');
+  if (pos != StringRef::npos && pos != 0) {
+    if (!to_integer(loc.substr(pos + 1), offset, 0))
+      return nullptr;
+    name = loc.substr(0, pos);
+  }
+  isEntry = offset == 0;
+  auto *d = dyn_cast_or_null<Defined>(map.lookup(name));
+  if (!d)
+    return nullptr;
+  return dyn_cast_or_null<InputSectionBase>(d->section);
+}
+
+// Read call graph edges from a branch sample profile. Two formats are
+// accepted:
+//
+// * The output of `perf script -F brstacksym --no-demangle`, where every
+//   token of the form "from/to/..." is one sampled taken branch.
+// * A symbolized pre-aggregated profile, where every line is
+//   "B <from> <to> <count> [<mispredicts>]". Other record kinds are ignored.
+//
+// Locations are "symbol[+0xoffset]". Only branches that land on the first
+// byte of a function in a different section are treated as calls; returns
+// and intra-function jumps land elsewhere and carry no call graph information.
+static void readCallGraphFromPerfProfile(MemoryBufferRef mb) {
+  DenseMap<StringRef, Symbol *> map = getCallGraphSymbolMap();
+
+  auto addBranch = [&](StringRef fromLoc, StringRef toLoc, uint64_t count) {
+    bool fromEntry, toEntry;
+    InputSectionBase *from = parseBranchLocation(map, fromLoc, fromEntry);
+    InputSectionBase *to = parseBranchLocation(map, toLoc, toEntry);
+    if (from && to && from != to && toEntry)
+      config->callGraphProfile[std::make_pair(from, to)] += count;
+  };
+
+  for (StringRef line : args::getLines(mb)) {
+    SmallVector<StringRef, 8> fields;
+    line.split(fields, ' ', /*MaxSplit=*/-1, /*KeepEmpty=*/false);
+
+    if (fields[0] == "B") {
+      uint64_t count;
+      if (fields.size() < 4 || !to_integer(fields[3], count)) {
+        error(mb.getBufferIdentifier() + ": parse error: " + line);
+        return;
+      }
+      addBranch(fields[1], fields[2], count);
+      continue;
+    }
+
+    for (StringRef field : fields) {
+      auto [fromLoc, rest] = field.split('/');
+      StringRef toLoc = rest.split('/').first;
+      if (!rest.empty() && !toLoc.empty())
+        addBranch(fromLoc, toLoc, 1);
+    }
+  }
+}
+
 // If SHT_LLVM_CALL_GRAPH_PROFILE and its relocation section exist, returns
 // true and populates cgProfile and symbolIndices.
 template <class ELFT>
@@ -1083,6 +1324,7 @@ static void readConfigs(opt::InputArgList &args) {
   config->chroot = args.getLastArgValue(OPT_chroot);
   config->compressDebugSections = getCompressDebugSections(args);
   config->cref = args.hasArg(OPT_cref);
+  config->debugNames = args.hasFlag(OPT_debug_names, OPT_no_debug_names, false);
   config->optimizeBBJumps =
       args.hasFlag(OPT_optimize_bb_jumps, OPT_no_optimize_bb_jumps, false);
   config->demangle = args.hasFlag(OPT_demangle, OPT_no_demangle, true);
@@ -1096,8 +1338,7 @@ static void readConfigs(opt::InputArgList &args) {
       args.hasFlag(OPT_eh_frame_hdr, OPT_no_eh_frame_hdr, false);
   config->emitLLVM = args.hasArg(OPT_plugin_opt_emit_llvm, false);
   config->emitRelocs = args.hasArg(OPT_emit_relocs);
-  config->callGraphProfileSort = args.hasFlag(
-      OPT_call_graph_profile_sort, OPT_no_call_graph_profile_sort, true);
+  config->callGraphProfileSort = getCGProfileSortKind(args);
   config->enableNewDtags =
       args.hasFlag(OPT_enable_new_dtags, OPT_disable_new_dtags, true);
   config->entry = args.getLastArgValue(OPT_entry);
@@ -1127,6 +1368,11 @@ static void readConfigs(opt::InputArgList &args) {
   config->ignoreFunctionAddressEquality =
       args.hasArg(OPT_ignore_function_address_equality);
   config->init = args.getLastArgValue(OPT_init, "_init");
+  config->incrementalCacheDir = args.getLastArgValue(OPT_incremental_cache);
+  config->incrementalCachePolicy = CHECK(
+      parseCachePruningPolicy(
+          args.getLastArgValue(OPT_incremental_cache_policy)),
+      "--incremental-cache-policy: invalid cache policy");
   config->ltoAAPipeline = args.getLastArgValue(OPT_lto_aa_pipeline);
   config->ltoCSProfileGenerate = args.hasArg(OPT_lto_cs_profile_generate);
   config->ltoCSProfileFile = args.getLastArgValue(OPT_lto_cs_profile_file);
@@ -1263,6 +1509,7 @@ static void readConfigs(opt::InputArgList &args) {
   config->zGlobal = hasZOption(args, "global");
   config->zGnustack = getZGnuStack(args);
   config->zHazardplt = hasZOption(args, "hazardplt");
+  config->zHugepageText = hasZOption(args, "hugepage-text");
   config->zIfuncNoplt = hasZOption(args, "ifunc-noplt");
   config->zInitfirst = hasZOption(args, "initfirst");
   config->zInterpose = hasZOption(args, "interpose");
@@ -1463,7 +1710,7 @@ static void readConfigs(opt::InputArgList &args) {
       config->symbolOrderingFile = getSymbolOrderingFile(*buffer);
       // Also need to disable CallGraphProfileSort to prevent
       // LLD order symbols with CGProfile
-      config->callGraphProfileSort = false;
+      config->callGraphProfileSort = CGProfileSortKind::None;
     }
   }
 
@@ -2847,10 +3094,13 @@ void LinkerDriver::link(opt::InputArgList &args) {
   }
 
   // Read the callgraph now that we know what was gced or icfed
-  if (config->callGraphProfileSort) {
+  if (config->callGraphProfileSort != CGProfileSortKind::None) {
     if (auto *arg = args.getLastArg(OPT_call_graph_ordering_file))
       if (std::optional<MemoryBufferRef> buffer = readFile(arg->getValue()))
         readCallGraph(*buffer);
+    if (auto *arg = args.getLastArg(OPT_call_graph_perf_profile))
+      if (std::optional<MemoryBufferRef> buffer = readFile(arg->getValue()))
+        readCallGraphFromPerfProfile(*buffer);
     invokeELFT(readCallGraphsFromObjectFiles,);
   }
 
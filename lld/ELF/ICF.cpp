@@ -433,6 +433,20 @@ void ICF<ELFT>::forEachClass(llvm::function_ref<void(size_t, size_t)> fn) {
   ++cnt;
 }
 
+// Returns a hash value of everything equalsConstant() compares except the
+// relocation targets and addends. Sections which are not constant-equal then
+// rarely end up in the same initial equivalence class, so segregate() seldom
+// needs a full content comparison to tell them apart.
+template <class ELFT, class RelTy>
+static uint64_t hashConstant(const InputSection *isec, ArrayRef<RelTy> rels) {
+  uint64_t hash = hash_combine(xxHash64(isec->content()), isec->flags,
+                               isec->getSize(), rels.size());
+  for (const RelTy &rel : rels)
+    hash = hash_combine(hash, uint64_t(rel.r_offset),
+                        rel.getType(config->isMips64EL));
+  return hash;
+}
+
 // Combine the hashes of the sections referenced by the given section into its
 // hash.
 template <class ELFT, class RelTy>
@@ -491,8 +505,12 @@ template <class ELFT> void ICF<ELFT>::run() {
 
   // Initially, we use hash values to partition sections.
   parallelForEach(sections, [&](InputSection *s) {
+    const RelsOrRelas<ELFT> rels = s->template relsOrRelas<ELFT>();
+    uint64_t hash = rels.areRelocsRel()
+                        ? hashConstant<ELFT>(s, rels.rels)
+                        : hashConstant<ELFT>(s, rels.relas);
     // Set MSB to 1 to avoid collisions with unique IDs.
-    s->eqClass[0] = xxHash64(s->content()) | (1U << 31);
+    s->eqClass[0] = hash | (1U << 31);
   });
 
   // Perform 2 rounds of relocation hash propagation. 2 is an empirical value to
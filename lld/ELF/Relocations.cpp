@@ -1518,22 +1518,54 @@ template <class ELFT> void elf::scanRelocations() {
   // for parallelism.
   bool serial = !config->zCombreloc || config->emachine == EM_MIPS ||
                 config->emachine == EM_PPC64;
-  parallel::TaskGroup tg;
+  SmallVector<InputSectionBase *, 0> sections;
+  SmallVector<size_t, 0> numRels;
+  size_t totalRels = 0;
   for (ELFFileBase *f : ctx.objectFiles) {
-    auto fn = [f]() {
-      RelocationScanner scanner;
-      for (InputSectionBase *s : f->getSections()) {
-        if (s && s->kind() == SectionBase::Regular && s->isLive() &&
-            (s->flags & SHF_ALLOC) &&
-            !(s->type == SHT_ARM_EXIDX && config->emachine == EM_ARM))
-          scanner.template scanSection<ELFT>(*s);
+    for (InputSectionBase *s : f->getSections()) {
+      if (s && s->kind() == SectionBase::Regular && s->isLive() &&
+          (s->flags & SHF_ALLOC) &&
+          !(s->type == SHT_ARM_EXIDX && config->emachine == EM_ARM)) {
+        const RelsOrRelas<ELFT> rels = s->template relsOrRelas<ELFT>();
+        sections.push_back(s);
+        numRels.push_back(rels.rels.size() + rels.relas.size());
+        totalRels += numRels.back();
       }
+    }
+  }
+
+  // Cut the section list into tasks with roughly the same number of
+  // relocations instead of using one task per object file. A link is often
+  // dominated by a few large object files (e.g. the output of LTO), and
+  // per-file tasks would scan each of them on a single thread. The relocation
+  // scan of a section does not depend on other sections of the same file, and
+  // the dynamic relocations added concurrently are sorted later, so the output
+  // does not depend on how the work is split.
+  parallel::TaskGroup tg;
+  auto scanRange = [&](size_t begin, size_t end) {
+    auto fn = [=, &sections]() {
+      RelocationScanner scanner;
+      for (InputSectionBase *s : ArrayRef(sections).slice(begin, end - begin))
+        scanner.template scanSection<ELFT>(*s);
     };
     if (serial)
       fn();
     else
       tg.execute(fn);
+  };
+  const size_t taskSize =
+      std::max<size_t>(totalRels / (config->threadCount * 4), 1024);
+  size_t begin = 0, pending = 0;
+  for (size_t i = 0, e = sections.size(); i != e; ++i) {
+    pending += numRels[i];
+    if (pending >= taskSize) {
+      scanRange(begin, i + 1);
+      begin = i + 1;
+      pending = 0;
+    }
   }
+  if (begin != sections.size())
+    scanRange(begin, sections.size());
 
   // Both the main thread and thread pool index 0 use getThreadIndex()==0. Be
   // careful that they don't concurrently run scanSections. When serial is
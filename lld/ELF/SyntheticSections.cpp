@@ -34,12 +34,15 @@
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/BinaryFormat/Dwarf.h"
 #include "llvm/BinaryFormat/ELF.h"
+#include "llvm/DebugInfo/DWARF/DWARFAcceleratorTable.h"
 #include "llvm/DebugInfo/DWARF/DWARFDebugPubTable.h"
+#include "llvm/Support/DJB.h"
 #include "llvm/Support/Endian.h"
 #include "llvm/Support/LEB128.h"
 #include "llvm/Support/Parallel.h"
 #include "llvm/Support/TimeProfiler.h"
 #include <cstdlib>
+#include <map>
 
 using namespace llvm;
 using namespace llvm::dwarf;
@@ -2756,10 +2759,10 @@ readPubNamesAndTypes(const LLDDwarfObj<ELFT> &obj,
 }
 
 // Create a list of symbols from a given list of symbol names and types
-// by uniquifying them by name.
+// by uniquifying them by name. nameAttrs is consumed by this function.
 static std::pair<SmallVector<GdbIndexSection::GdbSymbol, 0>, size_t>
 createSymbols(
-    ArrayRef<SmallVector<GdbIndexSection::NameAttrEntry, 0>> nameAttrs,
+    SmallVector<SmallVector<GdbIndexSection::NameAttrEntry, 0>, 0> &nameAttrs,
     const SmallVector<GdbIndexSection::GdbChunk, 0> &chunks) {
   using GdbSymbol = GdbIndexSection::GdbSymbol;
   using NameAttrEntry = GdbIndexSection::NameAttrEntry;
@@ -2809,18 +2812,25 @@ createSymbols(
     }
   });
 
+  // The name entries are not needed any more. Free them before flattening the
+  // shards, which temporarily needs memory for two copies of the symbols.
+  nameAttrs.clear();
+  map.reset();
+
   size_t numSymbols = 0;
   for (ArrayRef<GdbSymbol> v : ArrayRef(symbols.get(), numShards))
     numSymbols += v.size();
 
   // The return type is a flattened vector, so we'll copy each vector
-  // contents to Ret.
+  // contents to Ret. Release each shard once it has been copied.
   SmallVector<GdbSymbol, 0> ret;
   ret.reserve(numSymbols);
   for (SmallVector<GdbSymbol, 0> &vec :
-       MutableArrayRef(symbols.get(), numShards))
+       MutableArrayRef(symbols.get(), numShards)) {
     for (GdbSymbol &sym : vec)
       ret.push_back(std::move(sym));
+    vec = SmallVector<GdbSymbol, 0>();
+  }
 
   // CU vectors and symbol names are adjacent in the output file.
   // We can compute their offsets in the output file now.
@@ -2972,6 +2982,519 @@ void GdbIndexSection::writeTo(uint8_t *buf) {
 
 bool GdbIndexSection::isNeeded() const { return !chunks.empty(); }
 
+DebugNamesSection::DebugNamesSection()
+    : SyntheticSection(0, SHT_PROGBITS, 1, ".debug_names") {}
+
+// Returns true if an input index attribute of the given form can be copied to
+// the output index.
+static bool isSupportedForm(Form form) {
+  switch (form) {
+  case DW_FORM_flag_present:
+  case DW_FORM_data1:
+  case DW_FORM_data2:
+  case DW_FORM_data4:
+  case DW_FORM_data8:
+  case DW_FORM_ref1:
+  case DW_FORM_ref2:
+  case DW_FORM_ref4:
+  case DW_FORM_ref8:
+  case DW_FORM_udata:
+  case DW_FORM_ref_udata:
+  case DW_FORM_sdata:
+    return true;
+  default:
+    return false;
+  }
+}
+
+// A DW_IDX_parent value refers to another entry of the index, unless it is
+// DW_FORM_flag_present, which states that the parent is not indexed.
+static bool isParentRef(DebugNamesSection::AttrEncoding a) {
+  return a.index == DW_IDX_parent && a.form != DW_FORM_flag_present;
+}
+
+static size_t getValueSize(Form form, uint64_t v) {
+  switch (form) {
+  case DW_FORM_flag_present:
+    return 0;
+  case DW_FORM_data1:
+  case DW_FORM_ref1:
+    return 1;
+  case DW_FORM_data2:
+  case DW_FORM_ref2:
+    return 2;
+  case DW_FORM_data4:
+  case DW_FORM_ref4:
+    return 4;
+  case DW_FORM_data8:
+  case DW_FORM_ref8:
+    return 8;
+  case DW_FORM_udata:
+  case DW_FORM_ref_udata:
+    return getULEB128Size(v);
+  case DW_FORM_sdata:
+    return getSLEB128Size(v);
+  default:
+    llvm_unreachable("unsupported form");
+  }
+}
+
+static uint8_t *writeValue(uint8_t *buf, Form form, uint64_t v) {
+  switch (form) {
+  case DW_FORM_flag_present:
+    return buf;
+  case DW_FORM_data1:
+  case DW_FORM_ref1:
+    *buf = v;
+    return buf + 1;
+  case DW_FORM_data2:
+  case DW_FORM_ref2:
+    write16(buf, v);
+    return buf + 2;
+  case DW_FORM_data4:
+  case DW_FORM_ref4:
+    write32(buf, v);
+    return buf + 4;
+  case DW_FORM_data8:
+  case DW_FORM_ref8:
+    write64(buf, v);
+    return buf + 8;
+  case DW_FORM_udata:
+  case DW_FORM_ref_udata:
+    return buf + encodeULEB128(v, buf);
+  case DW_FORM_sdata:
+    return buf + encodeSLEB128(v, buf);
+  default:
+    llvm_unreachable("unsupported form");
+  }
+}
+
+// Calls fn with the output form and value of each attribute of an entry. The
+// compile unit indexes are rebased on the compile units of the preceding
+// chunks, the parent references are replaced with the output offsets of the
+// parents, and the compile unit is added if the input index does not need it
+// but the output index does.
+template <typename Fn>
+static void
+forEachOutputValue(const DebugNamesSection::Chunk &chunk,
+                   const DebugNamesSection::IndexEntry &ent,
+                   ArrayRef<DebugNamesSection::Abbrev> outAbbrevs, Fn fn) {
+  const DebugNamesSection::Abbrev &abbrev = chunk.abbrevs[ent.abbrevIdx];
+  for (auto [i, a] : llvm::enumerate(abbrev.attrs)) {
+    uint64_t v = chunk.values[ent.valueIdx + i];
+    if (a.index == DW_IDX_compile_unit)
+      fn(DW_FORM_data4, chunk.cuBase + v);
+    else if (isParentRef(a))
+      fn(DW_FORM_ref4, chunk.entries[v].offset);
+    else
+      fn(a.form, v);
+  }
+  if (outAbbrevs[chunk.outAbbrevs[ent.abbrevIdx]].attrs.size() >
+      abbrev.attrs.size())
+    fn(DW_FORM_data4, chunk.cuBase);
+}
+
+template <class ELFT>
+static void readDebugNames(ObjFile<ELFT> *file,
+                           SmallVector<DebugNamesSection::Chunk, 0> &chunks) {
+  using Chunk = DebugNamesSection::Chunk;
+
+  LLDDwarfObj<ELFT> obj(file);
+  const LLDDWARFSection &namesSec = obj.getNamesSection();
+  InputSection *infoSec = obj.getInfoSection();
+  if (!infoSec) {
+    warn(toString(namesSec.sec) + ": --debug-names: no .debug_info section");
+    return;
+  }
+  InputSectionBase *strSec = nullptr;
+  for (InputSectionBase *sec : file->getSections())
+    if (sec && sec->name == ".debug_str")
+      strSec = sec;
+  if (!strSec) {
+    warn(toString(namesSec.sec) + ": --debug-names: no .debug_str section");
+    return;
+  }
+
+  DWARFDataExtractor namesData(obj, namesSec, config->isLE, config->wordsize);
+  DataExtractor strData(obj.getStrSection(), config->isLE, config->wordsize);
+  DWARFDebugNames table(namesData, strData);
+  if (Error e = table.extract()) {
+    errorOrWarn(toString(namesSec.sec) + ": " + toString(std::move(e)));
+    return;
+  }
+
+  for (const DWARFDebugNames::NameIndex &ni : table) {
+    auto fail = [&](const Twine &msg) {
+      errorOrWarn(toString(namesSec.sec) + ": --debug-names: " + msg);
+      chunks.pop_back();
+    };
+    Chunk &chunk = chunks.emplace_back();
+    chunk.infoSec = infoSec;
+    chunk.strSec = strSec;
+
+    // The offsets of the tables are not exposed by NameIndex. Read the header
+    // again to get them.
+    DWARFDebugNames::Header hdr;
+    uint64_t offset = ni.getUnitOffset();
+    if (Error e = hdr.extract(namesData, &offset)) {
+      fail(toString(std::move(e)));
+      return;
+    }
+    if (hdr.Format != DWARF32) {
+      fail("64-bit DWARF is not supported");
+      return;
+    }
+    if (hdr.LocalTypeUnitCount || hdr.ForeignTypeUnitCount) {
+      fail("type units are not supported");
+      return;
+    }
+    uint64_t entriesBase = offset + uint64_t(hdr.CompUnitCount) * 4 +
+                           uint64_t(hdr.BucketCount) * 4 +
+                           uint64_t(hdr.BucketCount ? hdr.NameCount : 0) * 4 +
+                           uint64_t(hdr.NameCount) * 8 + hdr.AbbrevTableSize;
+
+    for (uint32_t i = 0; i != hdr.CompUnitCount; ++i)
+      chunk.cuOffsets.push_back(ni.getCUOffset(i));
+
+    // Read the abbreviations in the order of their codes, so that the output
+    // is deterministic.
+    SmallVector<const DWARFDebugNames::Abbrev *, 0> inAbbrevs;
+    for (const DWARFDebugNames::Abbrev &abbrev : ni.getAbbrevs())
+      inAbbrevs.push_back(&abbrev);
+    llvm::sort(inAbbrevs, [](auto *a, auto *b) { return a->Code < b->Code; });
+    DenseMap<uint32_t, uint32_t> abbrevIdx;
+    bool hasParentRefs = false;
+    for (const DWARFDebugNames::Abbrev *abbrev : inAbbrevs) {
+      DebugNamesSection::Abbrev &a = chunk.abbrevs.emplace_back();
+      a.tag = abbrev->Tag;
+      bool hasCU = false;
+      for (const DWARFDebugNames::AttributeEncoding &enc : abbrev->Attributes) {
+        if (!isSupportedForm(enc.Form)) {
+          fail("unsupported form " + FormEncodingString(enc.Form) +
+               " in abbreviation " + Twine(abbrev->Code));
+          return;
+        }
+        a.attrs.push_back({enc.Index, enc.Form});
+        hasCU |= enc.Index == DW_IDX_compile_unit;
+        hasParentRefs |= isParentRef(a.attrs.back());
+      }
+      if (!hasCU && hdr.CompUnitCount != 1) {
+        fail("abbreviation " + Twine(abbrev->Code) +
+             " has no DW_IDX_compile_unit");
+        return;
+      }
+      abbrevIdx[abbrev->Code] = chunk.abbrevs.size() - 1;
+    }
+
+    // Read the names and the entries of each name. The entries of a name are
+    // contiguous in the entry pool and are terminated by a null entry.
+    DenseMap<uint64_t, uint32_t> entryAt;
+    for (const DWARFDebugNames::NameTableEntry &nte : ni) {
+      StringRef s = nte.getString();
+      chunk.names.push_back({CachedHashStringRef(s, caseFoldingDjbHash(s)),
+                             (uint32_t)nte.getStringOffset(),
+                             (uint32_t)chunk.entries.size(), 0});
+      DebugNamesSection::NameEntry &ne = chunk.names.back();
+      uint64_t off = nte.getEntryOffset();
+      for (;;) {
+        uint64_t entryOff = off;
+        Expected<DWARFDebugNames::Entry> ent = ni.getEntry(&off);
+        if (!ent) {
+          Error e = ent.takeError();
+          if (e.isA<DWARFDebugNames::SentinelError>()) {
+            consumeError(std::move(e));
+            break;
+          }
+          fail(toString(std::move(e)));
+          return;
+        }
+        uint32_t idx = abbrevIdx.lookup(ent->getAbbrev().Code);
+        if (hasParentRefs)
+          entryAt[entryOff - entriesBase] = chunk.entries.size();
+        chunk.entries.push_back({idx, (uint32_t)chunk.values.size(), 0});
+        for (DebugNamesSection::AttrEncoding a : chunk.abbrevs[idx].attrs) {
+          uint64_t v = ent->lookup(a.index)->getRawUValue();
+          if (a.index == DW_IDX_compile_unit && v >= hdr.CompUnitCount) {
+            fail("invalid compile unit index " + Twine(v) + " for " + s);
+            return;
+          }
+          chunk.values.push_back(v);
+        }
+      }
+      ne.numEntries = chunk.entries.size() - ne.firstEntry;
+    }
+
+    // Now that all the entries are read, replace the parent references, which
+    // are offsets in the entry pool, with the indexes of the entries.
+    if (hasParentRefs) {
+      for (DebugNamesSection::IndexEntry &ent : chunk.entries) {
+        ArrayRef<DebugNamesSection::AttrEncoding> attrs =
+            chunk.abbrevs[ent.abbrevIdx].attrs;
+        for (auto [i, a] : llvm::enumerate(attrs)) {
+          if (!isParentRef(a))
+            continue;
+          uint64_t &v = chunk.values[ent.valueIdx + i];
+          auto it = entryAt.find(v);
+          if (it == entryAt.end()) {
+            fail("invalid DW_IDX_parent offset " + Twine(v));
+            return;
+          }
+          v = it->second;
+        }
+      }
+    }
+  }
+}
+
+// Returns the number of buckets of the hash table for n names, like the
+// .debug_names writer of the compiler.
+static uint32_t getBucketCount(uint32_t n) {
+  if (n > 1024)
+    return n / 4;
+  if (n > 16)
+    return n / 2;
+  return std::max<uint32_t>(n, 1);
+}
+
+// Returns a newly-created .debug_names section.
+template <class ELFT> DebugNamesSection *DebugNamesSection::create() {
+  llvm::TimeTraceScope timeScope("Create merged .debug_names");
+
+  // Collect the InputFiles with .debug_names. The input sections are replaced
+  // with the merged one.
+  SetVector<InputFile *> files;
+  for (InputSectionBase *s : ctx.inputSections) {
+    if (isa<InputSection>(s) && s->name == ".debug_names") {
+      s->markDead();
+      files.insert(s->file);
+    }
+  }
+  // Drop .rel[a].debug_names for --emit-relocs.
+  llvm::erase_if(ctx.inputSections, [](InputSectionBase *s) {
+    if (auto *isec = dyn_cast<InputSection>(s))
+      if (InputSectionBase *rel = isec->getRelocatedSection())
+        return !rel->isLive();
+    return !s->isLive();
+  });
+
+  // Read the input indexes in parallel. The DWARF parsers are not kept, only
+  // the names and the entries that they return.
+  SmallVector<SmallVector<Chunk, 0>, 0> fileChunks(files.size());
+  parallelFor(0, files.size(), [&](size_t i) {
+    readDebugNames<ELFT>(cast<ObjFile<ELFT>>(files[i]), fileChunks[i]);
+  });
+
+  auto *ret = make<DebugNamesSection>();
+  for (SmallVector<Chunk, 0> &v : fileChunks)
+    for (Chunk &chunk : v) {
+      chunk.cuBase = ret->numCUs;
+      ret->numCUs += chunk.cuOffsets.size();
+      ret->chunks.push_back(std::move(chunk));
+    }
+  fileChunks.clear();
+  ret->computeLayout();
+  return ret;
+}
+
+void DebugNamesSection::computeLayout() {
+  // Uniquify the abbreviations of the chunks. The output index always has a
+  // DW_IDX_compile_unit attribute when it covers several compile units.
+  std::map<std::pair<uint32_t, SmallVector<uint32_t, 8>>, uint32_t> abbrevMap;
+  for (Chunk &chunk : chunks) {
+    for (const Abbrev &a : chunk.abbrevs) {
+      Abbrev out{a.tag, {}};
+      bool hasCU = false;
+      for (AttrEncoding enc : a.attrs) {
+        if (enc.index == DW_IDX_compile_unit) {
+          enc.form = DW_FORM_data4;
+          hasCU = true;
+        } else if (isParentRef(enc)) {
+          enc.form = DW_FORM_ref4;
+        }
+        out.attrs.push_back(enc);
+      }
+      if (!hasCU && numCUs > 1)
+        out.attrs.push_back({DW_IDX_compile_unit, DW_FORM_data4});
+
+      std::pair<uint32_t, SmallVector<uint32_t, 8>> key;
+      key.first = out.tag;
+      for (AttrEncoding enc : out.attrs) {
+        key.second.push_back(enc.index);
+        key.second.push_back(enc.form);
+      }
+      auto [it, inserted] = abbrevMap.try_emplace(key, abbrevs.size());
+      if (inserted)
+        abbrevs.push_back(std::move(out));
+      chunk.outAbbrevs.push_back(it->second);
+    }
+  }
+
+  // Uniquify the names. The number of names is of the order of millions for
+  // large executables, so we use a sharded map like .gdb_index does.
+  constexpr size_t numShards = 32;
+  const size_t concurrency =
+      llvm::bit_floor(std::min<size_t>(config->threadCount, numShards));
+  const size_t shift = 32 - llvm::countr_zero(numShards);
+  auto map =
+      std::make_unique<DenseMap<CachedHashStringRef, uint32_t>[]>(numShards);
+  shards = std::make_unique<SmallVector<OutputName, 0>[]>(numShards);
+
+  parallelFor(0, concurrency, [&](size_t threadId) {
+    for (auto [chunkIdx, chunk] : llvm::enumerate(chunks)) {
+      for (auto [nameIdx, ne] : llvm::enumerate(chunk.names)) {
+        size_t shardId = ne.name.hash() >> shift;
+        if ((shardId & (concurrency - 1)) != threadId)
+          continue;
+        auto [it, inserted] =
+            map[shardId].try_emplace(ne.name, shards[shardId].size());
+        if (inserted)
+          shards[shardId].push_back({ne.name, {}, 0});
+        shards[shardId][it->second].inputs.emplace_back(chunkIdx, nameIdx);
+      }
+    }
+  });
+  map.reset();
+
+  // Sort the names by hash bucket in two passes: count the names of each
+  // bucket, then place them. Only pointers to the names are moved.
+  size_t numNames = 0;
+  for (ArrayRef<OutputName> v : ArrayRef(shards.get(), numShards))
+    numNames += v.size();
+  if (!isUInt<32>(numNames)) {
+    errorOrWarn("--debug-names: too many names (" + Twine(numNames) + ")");
+    chunks.clear();
+    return;
+  }
+  bucketCount = getBucketCount(numNames);
+  SmallVector<uint32_t, 0> bucketStart(bucketCount + 1);
+  for (ArrayRef<OutputName> v : ArrayRef(shards.get(), numShards))
+    for (const OutputName &name : v)
+      ++bucketStart[name.name.hash() % bucketCount + 1];
+  for (uint32_t i = 0; i != bucketCount; ++i)
+    bucketStart[i + 1] += bucketStart[i];
+  names.resize(numNames);
+  for (MutableArrayRef<OutputName> v :
+       MutableArrayRef(shards.get(), numShards))
+    for (OutputName &name : v)
+      names[bucketStart[name.name.hash() % bucketCount]++] = &name;
+
+  // Compute the offsets of the entries in the entry pool. Each name has a list
+  // of the entries of all its inputs, terminated by a null entry.
+  abbrevTableSize = 1;
+  for (auto [i, a] : llvm::enumerate(abbrevs)) {
+    abbrevTableSize += getULEB128Size(i + 1) + getULEB128Size(a.tag) + 2;
+    for (AttrEncoding enc : a.attrs)
+      abbrevTableSize += getULEB128Size(enc.index) + getULEB128Size(enc.form);
+  }
+
+  // The values that are rewritten have fixed sizes, so the sizes of the entries
+  // are known before the offsets of the parents are.
+  uint64_t off = 0;
+  for (OutputName *name : names) {
+    name->entryOffset = off;
+    for (auto [chunkIdx, nameIdx] : name->inputs) {
+      Chunk &chunk = chunks[chunkIdx];
+      const NameEntry &ne = chunk.names[nameIdx];
+      for (IndexEntry &ent : MutableArrayRef(chunk.entries)
+                                 .slice(ne.firstEntry, ne.numEntries)) {
+        ent.offset = off;
+        off += getULEB128Size(chunk.outAbbrevs[ent.abbrevIdx] + 1);
+        forEachOutputValue(chunk, ent, abbrevs, [&](Form form, uint64_t v) {
+          off += getValueSize(form, v);
+        });
+      }
+    }
+    ++off;
+  }
+
+  entryPoolOff = 36 + numCUs * 4 + bucketCount * 4 + numNames * 12 +
+                 abbrevTableSize;
+  size = entryPoolOff + off;
+  if (!isUInt<32>(size))
+    errorOrWarn("--debug-names: section size (" + Twine(size) +
+                ") exceeds UINT32_MAX");
+}
+
+void DebugNamesSection::writeTo(uint8_t *buf) {
+  // Write the header.
+  write32(buf, size - 4);
+  write16(buf + 4, 5);
+  write16(buf + 6, 0);
+  write32(buf + 8, numCUs);
+  write32(buf + 12, 0);
+  write32(buf + 16, 0);
+  write32(buf + 20, bucketCount);
+  write32(buf + 24, names.size());
+  write32(buf + 28, abbrevTableSize);
+  write32(buf + 32, 0);
+  uint8_t *p = buf + 36;
+
+  // Write the CU list.
+  for (const Chunk &chunk : chunks)
+    for (uint32_t cuOffset : chunk.cuOffsets) {
+      write32(p, chunk.infoSec->outSecOff + cuOffset);
+      p += 4;
+    }
+
+  // Write the bucket array, which has the 1-based index of the first name of
+  // each non-empty bucket.
+  uint8_t *buckets = p;
+  memset(buckets, 0, bucketCount * 4);
+  for (size_t i = names.size(); i--;)
+    write32(buckets + names[i]->name.hash() % bucketCount * 4, i + 1);
+  p += bucketCount * 4;
+
+  // Write the hash, string offset and entry offset arrays. The name of an
+  // output name is in .debug_str at the offset of its first input.
+  uint8_t *hashes = p;
+  uint8_t *strOffsets = hashes + names.size() * 4;
+  uint8_t *entryOffsets = strOffsets + names.size() * 4;
+  parallelFor(0, names.size(), [&](size_t i) {
+    const OutputName &name = *names[i];
+    const Chunk &chunk = chunks[name.inputs[0].first];
+    const NameEntry &ne = chunk.names[name.inputs[0].second];
+    write32(hashes + i * 4, name.name.hash());
+    write32(strOffsets + i * 4, chunk.strSec->getOffset(ne.stringOffset));
+    write32(entryOffsets + i * 4, name.entryOffset);
+  });
+  p = entryOffsets + names.size() * 4;
+
+  // Write the abbreviation table.
+  for (auto [i, a] : llvm::enumerate(abbrevs)) {
+    p += encodeULEB128(i + 1, p);
+    p += encodeULEB128(a.tag, p);
+    for (AttrEncoding enc : a.attrs) {
+      p += encodeULEB128(enc.index, p);
+      p += encodeULEB128(enc.form, p);
+    }
+    *p++ = 0;
+    *p++ = 0;
+  }
+  *p++ = 0;
+
+  // Write the entry pool.
+  uint8_t *entryPool = buf + entryPoolOff;
+  assert(p == entryPool);
+  parallelFor(0, names.size(), [&](size_t i) {
+    const OutputName &name = *names[i];
+    uint8_t *q = entryPool + name.entryOffset;
+    for (auto [chunkIdx, nameIdx] : name.inputs) {
+      const Chunk &chunk = chunks[chunkIdx];
+      const NameEntry &ne = chunk.names[nameIdx];
+      for (const IndexEntry &ent :
+           ArrayRef(chunk.entries).slice(ne.firstEntry, ne.numEntries)) {
+        q += encodeULEB128(chunk.outAbbrevs[ent.abbrevIdx] + 1, q);
+        forEachOutputValue(chunk, ent, abbrevs, [&](Form form, uint64_t v) {
+          q = writeValue(q, form, v);
+        });
+      }
+    }
+    *q = 0;
+  });
+}
+
+bool DebugNamesSection::isNeeded() const { return !chunks.empty(); }
+
 EhFrameHeader::EhFrameHeader()
     : SyntheticSection(SHF_ALLOC, SHT_PROGBITS, 4, ".eh_frame_hdr") {}
 
@@ -3887,6 +4410,11 @@ template GdbIndexSection *GdbIndexSection::create<ELF32BE>();
 template GdbIndexSection *GdbIndexSection::create<ELF64LE>();
 template GdbIndexSection *GdbIndexSection::create<ELF64BE>();
 
+template DebugNamesSection *DebugNamesSection::create<ELF32LE>();
+template DebugNamesSection *DebugNamesSection::create<ELF32BE>();
+template DebugNamesSection *DebugNamesSection::create<ELF64LE>();
+template DebugNamesSection *DebugNamesSection::create<ELF64BE>();
+
 template void elf::splitSections<ELF32LE>();
 template void elf::splitSections<ELF32BE>();
 template void elf::splitSections<ELF64LE>();
@@ -24,6 +24,7 @@
 #include "InputSection.h"
 #include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/MapVector.h"
+#include "llvm/BinaryFormat/Dwarf.h"
 #include "llvm/MC/StringTableBuilder.h"
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/Endian.h"
@@ -836,6 +837,84 @@ private:
   size_t size;
 };
 
+// --debug-names option tells linker to merge the DWARF v5 .debug_names
+// sections of the input files into a single name index covering all the
+// compile units. The entries of each name are copied from the inputs and
+// re-encoded with the abbreviations of the output index.
+class DebugNamesSection final : public SyntheticSection {
+public:
+  struct AttrEncoding {
+    llvm::dwarf::Index index;
+    llvm::dwarf::Form form;
+  };
+
+  struct Abbrev {
+    uint32_t tag;
+    SmallVector<AttrEncoding, 4> attrs;
+  };
+
+  // An index entry read from an input file. Its values are stored in
+  // Chunk::values in the order of the attributes of its abbreviation.
+  struct IndexEntry {
+    uint32_t abbrevIdx;
+    uint32_t valueIdx;
+    // The offset of this entry in the output entry pool.
+    uint32_t offset;
+  };
+
+  struct NameEntry {
+    llvm::CachedHashStringRef name;
+    uint32_t stringOffset;
+    uint32_t firstEntry;
+    uint32_t numEntries;
+  };
+
+  // Each chunk contains the contents of a single input name index.
+  struct Chunk {
+    InputSection *infoSec;
+    InputSectionBase *strSec;
+    SmallVector<uint32_t, 0> cuOffsets;
+    SmallVector<Abbrev, 0> abbrevs;
+    // The output abbreviation of each abbreviation of this chunk.
+    SmallVector<uint32_t, 0> outAbbrevs;
+    SmallVector<NameEntry, 0> names;
+    SmallVector<IndexEntry, 0> entries;
+    SmallVector<uint64_t, 0> values;
+    // The output index of the first compile unit of this chunk.
+    uint32_t cuBase;
+  };
+
+  struct OutputName {
+    llvm::CachedHashStringRef name;
+    // The (chunk, name) pairs of the input names with this string.
+    SmallVector<std::pair<uint32_t, uint32_t>, 1> inputs;
+    uint32_t entryOffset;
+  };
+
+  DebugNamesSection();
+  template <typename ELFT> static DebugNamesSection *create();
+  void writeTo(uint8_t *buf) override;
+  size_t getSize() const override { return size; }
+  bool isNeeded() const override;
+
+private:
+  void computeLayout();
+
+  SmallVector<Chunk, 0> chunks;
+  SmallVector<Abbrev, 0> abbrevs;
+
+  // The names, uniquified in shards by their hash, and the names of all the
+  // shards sorted by hash bucket.
+  std::unique_ptr<SmallVector<OutputName, 0>[]> shards;
+  SmallVector<OutputName *, 0> names;
+
+  uint32_t numCUs = 0;
+  uint32_t bucketCount = 0;
+  uint32_t abbrevTableSize = 0;
+  uint32_t entryPoolOff = 0;
+  size_t size = 0;
+};
+
 // --eh-frame-hdr option tells linker to construct a header for all the
 // .eh_frame sections. This header is placed to a section named .eh_frame_hdr
 // and also to a PT_GNU_EH_FRAME segment.
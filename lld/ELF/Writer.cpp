@@ -464,6 +464,8 @@ template <class ELFT> void elf::createSyntheticSections() {
 
   if (config->gdbIndex)
     add(*GdbIndexSection::create<ELFT>());
+  if (config->debugNames)
+    add(*DebugNamesSection::create<ELFT>());
 
   // We always need to add rel[a].plt to output if it has entries.
   // Even for static linking it can contain R_[*]_IRELATIVE relocations.
@@ -2427,17 +2429,34 @@ void Writer<ELFT>::addPhdrForSection(Partition &part, unsigned shType,
   part.phdrs.push_back(entry);
 }
 
+// The transparent huge page size used by -z hugepage-text.
+static constexpr uint32_t hugePageSize = 2 * 1024 * 1024;
+
 // Place the first section of each PT_LOAD to a different page (of maxPageSize).
 // This is achieved by assigning an alignment expression to addrExpr of each
 // such section.
 template <class ELFT> void Writer<ELFT>::fixSectionAlignments() {
   const PhdrEntry *prev;
-  auto pageAlign = [&](const PhdrEntry *p) {
+  auto pageAlign = [&](PhdrEntry *p) {
     OutputSection *cmd = p->firstSec;
     if (!cmd)
       return;
     cmd->alignExpr = [align = cmd->addralign]() { return align; };
-    if (!cmd->addrExpr) {
+    if (!cmd->addrExpr && config->zHugepageText &&
+        ((p->p_flags & PF_X) || (prev && (prev->p_flags & PF_X)))) {
+      // With -z hugepage-text, executable segments start at a huge page
+      // boundary in both the file and memory so that the kernel can back them
+      // with huge pages, and the segment following an executable segment
+      // starts at the next huge page boundary so that the last huge page of
+      // code is not shared with data. Hot sections sorted first by
+      // --symbol-ordering-file or the call graph profile thus end up in the
+      // first huge pages of the text.
+      if (p->p_flags & PF_X)
+        p->p_align = std::max(p->p_align, hugePageSize);
+      cmd->addrExpr = [] {
+        return alignToPowerOf2(script->getDot(), hugePageSize);
+      };
+    } else if (!cmd->addrExpr) {
       // Prefer advancing to align(dot, maxPageSize) + dot%maxPageSize to avoid
       // padding in the file contents.
       //
@@ -2487,7 +2506,7 @@ template <class ELFT> void Writer<ELFT>::fixSectionAlignments() {
 
   for (Partition &part : partitions) {
     prev = nullptr;
-    for (const PhdrEntry *p : part.phdrs)
+    for (PhdrEntry *p : part.phdrs)
       if (p->p_type == PT_LOAD && p->firstSec) {
         pageAlign(p);
         prev = p;
@@ -2816,8 +2835,11 @@ template <class ELFT> void Writer<ELFT>::openFile() {
   unsigned flags = 0;
   if (!config->relocatable)
     flags |= FileOutputBuffer::F_executable;
+  // Without mmap, the output is written on commit(). Write it with multiple
+  // threads, which matters on network file systems where a single sequential
+  // write is much slower than the link itself.
   if (!config->mmapOutputFile)
-    flags |= FileOutputBuffer::F_no_mmap;
+    flags |= FileOutputBuffer::F_no_mmap | FileOutputBuffer::F_parallel_write;
   Expected<std::unique_ptr<FileOutputBuffer>> bufferOrErr =
       FileOutputBuffer::create(config->outputFile, fileSize, flags);
 
@@ -338,21 +338,41 @@ static InputFile *addFile(StringRef path, LoadType loadType,
         if (sym.getName().startswith(objc::klass))
           file->fetch(sym);
 
-      // TODO: no need to look for ObjC sections for a given archive member if
-      // we already found that it contains an ObjC symbol.
       if (std::optional<MemoryBufferRef> buffer = readFile(path)) {
-        Error e = Error::success();
-        for (const object::Archive::Child &c : file->getArchive().children(e)) {
+        // Members that were already pulled in by an ObjC class symbol don't
+        // need their sections scanned. Scanning the rest is read-only, so do
+        // it in parallel and fetch the matches serially afterwards to keep
+        // the load order deterministic.
+        Error childrenErr = Error::success();
+        SmallVector<object::Archive::Child, 0> candidates;
+        SmallVector<MemoryBufferRef, 0> mbs;
+        for (const object::Archive::Child &c :
+             file->getArchive().children(childrenErr)) {
+          if (file->isFetched(c))
+            continue;
           Expected<MemoryBufferRef> mb = c.getMemoryBufferRef();
-          if (!mb || !hasObjCSection(*mb))
+          if (!mb) {
+            error(toString(file) + ": -ObjC failed to read archive member: " +
+                  toString(mb.takeError()));
             continue;
-          if (Error e = file->fetch(c, "-ObjC"))
+          }
+          candidates.push_back(c);
+          mbs.push_back(*mb);
+        }
+        if (childrenErr)
+          error(toString(file) + ": Archive::children failed: " +
+                toString(std::move(childrenErr)));
+
+        std::unique_ptr<bool[]> hasObjC(new bool[mbs.size()]);
+        parallelFor(0, mbs.size(),
+                    [&](size_t i) { hasObjC[i] = hasObjCSection(mbs[i]); });
+        for (size_t i = 0, n = candidates.size(); i != n; ++i) {
+          if (!hasObjC[i])
+            continue;
+          if (Error fetchErr = file->fetch(candidates[i], "-ObjC"))
             error(toString(file) + ": -ObjC failed to load archive member: " +
-                  toString(std::move(e)));
+                  toString(std::move(fetchErr)));
         }
-        if (e)
-          error(toString(file) +
-                ": Archive::children failed: " + toString(std::move(e)));
       }
     }
 
@@ -2176,7 +2176,7 @@ void ArchiveFile::fetch(const object::Archive::Symbol &sym) {
 
 static macho::Symbol *createBitcodeSymbol(const lto::InputFile::Symbol &objSym,
                                           BitcodeFile &file) {
-  StringRef name = saver().save(objSym.getName());
+  StringRef name = interner().intern(objSym.getName()).val();
 
   if (objSym.isUndefined())
     return symtab->addUndefined(name, &file, /*isWeakRef=*/objSym.isWeak());
@@ -2250,7 +2250,8 @@ void BitcodeFile::parseLazy() {
   symbols.resize(obj->symbols().size());
   for (const auto &[i, objSym] : llvm::enumerate(obj->symbols())) {
     if (!objSym.isUndefined()) {
-      symbols[i] = symtab->addLazyObject(saver().save(objSym.getName()), *this);
+      symbols[i] =
+          symtab->addLazyObject(interner().intern(objSym.getName()).val(), *this);
       if (!lazy)
         break;
     }
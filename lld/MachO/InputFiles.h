@@ -285,6 +285,9 @@ public:
   // LLD normally doesn't use Error for error-handling, but the underlying
   // Archive library does, so this is the cleanest way to wrap it.
   Error fetch(const llvm::object::Archive::Child &, StringRef reason);
+  bool isFetched(const llvm::object::Archive::Child &c) const {
+    return seen.contains(c.getChildOffset());
+  }
   const llvm::object::Archive &getArchive() const { return *file; };
   static bool classof(const InputFile *f) { return f->kind() == ArchiveKind; }
 
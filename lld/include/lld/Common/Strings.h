@@ -10,9 +10,13 @@
 #define LLD_STRINGS_H
 
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/CachedHashString.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Allocator.h"
 #include "llvm/Support/GlobPattern.h"
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -76,6 +80,31 @@ public:
   bool match(llvm::StringRef s) const;
 };
 
+// A thread-safe set of strings. intern() returns a copy of the given string
+// that lives as long as the linker context, and equal strings share a single
+// copy. The set is split into shards selected by the hash value, so threads
+// interning different strings rarely contend for the same lock.
+//
+// This is used for symbol names that cannot point into input files, e.g. the
+// names of bitcode symbols, which are otherwise copied once per referencing
+// file.
+class StringInterner {
+public:
+  llvm::CachedHashStringRef intern(llvm::CachedHashStringRef s);
+  llvm::CachedHashStringRef intern(llvm::StringRef s) {
+    return intern(llvm::CachedHashStringRef(s));
+  }
+
+private:
+  struct Shard {
+    std::mutex mu;
+    llvm::DenseSet<llvm::CachedHashStringRef> set;
+    llvm::BumpPtrAllocator alloc;
+  };
+  static constexpr unsigned numShardBits = 5;
+  Shard shards[1 << numShardBits];
+};
+
 } // namespace lld
 
 #endif
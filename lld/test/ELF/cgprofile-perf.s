@@ -0,0 +1,81 @@
+# REQUIRES: x86
+## Test --call-graph-perf-profile with both accepted profile formats, and the
+## algorithms of --call-graph-profile-sort=.
+
+# RUN: rm -rf %t && split-file %s %t && cd %t
+# RUN: llvm-mc -filetype=obj -triple=x86_64 a.s -o a.o
+
+## Without a profile, the sections keep the input order.
+# RUN: ld.lld -e A a.o -o out
+# RUN: llvm-nm --numeric-sort out | FileCheck %s --check-prefix=INPUT
+
+# INPUT:      T A
+# INPUT-NEXT: T B
+# INPUT-NEXT: T C
+# INPUT-NEXT: T D
+
+## Only the calls A -> D count. The returns and the jumps within a function
+## don't land on a function entry, and unknown symbols are ignored.
+# RUN: ld.lld -e A a.o --call-graph-perf-profile=brstack.txt -o out1
+# RUN: llvm-nm --numeric-sort out1 | FileCheck %s
+# RUN: ld.lld -e A a.o --call-graph-perf-profile=preagg.txt -o out2
+# RUN: llvm-nm --numeric-sort out2 | FileCheck %s
+# RUN: ld.lld -e A a.o --call-graph-perf-profile=preagg.txt \
+# RUN:   --call-graph-profile-sort=exttsp -o out3
+# RUN: llvm-nm --numeric-sort out3 | FileCheck %s
+
+# CHECK:      T A
+# CHECK-NEXT: T D
+# CHECK-NEXT: T B
+# CHECK-NEXT: T C
+
+## The profile is not used if sorting is disabled.
+# RUN: ld.lld -e A a.o --call-graph-perf-profile=preagg.txt \
+# RUN:   --call-graph-profile-sort=none -o out4
+# RUN: llvm-nm --numeric-sort out4 | FileCheck %s --check-prefix=INPUT
+# RUN: ld.lld -e A a.o --call-graph-perf-profile=preagg.txt \
+# RUN:   --no-call-graph-profile-sort -o out5
+# RUN: llvm-nm --numeric-sort out5 | FileCheck %s --check-prefix=INPUT
+
+# RUN: not ld.lld -e A a.o --call-graph-perf-profile=bad.txt -o /dev/null 2>&1 | \
+# RUN:   FileCheck %s --check-prefix=BAD
+# RUN: not ld.lld -e A a.o --call-graph-profile-sort=c3 -o /dev/null 2>&1 | \
+# RUN:   FileCheck %s --check-prefix=UNKNOWN
+
+# BAD:     error: bad.txt: parse error: B A+0x1 D many
+# UNKNOWN: error: unknown --call-graph-profile-sort= value: c3
+
+#--- a.s
+.section .text.A,"ax",@progbits
+.globl A
+A:
+  nop
+  nop
+  nop
+  ret
+
+.section .text.B,"ax",@progbits
+.globl B
+B:
+  ret
+
+.section .text.C,"ax",@progbits
+.globl C
+C:
+  ret
+
+.section .text.D,"ax",@progbits
+.globl D
+D:
+  ret
+
+#--- brstack.txt
+ A+0x1/D/P/-/-/0 D/A+0x2/P/-/-/0 B/B+0x1/P/-/-/0
+ A+0x1/D/P/-/-/0 C+0x0/X+0x4/P/-/-/0
+#--- preagg.txt
+B A+0x1 D 100 0
+B D A+0x2 100 0
+B C B+0x1 50 0
+F A+0x1 A+0x3 10
+#--- bad.txt
+B A+0x1 D many
@@ -0,0 +1,262 @@
+# REQUIRES: x86
+## Test that --debug-names merges the .debug_names sections of the input files
+## into a single name index covering all the compile units.
+
+# RUN: rm -rf %t && split-file %s %t && cd %t
+# RUN: llvm-mc -filetype=obj -triple=x86_64 a.s -o a.o
+# RUN: llvm-mc -filetype=obj -triple=x86_64 b.s -o b.o
+# RUN: ld.lld --debug-names a.o b.o -o out
+# RUN: llvm-dwarfdump --debug-names out | FileCheck %s
+
+# CHECK:      .debug_names contents:
+# CHECK-NEXT: Name Index @ 0x0 {
+# CHECK-NEXT:   Header {
+# CHECK-NEXT:     Length: 0x90
+# CHECK-NEXT:     Format: DWARF32
+# CHECK-NEXT:     Version: 5
+# CHECK-NEXT:     CU count: 2
+# CHECK-NEXT:     Local TU count: 0
+# CHECK-NEXT:     Foreign TU count: 0
+# CHECK-NEXT:     Bucket count: 3
+# CHECK-NEXT:     Name count: 3
+# CHECK-NEXT:     Abbreviations table size: 0x11
+# CHECK-NEXT:     Augmentation: ''
+# CHECK-NEXT:   }
+# CHECK-NEXT:   Compilation Unit offsets [
+# CHECK-NEXT:     CU[0]: 0x00000000
+# CHECK-NEXT:     CU[1]: 0x0000001c
+# CHECK-NEXT:   ]
+# CHECK:        Bucket 0 [
+# CHECK-NEXT:     Name 1 {
+# CHECK-NEXT:       Hash: 0xB887389
+# CHECK-NEXT:       String: {{0x[0-9a-f]+}} "foo"
+# CHECK-NEXT:       Entry @ 0x6d {
+# CHECK-NEXT:         Abbrev: 0x1
+# CHECK-NEXT:         Tag: DW_TAG_subprogram
+# CHECK-NEXT:         DW_IDX_die_offset: 0x00000011
+# CHECK-NEXT:         DW_IDX_compile_unit: 0x00000000
+# CHECK-NEXT:       }
+# CHECK-NEXT:     }
+# CHECK-NEXT:     Name 2 {
+# CHECK-NEXT:       Hash: 0xB8860BA
+# CHECK-NEXT:       String: {{0x[0-9a-f]+}} "bar"
+# CHECK-NEXT:       Entry @ 0x77 {
+# CHECK-NEXT:         Abbrev: 0x1
+# CHECK-NEXT:         Tag: DW_TAG_subprogram
+# CHECK-NEXT:         DW_IDX_die_offset: 0x00000011
+# CHECK-NEXT:         DW_IDX_compile_unit: 0x00000001
+# CHECK-NEXT:       }
+# CHECK-NEXT:     }
+# CHECK-NEXT:   ]
+# CHECK-NEXT:   Bucket 1 [
+# CHECK-NEXT:     EMPTY
+# CHECK-NEXT:   ]
+# CHECK-NEXT:   Bucket 2 [
+# CHECK-NEXT:     Name 3 {
+# CHECK-NEXT:       Hash: 0xB888030
+# CHECK-NEXT:       String: {{0x[0-9a-f]+}} "int"
+# CHECK-NEXT:       Entry @ 0x81 {
+# CHECK-NEXT:         Abbrev: 0x2
+# CHECK-NEXT:         Tag: DW_TAG_base_type
+# CHECK-NEXT:         DW_IDX_die_offset: 0x00000016
+# CHECK-NEXT:         DW_IDX_compile_unit: 0x00000000
+# CHECK-NEXT:       }
+# CHECK-NEXT:       Entry @ 0x8a {
+# CHECK-NEXT:         Abbrev: 0x2
+# CHECK-NEXT:         Tag: DW_TAG_base_type
+# CHECK-NEXT:         DW_IDX_die_offset: 0x00000016
+# CHECK-NEXT:         DW_IDX_compile_unit: 0x00000001
+# CHECK-NEXT:       }
+# CHECK-NEXT:     }
+# CHECK-NEXT:   ]
+# CHECK-NEXT: }
+
+## Without the option, the input sections are concatenated.
+# RUN: ld.lld a.o b.o -o out.nomerge
+# RUN: llvm-dwarfdump --debug-names out.nomerge | FileCheck %s --check-prefix=NOMERGE
+
+# NOMERGE:     Name Index @ 0x0 {
+# NOMERGE:     Name Index @ 0x{{[0-9a-f]+}} {
+
+# RUN: not ld.lld -r --debug-names a.o -o /dev/null 2>&1 | FileCheck %s --check-prefix=ERR
+# ERR: error: -r and --debug-names may not be used together
+
+#--- a.s
+.globl _start
+_start:
+  ret
+
+.section .debug_abbrev,"",@progbits
+  .byte 1        # Abbreviation code
+  .byte 0x11     # DW_TAG_compile_unit
+  .byte 1        # DW_CHILDREN_yes
+  .byte 0x03     # DW_AT_name
+  .byte 0x0e     # DW_FORM_strp
+  .byte 0, 0
+  .byte 2        # Abbreviation code
+  .byte 0x2e     # DW_TAG_subprogram
+  .byte 0        # DW_CHILDREN_no
+  .byte 0x03     # DW_AT_name
+  .byte 0x0e     # DW_FORM_strp
+  .byte 0, 0
+  .byte 3        # Abbreviation code
+  .byte 0x24     # DW_TAG_base_type
+  .byte 0        # DW_CHILDREN_no
+  .byte 0x03     # DW_AT_name
+  .byte 0x0e     # DW_FORM_strp
+  .byte 0, 0
+  .byte 0
+
+.section .debug_info,"",@progbits
+.Lcu_begin0:
+  .long .Lcu_end0 - .Lcu_start0
+.Lcu_start0:
+  .short 5                  # DWARF version
+  .byte 1                   # DW_UT_compile
+  .byte 8                   # Address size
+  .long .debug_abbrev
+  .byte 1                   # DW_TAG_compile_unit
+  .long .Lstr_cu
+.Ldie_foo:
+  .byte 2                   # DW_TAG_subprogram
+  .long .Lstr_foo
+.Ldie_int:
+  .byte 3                   # DW_TAG_base_type
+  .long .Lstr_int
+  .byte 0
+.Lcu_end0:
+
+.section .debug_str,"MS",@progbits,1
+.Lstr_cu:
+  .asciz "a.c"
+.Lstr_foo:
+  .asciz "foo"
+.Lstr_int:
+  .asciz "int"
+
+.section .debug_names,"",@progbits
+  .long .Lnames_end0 - .Lnames_start0
+.Lnames_start0:
+  .short 5                  # Version
+  .short 0                  # Padding
+  .long 1                   # CU count
+  .long 0                   # Local TU count
+  .long 0                   # Foreign TU count
+  .long 0                   # Bucket count
+  .long 2                   # Name count
+  .long .Lnames_abbrev_end0 - .Lnames_abbrev_start0
+  .long 0                   # Augmentation string size
+  .long .Lcu_begin0         # CU[0]
+  .long .Lstr_foo           # String offsets
+  .long .Lstr_int
+  .long .Lnames0 - .Lnames_entries0  # Entry offsets
+  .long .Lnames1 - .Lnames_entries0
+.Lnames_abbrev_start0:
+  .byte 1                   # Abbreviation code
+  .byte 0x2e                # DW_TAG_subprogram
+  .byte 3, 0x13             # DW_IDX_die_offset, DW_FORM_ref4
+  .byte 0, 0
+  .byte 2                   # Abbreviation code
+  .byte 0x24                # DW_TAG_base_type
+  .byte 3, 0x13             # DW_IDX_die_offset, DW_FORM_ref4
+  .byte 0, 0
+  .byte 0
+.Lnames_abbrev_end0:
+.Lnames_entries0:
+.Lnames0:
+  .byte 1
+  .long .Ldie_foo - .Lcu_begin0
+  .byte 0
+.Lnames1:
+  .byte 2
+  .long .Ldie_int - .Lcu_begin0
+  .byte 0
+.Lnames_end0:
+
+#--- b.s
+.section .debug_abbrev,"",@progbits
+  .byte 1        # Abbreviation code
+  .byte 0x11     # DW_TAG_compile_unit
+  .byte 1        # DW_CHILDREN_yes
+  .byte 0x03     # DW_AT_name
+  .byte 0x0e     # DW_FORM_strp
+  .byte 0, 0
+  .byte 2        # Abbreviation code
+  .byte 0x2e     # DW_TAG_subprogram
+  .byte 0        # DW_CHILDREN_no
+  .byte 0x03     # DW_AT_name
+  .byte 0x0e     # DW_FORM_strp
+  .byte 0, 0
+  .byte 3        # Abbreviation code
+  .byte 0x24     # DW_TAG_base_type
+  .byte 0        # DW_CHILDREN_no
+  .byte 0x03     # DW_AT_name
+  .byte 0x0e     # DW_FORM_strp
+  .byte 0, 0
+  .byte 0
+
+.section .debug_info,"",@progbits
+.Lcu_begin0:
+  .long .Lcu_end0 - .Lcu_start0
+.Lcu_start0:
+  .short 5                  # DWARF version
+  .byte 1                   # DW_UT_compile
+  .byte 8                   # Address size
+  .long .debug_abbrev
+  .byte 1                   # DW_TAG_compile_unit
+  .long .Lstr_cu
+.Ldie_bar:
+  .byte 2                   # DW_TAG_subprogram
+  .long .Lstr_bar
+.Ldie_int:
+  .byte 3                   # DW_TAG_base_type
+  .long .Lstr_int
+  .byte 0
+.Lcu_end0:
+
+.section .debug_str,"MS",@progbits,1
+.Lstr_cu:
+  .asciz "b.c"
+.Lstr_bar:
+  .asciz "bar"
+.Lstr_int:
+  .asciz "int"
+
+.section .debug_names,"",@progbits
+  .long .Lnames_end0 - .Lnames_start0
+.Lnames_start0:
+  .short 5                  # Version
+  .short 0                  # Padding
+  .long 1                   # CU count
+  .long 0                   # Local TU count
+  .long 0                   # Foreign TU count
+  .long 0                   # Bucket count
+  .long 2                   # Name count
+  .long .Lnames_abbrev_end0 - .Lnames_abbrev_start0
+  .long 0                   # Augmentation string size
+  .long .Lcu_begin0         # CU[0]
+  .long .Lstr_bar           # String offsets
+  .long .Lstr_int
+  .long .Lnames0 - .Lnames_entries0  # Entry offsets
+  .long .Lnames1 - .Lnames_entries0
+.Lnames_abbrev_start0:
+  .byte 1                   # Abbreviation code
+  .byte 0x2e                # DW_TAG_subprogram
+  .byte 3, 0x13             # DW_IDX_die_offset, DW_FORM_ref4
+  .byte 0, 0
+  .byte 2                   # Abbreviation code
+  .byte 0x24                # DW_TAG_base_type
+  .byte 3, 0x13             # DW_IDX_die_offset, DW_FORM_ref4
+  .byte 0, 0
+  .byte 0
+.Lnames_abbrev_end0:
+.Lnames_entries0:
+.Lnames0:
+  .byte 1
+  .long .Ldie_bar - .Lcu_begin0
+  .byte 0
+.Lnames1:
+  .byte 2
+  .long .Ldie_int - .Lcu_begin0
+  .byte 0
+.Lnames_end0:
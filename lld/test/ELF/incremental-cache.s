@@ -0,0 +1,71 @@
+# REQUIRES: x86
+## Test that --incremental-cache reuses the output of an identical link, and
+## that the contents of the files read late in the link are part of the key.
+
+# RUN: rm -rf %t && split-file %s %t && cd %t
+# RUN: llvm-mc -filetype=obj -triple=x86_64 a.s -o a.o
+
+## The first link populates the cache, and an identical link reuses it. The
+## output path and the options that only affect diagnostics or threading are
+## not part of the key.
+# RUN: ld.lld --incremental-cache=cache a.o -o out1 --verbose 2>&1 | \
+# RUN:   FileCheck %s --check-prefix=MISS
+# RUN: ld.lld --incremental-cache=cache a.o -o out2 --verbose 2>&1 | \
+# RUN:   FileCheck %s --check-prefix=HIT
+# RUN: cmp out1 out2
+# RUN: ld.lld --incremental-cache=cache a.o -o out2 --verbose --threads=1 \
+# RUN:   --error-limit=5 --color-diagnostics 2>&1 | FileCheck %s --check-prefix=HIT
+
+# MISS-NOT: --incremental-cache: reused
+# HIT:      --incremental-cache: reused {{.*}}llvmcache-
+
+## Changing the call graph ordering file, but not the command line, is a miss.
+# RUN: cp cg1.txt cg.txt
+# RUN: ld.lld --incremental-cache=cache a.o -o out3 \
+# RUN:   --call-graph-ordering-file=cg.txt --verbose 2>&1 | \
+# RUN:   FileCheck %s --check-prefix=MISS
+# RUN: ld.lld --incremental-cache=cache a.o -o out4 \
+# RUN:   --call-graph-ordering-file=cg.txt --verbose 2>&1 | \
+# RUN:   FileCheck %s --check-prefix=HIT
+# RUN: cp cg2.txt cg.txt
+# RUN: ld.lld --incremental-cache=cache a.o -o out5 \
+# RUN:   --call-graph-ordering-file=cg.txt --verbose 2>&1 | \
+# RUN:   FileCheck %s --check-prefix=MISS
+
+## Options with side outputs bypass the cache.
+# RUN: ld.lld --incremental-cache=cache a.o -o out6 -Map=out6.map --verbose \
+# RUN:   2>&1 | FileCheck %s --check-prefix=MISS
+# RUN: FileCheck %s --check-prefix=MAP < out6.map
+# MAP: .text
+
+## The policy prunes the cache after a link adds an entry.
+# RUN: ls cache/llvmcache-* | count 3
+# RUN: ld.lld --incremental-cache=cache a.o -o out7 -z norelro \
+# RUN:   --incremental-cache-policy=prune_interval=0s:cache_size_files=1
+# RUN: ls cache/llvmcache-* | count 1
+
+## An invalid policy is rejected.
+# RUN: not ld.lld --incremental-cache=cache a.o -o out8 \
+# RUN:   --incremental-cache-policy=foo 2>&1 | FileCheck %s --check-prefix=POLICY
+# POLICY: error: --incremental-cache-policy: invalid cache policy: Unknown key: 'foo'
+
+#--- a.s
+.globl _start
+_start:
+  call a
+
+.section .text.a,"ax",@progbits
+.globl a
+a:
+  call b
+
+.section .text.b,"ax",@progbits
+.globl b
+b:
+  ret
+
+#--- cg1.txt
+a b 10
+
+#--- cg2.txt
+b a 10
@@ -0,0 +1,39 @@
+# REQUIRES: x86
+## Test that -z hugepage-text starts the executable PT_LOAD, and the PT_LOAD
+## after it, at a 2 MiB boundary in both the file and memory.
+
+# RUN: llvm-mc -filetype=obj -triple=x86_64 %s -o %t.o
+# RUN: ld.lld -z hugepage-text %t.o -o %t
+# RUN: llvm-readelf -l %t | FileCheck %s
+
+# CHECK:      Type  Offset   VirtAddr           PhysAddr           FileSiz  MemSiz   Flg Align
+# CHECK-NEXT: PHDR
+# CHECK-NEXT: LOAD  0x000000 0x0000000000200000 0x0000000000200000 {{.*}} R   0x1000
+# CHECK-NEXT: LOAD  0x200000 0x0000000000400000 0x0000000000400000 0x000001 0x000001 R E 0x200000
+# CHECK-NEXT: LOAD  {{0x[0-9a-f]+}} 0x0000000000600000 0x0000000000600000 0x000008 0x000008 RW  0x1000
+
+## Without the option, the segments are only aligned to the page size.
+# RUN: ld.lld %t.o -o %t.default
+# RUN: llvm-readelf -l %t.default | FileCheck %s --check-prefix=DEFAULT
+
+# DEFAULT:      LOAD {{.*}} R E 0x1000
+# DEFAULT-NOT:  0x200000{{$}}
+
+## Segments whose address is set by a linker script are left alone.
+# RUN: echo 'SECTIONS { .rodata : {*(.rodata)} .text 0x300000 : {*(.text)} \
+# RUN:   .data : {*(.data)} }' > %t.script
+# RUN: ld.lld -z hugepage-text -T %t.script %t.o -o %t.script.out
+# RUN: llvm-readelf -l %t.script.out | FileCheck %s --check-prefix=SCRIPT
+
+# SCRIPT:     LOAD {{0x[0-9a-f]+}} 0x0000000000300000 0x0000000000300000 0x000001 0x000001 R E 0x1000
+# SCRIPT-NOT: 0x0000000000400000
+
+.globl _start
+_start:
+  ret
+
+.section .rodata,"a"
+.quad 1
+
+.data
+.quad 2
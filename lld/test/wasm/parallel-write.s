@@ -0,0 +1,67 @@
+## The chunks of the code and data sections are written in parallel. Check
+## that the output does not depend on the number of threads and that the
+## relocations of each chunk are applied to its own bytes.
+
+# RUN: llvm-mc -filetype=obj -triple=wasm32-unknown-unknown %s -o %t.o
+# RUN: wasm-ld --no-entry --no-gc-sections --threads=1 %t.o -o %t1.wasm
+# RUN: wasm-ld --no-entry --no-gc-sections --threads=4 %t.o -o %t4.wasm
+# RUN: cmp %t1.wasm %t4.wasm
+# RUN: obj2yaml %t4.wasm | FileCheck %s
+
+## Function f<a><b> calls f<b><a>, with a padded LEB128 function index.
+## The synthetic __wasm_call_ctors comes first, so f<a><b> has index <a><b>+1.
+# CHECK:      - Type: CODE
+# CHECK-NEXT:   Functions:
+# CHECK-NEXT:     - Index: 0
+# CHECK-NEXT:       Locals: []
+# CHECK-NEXT:       Body: 0B
+# CHECK-NEXT:     - Index: 1
+# CHECK-NEXT:       Locals: []
+# CHECK-NEXT:       Body: 1081808080001A41{{[0-9A-F]+}}0B
+# CHECK-NEXT:     - Index: 2
+# CHECK-NEXT:       Locals: []
+# CHECK-NEXT:       Body: 108B808080001A41{{[0-9A-F]+}}0B
+# CHECK:          - Index: 13
+# CHECK-NEXT:       Locals: []
+# CHECK-NEXT:       Body: 1096808080001A41{{[0-9A-F]+}}0B
+# CHECK:          - Index: 100
+# CHECK-NEXT:       Locals: []
+# CHECK-NEXT:       Body: 10E4808080001A41{{[0-9A-F]+}}0B
+
+## Data symbol d<a><b> holds the bytes <a> and <b>.
+# CHECK:      - Type: DATA
+# CHECK:          Content: '000000010002000300040005000600070008000901000101
+
+.macro decl a, b
+  .functype f\a\b () -> (i32)
+.endm
+
+.macro def a, b
+  .section .text.f\a\b,"",@
+  .globl f\a\b
+f\a\b:
+  .functype f\a\b () -> (i32)
+  call f\b\a
+  drop
+  i32.const d\a\b
+  end_function
+
+  .section .data.d\a\b,"",@
+  .globl d\a\b
+d\a\b:
+  .int8 \a
+  .int8 \b
+  .size d\a\b, 2
+.endm
+
+.irp a,0,1,2,3,4,5,6,7,8,9
+.irp b,0,1,2,3,4,5,6,7,8,9
+  decl \a, \b
+.endr
+.endr
+
+.irp a,0,1,2,3,4,5,6,7,8,9
+.irp b,0,1,2,3,4,5,6,7,8,9
+  def \a, \b
+.endr
+.endr
@@ -79,9 +79,10 @@ void CodeSection::writeTo(uint8_t *buf) {
   // Write code section headers
   memcpy(buf, codeSectionHeader.data(), codeSectionHeader.size());
 
-  // Write code section bodies
-  for (const InputChunk *chunk : functions)
-    chunk->writeTo(buf);
+  // Write code section bodies. Each function is written (and relocated) into
+  // its own range of the buffer, so they can be written in parallel.
+  parallelForEach(functions,
+                  [buf](const InputChunk *chunk) { chunk->writeTo(buf); });
 }
 
 uint32_t CodeSection::getNumRelocations() const {
@@ -184,8 +185,8 @@ void DataSection::writeTo(uint8_t *buf) {
     memcpy(segStart, segment->header.data(), segment->header.size());
 
     // Write segment data payload
-    for (const InputChunk *chunk : segment->inputSegments)
-      chunk->writeTo(buf);
+    parallelForEach(segment->inputSegments,
+                    [buf](const InputChunk *chunk) { chunk->writeTo(buf); });
   }
 }
 
@@ -270,8 +271,8 @@ void CustomSection::writeTo(uint8_t *buf) {
   buf += nameData.size();
 
   // Write custom sections payload
-  for (const InputChunk *section : inputSections)
-    section->writeTo(buf);
+  parallelForEach(inputSections,
+                  [buf](const InputChunk *section) { section->writeTo(buf); });
 }
 
 uint32_t CustomSection::getNumRelocations() const {
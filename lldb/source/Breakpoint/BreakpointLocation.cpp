@@ -18,13 +18,18 @@
 #include "lldb/Symbol/CompileUnit.h"
 #include "lldb/Symbol/Symbol.h"
 #include "lldb/Symbol/TypeSystem.h"
+#include "lldb/Target/Language.h"
 #include "lldb/Target/Process.h"
+#include "lldb/Target/StackFrame.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Target/Thread.h"
 #include "lldb/Target/ThreadSpec.h"
 #include "lldb/Utility/LLDBLog.h"
 #include "lldb/Utility/Log.h"
 #include "lldb/Utility/StreamString.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringExtras.h"
+#include <optional>
 
 using namespace lldb;
 using namespace lldb_private;
@@ -231,6 +236,109 @@ const char *BreakpointLocation::GetConditionText(size_t *hash) const {
       .GetConditionText(hash);
 }
 
+/// Evaluates a condition that only tests an integer variable, or compares it
+/// with an integer literal, such as "i == 42" or "node->depth >= 3", by reading
+/// the variable in \a frame. This saves building, materializing and running
+/// a user expression on every hit for the most common kind of condition.
+/// Returns std::nullopt for any other condition, and for the comparisons whose
+/// C semantics differ from a mathematical comparison of the two values, so the
+/// caller evaluates those as an expression.
+static std::optional<bool> EvaluateSimpleCondition(llvm::StringRef condition,
+                                                   StackFrame &frame) {
+  condition = condition.trim();
+
+  // The variable path: identifiers separated by "." or "->".
+  size_t pos = 0;
+  while (true) {
+    if (pos >= condition.size() ||
+        !(llvm::isAlpha(condition[pos]) || condition[pos] == '_'))
+      return std::nullopt;
+    while (pos < condition.size() &&
+           (llvm::isAlnum(condition[pos]) || condition[pos] == '_'))
+      ++pos;
+    if (condition.substr(pos).startswith("->"))
+      pos += 2;
+    else if (condition.substr(pos).startswith("."))
+      pos += 1;
+    else
+      break;
+  }
+  llvm::StringRef path = condition.take_front(pos);
+  llvm::StringRef rest = condition.drop_front(pos).ltrim();
+
+  llvm::StringRef op;
+  bool negative = false;
+  uint64_t magnitude = 0;
+  if (!rest.empty()) {
+    for (llvm::StringRef candidate : {"==", "!=", "<=", ">=", "<", ">"}) {
+      if (rest.consume_front(candidate)) {
+        op = candidate;
+        break;
+      }
+    }
+    if (op.empty())
+      return std::nullopt;
+    rest = rest.ltrim();
+    negative = rest.consume_front("-");
+    rest = rest.ltrim();
+    // Only decimal literals without a suffix are handled. They have a signed
+    // type, so the comparison is a mathematical one as long as they fit in an
+    // int64_t. The hexadecimal and octal literals which don't fit in an int
+    // are unsigned, and suffixed, character and floating point literals have
+    // other types, so all of those are left to the expression parser.
+    if (rest.empty() || !llvm::all_of(rest, llvm::isDigit) ||
+        (rest.size() > 1 && rest.front() == '0') ||
+        rest.getAsInteger(10, magnitude) || magnitude > uint64_t(INT64_MAX))
+      return std::nullopt;
+  }
+
+  VariableSP var_sp;
+  Status error;
+  ValueObjectSP valobj_sp = frame.GetValueForVariableExpressionPath(
+      path, eNoDynamicValues,
+      StackFrame::eExpressionPathOptionCheckPtrVsMember |
+          StackFrame::eExpressionPathOptionsNoSyntheticChildren,
+      var_sp, error);
+  if (!valobj_sp || error.Fail())
+    return std::nullopt;
+
+  CompilerType type = valobj_sp->GetCompilerType();
+  bool is_signed = false;
+  if (!type.IsIntegerOrEnumerationType(is_signed) ||
+      type.IsScopedEnumerationType() ||
+      valobj_sp->GetByteSize().value_or(UINT64_MAX) > sizeof(uint64_t))
+    return std::nullopt;
+  // C converts a negative literal to the unsigned type of the variable.
+  if (negative && !is_signed)
+    return std::nullopt;
+
+  Scalar scalar;
+  if (!valobj_sp->ResolveValue(scalar))
+    return std::nullopt;
+
+  int compare;
+  if (is_signed) {
+    int64_t lhs = scalar.SLongLong();
+    int64_t rhs = negative ? -int64_t(magnitude) : int64_t(magnitude);
+    compare = lhs < rhs ? -1 : lhs > rhs;
+  } else {
+    uint64_t lhs = scalar.ULongLong();
+    compare = lhs < magnitude ? -1 : lhs > magnitude;
+  }
+
+  if (op.empty() || op == "!=")
+    return compare != 0;
+  if (op == "==")
+    return compare == 0;
+  if (op == "<")
+    return compare < 0;
+  if (op == "<=")
+    return compare <= 0;
+  if (op == ">")
+    return compare > 0;
+  return compare >= 0;
+}
+
 bool BreakpointLocation::ConditionSaysStop(ExecutionContext &exe_ctx,
                                            Status &error) {
   Log *log = GetLog(LLDBLog::Breakpoints);
@@ -247,6 +355,20 @@ bool BreakpointLocation::ConditionSaysStop(ExecutionContext &exe_ctx,
 
   error.Clear();
 
+  // Simple comparisons in C family languages are evaluated by reading the
+  // variable, without going through the expression parser.
+  if (StackFrame *frame = exe_ctx.GetFramePtr()) {
+    CompileUnit *comp_unit = m_address.CalculateSymbolContextCompileUnit();
+    if (comp_unit && Language::LanguageIsCFamily(comp_unit->GetLanguage())) {
+      if (std::optional<bool> result =
+              EvaluateSimpleCondition(condition_text, *frame)) {
+        LLDB_LOGF(log, "Condition evaluated from the frame, result is %s.",
+                  *result ? "true" : "false");
+        return *result;
+      }
+    }
+  }
+
   DiagnosticManager diagnostics;
 
   if (condition_hash != m_condition_hash || !m_user_expression_sp ||
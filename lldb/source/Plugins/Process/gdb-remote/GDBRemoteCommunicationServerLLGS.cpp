@@ -13,6 +13,7 @@
 #include <chrono>
 #include <cstring>
 #include <limits>
+#include <map>
 #include <optional>
 #include <thread>
 
@@ -692,6 +693,51 @@ GetRegistersAsJSON(NativeThreadProtocol &thread) {
   return register_object;
 }
 
+using StackMemoryMap = std::map<lldb::addr_t, std::vector<uint8_t>>;
+
+/// Reads the saved frame pointer and return address of up to
+/// \a backtrace_limit frames of \a thread by following its frame pointer
+/// chain, the way debugserver does. The client adds this expedited memory to
+/// its memory cache, so unwinding these frames needs no memory read packets.
+static StackMemoryMap ReadStackMemory(NativeThreadProtocol &thread,
+                                      uint32_t backtrace_limit) {
+  StackMemoryMap stack_mmap;
+  NativeProcessProtocol &process = thread.GetProcess();
+  const uint32_t addr_size = process.GetAddressByteSize();
+  if (addr_size != 4 && addr_size != 8)
+    return stack_mmap;
+
+  lldb::addr_t fp = thread.GetRegisterContext().GetFP(0);
+  for (uint32_t frame_count = 0; fp != 0 && frame_count < backtrace_limit;
+       ++frame_count) {
+    // Make sure we don't put the same stack memory in more than once.
+    if (stack_mmap.count(fp))
+      break;
+
+    std::vector<uint8_t> bytes(addr_size * 2);
+    size_t bytes_read = 0;
+    Status error = process.ReadMemoryWithoutTrap(fp, bytes.data(),
+                                                 bytes.size(), bytes_read);
+    if (error.Fail() || bytes_read != bytes.size())
+      break;
+
+    // Dereference the frame pointer to get to the previous frame pointer.
+    lldb::addr_t next_fp;
+    if (addr_size == 4) {
+      uint32_t fp32;
+      memcpy(&fp32, bytes.data(), sizeof(fp32));
+      next_fp = fp32;
+    } else {
+      uint64_t fp64;
+      memcpy(&fp64, bytes.data(), sizeof(fp64));
+      next_fp = fp64;
+    }
+    stack_mmap.emplace(fp, std::move(bytes));
+    fp = next_fp;
+  }
+  return stack_mmap;
+}
+
 static const char *GetStopReasonString(StopReason stop_reason) {
   switch (stop_reason) {
   case eStopReasonTrace:
@@ -755,6 +801,22 @@ GetJSONThreadsInfo(NativeProcessProtocol &process, bool abridged) {
     if (!abridged) {
       if (std::optional<json::Object> registers = GetRegistersAsJSON(thread))
         thread_obj.try_emplace("registers", std::move(*registers));
+
+      // Add expedited stack memory so that backtracing doesn't need to read
+      // the frame pointer chain.
+      StackMemoryMap stack_mmap = ReadStackMemory(thread, 256);
+      if (!stack_mmap.empty()) {
+        json::Array memory_array;
+        for (const auto &stack_memory : stack_mmap) {
+          StreamString bytes;
+          bytes.PutBytesAsRawHex8(stack_memory.second.data(),
+                                  stack_memory.second.size());
+          memory_array.push_back(json::Object{
+              {"address", static_cast<int64_t>(stack_memory.first)},
+              {"bytes", bytes.GetString().str()}});
+        }
+        thread_obj.try_emplace("memory", std::move(memory_array));
+      }
     }
 
     thread_obj.try_emplace("tid", static_cast<int64_t>(tid));
@@ -975,6 +1037,15 @@ GDBRemoteCommunicationServerLLGS::PrepareStopReplyPacketForThread(
     }
   }
 
+  // Add expedited stack memory for the first frames so that the client can
+  // step and backtrace through them without reading the frame pointer chain.
+  for (const auto &stack_memory : ReadStackMemory(thread, 2)) {
+    response.Printf("memory:0x%" PRIx64 "=", stack_memory.first);
+    response.PutBytesAsRawHex8(stack_memory.second.data(),
+                               stack_memory.second.size());
+    response.PutChar(';');
+  }
+
   // Include child process PID/TID for forks.
   if (tid_stop_info.reason == eStopReasonFork ||
       tid_stop_info.reason == eStopReasonVFork) {
@@ -13,6 +13,7 @@
 #include "DWARFDebugInfo.h"
 #include "DWARFDeclContext.h"
 #include "DWARFDefines.h"
+#include "DWARFTypeUnit.h"
 #include "SymbolFileDWARF.h"
 #include "SymbolFileDWARFDebugMap.h"
 #include "SymbolFileDWARFDwo.h"
@@ -22,6 +23,7 @@
 #include "Plugins/ExpressionParser/Clang/ClangASTMetadata.h"
 #include "Plugins/ExpressionParser/Clang/ClangUtil.h"
 #include "Plugins/Language/ObjC/ObjCLanguage.h"
+#include "lldb/Core/Debugger.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Core/Value.h"
 #include "lldb/Host/Host.h"
@@ -41,7 +43,9 @@
 #include "clang/AST/DeclObjC.h"
 #include "clang/AST/DeclTemplate.h"
 #include "clang/AST/Type.h"
+#include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/Demangle/Demangle.h"
+#include "llvm/Support/ThreadPool.h"
 
 #include <map>
 #include <memory>
@@ -2157,6 +2161,47 @@ bool DWARFASTParserClang::ParseTemplateParameterInfos(
          template_param_infos.hasParameterPack();
 }
 
+/// Returns the unit that the DW_AT_type of \a die points into when that is not
+/// the unit of \a die itself, without extracting the DIEs of the target unit.
+static DWARFUnit *GetOtherUnitOfTypeReference(const DWARFDIE &die) {
+  DWARFFormValue form_value;
+  if (!die.GetDIE()->GetAttributeValue(die.GetCU(), DW_AT_type, form_value))
+    return nullptr;
+  DWARFDebugInfo &debug_info = die.GetCU()->GetSymbolFileDWARF().DebugInfo();
+  switch (form_value.Form()) {
+  case DW_FORM_ref_addr:
+    return debug_info.GetUnitContainingDIEOffset(DIERef::Section::DebugInfo,
+                                                 form_value.Unsigned());
+  case DW_FORM_ref_sig8:
+    return debug_info.GetTypeUnitForHash(form_value.Unsigned());
+  default:
+    return nullptr;
+  }
+}
+
+/// Extract the DIEs of the other units which the members and base classes of
+/// \a die refer to in parallel, before ParseChildMembers completes their types
+/// one at a time. With type units every class lives in its own unit, so this
+/// saves parsing each of them serially while the module mutex is held.
+static void PrefetchMemberTypeUnits(const DWARFDIE &die) {
+  llvm::SmallPtrSet<DWARFUnit *, 8> units;
+  for (DWARFDIE child : die.children()) {
+    const dw_tag_t tag = child.Tag();
+    if (tag != DW_TAG_member && tag != DW_TAG_inheritance)
+      continue;
+    if (DWARFUnit *unit = GetOtherUnitOfTypeReference(child))
+      if (unit != die.GetCU() && !unit->HasDIEsParsed())
+        units.insert(unit);
+  }
+  if (units.size() < 2)
+    return;
+
+  llvm::ThreadPoolTaskGroup task_group(Debugger::GetThreadPool());
+  for (DWARFUnit *unit : units)
+    task_group.async([unit] { unit->ExtractDIEsIfNeeded(); });
+  task_group.wait();
+}
+
 bool DWARFASTParserClang::CompleteRecordType(const DWARFDIE &die,
                                              lldb_private::Type *type,
                                              CompilerType &clang_type) {
@@ -2188,6 +2233,7 @@ bool DWARFASTParserClang::CompleteRecordType(const DWARFDIE &die,
     std::vector<DWARFDIE> member_function_dies;
 
     DelayedPropertyList delayed_properties;
+    PrefetchMemberTypeUnits(die);
     ParseChildMembers(die, clang_type, bases, member_function_dies,
                       delayed_properties, default_accessibility, layout_info);
 
@@ -98,6 +98,10 @@ public:
   void ExtractUnitDIEIfNeeded();
   void ExtractUnitDIENoDwoIfNeeded();
   void ExtractDIEsIfNeeded();
+  bool HasDIEsParsed() const {
+    llvm::sys::ScopedReader lock(m_die_array_mutex);
+    return !m_die_array.empty();
+  }
 
   class ScopedExtractDIEs {
     DWARFUnit *m_cu;
@@ -118,8 +118,17 @@ void ManualDWARFIndex::Index() {
 
   auto finalize_fn = [this, &sets, &progress](NameToDIE(IndexSet::*index)) {
     NameToDIE &result = m_set.*index;
+    // Allocate the merged index once instead of letting it double while the
+    // units are appended, and give back the memory of each unit's index as
+    // soon as it has been copied so the peak stays close to one copy.
+    size_t total = result.GetSize();
     for (auto &set : sets)
+      total += (set.*index).GetSize();
+    result.Reserve(total);
+    for (auto &set : sets) {
       result.Append(set.*index);
+      set.*index = NameToDIE();
+    }
     result.Finalize();
     progress.Increment();
   };
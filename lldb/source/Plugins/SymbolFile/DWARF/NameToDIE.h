@@ -84,6 +84,10 @@ public:
 
   bool IsEmpty() const { return m_map.IsEmpty(); }
 
+  size_t GetSize() const { return m_map.GetSize(); }
+
+  void Reserve(size_t n) { m_map.Reserve(n); }
+
   void Clear() { m_map.Clear(); }
 
 protected:
@@ -64,6 +64,7 @@
 
 #include "llvm/ADT/ScopeExit.h"
 #include "llvm/ADT/SetVector.h"
+#include "llvm/Support/ThreadPool.h"
 
 #include <memory>
 #include <mutex>
@@ -1646,6 +1647,22 @@ void Target::NotifyModulesRemoved(lldb_private::ModuleList &module_list) {
 void Target::ModulesDidLoad(ModuleList &module_list) {
   const size_t num_images = module_list.GetSize();
   if (m_valid && num_images) {
+    // Parse the symbol tables and index the debug info of all the modules at
+    // once before the breakpoints get resolved in them, instead of one module
+    // at a time on the first lookup. Modules that were already preloaded
+    // return right away.
+    if (GetPreloadSymbols()) {
+      if (num_images == 1) {
+        if (ModuleSP module_sp = module_list.GetModuleAtIndex(0))
+          module_sp->PreloadSymbols();
+      } else {
+        llvm::ThreadPoolTaskGroup task_group(Debugger::GetThreadPool());
+        for (size_t idx = 0; idx < num_images; ++idx)
+          if (ModuleSP module_sp = module_list.GetModuleAtIndex(idx))
+            task_group.async([module_sp] { module_sp->PreloadSymbols(); });
+        task_group.wait();
+      }
+    }
     for (size_t idx = 0; idx < num_images; ++idx) {
       ModuleSP module_sp(module_list.GetModuleAtIndex(idx));
       LoadScriptingResourceForModule(module_sp, this);
@@ -2230,9 +2247,10 @@ ModuleSP Target::GetOrCreateModule(const ModuleSpec &module_spec, bool notify,
           });
         }
 
-        // Preload symbols outside of any lock, so hopefully we can do this for
-        // each library in parallel.
-        if (GetPreloadSymbols())
+        // Preload symbols outside of any lock. Callers that don't notify only
+        // report the module later in a batch to ModulesDidLoad, which preloads
+        // all of them in parallel.
+        if (notify && GetPreloadSymbols())
           module_sp->PreloadSymbols();
 
         llvm::SmallVector<ModuleSP, 1> replaced_modules;
@@ -0,0 +1,86 @@
+"""
+Test the breakpoint conditions that are evaluated by reading a variable instead
+of running an expression, and the ones whose literals need the C rules, which
+are left to the expression parser.
+"""
+
+
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class SimpleBreakpointConditionsTestCase(TestBase):
+
+    NO_DEBUG_INFO_TESTCASE = True
+
+    def stops_for_condition(self, target, condition):
+        """Run to completion with a breakpoint on the loop body conditioned
+        on 'condition', and return the values of i at the stops."""
+        bkpt = target.BreakpointCreateBySourceRegex(
+            "break here", lldb.SBFileSpec("main.c"))
+        self.assertTrue(bkpt.IsValid() and bkpt.GetNumLocations() == 1,
+                        VALID_BREAKPOINT)
+        bkpt.SetCondition(condition)
+
+        process = target.LaunchSimple(
+            None, None, self.get_process_working_directory())
+        self.assertTrue(process, PROCESS_IS_VALID)
+
+        stops = []
+        while process.GetState() == lldb.eStateStopped:
+            thread = lldbutil.get_one_thread_stopped_at_breakpoint(
+                process, bkpt)
+            self.assertIsNotNone(thread, "Stopped at the breakpoint")
+            stops.append(
+                thread.GetFrameAtIndex(0).FindVariable("i").GetValueAsSigned())
+            process.Continue()
+
+        self.assertState(process.GetState(), lldb.eStateExited)
+        target.BreakpointDelete(bkpt.GetID())
+        return stops
+
+    def test_simple_conditions(self):
+        """Test the conditions which compare a variable with a decimal
+        literal, or only test a variable."""
+        self.build()
+        target = self.createTestTarget()
+
+        all_stops = list(range(10))
+        self.assertEqual(self.stops_for_condition(target, "i == 3"), [3])
+        self.assertEqual(self.stops_for_condition(target, " i>=7 "), [7, 8, 9])
+        self.assertEqual(self.stops_for_condition(target, "i < -1"), [])
+        self.assertEqual(self.stops_for_condition(target, "count != 5"),
+                         [i for i in all_stops if i != 5])
+        self.assertEqual(self.stops_for_condition(target, "i"), all_stops[1:])
+        self.assertEqual(self.stops_for_condition(target, "child.depth"),
+                         all_stops)
+        self.assertEqual(
+            self.stops_for_condition(target, "node->parent->depth"), [])
+        self.assertEqual(
+            self.stops_for_condition(target, "minus_one == 4294967295"), [])
+
+    def test_c_literal_types(self):
+        """Test the conditions whose literals have the types of C, which
+        differ from a mathematical comparison or from a decimal value."""
+        self.build()
+        target = self.createTestTarget()
+
+        all_stops = list(range(10))
+        # The hexadecimal literals that don't fit in an int are unsigned, so
+        # minus_one is converted to unsigned.
+        self.assertEqual(
+            self.stops_for_condition(target, "minus_one == 0xffffffff"),
+            all_stops)
+        self.assertEqual(
+            self.stops_for_condition(target, "minus_one < 0x80000000"), [])
+        self.assertEqual(
+            self.stops_for_condition(target, "minus_one == 037777777777"),
+            all_stops)
+        # A leading 0 makes a literal octal.
+        self.assertEqual(self.stops_for_condition(target, "i == 010"), [8])
+        self.assertEqual(self.stops_for_condition(target, "i == 0"), [0])
+        # A suffix makes an unsigned literal too.
+        self.assertEqual(self.stops_for_condition(target, "minus_one > 1u"),
+                         all_stops)
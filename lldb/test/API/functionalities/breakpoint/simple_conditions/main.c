@@ -0,0 +1,16 @@
+struct node {
+  int depth;
+  struct node *parent;
+};
+
+int main(int argc, char **argv) {
+  struct node root = {0, 0};
+  struct node child = {1, &root};
+  struct node *node = &child;
+  int minus_one = -1;
+  unsigned count = 0;
+  for (int i = 0; i < 10; ++i) {
+    count += 1; // break here
+  }
+  return node->depth + minus_one;
+}
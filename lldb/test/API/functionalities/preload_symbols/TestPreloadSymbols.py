@@ -0,0 +1,42 @@
+"""
+Test that the symbols of the modules loaded by the dynamic loader are
+preloaded when the target asks for it.
+"""
+
+import json
+import os
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class PreloadSymbolsTestCase(TestBase):
+
+    def get_module_stats(self, target, name):
+        stream = lldb.SBStream()
+        target.GetStatistics().GetAsJSON(stream)
+        stats = json.loads(stream.GetData())
+        for module in stats["modules"]:
+            if os.path.basename(module["path"]) == name:
+                return module
+        self.fail("no statistics for module '%s'" % name)
+
+    @skipIfRemote
+    def test_preload_symbols(self):
+        """The dynamic loader reports its modules in a batch, which preloads
+        the symbol table and the debug info index of each of them."""
+        self.build()
+        self.runCmd("settings set symbols.enable-lldb-index-cache false")
+        self.runCmd("settings set target.preload-symbols true")
+        target, process, _, _ = lldbutil.run_to_source_breakpoint(
+            self, "// break here", lldb.SBFileSpec("main.cpp"),
+            extra_images=["foo"])
+
+        # The breakpoint is resolved through the line tables, so it is the
+        # preloading that indexed the debug info of the library.
+        module = self.get_module_stats(
+            target, self.platformContext.shlib_prefix + "foo." +
+            self.platformContext.shlib_extension)
+        self.assertGreater(module["symbolTableParseTime"], 0.0)
+        self.assertGreater(module["debugInfoIndexTime"], 0.0)
@@ -0,0 +1,5 @@
+int foo(int x);
+
+int main() {
+  return foo(41) - 42; // break here
+}
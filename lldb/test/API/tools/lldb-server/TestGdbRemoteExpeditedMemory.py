@@ -0,0 +1,84 @@
+import json
+import re
+
+import gdbremote_testcase
+import lldbgdbserverutils
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class TestGdbRemoteExpeditedMemory(gdbremote_testcase.GdbRemoteTestCaseBase):
+    """Test that lldb-server sends the frame pointer chain of the stopped
+    thread along with the stop reply and jThreadsInfo."""
+
+    def stop_at_trap(self):
+        procs = self.prep_debug_monitor_and_inferior(inferior_args=["trap"])
+        self.test_sequence.add_log_lines([
+            "read packet: $c#63",
+            {"direction": "send",
+             "regex": r"^\$T([0-9a-fA-F]+)([^#]+)#[0-9a-fA-F]{2}$",
+             "capture": {1: "stop_result",
+                         2: "key_vals_text"}},
+        ], True)
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+        key_vals_text = context.get("key_vals_text")
+        self.assertIsNotNone(key_vals_text)
+        return key_vals_text
+
+    def get_frame_pointer(self, key_vals_text):
+        expedited_registers = self.extract_registers_from_stop_notification(
+            key_vals_text)
+        reg_infos = self.gather_register_infos()
+        fp_info = self.find_generic_register_with_name(reg_infos, "fp")
+        self.assertIsNotNone(fp_info)
+        self.assertIn(fp_info["lldb_register_index"], expedited_registers)
+        return lldbgdbserverutils.unpack_register_hex_unsigned(
+            self.get_target_byte_order(),
+            expedited_registers[fp_info["lldb_register_index"]])
+
+    # The inferior is built with frame pointers on these targets, and the
+    # trap happens in one of its functions.
+    @skipUnlessPlatform(["linux"])
+    @skipIf(archs=no_match(["x86_64", "aarch64"]))
+    def test_stop_reply_contains_frame_pointer_chain(self):
+        self.build()
+        self.set_inferior_startup_launch()
+        key_vals_text = self.stop_at_trap()
+        fp = self.get_frame_pointer(key_vals_text)
+
+        # The saved frame pointer and return address of the first two frames.
+        memory = {int(addr, 16): data for addr, data in re.findall(
+            r"memory:0x([0-9a-fA-F]+)=([0-9a-fA-F]+);", key_vals_text)}
+        self.assertIn(fp, memory)
+        self.assertEqual(len(memory[fp]), 2 * 2 * 8)
+        self.assertLessEqual(len(memory), 2)
+
+    @skipUnlessPlatform(["linux"])
+    @skipIf(archs=no_match(["x86_64", "aarch64"]))
+    def test_threads_info_contains_frame_pointer_chain(self):
+        self.build()
+        self.set_inferior_startup_launch()
+        fp = self.get_frame_pointer(self.stop_at_trap())
+
+        self.reset_test_sequence()
+        self.test_sequence.add_log_lines([
+            "read packet: $jThreadsInfo#c1",
+            {"direction": "send",
+             "regex": r"^\$(.*)#[0-9a-fA-F]{2}$",
+             "capture": {1: "threads_info"}},
+        ], True)
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+        # The jThreadsInfo response is not valid JSON data, so we have to
+        # clean it up first.
+        threads_info = json.loads(
+            re.sub(r"}]", "}", context.get("threads_info")))
+
+        memory = {}
+        for thread_info in threads_info:
+            for entry in thread_info.get("memory", []):
+                memory[entry["address"]] = entry["bytes"]
+        self.assertIn(fp, memory)
+        self.assertEqual(len(memory[fp]), 2 * 2 * 8)
@@ -0,0 +1,51 @@
+// With type units, each of the classes lives in its own unit. Completing
+// Outer extracts the units of its base class and of the types of its members
+// in parallel first. Check that all of them are complete.
+
+// REQUIRES: lld
+
+// RUN: %clangxx --target=x86_64-pc-linux -g -gdwarf-4 -fdebug-types-section \
+// RUN:   -fno-limit-debug-info -c %s -o %t.o
+// RUN: ld.lld %t.o -o %t
+// RUN: %lldb %t -b -o "type lookup Outer" -o "target variable g" | FileCheck %s
+
+// CHECK-LABEL: type lookup Outer
+// CHECK:      struct Outer : public Base {
+// CHECK-NEXT:     A a;
+// CHECK-NEXT:     B b;
+// CHECK-NEXT:     C c;
+// CHECK-NEXT: }
+
+// CHECK-LABEL: target variable g
+// CHECK:      (Outer) g = {
+// CHECK-NEXT:   Base = (base = 1)
+// CHECK-NEXT:   a = (x = 2)
+// CHECK-NEXT:   b = (y = 3)
+// CHECK-NEXT:   c = (z = 4)
+// CHECK-NEXT: }
+
+struct Base {
+  int base;
+};
+
+struct A {
+  int x;
+};
+
+struct B {
+  long y;
+};
+
+struct C {
+  short z;
+};
+
+struct Outer : Base {
+  A a;
+  B b;
+  C c;
+};
+
+Outer g = {{1}, {2}, {3}, {4}};
+
+extern "C" void _start() {}
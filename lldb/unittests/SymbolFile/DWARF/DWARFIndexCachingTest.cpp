@@ -88,6 +88,45 @@ TEST(DWARFIndexCachingTest, NameToDIEEncodeDecode) {
   EncodeDecode(map);
 }
 
+TEST(DWARFIndexCachingTest, NameToDIEReserveAppend) {
+  const DIERef die1(std::nullopt, DIERef::Section::DebugInfo, 0x10);
+  const DIERef die2(100, DIERef::Section::DebugInfo, 0x20);
+  const DIERef die3(200, DIERef::Section::DebugTypes, 0x30);
+
+  NameToDIE unit1;
+  unit1.Insert(ConstString("hello"), die1);
+  unit1.Insert(ConstString("world"), die2);
+  NameToDIE unit2;
+  unit2.Insert(ConstString("hello"), die3);
+  EXPECT_EQ(unit1.GetSize(), 2u);
+  EXPECT_EQ(unit2.GetSize(), 1u);
+
+  // Merging the per-unit maps into a map reserved to their total size gives
+  // the same map as inserting all the entries into a single one.
+  NameToDIE merged;
+  merged.Reserve(unit1.GetSize() + unit2.GetSize());
+  merged.Append(unit1);
+  merged.Append(unit2);
+  merged.Finalize();
+  EXPECT_EQ(merged.GetSize(), 3u);
+
+  NameToDIE expected;
+  expected.Insert(ConstString("hello"), die1);
+  expected.Insert(ConstString("world"), die2);
+  expected.Insert(ConstString("hello"), die3);
+  expected.Finalize();
+  EXPECT_EQ(merged, expected);
+  EncodeDecode(merged);
+}
+
+TEST(DWARFIndexCachingTest, IndexCacheDefaults) {
+  // The cache is keyed on the module UUID and modification time, so it is
+  // enabled by default, with the size of its directory bounded.
+  ModuleListProperties properties;
+  EXPECT_TRUE(properties.GetEnableLLDBIndexCache());
+  EXPECT_EQ(properties.GetLLDBIndexCacheMaxPercent(), 10u);
+}
+
 static void EncodeDecode(const ManualDWARFIndex::IndexSet &object,
                          ByteOrder byte_order) {
   const uint8_t addr_size = 8;
@@ -0,0 +1,178 @@
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/APInt.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/SwissDenseMap.h"
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace llvm;
+
+// The keys are pseudo-random so that the hash tables don't benefit from the
+// regularity of sequential keys, and fixed so that runs are comparable.
+static std::vector<uint64_t> makeIntKeys(size_t N) {
+  std::mt19937_64 Generator(N);
+  std::vector<uint64_t> Keys(N);
+  for (uint64_t &Key : Keys)
+    Key = Generator() >> 1; // Stay clear of the empty and tombstone keys.
+  return Keys;
+}
+
+static std::vector<std::string> makeStringKeys(size_t N) {
+  std::vector<std::string> Keys;
+  Keys.reserve(N);
+  for (uint64_t Key : makeIntKeys(N))
+    Keys.push_back("identifier_" + std::to_string(Key));
+  return Keys;
+}
+
+template <typename MapT> static void BM_MapInsert(benchmark::State &State) {
+  std::vector<uint64_t> Keys = makeIntKeys(State.range(0));
+  for (auto _ : State) {
+    MapT Map;
+    for (uint64_t Key : Keys)
+      Map[Key] = Key;
+    benchmark::DoNotOptimize(Map.size());
+  }
+  State.SetItemsProcessed(State.iterations() * Keys.size());
+}
+BENCHMARK_TEMPLATE(BM_MapInsert, DenseMap<uint64_t, uint64_t>)
+    ->Range(16, 1 << 16);
+BENCHMARK_TEMPLATE(BM_MapInsert, SwissDenseMap<uint64_t, uint64_t>)
+    ->Range(16, 1 << 16);
+
+template <typename MapT> static void BM_MapLookup(benchmark::State &State) {
+  std::vector<uint64_t> Keys = makeIntKeys(State.range(0));
+  MapT Map;
+  for (uint64_t Key : Keys)
+    Map[Key] = Key;
+  for (auto _ : State)
+    for (uint64_t Key : Keys)
+      benchmark::DoNotOptimize(Map.find(Key));
+  State.SetItemsProcessed(State.iterations() * Keys.size());
+}
+BENCHMARK_TEMPLATE(BM_MapLookup, DenseMap<uint64_t, uint64_t>)
+    ->Range(16, 1 << 16);
+BENCHMARK_TEMPLATE(BM_MapLookup, SwissDenseMap<uint64_t, uint64_t>)
+    ->Range(16, 1 << 16);
+
+// Lookups of keys that are not in the map, which probe until an empty bucket.
+template <typename MapT> static void BM_MapLookupMiss(benchmark::State &State) {
+  std::vector<uint64_t> Keys = makeIntKeys(State.range(0));
+  MapT Map;
+  for (uint64_t Key : Keys)
+    Map[Key] = Key;
+  for (auto _ : State)
+    for (uint64_t Key : Keys)
+      benchmark::DoNotOptimize(Map.find(Key + 1));
+  State.SetItemsProcessed(State.iterations() * Keys.size());
+}
+BENCHMARK_TEMPLATE(BM_MapLookupMiss, DenseMap<uint64_t, uint64_t>)
+    ->Range(16, 1 << 16);
+BENCHMARK_TEMPLATE(BM_MapLookupMiss, SwissDenseMap<uint64_t, uint64_t>)
+    ->Range(16, 1 << 16);
+
+// Pointer keys, as in the value maps of the optimizer, whose DenseMapInfo hash
+// is weak.
+template <typename MapT>
+static void BM_PointerMapLookup(benchmark::State &State) {
+  std::vector<std::unique_ptr<uint64_t>> Objects;
+  MapT Map;
+  for (int64_t I = 0; I < State.range(0); ++I) {
+    Objects.push_back(std::make_unique<uint64_t>(I));
+    Map[Objects.back().get()] = I;
+  }
+  for (auto _ : State)
+    for (const std::unique_ptr<uint64_t> &Object : Objects)
+      benchmark::DoNotOptimize(Map.find(Object.get()));
+  State.SetItemsProcessed(State.iterations() * Objects.size());
+}
+BENCHMARK_TEMPLATE(BM_PointerMapLookup, DenseMap<uint64_t *, int64_t>)
+    ->Range(16, 1 << 16);
+BENCHMARK_TEMPLATE(BM_PointerMapLookup, SwissDenseMap<uint64_t *, int64_t>)
+    ->Range(16, 1 << 16);
+
+static void BM_StringMapInsert(benchmark::State &State) {
+  std::vector<std::string> Keys = makeStringKeys(State.range(0));
+  for (auto _ : State) {
+    StringMap<unsigned> Map;
+    for (const std::string &Key : Keys)
+      Map[Key] = Key.size();
+    benchmark::DoNotOptimize(Map.size());
+  }
+  State.SetItemsProcessed(State.iterations() * Keys.size());
+}
+BENCHMARK(BM_StringMapInsert)->Range(16, 1 << 16);
+
+static void BM_StringMapLookup(benchmark::State &State) {
+  std::vector<std::string> Keys = makeStringKeys(State.range(0));
+  StringMap<unsigned> Map;
+  for (const std::string &Key : Keys)
+    Map[Key] = Key.size();
+  for (auto _ : State)
+    for (const std::string &Key : Keys)
+      benchmark::DoNotOptimize(Map.find(Key));
+  State.SetItemsProcessed(State.iterations() * Keys.size());
+}
+BENCHMARK(BM_StringMapLookup)->Range(16, 1 << 16);
+
+template <typename VectorT>
+static void BM_SmallVectorPushBack(benchmark::State &State) {
+  unsigned N = State.range(0);
+  for (auto _ : State) {
+    VectorT Vector;
+    for (unsigned I = 0; I < N; ++I)
+      Vector.push_back(I);
+    benchmark::DoNotOptimize(Vector.data());
+  }
+  State.SetItemsProcessed(State.iterations() * N);
+}
+// Sizes below and above the inline capacity.
+BENCHMARK_TEMPLATE(BM_SmallVectorPushBack, SmallVector<unsigned, 8>)
+    ->Arg(4)
+    ->Arg(8)
+    ->Arg(64)
+    ->Arg(1024);
+BENCHMARK_TEMPLATE(BM_SmallVectorPushBack, SmallVector<uint64_t, 4>)
+    ->Arg(4)
+    ->Arg(64)
+    ->Arg(1024);
+
+static SmallVector<APInt, 0> makeAPInts(unsigned BitWidth, size_t N) {
+  std::mt19937_64 Generator(BitWidth);
+  SmallVector<APInt, 0> Values;
+  for (size_t I = 0; I < N; ++I) {
+    SmallVector<uint64_t, 16> Words((BitWidth + 63) / 64);
+    for (uint64_t &Word : Words)
+      Word = Generator();
+    APInt Value(BitWidth, ArrayRef(Words));
+    // Keep the divisors non-zero.
+    Value.setBit(0);
+    Values.push_back(std::move(Value));
+  }
+  return Values;
+}
+
+static void BM_APIntMul(benchmark::State &State) {
+  SmallVector<APInt, 0> Values = makeAPInts(State.range(0), 64);
+  for (auto _ : State)
+    for (size_t I = 1; I < Values.size(); ++I)
+      benchmark::DoNotOptimize(Values[I - 1] * Values[I]);
+  State.SetItemsProcessed(State.iterations() * (Values.size() - 1));
+}
+BENCHMARK(BM_APIntMul)->Arg(32)->Arg(64)->Arg(128)->Arg(256)->Arg(1024);
+
+static void BM_APIntUDiv(benchmark::State &State) {
+  SmallVector<APInt, 0> Values = makeAPInts(State.range(0), 64);
+  for (auto _ : State)
+    for (size_t I = 1; I < Values.size(); ++I)
+      benchmark::DoNotOptimize(Values[I - 1].udiv(Values[I].lshr(1) | 1));
+  State.SetItemsProcessed(State.iterations() * (Values.size() - 1));
+}
+BENCHMARK(BM_APIntUDiv)->Arg(32)->Arg(64)->Arg(128)->Arg(256)->Arg(1024);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,90 @@
+#include "benchmark/benchmark.h"
+#include "llvm/IR/BasicBlock.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/Verifier.h"
+#include <memory>
+
+using namespace llvm;
+
+// Builds a function of \p NumBlocks diamonds, each of which loads from and
+// stores to an array argument, does some arithmetic and merges its two sides
+// with a phi. This is the shape of typical unoptimized scalar code.
+static Function *buildFunction(Module &M, unsigned NumBlocks) {
+  LLVMContext &Ctx = M.getContext();
+  Type *I64 = Type::getInt64Ty(Ctx);
+  FunctionType *FTy =
+      FunctionType::get(I64, {PointerType::getUnqual(Ctx), I64}, false);
+  Function *F = Function::Create(FTy, GlobalValue::ExternalLinkage, "f", M);
+  Argument *Array = F->getArg(0);
+  Argument *N = F->getArg(1);
+
+  IRBuilder<> Builder(BasicBlock::Create(Ctx, "entry", F));
+  Value *Acc = N;
+  for (unsigned I = 0; I < NumBlocks; ++I) {
+    Value *Ptr = Builder.CreateGEP(I64, Array, Builder.getInt64(I));
+    Value *Elt = Builder.CreateLoad(I64, Ptr);
+    Value *Cond = Builder.CreateICmpSLT(Elt, Acc);
+
+    BasicBlock *Then = BasicBlock::Create(Ctx, "then", F);
+    BasicBlock *Else = BasicBlock::Create(Ctx, "else", F);
+    BasicBlock *Merge = BasicBlock::Create(Ctx, "merge", F);
+    Builder.CreateCondBr(Cond, Then, Else);
+
+    Builder.SetInsertPoint(Then);
+    Value *ThenVal = Builder.CreateAdd(Builder.CreateMul(Elt, Acc), N);
+    Builder.CreateBr(Merge);
+
+    Builder.SetInsertPoint(Else);
+    Value *ElseVal = Builder.CreateXor(Builder.CreateShl(Acc, 3), Elt);
+    Builder.CreateStore(ElseVal, Ptr);
+    Builder.CreateBr(Merge);
+
+    Builder.SetInsertPoint(Merge);
+    PHINode *Phi = Builder.CreatePHI(I64, 2);
+    Phi->addIncoming(ThenVal, Then);
+    Phi->addIncoming(ElseVal, Else);
+    Acc = Phi;
+  }
+  Builder.CreateRet(Acc);
+  return F;
+}
+
+static void BM_IRBuilderBuildFunction(benchmark::State &State) {
+  LLVMContext Ctx;
+  for (auto _ : State) {
+    Module M("benchmark", Ctx);
+    benchmark::DoNotOptimize(buildFunction(M, State.range(0)));
+  }
+  State.SetItemsProcessed(State.iterations() * State.range(0));
+}
+BENCHMARK(BM_IRBuilderBuildFunction)->Range(8, 4096);
+
+static void BM_VerifyFunction(benchmark::State &State) {
+  LLVMContext Ctx;
+  Module M("benchmark", Ctx);
+  Function *F = buildFunction(M, State.range(0));
+  for (auto _ : State)
+    benchmark::DoNotOptimize(verifyFunction(*F));
+  State.SetItemsProcessed(State.iterations() * State.range(0));
+}
+BENCHMARK(BM_VerifyFunction)->Range(8, 4096);
+
+static void BM_InstructionTraversal(benchmark::State &State) {
+  LLVMContext Ctx;
+  Module M("benchmark", Ctx);
+  Function *F = buildFunction(M, State.range(0));
+  for (auto _ : State) {
+    unsigned NumEdges = 0;
+    for (BasicBlock &BB : *F)
+      for (Instruction &I : BB)
+        NumEdges += I.getNumOperands() + I.getNumUses();
+    benchmark::DoNotOptimize(NumEdges);
+  }
+  State.SetItemsProcessed(State.iterations() * F->getInstructionCount());
+}
+BENCHMARK(BM_InstructionTraversal)->Range(8, 4096);
+
+BENCHMARK_MAIN();
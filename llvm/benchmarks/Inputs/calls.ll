@@ -0,0 +1,158 @@
+; A small object-oriented-style module: accessors, a constructor, helpers and
+; a driver that calls them through a call graph for the inliner to work on.
+
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+
+%struct.Vec = type { ptr, i64, i64 }
+
+declare ptr @malloc(i64)
+declare ptr @realloc(ptr, i64)
+declare void @free(ptr)
+
+define internal void @vec_init(ptr %v) {
+entry:
+  %data = getelementptr inbounds %struct.Vec, ptr %v, i32 0, i32 0
+  store ptr null, ptr %data
+  %size = getelementptr inbounds %struct.Vec, ptr %v, i32 0, i32 1
+  store i64 0, ptr %size
+  %cap = getelementptr inbounds %struct.Vec, ptr %v, i32 0, i32 2
+  store i64 0, ptr %cap
+  ret void
+}
+
+define internal i64 @vec_size(ptr %v) {
+entry:
+  %size = getelementptr inbounds %struct.Vec, ptr %v, i32 0, i32 1
+  %0 = load i64, ptr %size
+  ret i64 %0
+}
+
+define internal i32 @vec_get(ptr %v, i64 %i) {
+entry:
+  %data = getelementptr inbounds %struct.Vec, ptr %v, i32 0, i32 0
+  %0 = load ptr, ptr %data
+  %gep = getelementptr inbounds i32, ptr %0, i64 %i
+  %1 = load i32, ptr %gep
+  ret i32 %1
+}
+
+define internal void @vec_grow(ptr %v) {
+entry:
+  %cap = getelementptr inbounds %struct.Vec, ptr %v, i32 0, i32 2
+  %0 = load i64, ptr %cap
+  %is.empty = icmp eq i64 %0, 0
+  %doubled = shl i64 %0, 1
+  %new.cap = select i1 %is.empty, i64 8, i64 %doubled
+  %data = getelementptr inbounds %struct.Vec, ptr %v, i32 0, i32 0
+  %1 = load ptr, ptr %data
+  %bytes = shl i64 %new.cap, 2
+  %2 = call ptr @realloc(ptr %1, i64 %bytes)
+  store ptr %2, ptr %data
+  store i64 %new.cap, ptr %cap
+  ret void
+}
+
+define internal void @vec_push(ptr %v, i32 %x) {
+entry:
+  %size.p = getelementptr inbounds %struct.Vec, ptr %v, i32 0, i32 1
+  %size = load i64, ptr %size.p
+  %cap.p = getelementptr inbounds %struct.Vec, ptr %v, i32 0, i32 2
+  %cap = load i64, ptr %cap.p
+  %full = icmp eq i64 %size, %cap
+  br i1 %full, label %grow, label %store
+
+grow:
+  call void @vec_grow(ptr %v)
+  br label %store
+
+store:
+  %data = getelementptr inbounds %struct.Vec, ptr %v, i32 0, i32 0
+  %0 = load ptr, ptr %data
+  %gep = getelementptr inbounds i32, ptr %0, i64 %size
+  store i32 %x, ptr %gep
+  %inc = add i64 %size, 1
+  store i64 %inc, ptr %size.p
+  ret void
+}
+
+define internal void @vec_destroy(ptr %v) {
+entry:
+  %data = getelementptr inbounds %struct.Vec, ptr %v, i32 0, i32 0
+  %0 = load ptr, ptr %data
+  call void @free(ptr %0)
+  ret void
+}
+
+define internal i32 @square(i32 %x) {
+entry:
+  %mul = mul nsw i32 %x, %x
+  ret i32 %mul
+}
+
+define internal i32 @clamp(i32 %x, i32 %lo, i32 %hi) {
+entry:
+  %lt = icmp slt i32 %x, %lo
+  br i1 %lt, label %ret.lo, label %check.hi
+
+check.hi:
+  %gt = icmp sgt i32 %x, %hi
+  br i1 %gt, label %ret.hi, label %ret.x
+
+ret.lo:
+  ret i32 %lo
+
+ret.hi:
+  ret i32 %hi
+
+ret.x:
+  ret i32 %x
+}
+
+define internal i64 @vec_sum_squares(ptr %v) {
+entry:
+  %n = call i64 @vec_size(ptr %v)
+  br label %cond
+
+cond:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %body ]
+  %sum = phi i64 [ 0, %entry ], [ %sum.next, %body ]
+  %more = icmp ult i64 %i, %n
+  br i1 %more, label %body, label %exit
+
+body:
+  %x = call i32 @vec_get(ptr %v, i64 %i)
+  %c = call i32 @clamp(i32 %x, i32 -1000, i32 1000)
+  %sq = call i32 @square(i32 %c)
+  %sq.ext = sext i32 %sq to i64
+  %sum.next = add i64 %sum, %sq.ext
+  %i.next = add i64 %i, 1
+  br label %cond
+
+exit:
+  ret i64 %sum
+}
+
+define i64 @driver(ptr %input, i32 %n) {
+entry:
+  %v = alloca %struct.Vec
+  call void @vec_init(ptr %v)
+  br label %cond
+
+cond:
+  %i = phi i32 [ 0, %entry ], [ %i.next, %body ]
+  %more = icmp slt i32 %i, %n
+  br i1 %more, label %body, label %done
+
+body:
+  %i.ext = sext i32 %i to i64
+  %gep = getelementptr inbounds i32, ptr %input, i64 %i.ext
+  %x = load i32, ptr %gep
+  call void @vec_push(ptr %v, i32 %x)
+  %i.next = add nsw i32 %i, 1
+  br label %cond
+
+done:
+  %r = call i64 @vec_sum_squares(ptr %v)
+  call void @vec_destroy(ptr %v)
+  ret i64 %r
+}
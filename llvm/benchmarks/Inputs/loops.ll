@@ -0,0 +1,175 @@
+; Loop nests in the shape clang emits at -O0: every variable lives in an
+; alloca, so the pipelines promote them before optimizing the loops.
+
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+
+; C[i][j] += A[i][k] * B[k][j] for n x n row-major matrices.
+define void @matmul(ptr %a, ptr %b, ptr %c, i32 %n) {
+entry:
+  %a.addr = alloca ptr
+  %b.addr = alloca ptr
+  %c.addr = alloca ptr
+  %n.addr = alloca i32
+  %i = alloca i32
+  %j = alloca i32
+  %k = alloca i32
+  store ptr %a, ptr %a.addr
+  store ptr %b, ptr %b.addr
+  store ptr %c, ptr %c.addr
+  store i32 %n, ptr %n.addr
+  store i32 0, ptr %i
+  br label %i.cond
+
+i.cond:
+  %0 = load i32, ptr %i
+  %1 = load i32, ptr %n.addr
+  %cmp.i = icmp slt i32 %0, %1
+  br i1 %cmp.i, label %i.body, label %exit
+
+i.body:
+  store i32 0, ptr %j
+  br label %j.cond
+
+j.cond:
+  %2 = load i32, ptr %j
+  %3 = load i32, ptr %n.addr
+  %cmp.j = icmp slt i32 %2, %3
+  br i1 %cmp.j, label %j.body, label %i.inc
+
+j.body:
+  store i32 0, ptr %k
+  br label %k.cond
+
+k.cond:
+  %4 = load i32, ptr %k
+  %5 = load i32, ptr %n.addr
+  %cmp.k = icmp slt i32 %4, %5
+  br i1 %cmp.k, label %k.body, label %j.inc
+
+k.body:
+  %6 = load ptr, ptr %a.addr
+  %7 = load i32, ptr %i
+  %8 = load i32, ptr %n.addr
+  %mul.a = mul nsw i32 %7, %8
+  %9 = load i32, ptr %k
+  %idx.a = add nsw i32 %mul.a, %9
+  %idx.a.ext = sext i32 %idx.a to i64
+  %gep.a = getelementptr inbounds double, ptr %6, i64 %idx.a.ext
+  %10 = load double, ptr %gep.a
+  %11 = load ptr, ptr %b.addr
+  %12 = load i32, ptr %k
+  %13 = load i32, ptr %n.addr
+  %mul.b = mul nsw i32 %12, %13
+  %14 = load i32, ptr %j
+  %idx.b = add nsw i32 %mul.b, %14
+  %idx.b.ext = sext i32 %idx.b to i64
+  %gep.b = getelementptr inbounds double, ptr %11, i64 %idx.b.ext
+  %15 = load double, ptr %gep.b
+  %prod = fmul double %10, %15
+  %16 = load ptr, ptr %c.addr
+  %17 = load i32, ptr %i
+  %18 = load i32, ptr %n.addr
+  %mul.c = mul nsw i32 %17, %18
+  %19 = load i32, ptr %j
+  %idx.c = add nsw i32 %mul.c, %19
+  %idx.c.ext = sext i32 %idx.c to i64
+  %gep.c = getelementptr inbounds double, ptr %16, i64 %idx.c.ext
+  %20 = load double, ptr %gep.c
+  %sum = fadd double %20, %prod
+  store double %sum, ptr %gep.c
+  %21 = load i32, ptr %k
+  %inc.k = add nsw i32 %21, 1
+  store i32 %inc.k, ptr %k
+  br label %k.cond
+
+j.inc:
+  %22 = load i32, ptr %j
+  %inc.j = add nsw i32 %22, 1
+  store i32 %inc.j, ptr %j
+  br label %j.cond
+
+i.inc:
+  %23 = load i32, ptr %i
+  %inc.i = add nsw i32 %23, 1
+  store i32 %inc.i, ptr %i
+  br label %i.cond
+
+exit:
+  ret void
+}
+
+; Sum of the elements of a that are above a threshold, with an early exit on
+; a sentinel value.
+define i64 @sum_above(ptr %a, i64 %n, i32 %threshold) {
+entry:
+  %a.addr = alloca ptr
+  %n.addr = alloca i64
+  %t.addr = alloca i32
+  %sum = alloca i64
+  %i = alloca i64
+  store ptr %a, ptr %a.addr
+  store i64 %n, ptr %n.addr
+  store i32 %threshold, ptr %t.addr
+  store i64 0, ptr %sum
+  store i64 0, ptr %i
+  br label %cond
+
+cond:
+  %0 = load i64, ptr %i
+  %1 = load i64, ptr %n.addr
+  %cmp = icmp ult i64 %0, %1
+  br i1 %cmp, label %body, label %exit
+
+body:
+  %2 = load ptr, ptr %a.addr
+  %3 = load i64, ptr %i
+  %gep = getelementptr inbounds i32, ptr %2, i64 %3
+  %4 = load i32, ptr %gep
+  %sentinel = icmp eq i32 %4, -1
+  br i1 %sentinel, label %exit, label %check
+
+check:
+  %5 = load i32, ptr %t.addr
+  %above = icmp sgt i32 %4, %5
+  br i1 %above, label %add, label %inc
+
+add:
+  %6 = load i64, ptr %sum
+  %ext = sext i32 %4 to i64
+  %7 = add nsw i64 %6, %ext
+  store i64 %7, ptr %sum
+  br label %inc
+
+inc:
+  %8 = load i64, ptr %i
+  %9 = add i64 %8, 1
+  store i64 %9, ptr %i
+  br label %cond
+
+exit:
+  %10 = load i64, ptr %sum
+  ret i64 %10
+}
+
+; dst[i] = src[i] * scale + bias, a loop the vectorizer handles.
+define void @saxpy(ptr noalias %dst, ptr noalias %src, float %scale, float %bias, i32 %n) {
+entry:
+  %cmp0 = icmp sgt i32 %n, 0
+  br i1 %cmp0, label %loop, label %exit
+
+loop:
+  %iv = phi i32 [ 0, %entry ], [ %iv.next, %loop ]
+  %iv.ext = zext i32 %iv to i64
+  %src.gep = getelementptr inbounds float, ptr %src, i64 %iv.ext
+  %x = load float, ptr %src.gep
+  %mul = fmul float %x, %scale
+  %add = fadd float %mul, %bias
+  %dst.gep = getelementptr inbounds float, ptr %dst, i64 %iv.ext
+  store float %add, ptr %dst.gep
+  %iv.next = add nuw nsw i32 %iv, 1
+  %done = icmp eq i32 %iv.next, %n
+  br i1 %done, label %exit, label %loop
+
+exit:
+  ret void
+}
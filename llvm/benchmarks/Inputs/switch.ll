@@ -0,0 +1,121 @@
+; A table-driven state machine, as in lexers and interpreters: a loop around
+; a large switch whose cases update the state through memory and phis.
+
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+
+define i32 @run(ptr %input, i64 %len) {
+entry:
+  %state = alloca i32
+  %count = alloca i32
+  store i32 0, ptr %state
+  store i32 0, ptr %count
+  br label %loop
+
+loop:
+  %pos = phi i64 [ 0, %entry ], [ %pos.next, %latch ]
+  %at.end = icmp uge i64 %pos, %len
+  br i1 %at.end, label %exit, label %dispatch
+
+dispatch:
+  %gep = getelementptr inbounds i8, ptr %input, i64 %pos
+  %c = load i8, ptr %gep
+  %cur = load i32, ptr %state
+  switch i8 %c, label %other [
+    i8 32, label %space
+    i8 9, label %space
+    i8 10, label %newline
+    i8 40, label %open
+    i8 41, label %close
+    i8 43, label %op
+    i8 45, label %op
+    i8 42, label %op
+    i8 47, label %op
+    i8 48, label %digit
+    i8 49, label %digit
+    i8 50, label %digit
+    i8 51, label %digit
+    i8 52, label %digit
+    i8 53, label %digit
+    i8 54, label %digit
+    i8 55, label %digit
+    i8 56, label %digit
+    i8 57, label %digit
+    i8 34, label %quote
+  ]
+
+space:
+  %in.word = icmp eq i32 %cur, 1
+  br i1 %in.word, label %end.word, label %latch.state0
+
+end.word:
+  %n0 = load i32, ptr %count
+  %n0.inc = add nsw i32 %n0, 1
+  store i32 %n0.inc, ptr %count
+  br label %latch.state0
+
+newline:
+  %n1 = load i32, ptr %count
+  %n1.inc = add nsw i32 %n1, 2
+  store i32 %n1.inc, ptr %count
+  br label %latch.state0
+
+open:
+  %depth.open = add nsw i32 %cur, 16
+  store i32 %depth.open, ptr %state
+  br label %latch
+
+close:
+  %depth.close = sub nsw i32 %cur, 16
+  %underflow = icmp slt i32 %depth.close, 0
+  br i1 %underflow, label %error, label %close.ok
+
+close.ok:
+  store i32 %depth.close, ptr %state
+  br label %latch
+
+op:
+  %op.ext = zext i8 %c to i32
+  %n2 = load i32, ptr %count
+  %n2.mix = xor i32 %n2, %op.ext
+  store i32 %n2.mix, ptr %count
+  br label %latch.state0
+
+digit:
+  %digit.val = sub i8 %c, 48
+  %digit.ext = zext i8 %digit.val to i32
+  %n3 = load i32, ptr %count
+  %n3.mul = mul nsw i32 %n3, 10
+  %n3.add = add nsw i32 %n3.mul, %digit.ext
+  store i32 %n3.add, ptr %count
+  store i32 2, ptr %state
+  br label %latch
+
+quote:
+  %in.string = icmp eq i32 %cur, 3
+  %new.state = select i1 %in.string, i32 0, i32 3
+  store i32 %new.state, ptr %state
+  br label %latch
+
+other:
+  %is.letter = icmp ugt i8 %c, 64
+  br i1 %is.letter, label %letter, label %error
+
+letter:
+  store i32 1, ptr %state
+  br label %latch
+
+latch.state0:
+  store i32 0, ptr %state
+  br label %latch
+
+latch:
+  %pos.next = add nuw i64 %pos, 1
+  br label %loop
+
+error:
+  ret i32 -1
+
+exit:
+  %result = load i32, ptr %count
+  ret i32 %result
+}
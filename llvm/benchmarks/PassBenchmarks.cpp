@@ -0,0 +1,136 @@
+//===- PassBenchmarks.cpp - Compile time of passes on a corpus of IR ------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Measures the time that pass pipelines take on .ll files. Every pipeline is
+// run on every file, on a fresh copy of the module, so each benchmark reports
+// the compile time of one pipeline on one input:
+//
+//   PassBenchmarks [benchmark options] [file.ll...]
+//
+// Without files, the corpus in llvm/benchmarks/Inputs is used.
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IRReader/IRReader.h"
+#include "llvm/Passes/PassBuilder.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Transforms/Utils/Cloning.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace llvm;
+
+/// The pipelines measured on every input, from single passes to the default
+/// optimization pipelines.
+static const char *const Pipelines[] = {
+    "sroa",
+    "early-cse<memssa>",
+    "instcombine",
+    "simplifycfg",
+    "gvn",
+    "function(loop-mssa(licm))",
+    "cgscc(inline)",
+    "default<O1>",
+    "default<O2>",
+    "default<O3>",
+};
+
+namespace {
+
+/// A pass pipeline parsed and ready to run on its own copy of a module.
+struct PipelineRun {
+  // The module outlives the analysis managers, which refer to it.
+  std::unique_ptr<Module> M;
+  LoopAnalysisManager LAM;
+  FunctionAnalysisManager FAM;
+  CGSCCAnalysisManager CGAM;
+  ModuleAnalysisManager MAM;
+  ModulePassManager MPM;
+
+  Error init(const Module &Source, StringRef Pipeline) {
+    M = CloneModule(Source);
+    PassBuilder PB;
+    PB.registerModuleAnalyses(MAM);
+    PB.registerCGSCCAnalyses(CGAM);
+    PB.registerFunctionAnalyses(FAM);
+    PB.registerLoopAnalyses(LAM);
+    PB.crossRegisterProxies(LAM, FAM, CGAM, MAM);
+    return PB.parsePassPipeline(MPM, Pipeline);
+  }
+};
+
+} // end anonymous namespace
+
+static void runPipeline(benchmark::State &State, const Module *Source,
+                        StringRef Pipeline) {
+  for (auto _ : State) {
+    // Only the pipeline itself is measured, not copying the module, building
+    // the pipeline or tearing them down.
+    State.PauseTiming();
+    auto Run = std::make_unique<PipelineRun>();
+    if (Error Err = Run->init(*Source, Pipeline)) {
+      State.SkipWithError(toString(std::move(Err)).c_str());
+      break;
+    }
+    State.ResumeTiming();
+
+    Run->MPM.run(*Run->M, Run->MAM);
+
+    State.PauseTiming();
+    Run.reset();
+    State.ResumeTiming();
+  }
+}
+
+static void collectCorpus(std::vector<std::string> &Files) {
+  std::error_code EC;
+  for (sys::fs::directory_iterator I(LLVM_BENCHMARK_INPUTS_DIR, EC), E;
+       I != E && !EC; I.increment(EC))
+    if (sys::path::extension(I->path()) == ".ll")
+      Files.push_back(I->path());
+  llvm::sort(Files);
+}
+
+int main(int argc, char **argv) {
+  benchmark::Initialize(&argc, argv);
+
+  // The arguments left after the benchmark options are the inputs.
+  std::vector<std::string> Files(argv + 1, argv + argc);
+  if (Files.empty())
+    collectCorpus(Files);
+
+  LLVMContext Ctx;
+  std::vector<std::unique_ptr<Module>> Modules;
+  for (const std::string &File : Files) {
+    SMDiagnostic Err;
+    std::unique_ptr<Module> M = parseIRFile(File, Err, Ctx);
+    if (!M) {
+      Err.print(argv[0], errs());
+      return 1;
+    }
+    for (const char *Pipeline : Pipelines)
+      benchmark::RegisterBenchmark(
+          (Twine(Pipeline) + "/" + sys::path::stem(File)).str().c_str(),
+          runPipeline, M.get(), StringRef(Pipeline))
+          ->Unit(benchmark::kMicrosecond);
+    Modules.push_back(std::move(M));
+  }
+
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
@@ -0,0 +1,709 @@
+//===- llvm/ADT/SwissDenseMap.h - Group-probed hash table -------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file defines the SwissDenseMap class, an open-addressing hash table
+/// with the interface of DenseMap whose probes look at groups of one-byte
+/// control words instead of at the buckets themselves.
+///
+/// Every bucket has a control byte, which is either empty, deleted, or holds
+/// 7 bits of the hash of the bucket's key. The buckets are split into groups
+/// of 16 (SSE2) or 8 (NEON and the portable fallback) consecutive buckets. A
+/// lookup compares the control bytes of a whole group with the hash bits of
+/// the key in a few instructions, and only compares the keys of the buckets
+/// whose control bytes match. Probing moves from group to group until a group
+/// with an empty bucket is found.
+///
+/// Unlike DenseMap, the keys don't need empty and tombstone values: the key
+/// info only has to provide getHashValue() and isEqual().
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_ADT_SWISSDENSEMAP_H
+#define LLVM_ADT_SWISSDENSEMAP_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseMapInfo.h"
+#include "llvm/ADT/EpochTracker.h"
+#include "llvm/ADT/bit.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/MemAlloc.h"
+#include "llvm/Support/type_traits.h"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LLVM_SWISSDENSEMAP_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__) && !defined(__ARM_BIG_ENDIAN)
+#define LLVM_SWISSDENSEMAP_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace llvm {
+
+namespace detail {
+namespace swiss {
+
+/// The control bytes of the buckets that don't hold an entry. The control
+/// byte of a bucket with an entry is non-negative.
+enum : int8_t { CtrlEmpty = -128, CtrlDeleted = -2 };
+
+/// A set of buckets of a group, where each bucket is represented by a bit at
+/// a multiple of 1 << Shift. Iterating over it gives the indices of the
+/// buckets in the group, in increasing order.
+template <typename T, unsigned Shift> class GroupMask {
+  T Mask;
+
+public:
+  explicit GroupMask(T Mask) : Mask(Mask) {}
+
+  explicit operator bool() const { return Mask != 0; }
+  unsigned lowest() const { return llvm::countr_zero(Mask) >> Shift; }
+
+  unsigned operator*() const { return lowest(); }
+  GroupMask &operator++() {
+    Mask &= Mask - 1;
+    return *this;
+  }
+  GroupMask begin() const { return *this; }
+  GroupMask end() const { return GroupMask(0); }
+  bool operator!=(const GroupMask &Other) const { return Mask != Other.Mask; }
+};
+
+/// The control bytes of a group of buckets, loaded at once.
+struct Group {
+#if defined(LLVM_SWISSDENSEMAP_SSE2)
+  static constexpr unsigned Width = 16;
+  using MaskT = GroupMask<uint32_t, 0>;
+
+  explicit Group(const int8_t *Pos)
+      : Ctrl(_mm_load_si128(reinterpret_cast<const __m128i *>(Pos))) {}
+
+  MaskT match(int8_t H2) const {
+    return MaskT(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(H2), Ctrl)));
+  }
+  MaskT matchEmpty() const { return match(CtrlEmpty); }
+  MaskT matchEmptyOrDeleted() const { return MaskT(_mm_movemask_epi8(Ctrl)); }
+
+private:
+  __m128i Ctrl;
+#elif defined(LLVM_SWISSDENSEMAP_NEON)
+  static constexpr unsigned Width = 8;
+  using MaskT = GroupMask<uint64_t, 3>;
+
+  explicit Group(const int8_t *Pos) : Ctrl(vld1_s8(Pos)) {}
+
+  MaskT match(int8_t H2) const {
+    return toMask(vceq_s8(vdup_n_s8(H2), Ctrl));
+  }
+  MaskT matchEmpty() const { return match(CtrlEmpty); }
+  MaskT matchEmptyOrDeleted() const {
+    return toMask(vclt_s8(Ctrl, vdup_n_s8(0)));
+  }
+
+private:
+  static MaskT toMask(uint8x8_t Bytes) {
+    return MaskT(vget_lane_u64(vreinterpret_u64_u8(Bytes), 0) &
+                 0x8080808080808080ULL);
+  }
+
+  int8x8_t Ctrl;
+#else
+  static constexpr unsigned Width = 8;
+  using MaskT = GroupMask<uint64_t, 3>;
+
+  explicit Group(const int8_t *Pos)
+      : Ctrl(support::endian::read64le(Pos)) {}
+
+  MaskT match(int8_t H2) const {
+    // The bytes equal to H2 become zero. The zero byte test may also report
+    // the full bucket after a match, which the key comparison rejects.
+    uint64_t X = Ctrl ^ (LSBs * static_cast<uint8_t>(H2));
+    return MaskT((X - LSBs) & ~X & MSBs);
+  }
+  MaskT matchEmpty() const {
+    // Of the control bytes with their top bit set, only CtrlEmpty has bit 1
+    // clear.
+    return MaskT(Ctrl & ~(Ctrl << 6) & MSBs);
+  }
+  MaskT matchEmptyOrDeleted() const { return MaskT(Ctrl & MSBs); }
+
+private:
+  static constexpr uint64_t LSBs = 0x0101010101010101ULL;
+  static constexpr uint64_t MSBs = 0x8080808080808080ULL;
+
+  uint64_t Ctrl;
+#endif
+};
+
+/// Returns the 7 bits of \p Hash stored in the control byte of its bucket.
+///
+/// The group of a key is selected by the low bits of its hash, like the bucket
+/// of a DenseMap key, which keeps the locality of the DenseMapInfo hashes of
+/// nearby pointers. These 7 bits are taken from all bits of the hash with a
+/// multiplicative hash instead, so that keys sharing a group have different
+/// control bytes.
+inline int8_t getH2(unsigned Hash) {
+  return (static_cast<uint64_t>(Hash) * 0x9E3779B97F4A7C15ULL) >> 57;
+}
+
+} // end namespace swiss
+} // end namespace detail
+
+template <typename KeyT, typename ValueT,
+          typename KeyInfoT = DenseMapInfo<KeyT>>
+class SwissDenseMap : public DebugEpochBase {
+  template <typename T>
+  using const_arg_type_t = typename const_pointer_or_const_ref<T>::type;
+
+  using Group = detail::swiss::Group;
+  using BucketT = detail::DenseMapPair<KeyT, ValueT>;
+
+  template <bool IsConst> class Iterator;
+
+public:
+  using size_type = unsigned;
+  using key_type = KeyT;
+  using mapped_type = ValueT;
+  using value_type = BucketT;
+
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  explicit SwissDenseMap(unsigned InitialReserve = 0) {
+    reserve(InitialReserve);
+  }
+
+  SwissDenseMap(const SwissDenseMap &Other) : DebugEpochBase() {
+    copyFrom(Other);
+  }
+
+  SwissDenseMap(SwissDenseMap &&Other) : DebugEpochBase() { swap(Other); }
+
+  template <typename InputIt> SwissDenseMap(const InputIt &I, const InputIt &E) {
+    reserve(std::distance(I, E));
+    insert(I, E);
+  }
+
+  SwissDenseMap(std::initializer_list<value_type> Vals) {
+    reserve(Vals.size());
+    insert(Vals.begin(), Vals.end());
+  }
+
+  ~SwissDenseMap() {
+    destroyAll();
+    deallocateBuckets();
+  }
+
+  SwissDenseMap &operator=(const SwissDenseMap &Other) {
+    if (&Other != this) {
+      destroyAll();
+      deallocateBuckets();
+      copyFrom(Other);
+    }
+    return *this;
+  }
+
+  SwissDenseMap &operator=(SwissDenseMap &&Other) {
+    destroyAll();
+    deallocateBuckets();
+    Ctrl = nullptr;
+    Buckets = nullptr;
+    NumBuckets = NumEntries = NumDeleted = 0;
+    swap(Other);
+    return *this;
+  }
+
+  void swap(SwissDenseMap &RHS) {
+    incrementEpoch();
+    RHS.incrementEpoch();
+    std::swap(Ctrl, RHS.Ctrl);
+    std::swap(Buckets, RHS.Buckets);
+    std::swap(NumBuckets, RHS.NumBuckets);
+    std::swap(NumEntries, RHS.NumEntries);
+    std::swap(NumDeleted, RHS.NumDeleted);
+  }
+
+  iterator begin() { return makeIterator(0); }
+  iterator end() { return makeIterator(NumBuckets); }
+  const_iterator begin() const { return makeConstIterator(0); }
+  const_iterator end() const { return makeConstIterator(NumBuckets); }
+
+  [[nodiscard]] bool empty() const { return NumEntries == 0; }
+  unsigned size() const { return NumEntries; }
+
+  /// Grow the map so that it can contain at least \p NumEntries items before
+  /// resizing again.
+  void reserve(size_type NumEntries) {
+    incrementEpoch();
+    unsigned NewNumBuckets = getMinBucketsToReserveForEntries(NumEntries);
+    if (NewNumBuckets > NumBuckets)
+      rehash(NewNumBuckets);
+  }
+
+  void clear() {
+    incrementEpoch();
+    if (NumEntries == 0 && NumDeleted == 0)
+      return;
+
+    // If the capacity of the table is huge, and the # elements used is small,
+    // shrink the table.
+    unsigned OldNumEntries = NumEntries;
+    destroyAll();
+    if (OldNumEntries * 4 < NumBuckets && NumBuckets > 64) {
+      deallocateBuckets();
+      allocateBuckets(std::max<unsigned>(
+          64, 1 << (Log2_32_Ceil(std::max(OldNumEntries, 1u)) + 1)));
+      return;
+    }
+    std::memset(Ctrl, detail::swiss::CtrlEmpty, NumBuckets);
+    NumEntries = NumDeleted = 0;
+  }
+
+  /// Return true if the specified key is in the map, false otherwise.
+  bool contains(const_arg_type_t<KeyT> Val) const {
+    return findBucket(Val) != NumBuckets;
+  }
+
+  /// Return 1 if the specified key is in the map, 0 otherwise.
+  size_type count(const_arg_type_t<KeyT> Val) const {
+    return contains(Val) ? 1 : 0;
+  }
+
+  iterator find(const_arg_type_t<KeyT> Val) {
+    return makeIterator(findBucket(Val), /*NoAdvance=*/true);
+  }
+  const_iterator find(const_arg_type_t<KeyT> Val) const {
+    return makeConstIterator(findBucket(Val), /*NoAdvance=*/true);
+  }
+
+  /// Alternate version of find() which allows a different, and possibly
+  /// less expensive, key type.
+  /// The DenseMapInfo is responsible for supplying methods
+  /// getHashValue(LookupKeyT) and isEqual(LookupKeyT, KeyT) for each key
+  /// type used.
+  template <class LookupKeyT> iterator find_as(const LookupKeyT &Val) {
+    return makeIterator(findBucket(Val), /*NoAdvance=*/true);
+  }
+  template <class LookupKeyT>
+  const_iterator find_as(const LookupKeyT &Val) const {
+    return makeConstIterator(findBucket(Val), /*NoAdvance=*/true);
+  }
+
+  /// lookup - Return the entry for the specified key, or a default
+  /// constructed value if no such entry exists.
+  ValueT lookup(const_arg_type_t<KeyT> Val) const {
+    unsigned Bucket = findBucket(Val);
+    if (Bucket != NumBuckets)
+      return Buckets[Bucket].getSecond();
+    return ValueT();
+  }
+
+  // Inserts key,value pair into the map if the key isn't already in the map.
+  // If the key is already in the map, it returns false and doesn't update the
+  // value.
+  std::pair<iterator, bool> insert(const std::pair<KeyT, ValueT> &KV) {
+    return try_emplace(KV.first, KV.second);
+  }
+
+  // Inserts key,value pair into the map if the key isn't already in the map.
+  // If the key is already in the map, it returns false and doesn't update the
+  // value.
+  std::pair<iterator, bool> insert(std::pair<KeyT, ValueT> &&KV) {
+    return try_emplace(std::move(KV.first), std::move(KV.second));
+  }
+
+  /// insert - Range insertion of pairs.
+  template <typename InputIt> void insert(InputIt I, InputIt E) {
+    for (; I != E; ++I)
+      insert(*I);
+  }
+
+  // Inserts key,value pair into the map if the key isn't already in the map.
+  // The value is constructed in-place if the key is not in the map, otherwise
+  // it is not moved.
+  template <typename... Ts>
+  std::pair<iterator, bool> try_emplace(KeyT &&Key, Ts &&...Args) {
+    return tryEmplaceImpl(std::move(Key), std::forward<Ts>(Args)...);
+  }
+
+  // Inserts key,value pair into the map if the key isn't already in the map.
+  // The value is constructed in-place if the key is not in the map, otherwise
+  // it is not moved.
+  template <typename... Ts>
+  std::pair<iterator, bool> try_emplace(const KeyT &Key, Ts &&...Args) {
+    return tryEmplaceImpl(Key, std::forward<Ts>(Args)...);
+  }
+
+  template <typename V>
+  std::pair<iterator, bool> insert_or_assign(const KeyT &Key, V &&Val) {
+    auto Ret = try_emplace(Key, std::forward<V>(Val));
+    if (!Ret.second)
+      Ret.first->second = std::forward<V>(Val);
+    return Ret;
+  }
+
+  template <typename V>
+  std::pair<iterator, bool> insert_or_assign(KeyT &&Key, V &&Val) {
+    auto Ret = try_emplace(std::move(Key), std::forward<V>(Val));
+    if (!Ret.second)
+      Ret.first->second = std::forward<V>(Val);
+    return Ret;
+  }
+
+  bool erase(const KeyT &Val) {
+    unsigned Bucket = findBucket(Val);
+    if (Bucket == NumBuckets)
+      return false; // not in map.
+    eraseBucket(Bucket);
+    return true;
+  }
+  void erase(iterator I) { eraseBucket(&*I - Buckets); }
+
+  value_type &FindAndConstruct(const KeyT &Key) {
+    return *try_emplace(Key).first;
+  }
+
+  ValueT &operator[](const KeyT &Key) { return FindAndConstruct(Key).second; }
+
+  value_type &FindAndConstruct(KeyT &&Key) {
+    return *try_emplace(std::move(Key)).first;
+  }
+
+  ValueT &operator[](KeyT &&Key) {
+    return FindAndConstruct(std::move(Key)).second;
+  }
+
+  /// Return the approximate size (in bytes) of the actual map.
+  /// This is just the raw memory used by the map, it doesn't include memory
+  /// owned by keys or values.
+  size_t getMemorySize() const { return NumBuckets ? getAllocSize(NumBuckets) : 0; }
+
+private:
+  template <bool IsConst> class Iterator : DebugEpochBase::HandleBase {
+    friend class SwissDenseMap;
+    friend class Iterator<!IsConst>;
+
+  public:
+    using difference_type = ptrdiff_t;
+    using value_type = std::conditional_t<IsConst, const BucketT, BucketT>;
+    using pointer = value_type *;
+    using reference = value_type &;
+    using iterator_category = std::forward_iterator_tag;
+
+  private:
+    const int8_t *Ctrl = nullptr;
+    pointer Ptr = nullptr;
+    pointer End = nullptr;
+
+  public:
+    Iterator() = default;
+
+    Iterator(const int8_t *Ctrl, pointer Pos, pointer E,
+             const DebugEpochBase &Epoch, bool NoAdvance)
+        : DebugEpochBase::HandleBase(&Epoch), Ctrl(Ctrl), Ptr(Pos), End(E) {
+      assert(isHandleInSync() && "invalid construction!");
+      if (!NoAdvance)
+        advancePastNonFullBuckets();
+    }
+
+    // Converting ctor from non-const iterators to const iterators. SFINAE'd
+    // out for const iterator destinations so it doesn't end up as a user
+    // defined copy constructor.
+    template <bool IsConstSrc,
+              typename = std::enable_if_t<!IsConstSrc && IsConst>>
+    Iterator(const Iterator<IsConstSrc> &I)
+        : DebugEpochBase::HandleBase(I), Ctrl(I.Ctrl), Ptr(I.Ptr),
+          End(I.End) {}
+
+    reference operator*() const {
+      assert(isHandleInSync() && "invalid iterator access!");
+      assert(Ptr != End && "dereferencing end() iterator");
+      return *Ptr;
+    }
+    pointer operator->() const { return &operator*(); }
+
+    friend bool operator==(const Iterator &LHS, const Iterator &RHS) {
+      assert((!LHS.Ptr || LHS.isHandleInSync()) && "handle not in sync!");
+      assert((!RHS.Ptr || RHS.isHandleInSync()) && "handle not in sync!");
+      assert(LHS.getEpochAddress() == RHS.getEpochAddress() &&
+             "comparing incomparable iterators!");
+      return LHS.Ptr == RHS.Ptr;
+    }
+    friend bool operator!=(const Iterator &LHS, const Iterator &RHS) {
+      return !(LHS == RHS);
+    }
+
+    Iterator &operator++() {
+      assert(isHandleInSync() && "invalid iterator access!");
+      assert(Ptr != End && "incrementing end() iterator");
+      ++Ptr;
+      ++Ctrl;
+      advancePastNonFullBuckets();
+      return *this;
+    }
+    Iterator operator++(int) {
+      assert(isHandleInSync() && "invalid iterator access!");
+      Iterator Tmp = *this;
+      ++*this;
+      return Tmp;
+    }
+
+  private:
+    void advancePastNonFullBuckets() {
+      while (Ptr != End && *Ctrl < 0) {
+        ++Ptr;
+        ++Ctrl;
+      }
+    }
+  };
+
+  iterator makeIterator(unsigned Bucket, bool NoAdvance = false) {
+    return iterator(Ctrl + Bucket, Buckets + Bucket, Buckets + NumBuckets,
+                    *this, NoAdvance);
+  }
+  const_iterator makeConstIterator(unsigned Bucket,
+                                   bool NoAdvance = false) const {
+    return const_iterator(Ctrl + Bucket, Buckets + Bucket,
+                          Buckets + NumBuckets, *this, NoAdvance);
+  }
+
+  static int8_t getH2(unsigned Hash) { return detail::swiss::getH2(Hash); }
+
+  template <typename LookupKeyT>
+  static unsigned getHash(const LookupKeyT &Val) {
+    return KeyInfoT::getHashValue(Val);
+  }
+
+  /// The probe sequence of a hash: the groups are visited in a triangular
+  /// sequence, which covers all of them since their number is a power of two.
+  class ProbeSeq {
+    size_t GroupMask;
+    size_t GroupIdx;
+    size_t Step = 0;
+
+  public:
+    ProbeSeq(unsigned Hash, unsigned NumBuckets)
+        : GroupMask(NumBuckets / Group::Width - 1),
+          GroupIdx(Hash & GroupMask) {}
+
+    /// The index of the first bucket of the current group.
+    unsigned getGroupStart() const { return GroupIdx * Group::Width; }
+
+    void next() {
+      ++Step;
+      assert(Step <= GroupMask && "no empty bucket on the probe sequence");
+      GroupIdx = (GroupIdx + Step) & GroupMask;
+    }
+  };
+
+  /// Returns the bucket holding \p Val, or NumBuckets if there is none.
+  template <typename LookupKeyT>
+  unsigned findBucket(const LookupKeyT &Val, unsigned Hash) const {
+    if (NumBuckets == 0)
+      return 0;
+    int8_t H2 = getH2(Hash);
+    for (ProbeSeq Seq(Hash, NumBuckets);; Seq.next()) {
+      unsigned GroupStart = Seq.getGroupStart();
+      Group G(Ctrl + GroupStart);
+      for (unsigned I : G.match(H2))
+        if (KeyInfoT::isEqual(Val, Buckets[GroupStart + I].getFirst()))
+          return GroupStart + I;
+      // A group with an empty bucket ends every probe sequence going through
+      // it.
+      if (G.matchEmpty())
+        return NumBuckets;
+    }
+  }
+  template <typename LookupKeyT>
+  unsigned findBucket(const LookupKeyT &Val) const {
+    return NumBuckets ? findBucket(Val, getHash(Val)) : 0;
+  }
+
+  /// Returns the first empty or deleted bucket on the probe sequence of
+  /// \p Hash.
+  unsigned findInsertBucket(unsigned Hash) const {
+    for (ProbeSeq Seq(Hash, NumBuckets);; Seq.next()) {
+      unsigned GroupStart = Seq.getGroupStart();
+      if (auto Mask = Group(Ctrl + GroupStart).matchEmptyOrDeleted())
+        return GroupStart + Mask.lowest();
+    }
+  }
+
+  template <typename KeyArgT, typename... Ts>
+  std::pair<iterator, bool> tryEmplaceImpl(KeyArgT &&Key, Ts &&...Args) {
+    unsigned Hash = getHash(Key);
+    unsigned Bucket = findBucket(Key, Hash);
+    if (Bucket != NumBuckets)
+      return std::make_pair(makeIterator(Bucket, /*NoAdvance=*/true),
+                            false); // Already in map.
+
+    // Otherwise, insert the new element.
+    Bucket = prepareInsert(Hash);
+    BucketT *TheBucket = &Buckets[Bucket];
+    ::new (&TheBucket->getFirst()) KeyT(std::forward<KeyArgT>(Key));
+    ::new (&TheBucket->getSecond()) ValueT(std::forward<Ts>(Args)...);
+    return std::make_pair(makeIterator(Bucket, /*NoAdvance=*/true), true);
+  }
+
+  /// Claims a bucket for a new entry with \p Hash, growing the table if it
+  /// would otherwise be more than 7/8 full.
+  unsigned prepareInsert(unsigned Hash) {
+    incrementEpoch();
+    unsigned Bucket = NumBuckets ? findInsertBucket(Hash) : 0;
+    // Deleted buckets are reused without affecting the load factor.
+    if (NumBuckets == 0 || (Ctrl[Bucket] == detail::swiss::CtrlEmpty &&
+                            (NumEntries + NumDeleted + 1) * 8 > NumBuckets * 7)) {
+      // If the table is mostly deleted buckets, rehashing at the same size is
+      // enough.
+      if (NumBuckets && (NumEntries + 1) * 16 <= NumBuckets * 7)
+        rehash(NumBuckets);
+      else
+        rehash(std::max<unsigned>(64, NumBuckets * 2));
+      Bucket = findInsertBucket(Hash);
+    }
+    if (Ctrl[Bucket] == detail::swiss::CtrlDeleted)
+      --NumDeleted;
+    Ctrl[Bucket] = getH2(Hash);
+    ++NumEntries;
+    return Bucket;
+  }
+
+  void eraseBucket(unsigned Bucket) {
+    Buckets[Bucket].getSecond().~ValueT();
+    Buckets[Bucket].getFirst().~KeyT();
+    --NumEntries;
+    // No probe sequence continues past a group with an empty bucket, so such
+    // a group doesn't need a deleted marker to keep the later groups
+    // reachable.
+    if (Group(Ctrl + (Bucket & ~(Group::Width - 1))).matchEmpty()) {
+      Ctrl[Bucket] = detail::swiss::CtrlEmpty;
+    } else {
+      Ctrl[Bucket] = detail::swiss::CtrlDeleted;
+      ++NumDeleted;
+    }
+  }
+
+  static unsigned getMinBucketsToReserveForEntries(unsigned NumEntries) {
+    // Ensure that "NumEntries * 8 <= NumBuckets * 7".
+    if (NumEntries == 0)
+      return 0;
+    return std::max<uint64_t>(
+        Group::Width,
+        PowerOf2Ceil(divideCeil(static_cast<uint64_t>(NumEntries) * 8, 7)));
+  }
+
+  /// The control bytes and the buckets share an allocation, the control
+  /// bytes first.
+  static constexpr size_t AllocAlign =
+      std::max<size_t>(Group::Width, alignof(BucketT));
+  static size_t getBucketsOffset(unsigned Num) {
+    return alignTo(Num, alignof(BucketT));
+  }
+  static size_t getAllocSize(unsigned Num) {
+    return getBucketsOffset(Num) + sizeof(BucketT) * Num;
+  }
+
+  void allocateBuckets(unsigned Num) {
+    assert(Num % Group::Width == 0 && isPowerOf2_32(Num));
+    NumBuckets = Num;
+    NumEntries = NumDeleted = 0;
+    Ctrl = static_cast<int8_t *>(allocate_buffer(getAllocSize(Num), AllocAlign));
+    std::memset(Ctrl, detail::swiss::CtrlEmpty, Num);
+    Buckets = reinterpret_cast<BucketT *>(Ctrl + getBucketsOffset(Num));
+  }
+
+  static void deallocateBuckets(int8_t *Ctrl, unsigned Num) {
+    if (Num)
+      deallocate_buffer(Ctrl, getAllocSize(Num), AllocAlign);
+  }
+  void deallocateBuckets() { deallocateBuckets(Ctrl, NumBuckets); }
+
+  void destroyAll() {
+    if (std::is_trivially_destructible<KeyT>::value &&
+        std::is_trivially_destructible<ValueT>::value)
+      return;
+    for (unsigned I = 0; I != NumBuckets; ++I) {
+      if (Ctrl[I] >= 0) {
+        Buckets[I].getSecond().~ValueT();
+        Buckets[I].getFirst().~KeyT();
+      }
+    }
+  }
+
+  void rehash(unsigned Num) {
+    int8_t *OldCtrl = Ctrl;
+    BucketT *OldBuckets = Buckets;
+    unsigned OldNumBuckets = NumBuckets;
+    unsigned OldNumEntries = NumEntries;
+
+    allocateBuckets(Num);
+    for (unsigned I = 0; I != OldNumBuckets; ++I) {
+      if (OldCtrl[I] < 0)
+        continue;
+      BucketT &B = OldBuckets[I];
+      unsigned Hash = getHash(B.getFirst());
+      unsigned Bucket = findInsertBucket(Hash);
+      Ctrl[Bucket] = getH2(Hash);
+      BucketT *DestBucket = &Buckets[Bucket];
+      ::new (&DestBucket->getFirst()) KeyT(std::move(B.getFirst()));
+      ::new (&DestBucket->getSecond()) ValueT(std::move(B.getSecond()));
+      B.getSecond().~ValueT();
+      B.getFirst().~KeyT();
+    }
+    NumEntries = OldNumEntries;
+
+    deallocateBuckets(OldCtrl, OldNumBuckets);
+  }
+
+  void copyFrom(const SwissDenseMap &Other) {
+    Ctrl = nullptr;
+    Buckets = nullptr;
+    NumBuckets = NumEntries = NumDeleted = 0;
+    if (!Other.NumBuckets)
+      return;
+    allocateBuckets(Other.NumBuckets);
+    std::memcpy(Ctrl, Other.Ctrl, NumBuckets);
+    for (unsigned I = 0; I != NumBuckets; ++I) {
+      if (Ctrl[I] < 0)
+        continue;
+      ::new (&Buckets[I].getFirst()) KeyT(Other.Buckets[I].getFirst());
+      ::new (&Buckets[I].getSecond()) ValueT(Other.Buckets[I].getSecond());
+    }
+    NumEntries = Other.NumEntries;
+    NumDeleted = Other.NumDeleted;
+  }
+
+  /// The control bytes of the buckets, aligned to a group.
+  int8_t *Ctrl = nullptr;
+  BucketT *Buckets = nullptr;
+  unsigned NumBuckets = 0;
+  unsigned NumEntries = 0;
+  unsigned NumDeleted = 0;
+};
+
+template <typename KeyT, typename ValueT, typename KeyInfoT>
+inline size_t
+capacity_in_bytes(const SwissDenseMap<KeyT, ValueT, KeyInfoT> &X) {
+  return X.getMemorySize();
+}
+
+} // end namespace llvm
+
+#endif // LLVM_ADT_SWISSDENSEMAP_H
@@ -0,0 +1,139 @@
+//===- AACache.h - Cache of alias analysis queries --------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines the AACache class, which memoizes the results of alias and
+// mod/ref queries on a function across the passes that preserve it, and the
+// analysis that provides it to the new pass manager.
+//
+// The cache is queried through a BatchAAResults constructed with it. Entries
+// are dropped automatically when a value they were computed from is deleted or
+// replaced, along with the entries of the values derived from it and of the
+// underlying object of the replacement, whose capture status may change. If an
+// instruction is modified in place, the client has to notify the cache by
+// calling invalidateValue, or clear if the modification could affect values
+// that do not use the instruction, such as through assumptions.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_ANALYSIS_AACACHE_H
+#define LLVM_ANALYSIS_AACACHE_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Analysis/AliasAnalysis.h"
+#include "llvm/Analysis/MemoryLocation.h"
+#include "llvm/IR/PassManager.h"
+#include "llvm/IR/ValueHandle.h"
+#include <optional>
+
+namespace llvm {
+
+class Function;
+class Instruction;
+class Value;
+
+/// Class for caching the alias and mod/ref results of the queries on a
+/// function.
+///
+/// Only the queries of a BatchAAResults that has no context-sensitive capture
+/// information are cached, so a cached result is the same as the one that the
+/// AA pipeline would compute for the unchanged IR.
+class AACache {
+public:
+  AACache() = default;
+
+  /// Return the alias result of \p LocA and \p LocB, computing it with \p AA
+  /// if it is not cached.
+  AliasResult alias(AAResults &AA, AAQueryInfo &AAQI,
+                    const MemoryLocation &LocA, const MemoryLocation &LocB);
+
+  /// Return the mod/ref result of \p I for \p OptLoc, computing it with \p AA
+  /// if it is not cached.
+  ModRefInfo getModRefInfo(AAResults &AA, AAQueryInfo &AAQI,
+                           const Instruction *I,
+                           const std::optional<MemoryLocation> &OptLoc);
+
+  /// Notify the cache that \p V was modified in place.
+  ///
+  /// This drops the entries of \p V and of the values derived from it. If \p V
+  /// is an instruction, this also drops the entries of the underlying objects
+  /// of its operands, as it may have become a new user that captures them.
+  void invalidateValue(const Value *V);
+
+  /// Drop all the cached entries.
+  void clear();
+
+  /// Handle invalidation events in the new pass manager.
+  bool invalidate(Function &F, const PreservedAnalyses &PA,
+                  FunctionAnalysisManager::Invalidator &Inv);
+
+private:
+  using LocPair = std::pair<MemoryLocation, MemoryLocation>;
+  using ModRefKey = std::pair<const Instruction *, MemoryLocation>;
+
+  /// Start tracking \p V and the values it is computed from, so that the
+  /// entries computed from them are dropped when they are deleted or replaced.
+  void trackValue(const Value *V);
+
+  /// Record that the alias entry \p Key was computed from \p V.
+  void addAliasEntry(const Value *V, const LocPair &Key);
+
+  /// Drop the entries of \p V and of the values derived from it.
+  void forgetValue(const Value *V);
+
+  /// Drop the entries of the underlying object of \p V, if its capture status
+  /// is used by alias analysis.
+  void forgetUnderlyingObject(const Value *V);
+
+  /// Drop the entries of \p V alone.
+  void forgetEntries(const Value *V);
+
+  /// The cached alias results, with the locations ordered by pointer.
+  DenseMap<LocPair, AliasResult> AliasResults;
+
+  /// The cached mod/ref results. A query without a location is keyed by a
+  /// location with a null pointer.
+  DenseMap<ModRefKey, ModRefInfo> ModRefResults;
+
+  /// The keys of the entries that were computed from each value.
+  DenseMap<const Value *, SmallVector<LocPair, 2>> AliasEntries;
+  DenseMap<const Value *, SmallVector<ModRefKey, 2>> ModRefEntries;
+
+  /// A CallbackVH to notify the AACache when a value is deleted or replaced,
+  /// so that the entries derived from it are dropped.
+  class AACacheCallbackVH final : public CallbackVH {
+    AACache *Cache;
+    void deleted() override;
+    void allUsesReplacedWith(Value *New) override;
+
+  public:
+    AACacheCallbackVH(Value *V, AACache *Cache = nullptr)
+        : CallbackVH(V), Cache(Cache) {}
+  };
+
+  /// A set of callbacks to the values that the entries were computed from.
+  DenseSet<AACacheCallbackVH, DenseMapInfo<Value *>> TrackedValues;
+};
+
+/// The analysis pass which yields an AACache.
+///
+/// The analysis does nothing by itself, and just returns an empty cache which
+/// gets filled in as it is queried.
+class AACacheAnalysis : public AnalysisInfoMixin<AACacheAnalysis> {
+  friend AnalysisInfoMixin<AACacheAnalysis>;
+  static AnalysisKey Key;
+
+public:
+  using Result = AACache;
+  AACache run(Function &F, FunctionAnalysisManager &AM);
+};
+
+} // namespace llvm
+
+#endif // LLVM_ANALYSIS_AACACHE_H
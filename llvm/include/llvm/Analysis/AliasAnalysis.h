@@ -52,6 +52,7 @@
 
 namespace llvm {
 
+class AACache;
 class AnalysisUsage;
 class AtomicCmpXchgInst;
 class BasicAAResult;
@@ -609,16 +610,29 @@ private:
 /// esentially making AA work in "batch mode". The internal state cannot be
 /// cleared, so to go "out-of-batch-mode", the user must either use AAResults,
 /// or create a new BatchAAResults.
+///
+/// A BatchAAResults without a custom CaptureInfo can also be given an AACache,
+/// which keeps the alias and mod/ref results across batches and passes.
 class BatchAAResults {
   AAResults &AA;
   AAQueryInfo AAQI;
   SimpleCaptureInfo SimpleCI;
+  AACache *Cache = nullptr;
+
+  AliasResult cachedAlias(const MemoryLocation &LocA,
+                          const MemoryLocation &LocB);
+  ModRefInfo cachedModRefInfo(const Instruction *I,
+                              const std::optional<MemoryLocation> &OptLoc);
 
 public:
   BatchAAResults(AAResults &AAR) : AA(AAR), AAQI(AAR, &SimpleCI) {}
   BatchAAResults(AAResults &AAR, CaptureInfo *CI) : AA(AAR), AAQI(AAR, CI) {}
+  BatchAAResults(AAResults &AAR, AACache *Cache)
+      : AA(AAR), AAQI(AAR, &SimpleCI), Cache(Cache) {}
 
   AliasResult alias(const MemoryLocation &LocA, const MemoryLocation &LocB) {
+    if (Cache)
+      return cachedAlias(LocA, LocB);
     return AA.alias(LocA, LocB, AAQI);
   }
   bool pointsToConstantMemory(const MemoryLocation &Loc, bool OrLocal = false) {
@@ -630,6 +644,8 @@ public:
   }
   ModRefInfo getModRefInfo(const Instruction *I,
                            const std::optional<MemoryLocation> &OptLoc) {
+    if (Cache)
+      return cachedModRefInfo(I, OptLoc);
     return AA.getModRefInfo(I, OptLoc, AAQI);
   }
   ModRefInfo getModRefInfo(const Instruction *I, const CallBase *Call2) {
@@ -658,6 +674,8 @@ public:
   /// Assume that values may come from different cycle iterations.
   void enableCrossIterationMode() {
     AAQI.MayBeCrossIteration = true;
+    // The results in this mode differ from the ones that are cached.
+    Cache = nullptr;
   }
 };
 
@@ -0,0 +1,139 @@
+//===- KnownBitsCache.h - Cache of known bits queries -----------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines the KnownBitsCache class, which memoizes the results of
+// computeKnownBits and ComputeNumSignBits queries on the instructions of a
+// function, and the analysis that provides it to the new pass manager.
+//
+// Entries are dropped automatically when a value is deleted or replaced, along
+// with the entries of the values that could have been computed from it. If an
+// instruction is modified in place, the client has to notify the cache by
+// calling invalidateValue, or clear if the modification could affect values
+// that do not use the instruction, such as through assumptions.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_ANALYSIS_KNOWNBITSCACHE_H
+#define LLVM_ANALYSIS_KNOWNBITSCACHE_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/IR/PassManager.h"
+#include "llvm/IR/ValueHandle.h"
+#include "llvm/Support/KnownBits.h"
+#include <optional>
+
+namespace llvm {
+
+class AssumptionCache;
+class DataLayout;
+class DominatorTree;
+class Function;
+class Instruction;
+class Value;
+
+/// Class for caching the known bits and the number of sign bits of the
+/// instructions in a function.
+///
+/// Only queries of a whole value at depth zero are cached, so a cached result
+/// is the same as the one that ValueTracking would compute. Results are
+/// cached per context instruction, as assumptions make them depend on it.
+class KnownBitsCache {
+public:
+  KnownBitsCache(const DataLayout &DL, AssumptionCache *AC = nullptr,
+                 const DominatorTree *DT = nullptr)
+      : DL(DL), AC(AC), DT(DT) {}
+
+  /// Return the known bits of \p V in the context of \p CxtI, computing them
+  /// if they are not cached.
+  KnownBits computeKnownBits(const Value *V, const Instruction *CxtI = nullptr);
+
+  /// Return the number of sign bits of \p V in the context of \p CxtI,
+  /// computing it if it is not cached.
+  unsigned ComputeNumSignBits(const Value *V,
+                              const Instruction *CxtI = nullptr);
+
+  /// Notify the cache that the information computed from \p V is no longer
+  /// valid.
+  ///
+  /// This drops the entries of \p V, of the entries using \p V as their
+  /// context instruction, and of the users of \p V up to
+  /// MaxAnalysisRecursionDepth levels, whose results may have been computed
+  /// from those of \p V.
+  void invalidateValue(const Value *V);
+
+  /// Drop all the cached entries.
+  void clear();
+
+  /// Handle invalidation events in the new pass manager.
+  bool invalidate(Function &, const PreservedAnalyses &,
+                  FunctionAnalysisManager::Invalidator &);
+
+private:
+  struct Entry {
+    const Instruction *CxtI;
+    std::optional<KnownBits> Known;
+    std::optional<unsigned> NumSignBits;
+  };
+
+  /// Return the entry of \p V in the context of \p CxtI, creating an empty
+  /// one if needed.
+  Entry &getEntry(const Instruction *V, const Instruction *CxtI);
+
+  /// Drop the entries of \p V and of the entries using \p V as their context.
+  void forgetValue(const Value *V);
+
+  /// Start tracking \p V, so that its entries are dropped when it is deleted
+  /// or replaced.
+  void trackValue(const Value *V);
+
+  const DataLayout &DL;
+  AssumptionCache *AC;
+  const DominatorTree *DT;
+
+  /// The cached entries of each instruction, one per context instruction.
+  DenseMap<const Value *, SmallVector<Entry, 1>> Entries;
+
+  /// The instructions that have an entry in the context of each instruction.
+  DenseMap<const Value *, SmallVector<const Value *, 1>> ContextUsers;
+
+  /// A CallbackVH to notify the KnownBitsCache when a value is deleted or
+  /// replaced, so that the entries derived from it are dropped.
+  class KnownBitsCacheCallbackVH final : public CallbackVH {
+    KnownBitsCache *KBC;
+    void deleted() override;
+    void allUsesReplacedWith(Value *New) override;
+
+  public:
+    KnownBitsCacheCallbackVH(Value *V, KnownBitsCache *KBC = nullptr)
+        : CallbackVH(V), KBC(KBC) {}
+  };
+
+  /// A set of callbacks to the values that have entries or are the context of
+  /// entries.
+  DenseSet<KnownBitsCacheCallbackVH, DenseMapInfo<Value *>> TrackedValues;
+};
+
+/// The analysis pass which yields a KnownBitsCache.
+///
+/// The analysis does nothing by itself, and just returns an empty cache which
+/// gets filled in as it is queried.
+class KnownBitsCacheAnalysis
+    : public AnalysisInfoMixin<KnownBitsCacheAnalysis> {
+  friend AnalysisInfoMixin<KnownBitsCacheAnalysis>;
+  static AnalysisKey Key;
+
+public:
+  using Result = KnownBitsCache;
+  KnownBitsCache run(Function &F, FunctionAnalysisManager &AM);
+};
+
+} // namespace llvm
+
+#endif // LLVM_ANALYSIS_KNOWNBITSCACHE_H
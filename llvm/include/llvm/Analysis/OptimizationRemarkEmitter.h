@@ -67,6 +67,13 @@ public:
            F->getContext().getDiagHandlerPtr()->isAnyRemarkEnabled();
   }
 
+  /// Return true iff remarks from pass \p PassName are enabled, either in the
+  /// diagnostic handler or in the optimization record file.
+  bool enabled(StringRef PassName) const {
+    return enabled(F->getContext(), PassName);
+  }
+  static bool enabled(LLVMContext &Ctx, StringRef PassName);
+
   /// Output the remark via the diagnostic handler and to the
   /// optimization record file.
   void emit(DiagnosticInfoOptimizationBase &OptDiag);
@@ -88,6 +95,23 @@ public:
     }
   }
 
+  /// Take a lambda that returns a remark from pass \p PassName. Unlike the
+  /// method above, the remark is only built if remarks from that pass are
+  /// enabled, so that the remarks dropped by the pass filters cost nothing.
+  template <typename T>
+  void emit(StringRef PassName, T RemarkBuilder,
+            decltype(RemarkBuilder()) * = nullptr) {
+    if (enabled(PassName)) {
+      auto R = RemarkBuilder();
+      static_assert(
+          std::is_base_of<DiagnosticInfoOptimizationBase, decltype(R)>::value,
+          "the lambda passed to emit() must return a remark");
+      assert(R.getPassName() == PassName &&
+             "the remark must be from the pass passed to emit()");
+      emit((DiagnosticInfoOptimizationBase &)R);
+    }
+  }
+
   /// Whether we allow for extra compile-time budget to perform more
   /// analysis to produce fewer false positives.
   ///
@@ -95,7 +95,8 @@ public:
     LIBMVEC_X86,      // GLIBC Vector Math library.
     MASSV,            // IBM MASS vector library.
     SVML,             // Intel short vector math library.
-    SLEEFGNUABI       // SLEEF - SIMD Library for Evaluating Elementary Functions.
+    SLEEFGNUABI,      // SLEEF - SIMD Library for Evaluating Elementary Functions.
+    LLVMLIBC          // LLVM libc vector math functions.
   };
 
   TargetLibraryInfoImpl();
@@ -271,6 +271,10 @@ class SelectionDAG {
   BumpPtrAllocator OperandAllocator;
   ArrayRecycler<SDUse> OperandRecycler;
 
+  /// clear() keeps OperandAllocator's memory for the next DAG as long as it
+  /// stays below this size.
+  static constexpr size_t MaxRetainedOperandMemory = 1 << 20;
+
   /// Tracks dbg_value and dbg_label information through SDISel.
   SDDbgInfo *DbgInfo;
 
@@ -4,7 +4,9 @@
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/MC/MCSection.h"
 #include "llvm/MC/MCStreamer.h"
+#include "llvm/Support/Allocator.h"
 #include <cassert>
+#include <cstring>
 
 namespace llvm {
 class DWPStringPool {
@@ -33,6 +35,9 @@ class DWPStringPool {
   MCStreamer &Out;
   MCSection *Sec;
   DenseMap<const char *, uint32_t, CStrDenseMapInfo> Pool;
+  /// Owns the keys of Pool, so that inputs can be released once they have
+  /// been written.
+  BumpPtrAllocator Alloc;
   uint32_t Offset = 0;
 
 public:
@@ -41,14 +46,18 @@ public:
   uint32_t getOffset(const char *Str, unsigned Length) {
     assert(strlen(Str) + 1 == Length && "Ensure length hint is correct");
 
-    auto Pair = Pool.insert(std::make_pair(Str, Offset));
-    if (Pair.second) {
-      Out.switchSection(Sec);
-      Out.emitBytes(StringRef(Str, Length));
-      Offset += Length;
-    }
+    auto It = Pool.find(Str);
+    if (It != Pool.end())
+      return It->second;
 
-    return Pair.first->second;
+    char *Key = Alloc.Allocate<char>(Length);
+    memcpy(Key, Str, Length);
+    Pool.insert(std::make_pair(Key, Offset));
+    Out.switchSection(Sec);
+    Out.emitBytes(StringRef(Str, Length));
+    uint32_t StrOffset = Offset;
+    Offset += Length;
+    return StrOffset;
   }
 };
 } // namespace llvm
@@ -67,6 +67,13 @@ Expected<std::string> getCachedOrDownloadExecutable(object::BuildIDRef ID);
 /// server URLs.
 Expected<std::string> getCachedOrDownloadDebuginfo(object::BuildIDRef ID);
 
+/// Fetches the debug binaries of all of \p IDs into the default local cache
+/// directory, running up to \p Parallelism downloads at a time (0 means one
+/// per hardware thread). Build IDs that no server knows about are skipped;
+/// any other failures are returned joined together.
+Error prefetchDebuginfo(ArrayRef<object::BuildID> IDs,
+                        unsigned Parallelism = 0);
+
 /// Fetches any debuginfod artifact using the default local cache directory and
 /// server URLs.
 Expected<std::string> getCachedOrDownloadArtifact(StringRef UniqueKey,
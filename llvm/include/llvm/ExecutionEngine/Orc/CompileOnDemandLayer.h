@@ -44,6 +44,7 @@
 #include <functional>
 #include <iterator>
 #include <list>
+#include <map>
 #include <memory>
 #include <optional>
 #include <set>
@@ -53,7 +54,7 @@
 namespace llvm {
 namespace orc {
 
-class CompileOnDemandLayer : public IRLayer {
+class CompileOnDemandLayer : public IRLayer, private ResourceManager {
   friend class PartitioningIRMaterializationUnit;
 
 public:
@@ -82,12 +83,31 @@ public:
                         LazyCallThroughManager &LCTMgr,
                         IndirectStubsManagerBuilder BuildIndirectStubsManager);
 
+  ~CompileOnDemandLayer();
+
   /// Sets the partition function.
   void setPartitionFunction(PartitionFunction Partition);
 
   /// Sets the ImplSymbolMap
   void setImplMap(ImplSymbolMap *Imp);
 
+  /// Enables tiered compilation.
+  ///
+  /// Every function emitted to the base layer counts its calls. Once one of
+  /// them has been called \p Threshold times, an uninstrumented copy of its
+  /// partition is emitted to \p TierUpLayer in a separate "<name>.opt"
+  /// JITDylib and the stubs of the partition's functions are repointed to
+  /// the new definitions. The copy is materialized through the
+  /// ExecutionSession, so it is compiled in the background if the session
+  /// dispatches materialization to other threads.
+  ///
+  /// Partitions that define global variables or aliases are never tiered up,
+  /// since those can not be duplicated. The copies of the partitions that have
+  /// not been tiered up yet are freed along with the resources of their
+  /// tracker. The call counters call back into this layer directly, so tiered
+  /// compilation is only supported for in-process JITs.
+  void setTierUpLayer(IRLayer &TierUpLayer, uint64_t Threshold);
+
   /// Emits the given module. This should not be called by clients: it will be
   /// called by the JIT when a definition added via the add method is requested.
   void emit(std::unique_ptr<MaterializationResponsibility> R,
@@ -101,10 +121,20 @@ private:
         : ImplD(ImplD), ISMgr(std::move(ISMgr)) {}
     JITDylib &getImplDylib() { return ImplD; }
     IndirectStubsManager &getISManager() { return *ISMgr; }
+    JITDylib *getOptDylib() { return OptD; }
+    void setOptDylib(JITDylib &D) { OptD = &D; }
 
   private:
     JITDylib &ImplD;
     std::unique_ptr<IndirectStubsManager> ISMgr;
+    JITDylib *OptD = nullptr;
+  };
+
+  /// A partition waiting to be recompiled by the tier-up layer.
+  struct TierUpPartition {
+    JITDylib *ImplD;
+    ResourceKey Key;
+    ThreadSafeModule TSM;
   };
 
   using PerDylibResourcesMap = std::map<const JITDylib *, PerDylibResources>;
@@ -119,6 +149,16 @@ private:
                      ThreadSafeModule TSM,
                      IRMaterializationUnit::SymbolNameToDefinitionMap Defs);
 
+  void prepareTierUp(MaterializationResponsibility &R, ThreadSafeModule &TSM);
+
+  static void tierUpCallback(void *Self, uint64_t Id);
+
+  void tierUp(uint64_t Id);
+
+  Error handleRemoveResources(JITDylib &JD, ResourceKey K) override;
+  void handleTransferResources(JITDylib &JD, ResourceKey DstK,
+                               ResourceKey SrcK) override;
+
   mutable std::mutex CODLayerMutex;
 
   IRLayer &BaseLayer;
@@ -128,6 +168,10 @@ private:
   PartitionFunction Partition = compileRequested;
   SymbolLinkagePromoter PromoteSymbols;
   ImplSymbolMap *AliaseeImpls = nullptr;
+  IRLayer *TierUpLayer = nullptr;
+  uint64_t TierUpThreshold = 0;
+  uint64_t NextTierUpId = 0;
+  std::map<uint64_t, TierUpPartition> TierUpPartitions;
 };
 
 } // end namespace orc
@@ -16,7 +16,11 @@
 #include "llvm/ExecutionEngine/Orc/IRCompileLayer.h"
 #include "llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h"
 #include "llvm/ExecutionEngine/Orc/Layer.h"
+#include "llvm/Support/Caching.h"
+#include <atomic>
+#include <map>
 #include <memory>
+#include <mutex>
 
 namespace llvm {
 
@@ -93,6 +97,47 @@ private:
   ObjectCache *ObjCache = nullptr;
 };
 
+/// An IRCompiler that keeps the objects produced by another IRCompiler in a
+/// FileCache (see llvm/Support/Caching.h), so that identical modules are not
+/// recompiled across process restarts.
+///
+/// Entries are keyed by a hash of the module's bitcode and of the target
+/// description taken from the JITTargetMachineBuilder (triple, CPU, features,
+/// relocation and code models, optimization level and the TargetOptions that
+/// affect code generation). On a hit the cached relocatable object is returned
+/// unchanged and IRCompileLayer hands it to the base object layer as usual.
+///
+/// This class is thread safe if the underlying compiler is.
+class CachingIRCompiler : public IRCompileLayer::IRCompiler {
+public:
+  /// Create a CachingIRCompiler that stores objects produced by
+  /// \p BaseCompiler in the directory \p CacheDir. The directory is created
+  /// the first time an object is written.
+  static Expected<std::unique_ptr<CachingIRCompiler>>
+  Create(std::unique_ptr<IRCompileLayer::IRCompiler> BaseCompiler,
+         const JITTargetMachineBuilder &JTMB, const Twine &CacheDir);
+
+  Expected<std::unique_ptr<MemoryBuffer>> operator()(Module &M) override;
+
+private:
+  CachingIRCompiler(std::unique_ptr<IRCompileLayer::IRCompiler> BaseCompiler,
+                    std::string TargetKey);
+
+  Error setCacheDirectory(const Twine &CacheDir);
+  std::string getKey(Module &M) const;
+  std::unique_ptr<MemoryBuffer> takeBuffer(unsigned Task);
+
+  std::unique_ptr<IRCompileLayer::IRCompiler> BaseCompiler;
+  std::string TargetKey;
+  FileCache Cache;
+
+  // FileCache reports cached objects through a callback, keyed by the task
+  // number passed to the lookup. Every lookup uses a fresh task number.
+  std::atomic<unsigned> NextTask{0};
+  std::mutex BuffersMutex;
+  std::map<unsigned, std::unique_ptr<MemoryBuffer>> Buffers;
+};
+
 } // end namespace orc
 
 } // end namespace llvm
@@ -192,6 +192,10 @@ protected:
   static Expected<std::unique_ptr<IRCompileLayer::IRCompiler>>
   createCompileFunction(LLJITBuilderState &S, JITTargetMachineBuilder JTMB);
 
+  static Expected<std::unique_ptr<IRCompileLayer::IRCompiler>>
+  createBaseCompileFunction(LLJITBuilderState &S,
+                            JITTargetMachineBuilder JTMB);
+
   /// Create an LLJIT instance with a single compile thread.
   LLJIT(LLJITBuilderState &S, Error &Err);
 
@@ -231,6 +235,9 @@ public:
   /// Returns a reference to the on-demand layer.
   CompileOnDemandLayer &getCompileOnDemandLayer() { return *CODLayer; }
 
+  /// Add a module to be lazily compiled with the given ResourceTracker.
+  Error addLazyIRModule(ResourceTrackerSP RT, ThreadSafeModule M);
+
   /// Add a module to be lazily compiled to JITDylib JD.
   Error addLazyIRModule(JITDylib &JD, ThreadSafeModule M);
 
@@ -246,6 +253,8 @@ private:
 
   std::unique_ptr<LazyCallThroughManager> LCTMgr;
   std::unique_ptr<CompileOnDemandLayer> CODLayer;
+  std::unique_ptr<IRCompileLayer> TierUpCompileLayer;
+  std::unique_ptr<IRTransformLayer> TierUpTransformLayer;
 };
 
 class LLJITBuilderState {
@@ -268,6 +277,7 @@ public:
   CompileFunctionCreator CreateCompileFunction;
   PlatformSetupFunction SetUpPlatform;
   unsigned NumCompileThreads = 0;
+  std::string ObjectCacheDirectory;
 
   /// Called prior to JIT class construcion to fix up defaults.
   Error prepareForConstruction();
@@ -338,6 +348,17 @@ public:
     return impl();
   }
 
+  /// Set a directory in which to cache compiled objects.
+  ///
+  /// If set, the compile function (default or custom) is wrapped in a
+  /// CachingIRCompiler, so that modules that have already been compiled for
+  /// the same target, possibly by an earlier process, are loaded from the
+  /// cache instead of being compiled again.
+  SetterImpl &setObjectCacheDirectory(std::string ObjectCacheDirectory) {
+    impl().ObjectCacheDirectory = std::move(ObjectCacheDirectory);
+    return impl();
+  }
+
   /// Set up an PlatformSetupFunction.
   ///
   /// If this method is not called then setUpGenericLLVMIRPlatform
@@ -404,6 +425,8 @@ public:
   ExecutorAddr LazyCompileFailureAddr;
   std::unique_ptr<LazyCallThroughManager> LCTMgr;
   IndirectStubsManagerBuilderFunction ISMBuilder;
+  uint64_t TierUpThreshold = 0;
+  std::optional<JITTargetMachineBuilder> TierUpJTMB;
 
   Error prepareForConstruction();
 };
@@ -439,6 +462,21 @@ public:
     this->impl().ISMBuilder = std::move(ISMBuilder);
     return this->impl();
   }
+
+  /// Enable tiered compilation.
+  ///
+  /// If set to a non-zero value, functions that are called \p Threshold times
+  /// are recompiled at -O3 (both in IR and in codegen) and their stubs
+  /// repointed to the optimized code. The first tier is compiled with the
+  /// settings of the JITTargetMachineBuilder, so for a quick first tier it
+  /// should use CodeGenOpt::None and FastISel. Transforms installed on the IR
+  /// transform layer only apply to the first tier. Tiered compilation is off
+  /// by default, and is only supported with the default in-process
+  /// ExecutorProcessControl.
+  SetterImpl &setTierUpThreshold(uint64_t Threshold) {
+    this->impl().TierUpThreshold = Threshold;
+    return this->impl();
+  }
 };
 
 /// Constructs LLLazyJIT instances.
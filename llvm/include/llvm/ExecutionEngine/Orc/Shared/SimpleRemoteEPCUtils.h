@@ -138,6 +138,66 @@ private:
   std::atomic<bool> Disconnected{false};
 };
 
+/// Uses a pair of single-producer/single-consumer rings in memory shared by
+/// both processes for transport.
+///
+/// Messages are copied into the sender's outbound ring and read by the
+/// peer's listener thread without any system calls while the listener is
+/// busy, so a burst of wrapper calls costs one round of copies rather than
+/// one round of read/write calls each. A listener that finds its ring empty
+/// spins briefly and then sleeps in a blocking read on a file descriptor; the
+/// sender writes a single wake-up byte to that descriptor only when the
+/// listener is asleep. The descriptors are also used to detect hangup.
+///
+/// The shared region must be zero-initialized before either side starts,
+/// e.g. freshly created shm_open/ftruncate memory. It is split in two halves:
+/// the JIT side sends on the first half and the executor side on the
+/// second.
+class SharedMemorySimpleRemoteEPCTransport : public SimpleRemoteEPCTransport {
+public:
+  enum class Side { JIT, Executor };
+
+  /// Create a SharedMemorySimpleRemoteEPCTransport using the shared region
+  /// [SharedMem, SharedMem + SharedMemSize) for messages, and the given FDs
+  /// for wake-ups of this side (InFD) and the peer (OutFD).
+  static Expected<std::unique_ptr<SharedMemorySimpleRemoteEPCTransport>>
+  Create(SimpleRemoteEPCTransportClient &C, Side S, char *SharedMem,
+         size_t SharedMemSize, int InFD, int OutFD);
+
+  ~SharedMemorySimpleRemoteEPCTransport() override;
+
+  Error start() override;
+
+  Error sendMessage(SimpleRemoteEPCOpcode OpC, uint64_t SeqNo,
+                    ExecutorAddr TagAddr, ArrayRef<char> ArgBytes) override;
+
+  void disconnect() override;
+
+private:
+  struct Ring;
+
+  SharedMemorySimpleRemoteEPCTransport(SimpleRemoteEPCTransportClient &C,
+                                       Ring &In, Ring &Out, uint64_t Capacity,
+                                       int InFD, int OutFD)
+      : C(C), In(In), Out(Out), Capacity(Capacity), InFD(InFD),
+        OutFD(OutFD) {}
+
+  Error readBytes(char *Dst, size_t Size, bool *IsEOF = nullptr);
+  Error writeBytes(const char *Src, size_t Size);
+  bool waitForData();
+  void wakePeer();
+  void listenLoop();
+
+  std::mutex M;
+  SimpleRemoteEPCTransportClient &C;
+  std::thread ListenerThread;
+  Ring &In;
+  Ring &Out;
+  uint64_t Capacity;
+  int InFD, OutFD;
+  std::atomic<bool> Disconnected{false};
+};
+
 struct RemoteSymbolLookupSetElement {
   std::string Name;
   bool Required;
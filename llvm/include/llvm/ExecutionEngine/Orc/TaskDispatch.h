@@ -23,7 +23,9 @@
 
 #if LLVM_ENABLE_THREADS
 #include <condition_variable>
+#include <deque>
 #include <mutex>
+#include <optional>
 #include <thread>
 #endif
 
@@ -112,8 +114,24 @@ public:
 
 #if LLVM_ENABLE_THREADS
 
+/// Runs each task on a new thread.
+///
+/// If \p MaxMaterializationThreads is set, at most that many threads run
+/// MaterializationTasks at any time; further materialization tasks are queued
+/// and picked up by those threads in FIFO order. All other tasks (lookup
+/// continuations, wrapper function calls, ...) are never queued, so they are
+/// not delayed behind a backlog of compiles. Materializers must not block
+/// waiting for another materialization when a limit is set, since the task
+/// they wait for may be queued behind them.
 class DynamicThreadPoolTaskDispatcher : public TaskDispatcher {
 public:
+  DynamicThreadPoolTaskDispatcher(
+      std::optional<size_t> MaxMaterializationThreads = std::nullopt)
+      : MaxMaterializationThreads(MaxMaterializationThreads) {
+    assert((!MaxMaterializationThreads || *MaxMaterializationThreads > 0) &&
+           "at least one materialization thread is required");
+  }
+
   void dispatch(std::unique_ptr<Task> T) override;
   void shutdown() override;
 private:
@@ -121,6 +139,9 @@ private:
   bool Running = true;
   size_t Outstanding = 0;
   std::condition_variable OutstandingCV;
+  std::optional<size_t> MaxMaterializationThreads;
+  size_t NumMaterializationThreads = 0;
+  std::deque<std::unique_ptr<Task>> MaterializationTaskQueue;
 };
 
 #endif // LLVM_ENABLE_THREADS
@@ -42,6 +42,9 @@ public:
   LLVMRemarkStreamer(remarks::RemarkStreamer &RS) : RS(RS) {}
   /// Emit a diagnostic through the streamer.
   void emit(const DiagnosticInfoOptimizationBase &Diag);
+  /// Return true if remarks from pass \p PassName pass the filter of the
+  /// streamer. This can be checked before building the remarks.
+  bool isEnabled(StringRef PassName);
 };
 
 template <typename ThisError>
@@ -32,6 +32,7 @@ namespace llvm {
 class Error;
 class IRMover;
 class LLVMContext;
+class MemoryBuffer;
 class MemoryBufferRef;
 class Module;
 class raw_pwrite_stream;
@@ -228,6 +229,49 @@ ThinBackend createWriteIndexesThinBackend(std::string OldPrefix,
                                           raw_fd_ostream *LinkedObjectsFile,
                                           IndexWriteCallback OnWrite);
 
+/// A single ThinLTO backend compilation, as handed to a
+/// RemoteBackendExecutor by the distributed ThinBackend. All references are
+/// only valid for the duration of the executor call.
+struct RemoteBackendJob {
+  /// The configuration of the link, whose code generation options the
+  /// compilation has to reproduce.
+  const Config *Conf;
+  /// The task number of this backend within the link.
+  unsigned Task;
+  /// The identifier of the module to compile.
+  StringRef ModuleID;
+  /// The bitcode of the module to compile.
+  StringRef Bitcode;
+  /// The individual summary index for this module, in the same format that
+  /// createWriteIndexesThinBackend writes to "<ModuleID>.thinlto.bc".
+  StringRef SummaryIndex;
+  /// The identifiers and bitcode of the modules that functions are imported
+  /// from, sorted by identifier.
+  std::vector<std::pair<StringRef, StringRef>> ImportedModules;
+  /// The cache key that the in-process backend would use for this module, or
+  /// empty if the module is not cacheable. Executors can use it to look up
+  /// results in a shared cache.
+  StringRef CacheKey;
+};
+
+/// Runs a RemoteBackendJob, typically by shipping it to a remote worker, and
+/// returns the native object file it produced. Executors are called
+/// concurrently from multiple threads and must be thread safe.
+using RemoteBackendExecutor =
+    std::function<Expected<std::unique_ptr<MemoryBuffer>>(
+        const RemoteBackendJob &Job)>;
+
+/// This ThinBackend hands each backend compilation to \p Executor instead of
+/// running it in-process, and adds the returned objects to the link. Up to
+/// \p Parallelism jobs are outstanding at a time. The local FileCache passed to
+/// the backend is consulted before and populated after each job, using the
+/// same keys as the in-process backend. \p OnWrite is called with the path of
+/// each module once its job has completed successfully, from one thread at a
+/// time.
+ThinBackend createDistributedThinBackend(ThreadPoolStrategy Parallelism,
+                                         RemoteBackendExecutor Executor,
+                                         IndexWriteCallback OnWrite = nullptr);
+
 /// This class implements a resolution-based interface to LLVM's LTO
 /// functionality. It supports regular LTO, parallel LTO code generation and
 /// ThinLTO. You can use it from a linker in the following way:
@@ -21,6 +21,7 @@
 #include "llvm/MC/MCSubtargetInfo.h"
 #include "llvm/MCA/CustomBehaviour.h"
 #include "llvm/MCA/HardwareUnits/HardwareUnit.h"
+#include "llvm/MCA/LoopMemoryDependences.h"
 #include "llvm/MCA/Pipeline.h"
 #include "llvm/MCA/SourceMgr.h"
 #include <memory>
@@ -46,6 +47,10 @@ struct PipelineOptions {
   unsigned StoreQueueSize;
   bool AssumeNoAlias;
   bool EnableBottleneckAnalysis;
+  // If set, the memory dependencies of the simulated code region, used by the
+  // LSUnit instead of assuming that every load aliases (or none aliases) the
+  // older stores.
+  const LoopMemoryDependences *MemoryDependences = nullptr;
 };
 
 class Context {
@@ -21,6 +21,7 @@
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/MC/MCInst.h"
 #include "llvm/MC/MCInstrInfo.h"
+#include "llvm/MC/MCRegister.h"
 #include "llvm/MC/MCSubtargetInfo.h"
 #include "llvm/MCA/SourceMgr.h"
 #include "llvm/MCA/View.h"
@@ -28,6 +29,18 @@
 namespace llvm {
 namespace mca {
 
+/// The address of a memory operand, computed from the registers read by the
+/// instruction as BaseReg + IndexReg * Scale + Displacement. A null register
+/// does not contribute to the address. Size is the number of bytes accessed,
+/// or zero if the target doesn't know it.
+struct MemoryAccess {
+  MCRegister BaseReg;
+  MCRegister IndexReg;
+  int64_t Scale = 1;
+  int64_t Displacement = 0;
+  unsigned Size = 0;
+};
+
 /// Class which can be overriden by targets to modify the
 /// mca::Instruction objects before the pipeline starts.
 /// A common usage of this class is to add immediate operands to certain
@@ -51,6 +64,22 @@ public:
   virtual void postProcessInstruction(std::unique_ptr<Instruction> &Inst,
                                       const MCInst &MCI) {}
 
+  /// This method can be overriden by targets to describe the address of the
+  /// memory operand of MCI. Returns false if MCI has no memory operand, or if
+  /// its address cannot be expressed as a MemoryAccess.
+  virtual bool getMemoryAccess(const MCInst &MCI, MemoryAccess &Access) const {
+    return false;
+  }
+
+  /// This method can be overriden by targets to identify instructions that
+  /// add the constant Offset to register Reg, such as the increment of a
+  /// pointer in a loop. Any other register written by MCI is still assumed to
+  /// be clobbered.
+  virtual bool isRegisterIncrement(const MCInst &MCI, MCRegister &Reg,
+                                   int64_t &Offset) const {
+    return false;
+  }
+
   // The resetState() method gets invoked at the beginning of each code region
   // so that targets that override this function can clear any state that they
   // have left from the previous code region.
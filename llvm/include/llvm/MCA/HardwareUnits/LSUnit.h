@@ -24,6 +24,8 @@
 namespace llvm {
 namespace mca {
 
+class LoopMemoryDependences;
+
 /// A node of a memory dependency graph. A MemoryGroup describes a set of
 /// instructions with same memory dependencies.
 ///
@@ -442,15 +444,28 @@ class LSUnit : public LSUnitBase {
   unsigned CurrentStoreGroupID;
   unsigned CurrentStoreBarrierGroupID;
 
+  // If set, the memory dependencies of the simulated loop body. A load then
+  // only depends on the older stores that it reads from, and the 'NoAlias'
+  // flag only applies to the accesses whose addresses cannot be compared.
+  const LoopMemoryDependences *MemoryDependences;
+
+  // Maps the source index of every store in flight to its memory group.
+  DenseMap<unsigned, unsigned> StoreGroupIDs;
+
+  // Returns the group of the youngest store in flight that IR reads from, or
+  // zero if there is none.
+  unsigned getAliasingStoreGroupID(const InstRef &IR) const;
+
 public:
   LSUnit(const MCSchedModel &SM)
       : LSUnit(SM, /* LQSize */ 0, /* SQSize */ 0, /* NoAlias */ false) {}
   LSUnit(const MCSchedModel &SM, unsigned LQ, unsigned SQ)
       : LSUnit(SM, LQ, SQ, /* NoAlias */ false) {}
-  LSUnit(const MCSchedModel &SM, unsigned LQ, unsigned SQ, bool AssumeNoAlias)
+  LSUnit(const MCSchedModel &SM, unsigned LQ, unsigned SQ, bool AssumeNoAlias,
+         const LoopMemoryDependences *MemDeps = nullptr)
       : LSUnitBase(SM, LQ, SQ, AssumeNoAlias), CurrentLoadGroupID(0),
         CurrentLoadBarrierGroupID(0), CurrentStoreGroupID(0),
-        CurrentStoreBarrierGroupID(0) {}
+        CurrentStoreBarrierGroupID(0), MemoryDependences(MemDeps) {}
 
   /// Returns LSU_AVAILABLE if there are enough load/store queue entries to
   /// accomodate instruction IR.
@@ -469,6 +484,9 @@ public:
   /// 4. A store may not pass a previous load (regardless of flag 'NoAlias').
   /// 5. A load has to wait until an older load barrier is fully executed.
   /// 6. A store has to wait until an older store barrier is fully executed.
+  ///
+  /// With loop memory dependencies, rule 2 only applies to the older stores
+  /// that the load may read from, including the stores of earlier iterations.
   unsigned dispatch(const InstRef &IR) override;
 
   void onInstructionExecuted(const InstRef &IR) override;
@@ -0,0 +1,81 @@
+//===---------------- LoopMemoryDependences.h -------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+/// \file
+///
+/// This file defines class LoopMemoryDependences, which computes the memory
+/// dependencies of a code region that is simulated as the body of a loop.
+///
+/// Addresses are compared symbolically: every register read by an address is
+/// described as its value at the start of an iteration plus a constant offset,
+/// which is tracked through the register increments of the loop body. The
+/// registers that are incremented by the same amount on every iteration are
+/// induction variables, so the addresses based on them can be compared across
+/// iterations. This lets a load wait for the store of an earlier iteration
+/// that it reads from (i.e. a store-to-load forwarding), instead of either
+/// never or always aliasing with the older stores.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_MCA_LOOPMEMORYDEPENDENCES_H
+#define LLVM_MCA_LOOPMEMORYDEPENDENCES_H
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/MC/MCInst.h"
+#include "llvm/MC/MCInstrInfo.h"
+#include "llvm/MC/MCRegisterInfo.h"
+#include "llvm/MCA/CustomBehaviour.h"
+
+namespace llvm {
+namespace mca {
+
+class LoopMemoryDependences {
+public:
+  /// A store that a load may read from, executed by the same iteration
+  /// (Distance is zero) or by the iteration Distance iterations before.
+  struct Dependence {
+    unsigned StoreIndex;
+    unsigned Distance;
+  };
+
+private:
+  /// Number of instructions in the loop body.
+  unsigned NumInstructions;
+
+  /// The stores that every instruction of the loop body may read from. Only
+  /// the closest instance of each store is recorded, since the stores are
+  /// executed in program order.
+  SmallVector<SmallVector<Dependence, 2>, 0> Dependences;
+
+public:
+  /// Computes the dependencies of the memory operations of Body. Accesses
+  /// whose addresses cannot be compared are assumed not to alias if
+  /// AssumeNoAlias is set, and to alias otherwise.
+  LoopMemoryDependences(ArrayRef<MCInst> Body, const InstrPostProcess &IPP,
+                        const MCInstrInfo &MCII, const MCRegisterInfo &MRI,
+                        bool AssumeNoAlias);
+
+  unsigned getNumInstructions() const { return NumInstructions; }
+
+  /// Returns the stores that the instruction at position Index of the loop
+  /// body may read from.
+  ArrayRef<Dependence> getDependences(unsigned Index) const {
+    return Dependences[Index];
+  }
+
+  /// Returns the source index of each store instance that the instruction with
+  /// source index SourceIndex may read from, assuming that instructions are
+  /// numbered in program order across the iterations of the loop.
+  void getStoreSourceIndices(unsigned SourceIndex,
+                             SmallVectorImpl<unsigned> &Stores) const;
+};
+
+} // namespace mca
+} // namespace llvm
+
+#endif // LLVM_MCA_LOOPMEMORYDEPENDENCES_H
@@ -26,8 +26,10 @@
 #include "llvm/Support/TimeProfiler.h"
 #include "llvm/Transforms/IPO/SampleProfileProbe.h"
 
+#include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace llvm {
 
@@ -453,6 +455,61 @@ private:
   void runAfterPass();
 };
 
+/// This class implements -report-slowest-pass-runs. Unlike -time-passes,
+/// which accumulates the time of each pass over all the IR units it runs on,
+/// it keeps the individual runs, so that a pathological function can be found
+/// without bisecting. For each of the slowest runs it reports the wall time
+/// and the change in the number of instructions of the IR unit.
+class SlowestPassRunsReporter {
+public:
+  /// Reports the \p NumRuns slowest pass runs. Does nothing if zero.
+  SlowestPassRunsReporter(unsigned NumRuns);
+  SlowestPassRunsReporter(const SlowestPassRunsReporter &) = delete;
+  void operator=(const SlowestPassRunsReporter &) = delete;
+
+  /// Destructor handles the print action if it has not been handled before.
+  ~SlowestPassRunsReporter() { print(); }
+
+  /// Prints the slowest runs recorded so far and resets them.
+  void print();
+
+  /// Set a custom output stream for subsequent reporting.
+  void setOutStream(raw_ostream &OutStream) { this->OutStream = &OutStream; }
+
+  void registerCallbacks(PassInstrumentationCallbacks &PIC);
+
+private:
+  struct PassRun {
+    StringRef PassID;
+    std::string IRName;
+    double WallTime;
+    /// Change in instruction count, if the IR unit survived the pass.
+    std::optional<int64_t> InstCountDelta;
+  };
+
+  struct ActivePassRun {
+    StringRef PassID;
+    double StartTime;
+    uint64_t InstCount;
+  };
+
+  void runBeforePass(StringRef PassID, Any IR);
+  void runAfterPass(StringRef PassID, std::optional<Any> IR);
+
+  /// Orders SlowestRuns as a min-heap.
+  static bool isSlower(const PassRun &LHS, const PassRun &RHS) {
+    return LHS.WallTime > RHS.WallTime;
+  }
+
+  unsigned NumRuns;
+  raw_ostream *OutStream = nullptr;
+  /// Passes currently running. Passes can be nested, e.g. a loop pass manager
+  /// run by a function pass.
+  SmallVector<ActivePassRun, 4> Stack;
+  /// The slowest runs so far, as a min-heap on WallTime.
+  std::vector<PassRun> SlowestRuns;
+};
+
 // Class that holds transitions between basic blocks.  The transitions
 // are contained in a map of values to names of basic blocks.
 class DCData {
@@ -554,6 +611,7 @@ class StandardInstrumentations {
   PrintPassInstrumentation PrintPass;
   TimePassesHandler TimePasses;
   TimeProfilingPassesHandler TimeProfilingPasses;
+  SlowestPassRunsReporter SlowestPassRuns;
   OptNoneInstrumentation OptNone;
   OptPassGateInstrumentation OptPassGate;
   PreservedCFGCheckerInstrumentation PreservedCFGChecker;
@@ -30,6 +30,7 @@
 #ifndef LLVM_REMARKS_REMARKSTREAMER_H
 #define LLVM_REMARKS_REMARKSTREAMER_H
 
+#include "llvm/ADT/StringMap.h"
 #include "llvm/Remarks/RemarkSerializer.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/Regex.h"
@@ -48,6 +49,8 @@ class RemarkStreamer final {
   std::unique_ptr<remarks::RemarkSerializer> RemarkSerializer;
   /// The filename that the remark diagnostics are emitted to.
   const std::optional<std::string> Filename;
+  /// The number of remarks seen so far from each pass, used for sampling.
+  StringMap<unsigned> PassRemarkCounts;
 
 public:
   RemarkStreamer(std::unique_ptr<remarks::RemarkSerializer> RemarkSerializer,
@@ -66,6 +69,10 @@ public:
   Error setFilter(StringRef Filter);
   /// Check wether the string matches the filter.
   bool matchesFilter(StringRef Str);
+  /// Check whether the next remark from pass \p PassName is picked by
+  /// sampling, which keeps one in every -remarks-sample-rate remarks of each
+  /// pass. This counts the remark as seen.
+  bool isSampled(StringRef PassName);
   /// Check if the remarks also need to have associated metadata in a section.
   bool needsSection() const;
 };
@@ -8,7 +8,8 @@
 //
 // This file defines the CachedFileStream and the localCache function, which
 // simplifies caching files on the local filesystem in a directory whose
-// contents are managed by a CachePruningPolicy.
+// contents are managed by a CachePruningPolicy. It also defines SharedCache,
+// which layers a local cache on top of a pluggable shared CacheStorage.
 //
 //===----------------------------------------------------------------------===//
 
@@ -16,6 +17,7 @@
 #define LLVM_SUPPORT_CACHING_H
 
 #include "llvm/Support/Error.h"
+#include "llvm/Support/Threading.h"
 
 namespace llvm {
 
@@ -74,6 +76,58 @@ Expected<FileCache> localCache(
     const Twine &CacheDirectoryPathRef,
     AddBufferFn AddBuffer = [](size_t Task, const Twine &ModuleName,
                                std::unique_ptr<MemoryBuffer> MB) {});
+
+/// A content-addressed key/value store that can back a SharedCache, such as a
+/// directory shared between machines or a network service. Implementations
+/// must be thread safe.
+class CacheStorage {
+public:
+  virtual ~CacheStorage();
+
+  /// Look up \p Key. Returns a null buffer if the key is not present.
+  virtual Expected<std::unique_ptr<MemoryBuffer>> get(StringRef Key) = 0;
+
+  /// Store \p Data under \p Key. Storing a key that is already present is
+  /// not an error; the contents are expected to be identical.
+  virtual Error put(StringRef Key, StringRef Data) = 0;
+};
+
+/// Create a CacheStorage that keeps each entry in its own file in the given
+/// directory, e.g. on a network file system. Entries are written atomically, so
+/// several machines can share the directory.
+std::unique_ptr<CacheStorage> directoryCacheStorage(const Twine &Path);
+
+/// A FileCache that consults a local cache first and falls back to a shared
+/// CacheStorage. Shared hits are copied into the local cache before they are
+/// added to the link. Entries produced locally are uploaded to the shared
+/// storage in the background, so a slow store doesn't delay the link.
+///
+/// Failures to talk to the shared storage are not fatal: lookups are treated
+/// as misses and upload errors are reported by wait().
+class SharedCache {
+public:
+  SharedCache(FileCache Local, std::unique_ptr<CacheStorage> Storage,
+              ThreadPoolStrategy S = hardware_concurrency(4));
+  /// Waits for pending uploads. Upload errors are dropped; call wait() first
+  /// to observe them.
+  ~SharedCache();
+
+  /// Start fetching \p Key from the shared storage so that a later lookup of
+  /// the same key doesn't have to wait for a round trip.
+  void prefetch(StringRef Key);
+
+  /// Return the FileCache to pass to clients such as lto::LTO::run(). It may
+  /// outlive this object.
+  FileCache getFileCache() const;
+
+  /// Wait for all pending prefetches and uploads, and return any upload errors.
+  Error wait();
+
+  class Impl;
+
+private:
+  std::shared_ptr<Impl> I;
+};
 } // namespace llvm
 
 #endif
@@ -34,6 +34,12 @@ public:
     /// Don't use mmap and instead write an in-memory buffer to a file when this
     /// buffer is closed.
     F_no_mmap = 2,
+
+    /// With F_no_mmap, write the in-memory buffer to a regular file using
+    /// multiple threads on commit(), each writing a disjoint page-aligned
+    /// chunk. This helps file systems where a single sequential writer does
+    /// not saturate the available bandwidth (e.g. NFS).
+    F_parallel_write = 4,
   };
 
   /// Factory method to create an OutputBuffer object which manages a read/write
@@ -40,8 +40,13 @@ extern thread_local unsigned threadIndex;
 
 inline unsigned getThreadIndex() { return threadIndex; }
 #endif
+
+// Returns the number of worker threads of the default executor. The values
+// returned by getThreadIndex() on those threads are in [0, getThreadCount()).
+size_t getThreadCount();
 #else
 inline unsigned getThreadIndex() { return 0; }
+inline size_t getThreadCount() { return 1; }
 #endif
 
 namespace detail {
@@ -77,7 +82,11 @@ public:
 
 class TaskGroup {
   detail::Latch L;
-  bool Parallel;
+  // For a group created on a worker thread of the default executor, the
+  // worker's spawn mark at creation; tasks spawned after it are run by the
+  // worker while it waits for the group.
+  static constexpr uint64_t NotOnWorker = UINT64_MAX;
+  uint64_t SpawnMark = NotOnWorker;
 
 public:
   TaskGroup();
@@ -103,7 +112,16 @@ public:
   // }
   void execute(std::function<void()> f);
 
-  void sync() const { L.sync(); }
+  // Wait for all spawned tasks to finish.
+  //
+  // TaskGroups can be nested: the tasks of a group created by a task of
+  // another group (e.g. a parallelFor within a parallelFor) run in parallel
+  // too. When called from a worker thread of the default executor, sync()
+  // first runs the tasks that the thread spawned since the group was created
+  // and that no other worker took yet. It runs no other task, as the waiting
+  // task may hold a lock that an unrelated task needs. It then blocks until
+  // the tasks taken by other workers finish.
+  void sync() const;
 };
 
 namespace detail {
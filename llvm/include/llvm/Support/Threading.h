@@ -129,6 +129,11 @@ constexpr bool llvm_is_multithreaded() { return LLVM_ENABLE_THREADS; }
     // threads, or hardware cores.
     bool Limit = false;
 
+    // On Linux, if set, pin the threads to the CPUs of the NUMA nodes when
+    // more threads are requested than one node provides. The threads are
+    // otherwise left where the OS schedules them.
+    bool PinToNUMANodes = false;
+
     /// Retrieves the max available threads for the current strategy. This
     /// accounts for affinity masks and takes advantage of all CPU sockets.
     unsigned compute_thread_count() const;
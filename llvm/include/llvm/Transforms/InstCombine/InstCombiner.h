@@ -19,6 +19,7 @@
 #define LLVM_TRANSFORMS_INSTCOMBINE_INSTCOMBINER_H
 
 #include "llvm/Analysis/InstructionSimplify.h"
+#include "llvm/Analysis/KnownBitsCache.h"
 #include "llvm/Analysis/TargetFolder.h"
 #include "llvm/Analysis/ValueTracking.h"
 #include "llvm/IR/IRBuilder.h"
@@ -52,6 +53,12 @@ public:
   /// Maximum size of array considered when transforming.
   uint64_t MaxArraySizeForCombine = 0;
 
+  /// If non-null, answers the known bits and sign bits queries at depth zero.
+  /// It is cleared whenever a combine changes the IR, and the values that are
+  /// modified in place during a combine are invalidated with
+  /// invalidateKnownBits.
+  KnownBitsCache *KBCache = nullptr;
+
   /// An IRBuilder that automatically inserts new instructions into the
   /// worklist.
   using BuilderTy = IRBuilder<TargetFolder, IRBuilderCallbackInserter>;
@@ -434,6 +441,7 @@ public:
     if (V->use_empty() && isa<Instruction>(V) && !V->hasName() && I.hasName())
       V->takeName(&I);
 
+    invalidateKnownBits(&I);
     I.replaceAllUsesWith(V);
     return &I;
   }
@@ -442,6 +450,7 @@ public:
   Instruction *replaceOperand(Instruction &I, unsigned OpNum, Value *V) {
     Worklist.addValue(I.getOperand(OpNum));
     I.setOperand(OpNum, V);
+    invalidateKnownBits(&I);
     return &I;
   }
 
@@ -449,6 +458,16 @@ public:
   void replaceUse(Use &U, Value *NewValue) {
     Worklist.addValue(U);
     U = NewValue;
+    invalidateKnownBits(U.getUser());
+  }
+
+  /// Notify the known bits cache, if any, that \p V was modified in place, so
+  /// that the results computed from it are dropped. Combines that change the
+  /// operands, the predicate or the poison-generating flags of an instruction
+  /// and then keep going must call this.
+  void invalidateKnownBits(const Value *V) {
+    if (KBCache)
+      KBCache->invalidateValue(V);
   }
 
   /// Combiner aware instruction erasure.
@@ -460,11 +479,17 @@ public:
 
   void computeKnownBits(const Value *V, KnownBits &Known, unsigned Depth,
                         const Instruction *CxtI) const {
+    if (KBCache && Depth == 0) {
+      Known = KBCache->computeKnownBits(V, CxtI);
+      return;
+    }
     llvm::computeKnownBits(V, Known, DL, Depth, &AC, CxtI, &DT);
   }
 
   KnownBits computeKnownBits(const Value *V, unsigned Depth,
                              const Instruction *CxtI) const {
+    if (KBCache && Depth == 0)
+      return KBCache->computeKnownBits(V, CxtI);
     return llvm::computeKnownBits(V, DL, Depth, &AC, CxtI, &DT);
   }
 
@@ -481,11 +506,16 @@ public:
 
   unsigned ComputeNumSignBits(const Value *Op, unsigned Depth = 0,
                               const Instruction *CxtI = nullptr) const {
+    if (KBCache && Depth == 0)
+      return KBCache->ComputeNumSignBits(Op, CxtI);
     return llvm::ComputeNumSignBits(Op, DL, Depth, &AC, CxtI, &DT);
   }
 
   unsigned ComputeMaxSignificantBits(const Value *Op, unsigned Depth = 0,
                                      const Instruction *CxtI = nullptr) const {
+    if (KBCache && Depth == 0)
+      return Op->getType()->getScalarSizeInBits() -
+             KBCache->ComputeNumSignBits(Op, CxtI) + 1;
     return llvm::ComputeMaxSignificantBits(Op, DL, Depth, &AC, CxtI, &DT);
   }
 
@@ -19,6 +19,7 @@
 
 namespace llvm {
 
+class AACache;
 class AAResults;
 class BatchAAResults;
 class AssumptionCache;
@@ -44,6 +45,7 @@ class MemCpyOptPass : public PassInfoMixin<MemCpyOptPass> {
   DominatorTree *DT = nullptr;
   MemorySSA *MSSA = nullptr;
   MemorySSAUpdater *MSSAU = nullptr;
+  AACache *AAC = nullptr;
 
 public:
   MemCpyOptPass() = default;
@@ -52,7 +54,8 @@ public:
 
   // Glue for the old PM.
   bool runImpl(Function &F, TargetLibraryInfo *TLI, AAResults *AA,
-               AssumptionCache *AC, DominatorTree *DT, MemorySSA *MSSA);
+               AssumptionCache *AC, DominatorTree *DT, MemorySSA *MSSA,
+               AACache *AAC = nullptr);
 
 private:
   // Helper functions
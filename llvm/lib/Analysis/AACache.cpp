@@ -0,0 +1,209 @@
+//===- AACache.cpp - Cache of alias analysis queries ----------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Analysis/AACache.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/Analysis/ValueTracking.h"
+#include "llvm/IR/Argument.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/Instruction.h"
+#include <functional>
+
+using namespace llvm;
+
+#define DEBUG_TYPE "aa-cache"
+
+STATISTIC(NumAliasHits, "Number of alias queries answered by the cache");
+STATISTIC(NumAliasMisses, "Number of alias queries computed");
+STATISTIC(NumModRefHits, "Number of mod/ref queries answered by the cache");
+STATISTIC(NumModRefMisses, "Number of mod/ref queries computed");
+STATISTIC(NumInvalidatedEntries, "Number of cache entries invalidated");
+
+void AACache::AACacheCallbackVH::deleted() {
+  AACache *C = Cache;
+  const Value *V = getValPtr();
+  C->forgetValue(V);
+  // This value is no longer tracked.
+  C->TrackedValues.erase(C->TrackedValues.find_as(V));
+  // this now dangles!
+}
+
+// Returns the function of a tracked value, or null for an instruction that is
+// not inserted in a function, e.g. one that was just removed from it.
+static const Function *getParentFunction(const Value *V) {
+  if (const auto *I = dyn_cast<Instruction>(V))
+    return I->getParent() ? I->getFunction() : nullptr;
+  return cast<Argument>(V)->getParent();
+}
+
+void AACache::AACacheCallbackVH::allUsesReplacedWith(Value *New) {
+  // The former users of the value now use New, so the values derived from
+  // them are treated as invalidated. They can't be told apart from the other
+  // users of New, whose entries are dropped too. The underlying object of New
+  // gains users, that may capture it.
+  Value *Old = getValPtr();
+  Cache->forgetValue(Old);
+  if (isa<Instruction, Argument>(New)) {
+    Cache->forgetValue(New);
+  } else if (const Function *F = getParentFunction(Old)) {
+    for (const User *U : New->users())
+      if (const auto *I = dyn_cast<Instruction>(U);
+          I && I->getParent() && I->getFunction() == F)
+        Cache->forgetValue(I);
+  }
+  Cache->forgetUnderlyingObject(New);
+}
+
+bool AACache::invalidate(Function &F, const PreservedAnalyses &PA,
+                         FunctionAnalysisManager::Invalidator &Inv) {
+  // AACache is invalidated if it isn't preserved, or if the CFG changed, as
+  // alias analysis uses the dominator tree.
+  auto PAC = PA.getChecker<AACacheAnalysis>();
+  if (!(PAC.preserved() || PAC.preservedSet<AllAnalysesOn<Function>>()))
+    return true;
+  return !PA.allAnalysesInSetPreserved<CFGAnalyses>();
+}
+
+AliasResult AACache::alias(AAResults &AA, AAQueryInfo &AAQI,
+                           const MemoryLocation &LocA,
+                           const MemoryLocation &LocB) {
+  bool Swapped = std::less<const Value *>()(LocB.Ptr, LocA.Ptr);
+  LocPair Key = Swapped ? LocPair(LocB, LocA) : LocPair(LocA, LocB);
+  auto It = AliasResults.find(Key);
+  if (It != AliasResults.end()) {
+    ++NumAliasHits;
+    AliasResult Result = It->second;
+    Result.swap(Swapped);
+    return Result;
+  }
+  ++NumAliasMisses;
+
+  AliasResult Result = AA.alias(LocA, LocB, AAQI);
+  AliasResult Cached = Result;
+  Cached.swap(Swapped);
+  AliasResults.insert({Key, Cached});
+  addAliasEntry(LocA.Ptr, Key);
+  if (LocB.Ptr != LocA.Ptr)
+    addAliasEntry(LocB.Ptr, Key);
+  return Result;
+}
+
+ModRefInfo AACache::getModRefInfo(AAResults &AA, AAQueryInfo &AAQI,
+                                  const Instruction *I,
+                                  const std::optional<MemoryLocation> &OptLoc) {
+  // A location with a null pointer keys the queries without a location, so
+  // the rare queries with such a location are not cached.
+  if (OptLoc && !OptLoc->Ptr)
+    return AA.getModRefInfo(I, OptLoc, AAQI);
+
+  ModRefKey Key(I, OptLoc.value_or(MemoryLocation()));
+  auto It = ModRefResults.find(Key);
+  if (It != ModRefResults.end()) {
+    ++NumModRefHits;
+    return It->second;
+  }
+  ++NumModRefMisses;
+
+  ModRefInfo Result = AA.getModRefInfo(I, OptLoc, AAQI);
+  ModRefResults.insert({Key, Result});
+  trackValue(I);
+  ModRefEntries[I].push_back(Key);
+  if (const Value *Ptr = Key.second.Ptr) {
+    trackValue(Ptr);
+    ModRefEntries[Ptr].push_back(Key);
+  }
+  return Result;
+}
+
+void AACache::addAliasEntry(const Value *V, const LocPair &Key) {
+  if (!V)
+    return;
+  trackValue(V);
+  AliasEntries[V].push_back(Key);
+}
+
+void AACache::trackValue(const Value *V) {
+  // Alias analysis looks through the operands of the instructions, so they are
+  // tracked too. Each value is only visited once in the lifetime of the cache.
+  SmallVector<const Value *, 8> Worklist;
+  Worklist.push_back(V);
+  while (!Worklist.empty()) {
+    const Value *Cur = Worklist.pop_back_val();
+    if (!isa<Instruction, Argument>(Cur))
+      continue;
+    if (!TrackedValues
+             .insert(AACacheCallbackVH(const_cast<Value *>(Cur), this))
+             .second)
+      continue;
+    if (const auto *I = dyn_cast<Instruction>(Cur))
+      append_range(Worklist, I->operand_values());
+  }
+}
+
+void AACache::forgetEntries(const Value *V) {
+  auto It = AliasEntries.find(V);
+  if (It != AliasEntries.end()) {
+    for (const LocPair &Key : It->second)
+      NumInvalidatedEntries += AliasResults.erase(Key);
+    AliasEntries.erase(It);
+  }
+
+  auto MIt = ModRefEntries.find(V);
+  if (MIt != ModRefEntries.end()) {
+    for (const ModRefKey &Key : MIt->second)
+      NumInvalidatedEntries += ModRefResults.erase(Key);
+    ModRefEntries.erase(MIt);
+  }
+}
+
+void AACache::forgetValue(const Value *V) {
+  // The entries of all the values computed from V may have been computed from
+  // it, as the tracked values include all their operands.
+  SmallVector<const Value *, 16> Worklist;
+  SmallPtrSet<const Value *, 16> Visited;
+  Worklist.push_back(V);
+  Visited.insert(V);
+  while (!Worklist.empty()) {
+    const Value *Cur = Worklist.pop_back_val();
+    forgetEntries(Cur);
+    for (const User *U : Cur->users())
+      if (isa<Instruction>(U) && Visited.insert(U).second)
+        Worklist.push_back(U);
+  }
+}
+
+void AACache::forgetUnderlyingObject(const Value *V) {
+  // Alias analysis only uses the capture status of identified function-local
+  // objects.
+  const Value *Obj = getUnderlyingObject(V);
+  if (isIdentifiedFunctionLocal(Obj))
+    forgetValue(Obj);
+}
+
+void AACache::invalidateValue(const Value *V) {
+  forgetValue(V);
+  if (const auto *I = dyn_cast<Instruction>(V))
+    for (const Value *Op : I->operand_values())
+      if (Op->getType()->isPtrOrPtrVectorTy())
+        forgetUnderlyingObject(Op);
+}
+
+void AACache::clear() {
+  NumInvalidatedEntries += AliasResults.size() + ModRefResults.size();
+  AliasResults.clear();
+  ModRefResults.clear();
+  AliasEntries.clear();
+  ModRefEntries.clear();
+  TrackedValues.clear();
+}
+
+AnalysisKey AACacheAnalysis::Key;
+AACache AACacheAnalysis::run(Function &F, FunctionAnalysisManager &AM) {
+  return AACache();
+}
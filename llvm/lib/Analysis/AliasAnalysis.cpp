@@ -25,6 +25,7 @@
 
 #include "llvm/Analysis/AliasAnalysis.h"
 #include "llvm/ADT/Statistic.h"
+#include "llvm/Analysis/AACache.h"
 #include "llvm/Analysis/BasicAliasAnalysis.h"
 #include "llvm/Analysis/CaptureTracking.h"
 #include "llvm/Analysis/GlobalsModRef.h"
@@ -637,6 +638,17 @@ ModRefInfo AAResults::getModRefInfo(const Instruction *I,
   }
 }
 
+AliasResult BatchAAResults::cachedAlias(const MemoryLocation &LocA,
+                                        const MemoryLocation &LocB) {
+  return Cache->alias(AA, AAQI, LocA, LocB);
+}
+
+ModRefInfo
+BatchAAResults::cachedModRefInfo(const Instruction *I,
+                                 const std::optional<MemoryLocation> &OptLoc) {
+  return Cache->getModRefInfo(AA, AAQI, I, OptLoc);
+}
+
 /// Return information about whether a particular call site modifies
 /// or reads the specified memory location \p MemLoc before instruction \p I
 /// in a BasicBlock.
@@ -107,7 +107,7 @@ void DefaultInlineAdvice::recordUnsuccessfulInliningImpl(
   using namespace ore;
   llvm::setInlineRemark(*OriginalCB, std::string(Result.getFailureReason()) +
                                          "; " + inlineCostStr(*OIC));
-  ORE.emit([&]() {
+  ORE.emit(Advisor->getAnnotatedInlinePassName(), [&]() {
     return OptimizationRemarkMissed(Advisor->getAnnotatedInlinePassName(),
                                     "NotInlined", DLoc, Block)
            << "'" << NV("Callee", Callee) << "' is not inlined into '"
@@ -392,14 +392,14 @@ llvm::shouldInline(CallBase &CB,
     LLVM_DEBUG(dbgs() << "    NOT Inlining " << inlineCostStr(IC)
                       << ", Call: " << CB << "\n");
     if (IC.isNever()) {
-      ORE.emit([&]() {
+      ORE.emit(DEBUG_TYPE, [&]() {
         return OptimizationRemarkMissed(DEBUG_TYPE, "NeverInline", Call)
                << "'" << NV("Callee", Callee) << "' not inlined into '"
                << NV("Caller", Caller)
                << "' because it should never be inlined " << IC;
       });
     } else {
-      ORE.emit([&]() {
+      ORE.emit(DEBUG_TYPE, [&]() {
         return OptimizationRemarkMissed(DEBUG_TYPE, "TooCostly", Call)
                << "'" << NV("Callee", Callee) << "' not inlined into '"
                << NV("Caller", Caller) << "' because too costly to inline "
@@ -416,7 +416,7 @@ llvm::shouldInline(CallBase &CB,
     LLVM_DEBUG(dbgs() << "    NOT Inlining: " << CB
                       << " Cost = " << IC.getCost()
                       << ", outer Cost = " << TotalSecondaryCost << '\n');
-    ORE.emit([&]() {
+    ORE.emit(DEBUG_TYPE, [&]() {
       return OptimizationRemarkMissed(DEBUG_TYPE, "IncreaseCostInOtherContexts",
                                       Call)
              << "Not inlining. Cost of inlining '" << NV("Callee", Callee)
@@ -491,10 +491,11 @@ void llvm::emitInlinedInto(
     const Function &Callee, const Function &Caller, bool AlwaysInline,
     function_ref<void(OptimizationRemark &)> ExtraContext,
     const char *PassName) {
-  ORE.emit([&]() {
+  if (!PassName)
+    PassName = DEBUG_TYPE;
+  ORE.emit(PassName, [&]() {
     StringRef RemarkName = AlwaysInline ? "AlwaysInline" : "Inlined";
-    OptimizationRemark Remark(PassName ? PassName : DEBUG_TYPE, RemarkName,
-                              DLoc, Block);
+    OptimizationRemark Remark(PassName, RemarkName, DLoc, Block);
     Remark << "'" << ore::NV("Callee", &Callee) << "' inlined into '"
            << ore::NV("Caller", &Caller) << "'";
     if (ExtraContext)
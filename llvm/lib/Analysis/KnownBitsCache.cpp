@@ -0,0 +1,177 @@
+//===- KnownBitsCache.cpp - Cache of known bits queries -------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Analysis/KnownBitsCache.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/Analysis/AssumptionCache.h"
+#include "llvm/Analysis/ValueTracking.h"
+#include "llvm/IR/Dominators.h"
+#include "llvm/IR/Instruction.h"
+#include "llvm/IR/Module.h"
+
+using namespace llvm;
+
+#define DEBUG_TYPE "known-bits-cache"
+
+STATISTIC(NumKnownBitsHits, "Number of known bits queries answered by the "
+                            "cache");
+STATISTIC(NumKnownBitsMisses, "Number of known bits queries computed");
+STATISTIC(NumSignBitsHits, "Number of sign bits queries answered by the "
+                           "cache");
+STATISTIC(NumSignBitsMisses, "Number of sign bits queries computed");
+STATISTIC(NumInvalidatedEntries, "Number of cache entries invalidated");
+
+void KnownBitsCache::KnownBitsCacheCallbackVH::deleted() {
+  KBC->invalidateValue(getValPtr());
+}
+
+void KnownBitsCache::KnownBitsCacheCallbackVH::allUsesReplacedWith(Value *) {
+  // The users of the value now use another one, whose known bits may differ,
+  // so the value is treated as invalidated.
+  KBC->invalidateValue(getValPtr());
+}
+
+bool KnownBitsCache::invalidate(Function &F, const PreservedAnalyses &PA,
+                                FunctionAnalysisManager::Invalidator &Inv) {
+  // KnownBitsCache is invalidated if it isn't preserved, or if the analyses
+  // it was computed with are invalidated.
+  auto PAC = PA.getChecker<KnownBitsCacheAnalysis>();
+  if (!(PAC.preserved() || PAC.preservedSet<AllAnalysesOn<Function>>()))
+    return true;
+  return (AC && Inv.invalidate<AssumptionAnalysis>(F, PA)) ||
+         (DT && Inv.invalidate<DominatorTreeAnalysis>(F, PA));
+}
+
+KnownBits KnownBitsCache::computeKnownBits(const Value *V,
+                                           const Instruction *CxtI) {
+  // Constants and arguments are cheap to analyze and are not cached.
+  const auto *I = dyn_cast<Instruction>(V);
+  if (!I || !I->getParent())
+    return llvm::computeKnownBits(V, DL, /*Depth=*/0, AC, CxtI, DT);
+
+  // Pick the same context instruction as ValueTracking does.
+  if (!CxtI || !CxtI->getParent())
+    CxtI = I;
+
+  Entry &E = getEntry(I, CxtI);
+  if (E.Known) {
+    ++NumKnownBitsHits;
+    return *E.Known;
+  }
+  ++NumKnownBitsMisses;
+  E.Known = llvm::computeKnownBits(V, DL, /*Depth=*/0, AC, CxtI, DT);
+  return *E.Known;
+}
+
+unsigned KnownBitsCache::ComputeNumSignBits(const Value *V,
+                                            const Instruction *CxtI) {
+  const auto *I = dyn_cast<Instruction>(V);
+  if (!I || !I->getParent())
+    return llvm::ComputeNumSignBits(V, DL, /*Depth=*/0, AC, CxtI, DT);
+
+  if (!CxtI || !CxtI->getParent())
+    CxtI = I;
+
+  Entry &E = getEntry(I, CxtI);
+  if (E.NumSignBits) {
+    ++NumSignBitsHits;
+    return *E.NumSignBits;
+  }
+  ++NumSignBitsMisses;
+  E.NumSignBits = llvm::ComputeNumSignBits(V, DL, /*Depth=*/0, AC, CxtI, DT);
+  return *E.NumSignBits;
+}
+
+KnownBitsCache::Entry &KnownBitsCache::getEntry(const Instruction *V,
+                                                const Instruction *CxtI) {
+  SmallVectorImpl<Entry> &VEntries = Entries[V];
+  for (Entry &E : VEntries)
+    if (E.CxtI == CxtI)
+      return E;
+
+  trackValue(V);
+  if (CxtI != V)
+    trackValue(CxtI);
+  SmallVectorImpl<const Value *> &Users = ContextUsers[CxtI];
+  if (!is_contained(Users, V))
+    Users.push_back(V);
+  VEntries.push_back({CxtI, std::nullopt, std::nullopt});
+  return VEntries.back();
+}
+
+void KnownBitsCache::trackValue(const Value *V) {
+  TrackedValues.insert(KnownBitsCacheCallbackVH(const_cast<Value *>(V), this));
+}
+
+void KnownBitsCache::forgetValue(const Value *V) {
+  auto It = Entries.find(V);
+  if (It != Entries.end()) {
+    NumInvalidatedEntries += It->second.size();
+    Entries.erase(It);
+  }
+
+  auto CIt = ContextUsers.find(V);
+  if (CIt == ContextUsers.end())
+    return;
+  for (const Value *User : CIt->second) {
+    auto UIt = Entries.find(User);
+    if (UIt == Entries.end())
+      continue;
+    SmallVectorImpl<Entry> &UserEntries = UIt->second;
+    auto *NewEnd =
+        remove_if(UserEntries, [V](const Entry &E) { return E.CxtI == V; });
+    NumInvalidatedEntries += UserEntries.end() - NewEnd;
+    UserEntries.erase(NewEnd, UserEntries.end());
+    if (UserEntries.empty())
+      Entries.erase(UIt);
+  }
+  ContextUsers.erase(CIt);
+}
+
+void KnownBitsCache::invalidateValue(const Value *V) {
+  // The known bits of a value are computed from the values up to
+  // MaxAnalysisRecursionDepth operands away, so the users up to that depth are
+  // invalid too. The users are visited breadth first, so that each of them is
+  // reached at its minimal depth.
+  SmallVector<std::pair<const Value *, unsigned>, 16> Worklist;
+  SmallPtrSet<const Value *, 16> Visited;
+  Worklist.push_back({V, 0});
+  Visited.insert(V);
+  for (unsigned Idx = 0; Idx != Worklist.size(); ++Idx) {
+    auto [Cur, Depth] = Worklist[Idx];
+    forgetValue(Cur);
+    if (Depth == MaxAnalysisRecursionDepth)
+      continue;
+    for (const User *U : Cur->users())
+      if (isa<Instruction>(U) && Visited.insert(U).second)
+        Worklist.push_back({U, Depth + 1});
+  }
+
+  // This value is no longer tracked.
+  auto It = TrackedValues.find_as(V);
+  if (It != TrackedValues.end())
+    TrackedValues.erase(It);
+}
+
+void KnownBitsCache::clear() {
+  for (const auto &[V, VEntries] : Entries)
+    NumInvalidatedEntries += VEntries.size();
+  Entries.clear();
+  ContextUsers.clear();
+  TrackedValues.clear();
+}
+
+AnalysisKey KnownBitsCacheAnalysis::Key;
+KnownBitsCache KnownBitsCacheAnalysis::run(Function &F,
+                                           FunctionAnalysisManager &AM) {
+  return KnownBitsCache(F.getParent()->getDataLayout(),
+                        &AM.getResult<AssumptionAnalysis>(F),
+                        &AM.getResult<DominatorTreeAnalysis>(F));
+}
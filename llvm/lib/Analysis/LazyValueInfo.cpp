@@ -14,6 +14,7 @@
 #include "llvm/Analysis/LazyValueInfo.h"
 #include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Analysis/AssumptionCache.h"
 #include "llvm/Analysis/ConstantFolding.h"
 #include "llvm/Analysis/InstructionSimplify.h"
@@ -33,6 +34,7 @@
 #include "llvm/IR/PatternMatch.h"
 #include "llvm/IR/ValueHandle.h"
 #include "llvm/InitializePasses.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/FormattedStream.h"
 #include "llvm/Support/KnownBits.h"
@@ -47,6 +49,17 @@ using namespace PatternMatch;
 // answer for a given value.
 static const unsigned MaxProcessedPerValue = 500;
 
+// Bounds the memory used by the cache on large functions, where clients such
+// as JumpThreading and CorrelatedValuePropagation query most values in most
+// blocks.
+static cl::opt<unsigned> MaxCachedValues(
+    "lvi-max-cached-values", cl::Hidden, cl::init(1u << 20),
+    cl::desc("Maximum number of per-block values cached by LazyValueInfo "
+             "before the cache is flushed (0 = no limit)"));
+
+STATISTIC(NumCacheFlushes, "Number of times the LazyValueInfo cache was "
+                           "flushed because it exceeded its size limit");
+
 char LazyValueInfoWrapperPass::ID = 0;
 LazyValueInfoWrapperPass::LazyValueInfoWrapperPass() : FunctionPass(ID) {
   initializeLazyValueInfoWrapperPassPass(*PassRegistry::getPassRegistry());
@@ -172,6 +185,14 @@ namespace {
         BlockCache;
     /// Set of value handles used to erase values from the cache on deletion.
     DenseSet<LVIValueHandle, DenseMapInfo<Value *>> ValueHandles;
+    /// The blocks that have cached information for each value, so that
+    /// erasing a value does not have to visit every block. The lists may
+    /// contain blocks that have since been erased, or that no longer hold the
+    /// value.
+    DenseMap<Value *, SmallVector<BasicBlock *, 4>> ValueBlocks;
+    /// The number of per-block values added since the cache was last cleared,
+    /// which bounds its size.
+    unsigned NumCachedValues = 0;
 
     const BlockCacheEntry *getBlockEntry(BasicBlock *BB) const {
       auto It = BlockCache.find_as(BB);
@@ -195,6 +216,12 @@ namespace {
         ValueHandles.insert({ Val, this });
     }
 
+    /// Record that \p Val has cached information in \p BB.
+    void addValueBlock(Value *Val, BasicBlock *BB) {
+      ValueBlocks[Val].push_back(BB);
+      ++NumCachedValues;
+    }
+
   public:
     void insertResult(Value *Val, BasicBlock *BB,
                       const ValueLatticeElement &Result) {
@@ -202,12 +229,15 @@ namespace {
 
       // Insert over-defined values into their own cache to reduce memory
       // overhead.
+      bool Inserted;
       if (Result.isOverdefined())
-        Entry->OverDefined.insert(Val);
+        Inserted = Entry->OverDefined.insert(Val).second;
       else
-        Entry->LatticeElements.insert({ Val, Result });
+        Inserted = Entry->LatticeElements.insert({ Val, Result }).second;
 
       addValueHandle(Val);
+      if (Inserted)
+        addValueBlock(Val, BB);
     }
 
     std::optional<ValueLatticeElement>
@@ -232,8 +262,10 @@ namespace {
       BlockCacheEntry *Entry = getOrCreateBlockEntry(BB);
       if (!Entry->NonNullPointers) {
         Entry->NonNullPointers = InitFn(BB);
-        for (Value *V : *Entry->NonNullPointers)
+        for (Value *V : *Entry->NonNullPointers) {
           addValueHandle(V);
+          addValueBlock(V, BB);
+        }
       }
 
       return Entry->NonNullPointers->count(V);
@@ -243,6 +275,14 @@ namespace {
     void clear() {
       BlockCache.clear();
       ValueHandles.clear();
+      ValueBlocks.clear();
+      NumCachedValues = 0;
+    }
+
+    /// Returns true if the cache holds more values than allowed by
+    /// -lvi-max-cached-values.
+    bool isOverLimit() const {
+      return MaxCachedValues && NumCachedValues > MaxCachedValues;
     }
 
     /// Inform the cache that a given value has been deleted.
@@ -260,11 +300,18 @@ namespace {
 }
 
 void LazyValueInfoCache::eraseValue(Value *V) {
-  for (auto &Pair : BlockCache) {
-    Pair.second->LatticeElements.erase(V);
-    Pair.second->OverDefined.erase(V);
-    if (Pair.second->NonNullPointers)
-      Pair.second->NonNullPointers->erase(V);
+  auto BlocksIt = ValueBlocks.find(V);
+  if (BlocksIt != ValueBlocks.end()) {
+    for (BasicBlock *BB : BlocksIt->second) {
+      auto It = BlockCache.find_as(BB);
+      if (It == BlockCache.end())
+        continue;
+      It->second->LatticeElements.erase(V);
+      It->second->OverDefined.erase(V);
+      if (It->second->NonNullPointers)
+        It->second->NonNullPointers->erase(V);
+    }
+    ValueBlocks.erase(BlocksIt);
   }
 
   auto HandleIt = ValueHandles.find_as(V);
@@ -435,6 +482,16 @@ class LazyValueInfoImpl {
 
   void solve();
 
+  /// Flush the cache if it grew past its size limit. This must only be done
+  /// between queries, as the solver relies on the values it has cached.
+  void flushCacheIfOverLimit() {
+    if (!TheCache.isOverLimit())
+      return;
+    LLVM_DEBUG(dbgs() << "LVI cache over its size limit, flushing it\n");
+    ++NumCacheFlushes;
+    TheCache.clear();
+  }
+
 public:
   /// This is the query interface to determine the lattice value for the
   /// specified Value* at the context instruction (if specified) or at the
@@ -1482,6 +1539,7 @@ ValueLatticeElement LazyValueInfoImpl::getValueInBlock(Value *V, BasicBlock *BB,
                     << BB->getName() << "'\n");
 
   assert(BlockValueStack.empty() && BlockValueSet.empty());
+  flushCacheIfOverLimit();
   std::optional<ValueLatticeElement> OptResult = getBlockValue(V, BB, CxtI);
   if (!OptResult) {
     solve();
@@ -1517,6 +1575,7 @@ getValueOnEdge(Value *V, BasicBlock *FromBB, BasicBlock *ToBB,
                     << FromBB->getName() << "' to '" << ToBB->getName()
                     << "'\n");
 
+  flushCacheIfOverLimit();
   std::optional<ValueLatticeElement> Result =
       getEdgeValue(V, FromBB, ToBB, CxtI);
   if (!Result) {
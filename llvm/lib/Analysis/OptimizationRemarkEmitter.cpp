@@ -19,6 +19,7 @@
 #include "llvm/IR/DiagnosticInfo.h"
 #include "llvm/IR/Dominators.h"
 #include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/LLVMRemarkStreamer.h"
 #include "llvm/InitializePasses.h"
 #include <optional>
 
@@ -90,6 +91,13 @@ void OptimizationRemarkEmitter::emit(
   F->getContext().diagnose(OptDiag);
 }
 
+bool OptimizationRemarkEmitter::enabled(LLVMContext &Ctx, StringRef PassName) {
+  if (Ctx.getDiagHandlerPtr()->isAnyRemarkEnabled(PassName))
+    return true;
+  LLVMRemarkStreamer *RS = Ctx.getLLVMRemarkStreamer();
+  return RS && RS->isEnabled(PassName);
+}
+
 OptimizationRemarkEmitterWrapperPass::OptimizationRemarkEmitterWrapperPass()
     : FunctionPass(ID) {
   initializeOptimizationRemarkEmitterWrapperPassPass(
@@ -6594,11 +6594,21 @@ Error BitcodeReader::materialize(GlobalValue *GV) {
   if (StripDebugInfo)
     stripDebugInfo(*F);
 
-  // Upgrade any old intrinsic calls in the function.
-  for (auto &I : UpgradedIntrinsics) {
-    for (User *U : llvm::make_early_inc_range(I.first->materialized_users()))
-      if (CallInst *CI = dyn_cast<CallInst>(U))
-        UpgradeIntrinsicCall(CI, I.second);
+  // Upgrade any old intrinsic calls in the function. Calls in previously
+  // materialized functions have already been upgraded, so only this body needs
+  // to be scanned rather than every user of every upgraded intrinsic, which
+  // would be quadratic in the number of materialized functions.
+  if (!UpgradedIntrinsics.empty()) {
+    SmallVector<std::pair<CallInst *, Function *>, 8> ToUpgrade;
+    for (auto &I : instructions(F))
+      if (auto *CI = dyn_cast<CallInst>(&I))
+        if (auto *Callee = dyn_cast<Function>(CI->getCalledOperand())) {
+          auto It = UpgradedIntrinsics.find(Callee);
+          if (It != UpgradedIntrinsics.end())
+            ToUpgrade.push_back({CI, It->second});
+        }
+    for (auto [CI, NewFn] : ToUpgrade)
+      UpgradeIntrinsicCall(CI, NewFn);
   }
 
   // Finish fn->subprogram upgrade for materialized functions.
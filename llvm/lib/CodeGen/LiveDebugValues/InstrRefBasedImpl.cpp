@@ -84,6 +84,7 @@
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallSet.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/BinaryFormat/Dwarf.h"
 #include "llvm/CodeGen/LexicalScopes.h"
 #include "llvm/CodeGen/MachineBasicBlock.h"
@@ -120,6 +121,7 @@
 #include <climits>
 #include <cstdint>
 #include <functional>
+#include <limits>
 #include <queue>
 #include <tuple>
 #include <utility>
@@ -136,6 +138,9 @@ using namespace LiveDebugValues;
 #undef DEBUG_TYPE
 #define DEBUG_TYPE "livedebugvalues"
 
+STATISTIC(NumScopesSkipped, "Number of lexical scopes whose variable values "
+                            "were not solved, as they exceed the limits");
+
 // Act more like the VarLoc implementation, by propagating some locations too
 // far and ignoring some transfers.
 static cl::opt<bool> EmulateOldLDV("emulate-old-livedebugvalues", cl::Hidden,
@@ -3482,10 +3487,12 @@ void InstrRefBasedLDV::makeDepthFirstEjectionMap(
 bool InstrRefBasedLDV::depthFirstVLocAndEmit(
     unsigned MaxNumBlocks, const ScopeToDILocT &ScopeToDILocation,
     const ScopeToVarsT &ScopeToVars, ScopeToAssignBlocksT &ScopeToAssignBlocks,
-    LiveInsT &Output, FuncValueTable &MOutLocs, FuncValueTable &MInLocs,
+    const ScopeToAssignCountT &ScopeToAssignCount, LiveInsT &Output,
+    FuncValueTable &MOutLocs, FuncValueTable &MInLocs,
     SmallVectorImpl<VLocTracker> &AllTheVLocs, MachineFunction &MF,
     DenseMap<DebugVariable, unsigned> &AllVarsNumbering,
-    const TargetPassConfig &TPC) {
+    const TargetPassConfig &TPC, unsigned InputBBLimit,
+    unsigned InputDbgValLimit) {
   TTracker = new TransferTracker(TII, MTracker, MF, *TRI, CalleeSavedRegs, TPC);
   unsigned NumLocs = MTracker->getNumLocs();
   VTracker = nullptr;
@@ -3552,8 +3559,25 @@ bool InstrRefBasedLDV::depthFirstVLocAndEmit(
       auto &VarsWeCareAbout = ScopeToVars.find(WS)->second;
       auto &BlocksInScope = ScopeToAssignBlocks.find(WS)->second;
 
-      buildVLocValueMap(DILoc, VarsWeCareAbout, BlocksInScope, Output, MOutLocs,
-                        MInLocs, AllTheVLocs);
+      // If this scope has an extremely large number of variable assignments
+      // and blocks, don't solve it: its variables only get locations within
+      // the blocks they're assigned in. Other scopes are unaffected.
+      bool TooLarge = false;
+      if (ScopeToAssignCount.lookup(WS) > InputDbgValLimit) {
+        getBlocksForScope(DILoc, BlocksToExplore, BlocksInScope);
+        TooLarge = BlocksToExplore.size() > InputBBLimit;
+        BlocksToExplore.clear();
+      }
+
+      if (TooLarge) {
+        LLVM_DEBUG(dbgs() << "Skipping scope of " << VarsWeCareAbout.size()
+                          << " variables in " << MF.getName()
+                          << ": exceeds limits.\n");
+        ++NumScopesSkipped;
+      } else {
+        buildVLocValueMap(DILoc, VarsWeCareAbout, BlocksInScope, Output,
+                          MOutLocs, MInLocs, AllTheVLocs);
+      }
     }
 
     HighestDFSIn = std::max(HighestDFSIn, WS->getDFSIn());
@@ -3703,6 +3727,10 @@ bool InstrRefBasedLDV::ExtendRanges(MachineFunction &MF,
   // dataflow problem.
   buildMLocValueMap(MF, MInLocs, MOutLocs, MLocTransfer);
 
+  // The transfer function is not needed any more: release it before solving
+  // the variable value problem, which is where memory usage peaks.
+  MLocTransfer.clear();
+
   // Patch up debug phi numbers, turning unknown block-live-in values into
   // either live-through machine values, or PHIs.
   for (auto &DBG_PHI : DebugPHINumToValue) {
@@ -3751,6 +3779,9 @@ bool InstrRefBasedLDV::ExtendRanges(MachineFunction &MF,
   // Store map of DILocations that describes scopes.
   ScopeToDILocT ScopeToDILocation;
 
+  // Map from one lexical scope to the number of assignments in that scope.
+  ScopeToAssignCountT ScopeToAssignCount;
+
   // To mirror old LiveDebugValues, enumerate variables in RPOT order. Otherwise
   // the order is unimportant, it just has to be stable.
   unsigned VarAssignCount = 0;
@@ -3771,30 +3802,33 @@ bool InstrRefBasedLDV::ExtendRanges(MachineFunction &MF,
       ScopeToVars[Scope].insert(Var);
       ScopeToAssignBlocks[Scope].insert(VTracker->MBB);
       ScopeToDILocation[Scope] = ScopeLoc;
+      ++ScopeToAssignCount[Scope];
       ++VarAssignCount;
     }
   }
 
-  bool Changed = false;
-
   // If we have an extremely large number of variable assignments and blocks,
-  // bail out at this point. We've burnt some time doing analysis already,
-  // however we should cut our losses.
-  if ((unsigned)MaxNumBlocks > InputBBLimit &&
-      VarAssignCount > InputDbgValLimit) {
-    LLVM_DEBUG(dbgs() << "Disabling InstrRefBasedLDV: " << MF.getName()
+  // the limits are applied to each lexical scope rather than to the whole
+  // function: the scopes that exceed them are not solved, but the others
+  // still get variable locations. Within the limits, no scope is skipped.
+  if ((unsigned)MaxNumBlocks <= InputBBLimit ||
+      VarAssignCount <= InputDbgValLimit) {
+    InputBBLimit = std::numeric_limits<unsigned>::max();
+    InputDbgValLimit = std::numeric_limits<unsigned>::max();
+  } else {
+    LLVM_DEBUG(dbgs() << "Limiting InstrRefBasedLDV: " << MF.getName()
                       << " has " << MaxNumBlocks << " basic blocks and "
                       << VarAssignCount
                       << " variable assignments, exceeding limits.\n");
-  } else {
-    // Optionally, solve the variable value problem and emit to blocks by using
-    // a lexical-scope-depth search. It should be functionally identical to
-    // the "else" block of this condition.
-    Changed = depthFirstVLocAndEmit(
-        MaxNumBlocks, ScopeToDILocation, ScopeToVars, ScopeToAssignBlocks,
-        SavedLiveIns, MOutLocs, MInLocs, vlocs, MF, AllVarsNumbering, *TPC);
   }
 
+  // Solve the variable value problem and emit to blocks by using a
+  // lexical-scope-depth search.
+  bool Changed = depthFirstVLocAndEmit(
+      MaxNumBlocks, ScopeToDILocation, ScopeToVars, ScopeToAssignBlocks,
+      ScopeToAssignCount, SavedLiveIns, MOutLocs, MInLocs, vlocs, MF,
+      AllVarsNumbering, *TPC, InputBBLimit, InputDbgValLimit);
+
   delete MTracker;
   delete TTracker;
   MTracker = nullptr;
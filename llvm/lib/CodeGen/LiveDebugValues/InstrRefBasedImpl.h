@@ -1074,6 +1074,10 @@ public:
   /// just a block where an assignment happens.
   using ScopeToAssignBlocksT = DenseMap<const LexicalScope *, SmallPtrSet<MachineBasicBlock *, 4>>;
 
+  /// Mapping from lexical scopes to the number of variable assignments in that
+  /// scope, counting one for each variable assigned in each block.
+  using ScopeToAssignCountT = DenseMap<const LexicalScope *, unsigned>;
+
 private:
   MachineDominatorTree *DomTree;
   const TargetRegisterInfo *TRI;
@@ -1398,13 +1402,19 @@ private:
   /// block information can be fully computed before exploration finishes,
   /// allowing us to emit it and free data structures earlier than otherwise.
   /// It's also good for locality.
+  /// Scopes that span more than \p InputBBLimit blocks and have more than
+  /// \p InputDbgValLimit variable assignments are not solved, leaving their
+  /// variables with block-local locations only, so that one pathological scope
+  /// does not cost the locations of the whole function.
   bool depthFirstVLocAndEmit(
       unsigned MaxNumBlocks, const ScopeToDILocT &ScopeToDILocation,
       const ScopeToVarsT &ScopeToVars, ScopeToAssignBlocksT &ScopeToBlocks,
-      LiveInsT &Output, FuncValueTable &MOutLocs, FuncValueTable &MInLocs,
+      const ScopeToAssignCountT &ScopeToAssignCount, LiveInsT &Output,
+      FuncValueTable &MOutLocs, FuncValueTable &MInLocs,
       SmallVectorImpl<VLocTracker> &AllTheVLocs, MachineFunction &MF,
       DenseMap<DebugVariable, unsigned> &AllVarsNumbering,
-      const TargetPassConfig &TPC);
+      const TargetPassConfig &TPC, unsigned InputBBLimit,
+      unsigned InputDbgValLimit);
 
   bool ExtendRanges(MachineFunction &MF, MachineDominatorTree *DomTree,
                     TargetPassConfig *TPC, unsigned InputBBLimit,
@@ -48,7 +48,9 @@ static cl::opt<cl::boolOrDefault> ValueTrackingVariableLocations(
     cl::desc("Use experimental new value-tracking variable locations"));
 
 // Options to prevent pathological compile-time behavior. If InputBBLimit and
-// InputDbgValueLimit are both exceeded, range extension is disabled.
+// InputDbgValueLimit are both exceeded, range extension is disabled. The
+// instruction referencing implementation applies them to each lexical scope
+// instead, and only skips the scopes that exceed both.
 static cl::opt<unsigned> InputBBLimit(
     "livedebugvalues-input-bb-limit",
     cl::desc("Maximum input basic blocks before DBG_VALUE limit applies"),
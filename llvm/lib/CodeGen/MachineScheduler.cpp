@@ -74,6 +74,8 @@ using namespace llvm;
 #define DEBUG_TYPE "machine-scheduler"
 
 STATISTIC(NumClustered, "Number of load/store pairs clustered");
+STATISTIC(NumHugeRegionsSkipped,
+          "Number of regions left in source order because of their size");
 
 namespace llvm {
 
@@ -128,6 +130,14 @@ static cl::opt<unsigned> SchedOnlyBlock("misched-only-block", cl::Hidden,
 static cl::opt<unsigned> ReadyListLimit("misched-limit", cl::Hidden,
   cl::desc("Limit ready list to N instructions"), cl::init(256));
 
+/// Building the dependence graph is superlinear in the size of the region, so
+/// give huge regions (e.g. fully unrolled loops) a way out.
+static cl::opt<unsigned> MaxRegionInstrs(
+    "misched-max-region-instrs", cl::Hidden,
+    cl::desc("Leave regions with more than N instructions in source order "
+             "(0 = no limit)"),
+    cl::init(0));
+
 static cl::opt<bool> EnableRegPressure("misched-regpressure", cl::Hidden,
   cl::desc("Enable register pressure scheduling."), cl::init(true));
 
@@ -600,6 +610,14 @@ void MachineSchedulerBase::scheduleRegions(ScheduleDAGInstrs &Scheduler,
         Scheduler.exitRegion();
         continue;
       }
+      if (MaxRegionInstrs && NumRegionInstrs > MaxRegionInstrs) {
+        LLVM_DEBUG(dbgs() << "Skipping huge region in " << MF->getName()
+                          << ":" << printMBBReference(*MBB) << " with "
+                          << NumRegionInstrs << " instructions\n");
+        ++NumHugeRegionsSkipped;
+        Scheduler.exitRegion();
+        continue;
+      }
       LLVM_DEBUG(dbgs() << "********** MI Scheduling **********\n");
       LLVM_DEBUG(dbgs() << MF->getName() << ":" << printMBBReference(*MBB)
                         << " " << MBB->getName() << "\n  From: " << *I
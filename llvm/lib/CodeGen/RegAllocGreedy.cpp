@@ -82,6 +82,8 @@ using namespace llvm;
 STATISTIC(NumGlobalSplits, "Number of split global live ranges");
 STATISTIC(NumLocalSplits,  "Number of split local live ranges");
 STATISTIC(NumEvicted,      "Number of interferences evicted");
+STATISTIC(NumRegionSplitBudgetExceeded,
+          "Number of functions that exceeded the region split budget");
 
 static cl::opt<SplitEditor::ComplementSpillMode> SplitSpillMode(
     "split-spill-mode", cl::Hidden,
@@ -128,6 +130,13 @@ static cl::opt<unsigned long> GrowRegionComplexityBudget(
              "limit its budget and bail out once we reach the limit."),
     cl::init(10000), cl::Hidden);
 
+static cl::opt<unsigned long> RegionSplitBudget(
+    "greedy-region-split-budget",
+    cl::desc("Maximum number of region split candidates evaluated per "
+             "function before falling back to per-block splitting "
+             "(0 = unlimited)"),
+    cl::init(0), cl::Hidden);
+
 static cl::opt<bool> GreedyRegClassPriorityTrumpsGlobalness(
     "greedy-regclass-priority-trumps-globalness",
     cl::desc("Change the greedy register allocator's live range priority "
@@ -1103,6 +1112,7 @@ unsigned RAGreedy::calculateRegionSplitCost(const LiveInterval &VirtReg,
       GlobalCand.resize(NumCands+1);
     GlobalSplitCandidate &Cand = GlobalCand[NumCands];
     Cand.reset(IntfCache, PhysReg);
+    ++NumRegionSplitCandsTried;
 
     SpillPlacer->prepare(Cand.LiveBundles);
     BlockFrequency Cost;
@@ -1723,8 +1733,15 @@ unsigned RAGreedy::trySplit(const LiveInterval &VirtReg, AllocationOrder &Order,
   // First try to split around a region spanning multiple blocks. RS_Split2
   // ranges already made dubious progress with region splitting, so they go
   // straight to single block splitting.
-  if (ExtraInfo->getStage(VirtReg) < RS_Split2) {
+  // Once a huge function has used up its region split budget, the remaining
+  // ranges only get the much cheaper per-block splitting.
+  if (ExtraInfo->getStage(VirtReg) < RS_Split2 &&
+      (!RegionSplitBudget || NumRegionSplitCandsTried < RegionSplitBudget)) {
     MCRegister PhysReg = tryRegionSplit(VirtReg, Order, NewVRegs);
+    if (RegionSplitBudget && NumRegionSplitCandsTried >= RegionSplitBudget) {
+      LLVM_DEBUG(dbgs() << "Region split budget exceeded.\n");
+      ++NumRegionSplitBudgetExceeded;
+    }
     if (PhysReg || !NewVRegs.empty())
       return PhysReg;
   }
@@ -2659,6 +2676,7 @@ bool RAGreedy::runOnMachineFunction(MachineFunction &mf) {
   IntfCache.init(MF, Matrix->getLiveUnions(), Indexes, LIS, TRI);
   GlobalCand.resize(32);  // This will grow as needed.
   SetOfBrokenHints.clear();
+  NumRegionSplitCandsTried = 0;
 
   allocatePhysRegs();
   tryHintsRecoloring();
@@ -272,6 +272,10 @@ private:
   /// Set of broken hints that may be reconciled later because of eviction.
   SmallSetVector<const LiveInterval *, 8> SetOfBrokenHints;
 
+  /// Number of region split candidates evaluated so far in this function,
+  /// checked against -greedy-region-split-budget.
+  unsigned long NumRegionSplitCandsTried = 0;
+
   /// The register cost values. This list will be recreated for each Machine
   /// Function
   ArrayRef<uint8_t> RegCosts;
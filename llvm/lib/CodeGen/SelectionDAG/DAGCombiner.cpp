@@ -27,6 +27,7 @@
 #include "llvm/ADT/SmallSet.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/Statistic.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/Analysis/AliasAnalysis.h"
 #include "llvm/Analysis/MemoryLocation.h"
 #include "llvm/Analysis/TargetLibraryInfo.h"
@@ -56,14 +57,18 @@
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/Format.h"
 #include "llvm/Support/KnownBits.h"
 #include "llvm/Support/MachineValueType.h"
+#include "llvm/Support/ManagedStatic.h"
 #include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Mutex.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Target/TargetMachine.h"
 #include "llvm/Target/TargetOptions.h"
 #include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cstdint>
 #include <functional>
 #include <iterator>
@@ -140,6 +145,65 @@ static cl::opt<bool> EnableVectorFCopySignExtendRound(
     cl::desc(
         "Enable merging extends and rounds into FCOPYSIGN on vector types"));
 
+static cl::opt<bool> ReportOpcodeStats(
+    "combiner-report-opcode-stats", cl::Hidden,
+    cl::desc("Report the number of visits, successful combines and time "
+             "spent per opcode in the DAG combiner at exit"));
+
+namespace {
+
+struct OpcodeCombineStats {
+  uint64_t Visits = 0;
+  uint64_t Combines = 0;
+  std::chrono::nanoseconds Time{0};
+};
+
+/// Accumulates the -combiner-report-opcode-stats numbers of every DAGCombiner
+/// run and prints them when llvm_shutdown destroys it.
+class CombineStatsReporter {
+  sys::SmartMutex<true> Lock;
+  StringMap<OpcodeCombineStats> Stats;
+
+public:
+  void merge(const StringMap<OpcodeCombineStats> &RunStats) {
+    sys::SmartScopedLock<true> Guard(Lock);
+    for (const auto &Entry : RunStats) {
+      OpcodeCombineStats &Total = Stats[Entry.getKey()];
+      Total.Visits += Entry.getValue().Visits;
+      Total.Combines += Entry.getValue().Combines;
+      Total.Time += Entry.getValue().Time;
+    }
+  }
+
+  ~CombineStatsReporter() {
+    if (Stats.empty())
+      return;
+    std::vector<const StringMapEntry<OpcodeCombineStats> *> Sorted;
+    for (const auto &Entry : Stats)
+      Sorted.push_back(&Entry);
+    llvm::sort(Sorted, [](const auto *LHS, const auto *RHS) {
+      return LHS->getValue().Time > RHS->getValue().Time;
+    });
+
+    std::unique_ptr<raw_ostream> OS = CreateInfoOutputFile();
+    *OS << "===" << std::string(73, '-') << "===\n"
+        << "                        DAG combiner statistics by opcode\n"
+        << "===" << std::string(73, '-') << "===\n";
+    *OS << "      Visits     Combines    Time (ms)  Opcode\n";
+    for (const auto *Entry : Sorted) {
+      const OpcodeCombineStats &S = Entry->getValue();
+      *OS << format("%12" PRIu64 " %12" PRIu64 " %12.3f  ", S.Visits,
+                    S.Combines, S.Time.count() / 1e6)
+          << Entry->getKey() << '\n';
+    }
+    OS->flush();
+  }
+};
+
+} // end anonymous namespace
+
+static ManagedStatic<CombineStatsReporter> CombineStats;
+
 namespace {
 
   class DAGCombiner {
@@ -1742,6 +1806,8 @@ void DAGCombiner::Run(CombineLevel AtLevel) {
   for (SDNode &Node : DAG.allnodes())
     AddToWorklist(&Node);
 
+  StringMap<OpcodeCombineStats> RunStats;
+
   // Create a dummy node (which is not added to allnodes), that adds a reference
   // to the root node, preventing it from being deleted, and tracking any
   // changes of the root.
@@ -1780,7 +1846,19 @@ void DAGCombiner::Run(CombineLevel AtLevel) {
       if (!CombinedNodes.count(ChildN.getNode()))
         AddToWorklist(ChildN.getNode());
 
-    SDValue RV = combine(N);
+    SDValue RV;
+    if (ReportOpcodeStats) {
+      // Look up the entry first: combine() may delete N.
+      OpcodeCombineStats &S = RunStats[N->getOperationName(&DAG)];
+      auto Start = std::chrono::steady_clock::now();
+      RV = combine(N);
+      S.Time += std::chrono::steady_clock::now() - Start;
+      ++S.Visits;
+      if (RV.getNode())
+        ++S.Combines;
+    } else {
+      RV = combine(N);
+    }
 
     if (!RV.getNode())
       continue;
@@ -1825,6 +1903,9 @@ void DAGCombiner::Run(CombineLevel AtLevel) {
     recursivelyDeleteUnusedNodes(N);
   }
 
+  if (!RunStats.empty())
+    CombineStats->merge(RunStats);
+
   // If the root changed (e.g. it was a dead load, update the root).
   DAG.setRoot(Dummy.getValue());
   DAG.RemoveDeadNodes();
@@ -1390,8 +1390,15 @@ SDNode *SelectionDAG::FindNodeOrInsertPos(const FoldingSetNodeID &ID,
 
 void SelectionDAG::clear() {
   allnodes_clear();
-  OperandRecycler.clear(OperandAllocator);
-  OperandAllocator.Reset();
+  // Nodes are recycled by NodeAllocator and CSEMap keeps its buckets, so keep
+  // the operand arrays warm for the next block too. They are all back in
+  // OperandRecycler at this point. Shuffle masks are never recycled, so
+  // release everything once the pool has grown past what a typical block
+  // needs.
+  if (OperandAllocator.getTotalMemory() > MaxRetainedOperandMemory) {
+    OperandRecycler.clear(OperandAllocator);
+    OperandAllocator.Reset();
+  }
   CSEMap.clear();
 
   ExtendedValueTypeNodes.clear();
@@ -581,12 +581,11 @@ Error write(MCStreamer &Out, ArrayRef<std::string> Inputs) {
 
   DWPStringPool Strings(Out, StrSection);
 
-  SmallVector<OwningBinary<object::ObjectFile>, 128> Objects;
-  Objects.reserve(Inputs.size());
-
-  std::deque<SmallString<32>> UncompressedSections;
-
   for (const auto &Input : Inputs) {
+    // Everything read from an input is copied to the streamer or the string
+    // pool, so the object and its decompressed sections only live for one
+    // iteration. This keeps memory bounded by the output rather than by the
+    // sum of all inputs.
     auto ErrOrObj = object::ObjectFile::createObjectFile(Input);
     if (!ErrOrObj) {
       return handleErrors(ErrOrObj.takeError(),
@@ -596,7 +595,7 @@ Error write(MCStreamer &Out, ArrayRef<std::string> Inputs) {
     }
 
     auto &Obj = *ErrOrObj->getBinary();
-    Objects.push_back(std::move(*ErrOrObj));
+    std::deque<SmallString<32>> UncompressedSections;
 
     UnitIndexEntry CurEntry = {};
 
@@ -10,11 +10,14 @@
 #include "llvm/DebugInfo/GSYM/Header.h"
 #include "llvm/DebugInfo/GSYM/LineTable.h"
 #include "llvm/MC/StringTableBuilder.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include <algorithm>
 #include <cassert>
 #include <functional>
+#include <numeric>
+#include <optional>
 #include <vector>
 
 using namespace llvm;
@@ -147,13 +150,45 @@ llvm::Error GsymCreator::encode(FileWriter &O) const {
   StrTab.write(O.get_stream());
   const off_t StrtabSize = O.tell() - StrtabOffset;
   std::vector<uint32_t> AddrInfoOffsets;
-
-  // Write out the address infos for each function info.
-  for (const auto &FuncInfo : Funcs) {
-    if (Expected<uint64_t> OffsetOrErr = FuncInfo.encode(O))
-      AddrInfoOffsets.push_back(OffsetOrErr.get());
-    else
-      return OffsetOrErr.takeError();
+  AddrInfoOffsets.reserve(Funcs.size());
+
+  // Write out the address infos for each function info. They are encoded in
+  // parallel into separate buffers, one batch at a time to bound the memory
+  // used, and then written in order. Each buffer starts at an offset aligned
+  // like the FunctionInfo data, so the bytes are the same as when encoding
+  // into the final stream.
+  constexpr size_t BatchSize = 4096;
+  const size_t NumBuffers = std::min(BatchSize, Funcs.size());
+  std::vector<SmallVector<char, 0>> Buffers(NumBuffers);
+  std::vector<std::optional<llvm::Error>> Errors(NumBuffers);
+  for (size_t Begin = 0, End; Begin < Funcs.size(); Begin = End) {
+    End = std::min(Begin + BatchSize, Funcs.size());
+    parallelFor(Begin, End, [&](size_t I) {
+      SmallVector<char, 0> &Buffer = Buffers[I - Begin];
+      Buffer.clear();
+      raw_svector_ostream BufferOS(Buffer);
+      FileWriter BufferWriter(BufferOS, O.getByteOrder());
+      Expected<uint64_t> OffsetOrErr = Funcs[I].encode(BufferWriter);
+      if (!OffsetOrErr)
+        Errors[I - Begin] = OffsetOrErr.takeError();
+      else
+        assert(*OffsetOrErr == 0 && "FunctionInfo data must start the buffer");
+    });
+    for (size_t I = Begin; I < End; ++I) {
+      if (std::optional<llvm::Error> &Err = Errors[I - Begin]) {
+        // Report the first error, and ignore the ones after it.
+        llvm::Error FirstErr = std::move(*Err);
+        for (size_t J = I + 1; J < End; ++J)
+          if (Errors[J - Begin])
+            consumeError(std::move(*Errors[J - Begin]));
+        return FirstErr;
+      }
+      const SmallVector<char, 0> &Buffer = Buffers[I - Begin];
+      O.alignTo(4);
+      AddrInfoOffsets.push_back(O.tell());
+      O.writeData(ArrayRef(reinterpret_cast<const uint8_t *>(Buffer.data()),
+                           Buffer.size()));
+    }
   }
   // Fixup the string table offset and size in the header
   O.fixup32((uint32_t)StrtabOffset, offsetof(Header, StrtabOffset));
@@ -194,8 +229,25 @@ llvm::Error GsymCreator::finalize(llvm::raw_ostream &OS) {
     return createStringError(std::errc::invalid_argument, "already finalized");
   Finalized = true;
 
-  // Sort function infos so we can emit sorted functions.
-  llvm::sort(Funcs);
+  // Sort function infos so we can emit sorted functions. FunctionInfos that
+  // have the same range and line table but different names or inline trees
+  // compare equal, and the de-duplication below keeps whichever of them sorts
+  // first. They are kept in the order they were added, so that the sorted
+  // order is the same whatever the number of threads.
+  std::vector<size_t> Order(Funcs.size());
+  std::iota(Order.begin(), Order.end(), 0);
+  parallelSort(Order, [&](size_t LHS, size_t RHS) {
+    if (Funcs[LHS] < Funcs[RHS])
+      return true;
+    if (Funcs[RHS] < Funcs[LHS])
+      return false;
+    return LHS < RHS;
+  });
+  std::vector<FunctionInfo> SortedFuncs;
+  SortedFuncs.reserve(Funcs.size());
+  for (size_t Index : Order)
+    SortedFuncs.push_back(std::move(Funcs[Index]));
+  Funcs = std::move(SortedFuncs);
 
   // Don't let the string table indexes change by finalizing in order.
   StrTab.finalizeInOrder();
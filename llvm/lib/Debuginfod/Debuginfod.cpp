@@ -24,6 +24,7 @@
 #include "llvm/Debuginfod/Debuginfod.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/StringSet.h"
 #include "llvm/BinaryFormat/Magic.h"
 #include "llvm/DebugInfo/DWARF/DWARFContext.h"
 #include "llvm/DebugInfo/Symbolize/Symbolize.h"
@@ -41,6 +42,7 @@
 #include "llvm/Support/xxhash.h"
 
 #include <atomic>
+#include <mutex>
 #include <thread>
 
 namespace llvm {
@@ -120,6 +122,35 @@ Expected<std::string> getCachedOrDownloadDebuginfo(BuildIDRef ID) {
   return getCachedOrDownloadArtifact(uniqueKey(UrlPath), UrlPath);
 }
 
+Error prefetchDebuginfo(ArrayRef<object::BuildID> IDs, unsigned Parallelism) {
+  std::mutex ErrMutex;
+  Error Err = Error::success();
+  StringSet<> Seen;
+  ThreadPool Pool(hardware_concurrency(Parallelism));
+  for (BuildIDRef ID : IDs) {
+    if (!Seen.insert(buildIDToString(ID)).second)
+      continue;
+    Pool.async([&, ID] {
+      Expected<std::string> PathOrErr = getCachedOrDownloadDebuginfo(ID);
+      if (PathOrErr)
+        return;
+      Error E = handleErrors(
+          PathOrErr.takeError(), [](const StringError &SE) -> Error {
+            if (SE.convertToErrorCode() == errc::argument_out_of_domain)
+              return Error::success();
+            return createStringError(SE.convertToErrorCode(),
+                                     SE.getMessage());
+          });
+      if (!E)
+        return;
+      std::lock_guard<std::mutex> Guard(ErrMutex);
+      Err = joinErrors(std::move(Err), std::move(E));
+    });
+  }
+  Pool.wait();
+  return Err;
+}
+
 // General fetching function.
 Expected<std::string> getCachedOrDownloadArtifact(StringRef UniqueKey,
                                                   StringRef UrlPath) {
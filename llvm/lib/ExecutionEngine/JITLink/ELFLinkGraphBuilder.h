@@ -194,6 +194,12 @@ Expected<std::unique_ptr<LinkGraph>> ELFLinkGraphBuilder<ELFT>::buildGraph() {
   if (auto Err = prepare())
     return std::move(Err);
 
+  // FIXME: Graph building is serial. Sections and their relocations could be
+  //        graphified in parallel, but blocks, symbols and edges are all
+  //        allocated from the LinkGraph's single BumpPtrAllocator and
+  //        registered in shared maps (GraphBlocks, GraphSymbols), which would
+  //        first need per-thread allocation and a deterministic merge.
+  //        Fixup application (JITLinker::fixUpBlocks) is already parallel.
   if (auto Err = graphifySections())
     return std::move(Err);
 
@@ -15,6 +15,9 @@
 
 #include "llvm/ADT/DenseSet.h"
 #include "llvm/ExecutionEngine/JITLink/JITLink.h"
+#include "llvm/Support/Parallel.h"
+
+#include <mutex>
 
 #define DEBUG_TYPE "jitlink"
 
@@ -123,31 +126,80 @@ private:
   Error fixUpBlocks(LinkGraph &G) const override {
     LLVM_DEBUG(dbgs() << "Fixing up blocks:\n");
 
+    // Each fixup only writes to its own location in its own block, so fixups
+    // can be applied in parallel. Split the work into chunks of at most
+    // FixUpChunkSize edges; large blocks (e.g. a .text section that wasn't
+    // split by -ffunction-sections) are split across chunks.
+    struct FixUpChunk {
+      Block *B;
+      size_t Begin, End;
+    };
+    std::vector<FixUpChunk> Chunks;
+    size_t NumEdges = 0;
     for (auto *B : G.blocks()) {
-      LLVM_DEBUG(dbgs() << "  " << *B << ":\n");
-
-      // Copy Block data and apply fixups.
-      LLVM_DEBUG(dbgs() << "    Applying fixups.\n");
       assert((!B->isZeroFill() || all_of(B->edges(),
                                          [](const Edge &E) {
                                            return E.getKind() ==
                                                   Edge::KeepAlive;
                                          })) &&
              "Non-KeepAlive edges in zero-fill block?");
-      for (auto &E : B->edges()) {
+      for (size_t I = 0, E = B->edges_size(); I < E; I += FixUpChunkSize)
+        Chunks.push_back({B, I, std::min(I + FixUpChunkSize, E)});
+      NumEdges += B->edges_size();
+    }
 
+    auto ApplyFixups = [&](const FixUpChunk &C) -> Error {
+      for (auto &E : make_range(C.B->edges().begin() + C.Begin,
+                                C.B->edges().begin() + C.End)) {
         // Skip non-relocation edges.
         if (!E.isRelocation())
           continue;
 
         // Dispatch to LinkerImpl for fixup.
-        if (auto Err = impl().applyFixup(G, *B, E))
+        if (auto Err = impl().applyFixup(G, *C.B, E))
+          return Err;
+      }
+      return Error::success();
+    };
+
+    // Small graphs aren't worth the scheduling overhead, and debug output
+    // should stay in order.
+    bool Parallel = NumEdges >= ParallelFixUpThreshold;
+    LLVM_DEBUG(Parallel = false);
+    if (!Parallel) {
+      for (auto &C : Chunks) {
+        LLVM_DEBUG({
+          if (C.Begin == 0)
+            dbgs() << "  " << *C.B << ":\n    Applying fixups.\n";
+        });
+        if (auto Err = ApplyFixups(C))
           return Err;
       }
+      return Error::success();
     }
 
-    return Error::success();
+    // Report the error from the first failing chunk, so that the result does
+    // not depend on scheduling.
+    std::mutex ErrMutex;
+    size_t FirstFailed = Chunks.size();
+    Error FirstErr = Error::success();
+    parallelFor(0, Chunks.size(), [&](size_t I) {
+      if (auto Err = ApplyFixups(Chunks[I])) {
+        std::lock_guard<std::mutex> Lock(ErrMutex);
+        if (I < FirstFailed) {
+          consumeError(std::move(FirstErr));
+          FirstErr = std::move(Err);
+          FirstFailed = I;
+        } else
+          consumeError(std::move(Err));
+      }
+    });
+    return FirstErr;
   }
+
+private:
+  static constexpr size_t FixUpChunkSize = 4096;
+  static constexpr size_t ParallelFixUpThreshold = 4 * FixUpChunkSize;
 };
 
 /// Removes dead symbols/blocks/addressables.
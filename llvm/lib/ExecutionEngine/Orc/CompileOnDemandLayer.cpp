@@ -9,9 +9,11 @@
 #include "llvm/ExecutionEngine/Orc/CompileOnDemandLayer.h"
 #include "llvm/ADT/Hashing.h"
 #include "llvm/ExecutionEngine/Orc/ExecutionUtils.h"
+#include "llvm/IR/IRBuilder.h"
 #include "llvm/IR/Mangler.h"
 #include "llvm/IR/Module.h"
 #include "llvm/Support/FormatVariadic.h"
+#include "llvm/Transforms/Utils/BasicBlockUtils.h"
 #include <string>
 
 using namespace llvm;
@@ -119,6 +121,11 @@ CompileOnDemandLayer::CompileOnDemandLayer(
       LCTMgr(LCTMgr),
       BuildIndirectStubsManager(std::move(BuildIndirectStubsManager)) {}
 
+CompileOnDemandLayer::~CompileOnDemandLayer() {
+  if (TierUpLayer)
+    getExecutionSession().deregisterResourceManager(*this);
+}
+
 void CompileOnDemandLayer::setPartitionFunction(PartitionFunction Partition) {
   this->Partition = std::move(Partition);
 }
@@ -126,6 +133,16 @@ void CompileOnDemandLayer::setPartitionFunction(PartitionFunction Partition) {
 void CompileOnDemandLayer::setImplMap(ImplSymbolMap *Imp) {
   this->AliaseeImpls = Imp;
 }
+
+void CompileOnDemandLayer::setTierUpLayer(IRLayer &TierUpLayer,
+                                          uint64_t Threshold) {
+  assert(Threshold > 0 && "Tier-up threshold must be non-zero");
+  if (!this->TierUpLayer)
+    getExecutionSession().registerResourceManager(*this);
+  this->TierUpLayer = &TierUpLayer;
+  this->TierUpThreshold = Threshold;
+}
+
 void CompileOnDemandLayer::emit(
     std::unique_ptr<MaterializationResponsibility> R, ThreadSafeModule TSM) {
   assert(TSM && "Null module");
@@ -375,8 +392,182 @@ void CompileOnDemandLayer::emitPartition(
     R->failMaterialization();
     return;
   }
+
+  if (TierUpLayer)
+    prepareTierUp(*R, *ExtractedTSM);
+
   BaseLayer.emit(std::move(R), std::move(*ExtractedTSM));
 }
 
+void CompileOnDemandLayer::prepareTierUp(MaterializationResponsibility &R,
+                                         ThreadSafeModule &TSM) {
+  bool CanTierUp = TSM.withModuleDo([](Module &M) {
+    return M.alias_empty() && M.ifunc_empty() &&
+           llvm::all_of(M.globals(), [](const GlobalVariable &G) {
+             return G.isDeclaration();
+           });
+  });
+  if (!CanTierUp)
+    return;
+
+  // Keep an uninstrumented copy for the tier-up layer, owned by the tracker
+  // of the partition. If the tracker has already been removed, the partition
+  // is not tiered up.
+  uint64_t Id = 0;
+  ThreadSafeModule Clone = cloneToNewContext(TSM);
+  if (auto Err = R.withResourceKeyDo([&](ResourceKey K) {
+        std::lock_guard<std::mutex> Lock(CODLayerMutex);
+        Id = NextTierUpId++;
+        TierUpPartitions[Id] = {&R.getTargetJITDylib(), K, std::move(Clone)};
+      })) {
+    consumeError(std::move(Err));
+    return;
+  }
+
+  // Count calls on entry to every function, and call back into this layer
+  // when the count reaches the threshold:
+  //
+  //   %count = atomicrmw add ptr @f.tierup.count, i64 1 monotonic
+  //   %tierup = icmp eq i64 %count, <Threshold - 1>
+  //   br i1 %tierup, label %call.tierup, label %rest.of.entry
+  TSM.withModuleDo([&](Module &M) {
+    auto &Ctx = M.getContext();
+    auto *Int64Ty = Type::getInt64Ty(Ctx);
+    auto *PtrTy = PointerType::getUnqual(Ctx);
+    auto *CallbackTy =
+        FunctionType::get(Type::getVoidTy(Ctx), {PtrTy, Int64Ty}, false);
+    auto *Callback = ConstantExpr::getIntToPtr(
+        ConstantInt::get(Int64Ty, pointerToJITTargetAddress(&tierUpCallback)),
+        PtrTy);
+    auto *Self = ConstantExpr::getIntToPtr(
+        ConstantInt::get(Int64Ty, pointerToJITTargetAddress(this)), PtrTy);
+
+    for (auto &F : M) {
+      if (F.isDeclaration())
+        continue;
+
+      auto *Counter = new GlobalVariable(
+          M, Int64Ty, false, GlobalValue::InternalLinkage,
+          ConstantInt::get(Int64Ty, 0), F.getName() + ".tierup.count");
+
+      // Leave static allocas at the start of the entry block.
+      BasicBlock &Entry = F.getEntryBlock();
+      auto InsertPt = Entry.getFirstInsertionPt();
+      while (isa<AllocaInst>(*InsertPt))
+        ++InsertPt;
+
+      IRBuilder<> B(&*InsertPt);
+      auto *Count = B.CreateAtomicRMW(AtomicRMWInst::Add, Counter,
+                                      B.getInt64(1), MaybeAlign(),
+                                      AtomicOrdering::Monotonic);
+      auto *ReachedThreshold =
+          B.CreateICmpEQ(Count, B.getInt64(TierUpThreshold - 1));
+      auto *ThenTerm =
+          SplitBlockAndInsertIfThen(ReachedThreshold, &*InsertPt, false);
+      IRBuilder<>(ThenTerm).CreateCall(CallbackTy, Callback,
+                                       {Self, B.getInt64(Id)});
+    }
+  });
+}
+
+void CompileOnDemandLayer::tierUpCallback(void *Self, uint64_t Id) {
+  static_cast<CompileOnDemandLayer *>(Self)->tierUp(Id);
+}
+
+void CompileOnDemandLayer::tierUp(uint64_t Id) {
+  auto &ES = getExecutionSession();
+
+  PerDylibResources *PDR = nullptr;
+  JITDylib *OptD = nullptr;
+  ThreadSafeModule TSM;
+  {
+    std::lock_guard<std::mutex> Lock(CODLayerMutex);
+
+    // Another function of the same partition may have got here first.
+    auto I = TierUpPartitions.find(Id);
+    if (I == TierUpPartitions.end())
+      return;
+    JITDylib &ImplD = *I->second.ImplD;
+    TSM = std::move(I->second.TSM);
+    TierUpPartitions.erase(I);
+
+    for (auto &KV : DylibResources) {
+      if (&KV.second.getImplDylib() != &ImplD)
+        continue;
+      PDR = &KV.second;
+      if (!PDR->getOptDylib()) {
+        // Optimized definitions are found first, then everything the
+        // implementation dylib can see.
+        auto &D = ES.createBareJITDylib(KV.first->getName() + ".opt");
+        ImplD.withLinkOrderDo([&](const JITDylibSearchOrder &ImplLinkOrder) {
+          D.setLinkOrder(ImplLinkOrder);
+        });
+        PDR->setOptDylib(D);
+      }
+      OptD = PDR->getOptDylib();
+      break;
+    }
+  }
+  assert(PDR && OptD && "Tier-up partition from an unknown dylib");
+
+  SymbolLookupSet Symbols;
+  TSM.withModuleDo([&](Module &M) {
+    MangleAndInterner Mangle(ES, M.getDataLayout());
+    for (auto &F : M)
+      if (!F.isDeclaration() && !F.hasLocalLinkage())
+        Symbols.add(Mangle(F.getName()));
+  });
+
+  if (auto Err = TierUpLayer->add(*OptD, std::move(TSM))) {
+    ES.reportError(std::move(Err));
+    return;
+  }
+
+  // Looking the definitions up compiles them. Once they are ready, repoint
+  // the stubs; symbols without a stub (e.g. promoted locals) are only called
+  // from within the partition.
+  ES.lookup(
+      LookupKind::Static,
+      makeJITDylibSearchOrder(OptD, JITDylibLookupFlags::MatchAllSymbols),
+      std::move(Symbols), SymbolState::Ready,
+      [&ES, PDR](Expected<SymbolMap> Result) {
+        if (!Result) {
+          ES.reportError(Result.takeError());
+          return;
+        }
+        auto &ISMgr = PDR->getISManager();
+        for (auto &KV : *Result) {
+          if (!ISMgr.findStub(*KV.first, false))
+            continue;
+          if (auto Err = ISMgr.updatePointer(*KV.first, KV.second.getAddress()))
+            ES.reportError(std::move(Err));
+        }
+      },
+      NoDependenciesToRegister);
+}
+
+Error CompileOnDemandLayer::handleRemoveResources(JITDylib &JD,
+                                                  ResourceKey K) {
+  // Free the copies of the partitions that were not tiered up yet. Their
+  // counters can't reach the callback anymore, as their code is removed too.
+  std::lock_guard<std::mutex> Lock(CODLayerMutex);
+  for (auto I = TierUpPartitions.begin(); I != TierUpPartitions.end();) {
+    if (I->second.Key == K)
+      I = TierUpPartitions.erase(I);
+    else
+      ++I;
+  }
+  return Error::success();
+}
+
+void CompileOnDemandLayer::handleTransferResources(JITDylib &JD,
+                                                   ResourceKey DstK,
+                                                   ResourceKey SrcK) {
+  std::lock_guard<std::mutex> Lock(CODLayerMutex);
+  for (auto &KV : TierUpPartitions)
+    if (KV.second.Key == SrcK)
+      KV.second.Key = DstK;
+}
+
 } // end namespace orc
 } // end namespace llvm
@@ -9,6 +9,9 @@
 #include "llvm/ExecutionEngine/Orc/CompileUtils.h"
 
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/Config/llvm-config.h"
 #include "llvm/ExecutionEngine/ObjectCache.h"
 #include "llvm/IR/LegacyPassManager.h"
 #include "llvm/IR/Module.h"
@@ -17,6 +20,7 @@
 #include "llvm/Support/Error.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/SHA1.h"
 #include "llvm/Support/SmallVectorMemoryBuffer.h"
 #include "llvm/Target/TargetMachine.h"
 
@@ -92,5 +96,112 @@ ConcurrentIRCompiler::operator()(Module &M) {
   return C(M);
 }
 
+Expected<std::unique_ptr<CachingIRCompiler>> CachingIRCompiler::Create(
+    std::unique_ptr<IRCompileLayer::IRCompiler> BaseCompiler,
+    const JITTargetMachineBuilder &JTMB, const Twine &CacheDir) {
+  // Everything in the target description that changes the generated code
+  // has to be part of the key.
+  std::string TargetKey;
+  raw_string_ostream OS(TargetKey);
+  const TargetOptions &Opts = JTMB.getOptions();
+  OS << LLVM_VERSION_STRING << ';' << JTMB.getTargetTriple().str() << ';'
+     << JTMB.getCPU() << ';' << JTMB.getFeatures().getString() << ';'
+     << static_cast<int>(JTMB.getCodeGenOptLevel()) << ';'
+     << (JTMB.getRelocationModel() ? int(*JTMB.getRelocationModel()) : -1)
+     << ';' << (JTMB.getCodeModel() ? int(*JTMB.getCodeModel()) : -1) << ';'
+     << int(Opts.FloatABIType) << ';' << int(Opts.AllowFPOpFusion) << ';'
+     << int(Opts.ExceptionModel) << ';' << int(Opts.ThreadModel) << ';'
+     << Opts.UnsafeFPMath << Opts.NoInfsFPMath << Opts.NoNaNsFPMath
+     << Opts.NoSignedZerosFPMath << Opts.ApproxFuncFPMath
+     << Opts.GuaranteedTailCallOpt << Opts.EnableFastISel
+     << Opts.EnableGlobalISel << Opts.UseInitArray << Opts.FunctionSections
+     << Opts.DataSections << Opts.UniqueSectionNames << Opts.TrapUnreachable
+     << Opts.EmulatedTLS << Opts.EnableIPRA << Opts.EnableMachineOutliner
+     << Opts.RelaxELFRelocations;
+  OS.flush();
+
+  std::unique_ptr<CachingIRCompiler> C(
+      new CachingIRCompiler(std::move(BaseCompiler), std::move(TargetKey)));
+  if (auto Err = C->setCacheDirectory(CacheDir))
+    return std::move(Err);
+  return std::move(C);
+}
+
+CachingIRCompiler::CachingIRCompiler(
+    std::unique_ptr<IRCompileLayer::IRCompiler> BaseCompiler,
+    std::string TargetKey)
+    : IRCompiler(BaseCompiler->getManglingOptions()),
+      BaseCompiler(std::move(BaseCompiler)), TargetKey(std::move(TargetKey)) {}
+
+Error CachingIRCompiler::setCacheDirectory(const Twine &CacheDir) {
+  auto AddBuffer = [this](unsigned Task, const Twine &ModuleName,
+                          std::unique_ptr<MemoryBuffer> MB) {
+    std::lock_guard<std::mutex> Lock(BuffersMutex);
+    Buffers[Task] = std::move(MB);
+  };
+  auto CacheOrErr = localCache("ORCObjectCache", "orc-cache", CacheDir,
+                               std::move(AddBuffer));
+  if (!CacheOrErr)
+    return CacheOrErr.takeError();
+  Cache = std::move(*CacheOrErr);
+  return Error::success();
+}
+
+std::string CachingIRCompiler::getKey(Module &M) const {
+  SmallVector<char, 0> Bitcode;
+  {
+    raw_svector_ostream BCOS(Bitcode);
+    WriteBitcodeToFile(M, BCOS);
+  }
+
+  SHA1 Hasher;
+  Hasher.update(TargetKey);
+  Hasher.update(StringRef(Bitcode.data(), Bitcode.size()));
+  return toHex(Hasher.result());
+}
+
+std::unique_ptr<MemoryBuffer> CachingIRCompiler::takeBuffer(unsigned Task) {
+  std::lock_guard<std::mutex> Lock(BuffersMutex);
+  auto I = Buffers.find(Task);
+  if (I == Buffers.end())
+    return nullptr;
+  auto MB = std::move(I->second);
+  Buffers.erase(I);
+  return MB;
+}
+
+Expected<std::unique_ptr<MemoryBuffer>>
+CachingIRCompiler::operator()(Module &M) {
+  unsigned Task = NextTask++;
+  auto AddStreamOrErr = Cache(Task, getKey(M), M.getModuleIdentifier());
+  if (!AddStreamOrErr)
+    return AddStreamOrErr.takeError();
+
+  // On a hit the cache has already handed us the object.
+  if (!*AddStreamOrErr) {
+    if (auto MB = takeBuffer(Task))
+      return std::move(MB);
+    return make_error<StringError>("Object cache hit for " +
+                                       M.getModuleIdentifier() +
+                                       " did not produce an object",
+                                   inconvertibleErrorCode());
+  }
+
+  auto ObjBuffer = (*BaseCompiler)(M);
+  if (!ObjBuffer)
+    return ObjBuffer.takeError();
+
+  auto StreamOrErr = (*AddStreamOrErr)(Task, M.getModuleIdentifier());
+  if (!StreamOrErr)
+    return StreamOrErr.takeError();
+  *(*StreamOrErr)->OS << (*ObjBuffer)->getBuffer();
+  // Destroying the stream commits the entry and reports a copy of it to us;
+  // the freshly compiled buffer is returned instead.
+  StreamOrErr->reset();
+  takeBuffer(Task);
+
+  return ObjBuffer;
+}
+
 } // end namespace orc
 } // end namespace llvm
@@ -22,6 +22,7 @@
 #include "llvm/IR/IRBuilder.h"
 #include "llvm/IR/Mangler.h"
 #include "llvm/IR/Module.h"
+#include "llvm/Passes/PassBuilder.h"
 #include "llvm/Support/DynamicLibrary.h"
 
 #include <map>
@@ -826,6 +827,20 @@ Expected<std::unique_ptr<IRCompileLayer::IRCompiler>>
 LLJIT::createCompileFunction(LLJITBuilderState &S,
                              JITTargetMachineBuilder JTMB) {
 
+  if (!S.ObjectCacheDirectory.empty()) {
+    auto BaseCompiler = createBaseCompileFunction(S, JTMB);
+    if (!BaseCompiler)
+      return BaseCompiler.takeError();
+    return CachingIRCompiler::Create(std::move(*BaseCompiler), JTMB,
+                                     S.ObjectCacheDirectory);
+  }
+
+  return createBaseCompileFunction(S, std::move(JTMB));
+}
+
+Expected<std::unique_ptr<IRCompileLayer::IRCompiler>>
+LLJIT::createBaseCompileFunction(LLJITBuilderState &S,
+                                 JITTargetMachineBuilder JTMB) {
   /// If there is a custom compile function creator set then use it.
   if (S.CreateCompileFunction)
     return S.CreateCompileFunction(std::move(JTMB));
@@ -966,20 +981,40 @@ Error setUpInactivePlatform(LLJIT &J) {
 }
 
 Error LLLazyJITBuilderState::prepareForConstruction() {
+  // The tier-up counters call into the JIT directly, so they only work if the
+  // JIT'd code runs in this process.
+  if (TierUpThreshold && (ES || EPC))
+    return make_error<StringError>(
+        "Tiered compilation requires the default in-process "
+        "ExecutorProcessControl",
+        inconvertibleErrorCode());
+
   if (auto Err = LLJITBuilderState::prepareForConstruction())
     return Err;
   TT = JTMB->getTargetTriple();
+
+  // The main compile layer produces the first tier with the requested target
+  // machine settings, and the optimized tier uses the same settings at
+  // CodeGenOpt::Aggressive.
+  if (TierUpThreshold) {
+    TierUpJTMB = *JTMB;
+    TierUpJTMB->setCodeGenOptLevel(CodeGenOpt::Aggressive);
+  }
   return Error::success();
 }
 
-Error LLLazyJIT::addLazyIRModule(JITDylib &JD, ThreadSafeModule TSM) {
+Error LLLazyJIT::addLazyIRModule(ResourceTrackerSP RT, ThreadSafeModule TSM) {
   assert(TSM && "Can not add null module");
 
   if (auto Err = TSM.withModuleDo(
           [&](Module &M) -> Error { return applyDataLayout(M); }))
     return Err;
 
-  return CODLayer->add(JD, std::move(TSM));
+  return CODLayer->add(std::move(RT), std::move(TSM));
+}
+
+Error LLLazyJIT::addLazyIRModule(JITDylib &JD, ThreadSafeModule TSM) {
+  return addLazyIRModule(JD.getDefaultResourceTracker(), std::move(TSM));
 }
 
 LLLazyJIT::LLLazyJIT(LLLazyJITBuilderState &S, Error &Err) : LLJIT(S, Err) {
@@ -1025,6 +1060,37 @@ LLLazyJIT::LLLazyJIT(LLLazyJITBuilderState &S, Error &Err) : LLJIT(S, Err) {
 
   if (S.NumCompileThreads > 0)
     CODLayer->setCloneToNewContextOnEmit(true);
+
+  if (S.TierUpJTMB) {
+    TierUpCompileLayer = std::make_unique<IRCompileLayer>(
+        *ES, *ObjTransformLayer,
+        std::make_unique<ConcurrentIRCompiler>(*S.TierUpJTMB));
+    TierUpTransformLayer = std::make_unique<IRTransformLayer>(
+        *ES, *TierUpCompileLayer,
+        [JTMB = std::move(*S.TierUpJTMB)](
+            ThreadSafeModule TSM,
+            MaterializationResponsibility &R) -> Expected<ThreadSafeModule> {
+          auto TM = JITTargetMachineBuilder(JTMB).createTargetMachine();
+          if (!TM)
+            return TM.takeError();
+          TSM.withModuleDo([&](Module &M) {
+            LoopAnalysisManager LAM;
+            FunctionAnalysisManager FAM;
+            CGSCCAnalysisManager CGAM;
+            ModuleAnalysisManager MAM;
+            PassBuilder PB(TM->get());
+            PB.registerModuleAnalyses(MAM);
+            PB.registerCGSCCAnalyses(CGAM);
+            PB.registerFunctionAnalyses(FAM);
+            PB.registerLoopAnalyses(LAM);
+            PB.crossRegisterProxies(LAM, FAM, CGAM, MAM);
+            PB.buildPerModuleDefaultPipeline(OptimizationLevel::O3)
+                .run(M, MAM);
+          });
+          return std::move(TSM);
+        });
+    CODLayer->setTierUpLayer(*TierUpTransformLayer, S.TierUpThreshold);
+  }
 }
 
 // In-process LLJIT uses eh-frame section wrappers via EPC, so we need to force
@@ -14,6 +14,9 @@
 #include "llvm/ExecutionEngine/Orc/Shared/SimpleRemoteEPCUtils.h"
 #include "llvm/Support/Endian.h"
 #include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/MathExtras.h"
+
+#include <cstring>
 
 #if !defined(_MSC_VER) && !defined(__MINGW32__)
 #include <unistd.h>
@@ -246,5 +249,292 @@ void FDSimpleRemoteEPCTransport::listenLoop() {
   C.handleDisconnect(std::move(Err));
 }
 
+/// One direction of a SharedMemorySimpleRemoteEPCTransport, placed at the
+/// start of its half of the shared region and followed by the ring's data.
+/// Head and Tail count all bytes ever written and read, so the ring is empty
+/// when they are equal and full when they differ by the capacity. Head is
+/// only written by the producer, under the transport's mutex, and Tail only by
+/// the consumer's listener thread; they live on separate cache lines.
+/// ConsumerAsleep has two writers: the consumer sets it before sleeping, and
+/// the producer clears it with an exchange when it wakes the consumer up.
+/// Closed is only written by the producer, when it disconnects.
+struct SharedMemorySimpleRemoteEPCTransport::Ring {
+  static constexpr size_t CacheLineSize = 64;
+
+  alignas(CacheLineSize) std::atomic<uint64_t> Head;
+  alignas(CacheLineSize) std::atomic<uint64_t> Tail;
+  alignas(CacheLineSize) std::atomic<uint32_t> ConsumerAsleep;
+  std::atomic<uint32_t> Closed;
+
+  char *data() { return reinterpret_cast<char *>(this) + sizeof(Ring); }
+};
+
+// The rings live in zero-initialized shared memory and are used by two
+// processes without being constructed.
+static_assert(std::atomic<uint64_t>::is_always_lock_free &&
+                  std::atomic<uint32_t>::is_always_lock_free,
+              "Shared-memory rings require lock-free atomics");
+
+Expected<std::unique_ptr<SharedMemorySimpleRemoteEPCTransport>>
+SharedMemorySimpleRemoteEPCTransport::Create(SimpleRemoteEPCTransportClient &C,
+                                             Side S, char *SharedMem,
+                                             size_t SharedMemSize, int InFD,
+                                             int OutFD) {
+#if LLVM_ENABLE_THREADS
+  if (InFD == -1)
+    return make_error<StringError>("Invalid input file descriptor " +
+                                       Twine(InFD),
+                                   inconvertibleErrorCode());
+  if (OutFD == -1)
+    return make_error<StringError>("Invalid output file descriptor " +
+                                       Twine(OutFD),
+                                   inconvertibleErrorCode());
+  if (reinterpret_cast<uintptr_t>(SharedMem) % Ring::CacheLineSize)
+    return make_error<StringError>("Shared memory region is not aligned to " +
+                                       Twine(Ring::CacheLineSize) + " bytes",
+                                   inconvertibleErrorCode());
+
+  size_t HalfSize = alignDown(SharedMemSize / 2, Ring::CacheLineSize);
+  if (HalfSize < 2 * sizeof(Ring))
+    return make_error<StringError>("Shared memory region of " +
+                                       Twine(SharedMemSize) +
+                                       " bytes is too small",
+                                   inconvertibleErrorCode());
+
+  auto &JITToExecutor = *reinterpret_cast<Ring *>(SharedMem);
+  auto &ExecutorToJIT = *reinterpret_cast<Ring *>(SharedMem + HalfSize);
+  auto &In = S == Side::JIT ? ExecutorToJIT : JITToExecutor;
+  auto &Out = S == Side::JIT ? JITToExecutor : ExecutorToJIT;
+  std::unique_ptr<SharedMemorySimpleRemoteEPCTransport> SMT(
+      new SharedMemorySimpleRemoteEPCTransport(
+          C, In, Out, HalfSize - sizeof(Ring), InFD, OutFD));
+  return std::move(SMT);
+#else
+  return make_error<StringError>("Shared-memory SimpleRemoteEPC transport "
+                                 "requires thread support, but llvm was built "
+                                 "with LLVM_ENABLE_THREADS=Off",
+                                 inconvertibleErrorCode());
+#endif
+}
+
+SharedMemorySimpleRemoteEPCTransport::~SharedMemorySimpleRemoteEPCTransport() {
+#if LLVM_ENABLE_THREADS
+  ListenerThread.join();
+#endif
+}
+
+Error SharedMemorySimpleRemoteEPCTransport::start() {
+#if LLVM_ENABLE_THREADS
+  ListenerThread = std::thread([this]() { listenLoop(); });
+  return Error::success();
+#endif
+  llvm_unreachable("Should not be called with LLVM_ENABLE_THREADS=Off");
+}
+
+Error SharedMemorySimpleRemoteEPCTransport::sendMessage(
+    SimpleRemoteEPCOpcode OpC, uint64_t SeqNo, ExecutorAddr TagAddr,
+    ArrayRef<char> ArgBytes) {
+  char HeaderBuffer[FDMsgHeader::Size];
+
+  *((support::ulittle64_t *)(HeaderBuffer + FDMsgHeader::MsgSizeOffset)) =
+      FDMsgHeader::Size + ArgBytes.size();
+  *((support::ulittle64_t *)(HeaderBuffer + FDMsgHeader::OpCOffset)) =
+      static_cast<uint64_t>(OpC);
+  *((support::ulittle64_t *)(HeaderBuffer + FDMsgHeader::SeqNoOffset)) = SeqNo;
+  *((support::ulittle64_t *)(HeaderBuffer + FDMsgHeader::TagAddrOffset)) =
+      TagAddr.getValue();
+
+  std::lock_guard<std::mutex> Lock(M);
+  if (Disconnected)
+    return make_error<StringError>("Shared-memory transport disconnected",
+                                   inconvertibleErrorCode());
+  if (auto Err = writeBytes(HeaderBuffer, FDMsgHeader::Size))
+    return Err;
+  if (auto Err = writeBytes(ArgBytes.data(), ArgBytes.size()))
+    return Err;
+  wakePeer();
+  return Error::success();
+}
+
+void SharedMemorySimpleRemoteEPCTransport::disconnect() {
+  if (Disconnected.exchange(true))
+    return; // Return if already disconnected.
+
+  // Let the peer's listener see the hangup even if it is spinning on the
+  // ring rather than reading its FD.
+  Out.Closed.store(1);
+  wakePeer();
+
+  bool CloseOutFD = InFD != OutFD;
+
+  // Close InFD.
+  while (close(InFD) == -1) {
+    if (errno == EBADF)
+      break;
+  }
+
+  // Close OutFD.
+  if (CloseOutFD) {
+    while (close(OutFD) == -1) {
+      if (errno == EBADF)
+        break;
+    }
+  }
+}
+
+void SharedMemorySimpleRemoteEPCTransport::wakePeer() {
+  // Pairs with the store to ConsumerAsleep in waitForData: either the peer
+  // sees the new Head before going to sleep, or we see that it is asleep.
+  if (Out.ConsumerAsleep.exchange(0)) {
+    char Byte = 0;
+    while (::write(OutFD, &Byte, 1) == -1 &&
+           (errno == EINTR || errno == EAGAIN))
+      ;
+  }
+}
+
+bool SharedMemorySimpleRemoteEPCTransport::waitForData() {
+  auto HasData = [&]() { return In.Head.load() != In.Tail.load(); };
+  auto IsClosed = [&]() { return In.Closed.load() || Disconnected; };
+
+  // Messages often arrive in quick succession (e.g. the result of a call
+  // that was just sent), so spin for a while before sleeping.
+  constexpr unsigned SpinCount = 1024;
+  for (unsigned I = 0; I != SpinCount; ++I) {
+    if (HasData())
+      return true;
+    if (IsClosed())
+      return HasData();
+    std::this_thread::yield();
+  }
+
+  while (true) {
+    In.ConsumerAsleep.store(1);
+    if (HasData() || IsClosed())
+      break;
+
+    // The byte carries no information: the writer sends one whenever it
+    // finds us asleep, so a stale one only causes a spurious wake-up.
+    char Byte;
+    ssize_t Read = ::read(InFD, &Byte, 1);
+    if (Read == 0 || (Read < 0 && errno != EINTR && errno != EAGAIN))
+      break; // Hangup.
+  }
+  In.ConsumerAsleep.store(0);
+  return HasData();
+}
+
+Error SharedMemorySimpleRemoteEPCTransport::readBytes(char *Dst, size_t Size,
+                                                      bool *IsEOF) {
+  assert((Size == 0 || Dst) && "Attempt to read into null.");
+  size_t Completed = 0;
+  while (Completed < Size) {
+    uint64_t Tail = In.Tail.load(std::memory_order_relaxed);
+    uint64_t Head = In.Head.load(std::memory_order_acquire);
+    if (Head == Tail) {
+      if (waitForData())
+        continue;
+      if (Completed == 0 && IsEOF) {
+        *IsEOF = true;
+        return Error::success();
+      }
+      return makeUnexpectedEOFError();
+    }
+
+    uint64_t Offset = Tail % Capacity;
+    size_t N = std::min<uint64_t>({Size - Completed, Head - Tail,
+                                   Capacity - Offset});
+    memcpy(Dst + Completed, In.data() + Offset, N);
+    In.Tail.store(Tail + N, std::memory_order_release);
+    Completed += N;
+  }
+  return Error::success();
+}
+
+Error SharedMemorySimpleRemoteEPCTransport::writeBytes(const char *Src,
+                                                       size_t Size) {
+  assert((Size == 0 || Src) && "Attempt to append from null.");
+  while (Size) {
+    uint64_t Head = Out.Head.load(std::memory_order_relaxed);
+    uint64_t Tail = Out.Tail.load(std::memory_order_acquire);
+    if (Head - Tail == Capacity) {
+      // The ring is full: make sure the peer is draining it.
+      wakePeer();
+      if (In.Closed.load() || Disconnected)
+        return make_error<StringError>("Shared-memory transport disconnected",
+                                       inconvertibleErrorCode());
+      std::this_thread::yield();
+      continue;
+    }
+
+    uint64_t Offset = Head % Capacity;
+    size_t N = std::min<uint64_t>({Size, Capacity - (Head - Tail),
+                                   Capacity - Offset});
+    memcpy(Out.data() + Offset, Src, N);
+    Out.Head.store(Head + N);
+    Src += N;
+    Size -= N;
+  }
+  return Error::success();
+}
+
+void SharedMemorySimpleRemoteEPCTransport::listenLoop() {
+  Error Err = Error::success();
+  do {
+
+    char HeaderBuffer[FDMsgHeader::Size];
+    // Read the header buffer.
+    {
+      bool IsEOF = false;
+      if (auto Err2 = readBytes(HeaderBuffer, FDMsgHeader::Size, &IsEOF)) {
+        Err = joinErrors(std::move(Err), std::move(Err2));
+        break;
+      }
+      if (IsEOF)
+        break;
+    }
+
+    // Decode header buffer.
+    uint64_t MsgSize =
+        *((support::ulittle64_t *)(HeaderBuffer + FDMsgHeader::MsgSizeOffset));
+    auto OpC = static_cast<SimpleRemoteEPCOpcode>(static_cast<uint64_t>(
+        *((support::ulittle64_t *)(HeaderBuffer + FDMsgHeader::OpCOffset))));
+    uint64_t SeqNo =
+        *((support::ulittle64_t *)(HeaderBuffer + FDMsgHeader::SeqNoOffset));
+    ExecutorAddr TagAddr(
+        *((support::ulittle64_t *)(HeaderBuffer + FDMsgHeader::TagAddrOffset)));
+
+    if (MsgSize < FDMsgHeader::Size) {
+      Err = joinErrors(std::move(Err),
+                       make_error<StringError>("Message size too small",
+                                               inconvertibleErrorCode()));
+      break;
+    }
+
+    // Read the argument bytes.
+    SimpleRemoteEPCArgBytesVector ArgBytes;
+    ArgBytes.resize(MsgSize - FDMsgHeader::Size);
+    if (auto Err2 = readBytes(ArgBytes.data(), ArgBytes.size())) {
+      Err = joinErrors(std::move(Err), std::move(Err2));
+      break;
+    }
+
+    if (auto Action = C.handleMessage(OpC, SeqNo, TagAddr, ArgBytes)) {
+      if (*Action == SimpleRemoteEPCTransportClient::EndSession)
+        break;
+    } else {
+      Err = joinErrors(std::move(Err), Action.takeError());
+      break;
+    }
+  } while (true);
+
+  // Mark the rings closed and close the FDs, so that subsequent sendMessage
+  // calls fail and the peer sees the hangup.
+  disconnect();
+
+  // Call up to the client to handle the disconnection.
+  C.handleDisconnect(std::move(Err));
+}
+
 } // end namespace orc
 } // end namespace llvm
@@ -82,12 +82,19 @@ void LLVMRemarkStreamer::emit(const DiagnosticInfoOptimizationBase &Diag) {
   if (!RS.matchesFilter(Diag.getPassName()))
       return;
 
+  if (!RS.isSampled(Diag.getPassName()))
+    return;
+
   // First, convert the diagnostic to a remark.
   remarks::Remark R = toRemark(Diag);
   // Then, emit the remark through the serializer.
   RS.getSerializer().emit(R);
 }
 
+bool LLVMRemarkStreamer::isEnabled(StringRef PassName) {
+  return RS.matchesFilter(PassName);
+}
+
 char LLVMRemarkSetupFileError::ID = 0;
 char LLVMRemarkSetupPatternError::ID = 0;
 char LLVMRemarkSetupFormatError::ID = 0;
@@ -1470,6 +1470,165 @@ ThinBackend lto::createWriteIndexesThinBackend(
   };
 }
 
+namespace {
+class DistributedThinBackend : public ThinBackendProc {
+  ThreadPool BackendThreadPool;
+  AddStreamFn AddStream;
+  FileCache Cache;
+  RemoteBackendExecutor Executor;
+  std::set<GlobalValue::GUID> CfiFunctionDefs;
+  std::set<GlobalValue::GUID> CfiFunctionDecls;
+
+  std::optional<Error> Err;
+  std::mutex ErrMu;
+
+  /// Serializes the writes of the individual indexes, which read the shared
+  /// combined index, and the calls to OnWrite.
+  std::mutex IndexMu;
+
+public:
+  DistributedThinBackend(
+      const Config &Conf, ModuleSummaryIndex &CombinedIndex,
+      ThreadPoolStrategy Parallelism,
+      const StringMap<GVSummaryMapTy> &ModuleToDefinedGVSummaries,
+      AddStreamFn AddStream, FileCache Cache, RemoteBackendExecutor Executor,
+      lto::IndexWriteCallback OnWrite)
+      : ThinBackendProc(Conf, CombinedIndex, ModuleToDefinedGVSummaries,
+                        OnWrite, /*ShouldEmitImportsFiles=*/false),
+        BackendThreadPool(Parallelism), AddStream(std::move(AddStream)),
+        Cache(std::move(Cache)), Executor(std::move(Executor)) {
+    for (auto &Name : CombinedIndex.cfiFunctionDefs())
+      CfiFunctionDefs.insert(
+          GlobalValue::getGUID(GlobalValue::dropLLVMManglingEscape(Name)));
+    for (auto &Name : CombinedIndex.cfiFunctionDecls())
+      CfiFunctionDecls.insert(
+          GlobalValue::getGUID(GlobalValue::dropLLVMManglingEscape(Name)));
+  }
+
+  Error runRemoteBackend(
+      unsigned Task, BitcodeModule BM,
+      const FunctionImporter::ImportMapTy &ImportList,
+      const FunctionImporter::ExportSetTy &ExportList,
+      const std::map<GlobalValue::GUID, GlobalValue::LinkageTypes> &ResolvedODR,
+      const GVSummaryMapTy &DefinedGlobals,
+      MapVector<StringRef, BitcodeModule> &ModuleMap) {
+    StringRef ModuleID = BM.getModuleIdentifier();
+
+    // Use the same cache key as the in-process backend so that local and
+    // remote results are interchangeable.
+    SmallString<40> Key;
+    AddStreamFn OutputStream = AddStream;
+    if (Cache && CombinedIndex.modulePaths().count(ModuleID) &&
+        !all_of(CombinedIndex.getModuleHash(ModuleID),
+                [](uint32_t V) { return V == 0; })) {
+      computeLTOCacheKey(Key, Conf, CombinedIndex, ModuleID, ImportList,
+                         ExportList, ResolvedODR, DefinedGlobals,
+                         CfiFunctionDefs, CfiFunctionDecls);
+      Expected<AddStreamFn> CacheAddStreamOrErr = Cache(Task, Key, ModuleID);
+      if (Error Err = CacheAddStreamOrErr.takeError())
+        return Err;
+      // A null stream means the cache already added the object to the link.
+      if (!*CacheAddStreamOrErr)
+        return Error::success();
+      OutputStream = std::move(*CacheAddStreamOrErr);
+    }
+
+    // Build the summary slice the remote backend needs.
+    std::map<std::string, GVSummaryMapTy> ModuleToSummariesForIndex;
+    SmallString<0> SummaryIndex;
+    {
+      std::lock_guard<std::mutex> L(IndexMu);
+      gatherImportedSummariesForModule(ModuleID, ModuleToDefinedGVSummaries,
+                                       ImportList, ModuleToSummariesForIndex);
+      raw_svector_ostream OS(SummaryIndex);
+      writeIndexToFile(CombinedIndex, OS, &ModuleToSummariesForIndex);
+    }
+
+    RemoteBackendJob Job;
+    Job.Conf = &Conf;
+    Job.Task = Task;
+    Job.ModuleID = ModuleID;
+    Job.Bitcode = BM.getBuffer();
+    Job.SummaryIndex = SummaryIndex;
+    Job.CacheKey = Key;
+    for (const auto &I : ModuleToSummariesForIndex) {
+      if (I.first == ModuleID)
+        continue;
+      auto It = ModuleMap.find(I.first);
+      if (It == ModuleMap.end())
+        return make_error<StringError>("distributed ThinLTO: module " +
+                                           I.first + " is not in the link",
+                                       inconvertibleErrorCode());
+      Job.ImportedModules.push_back({It->first, It->second.getBuffer()});
+    }
+
+    Expected<std::unique_ptr<MemoryBuffer>> ObjOrErr = Executor(Job);
+    if (!ObjOrErr)
+      return ObjOrErr.takeError();
+
+    Expected<std::unique_ptr<CachedFileStream>> StreamOrErr =
+        OutputStream(Task, ModuleID);
+    if (Error Err = StreamOrErr.takeError())
+      return Err;
+    *(*StreamOrErr)->OS << (*ObjOrErr)->getBuffer();
+    return Error::success();
+  }
+
+  Error start(
+      unsigned Task, BitcodeModule BM,
+      const FunctionImporter::ImportMapTy &ImportList,
+      const FunctionImporter::ExportSetTy &ExportList,
+      const std::map<GlobalValue::GUID, GlobalValue::LinkageTypes> &ResolvedODR,
+      MapVector<StringRef, BitcodeModule> &ModuleMap) override {
+    StringRef ModulePath = BM.getModuleIdentifier();
+    assert(ModuleToDefinedGVSummaries.count(ModulePath));
+    const GVSummaryMapTy &DefinedGlobals =
+        ModuleToDefinedGVSummaries.find(ModulePath)->second;
+    BackendThreadPool.async(
+        [=, &ImportList, &ExportList, &ResolvedODR, &DefinedGlobals,
+         &ModuleMap]() {
+          Error E = runRemoteBackend(Task, BM, ImportList, ExportList,
+                                     ResolvedODR, DefinedGlobals, ModuleMap);
+          if (E) {
+            std::unique_lock<std::mutex> L(ErrMu);
+            if (Err)
+              Err = joinErrors(std::move(*Err), std::move(E));
+            else
+              Err = std::move(E);
+          } else if (OnWrite) {
+            // The module is only done once its job has run.
+            std::lock_guard<std::mutex> L(IndexMu);
+            OnWrite(std::string(ModulePath));
+          }
+        });
+    return Error::success();
+  }
+
+  Error wait() override {
+    BackendThreadPool.wait();
+    if (Err)
+      return std::move(*Err);
+    return Error::success();
+  }
+
+  unsigned getThreadCount() override {
+    return BackendThreadPool.getThreadCount();
+  }
+};
+} // end anonymous namespace
+
+ThinBackend lto::createDistributedThinBackend(ThreadPoolStrategy Parallelism,
+                                              RemoteBackendExecutor Executor,
+                                              IndexWriteCallback OnWrite) {
+  return [=](const Config &Conf, ModuleSummaryIndex &CombinedIndex,
+             const StringMap<GVSummaryMapTy> &ModuleToDefinedGVSummaries,
+             AddStreamFn AddStream, FileCache Cache) {
+    return std::make_unique<DistributedThinBackend>(
+        Conf, CombinedIndex, Parallelism, ModuleToDefinedGVSummaries, AddStream,
+        Cache, Executor, OnWrite);
+  };
+}
+
 Error LTO::runThinLTO(AddStreamFn AddStream, FileCache Cache,
                       const DenseSet<GlobalValue::GUID> &GUIDPreservedSymbols) {
   ThinLTO.CombinedIndex.releaseTemporaryMemory();
@@ -13,6 +13,7 @@
 
 #include "llvm/MCA/HardwareUnits/LSUnit.h"
 #include "llvm/MCA/Instruction.h"
+#include "llvm/MCA/LoopMemoryDependences.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/raw_ostream.h"
 
@@ -66,6 +67,21 @@ void LSUnitBase::dump() const {
 }
 #endif
 
+unsigned LSUnit::getAliasingStoreGroupID(const InstRef &IR) const {
+  SmallVector<unsigned, 4> Stores;
+  MemoryDependences->getStoreSourceIndices(IR.getSourceIndex(), Stores);
+
+  // Group identifiers are allocated in program order, so the youngest store
+  // in flight is the one with the largest group identifier.
+  unsigned GroupID = 0;
+  for (unsigned StoreIndex : Stores) {
+    auto It = StoreGroupIDs.find(StoreIndex);
+    if (It != StoreGroupIDs.end() && isValidGroupID(It->second))
+      GroupID = std::max(GroupID, It->second);
+  }
+  return GroupID;
+}
+
 unsigned LSUnit::dispatch(const InstRef &IR) {
   const Instruction &IS = *IR.getInstruction();
   bool IsStoreBarrier = IS.isAStoreBarrier();
@@ -101,15 +117,34 @@ unsigned LSUnit::dispatch(const InstRef &IR) {
       StoreGroup.addSuccessor(&NewGroup, true);
     }
 
+    // The load of a read-modify-write instruction may not pass a previous
+    // store that it reads from.
+    unsigned AliasingStoreGroupID = 0;
+    if (MemoryDependences && IS.getMayLoad())
+      AliasingStoreGroupID = getAliasingStoreGroupID(IR);
+
     // A store may not pass a previous store.
     if (CurrentStoreGroupID &&
         (CurrentStoreGroupID != CurrentStoreBarrierGroupID)) {
       MemoryGroup &StoreGroup = getGroup(CurrentStoreGroupID);
       LLVM_DEBUG(dbgs() << "[LSUnit]: GROUP DEP: (" << CurrentStoreGroupID
                         << ") --> (" << NewGID << ")\n");
-      StoreGroup.addSuccessor(&NewGroup, !assumeNoAlias());
+      StoreGroup.addSuccessor(&NewGroup,
+                              !assumeNoAlias() ||
+                                  AliasingStoreGroupID == CurrentStoreGroupID);
     }
 
+    if (AliasingStoreGroupID && AliasingStoreGroupID != CurrentStoreGroupID &&
+        AliasingStoreGroupID != CurrentStoreBarrierGroupID) {
+      MemoryGroup &StoreGroup = getGroup(AliasingStoreGroupID);
+      LLVM_DEBUG(dbgs() << "[LSUnit]: GROUP DEP: (" << AliasingStoreGroupID
+                        << ") --> (" << NewGID << ")\n");
+      StoreGroup.addSuccessor(&NewGroup, true);
+    }
+
+    if (MemoryDependences)
+      StoreGroupIDs[IR.getSourceIndex()] = NewGID;
+
 
     CurrentStoreGroupID = NewGID;
     if (IsStoreBarrier)
@@ -129,6 +164,13 @@ unsigned LSUnit::dispatch(const InstRef &IR) {
   unsigned ImmediateLoadDominator =
       std::max(CurrentLoadGroupID, CurrentLoadBarrierGroupID);
 
+  // The group of the store that this load may not pass, if any.
+  unsigned StoreDominator = 0;
+  if (MemoryDependences)
+    StoreDominator = getAliasingStoreGroupID(IR);
+  else if (!assumeNoAlias())
+    StoreDominator = CurrentStoreGroupID;
+
   // A new load group is created if we are in one of the following situations:
   // 1) This is a load barrier (by construction, a load barrier is always
   //    assigned to a different memory group).
@@ -141,11 +183,14 @@ unsigned LSUnit::dispatch(const InstRef &IR) {
   // 5) There is no intervening store and there is an active load group.
   //    However that group has already started execution, so we cannot add
   //    this load to it.
+  // 6) The loop memory dependencies say that this load reads from an older
+  //    store. The active load group doesn't necessarily depend on it.
   bool ShouldCreateANewGroup =
       IsLoadBarrier || !ImmediateLoadDominator ||
       CurrentLoadBarrierGroupID == ImmediateLoadDominator ||
       ImmediateLoadDominator <= CurrentStoreGroupID ||
-      getGroup(ImmediateLoadDominator).isExecuting();
+      getGroup(ImmediateLoadDominator).isExecuting() ||
+      (MemoryDependences && StoreDominator);
 
   if (ShouldCreateANewGroup) {
     unsigned NewGID = createMemoryGroup();
@@ -153,10 +198,11 @@ unsigned LSUnit::dispatch(const InstRef &IR) {
     NewGroup.addInstruction();
 
     // A load may not pass a previous store or store barrier
-    // unless flag 'NoAlias' is set.
-    if (!assumeNoAlias() && CurrentStoreGroupID) {
-      MemoryGroup &StoreGroup = getGroup(CurrentStoreGroupID);
-      LLVM_DEBUG(dbgs() << "[LSUnit]: GROUP DEP: (" << CurrentStoreGroupID
+    // unless flag 'NoAlias' is set, or the loop memory dependencies say that
+    // the load doesn't read from it.
+    if (StoreDominator) {
+      MemoryGroup &StoreGroup = getGroup(StoreDominator);
+      LLVM_DEBUG(dbgs() << "[LSUnit]: GROUP DEP: (" << StoreDominator
                         << ") --> (" << NewGID << ")\n");
       StoreGroup.addSuccessor(&NewGroup, true);
     }
@@ -236,6 +282,8 @@ void LSUnit::onInstructionExecuted(const InstRef &IR) {
     return;
 
   LSUnitBase::onInstructionExecuted(IR);
+  if (IS.getMayStore())
+    StoreGroupIDs.erase(IR.getSourceIndex());
   unsigned GroupID = IS.getLSUTokenID();
   if (!isValidGroupID(GroupID)) {
     if (GroupID == CurrentLoadGroupID)
@@ -0,0 +1,276 @@
+//===---------------- LoopMemoryDependences.cpp -----------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+/// \file
+///
+/// This file implements the LoopMemoryDependences class.
+///
+//===----------------------------------------------------------------------===//
+
+#include "llvm/MCA/LoopMemoryDependences.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/raw_ostream.h"
+#include <optional>
+
+#define DEBUG_TYPE "llvm-mca"
+
+namespace llvm {
+namespace mca {
+
+namespace {
+
+/// The largest number of iterations between a store and a load that reads
+/// from it. Older stores are retired long before the load is dispatched.
+constexpr unsigned MaxDistance = 1024;
+
+/// Distance returned for accesses that never overlap.
+constexpr unsigned NoDependence = ~0U;
+
+/// Number of bytes assumed to be accessed by a memory operation whose size
+/// cannot be inferred from its operands.
+constexpr unsigned DefaultAccessSize = 8;
+
+/// A value computed by the loop body: the value of Symbol plus Offset. Symbol
+/// zero is the constant zero.
+struct SymbolicValue {
+  unsigned Symbol = 0;
+  int64_t Offset = 0;
+};
+
+/// The address BaseSymbol + IndexSymbol * Scale + Offset of a memory access
+/// of Size bytes.
+struct SymbolicAddress {
+  bool IsValid = false;
+  unsigned BaseSymbol = 0;
+  unsigned IndexSymbol = 0;
+  int64_t Scale = 0;
+  int64_t Offset = 0;
+  unsigned Size = 0;
+};
+
+/// Tracks the symbolic value of every register through one iteration of the
+/// loop body.
+class LoopBodyValues {
+  const MCRegisterInfo &MRI;
+  DenseMap<unsigned, SymbolicValue> Values;
+
+  /// The register whose value at the start of an iteration is described by
+  /// each symbol, or a null register for the symbols of the values computed by
+  /// the loop body.
+  SmallVector<MCRegister, 16> SymbolRegs;
+
+  unsigned createSymbol(MCRegister Reg) {
+    SymbolRegs.push_back(Reg);
+    return SymbolRegs.size() - 1;
+  }
+
+  void clobberAliases(MCRegister Reg, bool IncludeSelf) {
+    for (MCRegAliasIterator AI(Reg, &MRI, IncludeSelf); AI.isValid(); ++AI)
+      Values[*AI] = SymbolicValue{createSymbol(MCRegister()), 0};
+  }
+
+public:
+  LoopBodyValues(const MCRegisterInfo &MRI) : MRI(MRI), SymbolRegs(1) {}
+
+  SymbolicValue read(MCRegister Reg) {
+    if (!Reg)
+      return SymbolicValue();
+    auto It = Values.try_emplace(Reg.id());
+    if (It.second)
+      It.first->second.Symbol = createSymbol(Reg);
+    return It.first->second;
+  }
+
+  void clobber(MCRegister Reg) { clobberAliases(Reg, /*IncludeSelf=*/true); }
+
+  void increment(MCRegister Reg, int64_t Offset) {
+    SymbolicValue Value = read(Reg);
+    Value.Offset += Offset;
+    clobberAliases(Reg, /*IncludeSelf=*/false);
+    Values[Reg.id()] = Value;
+  }
+
+  /// Returns the amount added to Symbol by every iteration of the loop body,
+  /// or std::nullopt if Symbol is not an induction variable.
+  std::optional<int64_t> getStride(unsigned Symbol) const {
+    if (!Symbol)
+      return 0;
+    MCRegister Reg = SymbolRegs[Symbol];
+    if (!Reg)
+      return std::nullopt;
+    const SymbolicValue &Value = Values.find(Reg.id())->second;
+    if (Value.Symbol != Symbol)
+      return std::nullopt;
+    return Value.Offset;
+  }
+};
+
+} // end anonymous namespace
+
+/// Estimates the number of bytes accessed by the memory operand of MCI as the
+/// size of its widest register operand that is not part of the address.
+static unsigned getAccessSize(const MCInst &MCI, const MCInstrDesc &MCDesc,
+                              const MCRegisterInfo &MRI,
+                              const MemoryAccess &Access) {
+  unsigned Size = 0;
+  unsigned NumOperands =
+      std::min<unsigned>(MCDesc.getNumOperands(), MCI.getNumOperands());
+  for (unsigned I = 0; I < NumOperands; ++I) {
+    const MCOperand &Op = MCI.getOperand(I);
+    int16_t RegClass = MCDesc.operands()[I].RegClass;
+    if (!Op.isReg() || !Op.getReg() || RegClass < 0 ||
+        Op.getReg() == Access.BaseReg || Op.getReg() == Access.IndexReg)
+      continue;
+    Size = std::max(Size, MRI.getRegClass(RegClass).getSizeInBits() / 8);
+  }
+  return Size ? Size : DefaultAccessSize;
+}
+
+/// Returns the largest integer that is not greater than N / D, for D > 0.
+static int64_t floorDiv(int64_t N, int64_t D) {
+  int64_t Q = N / D;
+  return N % D < 0 ? Q - 1 : Q;
+}
+
+/// Returns the smallest distance, of at least MinDistance iterations, between
+/// an instance of Store and a younger instance of Load that access the same
+/// bytes. Returns NoDependence if there is none, and std::nullopt if the two
+/// addresses cannot be compared.
+static std::optional<unsigned> getDistance(const SymbolicAddress &Load,
+                                           const SymbolicAddress &Store,
+                                           unsigned MinDistance,
+                                           const LoopBodyValues &Values) {
+  if (!Load.IsValid || !Store.IsValid || Load.BaseSymbol != Store.BaseSymbol ||
+      Load.IndexSymbol != Store.IndexSymbol || Load.Scale != Store.Scale)
+    return std::nullopt;
+
+  // Checks if the store overlaps with the load when its address is
+  // StoreOffset bytes from the base of the load.
+  auto Overlaps = [&](int64_t StoreOffset) {
+    return Load.Offset < StoreOffset + Store.Size &&
+           StoreOffset < Load.Offset + Load.Size;
+  };
+
+  std::optional<int64_t> BaseStride = Values.getStride(Load.BaseSymbol);
+  std::optional<int64_t> IndexStride = Values.getStride(Load.IndexSymbol);
+  if (!BaseStride || !IndexStride) {
+    // The registers of the address have unrelated values in different
+    // iterations, so only the accesses of a same iteration can be compared.
+    if (!MinDistance)
+      return Overlaps(Store.Offset) ? 0 : NoDependence;
+    return std::nullopt;
+  }
+
+  // The instance of Store executed Distance iterations before Load accesses
+  // Store.Offset - Distance * Stride bytes from the base of the load. Find
+  // the first distance where the store reaches the load; if they don't
+  // overlap at that distance, they never do.
+  int64_t Stride = *BaseStride + *IndexStride * Load.Scale;
+  if (!Stride)
+    return Overlaps(Store.Offset) ? MinDistance : NoDependence;
+
+  int64_t Distance =
+      Stride > 0
+          ? floorDiv(Store.Offset - Load.Offset - Load.Size, Stride) + 1
+          : floorDiv(Load.Offset - Store.Offset - Store.Size, -Stride) + 1;
+  Distance = std::max<int64_t>(Distance, MinDistance);
+  if (Distance > MaxDistance || !Overlaps(Store.Offset - Distance * Stride))
+    return NoDependence;
+  return Distance;
+}
+
+LoopMemoryDependences::LoopMemoryDependences(ArrayRef<MCInst> Body,
+                                             const InstrPostProcess &IPP,
+                                             const MCInstrInfo &MCII,
+                                             const MCRegisterInfo &MRI,
+                                             bool AssumeNoAlias)
+    : NumInstructions(Body.size()), Dependences(Body.size()) {
+  // Compute the addresses accessed by one iteration of the loop body.
+  LoopBodyValues Values(MRI);
+  SmallVector<SymbolicAddress, 0> Addresses(Body.size());
+  for (const auto &[Index, MCI] : enumerate(Body)) {
+    const MCInstrDesc &MCDesc = MCII.get(MCI.getOpcode());
+    MemoryAccess Access;
+    if ((MCDesc.mayLoad() || MCDesc.mayStore()) &&
+        IPP.getMemoryAccess(MCI, Access)) {
+      SymbolicValue Base = Values.read(Access.BaseReg);
+      SymbolicValue ScaledIndex = Values.read(Access.IndexReg);
+      SymbolicAddress &Address = Addresses[Index];
+      Address.IsValid = true;
+      Address.BaseSymbol = Base.Symbol;
+      Address.IndexSymbol = ScaledIndex.Symbol;
+      Address.Scale = ScaledIndex.Symbol ? Access.Scale : 0;
+      Address.Offset = Base.Offset + ScaledIndex.Offset * Access.Scale +
+                       Access.Displacement;
+      Address.Size = Access.Size ? Access.Size
+                                 : getAccessSize(MCI, MCDesc, MRI, Access);
+    }
+
+    MCRegister IncrementedReg;
+    int64_t Increment = 0;
+    bool IsIncrement =
+        IPP.isRegisterIncrement(MCI, IncrementedReg, Increment);
+    if (IsIncrement)
+      Values.increment(IncrementedReg, Increment);
+
+    auto Clobber = [&](MCRegister Reg) {
+      if (Reg && !(IsIncrement && Reg == IncrementedReg))
+        Values.clobber(Reg);
+    };
+    for (unsigned I = 0, E = MCDesc.getNumDefs(); I < E; ++I)
+      if (MCI.getOperand(I).isReg())
+        Clobber(MCI.getOperand(I).getReg());
+    if (MCDesc.variadicOpsAreDefs())
+      for (unsigned I = MCDesc.getNumOperands(), E = MCI.getNumOperands();
+           I < E; ++I)
+        if (MCI.getOperand(I).isReg())
+          Clobber(MCI.getOperand(I).getReg());
+    for (MCPhysReg Reg : MCDesc.implicit_defs())
+      Clobber(Reg);
+  }
+
+  // Find the closest instance of every store that each load reads from.
+  for (unsigned Load = 0; Load < NumInstructions; ++Load) {
+    if (!MCII.get(Body[Load].getOpcode()).mayLoad())
+      continue;
+    for (unsigned Store = 0; Store < NumInstructions; ++Store) {
+      if (!MCII.get(Body[Store].getOpcode()).mayStore())
+        continue;
+      // A load only reads from older stores. That includes the store of a
+      // same read-modify-write instruction, but from an earlier iteration.
+      unsigned MinDistance = Store < Load ? 0 : 1;
+      std::optional<unsigned> Distance = getDistance(
+          Addresses[Load], Addresses[Store], MinDistance, Values);
+      if (!Distance) {
+        if (AssumeNoAlias)
+          continue;
+        Distance = MinDistance;
+      }
+      if (*Distance == NoDependence)
+        continue;
+
+      LLVM_DEBUG(dbgs() << "[LoopMemoryDependences] Load " << Load
+                        << " reads from store " << Store << " of iteration -"
+                        << *Distance << '\n');
+      Dependences[Load].push_back({Store, *Distance});
+    }
+  }
+}
+
+void LoopMemoryDependences::getStoreSourceIndices(
+    unsigned SourceIndex, SmallVectorImpl<unsigned> &Stores) const {
+  unsigned Iteration = SourceIndex / NumInstructions;
+  for (const Dependence &D : getDependences(SourceIndex % NumInstructions))
+    if (D.Distance <= Iteration)
+      Stores.push_back((Iteration - D.Distance) * NumInstructions +
+                       D.StoreIndex);
+}
+
+} // namespace mca
+} // namespace llvm
@@ -31,6 +31,7 @@
 #include "llvm/Support/ErrorOr.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Memory.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
@@ -224,6 +225,33 @@ static Error replaceDebugSections(
   return Obj.replaceSections(FromTo);
 }
 
+// Compressing the debug sections dominates the run time for large inputs, so
+// compress all of them in parallel before they get replaced in order.
+static Error compressDebugSections(Object &Obj,
+                                   DebugCompressionType CompressionType) {
+  DenseMap<const SectionBase *, size_t> Indices;
+  SmallVector<const SectionBase *, 13> ToCompress;
+  for (const SectionBase &Sec : Obj.sections())
+    if (isCompressable(Sec)) {
+      Indices[&Sec] = ToCompress.size();
+      ToCompress.push_back(&Sec);
+    }
+
+  std::vector<SmallVector<uint8_t, 128>> CompressedData(ToCompress.size());
+  parallelFor(0, ToCompress.size(), [&](size_t I) {
+    compression::compress(compression::Params(CompressionType),
+                          ToCompress[I]->OriginalData, CompressedData[I]);
+  });
+
+  return replaceDebugSections(
+      Obj, isCompressable,
+      [&](const SectionBase *S) -> Expected<SectionBase *> {
+        return &Obj.addSection<CompressedSection>(CompressedSection(
+            *S, CompressionType, Obj.Is64Bits,
+            std::move(CompressedData[Indices.lookup(S)])));
+      });
+}
+
 static bool isAArch64MappingSymbol(const Symbol &Sym) {
   if (Sym.Binding != STB_LOCAL || Sym.Type != STT_NOTYPE ||
       Sym.getShndx() == SHN_UNDEF)
@@ -505,12 +533,7 @@ static Error replaceAndRemoveSections(const CommonConfig &Config,
     return E;
 
   if (Config.CompressionType != DebugCompressionType::None) {
-    if (Error Err = replaceDebugSections(
-            Obj, isCompressable,
-            [&Config, &Obj](const SectionBase *S) -> Expected<SectionBase *> {
-              return &Obj.addSection<CompressedSection>(
-                  CompressedSection(*S, Config.CompressionType, Obj.Is64Bits));
-            }))
+    if (Error Err = compressDebugSections(Obj, Config.CompressionType))
       return Err;
   } else if (Config.DecompressDebugSections) {
     if (Error Err = replaceDebugSections(
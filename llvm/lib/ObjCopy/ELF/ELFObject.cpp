@@ -20,6 +20,7 @@
 #include "llvm/Support/Endian.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/FileOutputBuffer.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include <algorithm>
 #include <cstddef>
@@ -533,12 +534,11 @@ Error ELFSectionWriter<ELFT>::visit(const CompressedSection &Sec) {
 
 CompressedSection::CompressedSection(const SectionBase &Sec,
                                      DebugCompressionType CompressionType,
-                                     bool Is64Bits)
+                                     bool Is64Bits,
+                                     SmallVector<uint8_t, 128> CompressedData)
     : SectionBase(Sec), CompressionType(CompressionType),
-      DecompressedSize(Sec.OriginalData.size()), DecompressedAlign(Sec.Align) {
-  compression::compress(compression::Params(CompressionType), OriginalData,
-                        CompressedData);
-
+      DecompressedSize(Sec.OriginalData.size()), DecompressedAlign(Sec.Align),
+      CompressedData(std::move(CompressedData)) {
   Flags |= ELF::SHF_COMPRESSED;
   size_t ChdrSize = Is64Bits ? sizeof(object::Elf_Chdr_Impl<object::ELF64LE>)
                              : sizeof(object::Elf_Chdr_Impl<object::ELF32LE>);
@@ -2052,15 +2052,18 @@ template <class ELFT> void ELFWriter<ELFT>::writeShdrs() {
 }
 
 template <class ELFT> Error ELFWriter<ELFT>::writeSectionData() {
+  // Segments are responsible for writing their contents, so only write the
+  // section data if the section is not in a segment. Note that this renders
+  // sections in segments effectively immutable.
+  SmallVector<SectionBase *, 0> ToWrite;
   for (SectionBase &Sec : Obj.sections())
-    // Segments are responsible for writing their contents, so only write the
-    // section data if the section is not in a segment. Note that this renders
-    // sections in segments effectively immutable.
     if (Sec.ParentSegment == nullptr)
-      if (Error Err = Sec.accept(*SecWriter))
-        return Err;
+      ToWrite.push_back(&Sec);
 
-  return Error::success();
+  // The sections outside of segments don't overlap in the output, and the
+  // section writer has no state, so they can be written concurrently.
+  return parallelForEachError(
+      ToWrite, [&](SectionBase *Sec) { return Sec->accept(*SecWriter); });
 }
 
 template <class ELFT> void ELFWriter<ELFT>::writeSegmentData() {
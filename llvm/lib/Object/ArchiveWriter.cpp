@@ -29,6 +29,7 @@
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/Format.h"
 #include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/SmallVectorMemoryBuffer.h"
 #include "llvm/Support/raw_ostream.h"
@@ -547,10 +548,35 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
       Entry.second = Entry.second > 1 ? 1 : 0;
   }
 
+  // Reading the symbols dominates the time it takes to write an archive of
+  // many members, so read them for all the members in parallel here. The
+  // names are appended to SymNames in member order below, which keeps the
+  // output deterministic. A member whose symbols can't be read is read again
+  // in order below so that its error is reported where it was before.
+  struct MemberSymbols {
+    std::vector<unsigned> Offsets;
+    SmallString<0> Names;
+    bool HasObject = false;
+    bool Failed = false;
+  };
+  std::vector<MemberSymbols> Symbols(NeedSymbols ? NewMembers.size() : 0);
+  parallelFor(0, Symbols.size(), [&](size_t I) {
+    MemberSymbols &S = Symbols[I];
+    raw_svector_ostream Names(S.Names);
+    Expected<std::vector<unsigned>> OffsetsOrErr =
+        getSymbols(NewMembers[I].Buf->getMemBufferRef(), Names, S.HasObject);
+    if (!OffsetsOrErr) {
+      consumeError(OffsetsOrErr.takeError());
+      S.Failed = true;
+      return;
+    }
+    S.Offsets = std::move(*OffsetsOrErr);
+  });
+
   // The big archive format needs to know the offset of the previous member
   // header.
   unsigned PrevOffset = 0;
-  for (const NewArchiveMember &M : NewMembers) {
+  for (const auto &[Index, M] : enumerate(NewMembers)) {
     std::string Header;
     raw_string_ostream Out(Header);
 
@@ -594,17 +620,29 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
     }
     Out.flush();
 
-    std::vector<unsigned> Symbols;
+    std::vector<unsigned> MemberSymbolOffsets;
     if (NeedSymbols) {
-      Expected<std::vector<unsigned>> SymbolsOrErr =
-          getSymbols(Buf, SymNames, HasObject);
-      if (!SymbolsOrErr)
-        return createFileError(M.MemberName, SymbolsOrErr.takeError());
-      Symbols = std::move(*SymbolsOrErr);
+      MemberSymbols &S = Symbols[Index];
+      if (S.Failed) {
+        Expected<std::vector<unsigned>> SymbolsOrErr =
+            getSymbols(Buf, SymNames, HasObject);
+        if (!SymbolsOrErr)
+          return createFileError(M.MemberName, SymbolsOrErr.takeError());
+        MemberSymbolOffsets = std::move(*SymbolsOrErr);
+      } else {
+        uint64_t Base = SymNames.tell();
+        SymNames << S.Names;
+        HasObject |= S.HasObject;
+        MemberSymbolOffsets = std::move(S.Offsets);
+        for (unsigned &Offset : MemberSymbolOffsets)
+          Offset += Base;
+        S.Names = SmallString<0>();
+      }
     }
 
     Pos += Header.size() + Data.size() + Padding.size();
-    Ret.push_back({std::move(Symbols), std::move(Header), Data, Padding});
+    Ret.push_back(
+        {std::move(MemberSymbolOffsets), std::move(Header), Data, Padding});
   }
   // If there are no symbols, emit an empty symbol table, to satisfy Solaris
   // tools, older versions of which expect a symbol table in a non-empty
@@ -14,6 +14,7 @@
 
 #include "llvm/Passes/StandardInstrumentations.h"
 #include "llvm/ADT/Any.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Analysis/CallGraphSCCPass.h"
 #include "llvm/Analysis/LazyCallGraph.h"
@@ -35,7 +36,9 @@
 #include "llvm/Support/Program.h"
 #include "llvm/Support/Regex.h"
 #include "llvm/Support/Signals.h"
+#include "llvm/Support/Timer.h"
 #include "llvm/Support/raw_ostream.h"
+#include <algorithm>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -101,6 +104,12 @@ static cl::opt<bool>
                  cl::desc("Print the last form of the IR before crash"),
                  cl::Hidden);
 
+static cl::opt<unsigned> ReportSlowestPassRuns(
+    "report-slowest-pass-runs", cl::init(0), cl::Hidden,
+    cl::value_desc("N"),
+    cl::desc("Report the N slowest runs of a pass on a single IR unit, with "
+             "their change in instruction count"));
+
 static cl::opt<std::string> OptBisectPrintIRPath(
     "opt-bisect-print-ir-path",
     cl::desc("Print IR to path when opt-bisect-limit is reached"), cl::Hidden);
@@ -1245,6 +1254,120 @@ void TimeProfilingPassesHandler::runBeforePass(StringRef PassID, Any IR) {
 
 void TimeProfilingPassesHandler::runAfterPass() { timeTraceProfilerEnd(); }
 
+static uint64_t getInstructionCount(Any IR) {
+  if (const auto **M = any_cast<const Module *>(&IR))
+    return (*M)->getInstructionCount();
+
+  if (const auto **F = any_cast<const Function *>(&IR))
+    return (*F)->getInstructionCount();
+
+  if (const auto **C = any_cast<const LazyCallGraph::SCC *>(&IR)) {
+    uint64_t Count = 0;
+    for (const LazyCallGraph::Node &N : **C)
+      Count += N.getFunction().getInstructionCount();
+    return Count;
+  }
+
+  if (const auto **L = any_cast<const Loop *>(&IR)) {
+    uint64_t Count = 0;
+    for (const BasicBlock *BB : (*L)->blocks())
+      Count += BB->size();
+    return Count;
+  }
+
+  llvm_unreachable("Unknown wrapped IR type");
+}
+
+SlowestPassRunsReporter::SlowestPassRunsReporter(unsigned NumRuns)
+    : NumRuns(NumRuns) {}
+
+void SlowestPassRunsReporter::registerCallbacks(
+    PassInstrumentationCallbacks &PIC) {
+  if (!NumRuns)
+    return;
+  PIC.registerBeforeNonSkippedPassCallback(
+      [this](StringRef P, Any IR) { this->runBeforePass(P, IR); });
+  PIC.registerAfterPassCallback(
+      [this](StringRef P, Any IR, const PreservedAnalyses &) {
+        this->runAfterPass(P, IR);
+      },
+      true);
+  PIC.registerAfterPassInvalidatedCallback(
+      [this](StringRef P, const PreservedAnalyses &) {
+        this->runAfterPass(P, std::nullopt);
+      },
+      true);
+}
+
+static bool shouldIgnorePassRun(StringRef PassID) {
+  // Pass managers and adaptors only add up the time of the passes they run.
+  return isSpecialPass(PassID,
+                       {"PassManager", "PassAdaptor", "AnalysisManagerProxy",
+                        "ModuleInlinerWrapperPass", "DevirtSCCRepeatedPass"});
+}
+
+void SlowestPassRunsReporter::runBeforePass(StringRef PassID, Any IR) {
+  if (shouldIgnorePassRun(PassID))
+    return;
+  Stack.push_back({PassID, TimeRecord::getCurrentTime(true).getWallTime(),
+                   getInstructionCount(IR)});
+}
+
+void SlowestPassRunsReporter::runAfterPass(StringRef PassID,
+                                           std::optional<Any> IR) {
+  if (shouldIgnorePassRun(PassID))
+    return;
+  assert(!Stack.empty() && Stack.back().PassID == PassID &&
+         "Unbalanced pass instrumentation");
+  ActivePassRun Active = Stack.pop_back_val();
+  double WallTime =
+      TimeRecord::getCurrentTime(false).getWallTime() - Active.StartTime;
+  if (SlowestRuns.size() == NumRuns) {
+    if (WallTime <= SlowestRuns.front().WallTime)
+      return;
+    std::pop_heap(SlowestRuns.begin(), SlowestRuns.end(), isSlower);
+    SlowestRuns.pop_back();
+  }
+
+  std::optional<int64_t> InstCountDelta;
+  if (IR)
+    InstCountDelta = int64_t(getInstructionCount(*IR)) -
+                     int64_t(Active.InstCount);
+  // The IR name is only known after the pass if it did not invalidate the IR.
+  SlowestRuns.push_back(
+      {PassID, IR ? getIRName(*IR) : "<invalidated>", WallTime,
+       InstCountDelta});
+  std::push_heap(SlowestRuns.begin(), SlowestRuns.end(), isSlower);
+}
+
+void SlowestPassRunsReporter::print() {
+  if (SlowestRuns.empty())
+    return;
+  std::unique_ptr<raw_ostream> MaybeCreated;
+  raw_ostream *OS = OutStream;
+  if (!OS) {
+    MaybeCreated = CreateInfoOutputFile();
+    OS = &*MaybeCreated;
+  }
+
+  std::sort_heap(SlowestRuns.begin(), SlowestRuns.end(), isSlower);
+  StringRef Title = "Slowest pass runs";
+  *OS << "===" << std::string(73, '-') << "===\n";
+  OS->indent((80 - Title.size()) / 2) << Title << '\n';
+  *OS << "===" << std::string(73, '-') << "===\n";
+  *OS << "   Wall Time  Inst Delta  --- Pass (IR unit) ---\n";
+  for (const PassRun &Run : SlowestRuns) {
+    std::string Delta = "-";
+    if (Run.InstCountDelta)
+      Delta = (*Run.InstCountDelta > 0 ? "+" : "") +
+              std::to_string(*Run.InstCountDelta);
+    *OS << formatv("{0,11:f4}s {1,11}  {2} ({3})\n", Run.WallTime, Delta,
+                   Run.PassID, Run.IRName);
+  }
+  *OS << '\n';
+  SlowestRuns.clear();
+}
+
 namespace {
 
 class DisplayNode;
@@ -2093,7 +2216,7 @@ StandardInstrumentations::StandardInstrumentations(
     LLVMContext &Context, bool DebugLogging, bool VerifyEach,
     PrintPassOptions PrintPassOpts)
     : PrintPass(DebugLogging, PrintPassOpts),
-      OptNone(DebugLogging),
+      SlowestPassRuns(ReportSlowestPassRuns), OptNone(DebugLogging),
       OptPassGate(Context),
       PrintChangedIR(PrintChanged == ChangePrinter::Verbose),
       PrintChangedDiff(PrintChanged == ChangePrinter::DiffVerbose ||
@@ -2175,6 +2298,7 @@ void StandardInstrumentations::registerCallbacks(
   // AfterCallbacks by its `registerCallbacks`. This is necessary
   // to ensure that other callbacks are not included in the timings.
   TimeProfilingPasses.registerCallbacks(PIC);
+  SlowestPassRuns.registerCallbacks(PIC);
 }
 
 template class ChangeReporter<std::string>;
@@ -24,6 +24,12 @@ static cl::opt<cl::boolOrDefault> EnableRemarksSection(
         "this is enabled for the following formats: yaml-strtab, bitstream."),
     cl::init(cl::BOU_UNSET), cl::Hidden);
 
+static cl::opt<unsigned> RemarksSampleRate(
+    "remarks-sample-rate",
+    cl::desc("Only emit one in every N remarks of each pass, starting with the "
+             "first one"),
+    cl::init(1), cl::Hidden);
+
 RemarkStreamer::RemarkStreamer(
     std::unique_ptr<remarks::RemarkSerializer> RemarkSerializer,
     std::optional<StringRef> FilenameIn)
@@ -48,6 +54,13 @@ bool RemarkStreamer::matchesFilter(StringRef Str) {
   return true;
 }
 
+bool RemarkStreamer::isSampled(StringRef PassName) {
+  if (RemarksSampleRate <= 1)
+    return true;
+  unsigned &Count = PassRemarkCounts[PassName];
+  return Count++ % RemarksSampleRate == 0;
+}
+
 bool RemarkStreamer::needsSection() const {
   if (EnableRemarksSection == cl::BOU_TRUE)
     return true;
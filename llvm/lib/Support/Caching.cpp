@@ -9,14 +9,20 @@
 // This file implements the localCache function, which simplifies creating,
 // adding to, and querying a local file system cache. localCache takes care of
 // periodically pruning older files from the cache using a CachePruningPolicy.
+// It also implements SharedCache and the directory-based CacheStorage.
 //
 //===----------------------------------------------------------------------===//
 
 #include "llvm/Support/Caching.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/Support/Errc.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <mutex>
 
 #if !defined(_MSC_VER) && !defined(__MINGW32__)
 #include <unistd.h>
@@ -166,3 +172,211 @@ Expected<FileCache> llvm::localCache(const Twine &CacheNameRef,
     };
   };
 }
+
+CacheStorage::~CacheStorage() = default;
+
+namespace {
+class DirectoryCacheStorage : public CacheStorage {
+  SmallString<64> Path;
+
+public:
+  DirectoryCacheStorage(const Twine &Path) : Path(Path.str()) {}
+
+  Expected<std::unique_ptr<MemoryBuffer>> get(StringRef Key) override {
+    SmallString<64> EntryPath;
+    sys::path::append(EntryPath, Path, "llvmcache-" + Key);
+    ErrorOr<std::unique_ptr<MemoryBuffer>> MBOrErr = MemoryBuffer::getFile(
+        EntryPath, /*IsText=*/false, /*RequiresNullTerminator=*/false);
+    if (MBOrErr)
+      return std::move(*MBOrErr);
+    std::error_code EC = MBOrErr.getError();
+    if (EC == errc::no_such_file_or_directory)
+      return nullptr;
+    return createStringError(EC, Twine("Failed to open shared cache file ") +
+                                     EntryPath + ": " + EC.message());
+  }
+
+  Error put(StringRef Key, StringRef Data) override {
+    if (std::error_code EC =
+            sys::fs::create_directories(Path, /*IgnoreExisting=*/true))
+      return errorCodeToError(EC);
+    SmallString<64> EntryPath, TempFilenameModel;
+    sys::path::append(EntryPath, Path, "llvmcache-" + Key);
+    sys::path::append(TempFilenameModel, Path, "llvmcache-%%%%%%.tmp");
+    // The entries use the default mode, so that the directory can be shared
+    // between users.
+    Expected<sys::fs::TempFile> Temp =
+        sys::fs::TempFile::create(TempFilenameModel);
+    if (!Temp)
+      return Temp.takeError();
+    std::error_code EC;
+    {
+      raw_fd_ostream OS(Temp->FD, /*shouldClose=*/false);
+      OS << Data;
+      OS.flush();
+      EC = OS.error();
+      // The error is reported below rather than by the stream's destructor.
+      OS.clear_error();
+    }
+    if (EC) {
+      consumeError(Temp->discard());
+      return createStringError(EC, Twine("Failed to write shared cache file ") +
+                                       EntryPath + ": " + EC.message());
+    }
+    return Temp->keep(EntryPath);
+  }
+};
+} // namespace
+
+std::unique_ptr<CacheStorage> llvm::directoryCacheStorage(const Twine &Path) {
+  return std::make_unique<DirectoryCacheStorage>(Path);
+}
+
+class SharedCache::Impl : public std::enable_shared_from_this<Impl> {
+public:
+  using FetchResult = std::shared_ptr<MemoryBuffer>;
+
+  FileCache Local;
+  std::unique_ptr<CacheStorage> Storage;
+
+  std::mutex Mu;
+  StringMap<std::shared_future<FetchResult>> Prefetched;
+  std::optional<Error> UploadErr;
+
+  ThreadPool Pool;
+
+  Impl(FileCache Local, std::unique_ptr<CacheStorage> Storage,
+       ThreadPoolStrategy S)
+      : Local(std::move(Local)), Storage(std::move(Storage)), Pool(S) {}
+  // Queued prefetches and uploads refer to this object.
+  ~Impl() { Pool.wait(); }
+
+  FetchResult fetch(StringRef Key) {
+    Expected<std::unique_ptr<MemoryBuffer>> MBOrErr = Storage->get(Key);
+    if (!MBOrErr) {
+      // An unreachable store must not fail the build; treat it as a miss.
+      consumeError(MBOrErr.takeError());
+      return nullptr;
+    }
+    return std::move(*MBOrErr);
+  }
+
+  void prefetch(StringRef Key) {
+    std::lock_guard<std::mutex> L(Mu);
+    auto [It, Inserted] = Prefetched.try_emplace(Key);
+    if (Inserted)
+      It->second = Pool.async([this, Key = Key.str()] { return fetch(Key); });
+  }
+
+  FetchResult lookup(StringRef Key) {
+    std::shared_future<FetchResult> F;
+    {
+      std::lock_guard<std::mutex> L(Mu);
+      auto It = Prefetched.find(Key);
+      if (It == Prefetched.end())
+        return fetch(Key);
+      F = std::move(It->second);
+      Prefetched.erase(It);
+    }
+    return F.get();
+  }
+
+  void upload(std::string Key, std::unique_ptr<SmallVector<char, 0>> Data) {
+    std::shared_ptr<SmallVector<char, 0>> Contents = std::move(Data);
+    Pool.async([this, Key = std::move(Key), Data = std::move(Contents)] {
+      Error E = Storage->put(Key, StringRef(Data->data(), Data->size()));
+      if (!E)
+        return;
+      std::lock_guard<std::mutex> L(Mu);
+      if (UploadErr)
+        UploadErr = joinErrors(std::move(*UploadErr), std::move(E));
+      else
+        UploadErr = std::move(E);
+    });
+  }
+
+  Expected<AddStreamFn> operator()(unsigned Task, StringRef Key,
+                                   const Twine &ModuleName);
+};
+
+Expected<AddStreamFn> SharedCache::Impl::operator()(unsigned Task,
+                                                    StringRef Key,
+                                                    const Twine &ModuleName) {
+  Expected<AddStreamFn> LocalAddStreamOrErr = Local(Task, Key, ModuleName);
+  if (!LocalAddStreamOrErr || !*LocalAddStreamOrErr)
+    return LocalAddStreamOrErr;
+  AddStreamFn LocalAddStream = std::move(*LocalAddStreamOrErr);
+
+  // On a shared hit, populate the local cache, which also adds the file to
+  // the link.
+  if (FetchResult MB = lookup(Key)) {
+    Expected<std::unique_ptr<CachedFileStream>> StreamOrErr =
+        LocalAddStream(Task, ModuleName);
+    if (!StreamOrErr)
+      return StreamOrErr.takeError();
+    *(*StreamOrErr)->OS << MB->getBuffer();
+    return AddStreamFn();
+  }
+
+  // On a miss, capture the produced contents in memory, forward them to the
+  // local cache when the stream is closed and queue them for upload.
+  struct UploadStream : CachedFileStream {
+    std::shared_ptr<Impl> Owner;
+    std::string Key;
+    std::unique_ptr<SmallVector<char, 0>> Data;
+    std::unique_ptr<CachedFileStream> LocalStream;
+
+    UploadStream(std::shared_ptr<Impl> Owner, std::string Key,
+                 std::unique_ptr<SmallVector<char, 0>> Data,
+                 std::unique_ptr<CachedFileStream> LocalStream)
+        : CachedFileStream(std::make_unique<raw_svector_ostream>(*Data),
+                           LocalStream->ObjectPathName),
+          Owner(std::move(Owner)), Key(std::move(Key)), Data(std::move(Data)),
+          LocalStream(std::move(LocalStream)) {}
+
+    ~UploadStream() {
+      OS.reset();
+      *LocalStream->OS << StringRef(Data->data(), Data->size());
+      LocalStream.reset();
+      Owner->upload(std::move(Key), std::move(Data));
+    }
+  };
+
+  return [Self = shared_from_this(), Key = Key.str(),
+          LocalAddStream = std::move(LocalAddStream)](
+             unsigned Task, const Twine &ModuleName)
+             -> Expected<std::unique_ptr<CachedFileStream>> {
+    Expected<std::unique_ptr<CachedFileStream>> StreamOrErr =
+        LocalAddStream(Task, ModuleName);
+    if (!StreamOrErr)
+      return StreamOrErr.takeError();
+    auto Data = std::make_unique<SmallVector<char, 0>>();
+    return std::make_unique<UploadStream>(Self, Key, std::move(Data),
+                                          std::move(*StreamOrErr));
+  };
+}
+
+SharedCache::SharedCache(FileCache Local, std::unique_ptr<CacheStorage> Storage,
+                         ThreadPoolStrategy S)
+    : I(std::make_shared<Impl>(std::move(Local), std::move(Storage), S)) {}
+
+SharedCache::~SharedCache() { consumeError(wait()); }
+
+void SharedCache::prefetch(StringRef Key) { I->prefetch(Key); }
+
+FileCache SharedCache::getFileCache() const {
+  return [I = I](unsigned Task, StringRef Key, const Twine &ModuleName) {
+    return (*I)(Task, Key, ModuleName);
+  };
+}
+
+Error SharedCache::wait() {
+  I->Pool.wait();
+  std::lock_guard<std::mutex> L(I->Mu);
+  I->Prefetched.clear();
+  if (!I->UploadErr)
+    return Error::success();
+  Error E = std::move(*I->UploadErr);
+  I->UploadErr.reset();
+  return E;
+}
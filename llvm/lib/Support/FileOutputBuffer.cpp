@@ -14,6 +14,8 @@
 #include "llvm/Support/Errc.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Memory.h"
+#include "llvm/Support/Parallel.h"
+#include <mutex>
 #include <system_error>
 
 #if !defined(_MSC_VER) && !defined(__MINGW32__)
@@ -73,9 +75,9 @@ private:
 class InMemoryBuffer : public FileOutputBuffer {
 public:
   InMemoryBuffer(StringRef Path, MemoryBlock Buf, std::size_t BufSize,
-                 unsigned Mode)
-      : FileOutputBuffer(Path), Buffer(Buf), BufferSize(BufSize),
-        Mode(Mode) {}
+                 unsigned Mode, bool ParallelWrite = false)
+      : FileOutputBuffer(Path), Buffer(Buf), BufferSize(BufSize), Mode(Mode),
+        ParallelWrite(ParallelWrite) {}
 
   uint8_t *getBufferStart() const override { return (uint8_t *)Buffer.base(); }
 
@@ -92,6 +94,9 @@ public:
       return Error::success();
     }
 
+    if (ParallelWrite && BufferSize > ChunkSize)
+      return commitParallel();
+
     using namespace sys::fs;
     int FD;
     std::error_code EC;
@@ -104,21 +109,70 @@ public:
   }
 
 private:
+  // Writes the buffer into a temporary file in page-aligned chunks, each
+  // through its own file descriptor so that the writes proceed concurrently,
+  // and then atomically replaces the output file.
+  Error commitParallel() {
+    using namespace sys::fs;
+    Expected<TempFile> FileOrErr =
+        TempFile::create(FinalPath + ".tmp%%%%%%%", Mode);
+    if (!FileOrErr)
+      return FileOrErr.takeError();
+    TempFile File = std::move(*FileOrErr);
+    if (std::error_code EC = resize_file(File.FD, BufferSize)) {
+      consumeError(File.discard());
+      return errorCodeToError(EC);
+    }
+
+    std::mutex Mu;
+    std::error_code FirstEC;
+    size_t NumChunks = divideCeil(BufferSize, ChunkSize);
+    parallelFor(0, NumChunks, [&](size_t I) {
+      size_t Offset = I * ChunkSize;
+      size_t Size = std::min(ChunkSize, BufferSize - Offset);
+      int FD;
+      std::error_code EC = openFileForWrite(File.TmpName, FD, CD_OpenExisting);
+      if (!EC) {
+        raw_fd_ostream OS(FD, /*shouldClose=*/true, /*unbuffered=*/true);
+        OS.seek(Offset);
+        OS << StringRef((const char *)Buffer.base() + Offset, Size);
+        OS.close();
+        EC = OS.error();
+        OS.clear_error();
+      }
+      if (EC) {
+        std::lock_guard<std::mutex> Lock(Mu);
+        if (!FirstEC)
+          FirstEC = EC;
+      }
+    });
+    if (FirstEC) {
+      consumeError(File.discard());
+      return errorCodeToError(FirstEC);
+    }
+    return File.keep(FinalPath);
+  }
+
+  // Page-aligned size of the chunk written by each task of commitParallel().
+  static constexpr size_t ChunkSize = 16 * 1024 * 1024;
+
   // Buffer may actually contain a larger memory block than BufferSize
   OwningMemoryBlock Buffer;
   size_t BufferSize;
   unsigned Mode;
+  bool ParallelWrite;
 };
 } // namespace
 
 static Expected<std::unique_ptr<InMemoryBuffer>>
-createInMemoryBuffer(StringRef Path, size_t Size, unsigned Mode) {
+createInMemoryBuffer(StringRef Path, size_t Size, unsigned Mode,
+                     bool ParallelWrite = false) {
   std::error_code EC;
   MemoryBlock MB = Memory::allocateMappedMemory(
       Size, nullptr, sys::Memory::MF_READ | sys::Memory::MF_WRITE, EC);
   if (EC)
     return errorCodeToError(EC);
-  return std::make_unique<InMemoryBuffer>(Path, MB, Size, Mode);
+  return std::make_unique<InMemoryBuffer>(Path, MB, Size, Mode, ParallelWrite);
 }
 
 static Expected<std::unique_ptr<FileOutputBuffer>>
@@ -184,7 +238,7 @@ FileOutputBuffer::create(StringRef Path, size_t Size, unsigned Flags) {
   case fs::file_type::file_not_found:
   case fs::file_type::status_error:
     if (Flags & F_no_mmap)
-      return createInMemoryBuffer(Path, Size, Mode);
+      return createInMemoryBuffer(Path, Size, Mode, Flags & F_parallel_write);
     else
       return createOnDiskBuffer(Path, Size, Mode);
   default:
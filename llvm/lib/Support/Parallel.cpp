@@ -12,8 +12,8 @@
 #include "llvm/Support/Threading.h"
 
 #include <atomic>
+#include <deque>
 #include <future>
-#include <stack>
 #include <thread>
 #include <vector>
 
@@ -40,16 +40,33 @@ class Executor {
 public:
   virtual ~Executor() = default;
   virtual void add(std::function<void()> func) = 0;
+  virtual size_t getThreadCount() const = 0;
+  /// Returns true if the calling thread is a worker of this executor.
+  virtual bool isWorkerThread() const = 0;
+  /// Return a mark for the calling worker such that tasks it spawns from now
+  /// on are eligible for runPendingTask(Mark).
+  virtual uint64_t getSpawnMark() = 0;
+  /// Run the newest task that the calling worker spawned at or after \p Mark
+  /// and return true, or return false if there is none.
+  virtual bool runPendingTask(uint64_t Mark) = 0;
 
   static Executor *getDefaultExecutor();
 };
 
-/// An implementation of an Executor that runs closures on a thread pool
-///   in filo order.
+/// An implementation of an Executor that runs closures on a thread pool.
+///
+/// Every worker has its own deque of tasks. Tasks spawned by a worker are
+/// pushed to and popped from the back of its own deque (filo order, which
+/// keeps the working set of recursive algorithms hot), while idle workers
+/// steal from the front of other workers' deques. Tasks added by threads
+/// outside the pool go to a shared queue. This avoids funneling every
+/// spawn and every task pickup through a single lock.
 class ThreadPoolExecutor : public Executor {
 public:
   explicit ThreadPoolExecutor(ThreadPoolStrategy S = hardware_concurrency()) {
     unsigned ThreadCount = S.compute_thread_count();
+    for (unsigned I = 0; I < ThreadCount; ++I)
+      Queues.push_back(std::make_unique<WorkQueue>());
     // Spawn all but one of the threads in another thread as spawning threads
     // can take a while.
     Threads.reserve(ThreadCount);
@@ -95,37 +112,121 @@ public:
   };
 
   void add(std::function<void()> F) override {
+    WorkQueue &Q = CurrentExecutor == this ? *Queues[threadIndex] : Shared;
     {
+      std::lock_guard<std::mutex> Lock(Q.Mutex);
+      Q.Tasks.push_back({Q.NextSeq++, std::move(F)});
+    }
+    // Pending and Sleepers are both sequentially consistent, so either this
+    // thread sees a sleeper that is about to wait, or the sleeper sees the new
+    // task when it checks Pending under Mutex.
+    ++Pending;
+    if (Sleepers > 0) {
       std::lock_guard<std::mutex> Lock(Mutex);
-      WorkStack.push(std::move(F));
+      Cond.notify_one();
+    }
+  }
+
+  size_t getThreadCount() const override { return Queues.size(); }
+
+  bool isWorkerThread() const override { return CurrentExecutor == this; }
+
+  uint64_t getSpawnMark() override {
+    WorkQueue &Own = *Queues[threadIndex];
+    std::lock_guard<std::mutex> Lock(Own.Mutex);
+    return Own.NextSeq;
+  }
+
+  bool runPendingTask(uint64_t Mark) override {
+    // Only tasks this worker spawned after Mark are run: they are descendants
+    // of the computation being waited for. Running an unrelated task here
+    // could deadlock if the waiting task holds a lock that task needs.
+    WorkQueue &Own = *Queues[threadIndex];
+    std::function<void()> Task;
+    {
+      std::lock_guard<std::mutex> Lock(Own.Mutex);
+      if (Own.Tasks.empty() || Own.Tasks.back().first < Mark)
+        return false;
+      Task = std::move(Own.Tasks.back().second);
+      Own.Tasks.pop_back();
     }
-    Cond.notify_one();
+    --Pending;
+    Task();
+    return true;
   }
 
 private:
+  struct WorkQueue {
+    std::mutex Mutex;
+    // Tasks with the sequence number they were added with.
+    std::deque<std::pair<uint64_t, std::function<void()>>> Tasks;
+    uint64_t NextSeq = 0;
+  };
+
+  bool popFront(WorkQueue &Q, std::function<void()> &Task) {
+    std::lock_guard<std::mutex> Lock(Q.Mutex);
+    if (Q.Tasks.empty())
+      return false;
+    Task = std::move(Q.Tasks.front().second);
+    Q.Tasks.pop_front();
+    return true;
+  }
+
+  bool popTask(unsigned ThreadID, std::function<void()> &Task) {
+    if (Pending == 0)
+      return false;
+    bool Found = false;
+    WorkQueue &Own = *Queues[ThreadID];
+    {
+      std::lock_guard<std::mutex> Lock(Own.Mutex);
+      if (!Own.Tasks.empty()) {
+        Task = std::move(Own.Tasks.back().second);
+        Own.Tasks.pop_back();
+        Found = true;
+      }
+    }
+    if (!Found)
+      Found = popFront(Shared, Task);
+    for (size_t I = 1, E = Queues.size(); !Found && I < E; ++I)
+      Found = popFront(*Queues[(ThreadID + I) % E], Task);
+    if (Found)
+      --Pending;
+    return Found;
+  }
+
   void work(ThreadPoolStrategy S, unsigned ThreadID) {
     threadIndex = ThreadID;
+    CurrentExecutor = this;
     S.apply_thread_strategy(ThreadID);
-    while (true) {
+    std::function<void()> Task;
+    while (!Stop) {
+      if (popTask(ThreadID, Task)) {
+        Task();
+        Task = nullptr;
+        continue;
+      }
       std::unique_lock<std::mutex> Lock(Mutex);
-      Cond.wait(Lock, [&] { return Stop || !WorkStack.empty(); });
-      if (Stop)
-        break;
-      auto Task = std::move(WorkStack.top());
-      WorkStack.pop();
-      Lock.unlock();
-      Task();
+      ++Sleepers;
+      Cond.wait(Lock, [&] { return Stop || Pending > 0; });
+      --Sleepers;
     }
   }
 
+  static thread_local ThreadPoolExecutor *CurrentExecutor;
+
   std::atomic<bool> Stop{false};
-  std::stack<std::function<void()>> WorkStack;
+  std::atomic<size_t> Pending{0};
+  std::atomic<unsigned> Sleepers{0};
+  std::vector<std::unique_ptr<WorkQueue>> Queues;
+  WorkQueue Shared;
   std::mutex Mutex;
   std::condition_variable Cond;
   std::promise<void> ThreadsCreated;
   std::vector<std::thread> Threads;
 };
 
+thread_local ThreadPoolExecutor *ThreadPoolExecutor::CurrentExecutor = nullptr;
+
 Executor *Executor::getDefaultExecutor() {
   // The ManagedStatic enables the ThreadPoolExecutor to be stopped via
   // llvm_shutdown() which allows a "clean" fast exit, e.g. via _exit(). This
@@ -153,34 +254,49 @@ Executor *Executor::getDefaultExecutor() {
 }
 } // namespace
 } // namespace detail
+
+size_t getThreadCount() {
+  return detail::Executor::getDefaultExecutor()->getThreadCount();
+}
 #endif
 
-static std::atomic<int> TaskGroupInstances;
+// TaskGroups may nest: a worker thread that waits for a nested group keeps
+// running the tasks it spawned for that group (see sync()) instead of
+// blocking, so the pool cannot deadlock with all of its workers waiting.
+TaskGroup::TaskGroup() {
+#if LLVM_ENABLE_THREADS
+  detail::Executor *Exec = detail::Executor::getDefaultExecutor();
+  if (Exec->isWorkerThread())
+    SpawnMark = Exec->getSpawnMark();
+#endif
+}
 
-// Latch::sync() called by the dtor may cause one thread to block. If is a dead
-// lock if all threads in the default executor are blocked. To prevent the dead
-// lock, only allow the first TaskGroup to run tasks parallelly. In the scenario
-// of nested parallel_for_each(), only the outermost one runs parallelly.
-TaskGroup::TaskGroup() : Parallel(TaskGroupInstances++ == 0) {}
-TaskGroup::~TaskGroup() {
-  // We must ensure that all the workloads have finished before decrementing the
-  // instances count.
+TaskGroup::~TaskGroup() { sync(); }
+
+void TaskGroup::sync() const {
+#if LLVM_ENABLE_THREADS
+  if (SpawnMark != NotOnWorker) {
+    // Only this thread adds tasks to its own queue, so once none of the
+    // tasks of the group are left there, the remaining ones are running on
+    // other workers and the latch can be waited for.
+    detail::Executor *Exec = detail::Executor::getDefaultExecutor();
+    while (Exec->runPendingTask(SpawnMark))
+      ;
+  }
+#endif
   L.sync();
-  --TaskGroupInstances;
 }
 
 void TaskGroup::spawn(std::function<void()> F) {
 #if LLVM_ENABLE_THREADS
-  if (Parallel) {
-    L.inc();
-    detail::Executor::getDefaultExecutor()->add([&, F = std::move(F)] {
-      F();
-      L.dec();
-    });
-    return;
-  }
-#endif
+  L.inc();
+  detail::Executor::getDefaultExecutor()->add([&, F = std::move(F)] {
+    F();
+    L.dec();
+  });
+#else
   F();
+#endif
 }
 
 void TaskGroup::execute(std::function<void()> F) {
@@ -195,9 +311,7 @@ void TaskGroup::execute(std::function<void()> F) {
 void llvm::parallelFor(size_t Begin, size_t End,
                        llvm::function_ref<void(size_t)> Fn) {
   // If we have zero or one items, then do not incur the overhead of spinning up
-  // a task group.  They are surprisingly expensive, and because they do not
-  // support nested parallelism, a single entry task group can block parallel
-  // execution underneath them.
+  // a task group.  They are surprisingly expensive.
 #if LLVM_ENABLE_THREADS
   auto NumItems = End - Begin;
   if (NumItems > 1 && parallel::strategy.ThreadsRequested != 1) {
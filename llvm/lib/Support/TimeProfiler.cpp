@@ -63,19 +63,23 @@ using DurationType = duration<ClockType::rep, ClockType::period>;
 using CountAndDurationType = std::pair<size_t, DurationType>;
 using NameAndCountAndDurationType =
     std::pair<std::string, CountAndDurationType>;
+using NameEntryType = StringMapEntry<CountAndDurationType>;
 
 /// Represents an open or completed time section entry to be captured.
 struct TimeTraceProfilerEntry {
   const TimePointType Start;
   TimePointType End;
-  const std::string Name;
+  /// The interned name of the section, which also holds its totals.
+  NameEntryType *NameEntry;
   const std::string Detail;
 
-  TimeTraceProfilerEntry(TimePointType &&S, TimePointType &&E, std::string &&N,
-                         std::string &&Dt)
-      : Start(std::move(S)), End(std::move(E)), Name(std::move(N)),
+  TimeTraceProfilerEntry(TimePointType &&S, TimePointType &&E,
+                         NameEntryType *N, std::string &&Dt)
+      : Start(std::move(S)), End(std::move(E)), NameEntry(N),
         Detail(std::move(Dt)) {}
 
+  StringRef getName() const { return NameEntry->getKey(); }
+
   // Calculate timings for FlameGraph. Cast time points to microsecond precision
   // rather than casting duration. This avoids truncation issues causing inner
   // scopes overruning outer scopes.
@@ -102,9 +106,11 @@ struct llvm::TimeTraceProfiler {
     llvm::get_thread_name(ThreadName);
   }
 
-  void begin(std::string Name, llvm::function_ref<std::string()> Detail) {
-    Stack.emplace_back(ClockType::now(), TimePointType(), std::move(Name),
-                       Detail());
+  void begin(StringRef Name, llvm::function_ref<std::string()> Detail) {
+    // Section names are few and repeated often: intern them, so that ending a
+    // section neither copies nor hashes its name.
+    NameEntryType *NameEntry = &*CountAndTotalPerName.try_emplace(Name).first;
+    Stack.emplace_back(ClockType::now(), TimePointType(), NameEntry, Detail());
   }
 
   void end() {
@@ -133,9 +139,9 @@ struct llvm::TimeTraceProfiler {
     // itself.
     if (llvm::none_of(llvm::drop_begin(llvm::reverse(Stack)),
                       [&](const TimeTraceProfilerEntry &Val) {
-                        return Val.Name == E.Name;
+                        return Val.NameEntry == E.NameEntry;
                       })) {
-      auto &CountAndTotal = CountAndTotalPerName[E.Name];
+      auto &CountAndTotal = E.NameEntry->second;
       CountAndTotal.first++;
       CountAndTotal.second += Duration;
     }
@@ -171,7 +177,7 @@ struct llvm::TimeTraceProfiler {
         J.attribute("ph", "X");
         J.attribute("ts", StartUs);
         J.attribute("dur", DurUs);
-        J.attribute("name", E.Name);
+        J.attribute("name", E.getName());
         if (!E.Detail.empty()) {
           J.attributeObject("args", [&] { J.attribute("detail", E.Detail); });
         }
@@ -195,6 +201,9 @@ struct llvm::TimeTraceProfiler {
     auto combineStat = [&](const auto &Stat) {
       StringRef Key = Stat.getKey();
       auto Value = Stat.getValue();
+      // Names of sections that were never ended have no totals.
+      if (!Value.first)
+        return;
       auto &CountAndTotal = AllCountAndTotalPerName[Key];
       CountAndTotal.first += Value.first;
       CountAndTotal.second += Value.second;
@@ -271,6 +280,7 @@ struct llvm::TimeTraceProfiler {
 
   SmallVector<TimeTraceProfilerEntry, 16> Stack;
   SmallVector<TimeTraceProfilerEntry, 128> Entries;
+  // Interned section names, with the totals of their topmost sections.
   StringMap<CountAndDurationType> CountAndTotalPerName;
   // System clock time when the session was begun.
   const time_point<system_clock> BeginningOfTime;
@@ -343,14 +353,14 @@ Error llvm::timeTraceProfilerWrite(StringRef PreferredFileName,
 
 void llvm::timeTraceProfilerBegin(StringRef Name, StringRef Detail) {
   if (TimeTraceProfilerInstance != nullptr)
-    TimeTraceProfilerInstance->begin(std::string(Name),
+    TimeTraceProfilerInstance->begin(Name,
                                      [&]() { return std::string(Detail); });
 }
 
 void llvm::timeTraceProfilerBegin(StringRef Name,
                                   llvm::function_ref<std::string()> Detail) {
   if (TimeTraceProfilerInstance != nullptr)
-    TimeTraceProfilerInstance->begin(std::string(Name), Detail);
+    TimeTraceProfilerInstance->begin(Name, Detail);
 }
 
 void llvm::timeTraceProfilerEnd() {
@@ -43,6 +43,75 @@ void X86InstrPostProcess::postProcessInstruction(
   setMemBarriers(Inst, MCI);
 }
 
+bool X86InstrPostProcess::getMemoryAccess(const MCInst &MCI,
+                                          MemoryAccess &Access) const {
+  const MCInstrDesc &Desc = MCII.get(MCI.getOpcode());
+  int MemOpNo = X86II::getMemoryOperandNo(Desc.TSFlags);
+  if (MemOpNo < 0)
+    return false;
+  MemOpNo += X86II::getOperandBias(Desc);
+  if (MemOpNo + X86::AddrNumOperands > (int)MCI.getNumOperands())
+    return false;
+
+  const MCOperand &Base = MCI.getOperand(MemOpNo + X86::AddrBaseReg);
+  const MCOperand &Scale = MCI.getOperand(MemOpNo + X86::AddrScaleAmt);
+  const MCOperand &Index = MCI.getOperand(MemOpNo + X86::AddrIndexReg);
+  const MCOperand &Disp = MCI.getOperand(MemOpNo + X86::AddrDisp);
+  const MCOperand &Segment = MCI.getOperand(MemOpNo + X86::AddrSegmentReg);
+
+  // Symbolic displacements, RIP-relative addresses and segment overrides
+  // can't be compared with the other addresses.
+  if (!Base.isReg() || !Scale.isImm() || !Index.isReg() || !Disp.isImm() ||
+      !Segment.isReg() || Segment.getReg() || Base.getReg() == X86::RIP ||
+      Base.getReg() == X86::EIP)
+    return false;
+
+  Access.BaseReg = Base.getReg();
+  Access.IndexReg = Index.getReg();
+  Access.Scale = Scale.getImm();
+  Access.Displacement = Disp.getImm();
+  return true;
+}
+
+bool X86InstrPostProcess::isRegisterIncrement(const MCInst &MCI,
+                                              MCRegister &Reg,
+                                              int64_t &Offset) const {
+  switch (MCI.getOpcode()) {
+  case X86::ADD64ri8:
+  case X86::ADD64ri32:
+  case X86::SUB64ri8:
+  case X86::SUB64ri32: {
+    if (!MCI.getOperand(2).isImm())
+      return false;
+    Reg = MCI.getOperand(0).getReg();
+    Offset = MCI.getOperand(2).getImm();
+    if (MCI.getOpcode() == X86::SUB64ri8 || MCI.getOpcode() == X86::SUB64ri32)
+      Offset = -Offset;
+    return true;
+  }
+  case X86::INC64r:
+  case X86::DEC64r:
+    Reg = MCI.getOperand(0).getReg();
+    Offset = MCI.getOpcode() == X86::INC64r ? 1 : -1;
+    return true;
+  case X86::LEA64r: {
+    // lea Disp(%reg), %reg
+    MCRegister Dst = MCI.getOperand(0).getReg();
+    const MCOperand &Base = MCI.getOperand(1 + X86::AddrBaseReg);
+    const MCOperand &Index = MCI.getOperand(1 + X86::AddrIndexReg);
+    const MCOperand &Disp = MCI.getOperand(1 + X86::AddrDisp);
+    const MCOperand &Segment = MCI.getOperand(1 + X86::AddrSegmentReg);
+    if (Base.getReg() != Dst || Index.getReg() || !Disp.isImm() ||
+        Segment.getReg())
+      return false;
+    Reg = Dst;
+    Offset = Disp.getImm();
+    return true;
+  }
+  }
+  return false;
+}
+
 } // namespace mca
 } // namespace llvm
 
@@ -37,6 +37,11 @@ public:
 
   void postProcessInstruction(std::unique_ptr<Instruction> &Inst,
                               const MCInst &MCI) override;
+
+  bool getMemoryAccess(const MCInst &MCI, MemoryAccess &Access) const override;
+
+  bool isRegisterIncrement(const MCInst &MCI, MCRegister &Reg,
+                           int64_t &Offset) const override;
 };
 
 } // namespace mca
@@ -40,6 +40,7 @@
 #include "llvm/Support/Error.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Transforms/IPO/Internalize.h"
@@ -508,7 +509,10 @@ static void computeImportForFunction(
 
     const auto AdjThreshold = GetAdjustedThreshold(Threshold, IsHotCallsite);
 
-    ImportCount++;
+    // Only maintained for -import-cutoff, which forces a serial import
+    // computation; modules may otherwise be processed concurrently.
+    if (ImportCutoff >= 0)
+      ImportCount++;
 
     // Insert the newly imported function to the worklist.
     Worklist.emplace_back(ResolvedCalleeSummary, AdjThreshold);
@@ -656,14 +660,38 @@ void llvm::ComputeCrossModuleImport(
     StringMap<FunctionImporter::ImportMapTy> &ImportLists,
     StringMap<FunctionImporter::ExportSetTy> &ExportLists) {
   // For each module that has function defined, compute the import/export lists.
+  // This only reads the index, so modules are processed in parallel. Each
+  // module records the values it exports from other modules in its own map, and
+  // the maps are merged afterwards in module order. -import-cutoff counts
+  // imports across modules and the debug output is per module, so fall back to
+  // a serial walk when either is requested.
+  std::vector<const StringMapEntry<GVSummaryMapTy> *> Modules;
+  std::vector<FunctionImporter::ImportMapTy *> ModuleImportLists;
   for (const auto &DefinedGVSummaries : ModuleToDefinedGVSummaries) {
-    auto &ImportList = ImportLists[DefinedGVSummaries.first()];
-    LLVM_DEBUG(dbgs() << "Computing import for Module '"
-                      << DefinedGVSummaries.first() << "'\n");
-    ComputeImportForModule(DefinedGVSummaries.second, Index,
-                           DefinedGVSummaries.first(), ImportList,
-                           &ExportLists);
+    Modules.push_back(&DefinedGVSummaries);
+    ModuleImportLists.push_back(&ImportLists[DefinedGVSummaries.first()]);
   }
+  std::vector<StringMap<FunctionImporter::ExportSetTy>> ModuleExportLists(
+      Modules.size());
+  auto ComputeForModule = [&](size_t I) {
+    LLVM_DEBUG(dbgs() << "Computing import for Module '"
+                      << Modules[I]->first() << "'\n");
+    ComputeImportForModule(Modules[I]->second, Index, Modules[I]->first(),
+                           *ModuleImportLists[I], &ModuleExportLists[I]);
+  };
+  bool Serial = ImportCutoff >= 0 || PrintImportFailures;
+  LLVM_DEBUG(Serial = true);
+  if (Serial)
+    for (size_t I = 0, E = Modules.size(); I != E; ++I)
+      ComputeForModule(I);
+  else
+    parallelFor(0, Modules.size(), ComputeForModule);
+  for (StringMap<FunctionImporter::ExportSetTy> &ModuleExports :
+       ModuleExportLists)
+    for (auto &ExportPerModule : ModuleExports)
+      ExportLists[ExportPerModule.first()].insert(
+          ExportPerModule.second.begin(), ExportPerModule.second.end());
+  ModuleExportLists.clear();
 
   // When computing imports we only added the variables and functions being
   // imported to the export list. We also need to mark any references and calls
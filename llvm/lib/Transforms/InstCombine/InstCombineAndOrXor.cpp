@@ -3763,6 +3763,7 @@ Value *InstCombinerImpl::foldXorOfICmps(ICmpInst *LHS, ICmpInst *RHS,
       if (X && Y && (Y->hasOneUse() || canFreelyInvertAllUsersOf(Y, &I))) {
         // Invert the predicate of 'Y', thus inverting its output.
         Y->setPredicate(Y->getInversePredicate());
+        invalidateKnownBits(Y);
         // So, are there other uses of Y?
         if (!Y->hasOneUse()) {
           // We need to adapt other uses of Y though. Get a value that matches
@@ -4160,6 +4161,7 @@ Instruction *InstCombinerImpl::foldNot(BinaryOperator &I) {
        InstCombiner::canFreelyInvertAllUsersOf(cast<Instruction>(NotOp),
                                                /*IgnoredUser=*/nullptr))) {
     cast<CmpInst>(NotOp)->setPredicate(CmpInst::getInversePredicate(Pred));
+    invalidateKnownBits(NotOp);
     freelyInvertAllUsersOf(NotOp);
     return &I;
   }
@@ -4232,6 +4234,7 @@ Instruction *InstCombinerImpl::foldNot(BinaryOperator &I) {
           CmpF->setPredicate(CmpF->getInversePredicate());
         else
           Sel->setFalseValue(ConstantExpr::getNot(cast<Constant>(FV)));
+        invalidateKnownBits(Sel);
         return replaceInstUsesWith(I, Sel);
       }
     }
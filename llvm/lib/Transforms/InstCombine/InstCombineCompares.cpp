@@ -5393,8 +5393,10 @@ static Instruction *processUMulZExtIdiom(ICmpInst &I, Value *MulVal,
       if (TruncInst *TI = dyn_cast<TruncInst>(U)) {
         if (TI->getType()->getPrimitiveSizeInBits() == MulWidth)
           IC.replaceInstUsesWith(*TI, Mul);
-        else
+        else {
           TI->setOperand(0, Mul);
+          IC.invalidateKnownBits(TI);
+        }
       } else if (BinaryOperator *BO = dyn_cast<BinaryOperator>(U)) {
         assert(BO->getOpcode() == Instruction::And);
         // Replace (mul & mask) --> zext (mul.with.overflow & short_mask)
@@ -5988,6 +5990,7 @@ CmpInst *InstCombinerImpl::canonicalizeICmpPredicate(CmpInst &I) {
   // Let's first invert the comparison's predicate.
   I.setPredicate(CmpInst::getInversePredicate(Pred));
   I.setName(I.getName() + ".not");
+  invalidateKnownBits(&I);
 
   // And, adapt users.
   freelyInvertAllUsersOf(&I);
@@ -1294,6 +1294,8 @@ Instruction *InstCombinerImpl::foldSelectValueEquivalence(SelectInst &Sel,
                              /* AllowRefinement */ false) == TrueVal ||
       simplifyWithOpReplaced(FalseVal, CmpRHS, CmpLHS, SQ,
                              /* AllowRefinement */ false) == TrueVal) {
+    // The flags of FalseVal stay dropped.
+    invalidateKnownBits(FalseInst);
     return replaceInstUsesWith(Sel, FalseVal);
   }
 
@@ -1651,8 +1653,11 @@ Instruction *InstCombinerImpl::foldSelectInstWithICmp(SelectInst &SI,
   if (Instruction *NewSPF = canonicalizeSPF(SI, *ICI, *this))
     return NewSPF;
 
-  if (Value *V = foldSelectInstWithICmpConst(SI, ICI, Builder))
+  if (Value *V = foldSelectInstWithICmpConst(SI, ICI, Builder)) {
+    // The poison-generating flags of V were dropped.
+    invalidateKnownBits(V);
     return replaceInstUsesWith(SI, V);
+  }
 
   if (Value *V = canonicalizeClampLike(SI, *ICI, Builder))
     return replaceInstUsesWith(SI, V);
@@ -1662,6 +1667,8 @@ Instruction *InstCombinerImpl::foldSelectInstWithICmp(SelectInst &SI,
     return NewSel;
 
   bool Changed = adjustMinMax(SI, *ICI);
+  if (Changed)
+    invalidateKnownBits(ICI);
 
   if (Value *V = foldSelectICmpAnd(SI, ICI, Builder))
     return replaceInstUsesWith(SI, V);
@@ -670,6 +670,8 @@ static Value *getShiftedValue(Value *V, unsigned NumBits, bool isLeftShift,
 
   Instruction *I = cast<Instruction>(V);
   IC.addToWorklist(I);
+  // I is rewritten in place below, without any known bits query in between.
+  IC.invalidateKnownBits(I);
 
   switch (I->getOpcode()) {
   default: llvm_unreachable("Inconsistency with CanEvaluateShifted");
@@ -60,7 +60,11 @@ bool InstCombinerImpl::SimplifyDemandedInstructionBits(Instruction &Inst) {
   Value *V = SimplifyDemandedUseBits(&Inst, DemandedMask, Known,
                                      0, &Inst);
   if (!V) return false;
-  if (V == &Inst) return true;
+  if (V == &Inst) {
+    // The operands or the flags of Inst changed in place.
+    invalidateKnownBits(&Inst);
+    return true;
+  }
   replaceInstUsesWith(Inst, V);
   return true;
 }
@@ -78,6 +82,8 @@ bool InstCombinerImpl::SimplifyDemandedBits(Instruction *I, unsigned OpNo,
   if (Instruction* OpInst = dyn_cast<Instruction>(U))
     salvageDebugInfo(*OpInst);
 
+  // The operand may have been modified in place rather than replaced.
+  invalidateKnownBits(U.get());
   replaceUse(U, NewVal);
   return true;
 }
@@ -1725,5 +1731,8 @@ Value *InstCombinerImpl::SimplifyDemandedVectorElts(Value *V,
   if (UndefElts.isAllOnes())
     return UndefValue::get(I->getType());;
 
-  return MadeChange ? I : nullptr;
+  if (!MadeChange)
+    return nullptr;
+  invalidateKnownBits(I);
+  return I;
 }
@@ -49,6 +49,7 @@
 #include "llvm/Analysis/ConstantFolding.h"
 #include "llvm/Analysis/GlobalsModRef.h"
 #include "llvm/Analysis/InstructionSimplify.h"
+#include "llvm/Analysis/KnownBitsCache.h"
 #include "llvm/Analysis/LazyBlockFrequencyInfo.h"
 #include "llvm/Analysis/LoopInfo.h"
 #include "llvm/Analysis/MemoryBuiltins.h"
@@ -155,6 +156,22 @@ static cl::opt<unsigned> InfiniteLoopDetectionThreshold(
              "infinite loop"),
     cl::init(InstCombineDefaultInfiniteLoopThreshold), cl::Hidden);
 
+// An iteration after one that changed the IR only finds more work if some
+// combine did not add the instructions it affected back to the worklist. This
+// option runs that extra iteration past the limit and reports an error if it
+// changes anything, so that missing worklist additions can be found with
+// -instcombine-max-iterations=1.
+static cl::opt<bool> VerifyFixpoint(
+    "instcombine-verify-fixpoint",
+    cl::desc("Report an error if instcombine does not reach a fixpoint "
+             "within -instcombine-max-iterations"),
+    cl::init(false), cl::Hidden);
+
+static cl::opt<bool> EnableKnownBitsCache(
+    "instcombine-cache-known-bits",
+    cl::desc("Cache the known bits and sign bits queries of instcombine"),
+    cl::init(false), cl::Hidden);
+
 static cl::opt<unsigned>
 MaxArraySize("instcombine-maxarray-size", cl::init(1024),
              cl::desc("Maximum array size considered when doing a combine"));
@@ -3213,6 +3230,7 @@ Instruction *InstCombinerImpl::visitBranchInst(BranchInst &BI) {
     // Swap destinations and condition.
     auto *Cmp = cast<CmpInst>(Cond);
     Cmp->setPredicate(CmpInst::getInversePredicate(Pred));
+    invalidateKnownBits(Cmp);
     BI.swapSuccessors();
     Worklist.push(Cmp);
     return &BI;
@@ -3848,6 +3866,7 @@ InstCombinerImpl::pushFreezeToPreventPoisonFromPropagating(FreezeInst &OrigFI) {
   }
 
   OrigOpInst->dropPoisonGeneratingFlagsAndMetadata();
+  invalidateKnownBits(OrigOpInst);
 
   // If all operands are guaranteed to be non-poison, we can drop freeze.
   if (!MaybePoisonOperand)
@@ -3917,8 +3936,10 @@ Instruction *InstCombinerImpl::foldFreezeIntoRecurrence(FreezeInst &FI,
     append_range(Worklist, I->operands());
   }
 
-  for (Instruction *I : DropFlags)
+  for (Instruction *I : DropFlags) {
     I->dropPoisonGeneratingFlagsAndMetadata();
+    invalidateKnownBits(I);
+  }
 
   if (StartNeedsFreeze) {
     Builder.SetInsertPoint(StartBB->getTerminator());
@@ -4391,6 +4412,11 @@ bool InstCombinerImpl::run() {
         }
       }
       MadeIRChange = true;
+
+      // The combine may have modified instructions in place, changing the
+      // known bits of their users.
+      if (KBCache)
+        KBCache->clear();
     }
   }
 
@@ -4582,7 +4608,8 @@ static bool combineInstructionsOverFunction(
     Function &F, InstructionWorklist &Worklist, AliasAnalysis *AA,
     AssumptionCache &AC, TargetLibraryInfo &TLI, TargetTransformInfo &TTI,
     DominatorTree &DT, OptimizationRemarkEmitter &ORE, BlockFrequencyInfo *BFI,
-    ProfileSummaryInfo *PSI, unsigned MaxIterations, LoopInfo *LI) {
+    ProfileSummaryInfo *PSI, unsigned MaxIterations, LoopInfo *LI,
+    KnownBitsCache *KBCache) {
   auto &DL = F.getParent()->getDataLayout();
   MaxIterations = std::min(MaxIterations, LimitMaxIterations.getValue());
 
@@ -4621,7 +4648,8 @@ static bool combineInstructionsOverFunction(
           Twine(InfiniteLoopDetectionThreshold) + " iterations.");
     }
 
-    if (Iteration > MaxIterations) {
+    // When verifying, run one more iteration to check that it changes nothing.
+    if (Iteration > MaxIterations && !VerifyFixpoint) {
       LLVM_DEBUG(dbgs() << "\n\n[IC] Iteration limit #" << MaxIterations
                         << " on " << F.getName()
                         << " reached; stopping before reaching a fixpoint\n");
@@ -4636,10 +4664,18 @@ static bool combineInstructionsOverFunction(
     InstCombinerImpl IC(Worklist, Builder, F.hasMinSize(), AA, AC, TLI, TTI, DT,
                         ORE, BFI, PSI, DL, LI);
     IC.MaxArraySizeForCombine = MaxArraySize;
+    IC.KBCache = KBCache;
 
     if (!IC.run())
       break;
 
+    if (Iteration > MaxIterations) {
+      report_fatal_error("Instruction Combining did not reach a fixpoint "
+                         "after " +
+                         Twine(MaxIterations) + " iterations on " +
+                         F.getName());
+    }
+
     MadeIRChange = true;
   }
 
@@ -4667,9 +4703,12 @@ PreservedAnalyses InstCombinePass::run(Function &F,
       MAMProxy.getCachedResult<ProfileSummaryAnalysis>(*F.getParent());
   auto *BFI = (PSI && PSI->hasProfileSummary()) ?
       &AM.getResult<BlockFrequencyAnalysis>(F) : nullptr;
+  auto *KBCache = EnableKnownBitsCache
+                      ? &AM.getResult<KnownBitsCacheAnalysis>(F)
+                      : nullptr;
 
   if (!combineInstructionsOverFunction(F, Worklist, AA, AC, TLI, TTI, DT, ORE,
-                                       BFI, PSI, MaxIterations, LI))
+                                       BFI, PSI, MaxIterations, LI, KBCache))
     // No changes, all analyses are preserved.
     return PreservedAnalyses::all();
 
@@ -4717,8 +4756,13 @@ bool InstructionCombiningPass::runOnFunction(Function &F) {
       &getAnalysis<LazyBlockFrequencyInfoPass>().getBFI() :
       nullptr;
 
+  std::optional<KnownBitsCache> KBCache;
+  if (EnableKnownBitsCache)
+    KBCache.emplace(F.getParent()->getDataLayout(), &AC, &DT);
+
   return combineInstructionsOverFunction(F, Worklist, AA, AC, TLI, TTI, DT, ORE,
-                                         BFI, PSI, MaxIterations, LI);
+                                         BFI, PSI, MaxIterations, LI,
+                                         KBCache ? &*KBCache : nullptr);
 }
 
 char InstructionCombiningPass::ID = 0;
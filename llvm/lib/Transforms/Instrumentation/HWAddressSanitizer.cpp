@@ -15,9 +15,11 @@
 #include "llvm/ADT/MapVector.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Analysis/GlobalsModRef.h"
+#include "llvm/Analysis/OptimizationRemarkEmitter.h"
 #include "llvm/Analysis/PostDominators.h"
 #include "llvm/Analysis/StackSafetyAnalysis.h"
 #include "llvm/Analysis/ValueTracking.h"
@@ -231,11 +233,23 @@ static cl::opt<bool> ClInlineAllChecks("hwasan-inline-all-checks",
                                        cl::desc("inline all checks"),
                                        cl::Hidden, cl::init(false));
 
+static cl::opt<bool> ClOptSameTemp(
+    "hwasan-opt-same-temp",
+    cl::desc("Skip the check of an access when the same pointer was already "
+             "checked for at least as many bytes earlier in the basic block, "
+             "with no call in between, on the targets that ignore the tag of "
+             "the pointers"),
+    cl::Hidden, cl::init(false));
+
 // Enabled from clang by "-fsanitize-hwaddress-experimental-aliasing".
 static cl::opt<bool> ClUsePageAliases("hwasan-experimental-use-page-aliases",
                                       cl::desc("Use page aliasing in HWASan"),
                                       cl::Hidden, cl::init(false));
 
+STATISTIC(NumInstrumentedAccesses, "Number of instrumented accesses");
+STATISTIC(NumSkippedRedundantChecks,
+          "Number of accesses whose check was redundant");
+
 namespace {
 
 bool shouldUsePageAliases(const Triple &TargetTriple) {
@@ -793,9 +807,15 @@ static size_t TypeSizeToSizeIndex(uint32_t TypeSize) {
   return Res;
 }
 
+/// Return true if the hardware of \p TargetTriple ignores the tag of the
+/// pointers it accesses, so that the accesses need not be untagged.
+static bool ignoresPointerTags(const Triple &TargetTriple) {
+  return TargetTriple.isAArch64() || TargetTriple.getArch() == Triple::x86_64 ||
+         TargetTriple.isRISCV64();
+}
+
 void HWAddressSanitizer::untagPointerOperand(Instruction *I, Value *Addr) {
-  if (TargetTriple.isAArch64() || TargetTriple.getArch() == Triple::x86_64 ||
-      TargetTriple.isRISCV64())
+  if (ignoresPointerTags(TargetTriple))
     return;
 
   IRBuilder<> IRB(I);
@@ -1416,6 +1436,15 @@ bool HWAddressSanitizer::sanitizeFunction(Function &F,
   SmallVector<MemIntrinsic *, 16> IntrinToInstrument;
   SmallVector<Instruction *, 8> LandingPadVec;
 
+  // The pointers checked so far in the current basic block, with the number of
+  // bytes they were checked for.
+  SmallDenseMap<Value *, uint64_t, 16> CheckedTemps;
+  BasicBlock *CurrentBB = nullptr;
+  unsigned NumSkipped = 0;
+  // The accesses whose check is skipped are not untagged either, so they are
+  // only skipped if the hardware ignores the tags.
+  bool SkipRedundantChecks = ClOptSameTemp && ignoresPointerTags(TargetTriple);
+
   memtag::StackInfoBuilder SIB(SSI);
   for (auto &Inst : instructions(F)) {
     if (InstrumentStack) {
@@ -1425,7 +1454,34 @@ bool HWAddressSanitizer::sanitizeFunction(Function &F,
     if (InstrumentLandingPads && isa<LandingPadInst>(Inst))
       LandingPadVec.push_back(&Inst);
 
+    if (Inst.getParent() != CurrentBB) {
+      CurrentBB = Inst.getParent();
+      CheckedTemps.clear();
+    }
+    size_t FirstOperand = OperandsToInstrument.size();
     getInterestingMemoryOperands(&Inst, OperandsToInstrument);
+    if (SkipRedundantChecks) {
+      // Drop the operands already covered by an earlier check. Masked
+      // operands are not instrumented and don't cover anything.
+      auto IsRedundant = [&](InterestingMemoryOperand &O) {
+        if (O.MaybeMask)
+          return false;
+        uint64_t &CheckedBits = CheckedTemps[O.getPtr()];
+        if (CheckedBits >= O.TypeSize)
+          return true;
+        CheckedBits = O.TypeSize;
+        return false;
+      };
+      auto *NewEnd = std::remove_if(
+          OperandsToInstrument.begin() + FirstOperand,
+          OperandsToInstrument.end(), IsRedundant);
+      NumSkipped += OperandsToInstrument.end() - NewEnd;
+      OperandsToInstrument.erase(NewEnd, OperandsToInstrument.end());
+      // Calls may free or retag memory, including the lifetime intrinsics for
+      // stack variables.
+      if (isa<CallBase>(Inst) && !isa<DbgInfoIntrinsic>(Inst))
+        CheckedTemps.clear();
+    }
 
     if (MemIntrinsic *MI = dyn_cast<MemIntrinsic>(&Inst))
       if (!ignoreMemIntrinsic(MI))
@@ -1484,8 +1540,19 @@ bool HWAddressSanitizer::sanitizeFunction(Function &F,
     }
   }
 
+  unsigned NumInstrumented = 0;
   for (auto &Operand : OperandsToInstrument)
-    instrumentMemAccess(Operand);
+    NumInstrumented += instrumentMemAccess(Operand);
+  NumInstrumentedAccesses += NumInstrumented;
+  NumSkippedRedundantChecks += NumSkipped;
+
+  auto &ORE = FAM.getResult<OptimizationRemarkEmitterAnalysis>(F);
+  ORE.emit([&]() {
+    return OptimizationRemarkAnalysis(DEBUG_TYPE, "Checks", &F)
+           << "instrumented " << ore::NV("NumChecks", NumInstrumented)
+           << " memory accesses, skipped "
+           << ore::NV("NumSkippedChecks", NumSkipped) << " redundant checks";
+  });
 
   if (ClInstrumentMemIntrinsics && !IntrinToInstrument.empty()) {
     for (auto *Inst : IntrinToInstrument)
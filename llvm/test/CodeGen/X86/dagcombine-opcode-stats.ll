@@ -0,0 +1,17 @@
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -combiner-report-opcode-stats -o /dev/null 2>&1 | FileCheck %s
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -o /dev/null 2>&1 | FileCheck %s --check-prefix=NOSTATS --allow-empty
+
+; The two adds are reassociated into one by the combiner, which is counted as a
+; combine of an add.
+
+; CHECK:      DAG combiner statistics by opcode
+; CHECK:      Visits     Combines    Time (ms)  Opcode
+; CHECK:      {{^ +[0-9]+ +[1-9][0-9]* +[0-9]+\.[0-9]{3}  add$}}
+
+; NOSTATS-NOT: DAG combiner statistics by opcode
+
+define i32 @reassociate(i32 %x) {
+  %a = add i32 %x, 1
+  %b = add i32 %a, 2
+  ret i32 %b
+}
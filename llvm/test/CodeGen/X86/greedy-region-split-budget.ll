@@ -0,0 +1,26 @@
+; REQUIRES: asserts
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -stats 2>&1 | FileCheck %s --check-prefix=UNLIMITED
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -stats -greedy-region-split-budget=1 2>&1 | FileCheck %s --check-prefix=BUDGET
+
+; %x is live through a loop which clobbers every register, so it is split.
+; With a budget of one candidate, the function runs out of it at the first
+; region split.
+
+; UNLIMITED-NOT: Number of functions that exceeded the region split budget
+; BUDGET: 1 regalloc - Number of functions that exceeded the region split budget
+
+define i64 @live_through_clobbering_loop(i64 %x, i64 %n) nounwind {
+entry:
+  br label %loop
+
+loop:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]
+  call void asm sideeffect "", "~{rax},~{rbx},~{rcx},~{rdx},~{rsi},~{rdi},~{rbp},~{r8},~{r9},~{r10},~{r11},~{r12},~{r13},~{r14},~{r15}"()
+  %i.next = add i64 %i, 1
+  %cond = icmp ult i64 %i.next, %n
+  br i1 %cond, label %loop, label %exit
+
+exit:
+  %r = add i64 %x, %i.next
+  ret i64 %r
+}
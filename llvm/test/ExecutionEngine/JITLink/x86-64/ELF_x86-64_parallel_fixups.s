@@ -0,0 +1,36 @@
+# RUN: llvm-mc -triple=x86_64-unknown-linux -position-independent \
+# RUN:   -filetype=obj -o %t %s
+# RUN: llvm-jitlink -noexec -check %s %t
+#
+# Check that a graph with enough edges to be fixed up in parallel is fixed up
+# correctly, including in a block whose edges are split across several chunks.
+
+        .text
+        .globl  main
+        .p2align        4, 0x90
+        .type   main,@function
+main:
+        xorl    %eax, %eax
+        retq
+        .size   main, .-main
+
+        .globl  foo
+        .p2align        4, 0x90
+        .type   foo,@function
+foo:
+        retq
+        .size   foo, .-foo
+
+# jitlink-check: *{8}ptrs = main
+# jitlink-check: *{8}(ptrs + 32760) = foo
+# jitlink-check: *{8}(ptrs + 32768) = main
+# jitlink-check: *{8}(ptrs + 159992) = foo
+        .data
+        .globl  ptrs
+        .p2align        3
+ptrs:
+        .rept   10000
+        .quad   main
+        .quad   foo
+        .endr
+        .size   ptrs, .-ptrs
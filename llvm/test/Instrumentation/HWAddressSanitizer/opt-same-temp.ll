@@ -0,0 +1,95 @@
+; Test that -hwasan-opt-same-temp skips the checks that are redundant within
+; a basic block.
+;
+; RUN: opt < %s -passes=hwasan -hwasan-instrument-with-calls -S \
+; RUN:   | FileCheck %s --check-prefixes=CHECK,NOOPT
+; RUN: opt < %s -passes=hwasan -hwasan-instrument-with-calls \
+; RUN:   -hwasan-opt-same-temp -S | FileCheck %s --check-prefixes=CHECK,OPT
+; RUN: opt < %s -passes=hwasan -hwasan-instrument-with-calls \
+; RUN:   -hwasan-opt-same-temp -mtriple=x86_64-unknown-linux-gnu -S \
+; RUN:   | FileCheck %s --check-prefixes=CHECK,OPT
+; RUN: opt < %s -passes=hwasan -hwasan-instrument-with-calls \
+; RUN:   -hwasan-opt-same-temp -pass-remarks-analysis=hwasan \
+; RUN:   -disable-output 2>&1 | FileCheck %s --check-prefix=REMARK
+
+target datalayout = "e-m:e-i8:8:32-i16:16:32-i64:64-i128:128-n32:64-S128"
+target triple = "aarch64--linux-android10000"
+
+declare void @g()
+
+; CHECK-LABEL: @same_ptr(
+; CHECK: ptrtoint ptr %p to i64
+; CHECK-NEXT: call void @__hwasan_load4(
+; CHECK-NEXT: load i32, ptr %p
+; NOOPT-NEXT: ptrtoint ptr %p to i64
+; NOOPT-NEXT: call void @__hwasan_load4(
+; CHECK-NEXT: load i32, ptr %p
+; CHECK-NEXT: add i32
+; NOOPT-NEXT: ptrtoint ptr %p to i64
+; NOOPT-NEXT: call void @__hwasan_store4(
+; CHECK-NEXT: store i32
+; CHECK-NEXT: ret void
+; REMARK: remark: {{.*}}instrumented 1 memory accesses, skipped 2 redundant checks
+define void @same_ptr(ptr %p) sanitize_hwaddress {
+  %a = load i32, ptr %p
+  %b = load i32, ptr %p
+  %c = add i32 %a, %b
+  store i32 %c, ptr %p
+  ret void
+}
+
+; A check for fewer bytes does not cover a wider access.
+; CHECK-LABEL: @wider_access(
+; CHECK: ptrtoint ptr %p to i64
+; CHECK-NEXT: call void @__hwasan_load1(
+; CHECK-NEXT: load i8, ptr %p
+; CHECK-NEXT: ptrtoint ptr %p to i64
+; CHECK-NEXT: call void @__hwasan_load4(
+; CHECK-NEXT: load i32, ptr %p
+; NOOPT-NEXT: ptrtoint ptr %p to i64
+; NOOPT-NEXT: call void @__hwasan_load1(
+; CHECK-NEXT: load i8, ptr %p
+; CHECK-NEXT: ret void
+define void @wider_access(ptr %p) sanitize_hwaddress {
+  %a = load i8, ptr %p
+  %b = load i32, ptr %p
+  %c = load i8, ptr %p
+  ret void
+}
+
+; A call may free or retag the memory.
+; CHECK-LABEL: @call_between(
+; CHECK: ptrtoint ptr %p to i64
+; CHECK-NEXT: call void @__hwasan_load4(
+; CHECK-NEXT: load i32, ptr %p
+; CHECK-NEXT: call void @g()
+; CHECK-NEXT: ptrtoint ptr %p to i64
+; CHECK-NEXT: call void @__hwasan_load4(
+; CHECK-NEXT: load i32, ptr %p
+; CHECK-NEXT: ret void
+define void @call_between(ptr %p) sanitize_hwaddress {
+  %a = load i32, ptr %p
+  call void @g()
+  %b = load i32, ptr %p
+  ret void
+}
+
+; The checks are not reused across basic blocks.
+; CHECK-LABEL: @other_block(
+; CHECK: ptrtoint ptr %p to i64
+; CHECK-NEXT: call void @__hwasan_load4(
+; CHECK-NEXT: load i32, ptr %p
+; CHECK-NEXT: br label %next
+; CHECK:      next:
+; CHECK-NEXT: ptrtoint ptr %p to i64
+; CHECK-NEXT: call void @__hwasan_load4(
+; CHECK-NEXT: load i32, ptr %p
+; CHECK-NEXT: ret void
+define void @other_block(ptr %p) sanitize_hwaddress {
+  %a = load i32, ptr %p
+  br label %next
+
+next:
+  %b = load i32, ptr %p
+  ret void
+}
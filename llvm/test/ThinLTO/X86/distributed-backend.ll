@@ -0,0 +1,39 @@
+; Test the distributed ThinLTO backend, with the llvm-lto2 executor that
+; compiles each job from its own inputs only, as a remote worker would.
+
+; RUN: rm -rf %t.cache
+; RUN: opt -module-summary %s -o %t1.bc
+; RUN: opt -module-summary %p/Inputs/distributed-backend.ll -o %t2.bc
+
+; RUN: llvm-lto2 run %t1.bc %t2.bc -o %t.o -thinlto-distributed-backend \
+; RUN:   -save-temps -cache-dir %t.cache \
+; RUN:   -r=%t1.bc,main,plx -r=%t1.bc,foo, -r=%t2.bc,foo,pl
+; RUN: llvm-dis %t.o.1.3.import.bc -o - | FileCheck %s --check-prefix=IMPORT
+; RUN: llvm-nm %t.o.1 | FileCheck %s --check-prefix=NM1
+; RUN: llvm-nm %t.o.2 | FileCheck %s --check-prefix=NM2
+
+; The second link takes the objects from the cache that the first one filled,
+; without running the jobs again.
+; RUN: rm -f %t.o.1 %t.o.2 %t.o.1.3.import.bc
+; RUN: llvm-lto2 run %t1.bc %t2.bc -o %t.o -thinlto-distributed-backend \
+; RUN:   -save-temps -cache-dir %t.cache \
+; RUN:   -r=%t1.bc,main,plx -r=%t1.bc,foo, -r=%t2.bc,foo,pl
+; RUN: not ls %t.o.1.3.import.bc
+; RUN: llvm-nm %t.o.1 | FileCheck %s --check-prefix=NM1
+; RUN: llvm-nm %t.o.2 | FileCheck %s --check-prefix=NM2
+
+; The job of the first module has the definition of foo from the second one.
+; IMPORT: define available_externally i32 @foo(
+
+; NM1: T main
+; NM2: T foo
+
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare i32 @foo(i32)
+
+define i32 @main() {
+  %r = call i32 @foo(i32 41)
+  ret i32 %r
+}
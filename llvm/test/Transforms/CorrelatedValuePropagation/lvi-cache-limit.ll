@@ -0,0 +1,47 @@
+; RUN: opt < %s -passes=correlated-propagation -S | FileCheck %s
+; RUN: opt < %s -passes=correlated-propagation -lvi-max-cached-values=1 -S \
+; RUN:   | FileCheck %s
+; RUN: opt < %s -passes=correlated-propagation -lvi-max-cached-values=1 \
+; RUN:   -stats -disable-output 2>&1 | FileCheck %s --check-prefix=STATS
+; REQUIRES: asserts
+
+; Flushing the LazyValueInfo cache between queries must not change the
+; results, only recompute them.
+
+; STATS: {{[1-9][0-9]*}} lazy-value-info - Number of times the LazyValueInfo cache was flushed because it exceeded its size limit
+
+define i32 @chain(i32 %x, ptr %p) {
+; CHECK-LABEL: @chain(
+; CHECK:       bb1:
+; CHECK-NEXT:    br i1 true, label %bb2, label %exit
+; CHECK:       bb2:
+; CHECK-NEXT:    %y = add nuw nsw i32 %x, 10
+; CHECK-NEXT:    br i1 true, label %bb3, label %exit
+; CHECK:       bb3:
+; CHECK:         ret i32 0
+;
+entry:
+  %c0 = icmp ult i32 %x, 100
+  br i1 %c0, label %bb1, label %exit
+
+bb1:
+  %c1 = icmp ult i32 %x, 200
+  br i1 %c1, label %bb2, label %exit
+
+bb2:
+  %y = add nuw i32 %x, 10
+  %c2 = icmp ult i32 %y, 110
+  br i1 %c2, label %bb3, label %exit
+
+bb3:
+  %c3 = icmp ne ptr %p, null
+  store i32 %y, ptr %p
+  %c4 = icmp eq ptr %p, null
+  %r = select i1 %c4, i32 1, i32 %y
+  %c5 = icmp ugt i32 %r, 120
+  %z = zext i1 %c5 to i32
+  ret i32 %z
+
+exit:
+  ret i32 -1
+}
@@ -0,0 +1,55 @@
+; Check that the remarks of the inliner go through the pass filter and the
+; sampling of the optimization record.
+
+; RUN: opt < %s -S -passes=inline -pass-remarks-output=%t.yaml \
+; RUN:     -pass-remarks-filter=inline -o /dev/null
+; RUN: FileCheck --check-prefix=ALL %s < %t.yaml
+; RUN: opt < %s -S -passes=inline -pass-remarks-output=%t.sampled.yaml \
+; RUN:     -pass-remarks-filter=inline -remarks-sample-rate=2 -o /dev/null
+; RUN: FileCheck --check-prefix=SAMPLED --implicit-check-not=Callee: %s < %t.sampled.yaml
+; RUN: opt < %s -S -passes=inline -pass-remarks-output=%t.filtered.yaml \
+; RUN:     -pass-remarks-filter=other-pass -o /dev/null
+; RUN: FileCheck --check-prefix=FILTERED --allow-empty %s < %t.filtered.yaml
+
+; ALL:      Pass: inline
+; ALL:      Callee: callee1
+; ALL:      Pass: inline
+; ALL:      Callee: callee2
+; ALL:      Pass: inline
+; ALL:      Callee: callee3
+; ALL:      Pass: inline
+; ALL:      Callee: callee4
+
+; The first remark is kept, then one in every two.
+; SAMPLED:  Callee: callee1
+; SAMPLED:  Callee: callee3
+
+; FILTERED-NOT: Pass:
+
+define i32 @callee1(i32 %x) {
+  %y = add i32 %x, 1
+  ret i32 %y
+}
+
+define i32 @callee2(i32 %x) {
+  %y = add i32 %x, 2
+  ret i32 %y
+}
+
+define i32 @callee3(i32 %x) {
+  %y = add i32 %x, 3
+  ret i32 %y
+}
+
+define i32 @callee4(i32 %x) {
+  %y = add i32 %x, 4
+  ret i32 %y
+}
+
+define i32 @caller(i32 %x) {
+  %a = call i32 @callee1(i32 %x)
+  %b = call i32 @callee2(i32 %a)
+  %c = call i32 @callee3(i32 %b)
+  %d = call i32 @callee4(i32 %c)
+  ret i32 %d
+}
@@ -0,0 +1,30 @@
+; RUN: opt < %s -passes=instcombine -S | FileCheck %s
+; RUN: opt < %s -passes=instcombine -instcombine-cache-known-bits -S | FileCheck %s
+
+; The select is replaced by %add, whose nsw flag is dropped by the fold. The
+; compare must not be folded with the known bits that the flag implied.
+define i1 @flags_dropped_by_select(i8 %x, ptr %p) {
+; CHECK-LABEL: @flags_dropped_by_select(
+; CHECK-NOT:     ret i1 false
+; CHECK:         [[CMP:%.*]] = icmp
+; CHECK:         ret i1 [[CMP]]
+;
+  %xx = and i8 %x, 127
+  %c0 = icmp eq i8 %xx, 42
+  %add = add nsw i8 %xx, 1
+  %s = select i1 %c0, i8 43, i8 %add
+  store i8 %s, ptr %p
+  %cmp = icmp slt i8 %add, 0
+  ret i1 %cmp
+}
+
+; Without the select, the flag stays and the compare folds.
+define i1 @flags_kept(i8 %x) {
+; CHECK-LABEL: @flags_kept(
+; CHECK-NEXT:    ret i1 false
+;
+  %xx = and i8 %x, 127
+  %add = add nsw i8 %xx, 1
+  %cmp = icmp slt i8 %add, 0
+  ret i1 %cmp
+}
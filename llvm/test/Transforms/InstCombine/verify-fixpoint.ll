@@ -0,0 +1,17 @@
+; RUN: opt -passes=instcombine -instcombine-max-iterations=1 -instcombine-verify-fixpoint -S < %s | FileCheck %s
+; RUN: not --crash opt -passes=instcombine -instcombine-max-iterations=0 -instcombine-verify-fixpoint -S < %s 2>&1 | FileCheck %s --check-prefix=ERR
+
+; A single iteration folds everything, and the extra iteration run by
+; -instcombine-verify-fixpoint finds nothing left to do. With no iteration
+; allowed at all, the extra one changes the function and is reported.
+
+define i32 @add_zero_mul_one(i32 %x) {
+; CHECK-LABEL: @add_zero_mul_one(
+; CHECK-NEXT:    ret i32 [[X:%.*]]
+;
+  %a = add i32 %x, 0
+  %b = mul i32 %a, 1
+  ret i32 %b
+}
+
+; ERR: LLVM ERROR: Instruction Combining did not reach a fixpoint after 0 iterations on add_zero_mul_one
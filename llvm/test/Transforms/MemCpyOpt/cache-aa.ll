@@ -0,0 +1,45 @@
+; RUN: opt < %s -passes='memcpyopt,memcpyopt' -S | FileCheck %s
+; RUN: opt < %s -passes='memcpyopt,memcpyopt' -memcpyopt-cache-aa -S | FileCheck %s
+
+; The alias queries of the first run are reused by the second run, so the
+; edits of the first run must not leave stale results in the cache.
+
+define void @forward(ptr noalias %a, ptr noalias %b, ptr noalias %c) {
+; CHECK-LABEL: @forward(
+; CHECK-NEXT:    call void @llvm.memcpy.p0.p0.i64(ptr [[B:%.*]], ptr [[A:%.*]], i64 16, i1 false)
+; CHECK-NEXT:    call void @llvm.memcpy.p0.p0.i64(ptr [[C:%.*]], ptr [[A]], i64 16, i1 false)
+; CHECK-NEXT:    ret void
+;
+  call void @llvm.memcpy.p0.p0.i64(ptr %b, ptr %a, i64 16, i1 false)
+  call void @llvm.memcpy.p0.p0.i64(ptr %c, ptr %b, i64 16, i1 false)
+  ret void
+}
+
+define void @clobbered(ptr noalias %a, ptr noalias %b, ptr noalias %c) {
+; CHECK-LABEL: @clobbered(
+; CHECK-NEXT:    call void @llvm.memcpy.p0.p0.i64(ptr [[B:%.*]], ptr [[A:%.*]], i64 16, i1 false)
+; CHECK-NEXT:    store i8 0, ptr [[A]], align 1
+; CHECK-NEXT:    call void @llvm.memcpy.p0.p0.i64(ptr [[C:%.*]], ptr [[B]], i64 16, i1 false)
+; CHECK-NEXT:    ret void
+;
+  call void @llvm.memcpy.p0.p0.i64(ptr %b, ptr %a, i64 16, i1 false)
+  store i8 0, ptr %a
+  call void @llvm.memcpy.p0.p0.i64(ptr %c, ptr %b, i64 16, i1 false)
+  ret void
+}
+
+; The memmove is turned into a memcpy by the first run, which changes the
+; mod/ref result of the call in place.
+define void @memmove(ptr noalias %a, ptr noalias %b, ptr noalias %c) {
+; CHECK-LABEL: @memmove(
+; CHECK-NEXT:    call void @llvm.memcpy.p0.p0.i64(ptr [[B:%.*]], ptr [[A:%.*]], i64 16, i1 false)
+; CHECK-NEXT:    call void @llvm.memcpy.p0.p0.i64(ptr [[C:%.*]], ptr [[A]], i64 16, i1 false)
+; CHECK-NEXT:    ret void
+;
+  call void @llvm.memmove.p0.p0.i64(ptr %b, ptr %a, i64 16, i1 false)
+  call void @llvm.memcpy.p0.p0.i64(ptr %c, ptr %b, i64 16, i1 false)
+  ret void
+}
+
+declare void @llvm.memcpy.p0.p0.i64(ptr, ptr, i64, i1)
+declare void @llvm.memmove.p0.p0.i64(ptr, ptr, i64, i1)
@@ -0,0 +1,36 @@
+; REQUIRES: asserts
+; RUN: opt -passes=slp-vectorizer -S -mtriple=x86_64-unknown-linux-gnu -debug-only=SLP < %s 2>&1 | FileCheck %s
+
+; Both stores to %p start a chain of four consecutive stores, and the two
+; chains share their last three stores. The slices of the first chain are not
+; vectorized, so the second chain only tries the slice it does not share.
+
+; CHECK:     SLP: Analyzing a store chain of length 5.
+; CHECK:     SLP: Analyzing 2 stores at offset 0
+; CHECK:     SLP: Analyzing 2 stores at offset 1
+; CHECK:     SLP: Analyzing 2 stores at offset 2
+; CHECK:     SLP: Analyzing 2 stores at offset 0
+; CHECK-NOT: SLP: Analyzing 2 stores at offset
+
+define void @overlapping_chains(ptr %p, i64 %a, i64 %b, i64 %c, i64 %d, i64 %e) {
+; CHECK-LABEL: @overlapping_chains(
+; CHECK-NEXT:    store i64 [[A:%.*]], ptr [[P:%.*]], align 8
+; CHECK-NEXT:    [[P1:%.*]] = getelementptr inbounds i64, ptr [[P]], i64 1
+; CHECK-NEXT:    store i64 [[B:%.*]], ptr [[P1]], align 8
+; CHECK-NEXT:    [[P2:%.*]] = getelementptr inbounds i64, ptr [[P]], i64 2
+; CHECK-NEXT:    store i64 [[C:%.*]], ptr [[P2]], align 8
+; CHECK-NEXT:    [[P3:%.*]] = getelementptr inbounds i64, ptr [[P]], i64 3
+; CHECK-NEXT:    store i64 [[D:%.*]], ptr [[P3]], align 8
+; CHECK-NEXT:    store i64 [[E:%.*]], ptr [[P]], align 8
+; CHECK-NEXT:    ret void
+;
+  store i64 %a, ptr %p, align 8
+  %p1 = getelementptr inbounds i64, ptr %p, i64 1
+  store i64 %b, ptr %p1, align 8
+  %p2 = getelementptr inbounds i64, ptr %p, i64 2
+  store i64 %c, ptr %p2, align 8
+  %p3 = getelementptr inbounds i64, ptr %p, i64 3
+  store i64 %d, ptr %p3, align 8
+  store i64 %e, ptr %p, align 8
+  ret void
+}
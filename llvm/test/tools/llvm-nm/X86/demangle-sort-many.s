@@ -0,0 +1,48 @@
+## Check the order of more symbols than parallelSort sorts serially, and that
+## the names demangled ahead of printing stay with their symbols.
+
+# RUN: llvm-mc -filetype=obj -triple=x86_64 %s -o %t.o
+# RUN: llvm-nm %t.o | FileCheck %s --check-prefix=MANGLED
+# RUN: llvm-nm --demangle %t.o | FileCheck %s --check-prefix=DEMANGLED
+# RUN: llvm-nm --demangle -r %t.o | FileCheck %s --check-prefix=REVERSE
+# RUN: llvm-nm --demangle -n %t.o | FileCheck %s --check-prefix=NUMERIC
+# RUN: llvm-nm --demangle -p %t.o | FileCheck %s --check-prefix=NUMERIC
+# RUN: llvm-nm --demangle %t.o | count 1296
+
+# MANGLED:      0000000000000456 T _Z5f0000v
+# MANGLED-NEXT: 0000000000000457 T _Z5f0001v
+# MANGLED-NEXT: 0000000000000458 T _Z5f0002v
+
+# DEMANGLED:      0000000000000456 T f0000()
+# DEMANGLED-NEXT: 0000000000000457 T f0001()
+# DEMANGLED-NEXT: 0000000000000458 T f0002()
+# DEMANGLED:      00000000000000b7 T f5553()
+# DEMANGLED-NEXT: 00000000000000b8 T f5554()
+# DEMANGLED-NEXT: 00000000000000b9 T f5555()
+# DEMANGLED-NOT:  {{.}}
+
+# REVERSE:      00000000000000b9 T f5555()
+# REVERSE-NEXT: 00000000000000b8 T f5554()
+# REVERSE:      0000000000000456 T f0000()
+# REVERSE-NOT:  {{.}}
+
+# NUMERIC:      0000000000000000 T f5050()
+# NUMERIC-NEXT: 0000000000000001 T f5051()
+# NUMERIC:      000000000000050f T f0505()
+# NUMERIC-NOT:  {{.}}
+
+.macro sym a, b, c, d
+.globl _Z5f\a\b\c\d\()v
+_Z5f\a\b\c\d\()v:
+  nop
+.endm
+
+.irp a,5,4,3,2,1,0
+.irp b,0,1,2,3,4,5
+.irp c,5,4,3,2,1,0
+.irp d,0,1,2,3,4,5
+  sym \a, \b, \c, \d
+.endr
+.endr
+.endr
+.endr
@@ -0,0 +1,60 @@
+; REQUIRES: thread_support
+; Check that the chunks a parallel delta pass removes speculatively, while
+; another task already succeeded, are removed together.
+
+; RUN: llvm-reduce -j=4 --delta-passes=functions --test FileCheck --test-arg --check-prefixes=INTERESTING --test-arg %s --test-arg --input-file %s -o %t
+; RUN: FileCheck --check-prefixes=RESULT --implicit-check-not=define --implicit-check-not=declare %s < %t
+
+; INTERESTING: @keep0(
+; INTERESTING: @keep1(
+
+; RESULT: define void @keep0(
+; RESULT: define void @keep1(
+
+define void @f0() {
+  ret void
+}
+
+define void @keep0() {
+  ret void
+}
+
+define void @f1() {
+  ret void
+}
+
+define void @f2() {
+  ret void
+}
+
+define void @f3() {
+  ret void
+}
+
+define void @f4() {
+  ret void
+}
+
+define void @f5() {
+  ret void
+}
+
+define void @keep1() {
+  ret void
+}
+
+define void @f6() {
+  ret void
+}
+
+define void @f7() {
+  ret void
+}
+
+define void @f8() {
+  ret void
+}
+
+define void @f9() {
+  ret void
+}
@@ -12,6 +12,7 @@
 #include "llvm/MC/MCAsmInfo.h"
 #include "llvm/MC/MCTargetOptions.h"
 #include "llvm/Support/FormatVariadic.h"
+#include <cmath>
 #include <limits>
 #include <unordered_set>
 #include <vector>
@@ -369,6 +370,28 @@ bool Analysis::SchedClassCluster::measurementsMatch(
                                 AnalysisInconsistencyEpsilonSquared_);
 }
 
+std::vector<Analysis::SchedClassCluster>
+Analysis::makeSchedClassClusters(ArrayRef<size_t> PointIds) const {
+  std::vector<SchedClassCluster> SchedClassClusters;
+  for (const size_t PointId : PointIds) {
+    const auto &ClusterId = Clustering_.getClusterIdForPoint(PointId);
+    if (!ClusterId.isValid())
+      continue; // Ignore noise and errors. FIXME: take noise into account ?
+    if (ClusterId.isUnstable() ^ AnalysisDisplayUnstableOpcodes_)
+      continue; // Either display stable or unstable clusters only.
+    auto SchedClassClusterIt = llvm::find_if(
+        SchedClassClusters, [ClusterId](const SchedClassCluster &C) {
+          return C.id() == ClusterId;
+        });
+    if (SchedClassClusterIt == SchedClassClusters.end()) {
+      SchedClassClusters.emplace_back();
+      SchedClassClusterIt = std::prev(SchedClassClusters.end());
+    }
+    SchedClassClusterIt->addPoint(PointId, Clustering_);
+  }
+  return SchedClassClusters;
+}
+
 void Analysis::printSchedClassDescHtml(const ResolvedSchedClass &RSC,
                                        raw_ostream &OS) const {
   OS << "<table class=\"sched-class-desc\">";
@@ -546,24 +569,8 @@ Error Analysis::run<Analysis::PrintSchedClassInconsistencies>(
   for (const auto &RSCAndPoints : makePointsPerSchedClass()) {
     if (!RSCAndPoints.RSC.SCDesc)
       continue;
-    // Bucket sched class points into sched class clusters.
-    std::vector<SchedClassCluster> SchedClassClusters;
-    for (const size_t PointId : RSCAndPoints.PointIds) {
-      const auto &ClusterId = Clustering_.getClusterIdForPoint(PointId);
-      if (!ClusterId.isValid())
-        continue; // Ignore noise and errors. FIXME: take noise into account ?
-      if (ClusterId.isUnstable() ^ AnalysisDisplayUnstableOpcodes_)
-        continue; // Either display stable or unstable clusters only.
-      auto SchedClassClusterIt = llvm::find_if(
-          SchedClassClusters, [ClusterId](const SchedClassCluster &C) {
-            return C.id() == ClusterId;
-          });
-      if (SchedClassClusterIt == SchedClassClusters.end()) {
-        SchedClassClusters.emplace_back();
-        SchedClassClusterIt = std::prev(SchedClassClusters.end());
-      }
-      SchedClassClusterIt->addPoint(PointId, Clustering_);
-    }
+    const std::vector<SchedClassCluster> SchedClassClusters =
+        makeSchedClassClusters(RSCAndPoints.PointIds);
 
     // Print any scheduling class that has at least one cluster that does not
     // match the checked-in data.
@@ -596,5 +603,73 @@ Error Analysis::run<Analysis::PrintSchedClassInconsistencies>(
   return Error::success();
 }
 
+template <>
+Error Analysis::run<Analysis::PrintSchedModelDiff>(raw_ostream &OS) const {
+  if (Clustering_.getPoints().empty())
+    return Error::success();
+
+  const auto &Points = Clustering_.getPoints();
+  const auto &FirstPoint = Points[0];
+  const auto &SI = State_.getSubtargetInfo();
+  const auto &InstrInfo = State_.getInstrInfo();
+  const double Epsilon = std::sqrt(AnalysisInconsistencyEpsilonSquared_);
+  OS << "--- llvm SchedModel (" << FirstPoint.LLVMTriple << ", "
+     << FirstPoint.CpuName << ")\n";
+  OS << "+++ measured\n";
+
+  for (const auto &RSCAndPoints : makePointsPerSchedClass()) {
+    if (!RSCAndPoints.RSC.SCDesc)
+      continue;
+    for (const SchedClassCluster &Cluster :
+         makeSchedClassClusters(RSCAndPoints.PointIds)) {
+      if (Cluster.measurementsMatch(SI, RSCAndPoints.RSC, Clustering_,
+                                    AnalysisInconsistencyEpsilonSquared_))
+        continue;
+      const InstructionBenchmark::ModeE Mode = FirstPoint.Mode;
+      if (!Cluster.getCentroid().validate(Mode))
+        continue;
+      const std::vector<BenchmarkMeasure> Measured =
+          Cluster.getCentroid().getAsPoint();
+      const std::vector<BenchmarkMeasure> Model = RSCAndPoints.RSC.getAsPoint(
+          Mode, SI, Cluster.getCentroid().getStats());
+      if (Model.size() != Measured.size())
+        continue;
+
+      // The hunk header names the sched class and the opcodes of the cluster.
+      OS << "@@ ";
+#if !defined(NDEBUG) || defined(LLVM_ENABLE_DUMP)
+      OS << RSCAndPoints.RSC.SCDesc->Name;
+#else
+      OS << RSCAndPoints.RSC.SchedClassId;
+#endif
+      OS << " @@";
+      SmallVector<unsigned, 8> Opcodes;
+      for (const size_t PointId : Cluster.getPointIds()) {
+        unsigned Opcode = Points[PointId].keyInstruction().getOpcode();
+        if (!is_contained(Opcodes, Opcode)) {
+          Opcodes.push_back(Opcode);
+          OS << ' ' << InstrInfo.getName(Opcode);
+        }
+      }
+      OS << '\n';
+
+      // The values of the model come in the order of the measurements, but
+      // without their keys.
+      for (const auto &[ModelValue, MeasuredValue] : zip(Model, Measured)) {
+        if (std::abs(ModelValue.PerInstructionValue -
+                     MeasuredValue.PerInstructionValue) <= Epsilon)
+          continue;
+        OS << '-' << MeasuredValue.Key << ' ';
+        writeMeasurementValue<kEscapeCsv>(OS, ModelValue.PerInstructionValue);
+        OS << "\n+" << MeasuredValue.Key << ' ';
+        writeMeasurementValue<kEscapeCsv>(OS,
+                                          MeasuredValue.PerInstructionValue);
+        OS << '\n';
+      }
+    }
+  }
+  return Error::success();
+}
+
 } // namespace exegesis
 } // namespace llvm
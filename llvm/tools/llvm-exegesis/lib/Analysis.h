@@ -45,6 +45,9 @@ public:
   struct PrintClusters {};
   // Find potential errors in the scheduling information given measurements.
   struct PrintSchedClassInconsistencies {};
+  // Prints the scheduling information that doesn't match the measurements as
+  // a diff between the values of the model and the measured values.
+  struct PrintSchedModelDiff {};
 
   template <typename Pass> Error run(raw_ostream &OS) const;
 
@@ -106,6 +109,11 @@ private:
   // Builds a list of ResolvedSchedClassAndPoints.
   std::vector<ResolvedSchedClassAndPoints> makePointsPerSchedClass() const;
 
+  // Buckets the points of a sched class into sched class clusters, ignoring
+  // noise and errors.
+  std::vector<SchedClassCluster>
+  makeSchedClassClusters(ArrayRef<size_t> PointIds) const;
+
   template <typename EscapeTag, EscapeTag Tag>
   void writeSnippet(raw_ostream &OS, ArrayRef<uint8_t> Bytes,
                     const char *Separator) const;
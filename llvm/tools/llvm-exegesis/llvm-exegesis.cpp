@@ -43,6 +43,9 @@
 #include "llvm/TargetParser/Host.h"
 #include <algorithm>
 #include <string>
+#ifdef __linux__
+#include <sched.h>
+#endif
 
 namespace llvm {
 namespace exegesis {
@@ -52,6 +55,24 @@ static cl::opt<int> OpcodeIndex(
     cl::desc("opcode to measure, by index, or -1 to measure all opcodes"),
     cl::cat(BenchmarkOptions), cl::init(0));
 
+static cl::opt<unsigned>
+    NumShards("num-shards",
+              cl::desc("split the opcodes to measure into that many shards, "
+                       "and only measure the one selected by --shard-index"),
+              cl::cat(BenchmarkOptions), cl::init(1));
+
+static cl::opt<unsigned>
+    ShardIndex("shard-index",
+               cl::desc("index of the shard of opcodes to measure, between 0 "
+                        "and --num-shards - 1"),
+               cl::cat(BenchmarkOptions), cl::init(0));
+
+static cl::opt<int> BenchmarkProcessCPU(
+    "benchmark-process-cpu",
+    cl::desc("pin the benchmarking process to this CPU, or -1 to let the "
+             "operating system schedule it (default). Only supported on Linux"),
+    cl::cat(BenchmarkOptions), cl::init(-1));
+
 static cl::opt<std::string>
     OpcodeNames("opcode-name",
                 cl::desc("comma-separated list of opcodes to measure, by name"),
@@ -209,6 +230,13 @@ static cl::opt<std::string>
                                       cl::desc(""), cl::cat(AnalysisOptions),
                                       cl::init(""));
 
+static cl::opt<std::string> AnalysisSchedModelDiffOutputFile(
+    "analysis-sched-model-diff-output-file",
+    cl::desc("print the scheduling information that doesn't match the "
+             "measurements, as a diff from the values of the LLVM scheduling "
+             "model to the measured values"),
+    cl::cat(AnalysisOptions), cl::init(""));
+
 static cl::opt<bool> AnalysisDisplayUnstableOpcodes(
     "analysis-display-unstable-clusters",
     cl::desc("if there is more than one benchmark for an opcode, said "
@@ -276,15 +304,21 @@ static std::vector<unsigned> getOpcodesOrDie(const LLVMState &State) {
     ExitWithError("please provide one and only one of 'opcode-index', "
                   "'opcode-name' or 'snippets-file'");
   }
+  if (NumShards == 0 || ShardIndex >= NumShards)
+    ExitWithError("--shard-index must be less than --num-shards");
+  if (NumShards > 1 && OpcodeIndex >= 0)
+    ExitWithError("--num-shards requires --opcode-index=-1");
   if (!SnippetsFile.empty())
     return {};
   if (OpcodeIndex > 0)
     return {static_cast<unsigned>(OpcodeIndex)};
   if (OpcodeIndex < 0) {
+    // Interleave the opcodes of the shards, so that the similar instructions,
+    // which usually have consecutive opcodes, are spread across the shards.
     std::vector<unsigned> Result;
     unsigned NumOpcodes = State.getInstrInfo().getNumOpcodes();
-    Result.reserve(NumOpcodes);
-    for (unsigned I = 0, E = NumOpcodes; I < E; ++I)
+    Result.reserve(NumOpcodes / NumShards + 1);
+    for (unsigned I = ShardIndex, E = NumOpcodes; I < E; I += NumShards)
       Result.push_back(I);
     return Result;
   }
@@ -416,7 +450,28 @@ static void runBenchmarkConfigurations(
   }
 }
 
+// Pins the current process to CPU, so that concurrent benchmarking processes
+// don't disturb each other's measurements.
+static void pinProcessToCPU(int CPU) {
+#ifdef __linux__
+  if (CPU >= CPU_SETSIZE)
+    ExitWithError("--benchmark-process-cpu must be less than " +
+                  Twine(CPU_SETSIZE));
+  cpu_set_t CPUMask;
+  CPU_ZERO(&CPUMask);
+  CPU_SET(CPU, &CPUMask);
+  if (sched_setaffinity(0, sizeof(CPUMask), &CPUMask) != 0)
+    ExitOnErr(errorCodeToError(
+        std::error_code(errno, std::system_category())));
+#else
+  ExitWithError("--benchmark-process-cpu is only supported on Linux");
+#endif
+}
+
 void benchmarkMain() {
+  if (BenchmarkProcessCPU >= 0)
+    pinProcessToCPU(BenchmarkProcessCPU);
+
   if (BenchmarkPhaseSelector == BenchmarkPhaseSelectorE::Measure) {
 #ifndef HAVE_LIBPFM
     ExitWithError(
@@ -552,10 +607,12 @@ static void analysisMain() {
     ExitWithError("--benchmarks-file must be set");
 
   if (AnalysisClustersOutputFile.empty() &&
-      AnalysisInconsistenciesOutputFile.empty()) {
+      AnalysisInconsistenciesOutputFile.empty() &&
+      AnalysisSchedModelDiffOutputFile.empty()) {
     ExitWithError(
-        "for --mode=analysis: At least one of --analysis-clusters-output-file "
-        "and --analysis-inconsistencies-output-file must be specified");
+        "for --mode=analysis: At least one of --analysis-clusters-output-file, "
+        "--analysis-inconsistencies-output-file and "
+        "--analysis-sched-model-diff-output-file must be specified");
   }
 
   InitializeAllAsmPrinters();
@@ -616,6 +673,8 @@ static void analysisMain() {
   maybeRunAnalysis<Analysis::PrintSchedClassInconsistencies>(
       Analyzer, "sched class consistency analysis",
       AnalysisInconsistenciesOutputFile);
+  maybeRunAnalysis<Analysis::PrintSchedModelDiff>(
+      Analyzer, "sched model diff", AnalysisSchedModelDiffOutputFile);
 }
 
 } // namespace exegesis
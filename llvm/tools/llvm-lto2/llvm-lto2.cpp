@@ -19,6 +19,7 @@
 #include "llvm/CodeGen/CommandFlags.h"
 #include "llvm/IR/DiagnosticPrinter.h"
 #include "llvm/LTO/LTO.h"
+#include "llvm/LTO/LTOBackend.h"
 #include "llvm/Passes/PassPlugin.h"
 #include "llvm/Remarks/HotnessThresholdParser.h"
 #include "llvm/Support/Caching.h"
@@ -85,6 +86,12 @@ static cl::opt<bool>
                                        "import files for the "
                                        "distributed backend case"));
 
+static cl::opt<bool> ThinLTODistributedBackend(
+    "thinlto-distributed-backend",
+    cl::desc("Run the ThinLTO backends through the distributed backend, with "
+             "an executor that compiles each job in-process from its own "
+             "inputs only"));
+
 static cl::opt<bool>
     ThinLTOEmitIndexes("thinlto-emit-indexes",
                        cl::desc("Write out individual index files via "
@@ -210,6 +217,51 @@ template <typename T> static T check(ErrorOr<T> E, std::string Msg) {
   return T();
 }
 
+/// Compiles \p Job like a remote worker of the distributed ThinLTO backend
+/// would, from the bitcode and the individual summary index of the job only.
+static Expected<std::unique_ptr<MemoryBuffer>>
+runDistributedBackendJob(const RemoteBackendJob &Job) {
+  Expected<std::unique_ptr<ModuleSummaryIndex>> IndexOrErr =
+      getModuleSummaryIndex(MemoryBufferRef(Job.SummaryIndex, Job.ModuleID));
+  if (!IndexOrErr)
+    return IndexOrErr.takeError();
+  ModuleSummaryIndex &Index = **IndexOrErr;
+
+  MapVector<StringRef, BitcodeModule> ModuleMap;
+  for (const auto &[ModuleID, Bitcode] : Job.ImportedModules) {
+    Expected<std::vector<BitcodeModule>> BMsOrErr =
+        getBitcodeModuleList(MemoryBufferRef(Bitcode, ModuleID));
+    if (!BMsOrErr)
+      return BMsOrErr.takeError();
+    ModuleMap.insert({ModuleID, BMsOrErr->front()});
+  }
+
+  LLVMContext Context;
+  Expected<std::unique_ptr<Module>> MOrErr =
+      parseBitcodeFile(MemoryBufferRef(Job.Bitcode, Job.ModuleID), Context);
+  if (!MOrErr)
+    return MOrErr.takeError();
+  Module &M = **MOrErr;
+
+  FunctionImporter::ImportMapTy ImportList;
+  if (!initImportList(M, Index, ImportList))
+    return make_error<StringError>("cannot import into " + Job.ModuleID,
+                                   inconvertibleErrorCode());
+  StringMap<GVSummaryMapTy> ModuleToDefinedGVSummaries;
+  Index.collectDefinedGVSummariesPerModule(ModuleToDefinedGVSummaries);
+
+  SmallString<0> Object;
+  auto AddStream = [&](size_t Task, const Twine &ModuleName) {
+    return std::make_unique<CachedFileStream>(
+        std::make_unique<raw_svector_ostream>(Object));
+  };
+  if (Error E = thinBackend(*Job.Conf, Job.Task, AddStream, M, Index, ImportList,
+                            ModuleToDefinedGVSummaries[Job.ModuleID],
+                            &ModuleMap))
+    return std::move(E);
+  return MemoryBuffer::getMemBufferCopy(Object, Job.ModuleID);
+}
+
 static int usage() {
   errs() << "Available subcommands: dump-symtab run\n";
   return 1;
@@ -319,7 +371,11 @@ static int run(int argc, char **argv) {
   Conf.PTO.SLPVectorization = Conf.OptLevel > 1;
 
   ThinBackend Backend;
-  if (ThinLTODistributedIndexes)
+  if (ThinLTODistributedBackend)
+    Backend = createDistributedThinBackend(
+        llvm::heavyweight_hardware_concurrency(Threads),
+        runDistributedBackendJob);
+  else if (ThinLTODistributedIndexes)
     Backend =
         createWriteIndexesThinBackend(/* OldPrefix */ "",
                                       /* NewPrefix */ "", ThinLTOEmitImports,
@@ -45,6 +45,7 @@
 #include "llvm/MCA/Context.h"
 #include "llvm/MCA/CustomBehaviour.h"
 #include "llvm/MCA/InstrBuilder.h"
+#include "llvm/MCA/LoopMemoryDependences.h"
 #include "llvm/MCA/Pipeline.h"
 #include "llvm/MCA/Stages/EntryStage.h"
 #include "llvm/MCA/Stages/InstructionTables.h"
@@ -60,6 +61,7 @@
 #include "llvm/Support/ToolOutputFile.h"
 #include "llvm/Support/WithColor.h"
 #include "llvm/TargetParser/Host.h"
+#include <optional>
 
 using namespace llvm;
 
@@ -183,6 +185,14 @@ static cl::opt<bool>
                   cl::desc("If set, assume that loads and stores do not alias"),
                   cl::cat(ToolOptions), cl::init(true));
 
+static cl::opt<bool> LoopMemoryDeps(
+    "loop-memory-deps",
+    cl::desc("Simulate each code region as a loop body, where the loads wait "
+             "for the stores of the same or earlier iterations that they read "
+             "from, as computed from their address registers. Flag -noalias "
+             "only applies to the addresses that cannot be compared"),
+    cl::cat(ToolOptions), cl::init(false));
+
 static cl::opt<unsigned> LoadQueueSize("lqueue",
                                        cl::desc("Size of the load queue"),
                                        cl::cat(ToolOptions), cl::init(0));
@@ -651,6 +661,14 @@ int main(int argc, char **argv) {
       // flag is set) then we use the base class (which does nothing).
       CB = std::make_unique<mca::CustomBehaviour>(*STI, S, *MCII);
 
+    // Compute the loop-carried memory dependencies of the region.
+    std::optional<mca::LoopMemoryDependences> MemDeps;
+    PO.MemoryDependences = nullptr;
+    if (LoopMemoryDeps) {
+      MemDeps.emplace(Insts, *IPP, *MCII, *MRI, AssumeNoAlias);
+      PO.MemoryDependences = &*MemDeps;
+    }
+
     // Create a basic pipeline simulating an out-of-order backend.
     auto P = MCA.createDefaultPipeline(PO, S, *CB);
 
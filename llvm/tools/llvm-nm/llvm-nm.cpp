@@ -42,6 +42,7 @@
 #include "llvm/Support/InitLLVM.h"
 #include "llvm/Support/LLVMDriver.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Program.h"
 #include "llvm/Support/Signals.h"
 #include "llvm/Support/TargetSelect.h"
@@ -274,18 +275,21 @@ struct NMSymbol {
   }
 };
 
+// The names are compared as StringRefs, which order them the same way as
+// std::string, so that no comparison copies them.
 bool operator<(const NMSymbol &A, const NMSymbol &B) {
+  StringRef AName = A.Name, BName = B.Name;
   if (NumericSort)
-    return std::make_tuple(A.isDefined(), A.Address, A.Name, A.Size) <
-           std::make_tuple(B.isDefined(), B.Address, B.Name, B.Size);
+    return std::make_tuple(A.isDefined(), A.Address, AName, A.Size) <
+           std::make_tuple(B.isDefined(), B.Address, BName, B.Size);
   if (SizeSort)
-    return std::make_tuple(A.Size, A.Name, A.Address) <
-           std::make_tuple(B.Size, B.Name, B.Address);
+    return std::make_tuple(A.Size, AName, A.Address) <
+           std::make_tuple(B.Size, BName, B.Address);
   if (ExportSymbols)
-    return std::make_tuple(A.Name, A.Visibility) <
-           std::make_tuple(B.Name, B.Visibility);
-  return std::make_tuple(A.Name, A.Size, A.Address) <
-         std::make_tuple(B.Name, B.Size, B.Address);
+    return std::make_tuple(AName, A.Visibility) <
+           std::make_tuple(BName, B.Visibility);
+  return std::make_tuple(AName, A.Size, A.Address) <
+         std::make_tuple(BName, B.Size, B.Address);
 }
 
 bool operator>(const NMSymbol &A, const NMSymbol &B) { return B < A; }
@@ -683,9 +687,9 @@ static void sortSymbolList(std::vector<NMSymbol> &SymbolList) {
     return;
 
   if (ReverseSort)
-    llvm::sort(SymbolList, std::greater<>());
+    parallelSort(SymbolList, std::greater<>());
   else
-    llvm::sort(SymbolList);
+    parallelSort(SymbolList, std::less<>());
 }
 
 static void printExportSymbolList(const std::vector<NMSymbol> &SymbolList) {
@@ -745,21 +749,30 @@ static void printSymbolList(SymbolicFile &Obj,
     }
   }
 
-  for (const NMSymbol &S : SymbolList) {
+  // Demangling takes most of the time for large symbol tables, so demangle all
+  // the printed names in parallel before printing them in order.
+  std::vector<std::optional<std::string>> DemangledNames;
+  if (Demangle) {
+    function_ref<std::optional<std::string>(StringRef)> Fn = ::demangle;
+    if (Obj.isXCOFF())
+      Fn = demangleXCOFF;
+    if (Obj.isMachO())
+      Fn = demangleMachO;
+    DemangledNames.resize(SymbolList.size());
+    parallelFor(0, SymbolList.size(), [&](size_t I) {
+      if (SymbolList[I].shouldPrint())
+        DemangledNames[I] = Fn(SymbolList[I].Name);
+    });
+  }
+
+  MachOObjectFile *MachO = dyn_cast<MachOObjectFile>(&Obj);
+  for (const auto &[I, S] : enumerate(SymbolList)) {
     if (!S.shouldPrint())
       continue;
 
-    std::string Name = S.Name;
-    MachOObjectFile *MachO = dyn_cast<MachOObjectFile>(&Obj);
-    if (Demangle) {
-      function_ref<std::optional<std::string>(StringRef)> Fn = ::demangle;
-      if (Obj.isXCOFF())
-        Fn = demangleXCOFF;
-      if (Obj.isMachO())
-        Fn = demangleMachO;
-      if (std::optional<std::string> Opt = Fn(S.Name))
-        Name = *Opt;
-    }
+    StringRef Name = S.Name;
+    if (Demangle && DemangledNames[I])
+      Name = *DemangledNames[I];
 
     if (PrintFileName)
       writeFileName(outs(), ArchiveName, ArchitectureName);
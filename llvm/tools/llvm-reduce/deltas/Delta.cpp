@@ -167,7 +167,9 @@ static SmallString<0> ProcessChunkFromSerializedBitcode(
   return Result;
 }
 
-using SharedTaskQueue = std::deque<std::shared_future<SmallString<0>>>;
+using ChunkIterator = std::vector<Chunk>::const_reverse_iterator;
+using SharedTaskQueue =
+    std::deque<std::pair<ChunkIterator, std::shared_future<SmallString<0>>>>;
 
 /// Runs the Delta Debugging algorithm, splits the code into chunks and
 /// reduces the amount of chunks that are considered interesting by the
@@ -225,51 +227,67 @@ void llvm::runDeltaPass(TestRunner &Test, ReductionFunc ExtractChunksFromModule,
     ChunkThreadPoolPtr =
         std::make_unique<ThreadPool>(hardware_concurrency(NumJobs));
 
+  // When running with more than one thread, serialize the original bitcode
+  // to OriginalBC. The program is only replaced once the pass is done, so this
+  // is done once for all the granularity levels.
+  SmallString<0> OriginalBC;
+  if (NumJobs > 1) {
+    raw_svector_ostream BCOS(OriginalBC);
+    Test.getProgram().writeBitcode(BCOS);
+  }
+
   bool FoundAtLeastOneNewUninterestingChunkWithCurrentGranularity;
   do {
     FoundAtLeastOneNewUninterestingChunkWithCurrentGranularity = false;
 
     DenseSet<Chunk> UninterestingChunks;
 
-    // When running with more than one thread, serialize the original bitcode
-    // to OriginalBC.
-    SmallString<0> OriginalBC;
-    if (NumJobs > 1) {
-      raw_svector_ostream BCOS(OriginalBC);
-      Test.getProgram().writeBitcode(BCOS);
-    }
-
     SharedTaskQueue TaskQueue;
-    for (auto I = ChunksStillConsideredInteresting.rbegin(),
-              E = ChunksStillConsideredInteresting.rend();
+    for (auto I = ChunksStillConsideredInteresting.crbegin(),
+              E = ChunksStillConsideredInteresting.crend();
          I != E; ++I) {
+      // Chunks may have been removed speculatively along with an earlier one.
+      if (UninterestingChunks.count(*I))
+        continue;
+
       std::unique_ptr<ReducerWorkItem> Result = nullptr;
       unsigned WorkLeft = std::distance(I, E);
 
       // Run in parallel mode, if the user requested more than one thread and
       // there are at least a few chunks to process.
       if (NumJobs > 1 && WorkLeft > 1) {
-        unsigned NumInitialTasks = std::min(WorkLeft, unsigned(NumJobs));
-        unsigned NumChunksProcessed = 0;
-
         ThreadPool &ChunkThreadPool = *ChunkThreadPoolPtr;
         assert(TaskQueue.empty());
 
+        // Queue a job to process the next chunk still to check, if any, using
+        // ChunkThreadPool. When the task is run, it parses the original module
+        // from OriginalBC with a fresh LLVMContext object. This ensures that
+        // the cloned module of each task uses an independent LLVMContext
+        // object. If the task reduces the input, it serializes the result back
+        // into its future. The bitcode and the chunk sets are shared by
+        // reference rather than copied into each task: they are not modified
+        // until all the tasks are done.
+        ChunkIterator NextToSchedule = I;
+        auto ScheduleNextChunk = [&]() {
+          while (NextToSchedule != E &&
+                 UninterestingChunks.count(*NextToSchedule))
+            ++NextToSchedule;
+          if (NextToSchedule == E)
+            return;
+          TaskQueue.emplace_back(
+              NextToSchedule,
+              ChunkThreadPool.async(
+                  ProcessChunkFromSerializedBitcode, *NextToSchedule,
+                  std::ref(Test), ExtractChunksFromModule,
+                  std::cref(UninterestingChunks),
+                  ArrayRef(ChunksStillConsideredInteresting),
+                  StringRef(OriginalBC), std::ref(AnyReduced)));
+          ++NextToSchedule;
+        };
+
         AnyReduced = false;
-        // Queue jobs to process NumInitialTasks chunks in parallel using
-        // ChunkThreadPool. When the tasks are added to the pool, parse the
-        // original module from OriginalBC with a fresh LLVMContext object. This
-        // ensures that the cloned module of each task uses an independent
-        // LLVMContext object. If a task reduces the input, serialize the result
-        // back in the corresponding Result element.
-        for (unsigned J = 0; J < NumInitialTasks; ++J) {
-          Chunk ChunkToCheck = *(I + J);
-          TaskQueue.emplace_back(ChunkThreadPool.async(
-              ProcessChunkFromSerializedBitcode, ChunkToCheck, std::ref(Test),
-              ExtractChunksFromModule, UninterestingChunks,
-              ChunksStillConsideredInteresting, OriginalBC,
-              std::ref(AnyReduced)));
-        }
+        for (unsigned J = 0; J < NumJobs; ++J)
+          ScheduleNextChunk();
 
         // Start processing results of the queued tasks. We wait for the first
         // task in the queue to finish. If it reduced a chunk, we parse the
@@ -278,22 +296,15 @@ void llvm::runDeltaPass(TestRunner &Test, ReductionFunc ExtractChunksFromModule,
         //  * no other pending job reduced a chunk and
         //  * we have not reached the end of the chunk.
         while (!TaskQueue.empty()) {
-          auto &Future = TaskQueue.front();
-          Future.wait();
-
-          NumChunksProcessed++;
-          SmallString<0> Res = Future.get();
+          auto [ChunkIt, Future] = std::move(TaskQueue.front());
           TaskQueue.pop_front();
+          SmallString<0> Res = Future.get();
+
+          // Forward I to the last chunk processed in parallel.
+          I = ChunkIt;
           if (Res.empty()) {
-            unsigned NumScheduledTasks = NumChunksProcessed + TaskQueue.size();
-            if (!AnyReduced && I + NumScheduledTasks != E) {
-              Chunk ChunkToCheck = *(I + NumScheduledTasks);
-              TaskQueue.emplace_back(ChunkThreadPool.async(
-                  ProcessChunkFromSerializedBitcode, ChunkToCheck,
-                  std::ref(Test), ExtractChunksFromModule, UninterestingChunks,
-                  ChunksStillConsideredInteresting, OriginalBC,
-                  std::ref(AnyReduced)));
-            }
+            if (!AnyReduced)
+              ScheduleNextChunk();
             continue;
           }
 
@@ -305,15 +316,36 @@ void llvm::runDeltaPass(TestRunner &Test, ReductionFunc ExtractChunksFromModule,
         }
 
         // If we broke out of the loop, we still need to wait for everything to
-        // avoid race access to the chunk set.
+        // avoid race access to the chunk set. Tasks still running were
+        // evaluated speculatively against the same chunk set as the one that
+        // reduced: note the chunks they managed to reduce too.
         //
         // TODO: Create a way to kill remaining items we're ignoring; they could
         // take a long time.
-        ChunkThreadPoolPtr->wait();
+        SmallVector<Chunk, 4> SpeculativeChunks;
+        for (auto &[ChunkIt, Future] : TaskQueue)
+          if (!Future.get().empty())
+            SpeculativeChunks.push_back(*ChunkIt);
         TaskQueue.clear();
 
-        // Forward I to the last chunk processed in parallel.
-        I += NumChunksProcessed - 1;
+        // Try to remove all those chunks at once along with this one. If the
+        // result is still interesting, this saves checking each of them again
+        // on its own; otherwise they are checked again in order.
+        if (Result && !SpeculativeChunks.empty()) {
+          DenseSet<Chunk> MergedChunks = UninterestingChunks;
+          MergedChunks.insert(SpeculativeChunks.begin(),
+                              SpeculativeChunks.end());
+          if (std::unique_ptr<ReducerWorkItem> MergedResult = CheckChunk(
+                  *I, Test.getProgram().clone(Test.getTargetMachine()), Test,
+                  ExtractChunksFromModule, MergedChunks,
+                  ChunksStillConsideredInteresting)) {
+            if (Verbose)
+              errs() << "Merged " << SpeculativeChunks.size()
+                     << " speculatively reduced chunks\n";
+            UninterestingChunks = std::move(MergedChunks);
+            Result = std::move(MergedResult);
+          }
+        }
       } else {
         Result =
             CheckChunk(*I, Test.getProgram().clone(Test.getTargetMachine()),
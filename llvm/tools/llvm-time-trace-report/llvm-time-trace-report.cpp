@@ -0,0 +1,365 @@
+//===- llvm-time-trace-report.cpp -----------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// llvm-time-trace-report aggregates the traces written with -ftime-trace by
+// the compilations of a build, and reports the files, templates and functions
+// that took the longest to process across the whole build.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/InitLLVM.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
+#include "llvm/Support/Threading.h"
+#include "llvm/Support/WithColor.h"
+#include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace llvm;
+
+static cl::OptionCategory TimeTraceReportCategory("Time Trace Report Options");
+
+static cl::list<std::string> InputPaths(cl::Positional, cl::OneOrMore,
+                                        cl::desc("<trace file or directory>"),
+                                        cl::cat(TimeTraceReportCategory));
+static cl::opt<unsigned> Top("top", cl::init(10),
+                             cl::desc("Number of entries to report for each "
+                                      "category (default = 10)"),
+                             cl::cat(TimeTraceReportCategory));
+static cl::opt<unsigned>
+    Jobs("j", cl::init(0),
+         cl::desc("Number of threads used to read the traces (default = all "
+                  "hardware threads)"),
+         cl::cat(TimeTraceReportCategory));
+static cl::opt<std::string> OutputFilename("o", cl::value_desc("filename"),
+                                           cl::init("-"),
+                                           cl::desc("Output file"),
+                                           cl::cat(TimeTraceReportCategory));
+
+/// Number of traces read at once. Each batch is summarized in parallel, then
+/// merged into the build-wide totals, which bounds the memory used.
+static const size_t BatchSize = 256;
+
+namespace {
+
+/// The kinds of entries aggregated across the traces.
+enum CategoryKind {
+  Files,
+  Templates,
+  TemplateSets,
+  Functions,
+  TranslationUnits,
+  NumCategories
+};
+
+const char *const CategoryTitles[NumCategories] = {
+    "Files that took longest to parse",
+    "Templates that took longest to instantiate",
+    "Template sets that took longest to instantiate",
+    "Functions that took longest to optimize",
+    "Translation units that took longest to compile",
+};
+
+/// The time spent on an entry, and the number of times it was processed.
+struct Stat {
+  uint64_t TotalUs = 0;
+  uint64_t Count = 0;
+
+  void add(const Stat &Other) {
+    TotalUs += Other.TotalUs;
+    Count += Other.Count;
+  }
+};
+
+/// The totals of one trace, or of the whole build.
+struct Summary {
+  StringMap<Stat> Entries[NumCategories];
+  uint64_t FrontendUs = 0;
+  uint64_t BackendUs = 0;
+  uint64_t NumTraces = 0;
+  /// The error met reading the trace, if any.
+  std::string Error;
+
+  void add(const Summary &Other) {
+    for (unsigned Kind = 0; Kind != NumCategories; ++Kind)
+      for (const auto &Entry : Other.Entries[Kind])
+        Entries[Kind][Entry.getKey()].add(Entry.getValue());
+    FrontendUs += Other.FrontendUs;
+    BackendUs += Other.BackendUs;
+    NumTraces += Other.NumTraces;
+  }
+};
+
+/// A complete event of a trace.
+struct Event {
+  int64_t Tid;
+  int64_t Ts;
+  int64_t Dur;
+  StringRef Name;
+  StringRef Detail;
+};
+
+} // end anonymous namespace
+
+/// Replace the template arguments of \p Name with "$", so that the
+/// instantiations of a template are aggregated together.
+static std::string dropTemplateArgs(StringRef Name) {
+  std::string Result;
+  Result.reserve(Name.size());
+  unsigned Depth = 0;
+  for (char C : Name) {
+    if (C == '<') {
+      if (Depth++ == 0)
+        Result += "<$";
+      continue;
+    }
+    if (C == '>' && Depth) {
+      if (--Depth == 0)
+        Result += '>';
+      continue;
+    }
+    if (!Depth)
+      Result += C;
+  }
+  // Unbalanced brackets, e.g. from operator<: keep the name as is.
+  if (Depth)
+    return Name.str();
+  return Result;
+}
+
+/// Return the category that the events named \p Name are aggregated in, by
+/// detail, if any. The template instantiations are also aggregated in
+/// TemplateSets.
+static std::optional<CategoryKind> getCategory(StringRef Name) {
+  if (Name == "Source")
+    return Files;
+  if (Name == "InstantiateClass" || Name == "InstantiateFunction")
+    return Templates;
+  if (Name == "OptFunction")
+    return Functions;
+  return std::nullopt;
+}
+
+static void summarizeEvents(std::vector<Event> &Events, StringRef Path,
+                            Summary &S) {
+  // Visit the events of each thread in nesting order, so that an event nested
+  // in another one of the same entry is not counted twice: only the topmost
+  // one is, like the totals written by the profiler.
+  llvm::sort(Events, [](const Event &A, const Event &B) {
+    return std::make_tuple(A.Tid, A.Ts, -A.Dur) <
+           std::make_tuple(B.Tid, B.Ts, -B.Dur);
+  });
+
+  struct OpenEvent {
+    int64_t Tid;
+    int64_t End;
+    StringRef Name;
+    std::optional<CategoryKind> Kind;
+    std::string Key;
+    std::string SetKey;
+  };
+  SmallVector<OpenEvent, 32> Stack;
+  int64_t CompileUs = -1;
+  int64_t Begin = INT64_MAX, End = INT64_MIN;
+  auto AddEntry = [&](CategoryKind Kind, StringRef Key, int64_t Dur) {
+    Stat &St = S.Entries[Kind][Key];
+    St.TotalUs += Dur;
+    ++St.Count;
+  };
+  for (const Event &E : Events) {
+    while (!Stack.empty() &&
+           (Stack.back().Tid != E.Tid || Stack.back().End <= E.Ts))
+      Stack.pop_back();
+    Begin = std::min(Begin, E.Ts);
+    End = std::max(End, E.Ts + E.Dur);
+
+    bool IsTopmostName = none_of(
+        Stack, [&](const OpenEvent &O) { return O.Name == E.Name; });
+    if (IsTopmostName) {
+      if (E.Name == "Frontend")
+        S.FrontendUs += E.Dur;
+      else if (E.Name == "Backend")
+        S.BackendUs += E.Dur;
+      else if (E.Name == "ExecuteCompiler")
+        CompileUs = std::max(CompileUs, E.Dur);
+    }
+
+    OpenEvent Open{E.Tid, E.Ts + E.Dur, E.Name, getCategory(E.Name), "", ""};
+    if (Open.Kind) {
+      Open.Key = E.Detail.str();
+      if (none_of(Stack, [&](const OpenEvent &O) {
+            return O.Kind == Open.Kind && O.Key == Open.Key;
+          }))
+        AddEntry(*Open.Kind, Open.Key, E.Dur);
+      if (*Open.Kind == Templates) {
+        Open.SetKey = dropTemplateArgs(E.Detail);
+        if (none_of(Stack, [&](const OpenEvent &O) {
+              return O.Kind == Templates && O.SetKey == Open.SetKey;
+            }))
+          AddEntry(TemplateSets, Open.SetKey, E.Dur);
+      }
+    }
+    Stack.push_back(std::move(Open));
+  }
+
+  // Use the duration of the whole compilation if it was recorded, and the
+  // extent of the trace otherwise.
+  if (CompileUs < 0 && !Events.empty())
+    CompileUs = End - Begin;
+  if (CompileUs >= 0) {
+    Stat &St = S.Entries[TranslationUnits][Path];
+    St.TotalUs += CompileUs;
+    ++St.Count;
+  }
+  ++S.NumTraces;
+}
+
+static void summarizeTrace(StringRef Path, Summary &S) {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> Buf = MemoryBuffer::getFile(Path);
+  if (!Buf) {
+    S.Error = Buf.getError().message();
+    return;
+  }
+  Expected<json::Value> Trace = json::parse((*Buf)->getBuffer());
+  if (!Trace) {
+    S.Error = toString(Trace.takeError());
+    return;
+  }
+  const json::Object *Root = Trace->getAsObject();
+  const json::Array *TraceEvents =
+      Root ? Root->getArray("traceEvents") : nullptr;
+  if (!TraceEvents) {
+    S.Error = "not a time trace: no traceEvents array";
+    return;
+  }
+
+  std::vector<Event> Events;
+  Events.reserve(TraceEvents->size());
+  for (const json::Value &V : *TraceEvents) {
+    const json::Object *O = V.getAsObject();
+    if (!O || O->getString("ph") != "X")
+      continue;
+    std::optional<StringRef> Name = O->getString("name");
+    std::optional<int64_t> Ts = O->getInteger("ts");
+    std::optional<int64_t> Dur = O->getInteger("dur");
+    if (!Name || !Ts || !Dur)
+      continue;
+    StringRef Detail;
+    if (const json::Object *Args = O->getObject("args"))
+      Detail = Args->getString("detail").value_or("");
+    Events.push_back({O->getInteger("tid").value_or(0), *Ts, *Dur, *Name,
+                      Detail});
+  }
+  summarizeEvents(Events, Path, S);
+}
+
+static void collectTraces(StringRef Path, std::vector<std::string> &Traces) {
+  if (!sys::fs::is_directory(Path)) {
+    Traces.push_back(Path.str());
+    return;
+  }
+  std::error_code EC;
+  for (sys::fs::recursive_directory_iterator It(Path, EC), E; It != E && !EC;
+       It.increment(EC))
+    if (StringRef(It->path()).endswith(".json") &&
+        !sys::fs::is_directory(It->path()))
+      Traces.push_back(It->path());
+  if (EC)
+    WithColor::warning() << Path << ": " << EC.message() << "\n";
+}
+
+static void printCategory(raw_ostream &OS, CategoryKind Kind,
+                          const StringMap<Stat> &Entries) {
+  OS << "**** " << CategoryTitles[Kind] << ":\n";
+  std::vector<const StringMapEntry<Stat> *> Sorted;
+  Sorted.reserve(Entries.size());
+  for (const auto &Entry : Entries)
+    Sorted.push_back(&Entry);
+  size_t N = std::min<size_t>(Top, Sorted.size());
+  std::partial_sort(Sorted.begin(), Sorted.begin() + N, Sorted.end(),
+                    [](const StringMapEntry<Stat> *A,
+                       const StringMapEntry<Stat> *B) {
+                      if (A->getValue().TotalUs != B->getValue().TotalUs)
+                        return A->getValue().TotalUs > B->getValue().TotalUs;
+                      return A->getKey() < B->getKey();
+                    });
+  for (const StringMapEntry<Stat> *Entry : ArrayRef(Sorted).take_front(N)) {
+    const Stat &St = Entry->getValue();
+    OS << formatv("{0,8} ms: {1}", St.TotalUs / 1000, Entry->getKey());
+    if (Kind != TranslationUnits)
+      OS << formatv(" ({0} times, avg {1} ms)", St.Count,
+                    St.TotalUs / St.Count / 1000);
+    OS << "\n";
+  }
+  OS << "\n";
+}
+
+int main(int argc, const char *argv[]) {
+  InitLLVM X(argc, argv);
+
+  cl::HideUnrelatedOptions({&TimeTraceReportCategory, &getColorCategory()});
+  cl::ParseCommandLineOptions(
+      argc, argv,
+      "LLVM time trace report\n\n"
+      "  Aggregates the -ftime-trace files of a build, given directly or as\n"
+      "  directories to search for .json files.\n");
+
+  std::vector<std::string> Traces;
+  for (const std::string &Path : InputPaths)
+    collectTraces(Path, Traces);
+
+  if (Jobs)
+    parallel::strategy = hardware_concurrency(Jobs);
+
+  Summary Total;
+  for (size_t Begin = 0; Begin < Traces.size(); Begin += BatchSize) {
+    size_t End = std::min(Begin + BatchSize, Traces.size());
+    std::vector<Summary> Batch(End - Begin);
+    parallelFor(Begin, End, [&](size_t I) {
+      summarizeTrace(Traces[I], Batch[I - Begin]);
+    });
+    for (size_t I = Begin; I != End; ++I) {
+      Summary &S = Batch[I - Begin];
+      if (!S.Error.empty()) {
+        WithColor::warning() << Traces[I] << ": " << S.Error << "\n";
+        continue;
+      }
+      Total.add(S);
+    }
+  }
+
+  std::error_code EC;
+  raw_fd_ostream OS(OutputFilename, EC, sys::fs::OF_TextWithCRLF);
+  if (EC) {
+    WithColor::error() << OutputFilename << ": " << EC.message() << "\n";
+    return 1;
+  }
+
+  OS << "**** Time summary:\n";
+  OS << formatv("Traces: {0}\n", Total.NumTraces);
+  OS << formatv("  Parsing (frontend):         {0,8} ms\n",
+                Total.FrontendUs / 1000);
+  OS << formatv("  Codegen & opts (backend):   {0,8} ms\n\n",
+                Total.BackendUs / 1000);
+  for (unsigned Kind = 0; Kind != NumCategories; ++Kind)
+    printCategory(OS, CategoryKind(Kind), Total.Entries[Kind]);
+  return 0;
+}
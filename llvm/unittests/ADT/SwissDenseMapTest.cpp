@@ -0,0 +1,196 @@
+//===- llvm/unittest/ADT/SwissDenseMapTest.cpp - SwissDenseMap tests ------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ADT/SwissDenseMap.h"
+#include "llvm/ADT/Hashing.h"
+#include "gtest/gtest.h"
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+
+using namespace llvm;
+
+namespace {
+
+TEST(SwissDenseMapTest, EmptyMap) {
+  SwissDenseMap<int, int> Map;
+  EXPECT_TRUE(Map.empty());
+  EXPECT_EQ(0u, Map.size());
+  EXPECT_TRUE(Map.begin() == Map.end());
+  EXPECT_TRUE(Map.find(1) == Map.end());
+  EXPECT_FALSE(Map.contains(1));
+  EXPECT_EQ(0, Map.lookup(1));
+  EXPECT_FALSE(Map.erase(1));
+  Map.clear();
+  EXPECT_TRUE(Map.empty());
+}
+
+TEST(SwissDenseMapTest, InsertFindErase) {
+  SwissDenseMap<int, int> Map;
+  EXPECT_TRUE(Map.insert({1, 10}).second);
+  EXPECT_FALSE(Map.insert({1, 20}).second);
+  EXPECT_EQ(10, Map.lookup(1));
+  EXPECT_EQ(1u, Map.count(1));
+
+  Map[2] = 30;
+  EXPECT_EQ(2u, Map.size());
+  auto It = Map.find(2);
+  ASSERT_TRUE(It != Map.end());
+  EXPECT_EQ(2, It->first);
+  EXPECT_EQ(30, It->second);
+
+  EXPECT_TRUE(Map.erase(1));
+  EXPECT_FALSE(Map.erase(1));
+  EXPECT_FALSE(Map.contains(1));
+  Map.erase(Map.find(2));
+  EXPECT_TRUE(Map.empty());
+}
+
+TEST(SwissDenseMapTest, TryEmplaceAndAssign) {
+  SwissDenseMap<int, std::unique_ptr<int>> Map;
+  auto Try = Map.try_emplace(1, std::make_unique<int>(1));
+  EXPECT_TRUE(Try.second);
+  auto Ptr = std::make_unique<int>(2);
+  Try = Map.try_emplace(1, std::move(Ptr));
+  EXPECT_FALSE(Try.second);
+  // The value isn't moved from when the key is already in the map.
+  EXPECT_TRUE(Ptr);
+  EXPECT_EQ(1, *Map[1]);
+
+  auto Assign = Map.insert_or_assign(1, std::move(Ptr));
+  EXPECT_FALSE(Assign.second);
+  EXPECT_EQ(2, *Map[1]);
+}
+
+// Keys with all their hashes colliding land in the same groups, and must be
+// found through the control bytes and the probe sequence.
+struct CollidingKeyInfo {
+  static unsigned getHashValue(int) { return 0; }
+  static bool isEqual(int LHS, int RHS) { return LHS == RHS; }
+};
+
+TEST(SwissDenseMapTest, CollidingHashes) {
+  SwissDenseMap<int, int, CollidingKeyInfo> Map;
+  for (int I = 0; I < 100; ++I)
+    Map[I] = I * 2;
+  EXPECT_EQ(100u, Map.size());
+  for (int I = 0; I < 100; I += 2)
+    EXPECT_TRUE(Map.erase(I));
+  for (int I = 0; I < 100; ++I)
+    EXPECT_EQ(I % 2 != 0, Map.contains(I));
+  for (int I = 1; I < 100; I += 2)
+    EXPECT_EQ(I * 2, Map.lookup(I));
+}
+
+// Compare against std::map for random sequences of operations, which
+// exercises growth, deleted buckets and their reuse.
+TEST(SwissDenseMapTest, RandomOperations) {
+  std::mt19937 Generator(0);
+  SwissDenseMap<unsigned, unsigned> Map;
+  std::map<unsigned, unsigned> Reference;
+  for (unsigned Step = 0; Step < 200000; ++Step) {
+    unsigned Key = Generator() % 4096;
+    switch (Generator() % 3) {
+    case 0:
+      Map[Key] = Step;
+      Reference[Key] = Step;
+      break;
+    case 1:
+      EXPECT_EQ(Reference.erase(Key) != 0, Map.erase(Key));
+      break;
+    case 2:
+      EXPECT_EQ(Reference.count(Key), Map.count(Key));
+      break;
+    }
+    ASSERT_EQ(Reference.size(), Map.size());
+  }
+
+  std::map<unsigned, unsigned> Contents;
+  for (const auto &KV : Map)
+    EXPECT_TRUE(Contents.insert(KV).second);
+  EXPECT_EQ(Reference, Contents);
+}
+
+TEST(SwissDenseMapTest, EraseWhileIterating) {
+  SwissDenseMap<int, int> Map;
+  for (int I = 0; I < 1000; ++I)
+    Map[I] = I;
+  // Erasing doesn't move the other entries.
+  for (auto It = Map.begin(), E = Map.end(); It != E; ++It)
+    if (It->first % 3 == 0)
+      Map.erase(It);
+  EXPECT_EQ(666u, Map.size());
+  for (int I = 0; I < 1000; ++I)
+    EXPECT_EQ(I % 3 != 0, Map.contains(I));
+}
+
+// The keys don't need empty and tombstone values.
+struct StringKeyInfo {
+  static unsigned getHashValue(const std::string &S) { return hash_value(S); }
+  static bool isEqual(const std::string &LHS, const std::string &RHS) {
+    return LHS == RHS;
+  }
+};
+
+TEST(SwissDenseMapTest, NonTrivialTypes) {
+  using MapT = SwissDenseMap<std::string, std::string, StringKeyInfo>;
+  MapT Map;
+  for (int I = 0; I < 500; ++I)
+    Map[std::to_string(I)] = std::string(I % 50, 'x');
+
+  MapT Copy(Map);
+  EXPECT_EQ(500u, Copy.size());
+  EXPECT_EQ(std::string(7, 'x'), Copy.lookup("107"));
+
+  MapT Moved(std::move(Map));
+  EXPECT_EQ(500u, Moved.size());
+  EXPECT_TRUE(Map.empty());
+
+  Map = Copy;
+  EXPECT_EQ(500u, Map.size());
+  Copy.clear();
+  EXPECT_TRUE(Copy.empty());
+  EXPECT_FALSE(Copy.contains("1"));
+  Map = std::move(Moved);
+  EXPECT_EQ(std::string(49, 'x'), Map.lookup("49"));
+}
+
+TEST(SwissDenseMapTest, ReserveAvoidsGrowth) {
+  SwissDenseMap<int, int> Map;
+  Map.reserve(1000);
+  size_t MemorySize = Map.getMemorySize();
+  for (int I = 0; I < 1000; ++I)
+    Map[I] = I;
+  EXPECT_EQ(MemorySize, Map.getMemorySize());
+}
+
+TEST(SwissDenseMapTest, InitializerListAndRange) {
+  SwissDenseMap<int, int> Map({{1, 2}, {3, 4}});
+  EXPECT_EQ(2u, Map.size());
+  EXPECT_EQ(4, Map.lookup(3));
+
+  SwissDenseMap<int, int> FromRange(Map.begin(), Map.end());
+  EXPECT_EQ(2u, FromRange.size());
+  EXPECT_EQ(2, FromRange.lookup(1));
+}
+
+TEST(SwissDenseMapTest, ConstIterators) {
+  SwissDenseMap<int, int> Map;
+  Map[1] = 1;
+  const SwissDenseMap<int, int> &ConstMap = Map;
+  SwissDenseMap<int, int>::const_iterator It = Map.find(1);
+  EXPECT_TRUE(It == ConstMap.find(1));
+  EXPECT_TRUE(ConstMap.find(2) == ConstMap.end());
+  unsigned Count = 0;
+  for (const auto &KV : ConstMap)
+    Count += KV.second;
+  EXPECT_EQ(1u, Count);
+}
+
+} // namespace
@@ -0,0 +1,159 @@
+//===- AACacheTest.cpp - AACache unit tests -------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Analysis/AACache.h"
+#include "llvm/Analysis/AliasAnalysis.h"
+#include "llvm/Analysis/AssumptionCache.h"
+#include "llvm/Analysis/BasicAliasAnalysis.h"
+#include "llvm/Analysis/TargetLibraryInfo.h"
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/SourceMgr.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+
+namespace {
+
+class AACacheTest : public testing::Test {
+protected:
+  AACacheTest() : TLI(TLII) {}
+
+  void parseAssembly(StringRef Assembly) {
+    SMDiagnostic Error;
+    M = parseAssemblyString(Assembly, Error, Context);
+    ASSERT_TRUE(M) << Error.getMessage();
+    F = M->getFunction("test");
+    ASSERT_TRUE(F) << "Test must have a function @test";
+    AC = std::make_unique<AssumptionCache>(*F);
+    BAR = std::make_unique<BasicAAResult>(M->getDataLayout(), *F, TLI, *AC);
+    AAR = std::make_unique<AAResults>(TLI);
+    AAR->addAAResult(*BAR);
+  }
+
+  Instruction *findInstruction(StringRef Name) {
+    for (Instruction &I : instructions(F))
+      if (I.getName() == Name)
+        return &I;
+    return nullptr;
+  }
+
+  AliasResult alias(const Value *A, const Value *B) {
+    // Each query uses a new batch, so that only the AACache persists.
+    BatchAAResults BAA(*AAR, &Cache);
+    return BAA.alias(MemoryLocation(A, LocationSize::precise(1)),
+                     MemoryLocation(B, LocationSize::precise(1)));
+  }
+
+  ModRefInfo getModRefInfo(const Instruction *I, const Value *P) {
+    BatchAAResults BAA(*AAR, &Cache);
+    return BAA.getModRefInfo(I, MemoryLocation(P, LocationSize::precise(1)));
+  }
+
+  LLVMContext Context;
+  std::unique_ptr<Module> M;
+  Function *F = nullptr;
+  TargetLibraryInfoImpl TLII;
+  TargetLibraryInfo TLI;
+  std::unique_ptr<AssumptionCache> AC;
+  std::unique_ptr<BasicAAResult> BAR;
+  std::unique_ptr<AAResults> AAR;
+  AACache Cache;
+};
+
+TEST_F(AACacheTest, InvalidateValue) {
+  parseAssembly("define void @test(ptr noalias %a, ptr noalias %b) {\n"
+                "  %A = getelementptr i8, ptr %a, i64 1\n"
+                "  %B = getelementptr i8, ptr %b, i64 1\n"
+                "  ret void\n"
+                "}\n");
+  Instruction *A = findInstruction("A");
+  Instruction *B = findInstruction("B");
+
+  EXPECT_EQ(alias(A, B), AliasResult::NoAlias);
+  EXPECT_EQ(alias(B, A), AliasResult::NoAlias);
+
+  // Modifying %A in place is not observed until the cache is notified.
+  A->setOperand(0, F->getArg(1));
+  EXPECT_EQ(alias(A, B), AliasResult::NoAlias);
+
+  Cache.invalidateValue(A);
+  EXPECT_EQ(alias(A, B), AliasResult::MustAlias);
+}
+
+TEST_F(AACacheTest, ReplaceAndDelete) {
+  parseAssembly("define void @test(ptr noalias %a, ptr noalias %b) {\n"
+                "  %X = getelementptr i8, ptr %a, i64 0\n"
+                "  %Y = getelementptr i8, ptr %X, i64 1\n"
+                "  %Z = getelementptr i8, ptr %b, i64 1\n"
+                "  ret void\n"
+                "}\n");
+  Instruction *X = findInstruction("X");
+  Instruction *Y = findInstruction("Y");
+  Instruction *Z = findInstruction("Z");
+
+  EXPECT_EQ(alias(Y, Z), AliasResult::NoAlias);
+
+  // Replacing %X, which %Y is computed from, drops the entries of %Y.
+  X->replaceAllUsesWith(F->getArg(1));
+  X->eraseFromParent();
+  EXPECT_EQ(alias(Y, Z), AliasResult::MustAlias);
+
+  // Deleting a value that has entries must not leave dangling entries.
+  Z->eraseFromParent();
+  Y->eraseFromParent();
+  Cache.clear();
+}
+
+TEST_F(AACacheTest, NewCapture) {
+  parseAssembly("declare void @g()\n"
+                "define void @test(ptr %p) {\n"
+                "  %A = alloca i8\n"
+                "  %L = load ptr, ptr %p\n"
+                "  call void @g()\n"
+                "  ret void\n"
+                "}\n");
+  Instruction *A = findInstruction("A");
+  Instruction *L = findInstruction("L");
+  auto *Call = cast<CallInst>(L->getNextNode());
+
+  EXPECT_EQ(alias(A, L), AliasResult::NoAlias);
+  EXPECT_EQ(getModRefInfo(Call, A), ModRefInfo::NoModRef);
+
+  // Notifying the cache of a new store of %A drops the entries that relied on
+  // %A not being captured.
+  auto *SI = new StoreInst(A, F->getArg(0), L);
+  Cache.invalidateValue(SI);
+  EXPECT_EQ(alias(A, L), AliasResult::MayAlias);
+  EXPECT_EQ(getModRefInfo(Call, A), ModRefInfo::ModRef);
+}
+
+TEST_F(AACacheTest, ReplaceRemovedInstruction) {
+  parseAssembly("define void @test(ptr noalias %a, ptr noalias %b) {\n"
+                "  %A = getelementptr i8, ptr %a, i64 1\n"
+                "  %B = getelementptr i8, ptr %b, i64 1\n"
+                "  ret void\n"
+                "}\n");
+  Instruction *A = findInstruction("A");
+  Instruction *B = findInstruction("B");
+
+  EXPECT_EQ(alias(A, B), AliasResult::NoAlias);
+
+  // A tracked instruction can be replaced after it was removed from the
+  // function.
+  A->removeFromParent();
+  A->replaceAllUsesWith(ConstantPointerNull::get(PointerType::get(Context, 0)));
+  A->deleteValue();
+  EXPECT_EQ(alias(B, F->getArg(0)), AliasResult::NoAlias);
+}
+
+} // end anonymous namespace
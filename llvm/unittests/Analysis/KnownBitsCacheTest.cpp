@@ -0,0 +1,137 @@
+//===- KnownBitsCacheTest.cpp - KnownBitsCache unit tests -----------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Analysis/KnownBitsCache.h"
+#include "llvm/Analysis/AssumptionCache.h"
+#include "llvm/Analysis/ValueTracking.h"
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/Dominators.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/SourceMgr.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+
+namespace {
+
+class KnownBitsCacheTest : public testing::Test {
+protected:
+  void parseAssembly(StringRef Assembly) {
+    SMDiagnostic Error;
+    M = parseAssemblyString(Assembly, Error, Context);
+    ASSERT_TRUE(M) << Error.getMessage();
+    F = M->getFunction("test");
+    ASSERT_TRUE(F) << "Test must have a function @test";
+    DT = std::make_unique<DominatorTree>(*F);
+    AC = std::make_unique<AssumptionCache>(*F);
+    KBC = std::make_unique<KnownBitsCache>(M->getDataLayout(), AC.get(),
+                                           DT.get());
+  }
+
+  Instruction *findInstruction(StringRef Name) {
+    for (Instruction &I : instructions(F))
+      if (I.getName() == Name)
+        return &I;
+    return nullptr;
+  }
+
+  LLVMContext Context;
+  std::unique_ptr<Module> M;
+  Function *F = nullptr;
+  std::unique_ptr<DominatorTree> DT;
+  std::unique_ptr<AssumptionCache> AC;
+  std::unique_ptr<KnownBitsCache> KBC;
+};
+
+TEST_F(KnownBitsCacheTest, InvalidateValue) {
+  parseAssembly("define i32 @test(i32 %x) {\n"
+                "  %A = and i32 %x, 255\n"
+                "  %B = shl i32 %A, 1\n"
+                "  ret i32 %B\n"
+                "}\n");
+  Instruction *A = findInstruction("A");
+  Instruction *B = findInstruction("B");
+
+  KnownBits Known = KBC->computeKnownBits(B);
+  EXPECT_EQ(Known.Zero.getZExtValue(), 0xfffffe01u);
+  EXPECT_EQ(KBC->ComputeNumSignBits(B), 23u);
+
+  // Modifying %A in place is not observed until the cache is notified.
+  A->setOperand(1, ConstantInt::get(A->getType(), 15));
+  EXPECT_EQ(KBC->computeKnownBits(B).Zero.getZExtValue(), 0xfffffe01u);
+
+  // Invalidating %A also invalidates its user %B.
+  KBC->invalidateValue(A);
+  EXPECT_EQ(KBC->computeKnownBits(B).Zero,
+            computeKnownBits(B, M->getDataLayout()).Zero);
+  EXPECT_EQ(KBC->computeKnownBits(B).Zero.getZExtValue(), 0xffffffe1u);
+  EXPECT_EQ(KBC->ComputeNumSignBits(B), 27u);
+}
+
+TEST_F(KnownBitsCacheTest, ReplaceAndDelete) {
+  parseAssembly("define i32 @test(i32 %x) {\n"
+                "  %A = and i32 %x, 255\n"
+                "  %A2 = and i32 %x, 15\n"
+                "  %B = or i32 %A, 1\n"
+                "  ret i32 %B\n"
+                "}\n");
+  Instruction *A = findInstruction("A");
+  Instruction *A2 = findInstruction("A2");
+  Instruction *B = findInstruction("B");
+
+  EXPECT_EQ(KBC->computeKnownBits(A).Zero.getZExtValue(), 0xffffff00u);
+  EXPECT_EQ(KBC->computeKnownBits(B).Zero.getZExtValue(), 0xffffff00u);
+
+  // Replacing %A drops the entries of %A and of its users.
+  A->replaceAllUsesWith(A2);
+  A->eraseFromParent();
+  EXPECT_EQ(KBC->computeKnownBits(B).Zero.getZExtValue(), 0xfffffff0u);
+
+  // Deleting a value that has entries must not leave dangling entries.
+  KBC->computeKnownBits(A2);
+  B->replaceAllUsesWith(PoisonValue::get(B->getType()));
+  B->eraseFromParent();
+  A2->eraseFromParent();
+  KBC->clear();
+}
+
+TEST_F(KnownBitsCacheTest, ContextInstruction) {
+  parseAssembly("declare void @llvm.assume(i1)\n"
+                "define i32 @test(ptr %p, i1 %c) {\n"
+                "entry:\n"
+                "  %A = load i32, ptr %p\n"
+                "  %CxtI = add i32 0, 0\n"
+                "  br i1 %c, label %then, label %exit\n"
+                "then:\n"
+                "  %cmp = icmp ult i32 %A, 16\n"
+                "  call void @llvm.assume(i1 %cmp)\n"
+                "  %CxtI2 = add i32 0, 0\n"
+                "  br label %exit\n"
+                "exit:\n"
+                "  ret i32 %A\n"
+                "}\n");
+  Instruction *A = findInstruction("A");
+  Instruction *CxtI = findInstruction("CxtI");
+  Instruction *CxtI2 = findInstruction("CxtI2");
+
+  // The assumption only holds in the block of the call, so the results are
+  // cached separately for each context.
+  EXPECT_TRUE(KBC->computeKnownBits(A, CxtI).Zero.isZero());
+  EXPECT_EQ(KBC->computeKnownBits(A, CxtI2).Zero.getZExtValue(), 0xfffffff0u);
+  EXPECT_TRUE(KBC->computeKnownBits(A, CxtI).Zero.isZero());
+
+  // Deleting a context instruction drops the entries computed in its context.
+  CxtI2->eraseFromParent();
+  EXPECT_TRUE(KBC->computeKnownBits(A, CxtI).Zero.isZero());
+}
+
+} // end anonymous namespace
@@ -1744,4 +1744,59 @@ TEST_F(ScalarEvolutionsTest, ComputeMaxTripCountFromMultiDemArray) {
   });
 }
 
+TEST_F(ScalarEvolutionsTest, ForgetLoopDropsPredicatedRewritesOfSubLoops) {
+  LLVMContext C;
+  SMDiagnostic Err;
+  std::unique_ptr<Module> M = parseAssemblyString(
+      "define void @foo(i64 %n) { "
+      "entry: "
+      "  br label %outer "
+      "outer: "
+      "  %j = phi i64 [ 0, %entry ], [ %j.next, %outer.latch ] "
+      "  br label %inner "
+      "inner: "
+      "  %iv = phi i64 [ 0, %outer ], [ %iv.next, %inner ] "
+      "  %shl = shl i64 %iv, 32 "
+      "  %ashr = ashr exact i64 %shl, 32 "
+      "  %iv.next = add i64 %ashr, 1 "
+      "  %inner.cond = icmp slt i64 %iv.next, %n "
+      "  br i1 %inner.cond, label %inner, label %outer.latch "
+      "outer.latch: "
+      "  %j.next = add i64 %j, 1 "
+      "  %outer.cond = icmp slt i64 %j.next, %n "
+      "  br i1 %outer.cond, label %outer, label %exit "
+      "exit: "
+      "  ret void "
+      "} ",
+      Err, C);
+
+  ASSERT_TRUE(M && "Could not parse module?");
+  ASSERT_TRUE(!verifyModule(*M) && "Must have been well formed!");
+
+  runWithSE(*M, "foo", [](Function &F, LoopInfo &LI, ScalarEvolution &SE) {
+    auto *IV = getInstructionByName(F, "iv");
+    auto *IVNext = getInstructionByName(F, "iv.next");
+    const Loop *Outer = LI.getLoopFor(IV->getParent())->getParentLoop();
+    ASSERT_NE(Outer, nullptr);
+
+    auto *Expr = dyn_cast<SCEVUnknown>(SE.getSCEV(IV));
+    ASSERT_NE(Expr, nullptr);
+    auto Result = SE.createAddRecFromPHIWithCasts(Expr);
+    ASSERT_TRUE(Result);
+    EXPECT_EQ(cast<SCEVAddRecExpr>(Result->first)->getStepRecurrence(SE),
+              SE.getConstant(IV->getType(), 1));
+
+    // Forgetting the outer loop also drops the rewrite cached for the inner
+    // one, so the new step is seen.
+    IVNext->setOperand(1, ConstantInt::get(IV->getType(), 2));
+    SE.forgetLoop(Outer);
+    Expr = dyn_cast<SCEVUnknown>(SE.getSCEV(IV));
+    ASSERT_NE(Expr, nullptr);
+    Result = SE.createAddRecFromPHIWithCasts(Expr);
+    ASSERT_TRUE(Result);
+    EXPECT_EQ(cast<SCEVAddRecExpr>(Result->first)->getStepRecurrence(SE),
+              SE.getConstant(IV->getType(), 2));
+  });
+}
+
 }  // end namespace llvm
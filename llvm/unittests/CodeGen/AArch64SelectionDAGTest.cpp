@@ -621,4 +621,36 @@ TEST_F(AArch64SelectionDAGTest, ReplaceAllUsesWith) {
   EXPECT_EQ(DAG->getPCSections(New.getNode()), MD);
 }
 
+TEST_F(AArch64SelectionDAGTest, ClearKeepsOperandMemoryUsable) {
+  SDLoc Loc;
+  auto IntVT = EVT::getIntegerVT(Context, 32);
+  auto VecVT = EVT::getVectorVT(Context, IntVT, 4);
+  const int Mask[] = {4, 1, 6, 3};
+
+  // clear() keeps the operand arrays for the next DAG until the shuffle masks,
+  // which are never recycled, grow the pool past its limit. Build enough DAGs
+  // to go through both paths and check that the nodes of each are intact.
+  for (unsigned Round = 0; Round != 40; ++Round) {
+    SmallVector<SDValue, 0> Adds, Shuffles;
+    for (unsigned I = 0; I != 2000; ++I) {
+      SDValue A = DAG->getRegister(Register::index2VirtReg(2 * I), VecVT);
+      SDValue B = DAG->getRegister(Register::index2VirtReg(2 * I + 1), VecVT);
+      Adds.push_back(DAG->getNode(ISD::ADD, Loc, VecVT, A, B));
+      Shuffles.push_back(DAG->getVectorShuffle(VecVT, Loc, A, B, Mask));
+    }
+    for (unsigned I = 0; I != 2000; ++I) {
+      auto *A = cast<RegisterSDNode>(Adds[I].getOperand(0));
+      auto *B = cast<RegisterSDNode>(Adds[I].getOperand(1));
+      EXPECT_EQ(A->getReg(), Register::index2VirtReg(2 * I));
+      EXPECT_EQ(B->getReg(), Register::index2VirtReg(2 * I + 1));
+      auto *Shuffle = cast<ShuffleVectorSDNode>(Shuffles[I]);
+      EXPECT_EQ(Shuffle->getOperand(0), Adds[I].getOperand(0));
+      EXPECT_EQ(Shuffle->getOperand(1), Adds[I].getOperand(1));
+      EXPECT_EQ(Shuffle->getMask(), ArrayRef(Mask));
+    }
+    DAG->clear();
+    EXPECT_EQ(DAG->getRoot(), DAG->getEntryNode());
+  }
+}
+
 } // end namespace llvm
@@ -22,6 +22,7 @@
 #include "llvm/ObjectYAML/DWARFEmitter.h"
 #include "llvm/Support/DataExtractor.h"
 #include "llvm/Support/Endian.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Testing/Support/Error.h"
 
 #include "gtest/gtest.h"
@@ -2443,3 +2444,53 @@ TEST(GSYMTest, TestGsymCreatorMultipleSymbolsWithNoSize) {
                    1, // NumAddresses
                    ArrayRef<uint8_t>(UUID));
 }
+
+static SmallString<0> EncodeManyFunctions(unsigned NumThreads) {
+  // Add more functions than GsymCreator encodes in one batch, in reverse
+  // address order, and pairs of symbols with the same address range.
+  GsymCreator GC(/*Quiet=*/true);
+  constexpr uint64_t BaseAddr = 0x100000;
+  constexpr uint64_t FuncSize = 0x200;
+  constexpr uint32_t NumFuncs = 10000;
+  const uint32_t FileIdx = GC.insertFile("/tmp/main.c");
+  for (uint32_t I = NumFuncs; I-- > 0;) {
+    const uint64_t FuncAddr = BaseAddr + I * FuncSize;
+    FunctionInfo FI(FuncAddr, FuncSize,
+                    GC.insertString("func" + std::to_string(I)));
+    if (I % 2 == 0)
+      AddLines(FuncAddr, FileIdx, FI);
+    GC.addFunctionInfo(std::move(FI));
+    if (I % 3 == 0)
+      GC.addFunctionInfo(FunctionInfo(
+          FuncAddr, FuncSize, GC.insertString("alias" + std::to_string(I))));
+  }
+  parallel::strategy = hardware_concurrency(NumThreads);
+  Error FinalizeErr = GC.finalize(llvm::nulls());
+  EXPECT_FALSE((bool)FinalizeErr);
+  SmallString<0> Str;
+  raw_svector_ostream OutStrm(Str);
+  FileWriter FW(OutStrm, llvm::support::little);
+  Error Err = GC.encode(FW);
+  EXPECT_FALSE((bool)Err);
+  parallel::strategy = hardware_concurrency();
+  return Str;
+}
+
+TEST(GSYMTest, TestGsymCreatorParallelEncoding) {
+  // Finalizing and encoding in parallel must give the same bytes as doing it
+  // on a single thread.
+  SmallString<0> Serial = EncodeManyFunctions(1);
+  SmallString<0> Parallel = EncodeManyFunctions(4);
+  EXPECT_EQ(Serial, Parallel);
+
+  Expected<GsymReader> GR = GsymReader::copyBuffer(Parallel);
+  ASSERT_THAT_EXPECTED(GR, Succeeded());
+  EXPECT_EQ(GR->getNumAddresses(), 10000u);
+  for (uint32_t I : {0u, 1u, 4095u, 4096u, 9999u}) {
+    auto FI = GR->getFunctionInfo(0x100000 + I * 0x200 + 0x10);
+    ASSERT_THAT_EXPECTED(FI, Succeeded());
+    EXPECT_EQ(FI->Range.start(), 0x100000 + I * 0x200);
+    if (I % 3 != 0)
+      EXPECT_EQ(FI->OptLineTable.has_value(), I % 2 == 0);
+  }
+}
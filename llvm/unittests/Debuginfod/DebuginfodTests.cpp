@@ -7,14 +7,17 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/Debuginfod/Debuginfod.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/Debuginfod/HTTPClient.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/xxhash.h"
 #include "llvm/Testing/Support/Error.h"
 #include "gtest/gtest.h"
 
 #ifdef _WIN32
 #define setenv(name, var, ignore) _putenv_s(name, var)
+#define unsetenv(name) _putenv_s(name, "")
 #endif
 
 #define ASSERT_NO_ERROR(x)                                                     \
@@ -30,6 +33,28 @@
 
 using namespace llvm;
 
+namespace {
+// Sets an environment variable for the lifetime of the object.
+class ScopedSetEnv {
+public:
+  ScopedSetEnv(const char *Name, const char *Value) : Name(Name) {
+    if (const char *OldValue = getenv(Name))
+      this->OldValue = OldValue;
+    setenv(Name, Value, /*replace=*/1);
+  }
+  ~ScopedSetEnv() {
+    if (OldValue)
+      setenv(Name.c_str(), OldValue->c_str(), /*replace=*/1);
+    else
+      unsetenv(Name.c_str());
+  }
+
+private:
+  std::string Name;
+  std::optional<std::string> OldValue;
+};
+} // namespace
+
 // Check that the Debuginfod client can find locally cached artifacts.
 TEST(DebuginfodClient, CacheHit) {
   int FD;
@@ -67,3 +92,28 @@ TEST(DebuginfodClient, CacheMiss) {
   // A cache miss with no possible URLs should not create the cache directory.
   EXPECT_FALSE(sys::fs::exists(CacheDir));
 }
+
+// Check that prefetching succeeds for artifacts that are already cached and
+// tolerates duplicate build IDs.
+TEST(DebuginfodClient, PrefetchCacheHit) {
+  SmallString<32> CacheDir;
+  ASSERT_NO_ERROR(
+      sys::fs::createUniqueDirectory("debuginfod-unittest", CacheDir));
+  ScopedSetEnv CachePath("DEBUGINFOD_CACHE_PATH", CacheDir.c_str());
+  ScopedSetEnv Urls("DEBUGINFOD_URLS", "");
+
+  // The client caches artifacts under the hash of their URL path.
+  SmallString<64> CachedFilePath(CacheDir.str());
+  sys::path::append(CachedFilePath,
+                    "llvmcache-" + utostr(xxHash64("buildid/abcd/debuginfo")));
+  std::error_code EC;
+  raw_fd_ostream OF(CachedFilePath, EC);
+  ASSERT_NO_ERROR(EC);
+  OF << "contents\n";
+  OF.close();
+
+  object::BuildID ID = {0xab, 0xcd};
+  EXPECT_THAT_ERROR(prefetchDebuginfo({ID, ID}, /*Parallelism=*/2),
+                    Succeeded());
+  ASSERT_NO_ERROR(sys::fs::remove_directories(CacheDir));
+}
@@ -0,0 +1,100 @@
+//===- CachingIRCompilerTest.cpp - Unit tests for CachingIRCompiler -------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/CompileUtils.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Testing/Support/Error.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace llvm::orc;
+
+namespace {
+
+// Returns the module identifier as the "object", and counts compiles.
+class CountingCompiler : public IRCompileLayer::IRCompiler {
+public:
+  CountingCompiler(unsigned &NumCompiles)
+      : IRCompiler(IRSymbolMapper::ManglingOptions()),
+        NumCompiles(NumCompiles) {}
+
+  Expected<std::unique_ptr<MemoryBuffer>> operator()(Module &M) override {
+    ++NumCompiles;
+    return MemoryBuffer::getMemBufferCopy("object:" + M.getModuleIdentifier());
+  }
+
+private:
+  unsigned &NumCompiles;
+};
+
+class CachingIRCompilerTest : public testing::Test {
+protected:
+  void SetUp() override {
+    ASSERT_FALSE(sys::fs::createUniqueDirectory("orc-cache-test", CacheDir));
+  }
+
+  void TearDown() override { sys::fs::remove_directories(CacheDir); }
+
+  Expected<std::unique_ptr<CachingIRCompiler>>
+  createCompiler(const JITTargetMachineBuilder &JTMB) {
+    return CachingIRCompiler::Create(
+        std::make_unique<CountingCompiler>(NumCompiles), JTMB, CacheDir);
+  }
+
+  std::string compile(IRCompileLayer::IRCompiler &C, Module &M) {
+    auto Obj = C(M);
+    EXPECT_THAT_EXPECTED(Obj, Succeeded());
+    if (!Obj)
+      return "";
+    return (*Obj)->getBuffer().str();
+  }
+
+  SmallString<128> CacheDir;
+  unsigned NumCompiles = 0;
+  LLVMContext Ctx;
+  JITTargetMachineBuilder JTMB{Triple("x86_64-unknown-linux-gnu")};
+};
+
+TEST_F(CachingIRCompilerTest, HitAcrossInstances) {
+  Module M("M", Ctx);
+  {
+    auto C = createCompiler(JTMB);
+    ASSERT_THAT_EXPECTED(C, Succeeded());
+    EXPECT_EQ(compile(**C, M), "object:M");
+    EXPECT_EQ(NumCompiles, 1U);
+  }
+
+  // A new compiler, as in a new process, finds the object on disk.
+  auto C = createCompiler(JTMB);
+  ASSERT_THAT_EXPECTED(C, Succeeded());
+  EXPECT_EQ(compile(**C, M), "object:M");
+  EXPECT_EQ(NumCompiles, 1U);
+}
+
+TEST_F(CachingIRCompilerTest, KeyCoversModuleAndTarget) {
+  auto C = createCompiler(JTMB);
+  ASSERT_THAT_EXPECTED(C, Succeeded());
+
+  Module M1("M1", Ctx);
+  Module M2("M2", Ctx);
+  EXPECT_EQ(compile(**C, M1), "object:M1");
+  EXPECT_EQ(compile(**C, M2), "object:M2");
+  EXPECT_EQ(NumCompiles, 2U);
+
+  JITTargetMachineBuilder OtherJTMB = JTMB;
+  OtherJTMB.setCPU("znver4");
+  auto OtherC = createCompiler(OtherJTMB);
+  ASSERT_THAT_EXPECTED(OtherC, Succeeded());
+  EXPECT_EQ(compile(**OtherC, M1), "object:M1");
+  EXPECT_EQ(NumCompiles, 3U);
+}
+
+} // end anonymous namespace
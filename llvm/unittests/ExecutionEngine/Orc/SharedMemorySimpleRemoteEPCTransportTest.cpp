@@ -0,0 +1,195 @@
+//===- SharedMemorySimpleRemoteEPCTransportTest.cpp -----------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/Shared/SimpleRemoteEPCUtils.h"
+#include "llvm/Testing/Support/Error.h"
+#include "gtest/gtest.h"
+
+#include <condition_variable>
+
+#if !defined(_MSC_VER) && !defined(__MINGW32__)
+#include <signal.h>
+#include <unistd.h>
+#endif
+
+using namespace llvm;
+using namespace llvm::orc;
+
+#if LLVM_ENABLE_THREADS && !defined(_MSC_VER) && !defined(__MINGW32__)
+
+namespace {
+
+class RecordingClient : public SimpleRemoteEPCTransportClient {
+public:
+  struct Message {
+    SimpleRemoteEPCOpcode OpC;
+    uint64_t SeqNo;
+    ExecutorAddr TagAddr;
+    std::string ArgBytes;
+  };
+
+  Expected<HandleMessageAction>
+  handleMessage(SimpleRemoteEPCOpcode OpC, uint64_t SeqNo, ExecutorAddr TagAddr,
+                SimpleRemoteEPCArgBytesVector ArgBytes) override {
+    std::lock_guard<std::mutex> Lock(M);
+    Messages.push_back(
+        {OpC, SeqNo, TagAddr, std::string(ArgBytes.begin(), ArgBytes.end())});
+    CV.notify_all();
+    return ContinueSession;
+  }
+
+  void handleDisconnect(Error Err) override {
+    std::lock_guard<std::mutex> Lock(M);
+    DisconnectErr = toString(std::move(Err));
+    Disconnected = true;
+    CV.notify_all();
+  }
+
+  void waitForMessages(size_t N) {
+    std::unique_lock<std::mutex> Lock(M);
+    CV.wait(Lock, [&]() { return Messages.size() >= N || Disconnected; });
+  }
+
+  void waitForDisconnect() {
+    std::unique_lock<std::mutex> Lock(M);
+    CV.wait(Lock, [&]() { return Disconnected; });
+  }
+
+  std::mutex M;
+  std::condition_variable CV;
+  std::vector<Message> Messages;
+  bool Disconnected = false;
+  std::string DisconnectErr;
+};
+
+class SharedMemorySimpleRemoteEPCTransportTest : public testing::Test {
+protected:
+  void SetUp() override {
+    // A peer that has already closed its end must not kill the test.
+    signal(SIGPIPE, SIG_IGN);
+    ASSERT_EQ(pipe(JITWakeFDs), 0);
+    ASSERT_EQ(pipe(ExecutorWakeFDs), 0);
+  }
+
+  void createTransports(size_t SharedMemSize) {
+    SharedMem.reset(new (std::align_val_t(64)) char[SharedMemSize]());
+    auto JITOrErr = SharedMemorySimpleRemoteEPCTransport::Create(
+        JITClient, SharedMemorySimpleRemoteEPCTransport::Side::JIT,
+        SharedMem.get(), SharedMemSize, JITWakeFDs[0], ExecutorWakeFDs[1]);
+    ASSERT_THAT_EXPECTED(JITOrErr, Succeeded());
+    JIT = std::move(*JITOrErr);
+    auto ExecutorOrErr = SharedMemorySimpleRemoteEPCTransport::Create(
+        ExecutorClient, SharedMemorySimpleRemoteEPCTransport::Side::Executor,
+        SharedMem.get(), SharedMemSize, ExecutorWakeFDs[0], JITWakeFDs[1]);
+    ASSERT_THAT_EXPECTED(ExecutorOrErr, Succeeded());
+    Executor = std::move(*ExecutorOrErr);
+    ASSERT_THAT_ERROR(JIT->start(), Succeeded());
+    ASSERT_THAT_ERROR(Executor->start(), Succeeded());
+  }
+
+  void TearDown() override {
+    if (JIT) {
+      JIT->disconnect();
+      JITClient.waitForDisconnect();
+      ExecutorClient.waitForDisconnect();
+    }
+    // Join the listener threads before the shared memory goes away.
+    JIT.reset();
+    Executor.reset();
+  }
+
+  struct AlignedDelete {
+    void operator()(char *P) const {
+      operator delete[](P, std::align_val_t(64));
+    }
+  };
+
+  int JITWakeFDs[2];
+  int ExecutorWakeFDs[2];
+  std::unique_ptr<char[], AlignedDelete> SharedMem;
+  RecordingClient JITClient;
+  RecordingClient ExecutorClient;
+  std::unique_ptr<SharedMemorySimpleRemoteEPCTransport> JIT;
+  std::unique_ptr<SharedMemorySimpleRemoteEPCTransport> Executor;
+};
+
+TEST_F(SharedMemorySimpleRemoteEPCTransportTest, RegionTooSmall) {
+  SharedMem.reset(new (std::align_val_t(64)) char[128]());
+  EXPECT_THAT_EXPECTED(SharedMemorySimpleRemoteEPCTransport::Create(
+                           JITClient,
+                           SharedMemorySimpleRemoteEPCTransport::Side::JIT,
+                           SharedMem.get(), 128, JITWakeFDs[0],
+                           ExecutorWakeFDs[1]),
+                       Failed());
+  for (int FD : {JITWakeFDs[0], JITWakeFDs[1], ExecutorWakeFDs[0],
+                 ExecutorWakeFDs[1]})
+    close(FD);
+}
+
+TEST_F(SharedMemorySimpleRemoteEPCTransportTest, MessagesInBothDirections) {
+  createTransports(4096);
+
+  constexpr unsigned NumMessages = 100;
+  for (unsigned I = 0; I != NumMessages; ++I) {
+    std::string Arg = "message " + std::to_string(I);
+    EXPECT_THAT_ERROR(JIT->sendMessage(SimpleRemoteEPCOpcode::CallWrapper, I,
+                                       ExecutorAddr(0x1000 + I),
+                                       ArrayRef<char>(Arg.data(), Arg.size())),
+                      Succeeded());
+  }
+  EXPECT_THAT_ERROR(Executor->sendMessage(SimpleRemoteEPCOpcode::Result, 7,
+                                          ExecutorAddr(), {}),
+                    Succeeded());
+
+  ExecutorClient.waitForMessages(NumMessages);
+  ASSERT_EQ(ExecutorClient.Messages.size(), NumMessages);
+  for (unsigned I = 0; I != NumMessages; ++I) {
+    auto &Msg = ExecutorClient.Messages[I];
+    EXPECT_EQ(Msg.OpC, SimpleRemoteEPCOpcode::CallWrapper);
+    EXPECT_EQ(Msg.SeqNo, I);
+    EXPECT_EQ(Msg.TagAddr, ExecutorAddr(0x1000 + I));
+    EXPECT_EQ(Msg.ArgBytes, "message " + std::to_string(I));
+  }
+
+  JITClient.waitForMessages(1);
+  ASSERT_EQ(JITClient.Messages.size(), 1U);
+  EXPECT_EQ(JITClient.Messages[0].OpC, SimpleRemoteEPCOpcode::Result);
+  EXPECT_EQ(JITClient.Messages[0].SeqNo, 7U);
+}
+
+TEST_F(SharedMemorySimpleRemoteEPCTransportTest, MessageLargerThanRing) {
+  createTransports(1024);
+
+  std::string Arg(100000, '\0');
+  for (size_t I = 0; I != Arg.size(); ++I)
+    Arg[I] = static_cast<char>(I * 31);
+  EXPECT_THAT_ERROR(JIT->sendMessage(SimpleRemoteEPCOpcode::CallWrapper, 1,
+                                     ExecutorAddr(),
+                                     ArrayRef<char>(Arg.data(), Arg.size())),
+                    Succeeded());
+
+  ExecutorClient.waitForMessages(1);
+  ASSERT_EQ(ExecutorClient.Messages.size(), 1U);
+  EXPECT_EQ(ExecutorClient.Messages[0].ArgBytes, Arg);
+}
+
+TEST_F(SharedMemorySimpleRemoteEPCTransportTest, DisconnectReachesPeer) {
+  createTransports(4096);
+
+  Executor->disconnect();
+  JITClient.waitForDisconnect();
+  ExecutorClient.waitForDisconnect();
+  EXPECT_TRUE(JITClient.DisconnectErr.empty());
+  EXPECT_THAT_ERROR(JIT->sendMessage(SimpleRemoteEPCOpcode::Hangup, 0,
+                                     ExecutorAddr(), {}),
+                    Failed());
+}
+
+} // end anonymous namespace
+
+#endif
@@ -7,9 +7,14 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/ExecutionEngine/Orc/TaskDispatch.h"
+#include "OrcTestCommon.h"
+#include "llvm/ExecutionEngine/Orc/Core.h"
+#include "llvm/ExecutionEngine/Orc/ExecutorProcessControl.h"
 #include "gtest/gtest.h"
 
+#include <condition_variable>
 #include <future>
+#include <mutex>
 
 using namespace llvm;
 using namespace llvm::orc;
@@ -32,4 +37,82 @@ TEST(DynamicThreadPoolDispatchTest, GenericNamedTask) {
   EXPECT_TRUE(F.get());
   D->shutdown();
 }
+
+TEST(DynamicThreadPoolDispatchTest, GenericTasksNotLimited) {
+  // The materialization thread limit must not apply to other tasks: these two
+  // tasks can only complete if they run concurrently.
+  auto D = std::make_unique<DynamicThreadPoolTaskDispatcher>(1);
+  std::promise<void> P1, P2;
+  auto F1 = P1.get_future().share();
+  auto F2 = P2.get_future().share();
+  D->dispatch(makeGenericNamedTask([&P1, F2]() {
+    P1.set_value();
+    F2.wait();
+  }));
+  D->dispatch(makeGenericNamedTask([&P2, F1]() {
+    P2.set_value();
+    F1.wait();
+  }));
+  D->shutdown();
+}
+
+TEST(DynamicThreadPoolDispatchTest, MaterializationTasksLimited) {
+  // Dispatch more materialization tasks than the limit allows to run at once,
+  // and hold the running ones until the others have been dispatched: the
+  // extra tasks must wait in the queue, then run once the first ones finish.
+  constexpr size_t MaxThreads = 2;
+  constexpr size_t NumTasks = 6;
+  ExecutionSession ES(std::make_unique<UnsupportedExecutorProcessControl>(
+      nullptr, std::make_unique<DynamicThreadPoolTaskDispatcher>(MaxThreads)));
+  auto &JD = ES.createBareJITDylib("JD");
+
+  std::mutex M;
+  std::condition_variable CV;
+  size_t Running = 0, MaxRunning = 0, Started = 0;
+  bool Release = false;
+
+  std::vector<std::future<void>> Lookups;
+  for (size_t I = 0; I != NumTasks; ++I) {
+    auto Name = ES.intern(("foo" + Twine(I)).str());
+    cantFail(JD.define(std::make_unique<SimpleMaterializationUnit>(
+        SymbolFlagsMap({{Name, JITSymbolFlags::Exported}}),
+        [&](std::unique_ptr<MaterializationResponsibility> R) {
+          {
+            std::unique_lock<std::mutex> Lock(M);
+            ++Started;
+            MaxRunning = std::max(MaxRunning, ++Running);
+            CV.notify_all();
+            CV.wait(Lock, [&]() { return Release; });
+            --Running;
+          }
+          R->failMaterialization();
+        })));
+
+    auto P = std::make_shared<std::promise<void>>();
+    Lookups.push_back(P->get_future());
+    ES.lookup(
+        LookupKind::Static, makeJITDylibSearchOrder(&JD),
+        SymbolLookupSet(Name), SymbolState::Ready,
+        [P](Expected<SymbolMap> Result) {
+          consumeError(Result.takeError());
+          P->set_value();
+        },
+        NoDependenciesToRegister);
+  }
+
+  {
+    std::unique_lock<std::mutex> Lock(M);
+    CV.wait(Lock, [&]() { return Started >= MaxThreads; });
+    // None of the queued tasks can start while the running ones are held.
+    EXPECT_EQ(Started, MaxThreads);
+    Release = true;
+    CV.notify_all();
+  }
+
+  for (auto &F : Lookups)
+    F.get();
+  EXPECT_EQ(Started, NumTasks);
+  EXPECT_EQ(MaxRunning, MaxThreads);
+  cantFail(ES.endSession());
+}
 #endif
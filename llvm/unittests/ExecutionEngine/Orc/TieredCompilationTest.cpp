@@ -0,0 +1,108 @@
+//===- TieredCompilationTest.cpp - Unit tests for LLLazyJIT tier-up -------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "OrcTestCommon.h"
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/ExecutionEngine/Orc/ExecutorProcessControl.h"
+#include "llvm/ExecutionEngine/Orc/LLJIT.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Testing/Support/Error.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace llvm::orc;
+
+namespace {
+
+const char *TestModule = "define i32 @f() {\n"
+                         "entry:\n"
+                         "  ret i32 42\n"
+                         "}\n";
+
+ThreadSafeModule parseModule(StringRef Source) {
+  auto Ctx = std::make_unique<LLVMContext>();
+  SMDiagnostic Err;
+  auto M = parseAssemblyString(Source, Err, *Ctx);
+  if (!M)
+    report_fatal_error(Twine(Err.getMessage()));
+  return ThreadSafeModule(std::move(M), std::move(Ctx));
+}
+
+Expected<std::unique_ptr<LLLazyJIT>> createTieredJIT(uint64_t Threshold) {
+  OrcNativeTarget::initialize();
+  return LLLazyJITBuilder().setTierUpThreshold(Threshold).create();
+}
+
+TEST(TieredCompilationTest, TiersUpAfterThreshold) {
+  auto J = createTieredJIT(3);
+  if (!J) {
+    // Bail out if the native target isn't available.
+    consumeError(J.takeError());
+    GTEST_SKIP();
+  }
+
+  JITDylib &Main = (*J)->getMainJITDylib();
+  ASSERT_THAT_ERROR((*J)->addLazyIRModule(parseModule(TestModule)),
+                    Succeeded());
+  auto FAddr = (*J)->lookup("f");
+  ASSERT_THAT_EXPECTED(FAddr, Succeeded());
+  auto *F = FAddr->toPtr<int32_t (*)()>();
+
+  auto &ES = (*J)->getExecutionSession();
+  std::string OptName = Main.getName() + ".opt";
+  for (int I = 0; I != 2; ++I)
+    EXPECT_EQ(F(), 42);
+  EXPECT_EQ(ES.getJITDylibByName(OptName), nullptr);
+
+  // The third call reaches the threshold and emits the optimized tier, which
+  // the later calls go to.
+  for (int I = 0; I != 3; ++I)
+    EXPECT_EQ(F(), 42);
+  EXPECT_NE(ES.getJITDylibByName(OptName), nullptr);
+}
+
+TEST(TieredCompilationTest, RemoveBeforeTierUp) {
+  auto J = createTieredJIT(1000);
+  if (!J) {
+    consumeError(J.takeError());
+    GTEST_SKIP();
+  }
+
+  JITDylib &Main = (*J)->getMainJITDylib();
+  auto RT = Main.createResourceTracker();
+  ASSERT_THAT_ERROR((*J)->getCompileOnDemandLayer().add(
+                        RT, parseModule(TestModule)),
+                    Succeeded());
+  auto FAddr = (*J)->lookup("f");
+  ASSERT_THAT_EXPECTED(FAddr, Succeeded());
+  EXPECT_EQ(FAddr->toPtr<int32_t (*)()>()(), 42);
+
+  // Removing the tracker frees the copy of the partition kept for the tier-up,
+  // and the module can be added again.
+  ASSERT_THAT_ERROR(RT->remove(), Succeeded());
+  ASSERT_THAT_ERROR((*J)->addLazyIRModule(parseModule(TestModule)),
+                    Succeeded());
+  FAddr = (*J)->lookup("f");
+  ASSERT_THAT_EXPECTED(FAddr, Succeeded());
+  EXPECT_EQ(FAddr->toPtr<int32_t (*)()>()(), 42);
+}
+
+TEST(TieredCompilationTest, RequiresInProcessJIT) {
+  auto EPC = SelfExecutorProcessControl::Create();
+  ASSERT_THAT_EXPECTED(EPC, Succeeded());
+
+  // The tier-up counters call back into the JIT's process, so custom
+  // executors are refused.
+  auto J = LLLazyJITBuilder()
+               .setExecutorProcessControl(std::move(*EPC))
+               .setTierUpThreshold(3)
+               .create();
+  EXPECT_THAT_EXPECTED(J, Failed());
+}
+
+} // end anonymous namespace
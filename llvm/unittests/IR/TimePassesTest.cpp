@@ -16,6 +16,7 @@
 #include <llvm/IR/PassInstrumentation.h>
 #include <llvm/IR/PassManager.h>
 #include <llvm/IR/PassTimingInfo.h>
+#include <llvm/Passes/StandardInstrumentations.h>
 #include <llvm/Support/raw_ostream.h>
 
 using namespace llvm;
@@ -171,4 +172,46 @@ TEST(TimePassesTest, CustomOut) {
   EXPECT_TRUE(TimePassesStr.str().contains("Pass2"));
 }
 
+TEST(TimePassesTest, SlowestPassRuns) {
+  PassInstrumentationCallbacks PIC;
+  PassInstrumentation PI(&PIC);
+
+  LLVMContext Context;
+  Module M("TestModule", Context);
+  Function *F = Function::Create(
+      FunctionType::get(Type::getVoidTy(Context), /*isVarArg=*/false),
+      GlobalValue::ExternalLinkage, "f", M);
+  MyPass1 Pass1;
+  MyPass2 Pass2;
+
+  SmallString<0> ReportStr;
+  raw_svector_ostream ReportStream(ReportStr);
+
+  // Only keep the two slowest of the three runs.
+  std::unique_ptr<SlowestPassRunsReporter> SlowestRuns =
+      std::make_unique<SlowestPassRunsReporter>(2);
+  SlowestRuns->setOutStream(ReportStream);
+  SlowestRuns->registerCallbacks(PIC);
+
+  PI.runBeforePass(Pass1, M);
+  PI.runAfterPass(Pass1, M, PreservedAnalyses::all());
+  PI.runBeforePass(Pass2, *F);
+  PI.runAfterPass(Pass2, *F, PreservedAnalyses::all());
+  PI.runBeforePass(Pass1, *F);
+  PI.runAfterPassInvalidated<Function>(Pass1, PreservedAnalyses::none());
+
+  SlowestRuns->print();
+  StringRef Report = ReportStr.str();
+  EXPECT_TRUE(Report.contains("Slowest pass runs"));
+  SmallVector<StringRef> Lines;
+  Report.trim().split(Lines, '\n');
+  // Three header lines, the column titles and two runs.
+  EXPECT_EQ(6u, Lines.size());
+
+  // Printing resets the runs.
+  ReportStr.clear();
+  SlowestRuns.reset();
+  EXPECT_TRUE(ReportStr.empty());
+}
+
 } // end anonymous namespace
@@ -7,6 +7,10 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/Object/Archive.h"
+#include "llvm/Object/ArchiveWriter.h"
+#include "llvm/ObjectYAML/yaml2obj.h"
+#include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/YAMLTraits.h"
 #include "llvm/Testing/Support/Error.h"
 #include "gtest/gtest.h"
 
@@ -91,3 +95,94 @@ TEST_F(ArchiveTestsFixture, ArchiveChildGetBuffer) {
   EXPECT_EQ(MemberSize, Buffer->size());
   EXPECT_EQ(ArchiveWithMember + sizeof(ArchiveWithMember) - 1, Buffer->data());
 }
+
+// Returns an ELF relocatable object defining the global symbols "func<N>" and
+// "data<N>".
+static std::string createObjectWithSymbols(unsigned N) {
+  std::string Yaml = formatv(R"(
+--- !ELF
+FileHeader:
+  Class:   ELFCLASS64
+  Data:    ELFDATA2LSB
+  Type:    ET_REL
+  Machine: EM_X86_64
+Sections:
+  - Name:  .text
+    Type:  SHT_PROGBITS
+    Flags: [ SHF_ALLOC, SHF_EXECINSTR ]
+    Size:  8
+Symbols:
+  - Name:    func{0}
+    Section: .text
+    Binding: STB_GLOBAL
+  - Name:    data{0}
+    Section: .text
+    Binding: STB_GLOBAL
+    Value:   4
+)",
+                             N);
+  std::string Storage;
+  raw_string_ostream OS(Storage);
+  yaml::Input YIn(Yaml);
+  EXPECT_TRUE(yaml::convertYAML(YIn, OS, [](const Twine &Msg) {}));
+  return OS.str();
+}
+
+TEST(ArchiveWriterTest, SymbolTableInMemberOrder) {
+  // The symbols of the members are read in parallel, they must still be
+  // listed in the order of the members, whatever members are in between.
+  const unsigned NumObjects = 64;
+  std::vector<std::string> Names;
+  std::vector<std::string> Contents;
+  for (unsigned I = 0; I < NumObjects; ++I) {
+    Names.push_back(formatv("m{0}.o", I));
+    Contents.push_back(createObjectWithSymbols(I));
+    if (I % 8 == 0) {
+      Names.push_back(formatv("m{0}.txt", I));
+      Contents.push_back("not an object\n");
+    }
+  }
+  std::vector<NewArchiveMember> Members;
+  for (auto [Name, Content] : zip(Names, Contents)) {
+    NewArchiveMember Member(MemoryBufferRef(Content, Name));
+    Members.push_back(std::move(Member));
+  }
+
+  Expected<std::unique_ptr<MemoryBuffer>> BufOrErr =
+      writeArchiveToBuffer(Members, /*WriteSymtab=*/true, Archive::K_GNU,
+                           /*Deterministic=*/true, /*Thin=*/false);
+  ASSERT_THAT_EXPECTED(BufOrErr, Succeeded());
+  Expected<std::unique_ptr<Archive>> AOrErr =
+      Archive::create((*BufOrErr)->getMemBufferRef());
+  ASSERT_THAT_EXPECTED(AOrErr, Succeeded());
+
+  unsigned Index = 0;
+  for (const Archive::Symbol &Sym : (*AOrErr)->symbols()) {
+    ASSERT_LT(Index, 2 * NumObjects);
+    unsigned Object = Index / 2;
+    EXPECT_EQ(Sym.getName(),
+              formatv(Index % 2 ? "data{0}" : "func{0}", Object).str());
+    Expected<Archive::Child> ChildOrErr = Sym.getMember();
+    ASSERT_THAT_EXPECTED(ChildOrErr, Succeeded());
+    Expected<StringRef> NameOrErr = ChildOrErr->getName();
+    ASSERT_THAT_EXPECTED(NameOrErr, Succeeded());
+    EXPECT_EQ(*NameOrErr, formatv("m{0}.o", Object).str());
+    ++Index;
+  }
+  EXPECT_EQ(Index, 2 * NumObjects);
+}
+
+TEST(ArchiveWriterTest, InvalidMemberReportsItsName) {
+  std::string Object = createObjectWithSymbols(0);
+  // An ELF header cut short, which is identified as ELF but fails to parse.
+  StringRef Invalid = StringRef(Object).take_front(32);
+  std::vector<NewArchiveMember> Members;
+  Members.emplace_back(MemoryBufferRef(Object, "good.o"));
+  Members.emplace_back(MemoryBufferRef(Invalid, "bad.o"));
+  Members.emplace_back(MemoryBufferRef(Object, "good2.o"));
+
+  Expected<std::unique_ptr<MemoryBuffer>> BufOrErr =
+      writeArchiveToBuffer(Members, /*WriteSymtab=*/true, Archive::K_GNU,
+                           /*Deterministic=*/true, /*Thin=*/false);
+  EXPECT_THAT_EXPECTED(BufOrErr, FailedWithMessage(HasSubstr("'bad.o'")));
+}
@@ -0,0 +1,150 @@
+//===- CachingTest.cpp ----------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/Caching.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Testing/Support/Error.h"
+#include "llvm/Testing/Support/SupportHelpers.h"
+#include "gtest/gtest.h"
+
+#include <mutex>
+
+using namespace llvm;
+using llvm::unittest::TempDir;
+
+namespace {
+
+class MemoryCacheStorage : public CacheStorage {
+public:
+  std::mutex Mu;
+  StringMap<std::string> Entries;
+  unsigned Gets = 0;
+
+  Expected<std::unique_ptr<MemoryBuffer>> get(StringRef Key) override {
+    std::lock_guard<std::mutex> L(Mu);
+    ++Gets;
+    auto It = Entries.find(Key);
+    if (It == Entries.end())
+      return nullptr;
+    return MemoryBuffer::getMemBufferCopy(It->second);
+  }
+
+  Error put(StringRef Key, StringRef Data) override {
+    std::lock_guard<std::mutex> L(Mu);
+    Entries[Key] = std::string(Data);
+    return Error::success();
+  }
+};
+
+struct AddedBuffers {
+  std::mutex Mu;
+  std::vector<std::string> Contents;
+
+  AddBufferFn getAddBuffer() {
+    return [this](unsigned Task, const Twine &ModuleName,
+                  std::unique_ptr<MemoryBuffer> MB) {
+      std::lock_guard<std::mutex> L(Mu);
+      Contents.push_back(std::string(MB->getBuffer()));
+    };
+  }
+};
+
+// Look up Key and, on a miss, produce Contents through the returned stream.
+// Returns true on a hit.
+static bool lookupOrProduce(FileCache &Cache, StringRef Key,
+                            StringRef Contents) {
+  Expected<AddStreamFn> AddStreamOrErr = Cache(0, Key, "module");
+  EXPECT_THAT_EXPECTED(AddStreamOrErr, Succeeded());
+  if (!*AddStreamOrErr)
+    return true;
+  Expected<std::unique_ptr<CachedFileStream>> StreamOrErr =
+      (*AddStreamOrErr)(0, "module");
+  EXPECT_THAT_EXPECTED(StreamOrErr, Succeeded());
+  *(*StreamOrErr)->OS << Contents;
+  return false;
+}
+
+TEST(SharedCacheTest, UploadAndReuse) {
+  auto Storage = std::make_unique<MemoryCacheStorage>();
+  MemoryCacheStorage *S = Storage.get();
+  TempDir Dir1("shared-cache-1", /*Unique=*/true);
+  TempDir Dir2("shared-cache-2", /*Unique=*/true);
+
+  // A miss everywhere: the produced file is added to the link, written to the
+  // local cache and uploaded.
+  AddedBuffers Added1;
+  {
+    FileCache Local = cantFail(localCache("Test", "Test", Dir1.path(),
+                                          Added1.getAddBuffer()));
+    SharedCache Shared(Local, std::move(Storage));
+    FileCache Cache = Shared.getFileCache();
+    EXPECT_FALSE(lookupOrProduce(Cache, "key", "contents"));
+    EXPECT_THAT_ERROR(Shared.wait(), Succeeded());
+    ASSERT_EQ(1u, Added1.Contents.size());
+    EXPECT_EQ("contents", Added1.Contents[0]);
+    EXPECT_EQ("contents", S->Entries.lookup("key"));
+
+    // A second lookup is a local hit and doesn't query the storage.
+    unsigned Gets = S->Gets;
+    EXPECT_TRUE(lookupOrProduce(Cache, "key", "unused"));
+    EXPECT_EQ(Gets, S->Gets);
+  }
+
+  // Another machine with an empty local cache gets the shared entry.
+  auto Storage2 = std::make_unique<MemoryCacheStorage>();
+  Storage2->Entries["key"] = "contents";
+  AddedBuffers Added2;
+  FileCache Local2 = cantFail(
+      localCache("Test", "Test", Dir2.path(), Added2.getAddBuffer()));
+  SharedCache Shared2(Local2, std::move(Storage2));
+  Shared2.prefetch("key");
+  FileCache Cache2 = Shared2.getFileCache();
+  EXPECT_TRUE(lookupOrProduce(Cache2, "key", "unused"));
+  ASSERT_EQ(1u, Added2.Contents.size());
+  EXPECT_EQ("contents", Added2.Contents[0]);
+
+  // The shared hit was copied into the local cache.
+  SmallString<128> EntryPath(Dir2.path());
+  sys::path::append(EntryPath, "llvmcache-key");
+  EXPECT_TRUE(sys::fs::exists(EntryPath));
+}
+
+TEST(SharedCacheTest, DirectoryStorage) {
+  TempDir Dir("shared-cache-storage", /*Unique=*/true);
+  std::unique_ptr<CacheStorage> Storage = directoryCacheStorage(Dir.path());
+
+  Expected<std::unique_ptr<MemoryBuffer>> Missing = Storage->get("key");
+  ASSERT_THAT_EXPECTED(Missing, Succeeded());
+  EXPECT_EQ(nullptr, *Missing);
+
+  EXPECT_THAT_ERROR(Storage->put("key", "contents"), Succeeded());
+  Expected<std::unique_ptr<MemoryBuffer>> Found = Storage->get("key");
+  ASSERT_THAT_EXPECTED(Found, Succeeded());
+  ASSERT_NE(nullptr, *Found);
+  EXPECT_EQ("contents", (*Found)->getBuffer());
+
+  // The entries get the same permissions as the other files, so that the
+  // directory can be shared between users.
+  SmallString<128> EntryPath(Dir.path()), OtherPath(Dir.path());
+  sys::path::append(EntryPath, "llvmcache-key");
+  sys::path::append(OtherPath, "other");
+  {
+    std::error_code EC;
+    raw_fd_ostream OS(OtherPath, EC);
+    ASSERT_FALSE(EC);
+  }
+  ErrorOr<sys::fs::perms> EntryPerms = sys::fs::getPermissions(EntryPath);
+  ErrorOr<sys::fs::perms> OtherPerms = sys::fs::getPermissions(OtherPath);
+  ASSERT_TRUE(EntryPerms && OtherPerms);
+  EXPECT_EQ(*OtherPerms, *EntryPerms);
+}
+
+} // namespace
@@ -155,6 +155,32 @@ TEST(FileOutputBuffer, Test) {
   ASSERT_EQ(File6Size, 0ULL);
   ASSERT_NO_ERROR(fs::remove(File6.str()));
 
+  // TEST 7: In-memory buffer written with multiple threads.
+  SmallString<128> File7(TestDirectory);
+  File7.append("/file7");
+  const size_t File7Size = 40 * 1024 * 1024 + 123;
+  {
+    Expected<std::unique_ptr<FileOutputBuffer>> BufferOrErr =
+        FileOutputBuffer::create(File7, File7Size,
+                                 FileOutputBuffer::F_no_mmap |
+                                     FileOutputBuffer::F_parallel_write);
+    ASSERT_NO_ERROR(errorToErrorCode(BufferOrErr.takeError()));
+    std::unique_ptr<FileOutputBuffer> &Buffer = *BufferOrErr;
+    for (size_t I = 0; I != File7Size; ++I)
+      Buffer->getBufferStart()[I] = uint8_t(I * 7);
+    ASSERT_NO_ERROR(errorToErrorCode(Buffer->commit()));
+  }
+  {
+    ErrorOr<std::unique_ptr<MemoryBuffer>> MBOrErr =
+        MemoryBuffer::getFile(File7);
+    ASSERT_NO_ERROR(MBOrErr.getError());
+    StringRef Contents = (*MBOrErr)->getBuffer();
+    ASSERT_EQ(Contents.size(), File7Size);
+    for (size_t I = 0; I != File7Size; ++I)
+      ASSERT_EQ(uint8_t(Contents[I]), uint8_t(I * 7));
+  }
+  ASSERT_NO_ERROR(fs::remove(File7.str()));
+
   // Clean up.
   ASSERT_NO_ERROR(fs::remove(TestDirectory.str()));
 }
@@ -14,7 +14,9 @@
 #include "llvm/Support/Parallel.h"
 #include "gtest/gtest.h"
 #include <array>
+#include <atomic>
 #include <random>
+#include <thread>
 
 uint32_t array[1024 * 1024];
 
@@ -92,4 +94,74 @@ TEST(Parallel, ForEachError) {
   EXPECT_EQ(errText, std::string("asdf\nasdf\nasdf"));
 }
 
+TEST(Parallel, NestedTaskGroup) {
+  std::atomic<unsigned> count{0};
+  parallel::TaskGroup outer;
+  for (unsigned i = 0; i < 16; ++i)
+    outer.spawn([&count] {
+      parallel::TaskGroup inner;
+      for (unsigned j = 0; j < 16; ++j)
+        inner.spawn([&count] { ++count; });
+      inner.sync();
+      ++count;
+    });
+  outer.sync();
+  EXPECT_EQ(count, 16U * 17U);
+}
+
+TEST(Parallel, NestedParallelFor) {
+  std::atomic<unsigned> count{0};
+  parallelFor(0, 64, [&count](size_t) {
+    parallelFor(0, 64, [&count](size_t) { ++count; });
+  });
+  EXPECT_EQ(count, 64U * 64U);
+}
+
+#if LLVM_ENABLE_THREADS
+TEST(Parallel, NestedTaskGroupRunsInParallel) {
+  if (parallel::getThreadCount() < 2)
+    GTEST_SKIP();
+  // The two inner tasks wait for each other, so the nested group must run
+  // them on two threads at once.
+  std::atomic<unsigned> arrived{0};
+  parallel::TaskGroup outer;
+  outer.spawn([&arrived] {
+    parallel::TaskGroup inner;
+    for (unsigned i = 0; i < 2; ++i)
+      inner.spawn([&arrived] {
+        ++arrived;
+        while (arrived < 2)
+          std::this_thread::yield();
+      });
+  });
+  outer.sync();
+  EXPECT_EQ(arrived, 2U);
+}
+
+static thread_local bool inNestedSync = false;
+
+TEST(Parallel, NestedTaskGroupRunsOnlyItsOwnTasks) {
+  // While a task waits for its nested group, its thread may only run the
+  // tasks of that group, and not the other tasks of the outer group.
+  std::atomic<unsigned> unrelatedInNestedSync{0};
+  parallel::TaskGroup outer;
+  for (unsigned i = 0; i < 64; ++i) {
+    outer.spawn([] {
+      parallel::TaskGroup inner;
+      for (unsigned j = 0; j < 16; ++j)
+        inner.spawn([] {});
+      inNestedSync = true;
+      inner.sync();
+      inNestedSync = false;
+    });
+    outer.spawn([&unrelatedInNestedSync] {
+      if (inNestedSync)
+        ++unrelatedInNestedSync;
+    });
+  }
+  outer.sync();
+  EXPECT_EQ(unrelatedInNestedSync, 0U);
+}
+#endif
+
 #endif
@@ -58,6 +58,25 @@ TEST(Threading, NumPhysicalCoresUnsupported) {
 }
 
 #if LLVM_ENABLE_THREADS
+TEST(Threading, CPUSocketInRange) {
+  // Many more threads than hardware threads, so that they would be spread
+  // over all CPU sockets if there is more than one.
+  ThreadPoolStrategy S = hardware_concurrency(1024);
+  S.PinToNUMANodes = true;
+  unsigned NumSockets = get_cpus();
+  ASSERT_GE(NumSockets, 1U);
+  for (unsigned I = 0; I < S.compute_thread_count(); ++I)
+    if (std::optional<unsigned> Socket = S.compute_cpu_socket(I))
+      EXPECT_LT(*Socket, NumSockets);
+}
+
+#if defined(__linux__)
+TEST(Threading, NoNUMAPinningByDefault) {
+  ThreadPoolStrategy S = hardware_concurrency(1024);
+  for (unsigned I = 0; I < S.compute_thread_count(); ++I)
+    EXPECT_EQ(S.compute_cpu_socket(I), std::nullopt);
+}
+#endif
 
 class Notification {
 public:
@@ -0,0 +1,105 @@
+#include "MCA/X86CustomBehaviour.h"
+#include "MCTargetDesc/X86MCTargetDesc.h"
+#include "Views/SummaryView.h"
+#include "X86TestBase.h"
+#include "llvm/MC/MCInstBuilder.h"
+#include "llvm/MCA/LoopMemoryDependences.h"
+#include "llvm/Support/JSON.h"
+
+using namespace llvm;
+using namespace mca;
+
+// movl LoadDisp(%rdi), %eax
+// addl $1, %eax
+// movl %eax, StoreDisp(%rdi)
+// addq $4, %rdi
+static void getStridedLoop(SmallVectorImpl<MCInst> &Insts, int64_t LoadDisp,
+                           int64_t StoreDisp) {
+  Insts.push_back(MCInstBuilder(X86::MOV32rm)
+                      .addReg(X86::EAX)
+                      .addReg(X86::RDI)
+                      .addImm(1)
+                      .addReg(0)
+                      .addImm(LoadDisp)
+                      .addReg(0));
+  Insts.push_back(MCInstBuilder(X86::ADD32ri)
+                      .addReg(X86::EAX)
+                      .addReg(X86::EAX)
+                      .addImm(1));
+  Insts.push_back(MCInstBuilder(X86::MOV32mr)
+                      .addReg(X86::RDI)
+                      .addImm(1)
+                      .addReg(0)
+                      .addImm(StoreDisp)
+                      .addReg(0)
+                      .addReg(X86::EAX));
+  Insts.push_back(MCInstBuilder(X86::ADD64ri8)
+                      .addReg(X86::RDI)
+                      .addReg(X86::RDI)
+                      .addImm(4));
+}
+
+TEST_F(X86TestBase, TestLoopCarriedStoreToLoad) {
+  X86InstrPostProcess IPP(*STI, *MCII);
+
+  // Every iteration loads the value stored by the previous one.
+  SmallVector<MCInst> Insts;
+  getStridedLoop(Insts, /*LoadDisp=*/0, /*StoreDisp=*/4);
+  LoopMemoryDependences MemDeps(Insts, IPP, *MCII, *MRI,
+                                /*AssumeNoAlias=*/true);
+  ArrayRef<LoopMemoryDependences::Dependence> Deps = MemDeps.getDependences(0);
+  ASSERT_EQ(Deps.size(), 1U);
+  EXPECT_EQ(Deps[0].StoreIndex, 2U);
+  EXPECT_EQ(Deps[0].Distance, 1U);
+
+  SmallVector<unsigned> Stores;
+  MemDeps.getStoreSourceIndices(/*SourceIndex=*/8, Stores);
+  ASSERT_EQ(Stores.size(), 1U);
+  EXPECT_EQ(Stores[0], 6U);
+
+  // The chain of loads and stores makes the loop slower than with the
+  // independent accesses assumed by -noalias.
+  json::Object NoAliasResult;
+  ASSERT_FALSE(bool(runBaselineMCA(NoAliasResult, Insts)));
+  auto PO = getDefaultPipelineOptions();
+  PO.MemoryDependences = &MemDeps;
+  json::Object Result;
+  ASSERT_FALSE(bool(runBaselineMCA(Result, Insts, std::nullopt, &PO)));
+
+  auto *NoAliasSummary = NoAliasResult.getObject("SummaryView");
+  auto *Summary = Result.getObject("SummaryView");
+  ASSERT_TRUE(NoAliasSummary && Summary);
+  auto NoAliasCycles = NoAliasSummary->getInteger("TotalCycles");
+  auto Cycles = Summary->getInteger("TotalCycles");
+  ASSERT_TRUE(NoAliasCycles && Cycles);
+  EXPECT_GT(*Cycles, *NoAliasCycles);
+}
+
+TEST_F(X86TestBase, TestLoopWithoutStoreToLoad) {
+  X86InstrPostProcess IPP(*STI, *MCII);
+
+  // Every iteration stores behind the addresses loaded by the next ones.
+  SmallVector<MCInst> Insts;
+  getStridedLoop(Insts, /*LoadDisp=*/0, /*StoreDisp=*/-4);
+  LoopMemoryDependences MemDeps(Insts, IPP, *MCII, *MRI,
+                                /*AssumeNoAlias=*/false);
+  EXPECT_TRUE(MemDeps.getDependences(0).empty());
+
+  // The same store and load without the increment of %rdi alias on every
+  // iteration if they overlap.
+  Insts.pop_back();
+  LoopMemoryDependences InvariantDeps(Insts, IPP, *MCII, *MRI,
+                                      /*AssumeNoAlias=*/true);
+  EXPECT_TRUE(InvariantDeps.getDependences(0).empty());
+
+  Insts.clear();
+  getStridedLoop(Insts, /*LoadDisp=*/0, /*StoreDisp=*/2);
+  Insts.pop_back();
+  LoopMemoryDependences OverlappingDeps(Insts, IPP, *MCII, *MRI,
+                                        /*AssumeNoAlias=*/true);
+  ArrayRef<LoopMemoryDependences::Dependence> Deps =
+      OverlappingDeps.getDependences(0);
+  ASSERT_EQ(Deps.size(), 1U);
+  EXPECT_EQ(Deps[0].StoreIndex, 2U);
+  EXPECT_EQ(Deps[0].Distance, 1U);
+}
@@ -0,0 +1,192 @@
+#!/usr/bin/env python3
+
+"""Compare TTI throughput costs against llvm-mca for a set of IR kernels.
+
+Each input .ll file may contain any number of functions. Every defined
+function is treated as one kernel: its TTI cost is the sum of the
+per-instruction throughput costs reported by opt's print<cost-model>, and its
+measured cost is the block reciprocal throughput llvm-mca reports for the
+function body produced by llc. Kernels whose measured/estimated ratio strays
+too far from the median ratio of the whole run are reported, which points at
+cost-table entries that are worth revisiting for the selected CPU.
+
+Keep kernels small and straight-line (ideally a single interesting vector
+instruction plus its operands); llvm-mca only models the body as a single
+basic block that is run in a loop.
+
+Example:
+
+  compare_cost_model_mca.py --bindir build/bin --mtriple x86_64-- \\
+      --mcpu znver4 kernels/*.ll
+"""
+
+import argparse
+import os
+import re
+import statistics
+import subprocess
+import sys
+
+COST_RE = re.compile(r"Cost Model: Found an estimated cost of (\d+|Invalid) for")
+COST_FUNC_RE = re.compile(r"Printing analysis 'Cost Model Analysis' for function '([^']+)'")
+RTHROUGHPUT_RE = re.compile(r"Block RThroughput:\s*([0-9.]+)")
+# llc emits '.Lfunc_end<N>:' (ELF) or 'Lfunc_end<N>:' (MachO) after each
+# function body.
+FUNC_END_RE = re.compile(r"^\.?Lfunc_end\d+:")
+
+
+def run(cmd, input=None):
+    result = subprocess.run(
+        cmd, input=input, stdout=subprocess.PIPE, stderr=subprocess.PIPE, text=True
+    )
+    if result.returncode != 0:
+        sys.exit("error: '%s' failed:\n%s" % (" ".join(cmd), result.stderr))
+    return result
+
+
+def tool(args, name):
+    return os.path.join(args.bindir, name) if args.bindir else name
+
+
+def target_flags(args):
+    flags = ["-mtriple=" + args.mtriple]
+    if args.mcpu:
+        flags.append("-mcpu=" + args.mcpu)
+    if args.mattr:
+        flags.append("-mattr=" + args.mattr)
+    return flags
+
+
+def get_tti_costs(args, path):
+    """Return a {function: summed throughput cost} map for one IR file."""
+    cmd = [
+        tool(args, "opt"),
+        "-passes=print<cost-model>",
+        "-cost-kind=throughput",
+        "-disable-output",
+        path,
+    ] + target_flags(args)
+    # The cost model printer writes to stderr.
+    output = run(cmd).stderr
+    costs = {}
+    func = None
+    for line in output.splitlines():
+        m = COST_FUNC_RE.search(line)
+        if m:
+            func = m.group(1)
+            costs[func] = 0
+            continue
+        m = COST_RE.search(line)
+        if not m or func is None or costs[func] is None:
+            continue
+        # A single invalid cost makes the whole kernel unusable.
+        costs[func] = None if m.group(1) == "Invalid" else costs[func] + int(m.group(1))
+    return costs
+
+
+def split_functions(asm, names):
+    """Split llc output into a {function: body} map."""
+    bodies = {}
+    func = None
+    lines = []
+    for line in asm.splitlines():
+        if func is None and line.endswith(":"):
+            label = line[:-1]
+            # MachO prefixes symbols with an underscore.
+            if label not in names and label.startswith("_"):
+                label = label[1:]
+            if label in names:
+                func = label
+                lines = []
+            continue
+        if func is not None:
+            if FUNC_END_RE.match(line):
+                bodies[func] = "\n".join(lines) + "\n"
+                func = None
+            else:
+                lines.append(line)
+    return bodies
+
+
+def get_mca_costs(args, path, names):
+    """Return a {function: block reciprocal throughput} map for one IR file."""
+    cmd = [tool(args, "llc"), "-O" + args.opt_level, "-o", "-", path]
+    asm = run(cmd + target_flags(args)).stdout
+    costs = {}
+    for func, body in split_functions(asm, names).items():
+        cmd = [tool(args, "llvm-mca"), "-iterations=" + str(args.iterations)]
+        output = run(cmd + target_flags(args), input=body).stdout
+        m = RTHROUGHPUT_RE.search(output)
+        if m:
+            costs[func] = float(m.group(1))
+    return costs
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter
+    )
+    parser.add_argument("inputs", nargs="+", help="IR files containing kernels")
+    parser.add_argument("--bindir", help="directory containing opt, llc and llvm-mca")
+    parser.add_argument("--mtriple", required=True, help="target triple")
+    parser.add_argument("--mcpu", help="target CPU, e.g. znver4")
+    parser.add_argument("--mattr", help="target features")
+    parser.add_argument("--opt-level", default="2", choices="0123", help="llc -O level")
+    parser.add_argument(
+        "--iterations", type=int, default=100, help="llvm-mca -iterations value"
+    )
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=2.0,
+        help="report kernels whose ratio differs from the median by this factor",
+    )
+    parser.add_argument(
+        "--all", action="store_true", help="print every kernel, not only outliers"
+    )
+    args = parser.parse_args()
+
+    rows = []
+    for path in args.inputs:
+        tti = get_tti_costs(args, path)
+        mca = get_mca_costs(args, path, set(tti))
+        for func in sorted(tti):
+            if tti[func] is None:
+                print("%s:%s: skipped, invalid TTI cost" % (path, func), file=sys.stderr)
+            elif func not in mca:
+                print("%s:%s: skipped, no llvm-mca result" % (path, func), file=sys.stderr)
+            elif tti[func] > 0:
+                rows.append((path, func, tti[func], mca[func], mca[func] / tti[func]))
+
+    if not rows:
+        sys.exit("error: no kernels could be compared")
+
+    # TTI costs are in abstract units, so compare every kernel against the
+    # run's median ratio rather than against 1.0.
+    median = statistics.median(row[4] for row in rows)
+    print("median llvm-mca RThroughput / TTI cost: %.3f\n" % median)
+    print("%-40s %8s %10s %10s %8s" % ("kernel", "TTI", "mca", "expected", "factor"))
+    outliers = 0
+    for path, func, cost, rthroughput, ratio in rows:
+        factor = ratio / median
+        is_outlier = factor >= args.threshold or factor <= 1.0 / args.threshold
+        outliers += is_outlier
+        if not (is_outlier or args.all):
+            continue
+        # 'expected' is the TTI cost that would put this kernel on the median.
+        print(
+            "%-40s %8d %10.2f %10.1f %7.2fx%s"
+            % (
+                os.path.basename(path) + ":" + func,
+                cost,
+                rthroughput,
+                rthroughput / median,
+                factor,
+                " <--" if is_outlier else "",
+            )
+        )
+    print("\n%d of %d kernels outside a %.1fx band" % (outliers, len(rows), args.threshold))
+
+
+if __name__ == "__main__":
+    main()
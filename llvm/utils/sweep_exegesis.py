@@ -0,0 +1,154 @@
+#!/usr/bin/env python3
+
+"""Measure every instruction of a target with llvm-exegesis, in parallel.
+
+The opcodes are split into one shard per CPU. Each shard is measured by its
+own llvm-exegesis process pinned to that CPU (--benchmark-process-cpu), so
+the shards run concurrently without being migrated between cores. The
+per-shard benchmark files are then merged, and analyzed against the
+scheduling model of the CPU: the result is a diff whose '-' lines are the
+values of the TableGen scheduling model and '+' lines the measured ones, for
+every sched class that does not match its measurements.
+
+Running one shard per physical core (not per hyperthread) keeps the
+measurements of the shards independent; pass the list of cores with --cpus.
+
+Example:
+
+  sweep_exegesis.py --bindir build/bin --mode latency --cpus 0,2,4,6 \\
+      --output-dir sweep-spr
+"""
+
+import argparse
+import os
+import subprocess
+import sys
+
+
+def tool(args, name):
+    return os.path.join(args.bindir, name) if args.bindir else name
+
+
+def parse_cpus(spec):
+    """Parse a CPU list such as '0-3,8,10-11'."""
+    cpus = []
+    for part in spec.split(","):
+        first, _, last = part.partition("-")
+        cpus.extend(range(int(first), int(last or first) + 1))
+    return cpus
+
+
+def target_flags(args):
+    flags = []
+    if args.mtriple:
+        flags.append("-mtriple=" + args.mtriple)
+    if args.mcpu:
+        flags.append("-mcpu=" + args.mcpu)
+    return flags
+
+
+def run_shards(args, cpus):
+    """Measure one shard of opcodes on each CPU, and return the result files."""
+    processes = []
+    for index, cpu in enumerate(cpus):
+        result = os.path.join(args.output_dir, "shard-%d.yaml" % index)
+        cmd = [
+            tool(args, "llvm-exegesis"),
+            "-mode=" + args.mode,
+            "-opcode-index=-1",
+            "-num-shards=%d" % len(cpus),
+            "-shard-index=%d" % index,
+            "-benchmark-process-cpu=%d" % cpu,
+            "-benchmarks-file=" + result,
+        ] + target_flags(args) + args.exegesis_args
+        log = open(os.path.join(args.output_dir, "shard-%d.log" % index), "w")
+        processes.append((subprocess.Popen(cmd, stdout=log, stderr=log), result))
+
+    results = []
+    for process, result in processes:
+        # A shard that failed may still have written some benchmarks; keep
+        # them along with the other shards.
+        if process.wait() != 0:
+            print(
+                "warning: shard writing '%s' exited with %d"
+                % (result, process.returncode),
+                file=sys.stderr,
+            )
+        if os.path.exists(result):
+            results.append(result)
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter
+    )
+    parser.add_argument("--bindir", help="directory containing llvm-exegesis")
+    parser.add_argument(
+        "--mode",
+        default="latency",
+        choices=["latency", "uops", "inverse_throughput"],
+        help="llvm-exegesis benchmark mode",
+    )
+    parser.add_argument(
+        "--cpus",
+        default="0-%d" % (os.cpu_count() - 1),
+        help="CPUs to run the shards on (default: all CPUs)",
+    )
+    parser.add_argument("--mtriple", help="target triple (default: host)")
+    parser.add_argument("--mcpu", help="target CPU (default: host)")
+    parser.add_argument(
+        "--output-dir", required=True, help="directory for the results"
+    )
+    parser.add_argument(
+        "--analysis-only",
+        action="store_true",
+        help="do not measure, only analyze the shards of a previous run",
+    )
+    parser.add_argument(
+        "exegesis_args",
+        nargs="*",
+        help="extra arguments for the benchmarking llvm-exegesis processes",
+    )
+    args = parser.parse_args()
+
+    cpus = parse_cpus(args.cpus)
+    os.makedirs(args.output_dir, exist_ok=True)
+    if args.analysis_only:
+        results = [
+            os.path.join(args.output_dir, name)
+            for name in sorted(os.listdir(args.output_dir))
+            if name.startswith("shard-") and name.endswith(".yaml")
+        ]
+    else:
+        results = run_shards(args, cpus)
+    if not results:
+        sys.exit("error: no benchmark results")
+
+    # Benchmark files are YAML streams, so the shards can simply be
+    # concatenated.
+    merged = os.path.join(args.output_dir, "benchmarks.yaml")
+    with open(merged, "w") as out:
+        for result in results:
+            with open(result) as f:
+                out.write(f.read())
+
+    diff = os.path.join(args.output_dir, "sched-model.diff")
+    cmd = [
+        tool(args, "llvm-exegesis"),
+        "-mode=analysis",
+        "-benchmarks-file=" + merged,
+        "-analysis-clusters-output-file="
+        + os.path.join(args.output_dir, "clusters.csv"),
+        "-analysis-inconsistencies-output-file="
+        + os.path.join(args.output_dir, "inconsistencies.html"),
+        "-analysis-sched-model-diff-output-file=" + diff,
+    ]
+    result = subprocess.run(cmd)
+    if result.returncode != 0:
+        sys.exit("error: '%s' failed" % " ".join(cmd))
+    print("sched model diff written to '%s'" % diff)
+
+
+if __name__ == "__main__":
+    main()
@@ -21,6 +21,7 @@
 #include <cassert>
 #include <cinttypes>
 #include <functional>
+#include <thread>
 #include <vector>
 
 namespace mlir {
@@ -195,11 +196,49 @@ public:
   void sort() {
     if (isSorted)
       return;
-    std::sort(elements.begin(), elements.end(), getElementLT());
+    const ElementLT<V> lt = getElementLT();
+    const uint64_t nnz = elements.size();
+    const uint64_t numChunks =
+        std::min<uint64_t>(std::max(std::thread::hardware_concurrency(), 1u),
+                           nnz / kMinParallelSortChunk);
+    if (numChunks <= 1) {
+      std::sort(elements.begin(), elements.end(), lt);
+      isSorted = true;
+      return;
+    }
+    // Sort equally sized chunks of the elements concurrently, and then merge
+    // adjacent sorted runs pairwise until a single run is left.
+    const auto begin = elements.begin();
+    std::vector<uint64_t> bounds(numChunks + 1);
+    for (uint64_t c = 0; c <= numChunks; ++c)
+      bounds[c] = nnz * c / numChunks;
+    std::vector<std::thread> threads;
+    for (uint64_t c = 0; c < numChunks; ++c)
+      threads.emplace_back([=]() {
+        std::sort(begin + bounds[c], begin + bounds[c + 1], lt);
+      });
+    for (std::thread &thread : threads)
+      thread.join();
+    for (uint64_t width = 1; width < numChunks; width *= 2) {
+      threads.clear();
+      for (uint64_t c = 0; c + width < numChunks; c += 2 * width) {
+        const uint64_t lo = bounds[c];
+        const uint64_t mid = bounds[c + width];
+        const uint64_t hi = bounds[std::min(c + 2 * width, numChunks)];
+        threads.emplace_back([=]() {
+          std::inplace_merge(begin + lo, begin + mid, begin + hi, lt);
+        });
+      }
+      for (std::thread &thread : threads)
+        thread.join();
+    }
     isSorted = true;
   }
 
 private:
+  /// The minimum number of elements sorted by each thread in `sort`.
+  static constexpr uint64_t kMinParallelSortChunk = 1 << 16;
+
   const std::vector<uint64_t> dimSizes; // per-dimension sizes
   std::vector<Element<V>> elements;     // all COO elements
   std::vector<uint64_t> indices;        // shared index pool
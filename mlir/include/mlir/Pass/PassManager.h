@@ -420,6 +420,20 @@ public:
   void
   enableStatistics(PassDisplayMode displayMode = PassDisplayMode::Pipeline);
 
+  //===--------------------------------------------------------------------===//
+  // Pass Trace Profiling
+
+  /// Add an instrumentation that records the wall time of every pass execution
+  /// along with the operation (and its symbol name, if any) it ran on, and the
+  /// number of operations nested within it before and after the pass. The
+  /// trace is written to `outputFile` using the Chrome trace event format,
+  /// which can be viewed with chrome://tracing or Perfetto, when the pass
+  /// manager is destroyed.
+  ///
+  /// Note: Counting the nested operations walks the IR before and after every
+  /// pass, so the recorded times are only meaningful relative to each other.
+  void enableTraceProfiling(StringRef outputFile);
+
 private:
   /// Dump the statistics of the passes within this pass manager.
   void dumpStatistics();
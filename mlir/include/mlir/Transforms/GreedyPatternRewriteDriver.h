@@ -76,6 +76,15 @@ public:
   ///   were on the worklist at the very beginning) enqueued. All other ops are
   ///   excluded.
   GreedyRewriteStrictness strictMode = GreedyRewriteStrictness::AnyOp;
+
+  /// When set, ops nested in the region that are isolated from above are
+  /// first simplified in parallel, each with its own driver, before the region
+  /// as a whole is simplified. This has no effect if multithreading is
+  /// disabled on the context, if `strictMode` is not `AnyOp`, or if
+  /// `maxNumRewrites` is limited.
+  ///
+  /// Note: Only applicable when simplifying entire regions.
+  bool parallelizeIsolatedOps = false;
 };
 
 //===----------------------------------------------------------------------===//
@@ -1416,6 +1416,10 @@ LogicalResult BytecodeReader::parseResourceSection(
 
 LogicalResult BytecodeReader::parseIRSection(ArrayRef<uint8_t> sectionData,
                                              Block *block) {
+  // FIXME: Every region is parsed eagerly. Materializing individual functions
+  // on demand requires the regions of IsolatedFromAbove operations to be
+  // emitted with their encoded size (so that they can be skipped and indexed
+  // by symbol), which needs a new bytecode version.
   EncodingReader reader(sectionData, fileLoc);
 
   // A stack of operation regions currently being read from the bytecode.
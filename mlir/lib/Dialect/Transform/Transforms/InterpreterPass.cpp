@@ -0,0 +1,47 @@
+//===- InterpreterPass.cpp - Transform dialect interpreter pass -----------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines a pass that applies a transform script to the operation it
+// is anchored on.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/Dialect/Transform/Transforms/Passes.h"
+
+#include "mlir/Dialect/Transform/IR/TransformInterfaces.h"
+#include "mlir/Dialect/Transform/Transforms/TransformInterpreterPassBase.h"
+
+namespace mlir {
+namespace transform {
+#define GEN_PASS_DEF_INTERPRETERPASS
+#include "mlir/Dialect/Transform/Transforms/Passes.h.inc"
+} // namespace transform
+} // namespace mlir
+
+using namespace mlir;
+
+namespace {
+class InterpreterPass
+    : public transform::TransformInterpreterPassBase<
+          InterpreterPass, transform::impl::InterpreterPassBase> {
+public:
+  InterpreterPass() = default;
+  InterpreterPass(const InterpreterPass &pass) = default;
+  InterpreterPass(const transform::InterpreterPassOptions &passOptions) {
+    transformFileName = passOptions.transformFileName;
+    debugPayloadRootTag = passOptions.debugPayloadRootTag;
+    debugTransformRootTag = passOptions.debugTransformRootTag;
+    enableExpensiveChecks = passOptions.enableExpensiveChecks;
+  }
+
+  LogicalResult runBeforeInterpreter(Operation *) {
+    options = options.enableExpensiveChecks(enableExpensiveChecks);
+    return success();
+  }
+};
+} // namespace
@@ -18,6 +18,7 @@
 #include <atomic>
 #include <cassert>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <iostream>
 #include <mutex>
@@ -25,7 +26,7 @@
 #include <vector>
 
 #include "llvm/ADT/StringMap.h"
-#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Threading.h"
 
 using namespace mlir::runtime;
 
@@ -40,6 +41,156 @@ namespace {
 // Forward declare class defined below.
 class RefCounted;
 
+// -------------------------------------------------------------------------- //
+// A work stealing scheduler for the async tasks. Each worker thread owns a task
+// queue: tasks spawned from a worker thread are pushed to its own queue, and
+// popped by it in LIFO order (the data of the spawning task is likely to still
+// be in the cache), while idle workers steal tasks from the other end of the
+// queues of other workers. Tasks spawned outside of the worker threads are
+// pushed to a shared queue.
+//
+// Compared to a general purpose thread pool, spawning a task does not create
+// a future or take a global lock, which makes fine grained async graphs much
+// cheaper to execute.
+// -------------------------------------------------------------------------- //
+
+class WorkStealingScheduler {
+public:
+  using Task = std::function<void()>;
+
+  explicit WorkStealingScheduler(unsigned numWorkers)
+      : numWorkers(numWorkers), numPending(0), numQueued(0), numSleeping(0) {
+    // The last queue is the shared queue for tasks spawned by non-workers.
+    for (unsigned i = 0; i <= numWorkers; ++i)
+      queues.push_back(std::make_unique<TaskQueue>());
+    for (unsigned i = 0; i < numWorkers; ++i)
+      workers.emplace_back([this, i]() { runWorker(i); });
+  }
+
+  ~WorkStealingScheduler() {
+    wait();
+    {
+      std::unique_lock<std::mutex> lock(mu);
+      stop = true;
+    }
+    workAvailable.notify_all();
+    for (std::thread &worker : workers)
+      worker.join();
+  }
+
+  unsigned getNumWorkers() const { return numWorkers; }
+
+  // Schedules `task` for execution on one of the worker threads.
+  void spawn(Task task) {
+    numPending.fetch_add(1);
+    unsigned index = currentScheduler == this ? currentWorker : numWorkers;
+    {
+      std::unique_lock<std::mutex> lock(queues[index]->mu);
+      queues[index]->tasks.push_back(std::move(task));
+    }
+    numQueued.fetch_add(1);
+
+    // Only pay for the wake up if there is a worker to wake up.
+    if (numSleeping.load() > 0) {
+      std::unique_lock<std::mutex> lock(mu);
+      workAvailable.notify_one();
+    }
+  }
+
+  // Blocks until all spawned tasks are completed. Must not be called from a
+  // worker thread.
+  void wait() {
+    assert(currentScheduler != this && "waiting from a worker thread");
+    std::unique_lock<std::mutex> lock(mu);
+    allTasksDone.wait(lock, [this] { return numPending.load() == 0; });
+  }
+
+private:
+  struct TaskQueue {
+    std::mutex mu;
+    std::deque<Task> tasks;
+  };
+
+  void runWorker(unsigned index) {
+    currentScheduler = this;
+    currentWorker = index;
+
+    while (true) {
+      Task task;
+      if (tryPop(index, task)) {
+        task();
+        task = nullptr;
+        if (numPending.fetch_sub(1) == 1) {
+          std::unique_lock<std::mutex> lock(mu);
+          allTasksDone.notify_all();
+        }
+        continue;
+      }
+
+      std::unique_lock<std::mutex> lock(mu);
+      numSleeping.fetch_add(1);
+      workAvailable.wait(lock,
+                         [this] { return stop || numQueued.load() > 0; });
+      numSleeping.fetch_sub(1);
+      if (stop && numQueued.load() == 0)
+        return;
+    }
+  }
+
+  // Pops a task from the back of the worker's own queue, or steals one from
+  // the front of the shared queue or of the queue of another worker.
+  bool tryPop(unsigned index, Task &task) {
+    auto tryTake = [&](unsigned queueIndex, bool fromBack) {
+      TaskQueue &queue = *queues[queueIndex];
+      std::unique_lock<std::mutex> lock(queue.mu);
+      if (queue.tasks.empty())
+        return false;
+      if (fromBack) {
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+      } else {
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+      }
+      numQueued.fetch_sub(1);
+      return true;
+    };
+
+    if (tryTake(index, /*fromBack=*/true) ||
+        tryTake(numWorkers, /*fromBack=*/false))
+      return true;
+    for (unsigned i = 1; i < numWorkers; ++i)
+      if (tryTake((index + i) % numWorkers, /*fromBack=*/false))
+        return true;
+    return false;
+  }
+
+  // The scheduler and the worker index of the current thread, if it is a
+  // worker thread.
+  static thread_local WorkStealingScheduler *currentScheduler;
+  static thread_local unsigned currentWorker;
+
+  unsigned numWorkers;
+  std::vector<std::unique_ptr<TaskQueue>> queues;
+  std::vector<std::thread> workers;
+
+  // The number of spawned tasks that are not completed yet.
+  std::atomic<int64_t> numPending;
+  // The number of tasks that are waiting in one of the queues.
+  std::atomic<int64_t> numQueued;
+  // The number of workers waiting for `workAvailable`.
+  std::atomic<int64_t> numSleeping;
+
+  // Guards `stop` and the condition variables below.
+  std::mutex mu;
+  std::condition_variable workAvailable;
+  std::condition_variable allTasksDone;
+  bool stop = false;
+};
+
+thread_local WorkStealingScheduler *WorkStealingScheduler::currentScheduler;
+thread_local unsigned WorkStealingScheduler::currentWorker;
+
 // -------------------------------------------------------------------------- //
 // AsyncRuntime orchestrates all async operations and Async runtime API is built
 // on top of the default runtime instance.
@@ -47,10 +198,12 @@ class RefCounted;
 
 class AsyncRuntime {
 public:
-  AsyncRuntime() : numRefCountedObjects(0) {}
+  AsyncRuntime()
+      : numRefCountedObjects(0),
+        scheduler(llvm::hardware_concurrency().compute_thread_count()) {}
 
   ~AsyncRuntime() {
-    threadPool.wait(); // wait for the completion of all async tasks
+    scheduler.wait(); // wait for the completion of all async tasks
     assert(getNumRefCountedObjects() == 0 &&
            "all ref counted objects must be destroyed");
   }
@@ -59,7 +212,7 @@ public:
     return numRefCountedObjects.load(std::memory_order_relaxed);
   }
 
-  llvm::ThreadPool &getThreadPool() { return threadPool; }
+  WorkStealingScheduler &getScheduler() { return scheduler; }
 
 private:
   friend class RefCounted;
@@ -74,7 +227,7 @@ private:
   }
 
   std::atomic<int64_t> numRefCountedObjects;
-  llvm::ThreadPool threadPool;
+  WorkStealingScheduler scheduler;
 };
 
 // -------------------------------------------------------------------------- //
@@ -396,7 +549,7 @@ extern "C" ValueStorage mlirAsyncRuntimeGetValueStorage(AsyncValue *value) {
 
 extern "C" void mlirAsyncRuntimeExecute(CoroHandle handle, CoroResume resume) {
   auto *runtime = getDefaultAsyncRuntime();
-  runtime->getThreadPool().async([handle, resume]() { (*resume)(handle); });
+  runtime->getScheduler().spawn([handle, resume]() { (*resume)(handle); });
 }
 
 extern "C" void mlirAsyncRuntimeAwaitTokenAndExecute(AsyncToken *token,
@@ -439,7 +592,7 @@ extern "C" void mlirAsyncRuntimeAwaitAllInGroupAndExecute(AsyncGroup *group,
 }
 
 extern "C" int64_t mlirAsyncRuntimGetNumWorkerThreads() {
-  return getDefaultAsyncRuntime()->getThreadPool().getThreadCount();
+  return getDefaultAsyncRuntime()->getScheduler().getNumWorkers();
 }
 
 //===----------------------------------------------------------------------===//
@@ -16,6 +16,9 @@
 
 #include <stdio.h>
 
+#include <mutex>
+#include <vector>
+
 #include "cuda.h"
 
 #ifdef _WIN32
@@ -61,6 +64,72 @@ public:
   ~ScopedContext() { CUDA_REPORT_IF_ERROR(cuCtxPopCurrent(nullptr)); }
 };
 
+static CUresult destroyObject(CUstream stream) {
+  return cuStreamDestroy(stream);
+}
+
+static CUresult destroyObject(CUevent event) { return cuEventDestroy(event); }
+
+// A pool of CUDA objects (streams or events) that are handed out again once
+// released instead of being destroyed. The lowering of the gpu dialect creates
+// and destroys a stream, and an event per async dependency, around every
+// launch, and the driver calls to do so are a significant part of the launch
+// overhead of small kernels.
+template <typename T>
+class ObjectPool {
+public:
+  // Objects released beyond this limit are destroyed. It is well above the
+  // number of streams and events that are usually live at the same time.
+  static constexpr size_t kMaxPooledObjects = 64;
+
+  ~ObjectPool() {
+    // This runs at exit, possibly after the driver was shut down, in which
+    // case the objects are gone already and the errors can be ignored.
+    for (T object : objects)
+      (void)destroyObject(object);
+  }
+
+  // Returns a pooled object, or null if the pool is empty.
+  T acquire() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (objects.empty())
+      return nullptr;
+    T object = objects.back();
+    objects.pop_back();
+    return object;
+  }
+
+  void release(T object) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (objects.size() < kMaxPooledObjects) {
+        objects.push_back(object);
+        return;
+      }
+    }
+    CUDA_REPORT_IF_ERROR(destroyObject(object));
+  }
+
+private:
+  std::mutex mutex;
+  std::vector<T> objects;
+};
+
+static ObjectPool<CUstream> &getStreamPool() {
+  static ObjectPool<CUstream> pool;
+  return pool;
+}
+
+static ObjectPool<CUevent> &getEventPool() {
+  static ObjectPool<CUevent> pool;
+  return pool;
+}
+
+// FIXME: Modules are loaded and unloaded around every launch. Caching them
+// would remove most of the remaining launch overhead, but the image size isn't
+// passed to `mgpuModuleLoad`, so a cache could only be keyed by the address of
+// the image, which may be reused by a different image once a JIT-compiled
+// module is freed.
 extern "C" MLIR_CUDA_WRAPPERS_EXPORT CUmodule mgpuModuleLoad(void *data) {
   ScopedContext scopedContext;
   CUmodule module = nullptr;
@@ -94,14 +163,19 @@ mgpuLaunchKernel(CUfunction function, intptr_t gridX, intptr_t gridY,
 }
 
 extern "C" MLIR_CUDA_WRAPPERS_EXPORT CUstream mgpuStreamCreate() {
+  if (CUstream stream = getStreamPool().acquire())
+    return stream;
   ScopedContext scopedContext;
   CUstream stream = nullptr;
   CUDA_REPORT_IF_ERROR(cuStreamCreate(&stream, CU_STREAM_NON_BLOCKING));
   return stream;
 }
 
+// Streams are returned to the pool rather than destroyed. Work that is still
+// pending on a released stream is ordered before the work of its next user,
+// which is harmless as the previous user no longer waits on it.
 extern "C" MLIR_CUDA_WRAPPERS_EXPORT void mgpuStreamDestroy(CUstream stream) {
-  CUDA_REPORT_IF_ERROR(cuStreamDestroy(stream));
+  getStreamPool().release(stream);
 }
 
 extern "C" MLIR_CUDA_WRAPPERS_EXPORT void
@@ -115,14 +189,19 @@ extern "C" MLIR_CUDA_WRAPPERS_EXPORT void mgpuStreamWaitEvent(CUstream stream,
 }
 
 extern "C" MLIR_CUDA_WRAPPERS_EXPORT CUevent mgpuEventCreate() {
+  if (CUevent event = getEventPool().acquire())
+    return event;
   ScopedContext scopedContext;
   CUevent event = nullptr;
   CUDA_REPORT_IF_ERROR(cuEventCreate(&event, CU_EVENT_DISABLE_TIMING));
   return event;
 }
 
+// Events are returned to the pool rather than destroyed. Waits that were
+// already enqueued on a released event refer to its last recorded state, so
+// re-recording it for a new user does not affect them.
 extern "C" MLIR_CUDA_WRAPPERS_EXPORT void mgpuEventDestroy(CUevent event) {
-  CUDA_REPORT_IF_ERROR(cuEventDestroy(event));
+  getEventPool().release(event);
 }
 
 extern MLIR_CUDA_WRAPPERS_EXPORT "C" void mgpuEventSynchronize(CUevent event) {
@@ -134,15 +213,88 @@ extern MLIR_CUDA_WRAPPERS_EXPORT "C" void mgpuEventRecord(CUevent event,
   CUDA_REPORT_IF_ERROR(cuEventRecord(event, stream));
 }
 
-extern "C" void *mgpuMemAlloc(uint64_t sizeBytes, CUstream /*stream*/) {
+#if CUDA_VERSION >= 11030
+// Returns true if the default device supports stream ordered allocations from
+// memory pools.
+static bool hasMemoryPools() {
+  static bool hasPools = [] {
+    ScopedContext scopedContext;
+    CUdevice device;
+    int supported = 0;
+    CUDA_REPORT_IF_ERROR(cuCtxGetDevice(&device));
+    CUDA_REPORT_IF_ERROR(cuDeviceGetAttribute(
+        &supported, CU_DEVICE_ATTRIBUTE_MEMORY_POOLS_SUPPORTED, device));
+    return supported != 0;
+  }();
+  return hasPools;
+}
+#endif
+
+#if CUDA_VERSION >= 11030
+// Stream on which the stream ordered allocations are made. The allocation
+// stream is synchronized before the memory is returned, which makes it valid
+// on every stream, and as nothing else runs on this stream, doing so only
+// waits for the allocation itself.
+class AllocationStream {
+public:
+  AllocationStream() {
+    ScopedContext scopedContext;
+    CUDA_REPORT_IF_ERROR(cuStreamCreate(&stream, CU_STREAM_NON_BLOCKING));
+  }
+  // See ~ObjectPool.
+  ~AllocationStream() { (void)cuStreamDestroy(stream); }
+
+  CUstream get() const { return stream; }
+
+private:
+  CUstream stream = nullptr;
+};
+
+static CUstream getAllocationStream() {
+  static AllocationStream stream;
+  return stream.get();
+}
+#endif
+
+// Allocations on a stream come from the device's memory pool if the device
+// supports it, which lets the driver reuse memory freed with `mgpuMemFree`
+// instead of allocating it again.
+extern "C" void *mgpuMemAlloc(uint64_t sizeBytes, CUstream stream) {
   ScopedContext scopedContext;
   CUdeviceptr ptr;
+#if CUDA_VERSION >= 11030
+  if (stream && hasMemoryPools()) {
+    // The memory may be used on other streams than `stream`, which would need
+    // to be synchronized with it. Allocate it on the allocation stream
+    // instead, and wait for the allocation, so that it can be used anywhere.
+    CUstream allocationStream = getAllocationStream();
+    CUDA_REPORT_IF_ERROR(cuMemAllocAsync(&ptr, sizeBytes, allocationStream));
+    CUDA_REPORT_IF_ERROR(cuStreamSynchronize(allocationStream));
+    return reinterpret_cast<void *>(ptr);
+  }
+#endif
   CUDA_REPORT_IF_ERROR(cuMemAlloc(&ptr, sizeBytes));
   return reinterpret_cast<void *>(ptr);
 }
 
-extern "C" void mgpuMemFree(void *ptr, CUstream /*stream*/) {
-  CUDA_REPORT_IF_ERROR(cuMemFree(reinterpret_cast<CUdeviceptr>(ptr)));
+extern "C" void mgpuMemFree(void *ptr, CUstream stream) {
+  CUdeviceptr devicePtr = reinterpret_cast<CUdeviceptr>(ptr);
+#if CUDA_VERSION >= 11030
+  // Only memory that was allocated from a pool can be freed stream ordered.
+  // The async dependencies of the deallocation are ordered before `stream`,
+  // so the memory is no longer used when `stream` reaches the free.
+  if (stream && hasMemoryPools()) {
+    ScopedContext scopedContext;
+    CUmemoryPool pool = nullptr;
+    if (cuPointerGetAttribute(&pool, CU_POINTER_ATTRIBUTE_MEMPOOL_HANDLE,
+                              devicePtr) == CUDA_SUCCESS &&
+        pool) {
+      CUDA_REPORT_IF_ERROR(cuMemFreeAsync(devicePtr, stream));
+      return;
+    }
+  }
+#endif
+  CUDA_REPORT_IF_ERROR(cuMemFree(devicePtr));
 }
 
 extern "C" void mgpuMemcpy(void *dst, void *src, size_t sizeBytes,
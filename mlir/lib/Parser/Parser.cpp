@@ -61,7 +61,21 @@ static LogicalResult loadSourceFileBuffer(llvm::StringRef filename,
     return emitError(mlir::UnknownLoc::get(ctx),
                      "only main buffer parsed at the moment");
   }
-  auto fileOrErr = llvm::MemoryBuffer::getFileOrSTDIN(filename);
+  // Bytecode doesn't need a null terminator, and requiring one may prevent the
+  // file from being memory mapped. Mapping the file is what allows resource
+  // blobs (e.g. large weights) to reference the input buffer directly instead
+  // of being copied, so try that first and only re-open the file with a null
+  // terminator if it turns out to be textual IR.
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> fileOrErr =
+      std::make_error_code(std::errc::no_such_file_or_directory);
+  if (filename != "-") {
+    fileOrErr = llvm::MemoryBuffer::getFile(filename, /*IsText=*/false,
+                                            /*RequiresNullTerminator=*/false);
+    if (fileOrErr && !isBytecode(**fileOrErr))
+      fileOrErr = std::make_error_code(std::errc::no_such_file_or_directory);
+  }
+  if (!fileOrErr)
+    fileOrErr = llvm::MemoryBuffer::getFileOrSTDIN(filename);
   if (std::error_code error = fileOrErr.getError())
     return emitError(mlir::UnknownLoc::get(ctx),
                      "could not open input file " + filename);
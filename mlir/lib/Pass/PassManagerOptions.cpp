@@ -78,6 +78,14 @@ struct PassManagerOptions {
               "display the results in a merged list sorted by pass name"),
           clEnumValN(PassDisplayMode::Pipeline, "pipeline",
                      "display the results with a nested pipeline view"))};
+
+  //===--------------------------------------------------------------------===//
+  // Pass Trace Profiling
+  //===--------------------------------------------------------------------===//
+  llvm::cl::opt<std::string> passTraceFile{
+      "mlir-pass-trace-file",
+      llvm::cl::desc("Write a Chrome trace of the pass executions, per nested "
+                     "operation, to the given file")};
 };
 } // namespace
 
@@ -145,6 +153,10 @@ void mlir::applyPassManagerCLOptions(PassManager &pm) {
 
   // Add the IR printing instrumentation.
   options->addPrinterInstrumentation(pm);
+
+  // Record a trace of the pass executions.
+  if (!options->passTraceFile.empty())
+    pm.enableTraceProfiling(options->passTraceFile);
 }
 
 void mlir::applyDefaultTimingPassManagerCLOptions(PassManager &pm) {
@@ -0,0 +1,187 @@
+//===- PassTraceProfiling.cpp ---------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "PassDetail.h"
+#include "mlir/IR/SymbolTable.h"
+#include "mlir/Pass/PassManager.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/Threading.h"
+#include "llvm/Support/ToolOutputFile.h"
+#include <chrono>
+#include <mutex>
+
+using namespace mlir;
+using namespace mlir::detail;
+
+namespace {
+//===----------------------------------------------------------------------===//
+// PassTraceProfiler
+//===----------------------------------------------------------------------===//
+
+using Clock = std::chrono::steady_clock;
+
+/// A single execution of a pass on an operation.
+struct PassTraceEvent {
+  std::string passName;
+  std::string opName;
+  std::string symbolName;
+  Clock::time_point start;
+  Clock::duration duration;
+  uint64_t threadId;
+  int64_t numOpsBefore;
+  int64_t numOpsAfter;
+  bool failed;
+};
+
+/// An instrumentation that records the wall time and the change in the number
+/// of nested operations of every pass execution, keyed by the operation (and
+/// its symbol name, if any) the pass ran on. The events are written to a file
+/// in the Chrome trace event format when the instrumentation is destroyed.
+class PassTraceProfilerInstrumentation : public PassInstrumentation {
+public:
+  PassTraceProfilerInstrumentation(StringRef outputFile)
+      : outputFile(outputFile), startTime(Clock::now()) {}
+  ~PassTraceProfilerInstrumentation() override { writeTrace(); }
+
+private:
+  /// Instrumentation hooks.
+  void runBeforePass(Pass *pass, Operation *op) override;
+  void runAfterPass(Pass *pass, Operation *op) override {
+    finishEvent(op, /*failed=*/false);
+  }
+  void runAfterPassFailed(Pass *pass, Operation *op) override {
+    finishEvent(op, /*failed=*/true);
+  }
+
+  /// Complete the innermost event of the current thread.
+  void finishEvent(Operation *op, bool failed);
+
+  /// Write the recorded events to the output file.
+  void writeTrace();
+
+  /// Return the number of operations nested within `op`, including `op`.
+  static int64_t getNumOps(Operation *op) {
+    int64_t numOps = 0;
+    op->walk([&](Operation *) { ++numOps; });
+    return numOps;
+  }
+
+  /// The file to write the trace to.
+  std::string outputFile;
+
+  /// The time the instrumentation was created at, which is used as the origin
+  /// of the trace.
+  Clock::time_point startTime;
+
+  /// Guards the fields below.
+  std::mutex mutex;
+
+  /// The events that are in progress, grouped by thread. Passes nest, so the
+  /// innermost event of a thread is always the next one to finish.
+  DenseMap<uint64_t, SmallVector<PassTraceEvent, 4>> activeEvents;
+
+  /// The completed events.
+  std::vector<PassTraceEvent> events;
+};
+} // namespace
+
+void PassTraceProfilerInstrumentation::runBeforePass(Pass *pass,
+                                                     Operation *op) {
+  PassTraceEvent event;
+  if (auto *adaptor = dyn_cast<OpToOpPassAdaptor>(pass))
+    event.passName = adaptor->getAdaptorName();
+  else
+    event.passName = pass->getName().str();
+  event.opName = op->getName().getStringRef().str();
+  if (auto symbolName =
+          op->getAttrOfType<StringAttr>(SymbolTable::getSymbolAttrName()))
+    event.symbolName = symbolName.str();
+  event.threadId = llvm::get_threadid();
+  event.numOpsBefore = getNumOps(op);
+  event.numOpsAfter = 0;
+  event.failed = false;
+  event.duration = Clock::duration::zero();
+
+  // Start the clock last to keep the bookkeeping out of the measurement.
+  std::lock_guard<std::mutex> lock(mutex);
+  event.start = Clock::now();
+  activeEvents[event.threadId].push_back(std::move(event));
+}
+
+void PassTraceProfilerInstrumentation::finishEvent(Operation *op,
+                                                   bool failed) {
+  Clock::time_point end = Clock::now();
+  int64_t numOpsAfter = getNumOps(op);
+
+  std::lock_guard<std::mutex> lock(mutex);
+  SmallVector<PassTraceEvent, 4> &threadEvents =
+      activeEvents[llvm::get_threadid()];
+  assert(!threadEvents.empty() && "finishing a pass that wasn't started");
+  PassTraceEvent event = threadEvents.pop_back_val();
+  event.duration = end - event.start;
+  event.numOpsAfter = numOpsAfter;
+  event.failed = failed;
+  events.push_back(std::move(event));
+}
+
+void PassTraceProfilerInstrumentation::writeTrace() {
+  std::error_code ec;
+  llvm::ToolOutputFile out(outputFile, ec, llvm::sys::fs::OF_TextWithCRLF);
+  if (ec) {
+    llvm::errs() << "error: could not open pass trace file '" << outputFile
+                 << "': " << ec.message() << "\n";
+    return;
+  }
+
+  auto toMicroseconds = [](Clock::duration duration) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(duration)
+        .count();
+  };
+  int64_t pid = llvm::sys::Process::getProcessId();
+
+  llvm::json::OStream json(out.os());
+  json.object([&] {
+    json.attributeArray("traceEvents", [&] {
+      for (const PassTraceEvent &event : events) {
+        json.object([&] {
+          json.attribute("pid", pid);
+          json.attribute("tid", int64_t(event.threadId));
+          json.attribute("ph", "X");
+          json.attribute("name", event.passName);
+          json.attribute("cat", "pass");
+          json.attribute("ts", toMicroseconds(event.start - startTime));
+          json.attribute("dur", toMicroseconds(event.duration));
+          json.attributeObject("args", [&] {
+            json.attribute("op", event.opName);
+            if (!event.symbolName.empty())
+              json.attribute("symbol", event.symbolName);
+            json.attribute("ops-before", event.numOpsBefore);
+            json.attribute("ops-after", event.numOpsAfter);
+            json.attribute("ops-delta",
+                           event.numOpsAfter - event.numOpsBefore);
+            if (event.failed)
+              json.attribute("failed", true);
+          });
+        });
+      }
+    });
+    json.attribute("displayTimeUnit", "ms");
+  });
+  out.keep();
+}
+
+//===----------------------------------------------------------------------===//
+// PassManager
+//===----------------------------------------------------------------------===//
+
+/// Add an instrumentation to record a trace of the pass executions.
+void PassManager::enableTraceProfiling(StringRef outputFile) {
+  addInstrumentation(
+      std::make_unique<PassTraceProfilerInstrumentation>(outputFile));
+}
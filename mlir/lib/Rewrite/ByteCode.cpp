@@ -1051,6 +1051,17 @@ PDLByteCode::PDLByteCode(
                       maxLoopLevel, constraintFns, rewriteFns, configMap);
   generator.generate(module);
 
+  // Collect the root kinds of the patterns, which allows us to skip the
+  // matcher entirely for operations that can't match any pattern.
+  for (const PDLByteCodePattern &pattern : patterns) {
+    std::optional<OperationName> rootKind = pattern.getRootKind();
+    if (!rootKind) {
+      rootKinds.clear();
+      break;
+    }
+    rootKinds.insert(*rootKind);
+  }
+
   // Initialize the external functions.
   for (auto &it : constraintFns)
     constraintFunctions.push_back(std::move(it.second));
@@ -2266,6 +2277,10 @@ ByteCodeExecutor::execute(PatternRewriter &rewriter,
 void PDLByteCode::match(Operation *op, PatternRewriter &rewriter,
                         SmallVectorImpl<MatchResult> &matches,
                         PDLByteCodeMutableState &state) const {
+  // Avoid executing the matcher if no pattern can be rooted at this operation.
+  if (!rootKinds.empty() && !rootKinds.contains(op->getName()))
+    return;
+
   // The first memory slot is always the root operation.
   state.memory[0] = op;
 
@@ -205,6 +205,11 @@ private:
   /// The set of patterns contained within the bytecode.
   SmallVector<PDLByteCodePattern, 32> patterns;
 
+  /// The root operation kinds of the patterns. This is used to skip running
+  /// the matcher on operations that no pattern may be rooted at, and is only
+  /// populated if every pattern has a specific root kind.
+  DenseSet<OperationName> rootKinds;
+
   /// A set of user defined functions invoked via PDL.
   std::vector<PDLConstraintFunction> constraintFunctions;
   std::vector<PDLRewriteFunction> rewriteFunctions;
@@ -11,11 +11,30 @@
 #include "mlir/Support/LLVM.h"
 #include "mlir/Support/ThreadLocalCache.h"
 #include "mlir/Support/TypeID.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/Support/MathExtras.h"
 #include "llvm/Support/RWMutex.h"
+#include "llvm/Support/Threading.h"
+
+#define DEBUG_TYPE "mlir-storage-uniquer"
 
 using namespace mlir;
 using namespace mlir::detail;
 
+STATISTIC(NumLocalCacheMisses,
+          "Number of parametric storage lookups missing the local cache");
+STATISTIC(NumWriterLocks, "Number of parametric storage writer lock acquires");
+
+/// Count an event of the parametric storage lookups. The statistics are shared
+/// by all of the threads, so they are only updated when they are requested, to
+/// keep the lookups from contending on them.
+static void countEvent(llvm::Statistic &stat) {
+#if LLVM_ENABLE_STATS
+  if (llvm::AreStatisticsEnabled())
+    ++stat;
+#endif
+}
+
 namespace {
 /// This class represents a uniquer for storage instances of a specific type
 /// that has parametric storage. It contains all of the necessary data to unique
@@ -117,7 +136,7 @@ public:
   /// use. The provided shard number is required to be a valid power of 2. The
   /// destructor function is used to destroy any allocated storage instances.
   ParametricStorageUniquer(function_ref<void(BaseStorage *)> destructorFn,
-                           size_t numShards = 8)
+                           size_t numShards = getDefaultNumShards())
       : shards(new std::atomic<Shard *>[numShards]), numShards(numShards),
         destructorFn(destructorFn) {
     assert(llvm::isPowerOf2_64(numShards) &&
@@ -151,6 +170,7 @@ public:
       return localInst;
 
     // Check for an existing instance in read-only mode.
+    countEvent(NumLocalCacheMisses);
     {
       llvm::sys::SmartScopedReader<true> typeLock(shard.mutex);
       auto it = shard.instances.find_as(lookupKey);
@@ -160,6 +180,7 @@ public:
 
     // Acquire a writer-lock so that we can safely create the new storage
     // instance.
+    countEvent(NumWriterLocks);
     llvm::sys::SmartScopedWriter<true> typeLock(shard.mutex);
     return localInst = getOrCreateUnsafe(shard, lookupKey, ctorFn);
   }
@@ -172,10 +193,22 @@ public:
     if (!threadingIsEnabled)
       return mutationFn(shard.allocator);
 
+    countEvent(NumWriterLocks);
     llvm::sys::SmartScopedWriter<true> lock(shard.mutex);
     return mutationFn(shard.allocator);
   }
 
+  /// Return the default number of shards to use for a uniquer. Even readers
+  /// write to the cache line of the shard mutex, so the number of shards is
+  /// scaled with the number of threads that may access the uniquer.
+  static size_t getDefaultNumShards() {
+    static const size_t numShards = [] {
+      unsigned numThreads = llvm::hardware_concurrency().compute_thread_count();
+      return std::clamp<size_t>(llvm::PowerOf2Ceil(numThreads), 8, 64);
+    }();
+    return numShards;
+  }
+
 private:
   /// Return the shard used for the given hash value.
   Shard &getShard(unsigned hashValue) {
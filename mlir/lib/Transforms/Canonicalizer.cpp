@@ -34,6 +34,7 @@ struct Canonicalizer : public impl::CanonicalizerBase<Canonicalizer> {
     this->enableRegionSimplification = config.enableRegionSimplification;
     this->maxIterations = config.maxIterations;
     this->maxNumRewrites = config.maxNumRewrites;
+    this->parallelizeIsolatedOps = config.parallelizeIsolatedOps;
     this->disabledPatterns = disabledPatterns;
     this->enabledPatterns = enabledPatterns;
   }
@@ -57,6 +58,7 @@ struct Canonicalizer : public impl::CanonicalizerBase<Canonicalizer> {
     config.enableRegionSimplification = enableRegionSimplification;
     config.maxIterations = maxIterations;
     config.maxNumRewrites = maxNumRewrites;
+    config.parallelizeIsolatedOps = parallelizeIsolatedOps;
     LogicalResult converged =
         applyPatternsAndFoldGreedily(getOperation(), patterns, config);
     // Canonicalization is best-effort. Non-convergence is not a pass failure.
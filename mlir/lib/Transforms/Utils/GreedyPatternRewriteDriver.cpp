@@ -12,6 +12,7 @@
 
 #include "mlir/Transforms/GreedyPatternRewriteDriver.h"
 #include "mlir/IR/Matchers.h"
+#include "mlir/IR/Threading.h"
 #include "mlir/Interfaces/SideEffectInterfaces.h"
 #include "mlir/Rewrite/PatternApplicator.h"
 #include "mlir/Transforms/FoldUtils.h"
@@ -480,14 +481,48 @@ mlir::applyPatternsAndFoldGreedily(Region &region,
   assert(region.getParentOp()->hasTrait<OpTrait::IsIsolatedFromAbove>() &&
          "patterns can only be applied to operations IsolatedFromAbove");
 
+  // Simplify the nested isolated ops in parallel first. Patterns applied to
+  // ops inside of them can't touch anything outside, so this is safe for the
+  // same reason the pass manager can run op passes on them in parallel. The
+  // region driver below still visits them, but normally finds nothing left
+  // to do.
+  MLIRContext *ctx = region.getContext();
+  bool nestedConverged = true;
+  if (config.parallelizeIsolatedOps && ctx->isMultithreadingEnabled() &&
+      config.strictMode == GreedyRewriteStrictness::AnyOp &&
+      config.maxNumRewrites == GreedyRewriteConfig::kNoLimit) {
+    SmallVector<Operation *> isolatedOps;
+    region.walk<WalkOrder::PreOrder>([&](Operation *op) {
+      if (!op->hasTrait<OpTrait::IsIsolatedFromAbove>())
+        return WalkResult::advance();
+      if (op->getNumRegions())
+        isolatedOps.push_back(op);
+      return WalkResult::skip();
+    });
+
+    if (isolatedOps.size() > 1) {
+      // The nested drivers only notify themselves. Any state of the config
+      // that is called back during the rewrite would have to be excluded
+      // here, as it would be called from several threads.
+      GreedyRewriteConfig nestedConfig = config;
+      nestedConfig.scope = nullptr;
+      std::atomic<bool> anyFailed(false);
+      parallelForEach(ctx, isolatedOps, [&](Operation *op) {
+        if (failed(applyPatternsAndFoldGreedily(op, patterns, nestedConfig)))
+          anyFailed = true;
+      });
+      nestedConverged = !anyFailed;
+    }
+  }
+
   // Set scope if not specified.
   if (!config.scope)
     config.scope = &region;
 
   // Start the pattern driver.
-  RegionPatternRewriteDriver driver(region.getContext(), patterns, config,
-                                    region);
-  LogicalResult converged = std::move(driver).simplify();
+  RegionPatternRewriteDriver driver(ctx, patterns, config, region);
+  LogicalResult converged = success(
+      succeeded(std::move(driver).simplify()) && nestedConverged);
   LLVM_DEBUG(if (failed(converged)) {
     llvm::dbgs() << "The pattern rewrite did not converge after scanning "
                  << config.maxIterations << " times\n";
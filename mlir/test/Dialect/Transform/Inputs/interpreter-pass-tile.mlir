@@ -0,0 +1,7 @@
+transform.sequence failures(propagate) {
+^bb0(%arg0: !transform.any_op):
+  %0 = transform.structured.match ops{["linalg.matmul"]} in %arg0
+    : (!transform.any_op) -> !transform.any_op
+  %1, %loops:2 = transform.structured.tile %0 [4, 8]
+    : (!transform.any_op) -> (!transform.any_op, !transform.any_op, !transform.any_op)
+}
@@ -0,0 +1,14 @@
+// RUN: mlir-opt %s --transform-interpreter=transform-file-name=%p/Inputs/interpreter-pass-tile.mlir | FileCheck %s
+// RUN: mlir-opt %s --pass-pipeline="builtin.module(transform-interpreter{transform-file-name=%p/Inputs/interpreter-pass-tile.mlir enable-expensive-checks},canonicalize)" | FileCheck %s
+
+// CHECK-LABEL: func.func @matmul
+// CHECK:         scf.for
+// CHECK:           scf.for
+// CHECK:             linalg.matmul ins(%{{.*}}, %{{.*}} : tensor<4x16xf32>, tensor<16x8xf32>) outs(%{{.*}} : tensor<4x8xf32>)
+// CHECK-NOT:   transform.
+func.func @matmul(%A: tensor<16x16xf32>, %B: tensor<16x16xf32>,
+                  %C: tensor<16x16xf32>) -> tensor<16x16xf32> {
+  %0 = linalg.matmul ins(%A, %B : tensor<16x16xf32>, tensor<16x16xf32>)
+                     outs(%C : tensor<16x16xf32>) -> tensor<16x16xf32>
+  return %0 : tensor<16x16xf32>
+}
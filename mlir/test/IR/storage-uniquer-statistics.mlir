@@ -0,0 +1,20 @@
+// REQUIRES: asserts
+// RUN: mlir-opt %s -stats 2>&1 | FileCheck %s
+// RUN: mlir-opt %s -mlir-disable-threading -stats 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=NOTHREADS
+
+// Lookups of parametric storage which miss the thread-local cache, and the
+// writer locks taken to create new instances, are counted when the context is
+// multithreaded.
+
+// CHECK: {{[1-9][0-9]*}} mlir-storage-uniquer {{ *}}- Number of parametric storage lookups missing the local cache
+// CHECK: {{[1-9][0-9]*}} mlir-storage-uniquer {{ *}}- Number of parametric storage writer lock acquires
+
+// Single-threaded lookups never take the locks.
+
+// NOTHREADS-NOT: mlir-storage-uniquer
+
+func.func @f(%arg0: tensor<4xf32>, %arg1: memref<?x8xi64>) -> vector<2x3xf16> {
+  %0 = arith.constant dense<1.0> : vector<2x3xf16>
+  return %0 : vector<2x3xf16>
+}
@@ -0,0 +1,54 @@
+// RUN: mlir-opt -test-ir-visitors -allow-unregistered-dialect %s | FileCheck %s
+
+// The walkers look at the next operation of a block before visiting the
+// current one. Check that operations are still visited in order, including
+// when the callbacks erase the operation being visited.
+
+"test.a"() ({
+  "test.b"() : () -> ()
+  "test.c"() ({
+    "test.d"() : () -> ()
+  }) : () -> ()
+  "test.e"() : () -> ()
+}) : () -> ()
+"test.f"() : () -> ()
+
+// CHECK-LABEL: Op pre-order visits
+// CHECK-NEXT:    Visiting op 'builtin.module'
+// CHECK-NEXT:    Visiting op 'test.a'
+// CHECK-NEXT:    Visiting op 'test.b'
+// CHECK-NEXT:    Visiting op 'test.c'
+// CHECK-NEXT:    Visiting op 'test.d'
+// CHECK-NEXT:    Visiting op 'test.e'
+// CHECK-NEXT:    Visiting op 'test.f'
+
+// CHECK-LABEL: Op post-order visits
+// CHECK-NEXT:    Visiting op 'test.b'
+// CHECK-NEXT:    Visiting op 'test.d'
+// CHECK-NEXT:    Visiting op 'test.c'
+// CHECK-NEXT:    Visiting op 'test.e'
+// CHECK-NEXT:    Visiting op 'test.a'
+// CHECK-NEXT:    Visiting op 'test.f'
+// CHECK-NEXT:    Visiting op 'builtin.module'
+
+// CHECK-LABEL: Op pre-order erasures (skip)
+// CHECK-NEXT:    Erasing op 'test.b'
+// CHECK-NEXT:    Erasing op 'test.c'
+// CHECK-NEXT:    Erasing op 'test.e'
+// CHECK-NEXT:    Block pre-order erasures (skip)
+
+// CHECK-LABEL: Op post-order erasures (skip)
+// CHECK-NEXT:    Erasing op 'test.b'
+// CHECK-NEXT:    Erasing op 'test.d'
+// CHECK-NEXT:    Erasing op 'test.c'
+// CHECK-NEXT:    Erasing op 'test.e'
+// CHECK-NEXT:    Block post-order erasures (skip)
+
+// CHECK-LABEL: Op post-order erasures (no skip)
+// CHECK-NEXT:    Erasing op 'test.b'
+// CHECK-NEXT:    Erasing op 'test.d'
+// CHECK-NEXT:    Erasing op 'test.c'
+// CHECK-NEXT:    Erasing op 'test.e'
+// CHECK-NEXT:    Erasing op 'test.a'
+// CHECK-NEXT:    Erasing op 'test.f'
+// CHECK-NEXT:    Erasing op 'builtin.module'
@@ -0,0 +1,53 @@
+// RUN: mlir-opt %s \
+// RUN: | mlir-opt -gpu-kernel-outlining \
+// RUN: | mlir-opt -pass-pipeline='builtin.module(gpu.module(strip-debuginfo,convert-gpu-to-nvvm,gpu-to-cubin))' \
+// RUN: | mlir-opt -convert-scf-to-cf -gpu-to-llvm \
+// RUN: | mlir-cpu-runner \
+// RUN:   --shared-libs=%mlir_cuda_runtime \
+// RUN:   --shared-libs=%mlir_runner_utils \
+// RUN:   --entry-point-result=void \
+// RUN: | FileCheck %s
+
+// Every iteration creates and destroys a stream and the events of its async
+// dependencies, which the runtime hands out again from its pools, and
+// allocates and frees device memory on that stream. The increments of all the
+// iterations must be visible in the result.
+
+// CHECK: [10, 11, 12, 13]
+func.func @main() {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c4 = arith.constant 4 : index
+  %c10 = arith.constant 10 : index
+  %one = arith.constant 1 : i32
+
+  %h = memref.alloc() : memref<4xi32>
+  %cast = memref.cast %h : memref<4xi32> to memref<*xi32>
+  gpu.host_register %cast : memref<*xi32>
+  scf.for %i = %c0 to %c4 step %c1 {
+    %v = arith.index_cast %i : index to i32
+    memref.store %v, %h[%i] : memref<4xi32>
+  }
+
+  scf.for %iter = %c0 to %c10 step %c1 {
+    %t0 = gpu.wait async
+    %d, %t1 = gpu.alloc async [%t0] () : memref<4xi32>
+    %t2 = gpu.memcpy async [%t1] %d, %h : memref<4xi32>, memref<4xi32>
+    %t3 = gpu.launch async [%t2]
+        blocks(%bx, %by, %bz) in (%grid_x = %c1, %grid_y = %c1, %grid_z = %c1)
+        threads(%tx, %ty, %tz) in (%block_x = %c4, %block_y = %c1, %block_z = %c1) {
+      %x = memref.load %d[%tx] : memref<4xi32>
+      %y = arith.addi %x, %one : i32
+      memref.store %y, %d[%tx] : memref<4xi32>
+      gpu.terminator
+    }
+    %t4 = gpu.memcpy async [%t3] %h, %d : memref<4xi32>, memref<4xi32>
+    %t5 = gpu.dealloc async [%t4] %d : memref<4xi32>
+    gpu.wait [%t5]
+  }
+
+  call @printMemrefI32(%cast) : (memref<*xi32>) -> ()
+  return
+}
+
+func.func private @printMemrefI32(memref<*xi32>)
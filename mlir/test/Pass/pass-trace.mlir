@@ -0,0 +1,28 @@
+// RUN: mlir-opt %s -mlir-disable-threading -mlir-pass-trace-file=%t.json \
+// RUN:   -pass-pipeline='builtin.module(func.func(canonicalize,cse))' -o /dev/null
+// RUN: FileCheck %s --input-file=%t.json
+
+// Each pass execution is recorded, with the operation it ran on and the
+// number of operations nested in it. The events are written in the order the
+// passes finished, so the nested passes of each function come before the
+// adaptor that ran them.
+
+// CHECK: {"traceEvents":[
+// CHECK-SAME: {"pid":{{[0-9]+}},"tid":{{[0-9]+}},"ph":"X","name":"Canonicalizer","cat":"pass","ts":{{[0-9]+}},"dur":{{[0-9]+}},"args":{"op":"func.func","symbol":"fold","ops-before":6,"ops-after":4,"ops-delta":-2}},
+// CHECK-SAME: {"pid":{{[0-9]+}},"tid":{{[0-9]+}},"ph":"X","name":"CSE","cat":"pass","ts":{{[0-9]+}},"dur":{{[0-9]+}},"args":{"op":"func.func","symbol":"fold","ops-before":4,"ops-after":4,"ops-delta":0}},
+// CHECK-SAME: {"pid":{{[0-9]+}},"tid":{{[0-9]+}},"ph":"X","name":"Canonicalizer","cat":"pass","ts":{{[0-9]+}},"dur":{{[0-9]+}},"args":{"op":"func.func","symbol":"empty","ops-before":2,"ops-after":2,"ops-delta":0}},
+// CHECK-SAME: {"pid":{{[0-9]+}},"tid":{{[0-9]+}},"ph":"X","name":"CSE","cat":"pass","ts":{{[0-9]+}},"dur":{{[0-9]+}},"args":{"op":"func.func","symbol":"empty","ops-before":2,"ops-after":2,"ops-delta":0}},
+// CHECK-SAME: {"pid":{{[0-9]+}},"tid":{{[0-9]+}},"ph":"X","name":"Pipeline Collection : ['func.func']","cat":"pass","ts":{{[0-9]+}},"dur":{{[0-9]+}},"args":{"op":"builtin.module","ops-before":9,"ops-after":7,"ops-delta":-2}}
+// CHECK-SAME: ],"displayTimeUnit":"ms"}
+
+func.func @fold(%arg0: i32) -> i32 {
+  %c1 = arith.constant 1 : i32
+  %c2 = arith.constant 2 : i32
+  %0 = arith.addi %c1, %c2 : i32
+  %1 = arith.addi %arg0, %0 : i32
+  return %1 : i32
+}
+
+func.func @empty() {
+  return
+}
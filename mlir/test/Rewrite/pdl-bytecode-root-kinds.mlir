@@ -0,0 +1,73 @@
+// RUN: mlir-opt %s -test-pdl-bytecode-pass -split-input-file | FileCheck %s
+
+// Check that the matcher is only skipped for operations that no pattern may
+// be rooted at.
+
+//===----------------------------------------------------------------------===//
+// All patterns have a root kind
+//===----------------------------------------------------------------------===//
+
+module @patterns {
+  pdl_interp.func @matcher(%root : !pdl.operation) {
+    pdl_interp.check_operation_name of %root is "test.op" -> ^pat, ^end
+
+  ^pat:
+    pdl_interp.record_match @rewriters::@success(%root : !pdl.operation) : benefit(1), loc([%root]), root("test.op") -> ^end
+
+  ^end:
+    pdl_interp.finalize
+  }
+
+  module @rewriters {
+    pdl_interp.func @success(%root : !pdl.operation) {
+      %op = pdl_interp.create_operation "test.success"
+      pdl_interp.erase %root
+      pdl_interp.finalize
+    }
+  }
+}
+
+// CHECK-LABEL: test.all_rooted
+// CHECK-NEXT: "test.success"
+// CHECK-NEXT: "test.other"
+module @ir attributes { test.all_rooted } {
+  "test.op"() : () -> ()
+  "test.other"() : () -> ()
+}
+
+// -----
+
+//===----------------------------------------------------------------------===//
+// A pattern without a root kind
+//===----------------------------------------------------------------------===//
+
+module @patterns {
+  pdl_interp.func @matcher(%root : !pdl.operation) {
+    pdl_interp.switch_operation_name of %root to ["test.op", "test.other"](^op, ^other) -> ^end
+
+  ^op:
+    pdl_interp.record_match @rewriters::@success(%root : !pdl.operation) : benefit(1), loc([%root]), root("test.op") -> ^end
+
+  ^other:
+    pdl_interp.record_match @rewriters::@success(%root : !pdl.operation) : benefit(1), loc([%root]) -> ^end
+
+  ^end:
+    pdl_interp.finalize
+  }
+
+  module @rewriters {
+    pdl_interp.func @success(%root : !pdl.operation) {
+      %op = pdl_interp.create_operation "test.success"
+      pdl_interp.erase %root
+      pdl_interp.finalize
+    }
+  }
+}
+
+// CHECK-LABEL: test.some_unrooted
+// CHECK-NEXT: "test.success"
+// CHECK-NEXT: "test.success"
+module @ir attributes { test.some_unrooted } {
+  "test.op"() : () -> ()
+  "test.other"() : () -> ()
+}
@@ -0,0 +1,64 @@
+// RUN: mlir-opt %s -allow-unregistered-dialect \
+// RUN:   -pass-pipeline='builtin.module(canonicalize{parallelize-isolated-ops=true})' \
+// RUN:   | FileCheck %s
+// RUN: mlir-opt %s -allow-unregistered-dialect --mlir-disable-threading \
+// RUN:   -pass-pipeline='builtin.module(canonicalize{parallelize-isolated-ops=true})' \
+// RUN:   | FileCheck %s
+
+// The functions, including the ones of the nested module, are isolated from
+// above and are simplified in parallel before the module itself.
+
+// CHECK-LABEL: func @add_zero
+//  CHECK-NEXT:   return %arg0
+func.func @add_zero(%arg0: i32) -> i32 {
+  %c0 = arith.constant 0 : i32
+  %0 = arith.addi %arg0, %c0 : i32
+  return %0 : i32
+}
+
+// CHECK-LABEL: func @mul_one
+//  CHECK-NEXT:   return %arg0
+func.func @mul_one(%arg0: i32) -> i32 {
+  %c1 = arith.constant 1 : i32
+  %0 = arith.muli %arg0, %c1 : i32
+  return %0 : i32
+}
+
+// CHECK-LABEL: func @fold_constants
+//  CHECK-NEXT:   %[[C:.*]] = arith.constant 5 : i32
+//  CHECK-NEXT:   return %[[C]]
+func.func @fold_constants() -> i32 {
+  %c2 = arith.constant 2 : i32
+  %c3 = arith.constant 3 : i32
+  %0 = arith.addi %c2, %c3 : i32
+  return %0 : i32
+}
+
+// CHECK-LABEL: module @nested
+module @nested {
+  // CHECK-LABEL: func @sub_self
+  //  CHECK-NEXT:   %[[C:.*]] = arith.constant 0 : i32
+  //  CHECK-NEXT:   return %[[C]]
+  func.func @sub_self(%arg0: i32) -> i32 {
+    %0 = arith.subi %arg0, %arg0 : i32
+    return %0 : i32
+  }
+
+  // CHECK-LABEL: func @dead_op
+  //  CHECK-NEXT:   "test.sink"(%arg0)
+  //  CHECK-NEXT:   return
+  func.func @dead_op(%arg0: i32) {
+    %c0 = arith.constant 0 : i32
+    %0 = arith.addi %arg0, %c0 : i32
+    "test.sink"(%0) : (i32) -> ()
+    return
+  }
+}
+
+// The ops of the module itself are simplified afterwards.
+// CHECK: "test.sink"(%[[C:.*]]) : (i32) -> ()
+// CHECK-NOT: arith.addi
+%c4 = arith.constant 4 : i32
+%c0 = arith.constant 0 : i32
+%sum = arith.addi %c4, %c0 : i32
+"test.sink"(%sum) : (i32) -> ()
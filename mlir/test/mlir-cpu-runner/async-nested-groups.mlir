@@ -0,0 +1,77 @@
+// RUN:   mlir-opt %s -pass-pipeline="builtin.module(async-to-async-runtime,func.func(async-runtime-ref-counting,async-runtime-ref-counting-opt),convert-async-to-llvm,func.func(convert-scf-to-cf),convert-arith-to-llvm,finalize-memref-to-llvm,convert-cf-to-llvm,convert-func-to-llvm,reconcile-unrealized-casts)" \
+// RUN: | mlir-cpu-runner                                                      \
+// RUN:     -e main -entry-point-result=void -O0                               \
+// RUN:     -shared-libs=%mlir_lib_dir/libmlir_c_runner_utils%shlibext         \
+// RUN:     -shared-libs=%mlir_lib_dir/libmlir_async_runtime%shlibext          \
+// RUN: | FileCheck %s
+
+// Tasks spawned from the main thread go to the shared queue of the async
+// runtime, and the tasks they spawn go to the queues of the worker threads,
+// from which idle workers steal them. Every one of the nested tasks must run
+// exactly once before the groups are ready.
+
+func.func private @printI64(i64)
+func.func private @printNewline()
+
+func.func @main() {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c64 = arith.constant 64 : index
+  %c0_i64 = arith.constant 0 : i64
+  %c1_i64 = arith.constant 1 : i64
+
+  %A = memref.alloc() : memref<64x64xi64>
+  scf.for %i = %c0 to %c64 step %c1 {
+    scf.for %j = %c0 to %c64 step %c1 {
+      memref.store %c0_i64, %A[%i, %j] : memref<64x64xi64>
+    }
+  }
+
+  %outer = async.create_group %c64 : !async.group
+  scf.for %i = %c0 to %c64 step %c1 {
+    %token = async.execute {
+      %inner = async.create_group %c64 : !async.group
+      scf.for %j = %c0 to %c64 step %c1 {
+        %t = async.execute {
+          %v = memref.load %A[%i, %j] : memref<64x64xi64>
+          %inc = arith.addi %v, %c1_i64 : i64
+          memref.store %inc, %A[%i, %j] : memref<64x64xi64>
+          async.yield
+        }
+        %0 = async.add_to_group %t, %inner : !async.token
+      }
+      async.await_all %inner
+      async.yield
+    }
+    %1 = async.add_to_group %token, %outer : !async.token
+  }
+  async.await_all %outer
+
+  // CHECK: 4096
+  %sum = scf.for %i = %c0 to %c64 step %c1 iter_args(%s0 = %c0_i64) -> (i64) {
+    %row = scf.for %j = %c0 to %c64 step %c1 iter_args(%s1 = %s0) -> (i64) {
+      %v = memref.load %A[%i, %j] : memref<64x64xi64>
+      %s2 = arith.addi %s1, %v : i64
+      scf.yield %s2 : i64
+    }
+    scf.yield %row : i64
+  }
+  call @printI64(%sum) : (i64) -> ()
+  call @printNewline() : () -> ()
+
+  // Together with the sum, this checks that every task ran exactly once.
+  // CHECK-NEXT: 1
+  %max = scf.for %i = %c0 to %c64 step %c1 iter_args(%m0 = %c0_i64) -> (i64) {
+    %row = scf.for %j = %c0 to %c64 step %c1 iter_args(%m1 = %m0) -> (i64) {
+      %v = memref.load %A[%i, %j] : memref<64x64xi64>
+      %m2 = arith.maxui %m1, %v : i64
+      scf.yield %m2 : i64
+    }
+    scf.yield %row : i64
+  }
+  call @printI64(%max) : (i64) -> ()
+  call @printNewline() : () -> ()
+
+  memref.dealloc %A : memref<64x64xi64>
+  return
+}
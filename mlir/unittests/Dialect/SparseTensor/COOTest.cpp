@@ -0,0 +1,53 @@
+//===- COOTest.cpp - SparseTensorCOO unit tests ---------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/ExecutionEngine/SparseTensor/COO.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <vector>
+
+using namespace mlir::sparse_tensor;
+
+namespace {
+
+/// Adds `nnz` distinct elements to a `rows` x `cols` COO tensor in a scrambled
+/// order, with each value encoding the indices it was added with, sorts the
+/// tensor, and checks that the elements are sorted and still paired with
+/// their values.
+void testSort(uint64_t rows, uint64_t cols, uint64_t nnz) {
+  ASSERT_LE(nnz, rows * cols);
+  SparseTensorCOO<uint64_t> coo({rows, cols}, nnz);
+  // Stepping by a prime coprime with the number of positions visits each of
+  // the first `nnz` positions of the permutation exactly once.
+  const uint64_t size = rows * cols;
+  const uint64_t step = 1000003;
+  ASSERT_NE(size % step, 0u);
+  for (uint64_t k = 0, pos = 0; k < nnz; ++k, pos = (pos + step) % size)
+    coo.add({pos / cols, pos % cols}, pos);
+
+  coo.sort();
+
+  const std::vector<Element<uint64_t>> &elements = coo.getElements();
+  ASSERT_EQ(elements.size(), nnz);
+  EXPECT_TRUE(
+      std::is_sorted(elements.begin(), elements.end(), coo.getElementLT()));
+  for (uint64_t i = 0; i < nnz; ++i) {
+    const Element<uint64_t> &e = elements[i];
+    EXPECT_EQ(e.value, e.indices[0] * cols + e.indices[1]);
+    if (i > 0)
+      EXPECT_TRUE(coo.getElementLT()(elements[i - 1], e));
+  }
+}
+
+TEST(SparseTensorCOO, SortSmall) { testSort(100, 100, 5000); }
+
+// Large enough to be sorted in chunks on several threads, with a number of
+// elements that doesn't divide evenly into chunks.
+TEST(SparseTensorCOO, SortLarge) { testSort(1000, 1000, 600011); }
+
+} // namespace
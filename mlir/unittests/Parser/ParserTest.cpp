@@ -7,8 +7,14 @@
 //===----------------------------------------------------------------------===//
 
 #include "mlir/Parser/Parser.h"
+#include "mlir/Bytecode/BytecodeWriter.h"
+#include "mlir/IR/BuiltinAttributes.h"
 #include "mlir/IR/BuiltinOps.h"
 #include "mlir/IR/Verifier.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/FileUtilities.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/raw_ostream.h"
 
 #include "gmock/gmock.h"
 
@@ -55,4 +61,89 @@ TEST(MLIRParser, ParseAtEnd) {
   EXPECT_EQ(block.front().getName().getStringRef(), "test.first");
   EXPECT_EQ(block.back().getName().getStringRef(), "test.second");
 }
+
+/// Write `contents` to a new temporary file, returning its path in `path`.
+static void writeTemporaryFile(StringRef contents,
+                               SmallVectorImpl<char> &path) {
+  int fd;
+  ASSERT_FALSE(llvm::sys::fs::createTemporaryFile("parser-test", "mlir", fd,
+                                                  path));
+  llvm::raw_fd_ostream os(fd, /*shouldClose=*/true);
+  os << contents;
+}
+
+TEST(MLIRParser, ParseTextualFile) {
+  SmallString<128> path;
+  writeTemporaryFile(R"mlir("test.first"() : () -> ())mlir", path);
+  llvm::FileRemover remover(path);
+
+  MLIRContext context;
+  context.allowUnregisteredDialects();
+  ParserConfig config(&context);
+
+  // Textual IR isn't bytecode, so the file is re-opened with a null
+  // terminator before being parsed.
+  llvm::SourceMgr sourceMgr;
+  Block block;
+  ASSERT_TRUE(succeeded(parseSourceFile(path, sourceMgr, &block, config)));
+  EXPECT_EQ(block.front().getName().getStringRef(), "test.first");
+}
+
+TEST(MLIRParser, ParseBytecodeFileReferencesBlobs) {
+  // Use a blob large enough for the input file to be memory mapped.
+  const int64_t numElements = 32768;
+  std::string moduleStr = "\"test.use\"() {attr = dense_resource<blob1> : "
+                          "tensor<" +
+                          std::to_string(numElements) +
+                          "xi32>} : () -> ()\n"
+                          "{-#\n  dialect_resources: {\n    builtin: {\n"
+                          "      blob1: \"0x04000000";
+  for (int64_t i = 0; i != numElements; ++i)
+    moduleStr += "2A000000";
+  moduleStr += "\"\n    }\n  }\n#-}\n";
+
+  MLIRContext context;
+  context.allowUnregisteredDialects();
+  ParserConfig config(&context);
+
+  std::string bytecode;
+  {
+    OwningOpRef<ModuleOp> module =
+        parseSourceString<ModuleOp>(moduleStr, config);
+    ASSERT_TRUE(module);
+    llvm::raw_string_ostream os(bytecode);
+    writeBytecodeToFile(*module, os);
+  }
+  SmallString<128> path;
+  writeTemporaryFile(bytecode, path);
+  llvm::FileRemover remover(path);
+
+  // Parse the file into a fresh context, so that the blob has to come from
+  // the bytecode.
+  MLIRContext readContext;
+  readContext.allowUnregisteredDialects();
+  ParserConfig readConfig(&readContext);
+  auto sourceMgr = std::make_shared<llvm::SourceMgr>();
+  OwningOpRef<ModuleOp> module =
+      parseSourceFile<ModuleOp>(path, sourceMgr, readConfig);
+  ASSERT_TRUE(module);
+
+  // The file is mapped rather than read into the heap, and the blob references
+  // it directly rather than being copied.
+  const llvm::MemoryBuffer *buffer =
+      sourceMgr->getMemoryBuffer(sourceMgr->getMainFileID());
+  EXPECT_EQ(buffer->getBufferKind(), llvm::MemoryBuffer::MemoryBuffer_MMap);
+
+  auto attr = module->getBody()
+                  ->front()
+                  .getAttrOfType<DenseResourceElementsAttr>("attr");
+  ASSERT_TRUE(attr);
+  AsmResourceBlob *blob = attr.getRawHandle().getBlob();
+  ASSERT_TRUE(blob);
+  ArrayRef<char> data = blob->getData();
+  ASSERT_EQ(data.size(), size_t(numElements * 4));
+  EXPECT_GE(data.data(), buffer->getBufferStart());
+  EXPECT_LE(data.data() + data.size(), buffer->getBufferEnd());
+  EXPECT_EQ(data[0], 0x2A);
+}
 } // namespace
@@ -0,0 +1,232 @@
+#!/usr/bin/env python3
+
+"""Search transform dialect parameters (tile sizes, interchange, vector sizes)
+for a linalg kernel by benchmarking every candidate on the host.
+
+The transform script is given as a template in which parameters are written as
+'{{name}}'. Every '--param name=v1,v2,...' adds a dimension to the search
+space, and the cartesian product of all of them is explored (or a random
+sample of it, see --max-candidates). A value may contain commas when it is
+written between brackets, e.g. '--param tiles=[8,16],[16,32]' expands to the
+values '8, 16' and '16, 32', which is convenient for tile size lists.
+
+For each candidate the payload is transformed with the transform-interpreter
+pass, lowered with the passes of --lower-pipeline and run with mlir-cpu-runner. The
+entry function of the payload is expected to time the kernel itself (e.g. with
+'func.call @rtclock()' from the C runner utils) and print the elapsed time in
+seconds as the last line of its output; this keeps JIT compilation out of the
+measurement. The fastest candidate's transform script is written to --output.
+
+Example:
+
+  tune-transform.py --bindir build/bin --shared-libs \\
+      build/lib/libmlir_c_runner_utils.so,build/lib/libmlir_runner_utils.so \\
+      --param tile_m=8,16,32 --param tile_n=16,32,64 --param vec=4,8 \\
+      matmul.mlir matmul-transform.mlir.in -o best-transform.mlir
+"""
+
+import argparse
+import itertools
+import os
+import random
+import re
+import subprocess
+import sys
+import tempfile
+
+PLACEHOLDER_RE = re.compile(r"\{\{(\w+)\}\}")
+FLOAT_RE = re.compile(r"[-+]?(\d+\.?\d*|\.\d+)([eE][-+]?\d+)?")
+
+DEFAULT_LOWER_PIPELINE = (
+    "one-shot-bufferize{bufferize-function-boundaries},"
+    "convert-vector-to-scf,convert-linalg-to-loops,lower-affine,"
+    "convert-scf-to-cf,convert-vector-to-llvm,finalize-memref-to-llvm,"
+    "convert-func-to-llvm,convert-index-to-llvm,reconcile-unrealized-casts"
+)
+
+
+def tool(args, name):
+    return os.path.join(args.bindir, name) if args.bindir else name
+
+
+def split_values(text):
+    """Split a comma separated value list, keeping bracketed groups whole."""
+    values = []
+    depth = 0
+    current = ""
+    for char in text:
+        if char == "," and depth == 0:
+            values.append(current)
+            current = ""
+            continue
+        depth += {"[": 1, "]": -1}.get(char, 0)
+        current += char
+    values.append(current)
+    # Brackets only serve grouping, e.g. '[8,16]' stands for '8, 16'.
+    return [
+        ", ".join(v.strip() for v in value.strip()[1:-1].split(","))
+        if value.strip().startswith("[")
+        else value.strip()
+        for value in values
+    ]
+
+
+def parse_params(specs):
+    params = {}
+    for spec in specs:
+        name, sep, values = spec.partition("=")
+        if not sep or not values:
+            sys.exit("error: expected --param name=v1,v2,..., got '%s'" % spec)
+        params[name] = split_values(values)
+    return params
+
+
+def candidates(args, params):
+    names = sorted(params)
+    space = [dict(zip(names, values)) for values in
+             itertools.product(*(params[name] for name in names))]
+    if args.max_candidates and len(space) > args.max_candidates:
+        random.Random(args.seed).shuffle(space)
+        space = space[: args.max_candidates]
+    return space
+
+
+def instantiate(template, candidate):
+    return PLACEHOLDER_RE.sub(lambda m: candidate[m.group(1)], template)
+
+
+def run(cmd, timeout, input=None):
+    """Run a command and return its stdout, or None if it failed."""
+    try:
+        result = subprocess.run(
+            cmd,
+            input=input,
+            stdout=subprocess.PIPE,
+            stderr=subprocess.PIPE,
+            text=True,
+            timeout=timeout,
+        )
+    except subprocess.TimeoutExpired:
+        return None, "timed out after %ss" % timeout
+    if result.returncode != 0:
+        lines = result.stderr.strip().splitlines()
+        return None, lines[-1] if lines else "exit code %d" % result.returncode
+    return result.stdout, None
+
+
+def benchmark(args, payload, transform_path):
+    """Return the best reported time of the transformed payload, or an error."""
+    # mlir-opt doesn't allow mixing --pass-pipeline with individual pass
+    # flags, so run the interpreter as part of the lowering pipeline. The
+    # script is read from its own file, so the payload has no schedule left to
+    # erase.
+    pipeline = "builtin.module(transform-interpreter{transform-file-name=%s},%s)" % (
+        transform_path,
+        args.lower_pipeline,
+    )
+    transform = [tool(args, "mlir-opt"), payload, "--pass-pipeline=" + pipeline]
+    lowered, error = run(transform, args.timeout)
+    if lowered is None:
+        return None, "transform/lowering: %s" % error
+
+    runner = [
+        tool(args, "mlir-cpu-runner"),
+        "-e",
+        args.entry,
+        "-entry-point-result=void",
+        "-O" + args.opt_level,
+    ]
+    if args.shared_libs:
+        runner.append("-shared-libs=" + args.shared_libs)
+    best = None
+    for _ in range(args.repetitions):
+        output, error = run(runner, args.timeout, input=lowered)
+        if output is None:
+            return None, "execution: %s" % error
+        lines = output.strip().splitlines()
+        match = FLOAT_RE.search(lines[-1]) if lines else None
+        if not match:
+            return None, "execution: no time printed on the last line"
+        time = float(match.group(0))
+        best = time if best is None else min(best, time)
+    return best, None
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter
+    )
+    parser.add_argument("payload", help="MLIR file containing the kernel")
+    parser.add_argument("template", help="transform script template")
+    parser.add_argument("-o", "--output", help="where to write the best script")
+    parser.add_argument(
+        "--param",
+        action="append",
+        default=[],
+        metavar="NAME=V1,V2,...",
+        help="values to explore for the '{{NAME}}' placeholder",
+    )
+    parser.add_argument("--bindir", help="directory containing mlir-opt and mlir-cpu-runner")
+    parser.add_argument("--shared-libs", help="comma separated runtime libraries")
+    parser.add_argument("--entry", default="main", help="entry function of the payload")
+    parser.add_argument(
+        "--lower-pipeline",
+        default=DEFAULT_LOWER_PIPELINE,
+        help="comma separated module passes lowering the transformed payload "
+        "to the LLVM dialect",
+    )
+    parser.add_argument("--opt-level", default="3", choices="0123", help="JIT -O level")
+    parser.add_argument(
+        "--repetitions", type=int, default=3, help="runs per candidate, the best is kept"
+    )
+    parser.add_argument(
+        "--max-candidates",
+        type=int,
+        default=0,
+        help="benchmark a random sample of at most this many candidates",
+    )
+    parser.add_argument("--seed", type=int, default=0, help="seed for the sampling")
+    parser.add_argument(
+        "--timeout", type=int, default=300, help="timeout in seconds for each tool run"
+    )
+    args = parser.parse_args()
+
+    with open(args.template) as f:
+        template = f.read()
+    params = parse_params(args.param)
+    missing = set(PLACEHOLDER_RE.findall(template)) - set(params)
+    if missing:
+        sys.exit("error: no --param given for: " + ", ".join(sorted(missing)))
+
+    space = candidates(args, params)
+    results = []
+    with tempfile.TemporaryDirectory() as tmpdir:
+        transform_path = os.path.join(tmpdir, "transform.mlir")
+        for index, candidate in enumerate(space):
+            script = instantiate(template, candidate)
+            with open(transform_path, "w") as f:
+                f.write(script)
+            time, error = benchmark(args, args.payload, transform_path)
+            desc = " ".join("%s=%s" % item for item in sorted(candidate.items()))
+            if time is None:
+                print("[%d/%d] %s: skipped, %s" % (index + 1, len(space), desc, error),
+                      file=sys.stderr)
+                continue
+            print("[%d/%d] %s: %.6fs" % (index + 1, len(space), desc, time))
+            results.append((time, desc, script))
+
+    if not results:
+        sys.exit("error: no candidate could be benchmarked")
+
+    results.sort(key=lambda result: result[0])
+    print("\nbest %d of %d candidates:" % (min(5, len(results)), len(space)))
+    for time, desc, _ in results[:5]:
+        print("  %.6fs  %s" % (time, desc))
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(results[0][2])
+        print("\nwrote the best transform script to %s" % args.output)
+
+
+if __name__ == "__main__":
+    main()
@@ -370,7 +370,8 @@ Error GenericDeviceTy::init(GenericPluginTy &Plugin) {
   // Enable the memory manager if required.
   auto [ThresholdMM, EnableMM] = MemoryManagerTy::getSizeThresholdFromEnv();
   if (EnableMM)
-    MemoryManager = new MemoryManagerTy(*this, ThresholdMM);
+    MemoryManager = new MemoryManagerTy(*this, ThresholdMM,
+                                        MemoryManagerTy::getPoolLimitFromEnv());
 
   if (RecordReplay.isRecordingOrReplaying())
     if (auto Err = RecordReplay.init(this))
@@ -382,8 +383,10 @@ Error GenericDeviceTy::init(GenericPluginTy &Plugin) {
 Error GenericDeviceTy::deinit() {
   // Delete the memory manager before deinitilizing the device. Otherwise,
   // we may delete device allocations after the device is deinitialized.
-  if (MemoryManager)
+  if (MemoryManager) {
+    MemoryManager->printStatistics(DeviceId);
     delete MemoryManager;
+  }
   MemoryManager = nullptr;
 
   if (RecordReplay.isRecordingOrReplaying())
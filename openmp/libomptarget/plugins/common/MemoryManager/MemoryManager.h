@@ -13,6 +13,7 @@
 #ifndef LLVM_OPENMP_LIBOMPTARGET_PLUGINS_COMMON_MEMORYMANAGER_MEMORYMANAGER_H
 #define LLVM_OPENMP_LIBOMPTARGET_PLUGINS_COMMON_MEMORYMANAGER_MEMORYMANAGER_H
 
+#include <atomic>
 #include <cassert>
 #include <functional>
 #include <list>
@@ -132,13 +133,35 @@ class MemoryManagerTy {
   /// memory manager.
   size_t SizeThreshold = 1U << 13;
 
+  /// The maximum number of bytes kept in the FreeLists. The memory freed beyond
+  /// it is returned to the device. Zero means there is no limit.
+  size_t PoolLimit = 0;
+
+  /// Usage statistics of the memory manager.
+  struct StatisticsTy {
+    /// Number of allocations requested to the memory manager
+    std::atomic<uint64_t> Allocations{0};
+    /// Number of allocations served from the FreeLists
+    std::atomic<uint64_t> Reuses{0};
+    /// Number of allocations and deallocations on the device
+    std::atomic<uint64_t> DeviceAllocations{0};
+    std::atomic<uint64_t> DeviceFrees{0};
+    /// Number of bytes currently in the FreeLists, and its maximum
+    std::atomic<size_t> CachedBytes{0};
+    std::atomic<size_t> MaxCachedBytes{0};
+  } Statistics;
+
   /// Request memory from target device
-  void *allocateOnDevice(size_t Size, void *HstPtr) const {
+  void *allocateOnDevice(size_t Size, void *HstPtr) {
+    ++Statistics.DeviceAllocations;
     return DeviceAllocator.allocate(Size, HstPtr, TARGET_ALLOC_DEVICE);
   }
 
   /// Deallocate data on device
-  int deleteOnDevice(void *Ptr) const { return DeviceAllocator.free(Ptr); }
+  int deleteOnDevice(void *Ptr) {
+    ++Statistics.DeviceFrees;
+    return DeviceAllocator.free(Ptr);
+  }
 
   /// This function is called when it tries to allocate memory on device but the
   /// device returns out of memory. It will first free all memory in the
@@ -155,6 +178,7 @@ class MemoryManagerTy {
       for (const NodeTy &N : List) {
         deleteOnDevice(N.Ptr);
         RemoveList.push_back(N.Ptr);
+        Statistics.CachedBytes -= N.Size;
       }
       FreeLists[I].clear();
     }
@@ -193,10 +217,12 @@ class MemoryManagerTy {
 
 public:
   /// Constructor. If \p Threshold is non-zero, then the default threshold will
-  /// be overwritten by \p Threshold.
-  MemoryManagerTy(DeviceAllocatorTy &DeviceAllocator, size_t Threshold = 0)
+  /// be overwritten by \p Threshold. If \p Limit is non-zero, the FreeLists
+  /// keep at most \p Limit bytes.
+  MemoryManagerTy(DeviceAllocatorTy &DeviceAllocator, size_t Threshold = 0,
+                  size_t Limit = 0)
       : FreeLists(NumBuckets), FreeListLocks(NumBuckets),
-        DeviceAllocator(DeviceAllocator) {
+        DeviceAllocator(DeviceAllocator), PoolLimit(Limit) {
     if (Threshold)
       SizeThreshold = Threshold;
   }
@@ -221,6 +247,8 @@ public:
     DP("MemoryManagerTy::allocate: size %zu with host pointer " DPxMOD ".\n",
        Size, DPxPTR(HstPtr));
 
+    ++Statistics.Allocations;
+
     // If the size is greater than the threshold, allocate it directly from
     // device.
     if (Size > SizeThreshold) {
@@ -243,16 +271,22 @@ public:
 
       NodeTy TempNode(Size, nullptr);
       std::lock_guard<std::mutex> LG(FreeListLocks[B]);
-      const auto Itr = List.find(TempNode);
+      // Take the smallest node that is large enough, unless more than half of
+      // it would be wasted, which can only happen in the last bucket.
+      const auto Itr = List.lower_bound(TempNode);
 
-      if (Itr != List.end()) {
+      if (Itr != List.end() && Itr->get().Size / 2 < Size) {
         NodePtr = &Itr->get();
         List.erase(Itr);
       }
     }
 
-    if (NodePtr != nullptr)
-      DP("Find one node " DPxMOD " in the bucket.\n", DPxPTR(NodePtr));
+    if (NodePtr != nullptr) {
+      DP("Find one node " DPxMOD " of size %zu in the bucket.\n",
+         DPxPTR(NodePtr), NodePtr->Size);
+      ++Statistics.Reuses;
+      Statistics.CachedBytes -= NodePtr->Size;
+    }
 
     // We cannot find a valid node in FreeLists. Let's allocate on device and
     // create a node for it.
@@ -303,8 +337,28 @@ public:
       return deleteOnDevice(TgtPtr);
     }
 
+    // Return the memory to the device if the FreeLists are full
+    const size_t Size = P->Size;
+    const size_t CachedBytes = Statistics.CachedBytes += Size;
+    if (PoolLimit && CachedBytes > PoolLimit) {
+      Statistics.CachedBytes -= Size;
+      DP("The FreeLists hold %zu bytes, more than the limit %zu. Delete it on "
+         "device.\n",
+         CachedBytes, PoolLimit);
+      {
+        std::lock_guard<std::mutex> G(MapTableLock);
+        PtrToNodeTable.erase(TgtPtr);
+      }
+      return deleteOnDevice(TgtPtr);
+    }
+    size_t MaxCachedBytes = Statistics.MaxCachedBytes;
+    while (MaxCachedBytes < CachedBytes &&
+           !Statistics.MaxCachedBytes.compare_exchange_weak(MaxCachedBytes,
+                                                            CachedBytes))
+      ;
+
     // Insert the node to the free list
-    const int B = findBucket(P->Size);
+    const int B = findBucket(Size);
 
     DP("Found its node " DPxMOD ". Insert it to bucket %d.\n", DPxPTR(P), B);
 
@@ -337,6 +391,27 @@ public:
 
     return std::make_pair(Threshold, true);
   }
+
+  /// Get the maximum number of bytes kept in the FreeLists from the
+  /// environment variable \p LIBOMPTARGET_MEMORY_MANAGER_POOL_LIMIT . Returns 0,
+  /// which means no limit, if user doesn't specify anything.
+  static size_t getPoolLimitFromEnv() {
+    if (const char *Env = std::getenv("LIBOMPTARGET_MEMORY_MANAGER_POOL_LIMIT"))
+      return std::stoul(Env);
+    return 0;
+  }
+
+  /// Print the usage statistics of the memory manager of the device
+  /// \p DeviceId if user requests them with \p LIBOMPTARGET_INFO .
+  void printStatistics(int DeviceId) const {
+    INFO(OMP_INFOTYPE_MEMORY_MANAGER, DeviceId,
+         "Memory manager: %" PRIu64 " allocations, %" PRIu64
+         " reused, %" PRIu64 " device allocations, %" PRIu64
+         " device frees, %zu bytes cached at most\n",
+         Statistics.Allocations.load(), Statistics.Reuses.load(),
+         Statistics.DeviceAllocations.load(), Statistics.DeviceFrees.load(),
+         Statistics.MaxCachedBytes.load());
+  }
 };
 
 // GCC still cannot handle the static data member like Clang so we still need
@@ -0,0 +1,34 @@
+// RUN: %libomptarget-compile-generic
+// RUN: env LIBOMPTARGET_INFO=64 %libomptarget-run-generic 2>&1 | \
+// RUN:   %fcheck-generic -check-prefix=CACHE
+// RUN: env LIBOMPTARGET_INFO=64 LIBOMPTARGET_MEMORY_MANAGER_POOL_LIMIT=1000 \
+// RUN:   %libomptarget-run-generic 2>&1 | %fcheck-generic -check-prefix=LIMIT
+
+// Test that the memory manager reuses a free buffer that is slightly larger
+// than the request, that the pool limit sends the freed buffers back to the
+// device, and that the statistics are reported.
+
+#include <omp.h>
+#include <stdio.h>
+
+int main() {
+  int Device = omp_get_default_device();
+
+  // Each buffer is a little smaller than the previous one, so every
+  // allocation but the first can take the buffer freed just before it.
+  for (int I = 15; I >= 0; --I) {
+    void *P = omp_target_alloc((1000 + I) * sizeof(int), Device);
+    if (!P) {
+      printf("allocation failed\n");
+      return 1;
+    }
+    omp_target_free(P, Device);
+  }
+
+  return 0;
+}
+
+// The statistics are printed when the device is deinitialized, before the
+// memory manager returns its cached buffers to the device.
+// CACHE: device {{[0-9]+}} info: Memory manager: 16 allocations, 15 reused, 1 device allocations, 0 device frees, 4060 bytes cached at most
+// LIMIT: device {{[0-9]+}} info: Memory manager: 16 allocations, 0 reused, 16 device allocations, 16 device frees, 0 bytes cached at most
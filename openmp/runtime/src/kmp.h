@@ -2054,6 +2054,7 @@ typedef enum kmp_bar_pat { /* Barrier communication patterns */
                                                 branching factor 2^n */
                            bp_hierarchical_bar = 3, /* Machine hierarchy tree */
                            bp_dist_bar = 4, /* Distributed barrier */
+                           bp_dissem_bar = 5, /* Dissemination barrier */
                            bp_last_bar /* Placeholder to mark the end */
 } kmp_bar_pat_e;
 
@@ -2325,6 +2326,7 @@ extern kmp_tasking_mode_t
     __kmp_tasking_mode; /* determines how/when to execute tasks */
 extern int __kmp_task_stealing_constraint;
 extern int __kmp_enable_task_throttling;
+extern int __kmp_task_steal_locality;
 extern kmp_int32 __kmp_default_device; // Set via OMP_DEFAULT_DEVICE if
 // specified, defaults to 0 otherwise
 // Set via OMP_MAX_TASK_PRIORITY if specified, defaults to 0 otherwise
@@ -2586,6 +2588,8 @@ struct kmp_taskdata { /* aligned during dynamic allocation       */
   ompt_task_info_t ompt_task_info;
 #endif
   kmp_target_data_t td_target_data;
+  // Page of the first list item of the affinity clause, 0 without the clause
+  kmp_uintptr_t td_affinity_page;
 #if KMP_MOLDABILITY
   bool td_moldable;
   kmp_task_stats_t *td_task_stats;
@@ -2611,6 +2615,12 @@ typedef struct kmp_base_thread_data {
   kmp_int32 td_deque_ntasks; // Number of tasks in deque
   // GEH: shouldn't this be volatile since used in while-spin?
   kmp_int32 td_deque_last_stolen; // Thread number of last successful steal
+  // The other threads of the team, the ones on the same core first, then the
+  // ones sharing the last level cache, then the same NUMA domain, then the
+  // others. NULL when the topology of the thread is unknown.
+  kmp_int32 *td_victims;
+  kmp_int32 td_victims_len;
+  kmp_int32 td_victims_next; // Index into td_victims of the next victim to try
 #if KMP_MOLDABILITY
   // Thread number of last successful (moldable) steal
   kmp_int32 td_deque_last_stolen_m;
@@ -2666,6 +2676,14 @@ typedef union KMP_ALIGN_CACHE kmp_thread_data {
   char td_pad[KMP_PAD(kmp_base_thread_data_t, CACHE_LINE)];
 } kmp_thread_data_t;
 
+// Remembers which thread last executed a task with an affinity clause on the
+// page, so that the next tasks with affinity to it are queued on that thread.
+#define KMP_TASK_AFFINITY_HOMES 256
+typedef struct kmp_task_affinity_home {
+  kmp_uintptr_t page;
+  kmp_int32 tid;
+} kmp_task_affinity_home_t;
+
 typedef struct kmp_task_pri {
   kmp_thread_data_t td;
   kmp_int32 priority;
@@ -2704,6 +2722,9 @@ typedef struct kmp_base_task_team {
   KMP_ALIGN_CACHE
   volatile kmp_uint32
       tt_active; /* is the team still actively executing tasks */
+
+  KMP_ALIGN_CACHE
+  kmp_task_affinity_home_t tt_affinity_homes[KMP_TASK_AFFINITY_HOMES];
 #if KMP_MOLDABILITY
   kmp_bootstrap_lock_t tt_moldable_teams_affinity_lock;
 
@@ -3049,6 +3070,8 @@ typedef struct KMP_ALIGN_CACHE kmp_base_team {
   void *t_stack_id; // team specific stack stitching id (for ittnotify)
 #endif /* USE_ITT_BUILD */
   distributedBarrier *b; // Distributed barrier data associated with team
+  // Dissemination barrier data associated with team
+  disseminationBarrier *dissem;
 } kmp_base_team_t;
 
 union KMP_ALIGN_CACHE kmp_team {
@@ -551,6 +551,219 @@ static void __kmp_dist_barrier_release(
            gtid, team->t.t_id, tid, bt));
 }
 
+// Dissemination Barrier
+
+// Have the threads sharing a last level cache poll the same go signal, so the
+// release costs one write per cache and no traffic between the caches.
+void disseminationBarrier::computeGo(size_t nthr) {
+  threads_per_go = MAX_THREADS_PER_GO / 2;
+  if (__kmp_topology) {
+    int thread_level = __kmp_topology->get_level(KMP_HW_THREAD);
+    int cache_level = __kmp_topology->get_level(KMP_HW_LLC);
+    if (cache_level < 0)
+      cache_level = __kmp_topology->get_level(KMP_HW_SOCKET);
+    if (thread_level >= 0 && cache_level >= 0 && cache_level < thread_level)
+      threads_per_go =
+          __kmp_topology->calculate_ratio(thread_level, cache_level);
+  }
+  if (threads_per_go > MAX_THREADS_PER_GO)
+    threads_per_go = MAX_THREADS_PER_GO;
+  if (threads_per_go == 0)
+    threads_per_go = 1;
+  num_gos = (nthr + threads_per_go - 1) / threads_per_go;
+}
+
+// This function is to reallocate the barrier arrays when the new number of
+// threads exceeds max_threads. The arrays are only touched inside of the
+// parallel regions, so this is safe when the team is forked.
+void disseminationBarrier::resize(size_t nthr) {
+  KMP_DEBUG_ASSERT(nthr > max_threads);
+
+  if (flags)
+    __kmp_free(flags);
+  if (threads)
+    __kmp_free(threads);
+  if (go)
+    __kmp_free(go);
+
+  max_threads = nthr;
+  for (max_rounds = 0; ((size_t)1 << max_rounds) < max_threads; ++max_rounds)
+    ;
+
+  // __kmp_allocate clears the flags, which never match a valid barrier state
+  flags = (flag_s *)__kmp_allocate(bs_last_barrier * max_threads * 2 *
+                                   max_rounds * sizeof(flag_s));
+  threads = (thread_s *)__kmp_allocate(max_threads * sizeof(thread_s));
+  go = (go_s *)__kmp_allocate(bs_last_barrier * max_threads * sizeof(go_s));
+  for (size_t i = 0; i < max_threads; ++i)
+    threads[i].spins = INIT_SPINS;
+}
+
+void disseminationBarrier::update_num_threads(size_t nthr) {
+  if (nthr > max_threads)
+    resize(nthr);
+  computeGo(nthr);
+  num_threads = nthr;
+}
+
+void disseminationBarrier::deallocate(disseminationBarrier *db) {
+  if (db->flags)
+    __kmp_free(db->flags);
+  if (db->threads)
+    __kmp_free(db->threads);
+  if (db->go)
+    __kmp_free(db->go);
+  KMP_ALIGNED_FREE(db);
+}
+
+// Spin on a signal of the dissemination barrier for an adaptive number of
+// iterations, then fall back to the generic wait, which executes tasks and
+// sleeps after the blocktime. The budget doubles when the signal comes late
+// in the spin, and halves when it doesn't come at all, so the threads which
+// usually wait for a long time quickly stop burning their spins. There is no
+// spin when there are tasks to execute instead.
+static void __kmp_dissem_barrier_wait(kmp_info_t *this_thr,
+                                      disseminationBarrier *b, int tid,
+                                      std::atomic<kmp_uint64> *loc,
+                                      kmp_uint64 state, int final_spin
+                                          USE_ITT_BUILD_ARG(void *itt_sync_obj)) {
+  kmp_task_team_t *task_team = this_thr->th.th_task_team;
+  if (__kmp_tasking_mode == tskm_immediate_exec || task_team == NULL ||
+      !KMP_TASKING_ENABLED(task_team)) {
+    kmp_uint32 budget = b->threads[tid].spins;
+    kmp_uint32 spins = 0;
+    while (loc->load(std::memory_order_acquire) != state && spins < budget) {
+      KMP_CPU_PAUSE();
+      ++spins;
+    }
+    if (spins < budget) {
+      if (spins > budget / 2 && budget < disseminationBarrier::MAX_SPINS)
+        b->threads[tid].spins = budget * 2;
+      return;
+    }
+    if (budget > disseminationBarrier::MIN_SPINS)
+      b->threads[tid].spins = budget / 2;
+  }
+  kmp_atomic_flag_64<false, true> flag(loc, state, &(b->threads[tid].sleep));
+  flag.wait(this_thr, final_spin USE_ITT_BUILD_ARG(itt_sync_obj));
+  KMP_DEBUG_ASSERT(b->threads[tid].sleep == false);
+}
+
+// Wake up a thread which may sleep on a signal of the dissemination barrier.
+static inline void __kmp_dissem_barrier_wakeup(disseminationBarrier *b,
+                                               kmp_team_t *team, size_t tid) {
+  if (__kmp_dflt_blocktime != KMP_MAX_BLOCKTIME && b->threads[tid].sleep) {
+    __kmp_atomic_resume_64(team->t.t_threads[tid]->th.th_info.ds.ds_gtid,
+                           (kmp_atomic_flag_64<> *)NULL);
+  }
+}
+
+static void __kmp_dissem_barrier_gather(
+    enum barrier_type bt, kmp_info_t *this_thr, int gtid, int tid,
+    void (*reduce)(void *, void *) USE_ITT_BUILD_ARG(void *itt_sync_obj)) {
+  KMP_TIME_DEVELOPER_PARTITIONED_BLOCK(KMP_dissem_gather);
+  kmp_team_t *team = this_thr->th.th_team;
+  kmp_bstate_t *thr_bar = &this_thr->th.th_bar[bt].bb;
+  kmp_info_t **other_threads = team->t.t_threads;
+  disseminationBarrier *b = team->t.dissem;
+  kmp_uint32 nproc = this_thr->th.th_team_nproc;
+  // The primary thread bumps the team state only once all the threads arrived,
+  // so it is still the state of the previous barrier for every thread here.
+  kmp_uint64 new_state = team->t.t_bar[bt].b_arrived + KMP_BARRIER_STATE_BUMP;
+  size_t parity = (new_state / KMP_BARRIER_STATE_BUMP) & 1;
+
+  KA_TRACE(
+      20,
+      ("__kmp_dissem_barrier_gather: T#%d(%d:%d) enter for barrier type %d\n",
+       gtid, team->t.t_id, tid, bt));
+  KMP_DEBUG_ASSERT(b && nproc <= b->max_threads);
+  KMP_DEBUG_ASSERT(this_thr == other_threads[this_thr->th.th_info.ds.ds_tid]);
+
+#if USE_ITT_BUILD && USE_ITT_NOTIFY
+  // Barrier imbalance - save arrive time to the thread
+  if (__kmp_forkjoin_frames_mode == 3 || __kmp_forkjoin_frames_mode == 2) {
+    this_thr->th.th_bar_arrive_time = this_thr->th.th_bar_min_time =
+        __itt_get_timestamp();
+  }
+#endif
+
+  for (size_t round = 0, dist = 1; dist < nproc; ++round, dist <<= 1) {
+    size_t to = (tid + dist) % nproc;
+    KA_TRACE(20, ("__kmp_dissem_barrier_gather: T#%d(%d:%d) round %d "
+                  "signals T#%d(%d:%d) with %llu\n",
+                  gtid, team->t.t_id, tid, (int)round,
+                  __kmp_gtid_from_tid((int)to, team), team->t.t_id, (int)to,
+                  new_state));
+    b->get_flag(bt, to, parity, round)->store(new_state);
+    __kmp_dissem_barrier_wakeup(b, team, to);
+    __kmp_dissem_barrier_wait(this_thr, b, tid,
+                              b->get_flag(bt, tid, parity, round), new_state,
+                              FALSE USE_ITT_BUILD_ARG(itt_sync_obj));
+  }
+
+  if (KMP_MASTER_TID(tid)) {
+    // All the threads arrived and wait for the release, so their data is
+    // ready to be reduced.
+    if (reduce) {
+      OMPT_REDUCTION_DECL(this_thr, gtid);
+      OMPT_REDUCTION_BEGIN;
+      for (kmp_uint32 i = 1; i < nproc; ++i) {
+        (*reduce)(this_thr->th.th_local.reduce_data,
+                  other_threads[i]->th.th_local.reduce_data);
+      }
+      OMPT_REDUCTION_END;
+    }
+    team->t.t_bar[bt].b_arrived = new_state;
+    KA_TRACE(20, ("__kmp_dissem_barrier_gather: T#%d(%d:%d) set team %d "
+                  "arrived(%p) = %llu\n",
+                  gtid, team->t.t_id, tid, team->t.t_id,
+                  &team->t.t_bar[bt].b_arrived, team->t.t_bar[bt].b_arrived));
+  } else {
+    // Keep the thread state in sync with the team state, as the other
+    // patterns and the release expect.
+    thr_bar->b_arrived = new_state;
+  }
+  KA_TRACE(
+      20, ("__kmp_dissem_barrier_gather: T#%d(%d:%d) exit for barrier type %d\n",
+           gtid, team->t.t_id, tid, bt));
+}
+
+// Every thread knows that the others arrived at the end of the gather, so the
+// workers only wait for the primary thread to be done with the tasks. The
+// primary thread writes one go signal per group of threads sharing a cache.
+static void __kmp_dissem_barrier_release(
+    enum barrier_type bt, kmp_info_t *this_thr, int gtid, int tid,
+    int propagate_icvs USE_ITT_BUILD_ARG(void *itt_sync_obj)) {
+  KMP_TIME_DEVELOPER_PARTITIONED_BLOCK(KMP_dissem_release);
+  kmp_team_t *team = this_thr->th.th_team;
+  disseminationBarrier *b = team->t.dissem;
+
+  KA_TRACE(20,
+           ("__kmp_dissem_barrier_release: T#%d(%d:%d) enter for barrier type "
+            "%d\n",
+            gtid, team->t.t_id, tid, bt));
+  // The fork barrier releases threads which are not in the team yet.
+  KMP_DEBUG_ASSERT(bt != bs_forkjoin_barrier && !propagate_icvs);
+
+  if (KMP_MASTER_TID(tid)) {
+    kmp_uint64 state = team->t.t_bar[bt].b_arrived;
+    size_t nproc = this_thr->th.th_team_nproc;
+    for (size_t i = 0; i < b->num_gos; ++i)
+      b->get_go(bt, i * b->threads_per_go)->store(state);
+    for (size_t i = 1; i < nproc; ++i)
+      __kmp_dissem_barrier_wakeup(b, team, i);
+  } else {
+    kmp_uint64 state = this_thr->th.th_bar[bt].bb.b_arrived;
+    __kmp_dissem_barrier_wait(this_thr, b, tid,
+                              b->get_go(bt, tid), state,
+                              TRUE USE_ITT_BUILD_ARG(itt_sync_obj));
+  }
+  KA_TRACE(
+      20,
+      ("__kmp_dissem_barrier_release: T#%d(%d:%d) exit for barrier type %d\n",
+       gtid, team->t.t_id, tid, bt));
+}
+
 // Linear Barrier
 template <bool cancellable = false>
 static bool __kmp_linear_barrier_gather_template(
@@ -1871,6 +2084,11 @@ static int __kmp_barrier_template(enum barrier_type bt, int gtid, int is_split,
                                   reduce USE_ITT_BUILD_ARG(itt_sync_obj));
         break;
       }
+      case bp_dissem_bar: {
+        __kmp_dissem_barrier_gather(bt, this_thr, gtid, tid,
+                                    reduce USE_ITT_BUILD_ARG(itt_sync_obj));
+        break;
+      }
       case bp_hyper_bar: {
         // don't set branch bits to 0; use linear
         KMP_ASSERT(__kmp_barrier_gather_branch_bits[bt]);
@@ -1990,6 +2208,11 @@ static int __kmp_barrier_template(enum barrier_type bt, int gtid, int is_split,
                                      FALSE USE_ITT_BUILD_ARG(itt_sync_obj));
           break;
         }
+        case bp_dissem_bar: {
+          __kmp_dissem_barrier_release(bt, this_thr, gtid, tid,
+                                       FALSE USE_ITT_BUILD_ARG(itt_sync_obj));
+          break;
+        }
         case bp_hyper_bar: {
           KMP_ASSERT(__kmp_barrier_release_branch_bits[bt]);
           __kmp_hyper_barrier_release(bt, this_thr, gtid, tid,
@@ -2125,6 +2348,11 @@ void __kmp_end_split_barrier(enum barrier_type bt, int gtid) {
                                    FALSE USE_ITT_BUILD_ARG(NULL));
         break;
       }
+      case bp_dissem_bar: {
+        __kmp_dissem_barrier_release(bt, this_thr, gtid, tid,
+                                     FALSE USE_ITT_BUILD_ARG(NULL));
+        break;
+      }
       case bp_hyper_bar: {
         KMP_ASSERT(__kmp_barrier_release_branch_bits[bt]);
         __kmp_hyper_barrier_release(bt, this_thr, gtid, tid,
@@ -138,4 +138,82 @@ public:
   void go_reset();
 };
 
+// In round k of the dissemination barrier, the thread tid signals the thread
+// (tid + 2^k) % nproc and waits for the signal of (tid - 2^k) % nproc, so every
+// thread knows that all the threads arrived after ceil(log2(nproc)) rounds.
+// The signals are the barrier state, written in one of two sets of flags
+// chosen by the parity of the state, so they never need to be reset. Each
+// barrier type has its own flags, since their states are independent.
+class disseminationBarrier {
+  struct flag_s {
+    std::atomic<kmp_uint64> KMP_ALIGN_CACHE flag;
+  };
+
+  struct thread_s {
+    std::atomic<bool> KMP_ALIGN_CACHE sleep;
+    // Number of iterations to spin on a flag before the generic wait
+    kmp_uint32 KMP_ALIGN_CACHE spins;
+  };
+
+  struct go_s {
+    std::atomic<kmp_uint64> KMP_ALIGN_CACHE go;
+  };
+
+  void resize(size_t nthr);
+  void computeGo(size_t nthr);
+
+public:
+  enum {
+    MIN_SPINS = 16,
+    INIT_SPINS = 256,
+    MAX_SPINS = 4096,
+    MAX_THREADS_PER_GO = 16,
+  };
+
+  flag_s *flags; // barrier types * max_threads * 2 parities * max_rounds
+  thread_s *threads;
+  go_s *go; // barrier types * max_threads
+
+  size_t KMP_ALIGN_CACHE num_threads; // number of threads in barrier
+  size_t max_threads; // size of arrays in data structure
+  size_t max_rounds; // ceil(log2(max_threads))
+  // number of go signals the primary thread writes in the release
+  size_t num_gos;
+  // threads polling each go signal
+  size_t threads_per_go;
+
+  disseminationBarrier() = delete;
+  ~disseminationBarrier() = delete;
+
+  // Used instead of constructor to create aligned data
+  static disseminationBarrier *allocate(int nThreads) {
+    disseminationBarrier *d = (disseminationBarrier *)KMP_ALIGNED_ALLOCATE(
+        sizeof(disseminationBarrier), CACHE_LINE);
+    if (!d) {
+      KMP_FATAL(MemoryAllocFailed);
+    }
+    d->flags = NULL;
+    d->threads = NULL;
+    d->go = NULL;
+    d->num_threads = 0;
+    d->max_threads = 0;
+    d->max_rounds = 0;
+    d->update_num_threads(nThreads);
+    return d;
+  }
+
+  static void deallocate(disseminationBarrier *db);
+
+  void update_num_threads(size_t nthr);
+
+  std::atomic<kmp_uint64> *get_flag(int bt, size_t tid, size_t parity,
+                                    size_t round) {
+    return &flags[((bt * max_threads + tid) * 2 + parity) * max_rounds + round]
+                .flag;
+  }
+  std::atomic<kmp_uint64> *get_go(int bt, size_t tid) {
+    return &go[bt * max_threads + tid / threads_per_go].go;
+  }
+};
+
 #endif // KMP_BARRIER_H
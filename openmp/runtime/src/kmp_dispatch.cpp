@@ -104,6 +104,16 @@ enum { // values for steal_flag (possible states of private per-loop buffer)
   // 3 -> 2 owner only, async
   // 3 -> 0 last thread finishing the loop, async
 };
+
+// Number of chunks the owner of a static_steal range takes at once out of its
+// remaining ones. Taking 1/8 of them makes a long range of small chunks cost
+// few updates of the (count, ub) pair the thieves compete for, while most of
+// the range is still left for the thieves to balance the load. The last
+// chunks are taken one by one.
+template <typename UT>
+static inline UT __kmp_static_steal_own_chunks(UT remaining) {
+  return remaining > 15 ? remaining >> 3 : 1;
+}
 #endif
 
 // Initialize a dispatch_private_info_template<T> buffer for a particular
@@ -1207,6 +1217,7 @@ int __kmp_dispatch_next_algorithm(int gtid,
   case kmp_sch_static_steal: {
     T chunk = pr->u.p.parm1;
     UT nchunks = pr->u.p.parm2;
+    UT taken = 1; // number of chunks to execute, starting from init
     KD_TRACE(100,
              ("__kmp_dispatch_next_algorithm: T#%d kmp_sch_static_steal case\n",
               gtid));
@@ -1221,9 +1232,13 @@ int __kmp_dispatch_next_algorithm(int gtid,
       if (pr->u.p.count < (UT)pr->u.p.ub) {
         KMP_DEBUG_ASSERT(pr->steal_flag == READY);
         __kmp_acquire_lock(lck, gtid);
-        // try to get own chunk of iterations
-        init = (pr->u.p.count)++;
+        // try to get own chunks of iterations
+        init = pr->u.p.count;
         status = (init < (UT)pr->u.p.ub);
+        if (status) {
+          taken = __kmp_static_steal_own_chunks<UT>((UT)pr->u.p.ub - init);
+          pr->u.p.count = init + taken;
+        }
         __kmp_release_lock(lck, gtid);
       } else {
         status = 0; // no own chunks
@@ -1355,17 +1370,21 @@ int __kmp_dispatch_next_algorithm(int gtid,
       union_i4 vold, vnew;
       if (pr->u.p.count < (UT)pr->u.p.ub) {
         KMP_DEBUG_ASSERT(pr->steal_flag == READY);
-        vold.b = *(volatile kmp_int64 *)(&pr->u.p.count);
-        vnew.b = vold.b;
-        vnew.p.count++; // get chunk from head of self range
-        while (!KMP_COMPARE_AND_STORE_REL64(
-            (volatile kmp_int64 *)&pr->u.p.count,
-            *VOLATILE_CAST(kmp_int64 *) & vold.b,
-            *VOLATILE_CAST(kmp_int64 *) & vnew.b)) {
-          KMP_CPU_PAUSE();
+        while (1) { // get chunks from head of self range
           vold.b = *(volatile kmp_int64 *)(&pr->u.p.count);
           vnew.b = vold.b;
-          vnew.p.count++;
+          // thieves may have shrunk the range since the check above
+          taken = 1;
+          if (vold.p.count < (UT)vold.p.ub)
+            taken = __kmp_static_steal_own_chunks<UT>((UT)vold.p.ub -
+                                                      vold.p.count);
+          vnew.p.count += taken;
+          if (KMP_COMPARE_AND_STORE_REL64(
+                  (volatile kmp_int64 *)&pr->u.p.count,
+                  *VOLATILE_CAST(kmp_int64 *) & vold.b,
+                  *VOLATILE_CAST(kmp_int64 *) & vnew.b))
+            break;
+          KMP_CPU_PAUSE();
         }
         init = vold.p.count;
         status = (init < (UT)vold.p.ub);
@@ -1501,9 +1520,9 @@ int __kmp_dispatch_next_algorithm(int gtid,
     } else {
       start = pr->u.p.lb;
       init *= chunk;
-      limit = chunk + init - 1;
+      limit = chunk * taken + init - 1;
       incr = pr->u.p.st;
-      KMP_COUNT_DEVELOPER_VALUE(FOR_static_steal_chunks, 1);
+      KMP_COUNT_DEVELOPER_VALUE(FOR_static_steal_chunks, taken);
 
       KMP_DEBUG_ASSERT(init <= trip);
       // keep track of done chunks for possible early exit from stealing
@@ -112,7 +112,7 @@ char const *__kmp_barrier_type_name[bs_last_barrier] = {"plain", "forkjoin"
 #endif // KMP_FAST_REDUCTION_BARRIER
 };
 char const *__kmp_barrier_pattern_name[bp_last_bar] = {
-    "linear", "tree", "hyper", "hierarchical", "dist"};
+    "linear", "tree", "hyper", "hierarchical", "dist", "dissemination"};
 
 int __kmp_allThreadsSpecified = 0;
 size_t __kmp_align_alloc = CACHE_LINE;
@@ -362,6 +362,7 @@ KMP_BUILD_ASSERT(sizeof(kmp_tasking_flags_t) == 4);
 
 int __kmp_task_stealing_constraint = 1; /* Constrain task stealing by default */
 int __kmp_enable_task_throttling = 1;
+int __kmp_task_steal_locality = TRUE; /* Steal from the closest threads first */
 
 #ifdef DEBUG_SUSPEND
 int __kmp_suspend_count = 0;
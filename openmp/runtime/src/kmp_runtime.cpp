@@ -1025,6 +1025,17 @@ static void __kmp_fork_team_threads(kmp_root_t *root, kmp_team_t *team,
     }
   }
 
+  // No thread of the team is in a barrier yet, so the dissemination barrier
+  // can be resized.
+  if (team->t.t_nproc > 1 &&
+      (__kmp_barrier_gather_pattern[bs_plain_barrier] == bp_dissem_bar ||
+       __kmp_barrier_gather_pattern[bs_reduction_barrier] == bp_dissem_bar)) {
+    if (!team->t.dissem)
+      team->t.dissem = disseminationBarrier::allocate(team->t.t_nproc);
+    else
+      team->t.dissem->update_num_threads(team->t.t_nproc);
+  }
+
   if (__kmp_display_affinity && team->t.t_display_affinity != 1) {
     for (i = 0; i < team->t.t_nproc; i++) {
       kmp_info_t *thr = team->t.t_threads[i];
@@ -5796,6 +5807,12 @@ void __kmp_free_team(kmp_root_t *root,
       distributedBarrier::deallocate(team->t.b);
       team->t.b = NULL;
     }
+    // The state of a team from the pool starts over, so its dissemination
+    // barrier has to start from cleared flags.
+    if (team->t.dissem) {
+      disseminationBarrier::deallocate(team->t.dissem);
+      team->t.dissem = NULL;
+    }
     /* put the team back in the team pool */
     /* TODO limit size of team pool, call reap_team if pool too large */
     team->t.t_next_pool = CCAST(kmp_team_t *, __kmp_team_pool);
@@ -5844,6 +5861,8 @@ kmp_team_t *__kmp_reap_team(kmp_team_t *team) {
   /* TODO clean the threads that are a part of this? */
 
   /* free stuff */
+  if (team->t.dissem)
+    disseminationBarrier::deallocate(team->t.dissem);
   __kmp_free_team_arrays(team);
   if (team->t.t_argv != &team->t.t_inline_argv[0])
     __kmp_free((void *)team->t.t_argv);
@@ -1851,6 +1851,24 @@ static void __kmp_stg_parse_barrier_pattern(char const *name, char const *value,
                      __kmp_barrier_pattern_name[bp_linear_bar]);
         }
       }
+
+      // The workers wait for the fork barrier outside of the team, so it can't
+      // use the dissemination barrier, whose data lives in the team.
+      if (i == bs_forkjoin_barrier &&
+          (__kmp_barrier_gather_pattern[i] == bp_dissem_bar ||
+           __kmp_barrier_release_pattern[i] == bp_dissem_bar)) {
+        KMP_WARNING(BarrGatherValueInvalid, name, value);
+        KMP_INFORM(Using_str_Value, name,
+                   __kmp_barrier_pattern_name[bp_hyper_bar]);
+        if (__kmp_barrier_gather_pattern[i] == bp_dissem_bar)
+          __kmp_barrier_gather_pattern[i] = bp_hyper_bar;
+        if (__kmp_barrier_release_pattern[i] == bp_dissem_bar)
+          __kmp_barrier_release_pattern[i] = bp_hyper_bar;
+      }
+      // The dissemination release relies on the state the dissemination
+      // gather leaves in every thread.
+      if (__kmp_barrier_release_pattern[i] == bp_dissem_bar)
+        __kmp_barrier_gather_pattern[i] = bp_dissem_bar;
     }
   }
   if (dist_req != 0) {
@@ -5278,6 +5296,19 @@ static void __kmp_stg_print_task_throttling(kmp_str_buf_t *buffer,
   __kmp_stg_print_bool(buffer, name, __kmp_enable_task_throttling);
 } // __kmp_stg_print_task_throttling
 
+// -----------------------------------------------------------------------------
+// KMP_TASK_STEAL_LOCALITY
+
+static void __kmp_stg_parse_task_steal_locality(char const *name,
+                                                char const *value, void *data) {
+  __kmp_stg_parse_bool(name, value, &__kmp_task_steal_locality);
+} // __kmp_stg_parse_task_steal_locality
+
+static void __kmp_stg_print_task_steal_locality(kmp_str_buf_t *buffer,
+                                                char const *name, void *data) {
+  __kmp_stg_print_bool(buffer, name, __kmp_task_steal_locality);
+} // __kmp_stg_print_task_steal_locality
+
 #if KMP_HAVE_MWAIT || KMP_HAVE_UMWAIT
 // -----------------------------------------------------------------------------
 // KMP_USER_LEVEL_MWAIT
@@ -5683,6 +5714,8 @@ static kmp_setting_t __kmp_stg_table[] = {
 #endif
     {"KMP_ENABLE_TASK_THROTTLING", __kmp_stg_parse_task_throttling,
      __kmp_stg_print_task_throttling, NULL, 0, 0},
+    {"KMP_TASK_STEAL_LOCALITY", __kmp_stg_parse_task_steal_locality,
+     __kmp_stg_print_task_steal_locality, NULL, 0, 0},
 
     {"OMP_DISPLAY_ENV", __kmp_stg_parse_omp_display_env,
      __kmp_stg_print_omp_display_env, NULL, 0, 0},
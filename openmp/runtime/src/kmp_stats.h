@@ -251,6 +251,8 @@ enum stats_state_e {
 // KMP_hyper_release      -- time in __kmp_hyper_barrier_release
 // KMP_dist_gather       -- time in __kmp_dist_barrier_gather
 // KMP_dist_release      -- time in __kmp_dist_barrier_release
+// KMP_dissem_gather     -- time in __kmp_dissem_barrier_gather
+// KMP_dissem_release    -- time in __kmp_dissem_barrier_release
 // clang-format off
 #define KMP_FOREACH_DEVELOPER_TIMER(macro, arg)                                \
   macro(KMP_fork_call, 0, arg)                                                 \
@@ -262,6 +264,8 @@ enum stats_state_e {
   macro(KMP_hyper_release, 0, arg)                                             \
   macro(KMP_dist_gather, 0, arg)                                              \
   macro(KMP_dist_release, 0, arg)                                             \
+  macro(KMP_dissem_gather, 0, arg)                                             \
+  macro(KMP_dissem_release, 0, arg)                                            \
   macro(KMP_linear_gather, 0, arg)                                             \
   macro(KMP_linear_release, 0, arg)                                            \
   macro(KMP_tree_gather, 0, arg)                                               \
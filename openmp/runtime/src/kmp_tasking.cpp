@@ -16,8 +16,10 @@
 #include "kmp_stats.h"
 #include "kmp_wait_release.h"
 #include "kmp_taskdeps.h"
-#if KMP_MOLDABILITY
+#if KMP_AFFINITY_SUPPORTED || KMP_MOLDABILITY
 #include "kmp_affinity.h"
+#endif
+#if KMP_MOLDABILITY
 #include "kmp_io.h"
 #include <sys/resource.h>
 #endif
@@ -39,9 +41,11 @@ static void __kmp_alloc_task_deque(kmp_info_t *thread,
 #if KMP_MOLDABILITY
 static void __kmp_alloc_moldable_task_deque(kmp_info_t *thread,
                                    kmp_thread_data_t *thread_data, int team_i);
+#endif
 static bool __kmp_give_task(kmp_info_t *thread, kmp_int32 tid, kmp_task_t *task,
                             kmp_int32 pass, int team_i);
-#endif
+static kmp_int32 __kmp_get_task_affinity_home(kmp_task_team_t *task_team,
+                                              kmp_uintptr_t page);
 static int __kmp_realloc_task_threads_data(kmp_info_t *thread,
                                            kmp_task_team_t *task_team);
 static void __kmp_bottom_half_finish_proxy(kmp_int32 gtid, kmp_task_t *ptask);
@@ -716,6 +720,25 @@ static kmp_int32 __kmp_push_task(kmp_int32 gtid, kmp_task_t *task) {
     KMP_DEBUG_ASSERT(result);
   } else {
 #endif
+  // Queue a task with an affinity clause on the thread which ran the last task
+  // with affinity to the same data, if there is room in its deque.
+  if (taskdata->td_affinity_page != 0) {
+    kmp_int32 home =
+        __kmp_get_task_affinity_home(task_team, taskdata->td_affinity_page);
+    if (home != -1 && home != tid) {
+      kmp_info_t *home_thread = task_team->tt.tt_threads_data[home].td.td_thr;
+      if (__kmp_give_task(home_thread, home, task, 0, 0)) {
+        if (__kmp_dflt_blocktime != KMP_MAX_BLOCKTIME &&
+            TCR_PTR(CCAST(void *, home_thread->th.th_sleep_loc)) != NULL)
+          __kmp_null_resume_wrapper(home_thread);
+        KA_TRACE(20, ("__kmp_push_task: T#%d gave task %p to its affinity "
+                      "home T#%d\n",
+                      gtid, taskdata, __kmp_gtid_from_thread(home_thread)));
+        return TASK_SUCCESSFULLY_PUSHED;
+      }
+    }
+  }
+
   // No lock needed since only owner can allocate. If the task is hidden_helper,
   // we don't need it either because we have initialized the dequeue for hidden
   // helper thread data.
@@ -1751,6 +1774,7 @@ kmp_task_t *__kmp_task_alloc(ident_t *loc_ref, kmp_int32 gtid,
   taskdata->td_dephash = NULL;
   taskdata->td_depnode = NULL;
   taskdata->td_target_data.async_handle = NULL;
+  taskdata->td_affinity_page = 0;
   if (flags->tiedness == TASK_UNTIED)
     taskdata->td_last_tied = NULL; // will be set when the task is scheduled
   else
@@ -1847,9 +1871,53 @@ kmp_int32
 __kmpc_omp_reg_task_with_affinity(ident_t *loc_ref, kmp_int32 gtid,
                                   kmp_task_t *new_task, kmp_int32 naffins,
                                   kmp_task_affinity_info_t *affin_list) {
+  // The affinity clause is a hint. The task is queued on the thread which ran
+  // the last task with affinity to the same page, which has the data in its
+  // caches or in its NUMA domain. Only the first list item is looked at.
+  if (naffins > 0 && affin_list != NULL && new_task != NULL) {
+    kmp_taskdata_t *taskdata = KMP_TASK_TO_TASKDATA(new_task);
+    taskdata->td_affinity_page =
+        (kmp_uintptr_t)ALIGN_TO_PAGE(affin_list[0].base_addr);
+    KA_TRACE(20, ("__kmpc_omp_reg_task_with_affinity: T#%d task %p has "
+                  "affinity to page %p\n",
+                  gtid, taskdata, (void *)taskdata->td_affinity_page));
+  }
   return 0;
 }
 
+// __kmp_task_affinity_home_slot: returns the slot of the page in the table of
+// the threads which last ran a task with affinity to it. Collisions only
+// overwrite a hint.
+static kmp_task_affinity_home_t *
+__kmp_task_affinity_home_slot(kmp_task_team_t *task_team, kmp_uintptr_t page) {
+  kmp_uintptr_t hash = page / KMP_GET_PAGE_SIZE();
+  hash ^= hash >> 8;
+  return &task_team->tt.tt_affinity_homes[hash % KMP_TASK_AFFINITY_HOMES];
+}
+
+// __kmp_get_task_affinity_home: returns the tid of the thread which last ran
+// a task with affinity to the page, or -1.
+static kmp_int32 __kmp_get_task_affinity_home(kmp_task_team_t *task_team,
+                                              kmp_uintptr_t page) {
+  kmp_task_affinity_home_t *home =
+      __kmp_task_affinity_home_slot(task_team, page);
+  if ((kmp_uintptr_t)TCR_PTR(home->page) != page)
+    return -1;
+  kmp_int32 tid = TCR_4(home->tid);
+  // The entry may have been left by an earlier team
+  return tid < task_team->tt.tt_nproc ? tid : -1;
+}
+
+static void __kmp_set_task_affinity_home(kmp_task_team_t *task_team,
+                                         kmp_uintptr_t page, kmp_int32 tid) {
+  kmp_task_affinity_home_t *home =
+      __kmp_task_affinity_home_slot(task_team, page);
+  if ((kmp_uintptr_t)TCR_PTR(home->page) == page && TCR_4(home->tid) == tid)
+    return; // Don't dirty the cache line of the other threads
+  TCW_PTR(home->page, page);
+  TCW_4(home->tid, tid);
+}
+
 //  __kmp_invoke_task: invoke the specified task
 //
 // gtid: global thread ID of caller
@@ -1933,6 +2001,12 @@ static void __kmp_invoke_task(kmp_int32 gtid, kmp_task_t *task,
   // Invoke the task routine and pass in relevant data.
   // Thunks generated by gcc take a different argument list.
   if (!discard) {
+    if (taskdata->td_affinity_page != 0 && taskdata->td_task_team != NULL &&
+        !KMP_HIDDEN_HELPER_THREAD(gtid)) {
+      __kmp_set_task_affinity_home(taskdata->td_task_team,
+                                   taskdata->td_affinity_page,
+                                   __kmp_tid_from_gtid(gtid));
+    }
     if (taskdata->td_flags.tiedness == TASK_UNTIED) {
       taskdata->td_last_tied = current_task->td_last_tied;
       KMP_DEBUG_ASSERT(taskdata->td_last_tied);
@@ -3913,13 +3987,22 @@ static inline int __kmp_execute_tasks_template(
           asleep = 0;
         } else if (!new_victim) { // no recent steals and we haven't already
           // used a new victim; select a random thread
+          kmp_thread_data_t *my_data = &threads_data[tid];
           do { // Find a different thread to steal work from.
-            // Pick a random thread. Initial plan was to cycle through all the
-            // threads, and only return if we tried to steal from every thread,
-            // and failed.  Arch says that's not such a great idea.
-            victim_tid = __kmp_get_random(thread) % (nthreads - 1);
-            if (victim_tid >= tid) {
-              ++victim_tid; // Adjusts random distribution to exclude self
+            if (my_data->td.td_victims != NULL) {
+              // Go through the other threads from the closest to the
+              // furthest, see __kmp_create_victim_lists.
+              victim_tid = my_data->td.td_victims[my_data->td.td_victims_next];
+              my_data->td.td_victims_next =
+                  (my_data->td.td_victims_next + 1) % my_data->td.td_victims_len;
+            } else {
+              // Pick a random thread. Initial plan was to cycle through all
+              // the threads, and only return if we tried to steal from every
+              // thread, and failed.  Arch says that's not such a great idea.
+              victim_tid = __kmp_get_random(thread) % (nthreads - 1);
+              if (victim_tid >= tid) {
+                ++victim_tid; // Adjusts random distribution to exclude self
+              }
             }
             // Found a potential victim
             other_thread = threads_data[victim_tid].td.td_thr;
@@ -4101,6 +4184,8 @@ static inline int __kmp_execute_tasks_template(
           } else {
             if (threads_data[tid].td.td_deque_last_stolen != victim_tid) {
               threads_data[tid].td.td_deque_last_stolen = victim_tid;
+              // Start again from the closest threads when this one runs dry
+              threads_data[tid].td.td_victims_next = 0;
               changed = true;
             }
           }
@@ -4703,6 +4788,99 @@ static void __kmp_create_steal_lists(kmp_task_team_t *task_team, kmp_info_t *thr
   __kmp_free(team_count);
 }
 
+#if KMP_AFFINITY_SUPPORTED
+// Returns how far apart the threads run: 0 on the same core, 1 sharing the
+// last level cache, 2 in the same NUMA domain and 3 further, or -1 if a thread
+// isn't bound to a single place.
+static int __kmp_get_thread_distance(kmp_info_t *a, kmp_info_t *b) {
+  if (!KMP_AFFINITY_CAPABLE() || __kmp_topology == NULL)
+    return -1;
+  // The id of a thread at a level is relative to its unit at the level above,
+  // so the threads share a unit only if all the ids down to it are equal.
+  int depth = __kmp_topology->get_depth();
+  int common = -1;
+  for (int level = 0; level < depth; ++level) {
+    kmp_hw_t type = __kmp_topology->get_type(level);
+    int id_a = a->th.th_topology_ids[type];
+    int id_b = b->th.th_topology_ids[type];
+    if (level == 0 && (id_a < 0 || id_b < 0))
+      return -1;
+    if (id_a < 0 || id_a != id_b)
+      break;
+    common = level;
+  }
+  const kmp_hw_t units[] = {KMP_HW_CORE, KMP_HW_LLC, KMP_HW_NUMA};
+  for (int distance = 0; distance < 3; ++distance) {
+    int level = __kmp_topology->get_level(units[distance]);
+    if (level != -1 && common >= level)
+      return distance;
+  }
+  return 3;
+}
+
+// Sorts the other threads of the team by their distance to each thread in its
+// td_victims, so that __kmp_execute_tasks_template steals from the same core
+// first, then from the same last level cache, then from the same NUMA domain.
+// The threads at the same distance are shuffled so that they don't all pick the
+// same victim. The lists are only rebuilt when the threads of the team change.
+// `thread` is only used for sampling random numbers
+static void __kmp_create_victim_lists(kmp_task_team_t *task_team,
+                                      kmp_info_t *thread, bool threads_changed) {
+  kmp_int32 nthreads = task_team->tt.tt_nproc;
+  kmp_thread_data_t *threads_data = task_team->tt.tt_threads_data;
+  kmp_int32 *distances =
+      (kmp_int32 *)__kmp_allocate(sizeof(kmp_int32) * nthreads);
+
+  for (int t = 0; t < nthreads; t++) {
+    kmp_thread_data_t *thread_data = &threads_data[t];
+    thread_data->td.td_victims_next = 0;
+    if (!threads_changed && thread_data->td.td_victims != NULL &&
+        thread_data->td.td_victims_len == nthreads - 1)
+      continue;
+    if (thread_data->td.td_victims != NULL) {
+      __kmp_free(thread_data->td.td_victims);
+      thread_data->td.td_victims = NULL;
+    }
+    thread_data->td.td_victims_len = 0;
+    if (!__kmp_task_steal_locality || nthreads < 2)
+      continue;
+
+    bool known = true;
+    for (int v = 0; v < nthreads && known; v++) {
+      if (v != t) {
+        distances[v] = __kmp_get_thread_distance(thread_data->td.td_thr,
+                                                 threads_data[v].td.td_thr);
+        known = distances[v] != -1;
+      }
+    }
+    if (!known)
+      continue; // Keep stealing from random victims
+
+    kmp_int32 *victims =
+        (kmp_int32 *)__kmp_allocate(sizeof(kmp_int32) * (nthreads - 1));
+    int len = 0;
+    for (int distance = 0; distance <= 3; distance++) {
+      int first = len;
+      for (int v = 0; v < nthreads; v++) {
+        if (v != t && distances[v] == distance)
+          victims[len++] = v;
+      }
+      // Shuffle the threads at this distance, version of Fisher-Yates
+      for (int i = first; i < len - 1; ++i) {
+        int j = __kmp_get_random(thread) % (len - i) + i;
+        kmp_int32 temp = victims[i];
+        victims[i] = victims[j];
+        victims[j] = temp;
+      }
+    }
+    KMP_DEBUG_ASSERT(len == nthreads - 1);
+    thread_data->td.td_victims = victims;
+    thread_data->td.td_victims_len = len;
+  }
+  __kmp_free(distances);
+}
+#endif // KMP_AFFINITY_SUPPORTED
+
 // __kmp_realloc_task_threads_data:
 // Allocates a threads_data array for a task team, either by allocating an
 // initial array or enlarging an existing array.  Only the first thread to get
@@ -4791,8 +4969,11 @@ static int __kmp_realloc_task_threads_data(kmp_info_t *thread,
     }
 
     // initialize threads_data pointers back to thread_info structures
+    bool threads_changed = false;
     for (i = 0; i < nthreads; i++) {
       kmp_thread_data_t *thread_data = &(*threads_data_p)[i];
+      if (thread_data->td.td_thr != team->t.t_threads[i])
+        threads_changed = true;
       thread_data->td.td_thr = team->t.t_threads[i];
 
       if (thread_data->td.td_deque_last_stolen >= nthreads) {
@@ -4805,6 +4986,9 @@ static int __kmp_realloc_task_threads_data(kmp_info_t *thread,
       thread_data->td.td_deque_last_stolen_m = -1;
       thread_data->td.td_deque_last_stolen_mteam = -1;
     }
+#if KMP_AFFINITY_SUPPORTED
+    __kmp_create_victim_lists(task_team, thread, threads_changed);
+#endif
 #if KMP_MOLDABILITY
     KMP_DEBUG_ASSERT(__kmp_topology);
 
@@ -5054,6 +5238,8 @@ static void __kmp_free_task_threads_data(kmp_task_team_t *task_team) {
     int i;
     for (i = 0; i < task_team->tt.tt_max_threads; i++) {
       __kmp_free_task_deque(&task_team->tt.tt_threads_data[i]);
+      if (task_team->tt.tt_threads_data[i].td.td_victims != NULL)
+        __kmp_free(task_team->tt.tt_threads_data[i].td.td_victims);
 #if KMP_MOLDABILITY
       for (int j = 0; j < MAX_TEAMS_PER_THREAD; j++) {
         __kmp_free_moldable_task_deque(&task_team->tt.tt_threads_data[i], j);
@@ -0,0 +1,62 @@
+// RUN: %libomp-compile && env OMP_PLACES=threads OMP_PROC_BIND=close %libomp-run
+// RUN: %libomp-compile && env OMP_PLACES=threads OMP_PROC_BIND=spread KMP_TASK_STEAL_LOCALITY=0 %libomp-run
+// RUN: %libomp-compile && env KMP_AFFINITY=none %libomp-run
+// UNSUPPORTED: gcc
+// UNSUPPORTED: clang-5, clang-6, clang-7, clang-8, clang-9, clang-10, clang-11
+// UNSUPPORTED: icc
+
+// The tasks with an affinity clause are queued on the thread which ran the
+// last task with affinity to the same data, and the idle threads steal from the
+// closest threads first. Make sure every task still runs exactly once, whatever
+// the binding of the threads.
+
+#include <stdio.h>
+#include <omp.h>
+
+#define NBLOCKS 64
+#define BLOCK 1024
+#define ITERATIONS 20
+
+double data[NBLOCKS * BLOCK];
+int runs[NBLOCKS];
+
+int main() {
+  int i, it, errors = 0;
+
+  #pragma omp parallel
+  #pragma omp single
+  {
+    for (it = 0; it < ITERATIONS; ++it) {
+      for (i = 0; i < NBLOCKS; ++i) {
+        #pragma omp task firstprivate(i) affinity(data[i * BLOCK : BLOCK])
+        {
+          int j;
+          for (j = 0; j < BLOCK; ++j)
+            data[i * BLOCK + j] += 1.0;
+          #pragma omp atomic
+          runs[i]++;
+          // Nested tasks without the clause are stolen from the closest
+          // threads first
+          #pragma omp task
+          { /* empty */ }
+        }
+      }
+      #pragma omp taskwait
+    }
+  }
+
+  for (i = 0; i < NBLOCKS; ++i) {
+    if (runs[i] != ITERATIONS)
+      errors++;
+  }
+  for (i = 0; i < NBLOCKS * BLOCK; ++i) {
+    if (data[i] != ITERATIONS)
+      errors++;
+  }
+  if (errors) {
+    printf("failed: %d errors\n", errors);
+    return 1;
+  }
+  printf("passed\n");
+  return 0;
+}
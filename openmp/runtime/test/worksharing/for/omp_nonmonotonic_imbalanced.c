@@ -0,0 +1,83 @@
+// RUN: %libomp-compile-and-run
+// RUN: %libomp-compile && env OMP_NUM_THREADS=7 %libomp-run
+// RUN: %libomp-compile && env KMP_FORCE_MONOTONIC_DYNAMIC_SCHEDULE=1 %libomp-run
+
+// The test checks that the nonmonotonic dynamic loops, which steal chunks from
+// each other and take several of their own chunks at once, execute every
+// iteration exactly once, never split a chunk between threads, and give the
+// last iteration to lastprivate, when the iterations are imbalanced.
+
+#include <stdio.h>
+#include <omp.h>
+
+#define ITERS 20000
+#define CHUNK 3
+
+int hits[ITERS];
+int owner[ITERS];
+volatile int sink;
+
+// The first threads get most of the work, so the others have to steal it.
+static void work(long long i) {
+  int n = i < ITERS / 4 ? 200 : (i % 97 == 0 ? 2000 : 1);
+  for (int k = 0; k < n; ++k)
+    sink = k;
+}
+
+static void run(long long i) {
+  work(i);
+  owner[i] = omp_get_thread_num();
+#pragma omp atomic
+  hits[i]++;
+}
+
+static int check(const char *name, int chunk, long long last) {
+  int i, err = 0;
+  for (i = 0; i < ITERS; ++i) {
+    if (hits[i] != 1 || owner[i] != owner[i - i % chunk]) {
+      if (err++ < 10)
+        printf("%s: iteration %d executed %d times, by thread %d\n", name, i,
+               hits[i], owner[i]);
+    }
+    hits[i] = 0;
+  }
+  if (last != ITERS) {
+    printf("%s: lastprivate is %lld\n", name, last);
+    err++;
+  }
+  return err;
+}
+
+int main(int argc, char **argv) {
+  int err = 0;
+  int i;
+  long long j;
+  unsigned long long k;
+
+#pragma omp parallel for schedule(nonmonotonic : dynamic) lastprivate(i)
+  for (i = 0; i < ITERS; ++i)
+    run(i);
+  err += check("int", 1, i);
+
+#pragma omp parallel for schedule(nonmonotonic : dynamic, CHUNK) lastprivate(i)
+  for (i = 0; i < ITERS; ++i)
+    run(i);
+  err += check("int, chunked", CHUNK, i);
+
+#pragma omp parallel for schedule(nonmonotonic : dynamic) lastprivate(j)
+  for (j = 0; j < ITERS; ++j)
+    run(j);
+  err += check("long long", 1, j);
+
+#pragma omp parallel for schedule(nonmonotonic : dynamic, CHUNK) lastprivate(k)
+  for (k = 0; k < ITERS; ++k)
+    run(k);
+  err += check("unsigned long long, chunked", CHUNK, k);
+
+  if (err > 0) {
+    printf("Failed, err = %d\n", err);
+    return 1;
+  }
+  printf("Passed\n");
+  return 0;
+}
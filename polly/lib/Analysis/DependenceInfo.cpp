@@ -850,7 +850,7 @@ const Dependences &DependenceAnalysis::Result::recomputeDependences(
 
 void DependenceAnalysis::Result::abandonDependences() {
   for (std::unique_ptr<Dependences> &Deps : D)
-    Deps.release();
+    Deps.reset();
 }
 
 DependenceAnalysis::Result
@@ -897,7 +897,7 @@ DependenceInfo::recomputeDependences(Dependences::AnalysisLevel Level) {
 
 void DependenceInfo::abandonDependences() {
   for (std::unique_ptr<Dependences> &Deps : D)
-    Deps.release();
+    Deps.reset();
 }
 
 bool DependenceInfo::runOnScop(Scop &ScopVar) {
@@ -52,6 +52,7 @@
 #include "polly/MatmulOptimizer.h"
 #include "polly/Options.h"
 #include "polly/ScheduleTreeTransform.h"
+#include "polly/Support/GICHelper.h"
 #include "polly/Support/ISLOStream.h"
 #include "polly/Support/ISLTools.h"
 #include "llvm/ADT/Sequence.h"
@@ -190,8 +191,16 @@ static cl::opt<bool> OptimizedScops(
              "transformations is applied on the schedule tree"),
     cl::cat(PollyCategory));
 
+static cl::opt<int> ScheduleComputeOut(
+    "polly-schedule-computeout",
+    cl::desc("Bound the scheduler by a maximal amount of computational steps "
+             "(0 means no bound)"),
+    cl::Hidden, cl::init(300000), cl::cat(PollyCategory));
+
 STATISTIC(ScopsProcessed, "Number of scops processed");
 STATISTIC(ScopsRescheduled, "Number of scops rescheduled");
+STATISTIC(ScheduleComputedOut, "Number of scops that exceeded the scheduler "
+                               "operations limit");
 STATISTIC(ScopsOptimized, "Number of scops optimized");
 
 STATISTIC(NumAffineLoopsOptimized, "Number of affine loops optimized");
@@ -642,6 +651,10 @@ char IslScheduleOptimizerWrapperPass::ID = 0;
 #ifndef NDEBUG
 static void printSchedule(llvm::raw_ostream &OS, const isl::schedule &Schedule,
                           StringRef Desc) {
+  if (Schedule.is_null()) {
+    OS << Desc << ": n/a\n";
+    return;
+  }
   isl::ctx Ctx = Schedule.ctx();
   isl_printer *P = isl_printer_to_str(Ctx.get());
   P = isl_printer_set_yaml_style(P, ISL_YAML_STYLE_BLOCK);
@@ -865,7 +878,20 @@ static void runIslScheduleOptimizer(
     SC = SC.set_proximity(Proximity);
     SC = SC.set_validity(Validity);
     SC = SC.set_coincidence(Validity);
-    Schedule = SC.compute_schedule();
+
+    {
+      IslMaxOperationsGuard MaxOpGuard(Ctx, ScheduleComputeOut);
+      Schedule = SC.compute_schedule();
+
+      if (MaxOpGuard.hasQuotaExceeded()) {
+        LLVM_DEBUG(dbgs() << "Schedule optimizer calculation exceeds ISL "
+                             "quota; keeping the original schedule\n");
+        ScheduleComputedOut++;
+        Schedule = {};
+        isl_ctx_reset_error(Ctx);
+      }
+    }
+
     isl_options_set_on_error(Ctx, OnErrorStatus);
 
     ScopsRescheduled++;
@@ -0,0 +1,50 @@
+; RUN: opt %loadPolly -polly-process-unprofitable -polly-opt-isl \
+; RUN:   -polly-schedule-computeout=1 -debug-only=polly-opt-isl -stats \
+; RUN:   -disable-output < %s 2>&1 | FileCheck %s
+; RUN: opt %loadPolly -polly-process-unprofitable -polly-opt-isl \
+; RUN:   -polly-schedule-computeout=0 -debug-only=polly-opt-isl -stats \
+; RUN:   -disable-output < %s 2>&1 | FileCheck %s --check-prefix=NOBOUND
+; REQUIRES: asserts
+;
+; When the scheduler runs out of operations, the original schedule is kept.
+;
+;    for (long i = 0; i < 1023; i++)
+;      for (long j = 0; j < 1024; j++)
+;        A[i + 1][j] = 2 * A[i][j];
+;
+; CHECK:      Schedule optimizer calculation exceeds ISL quota; keeping the original schedule
+; CHECK-NEXT: After rescheduling: n/a
+; CHECK:      1 polly-opt-isl - Number of scops that exceeded the scheduler operations limit
+;
+; NOBOUND-NOT: exceeds ISL quota
+; NOBOUND:     After rescheduling:
+; NOBOUND-NOT: exceeded the scheduler operations limit
+
+define void @f(ptr %A) {
+entry:
+  br label %for.i
+
+for.i:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %for.i.latch ]
+  %i.plus = add nsw i64 %i, 1
+  br label %for.j
+
+for.j:
+  %j = phi i64 [ 0, %for.i ], [ %j.next, %for.j ]
+  %src = getelementptr inbounds [1024 x double], ptr %A, i64 %i, i64 %j
+  %val = load double, ptr %src
+  %mul = fmul double %val, 2.0
+  %dst = getelementptr inbounds [1024 x double], ptr %A, i64 %i.plus, i64 %j
+  store double %mul, ptr %dst
+  %j.next = add nuw nsw i64 %j, 1
+  %j.cond = icmp ne i64 %j.next, 1024
+  br i1 %j.cond, label %for.j, label %for.i.latch
+
+for.i.latch:
+  %i.next = add nuw nsw i64 %i, 1
+  %i.cond = icmp ne i64 %i.next, 1023
+  br i1 %i.cond, label %for.i, label %exit
+
+exit:
+  ret void
+}
@@ -30,6 +30,12 @@ namespace __pstl
 {
 namespace __par_backend = __omp_backend;
 }
+#elif defined(_PSTL_PAR_BACKEND_STD_THREAD)
+#    include "parallel_backend_std_thread.h"
+namespace __pstl
+{
+namespace __par_backend = __std_thread_backend;
+}
 #else
 _PSTL_PRAGMA_MESSAGE("Parallel backend was not specified");
 #endif
@@ -0,0 +1,764 @@
+// -*- C++ -*-
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _PSTL_PARALLEL_BACKEND_STD_THREAD_H
+#define _PSTL_PARALLEL_BACKEND_STD_THREAD_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "pstl_config.h"
+
+// This backend has no dependency besides the C++ standard library: the work is
+// distributed on a pool of std::thread workers which is created on first use and
+// shared by all the algorithms. The algorithms are written as recursive fork-join
+// computations, and a thread waiting for a forked task to complete executes other
+// pending tasks meanwhile, so nested parallel algorithms do not block the pool.
+
+_PSTL_HIDE_FROM_ABI_PUSH
+
+namespace __pstl
+{
+namespace __std_thread_backend
+{
+
+//------------------------------------------------------------------------
+// use to cancel execution
+//------------------------------------------------------------------------
+inline void
+__cancel_execution()
+{
+    // TODO: Figure out how to make cancelation work.
+}
+
+//------------------------------------------------------------------------
+// raw buffer
+//------------------------------------------------------------------------
+
+template <typename _Tp>
+class __buffer
+{
+    std::allocator<_Tp> __allocator_;
+    _Tp* __ptr_;
+    const std::size_t __buf_size_;
+    __buffer(const __buffer&) = delete;
+    void
+    operator=(const __buffer&) = delete;
+
+  public:
+    __buffer(std::size_t __n) : __allocator_(), __ptr_(__allocator_.allocate(__n)), __buf_size_(__n) {}
+
+    operator bool() const { return __ptr_ != nullptr; }
+
+    _Tp*
+    get() const
+    {
+        return __ptr_;
+    }
+    ~__buffer() { __allocator_.deallocate(__ptr_, __buf_size_); }
+};
+
+// Preliminary size of each chunk: requires further discussion
+inline constexpr std::size_t __default_chunk_size = 2048;
+
+//------------------------------------------------------------------------
+// thread pool
+//------------------------------------------------------------------------
+
+// A unit of work forked by __parallel_invoke_body. It lives on the stack of
+// the forking thread, which does not return before the task has completed.
+class __task
+{
+    void (*__run_)(__task*);
+    std::atomic<bool> __done_;
+
+  public:
+    explicit __task(void (*__run)(__task*)) : __run_(__run), __done_(false) {}
+
+    // The task may be destroyed as soon as it is marked as done, so it must
+    // not be accessed after that.
+    void
+    __execute()
+    {
+        __run_(this);
+        __done_.store(true, std::memory_order_seq_cst);
+    }
+
+    bool
+    __is_done() const
+    {
+        return __done_.load(std::memory_order_seq_cst);
+    }
+};
+
+// Every worker owns a deque of tasks: it pushes and pops its own tasks at the
+// back, so that it keeps working on the most recent (and smallest) tasks while
+// idle threads steal the oldest (and largest) ones from the front. The tasks
+// forked by the threads which are not part of the pool go to an extra deque.
+class __thread_pool
+{
+    struct __task_queue
+    {
+        std::mutex __mutex_;
+        std::deque<__task*> __tasks_;
+    };
+
+    std::vector<std::thread> __workers_;
+    std::unique_ptr<__task_queue[]> __queues_;
+    std::size_t __num_queues_;
+
+    // Number of tasks which are queued and not taken yet, to let the idle
+    // workers sleep.
+    std::atomic<std::size_t> __num_queued_;
+    // Number of threads sleeping in __wait until a stolen task completes, so
+    // that the completion of a task only notifies when someone is waiting.
+    std::atomic<std::size_t> __num_waiting_;
+    std::mutex __sleep_mutex_;
+    std::condition_variable __wake_up_;
+    bool __stop_;
+
+    static std::size_t&
+    __current_queue()
+    {
+        static thread_local std::size_t __index = 0;
+        return __index;
+    }
+
+    __task*
+    __pop_back(std::size_t __index)
+    {
+        __task_queue& __queue = __queues_[__index];
+        std::lock_guard<std::mutex> __lock(__queue.__mutex_);
+        if (__queue.__tasks_.empty())
+            return nullptr;
+        __task* __t = __queue.__tasks_.back();
+        __queue.__tasks_.pop_back();
+        __num_queued_.fetch_sub(1, std::memory_order_relaxed);
+        return __t;
+    }
+
+    __task*
+    __pop_front(std::size_t __index)
+    {
+        __task_queue& __queue = __queues_[__index];
+        std::lock_guard<std::mutex> __lock(__queue.__mutex_);
+        if (__queue.__tasks_.empty())
+            return nullptr;
+        __task* __t = __queue.__tasks_.front();
+        __queue.__tasks_.pop_front();
+        __num_queued_.fetch_sub(1, std::memory_order_relaxed);
+        return __t;
+    }
+
+    void
+    __execute(__task* __t)
+    {
+        __t->__execute();
+        // The store of the done flag and the load of __num_waiting_ are
+        // sequentially consistent, as are the increment of __num_waiting_ and
+        // the check of the flag in __wait, so either the waiter sees that its
+        // task is done or it is notified.
+        if (__num_waiting_.load(std::memory_order_seq_cst) != 0)
+        {
+            { std::lock_guard<std::mutex> __lock(__sleep_mutex_); }
+            __wake_up_.notify_all();
+        }
+    }
+
+    // Takes a task from the deque of the current thread first, then from the
+    // other deques in turn.
+    __task*
+    __find_task()
+    {
+        const std::size_t __self = __current_queue();
+        if (__task* __t = __pop_back(__self))
+            return __t;
+        for (std::size_t __i = 1; __i < __num_queues_; ++__i)
+        {
+            if (__task* __t = __pop_front((__self + __i) % __num_queues_))
+                return __t;
+        }
+        return nullptr;
+    }
+
+    void
+    __worker_loop(std::size_t __index)
+    {
+        __current_queue() = __index;
+        for (;;)
+        {
+            if (__task* __t = __find_task())
+            {
+                __execute(__t);
+                continue;
+            }
+            std::unique_lock<std::mutex> __lock(__sleep_mutex_);
+            __wake_up_.wait(__lock,
+                            [this] { return __stop_ || __num_queued_.load(std::memory_order_relaxed) != 0; });
+            if (__stop_)
+                return;
+        }
+    }
+
+  public:
+    // The thread calling an algorithm takes part in the computation, so one
+    // worker less than the number of hardware threads is started.
+    __thread_pool()
+        : __num_queues_(std::max(1u, std::thread::hardware_concurrency())), __num_queued_(0), __num_waiting_(0),
+          __stop_(false)
+    {
+        __queues_.reset(new __task_queue[__num_queues_]);
+        // Queue 0 receives the tasks of the threads which are not workers.
+        __workers_.reserve(__num_queues_ - 1);
+        for (std::size_t __i = 1; __i < __num_queues_; ++__i)
+            __workers_.emplace_back([this, __i] { __worker_loop(__i); });
+    }
+
+    ~__thread_pool()
+    {
+        {
+            std::lock_guard<std::mutex> __lock(__sleep_mutex_);
+            __stop_ = true;
+        }
+        __wake_up_.notify_all();
+        for (std::thread& __worker : __workers_)
+            __worker.join();
+    }
+
+    __thread_pool(const __thread_pool&) = delete;
+    void
+    operator=(const __thread_pool&) = delete;
+
+    std::size_t
+    __num_threads() const
+    {
+        return __num_queues_;
+    }
+
+    void
+    __push(__task* __t)
+    {
+        {
+            __task_queue& __queue = __queues_[__current_queue()];
+            std::lock_guard<std::mutex> __lock(__queue.__mutex_);
+            __queue.__tasks_.push_back(__t);
+            __num_queued_.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (!__workers_.empty())
+        {
+            // Taking the lock ensures that a worker which just found no task
+            // to run is either woken up or sees the new task.
+            { std::lock_guard<std::mutex> __lock(__sleep_mutex_); }
+            __wake_up_.notify_one();
+        }
+    }
+
+    // Waits for __t, pushed by the current thread, to complete. If it was not
+    // stolen, it is executed inline. Otherwise, the other tasks are executed
+    // until the thief is done, and the thread sleeps while there are none.
+    void
+    __wait(__task* __t)
+    {
+        if (__task* __own = __pop_back(__current_queue()))
+        {
+            if (__own == __t)
+            {
+                __execute(__t);
+                return;
+            }
+            __execute(__own);
+        }
+        while (!__t->__is_done())
+        {
+            if (__task* __other = __find_task())
+            {
+                __execute(__other);
+                continue;
+            }
+            __num_waiting_.fetch_add(1, std::memory_order_seq_cst);
+            {
+                std::unique_lock<std::mutex> __lock(__sleep_mutex_);
+                __wake_up_.wait(__lock, [this, __t] {
+                    return __t->__is_done() || __num_queued_.load(std::memory_order_relaxed) != 0;
+                });
+            }
+            __num_waiting_.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+};
+
+inline __thread_pool&
+__get_thread_pool()
+{
+    static __thread_pool __pool;
+    return __pool;
+}
+
+//------------------------------------------------------------------------
+// parallel_invoke
+//------------------------------------------------------------------------
+
+template <typename _F1, typename _F2>
+void
+__parallel_invoke_body(_F1&& __f1, _F2&& __f2)
+{
+    struct __invoke_task : __task
+    {
+        _F2& __f_;
+        std::exception_ptr __exception_;
+
+        explicit __invoke_task(_F2& __f) : __task(&__run), __f_(__f) {}
+
+        static void
+        __run(__task* __self)
+        {
+            __invoke_task* __t = static_cast<__invoke_task*>(__self);
+            try
+            {
+                std::forward<_F2>(__t->__f_)();
+            }
+            catch (...)
+            {
+                __t->__exception_ = std::current_exception();
+            }
+        }
+    };
+
+    __thread_pool& __pool = __get_thread_pool();
+    __invoke_task __t(__f2);
+    __pool.__push(&__t);
+
+    // __t refers to __f2 and to the stack of this thread, so it has to be
+    // completed before an exception thrown by __f1 is propagated.
+    std::exception_ptr __exception;
+    try
+    {
+        std::forward<_F1>(__f1)();
+    }
+    catch (...)
+    {
+        __exception = std::current_exception();
+    }
+    __pool.__wait(&__t);
+
+    if (__exception)
+        std::rethrow_exception(__exception);
+    if (__t.__exception_)
+        std::rethrow_exception(__t.__exception_);
+}
+
+template <class _ExecutionPolicy, typename _F1, typename _F2>
+void
+__parallel_invoke(__pstl::__internal::__std_thread_backend_tag, _ExecutionPolicy&&, _F1&& __f1, _F2&& __f2)
+{
+    __std_thread_backend::__parallel_invoke_body(std::forward<_F1>(__f1), std::forward<_F2>(__f2));
+}
+
+//------------------------------------------------------------------------
+// parallel_for
+//------------------------------------------------------------------------
+
+// The ranges are split until there are a few chunks per thread, so that the
+// load is balanced by stealing, and the chunks are not smaller than the grain.
+template <class _Index>
+std::size_t
+__get_grain_size(_Index __first, _Index __last, std::size_t __min_grain_size)
+{
+    const std::size_t __size = __last - __first;
+    const std::size_t __chunks_per_thread = 4;
+    return std::max(__min_grain_size, __size / (__chunks_per_thread * __get_thread_pool().__num_threads()));
+}
+
+template <class _Index, class _Fp>
+void
+__parallel_for_body(_Index __first, _Index __last, std::size_t __grain_size, _Fp& __f)
+{
+    const std::size_t __size = __last - __first;
+    if (__size <= __grain_size)
+    {
+        __f(__first, __last);
+        return;
+    }
+
+    _Index __middle = __first + (__size / 2);
+    __std_thread_backend::__parallel_invoke_body(
+        [&]() { __std_thread_backend::__parallel_for_body(__first, __middle, __grain_size, __f); },
+        [&]() { __std_thread_backend::__parallel_for_body(__middle, __last, __grain_size, __f); });
+}
+
+//------------------------------------------------------------------------
+// Notation:
+// Evaluation of brick f[i,j) for each subrange [i,j) of [first, last)
+//------------------------------------------------------------------------
+
+template <class _ExecutionPolicy, class _Index, class _Fp>
+void
+__parallel_for(__pstl::__internal::__std_thread_backend_tag, _ExecutionPolicy&&, _Index __first, _Index __last,
+               _Fp __f)
+{
+    if (__first == __last)
+        return;
+    const std::size_t __grain_size = __std_thread_backend::__get_grain_size(__first, __last, __default_chunk_size);
+    __std_thread_backend::__parallel_for_body(__first, __last, __grain_size, __f);
+}
+
+//------------------------------------------------------------------------
+// parallel_reduce
+//------------------------------------------------------------------------
+
+template <class _Index, class _Value, typename _RealBody, typename _Reduction>
+_Value
+__parallel_reduce_body(_Index __first, _Index __last, std::size_t __grain_size, const _Value& __identity,
+                       const _RealBody& __real_body, const _Reduction& __reduction)
+{
+    const std::size_t __size = __last - __first;
+    if (__size <= __grain_size)
+        return __real_body(__first, __last, __identity);
+
+    _Index __middle = __first + (__size / 2);
+    _Value __v1(__identity), __v2(__identity);
+    __std_thread_backend::__parallel_invoke_body(
+        [&]() {
+            __v1 = __std_thread_backend::__parallel_reduce_body(__first, __middle, __grain_size, __identity,
+                                                                __real_body, __reduction);
+        },
+        [&]() {
+            __v2 = __std_thread_backend::__parallel_reduce_body(__middle, __last, __grain_size, __identity,
+                                                                __real_body, __reduction);
+        });
+    return __reduction(__v1, __v2);
+}
+
+//------------------------------------------------------------------------
+// Notation:
+//      r(i,j,init) returns reduction of init with reduction over [i,j)
+//      c(x,y) combines values x and y that were the result of r
+//------------------------------------------------------------------------
+
+template <class _ExecutionPolicy, class _Value, class _Index, typename _RealBody, typename _Reduction>
+_Value
+__parallel_reduce(__pstl::__internal::__std_thread_backend_tag, _ExecutionPolicy&&, _Index __first, _Index __last,
+                  const _Value& __identity, const _RealBody& __real_body, const _Reduction& __reduction)
+{
+    if (__first == __last)
+        return __identity;
+    const std::size_t __grain_size = __std_thread_backend::__get_grain_size(__first, __last, __default_chunk_size);
+    return __std_thread_backend::__parallel_reduce_body(__first, __last, __grain_size, __identity, __real_body,
+                                                        __reduction);
+}
+
+//------------------------------------------------------------------------
+// parallel_transform_reduce
+//
+// Notation:
+//      r(i,j,init) returns reduction of init with reduction over [i,j)
+//      u(i) returns f(i,i+1,identity) for a hypothetical left identity element
+//      of r c(x,y) combines values x and y that were the result of r or u
+//------------------------------------------------------------------------
+
+// There is no identity element, so the left half of a range is reduced with
+// __init and the right half with u of its first element.
+template <class _Index, class _Up, class _Tp, class _Cp, class _Rp>
+_Tp
+__transform_reduce_body(_Index __first, _Index __last, std::size_t __grain_size, _Up& __u, _Tp __init,
+                        _Cp& __combine, _Rp& __brick_reduce)
+{
+    const std::size_t __size = __last - __first;
+    if (__size <= __grain_size)
+        return __brick_reduce(__first, __last, __init);
+
+    _Index __middle = __first + (__size / 2);
+    _Tp __v1(__init);
+    _Tp __v2(__init);
+    __std_thread_backend::__parallel_invoke_body(
+        [&]() {
+            __v1 = __std_thread_backend::__transform_reduce_body(__first, __middle, __grain_size, __u, __init,
+                                                                 __combine, __brick_reduce);
+        },
+        [&]() {
+            __v2 = __std_thread_backend::__transform_reduce_body(__middle + 1, __last, __grain_size, __u,
+                                                                 __u(__middle), __combine, __brick_reduce);
+        });
+    return __combine(__v1, __v2);
+}
+
+template <class _ExecutionPolicy, class _Index, class _Up, class _Tp, class _Cp, class _Rp>
+_Tp
+__parallel_transform_reduce(__pstl::__internal::__std_thread_backend_tag, _ExecutionPolicy&&, _Index __first,
+                            _Index __last, _Up __u, _Tp __init, _Cp __combine, _Rp __brick_reduce)
+{
+    if (__first == __last)
+        return __init;
+    const std::size_t __grain_size = __std_thread_backend::__get_grain_size(__first, __last, __default_chunk_size);
+    return __std_thread_backend::__transform_reduce_body(__first, __last, __grain_size, __u, __init, __combine,
+                                                         __brick_reduce);
+}
+
+//------------------------------------------------------------------------
+// parallel_scan
+//------------------------------------------------------------------------
+
+template <typename _Index>
+_Index
+__split(_Index __m)
+{
+    _Index __k = 1;
+    while (2 * __k < __m)
+        __k *= 2;
+    return __k;
+}
+
+template <typename _Index, typename _Tp, typename _Rp, typename _Cp>
+void
+__upsweep(_Index __i, _Index __m, _Index __tilesize, _Tp* __r, _Index __lastsize, _Rp __reduce, _Cp __combine)
+{
+    if (__m == 1)
+        __r[0] = __reduce(__i * __tilesize, __lastsize);
+    else
+    {
+        _Index __k = __split(__m);
+        __std_thread_backend::__parallel_invoke_body(
+            [=] { __std_thread_backend::__upsweep(__i, __k, __tilesize, __r, __tilesize, __reduce, __combine); },
+            [=] {
+                __std_thread_backend::__upsweep(__i + __k, __m - __k, __tilesize, __r + __k, __lastsize, __reduce,
+                                                __combine);
+            });
+        if (__m == 2 * __k)
+            __r[__m - 1] = __combine(__r[__k - 1], __r[__m - 1]);
+    }
+}
+
+template <typename _Index, typename _Tp, typename _Cp, typename _Sp>
+void
+__downsweep(_Index __i, _Index __m, _Index __tilesize, _Tp* __r, _Index __lastsize, _Tp __initial, _Cp __combine,
+            _Sp __scan)
+{
+    if (__m == 1)
+        __scan(__i * __tilesize, __lastsize, __initial);
+    else
+    {
+        const _Index __k = __split(__m);
+        __std_thread_backend::__parallel_invoke_body(
+            [=] {
+                __std_thread_backend::__downsweep(__i, __k, __tilesize, __r, __tilesize, __initial, __combine,
+                                                  __scan);
+            },
+            // Assumes that __combine never throws.
+            // TODO: Consider adding a requirement for user functors to be constant.
+            [=, &__combine] {
+                __std_thread_backend::__downsweep(__i + __k, __m - __k, __tilesize, __r + __k, __lastsize,
+                                                  __combine(__initial, __r[__k - 1]), __combine, __scan);
+            });
+    }
+}
+
+// Adapted from Intel(R) Cilk(TM) version from cilkpub.
+//
+// Let i:len denote a counted interval of length n starting at i.  s denotes a generalized-sum value.
+// Expected actions of the functors are:
+//     reduce(i,len) -> s  -- return reduction value of i:len.
+//     combine(s1,s2) -> s -- return merged sum
+//     apex(s) -- do any processing necessary between reduce and scan.
+//     scan(i,len,initial) -- perform scan over i:len starting with initial.
+// The initial range 0:n is partitioned into consecutive subranges.
+// reduce and scan are each called exactly once per subrange.
+// Thus callers can rely upon side effects in reduce.
+// combine must not throw an exception.
+// apex is called exactly once, after all calls to reduce and before all calls to scan.
+// For example, it's useful for allocating a __buffer used by scan but whose size depends upon the
+// result of reduce.
+template <class _ExecutionPolicy, typename _Index, typename _Tp, typename _Rp, typename _Cp, typename _Sp, typename _Ap>
+void
+__parallel_strict_scan(__pstl::__internal::__std_thread_backend_tag, _ExecutionPolicy&&, _Index __n, _Tp __initial,
+                       _Rp __reduce, _Cp __combine, _Sp __scan, _Ap __apex)
+{
+    if (__n <= static_cast<_Index>(__default_chunk_size))
+    {
+        _Tp __sum = __initial;
+        if (__n)
+        {
+            __sum = __combine(__sum, __reduce(_Index(0), __n));
+        }
+        __apex(__sum);
+        if (__n)
+        {
+            __scan(_Index(0), __n, __initial);
+        }
+        return;
+    }
+
+    const _Index __p = __get_thread_pool().__num_threads();
+    const _Index __slack = 4;
+    _Index __tilesize = (__n - 1) / (__slack * __p) + 1;
+    _Index __m = (__n - 1) / __tilesize;
+    __buffer<_Tp> __buf(__m + 1);
+    _Tp* __r = __buf.get();
+
+    __std_thread_backend::__upsweep(_Index(0), _Index(__m + 1), __tilesize, __r, __n - __m * __tilesize, __reduce,
+                                    __combine);
+
+    std::size_t __k = __m + 1;
+    _Tp __t = __r[__k - 1];
+    while ((__k &= __k - 1))
+    {
+        __t = __combine(__r[__k - 1], __t);
+    }
+
+    __apex(__combine(__initial, __t));
+    __std_thread_backend::__downsweep(_Index(0), _Index(__m + 1), __tilesize, __r, __n - __m * __tilesize, __initial,
+                                      __combine, __scan);
+}
+
+template <class _ExecutionPolicy, class _Index, class _Up, class _Tp, class _Cp, class _Rp, class _Sp>
+_Tp
+__parallel_transform_scan(__pstl::__internal::__std_thread_backend_tag, _ExecutionPolicy&&, _Index __n, _Up /* __u */,
+                          _Tp __init, _Cp /* __combine */, _Rp /* __brick_reduce */, _Sp __scan)
+{
+    // TODO: parallelize this function.
+    return __scan(_Index(0), __n, __init);
+}
+
+//------------------------------------------------------------------------
+// parallel_merge
+//------------------------------------------------------------------------
+
+template <typename _RandomAccessIterator1, typename _RandomAccessIterator2, typename _RandomAccessIterator3,
+          typename _Compare, typename _LeafMerge>
+void
+__parallel_merge_body(std::size_t __size_x, std::size_t __size_y, _RandomAccessIterator1 __xs,
+                      _RandomAccessIterator1 __xe, _RandomAccessIterator2 __ys, _RandomAccessIterator2 __ye,
+                      _RandomAccessIterator3 __zs, _Compare __comp, _LeafMerge& __leaf_merge)
+{
+    if (__size_x + __size_y <= __default_chunk_size)
+    {
+        __leaf_merge(__xs, __xe, __ys, __ye, __zs, __comp);
+        return;
+    }
+
+    // Split the larger range in half, and the smaller one at the position of
+    // the middle element of the larger one, keeping equal elements of the
+    // first range before those of the second range.
+    _RandomAccessIterator1 __xm;
+    _RandomAccessIterator2 __ym;
+    if (__size_x < __size_y)
+    {
+        __ym = __ys + (__size_y / 2);
+        __xm = std::upper_bound(__xs, __xe, *__ym, __comp);
+    }
+    else
+    {
+        __xm = __xs + (__size_x / 2);
+        __ym = std::lower_bound(__ys, __ye, *__xm, __comp);
+    }
+
+    auto __zm = __zs + (__xm - __xs) + (__ym - __ys);
+    __std_thread_backend::__parallel_invoke_body(
+        [&]() {
+            __std_thread_backend::__parallel_merge_body(__xm - __xs, __ym - __ys, __xs, __xm, __ys, __ym, __zs,
+                                                        __comp, __leaf_merge);
+        },
+        [&]() {
+            __std_thread_backend::__parallel_merge_body(__xe - __xm, __ye - __ym, __xm, __xe, __ym, __ye, __zm,
+                                                        __comp, __leaf_merge);
+        });
+}
+
+template <class _ExecutionPolicy, typename _RandomAccessIterator1, typename _RandomAccessIterator2,
+          typename _RandomAccessIterator3, typename _Compare, typename _LeafMerge>
+void
+__parallel_merge(__pstl::__internal::__std_thread_backend_tag, _ExecutionPolicy&&, _RandomAccessIterator1 __xs,
+                 _RandomAccessIterator1 __xe, _RandomAccessIterator2 __ys, _RandomAccessIterator2 __ye,
+                 _RandomAccessIterator3 __zs, _Compare __comp, _LeafMerge __leaf_merge)
+{
+    __std_thread_backend::__parallel_merge_body(__xe - __xs, __ye - __ys, __xs, __xe, __ys, __ye, __zs, __comp,
+                                                __leaf_merge);
+}
+
+//------------------------------------------------------------------------
+// parallel_stable_sort
+//------------------------------------------------------------------------
+
+// Sorts [__xs, __xe) using __buf, which has room for as many elements, as a
+// scratch area: the sorted halves are moved into __buf and merged back.
+template <typename _RandomAccessIterator, typename _ValueType, typename _Compare, typename _LeafSort>
+void
+__parallel_stable_sort_body(_RandomAccessIterator __xs, _RandomAccessIterator __xe, _ValueType* __buf,
+                            _Compare __comp, _LeafSort& __leaf_sort)
+{
+    const std::size_t __size = __xe - __xs;
+    if (__size <= __default_chunk_size)
+    {
+        __leaf_sort(__xs, __xe, __comp);
+        return;
+    }
+
+    const std::size_t __half = __size / 2;
+    _RandomAccessIterator __mid = __xs + __half;
+    __std_thread_backend::__parallel_invoke_body(
+        [&]() { __std_thread_backend::__parallel_stable_sort_body(__xs, __mid, __buf, __comp, __leaf_sort); },
+        [&]() {
+            __std_thread_backend::__parallel_stable_sort_body(__mid, __xe, __buf + __half, __comp, __leaf_sort);
+        });
+
+    auto __move_construct = [__xs, __buf](std::size_t __i, std::size_t __j) {
+        std::uninitialized_move(__xs + __i, __xs + __j, __buf + __i);
+    };
+    __std_thread_backend::__parallel_for_body(std::size_t(0), __size, __default_chunk_size, __move_construct);
+
+    auto __leaf_merge = [](_ValueType* __as, _ValueType* __ae, _ValueType* __bs, _ValueType* __be,
+                           _RandomAccessIterator __cs, _Compare __comp) {
+        std::merge(std::make_move_iterator(__as), std::make_move_iterator(__ae), std::make_move_iterator(__bs),
+                   std::make_move_iterator(__be), __cs, __comp);
+    };
+    __std_thread_backend::__parallel_merge_body(__half, __size - __half, __buf, __buf + __half, __buf + __half,
+                                                __buf + __size, __xs, __comp, __leaf_merge);
+
+    auto __destroy = [__buf](std::size_t __i, std::size_t __j) { std::destroy(__buf + __i, __buf + __j); };
+    __std_thread_backend::__parallel_for_body(std::size_t(0), __size, __default_chunk_size, __destroy);
+}
+
+template <class _ExecutionPolicy, typename _RandomAccessIterator, typename _Compare, typename _LeafSort>
+void
+__parallel_stable_sort(__pstl::__internal::__std_thread_backend_tag, _ExecutionPolicy&&, _RandomAccessIterator __xs,
+                       _RandomAccessIterator __xe, _Compare __comp, _LeafSort __leaf_sort, std::size_t __nsort = 0)
+{
+    using _ValueType = typename std::iterator_traits<_RandomAccessIterator>::value_type;
+
+    const std::size_t __count = __xe - __xs;
+    if (__nsort == __count)
+        __nsort = 0; // 'partial_sort' becames 'sort'
+
+    // TODO: parallelize the partial sort.
+    if (__count <= __default_chunk_size || __nsort != 0)
+    {
+        __leaf_sort(__xs, __xe, __comp);
+        return;
+    }
+
+    __buffer<_ValueType> __buf(__count);
+    __std_thread_backend::__parallel_stable_sort_body(__xs, __xe, __buf.get(), __comp, __leaf_sort);
+}
+
+} // namespace __std_thread_backend
+} // namespace __pstl
+
+_PSTL_HIDE_FROM_ABI_POP
+
+#endif /* _PSTL_PARALLEL_BACKEND_STD_THREAD_H */
@@ -0,0 +1,173 @@
+// -*- C++ -*-
+//===-- std_thread_backend.pass.cpp ---------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14
+
+// Tests the thread pool of the std_thread backend directly: nested forks,
+// forks from threads which are not part of the pool, and exceptions.
+
+#include "support/pstl_test_config.h"
+
+#include <execution>
+#include <pstl/internal/execution_impl.h>
+#include <pstl/internal/parallel_backend.h>
+
+#if defined(_PSTL_PAR_BACKEND_STD_THREAD)
+
+#    include <algorithm>
+#    include <atomic>
+#    include <cstdint>
+#    include <functional>
+#    include <numeric>
+#    include <stdexcept>
+#    include <thread>
+#    include <vector>
+
+#    include "support/utils.h"
+
+using __pstl::__internal::__std_thread_backend_tag;
+namespace __backend = __pstl::__std_thread_backend;
+
+struct policy
+{
+};
+
+// Forks recursively down to single elements, so that most tasks are tiny and
+// the forking threads often wait for stolen tasks.
+std::uint64_t
+sum_nested(const std::uint64_t* first, const std::uint64_t* last)
+{
+    if (last - first == 1)
+        return *first;
+    const std::uint64_t* middle = first + (last - first) / 2;
+    std::uint64_t left = 0, right = 0;
+    __backend::__parallel_invoke(
+        __std_thread_backend_tag{}, policy{}, [&] { left = sum_nested(first, middle); },
+        [&] { right = sum_nested(middle, last); });
+    return left + right;
+}
+
+void
+test_nested_invoke()
+{
+    std::vector<std::uint64_t> values(100000);
+    std::iota(values.begin(), values.end(), 0);
+    const std::uint64_t expected = std::accumulate(values.begin(), values.end(), std::uint64_t(0));
+    for (int i = 0; i < 10; ++i)
+        EXPECT_TRUE(sum_nested(values.data(), values.data() + values.size()) == expected,
+                    "wrong sum of nested __parallel_invoke");
+}
+
+void
+test_parallel_for()
+{
+    const std::size_t n = 1000000;
+    std::vector<std::atomic<int>> visits(n);
+    __backend::__parallel_for(__std_thread_backend_tag{}, policy{}, std::size_t(0), n,
+                              [&](std::size_t first, std::size_t last) {
+                                  for (std::size_t i = first; i != last; ++i)
+                                      visits[i].fetch_add(1, std::memory_order_relaxed);
+                              });
+    EXPECT_TRUE(std::all_of(visits.begin(), visits.end(), [](const std::atomic<int>& v) { return v.load() == 1; }),
+                "each index must be visited once by __parallel_for");
+}
+
+void
+test_parallel_reduce()
+{
+    const std::uint64_t n = 1000000;
+    const std::uint64_t sum = __backend::__parallel_reduce(
+        __std_thread_backend_tag{}, policy{}, std::uint64_t(0), n, std::uint64_t(0),
+        [](std::uint64_t first, std::uint64_t last, std::uint64_t init) {
+            for (std::uint64_t i = first; i != last; ++i)
+                init += i;
+            return init;
+        },
+        std::plus<std::uint64_t>());
+    EXPECT_TRUE(sum == n * (n - 1) / 2, "wrong result of __parallel_reduce");
+}
+
+// The threads which are not part of the pool share a single deque, and wait
+// for the stolen tasks like the workers do.
+void
+test_concurrent_callers()
+{
+    std::vector<std::uint64_t> values(20000, 1);
+    std::vector<std::thread> callers;
+    std::atomic<int> failures(0);
+    for (int t = 0; t < 4; ++t)
+        callers.emplace_back([&] {
+            for (int i = 0; i < 5; ++i)
+                if (sum_nested(values.data(), values.data() + values.size()) != values.size())
+                    failures.fetch_add(1);
+        });
+    for (std::thread& caller : callers)
+        caller.join();
+    EXPECT_TRUE(failures.load() == 0, "wrong sum from concurrent callers");
+}
+
+void
+test_exception()
+{
+    bool caught = false;
+    std::atomic<bool> second_done(false);
+    try
+    {
+        __backend::__parallel_invoke(
+            __std_thread_backend_tag{}, policy{}, [] { throw std::runtime_error("first"); },
+            [&] { second_done = true; });
+    }
+    catch (const std::runtime_error&)
+    {
+        caught = true;
+    }
+    EXPECT_TRUE(caught, "the exception of the first function must be propagated");
+    EXPECT_TRUE(second_done.load(), "the forked function must complete before the exception is propagated");
+}
+
+void
+test_stable_sort()
+{
+    // Sort pairs by their first member only, so that stability is observable.
+    std::vector<std::pair<int, int>> values(200000);
+    for (std::size_t i = 0; i < values.size(); ++i)
+        values[i] = {int((i * 7919) % 1000), int(i)};
+    std::vector<std::pair<int, int>> expected(values);
+    auto comp = [](const std::pair<int, int>& a, const std::pair<int, int>& b) { return a.first < b.first; };
+    std::stable_sort(expected.begin(), expected.end(), comp);
+    __backend::__parallel_stable_sort(__std_thread_backend_tag{}, policy{}, values.begin(), values.end(), comp,
+                                      [](auto first, auto last, auto cmp) { std::stable_sort(first, last, cmp); });
+    EXPECT_TRUE(values == expected, "wrong result of __parallel_stable_sort");
+}
+
+int
+main()
+{
+    test_nested_invoke();
+    test_parallel_for();
+    test_parallel_reduce();
+    test_concurrent_callers();
+    test_exception();
+    test_stable_sort();
+    std::cout << TestUtils::done() << std::endl;
+    return 0;
+}
+
+#else
+
+#    include "support/utils.h"
+
+int
+main()
+{
+    std::cout << TestUtils::done() << std::endl;
+    return 0;
+}
+
+#endif